@@ -0,0 +1,84 @@
+from typing import Any, ClassVar, Optional, Union
+
+from typing import overload
+import io
+import lief # type: ignore
+import lief.AR # type: ignore
+import os
+
+class Archive:
+    class KIND:
+        BSD: ClassVar[Archive.KIND] = ...
+        COFF: ClassVar[Archive.KIND] = ...
+        GNU: ClassVar[Archive.KIND] = ...
+        UNKNOWN: ClassVar[Archive.KIND] = ...
+        __name__: str
+        def __init__(self, *args, **kwargs) -> None: ...
+        @staticmethod
+        def from_value(arg: int, /) -> lief.AR.Archive.KIND: ...
+        def __ge__(self, other) -> bool: ...
+        def __gt__(self, other) -> bool: ...
+        def __hash__(self) -> int: ...
+        def __index__(self) -> Any: ...
+        def __int__(self) -> int: ...
+        def __le__(self, other) -> bool: ...
+        def __lt__(self, other) -> bool: ...
+        @property
+        def value(self) -> int: ...
+
+    class it_const_members:
+        def __init__(self, *args, **kwargs) -> None: ...
+        def __getitem__(self, arg: int, /) -> lief.AR.Member: ...
+        def __iter__(self) -> lief.AR.Archive.it_const_members: ...
+        def __len__(self) -> int: ...
+        def __next__(self) -> lief.AR.Member: ...
+    def __init__(self, *args, **kwargs) -> None: ...
+    def find_symbol(self, name: str) -> Optional[lief.AR.Member]: ...
+    def get_member(self, name: str) -> Optional[lief.AR.Member]: ...
+    def has_symbol(self, name: str) -> bool: ...
+    @overload
+    def parse(self, member: lief.AR.Member) -> Optional[lief.Binary]: ...
+    @overload
+    def parse(self, nb_threads: int = ...) -> list: ...
+    @property
+    def kind(self) -> lief.AR.Archive.KIND: ...
+    @property
+    def members(self) -> lief.AR.Archive.it_const_members: ...
+    @property
+    def raw(self) -> bytes: ...
+    @property
+    def symbols(self) -> dict: ...
+
+class Member:
+    def __init__(self, *args, **kwargs) -> None: ...
+    @property
+    def content(self) -> memoryview: ...
+    @property
+    def data_offset(self) -> int: ...
+    @property
+    def date(self) -> int: ...
+    @property
+    def format(self) -> lief.Binary.FORMATS: ...
+    @property
+    def gid(self) -> int: ...
+    @property
+    def mode(self) -> int: ...
+    @property
+    def name(self) -> str: ...
+    @property
+    def offset(self) -> int: ...
+    @property
+    def size(self) -> int: ...
+    @property
+    def uid(self) -> int: ...
+
+@overload
+def is_archive(path: str) -> bool: ...
+@overload
+def is_archive(raw: list[int]) -> bool: ...
+@overload
+def parse(filename: str) -> Optional[lief.AR.Archive]: ...
+@overload
+def parse(raw: list[int]) -> Optional[lief.AR.Archive]: ...
+@overload
+def parse(obj: Union[io.IOBase|os.PathLike]) -> Optional[lief.AR.Archive]: ...
@@ -1,4 +1,4 @@
-from typing import Any, ClassVar, Optional, Union
+from typing import Any, ClassVar, Iterator, Optional, Union
 
 from typing import overload
 import io
@@ -10,6 +10,8 @@ class File(lief.Object):
     def __init__(self, *args, **kwargs) -> None: ...
     @property
     def header(self) -> lief.ART.Header: ...
+    @property
+    def image(self) -> Optional[lief.ART.ImageReader]: ...
 
 class Header(lief.Object):
     def __init__(self, *args, **kwargs) -> None: ...
@@ -54,6 +56,162 @@ class Header(lief.Object):
     @property
     def version(self) -> int: ...
 
+class ImageReader:
+    class OBJECT_KIND:
+        ARRAY: ClassVar[ImageReader.OBJECT_KIND] = ...
+        CLASS: ClassVar[ImageReader.OBJECT_KIND] = ...
+        INSTANCE: ClassVar[ImageReader.OBJECT_KIND] = ...
+        STRING: ClassVar[ImageReader.OBJECT_KIND] = ...
+        __name__: str
+        def __init__(self, *args, **kwargs) -> None: ...
+        @staticmethod
+        def from_value(arg: int, /) -> lief.ART.ImageReader.OBJECT_KIND: ...
+        def __ge__(self, other) -> bool: ...
+        def __gt__(self, other) -> bool: ...
+        def __hash__(self) -> int: ...
+        def __index__(self) -> Any: ...
+        def __int__(self) -> int: ...
+        def __le__(self, other) -> bool: ...
+        def __lt__(self, other) -> bool: ...
+        @property
+        def value(self) -> int: ...
+
+    class SECTION:
+        ART_FIELDS: ClassVar[ImageReader.SECTION] = ...
+        ART_METHODS: ClassVar[ImageReader.SECTION] = ...
+        CLASS_TABLE: ClassVar[ImageReader.SECTION] = ...
+        DEX_CACHE_ARRAYS: ClassVar[ImageReader.SECTION] = ...
+        IMAGE_BITMAP: ClassVar[ImageReader.SECTION] = ...
+        IMT_CONFLICT_TABLES: ClassVar[ImageReader.SECTION] = ...
+        IM_TABLES: ClassVar[ImageReader.SECTION] = ...
+        INTERNED_STRINGS: ClassVar[ImageReader.SECTION] = ...
+        OBJECTS: ClassVar[ImageReader.SECTION] = ...
+        RUNTIME_METHODS: ClassVar[ImageReader.SECTION] = ...
+        UNKNOWN: ClassVar[ImageReader.SECTION] = ...
+        __name__: str
+        def __init__(self, *args, **kwargs) -> None: ...
+        @staticmethod
+        def from_value(arg: int, /) -> lief.ART.ImageReader.SECTION: ...
+        def __ge__(self, other) -> bool: ...
+        def __gt__(self, other) -> bool: ...
+        def __hash__(self) -> int: ...
+        def __index__(self) -> Any: ...
+        def __int__(self) -> int: ...
+        def __le__(self, other) -> bool: ...
+        def __lt__(self, other) -> bool: ...
+        @property
+        def value(self) -> int: ...
+
+    class art_field_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def access_flags(self) -> int: ...
+        @property
+        def address(self) -> int: ...
+        @property
+        def declaring_class(self) -> int: ...
+        @property
+        def dex_field_index(self) -> int: ...
+        @property
+        def offset(self) -> int: ...
+
+    class art_method_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def access_flags(self) -> int: ...
+        @property
+        def address(self) -> int: ...
+        @property
+        def declaring_class(self) -> int: ...
+        @property
+        def dex_code_item_offset(self) -> int: ...
+        @property
+        def dex_method_index(self) -> int: ...
+        @property
+        def entry_point(self) -> int: ...
+        @property
+        def method_index(self) -> int: ...
+
+    class dex_cache_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def address(self) -> int: ...
+        @property
+        def location(self) -> str: ...
+        @property
+        def nb_resolved_fields(self) -> int: ...
+        @property
+        def nb_resolved_methods(self) -> int: ...
+        @property
+        def nb_resolved_types(self) -> int: ...
+        @property
+        def nb_strings(self) -> int: ...
+        @property
+        def resolved_fields(self) -> int: ...
+        @property
+        def resolved_methods(self) -> int: ...
+        @property
+        def resolved_types(self) -> int: ...
+        @property
+        def strings(self) -> int: ...
+
+    class object_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def address(self) -> int: ...
+        @property
+        def kind(self) -> lief.ART.ImageReader.OBJECT_KIND: ...
+        @property
+        def klass(self) -> int: ...
+        @property
+        def length(self) -> int: ...
+        @property
+        def size(self) -> int: ...
+
+    class section_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def offset(self) -> int: ...
+        @property
+        def size(self) -> int: ...
+        @property
+        def type(self) -> lief.ART.ImageReader.SECTION: ...
+
+    def __init__(self, *args, **kwargs) -> None: ...
+    def art_field(self, address: int) -> Union[lief.ART.ImageReader.art_field_t,lief.lief_errors]: ...
+    def art_method(self, address: int) -> Union[lief.ART.ImageReader.art_method_t,lief.lief_errors]: ...
+    def class_name(self, address: int) -> Union[str,lief.lief_errors]: ...
+    def contains(self, address: int) -> bool: ...
+    def find_object(self, address: int) -> Union[lief.ART.ImageReader.object_t,lief.lief_errors]: ...
+    def get(self, type: lief.ART.ImageReader.SECTION) -> Optional[lief.ART.ImageReader.section_t]: ...
+    def object(self, address: int) -> Union[lief.ART.ImageReader.object_t,lief.lief_errors]: ...
+    def read(self, address: int, size: int) -> Union[bytes,lief.lief_errors]: ...
+    def string(self, address: int) -> Union[str,lief.lief_errors]: ...
+    @property
+    def art_fields(self) -> list[lief.ART.ImageReader.art_field_t]: ...
+    @property
+    def art_methods(self) -> list[lief.ART.ImageReader.art_method_t]: ...
+    @property
+    def class_roots(self) -> list[int]: ...
+    @property
+    def class_table(self) -> list[int]: ...
+    @property
+    def dex_caches(self) -> list[lief.ART.ImageReader.dex_cache_t]: ...
+    @property
+    def image_begin(self) -> int: ...
+    @property
+    def image_size(self) -> int: ...
+    @property
+    def interned_strings(self) -> list[int]: ...
+    @property
+    def nb_decoded_blocks(self) -> int: ...
+    @property
+    def objects(self) -> Iterator[lief.ART.ImageReader.object_t]: ...
+    @property
+    def pointer_size(self) -> int: ...
+    @property
+    def sections(self) -> list[lief.ART.ImageReader.section_t]: ...
+
 class STORAGE_MODES:
     LZ4: ClassVar[STORAGE_MODES] = ...
     LZ4HC: ClassVar[STORAGE_MODES] = ...
@@ -172,6 +172,8 @@ class File(lief.Object):
     def has_class(self, classname: str) -> bool: ...
     def raw(self, deoptimize: bool = ...) -> list[int]: ...
     def save(self, output: str = ..., deoptimize: bool = ...) -> str: ...
+    def verify_checksum(self) -> bool: ...
+    def verify_signature(self) -> bool: ...
     @property
     def classes(self) -> lief.DEX.File.it_classes: ...
     @property
@@ -370,12 +372,45 @@ class Type(lief.Object):
     @property
     def value(self) -> object: ...
 
+class XRef:
+    def __init__(self, *args, **kwargs) -> None: ...
+    def accessors(self, field: lief.DEX.Field) -> list[lief.DEX.Method]: ...
+    @staticmethod
+    def build(file: lief.DEX.File, nb_threads: int = ...) -> lief.DEX.XRef: ...
+    def callees(self, method_idx: int) -> list[int]: ...
+    def callers(self, method_idx: int) -> list[int]: ...
+    def field(self, field_idx: int) -> lief.DEX.Field: ...
+    def field_users(self, field_idx: int) -> list[int]: ...
+    def fields(self, method_idx: int) -> list[int]: ...
+    def method(self, method_idx: int) -> lief.DEX.Method: ...
+    def method_callees(self, method: lief.DEX.Method) -> list[lief.DEX.Method]: ...
+    def method_callers(self, method: lief.DEX.Method) -> list[lief.DEX.Method]: ...
+    def string_users(self, string_idx: int) -> list[int]: ...
+    def strings(self, method_idx: int) -> list[int]: ...
+    def type_users(self, type_idx: int) -> list[int]: ...
+    def types(self, method_idx: int) -> list[int]: ...
+
+class verify_t:
+    def __init__(self, *args, **kwargs) -> None: ...
+    @property
+    def checksum(self) -> bool: ...
+    @property
+    def is_valid(self) -> bool: ...
+    @property
+    def signature(self) -> bool: ...
+
+def adler32(data: bytes, adler: int = ...) -> int: ...
+def compute_checksum(raw: bytes) -> Union[int,lief.lief_errors]: ...
+def compute_signature(raw: bytes) -> Union[list[int],lief.lief_errors]: ...
+def fix(files: list[lief.DEX.File], deoptimize: bool = ..., nb_threads: int = ...) -> list: ...
 @overload
 def parse(filename: str) -> Optional[lief.DEX.File]: ...
 @overload
 def parse(raw: list[int], name: str = ...) -> Optional[lief.DEX.File]: ...
 @overload
 def parse(obj: Union[io.IOBase|os.PathLike], name: str = ...) -> Optional[lief.DEX.File]: ...
+def update_checksums(raw: bytes) -> Union[bytes,lief.lief_errors]: ...
+def verify(files: list[lief.DEX.File], nb_threads: int = ...) -> list[lief.DEX.verify_t]: ...
 @overload
 def version(file: str) -> int: ...
 @overload
@@ -1,4 +1,4 @@
-from typing import Any, ClassVar, Iterable, Iterator, Optional, Union
+from typing import Any, Callable, ClassVar, Iterable, Iterator, Optional, Union
 
 from typing import overload
 import io
@@ -368,6 +368,7 @@ class Binary(lief.Binary):
     def add_object_relocation(self, relocation: lief.ELF.Relocation, section: lief.ELF.Section) -> lief.ELF.Relocation: ...
     def add_pltgot_relocation(self, relocation: lief.ELF.Relocation) -> lief.ELF.Relocation: ...
     def add_symtab_symbol(self, symbol: lief.ELF.Symbol) -> lief.ELF.Symbol: ...
+    def clone(self) -> lief.ELF.Binary: ...
     @overload
     def dynsym_idx(self, name: str) -> int: ...
     @overload
@@ -434,6 +435,7 @@ class Binary(lief.Binary):
     def remove_dynamic_symbol(self, arg: lief.ELF.Symbol, /) -> None: ...
     @overload
     def remove_dynamic_symbol(self, arg: str, /) -> None: ...
+    def relocate(self, layout: dict, resolver: Optional[Callable[[lief.ELF.Symbol], Optional[int]]] = ...) -> Union[int,lief.lief_errors]: ...
     def remove_library(self, library_name: str) -> None: ...
     def remove_symtab_symbol(self, arg: lief.ELF.Symbol, /) -> None: ...
     def replace(self, new_segment: lief.ELF.Segment, original_segment: lief.ELF.Segment, base: int = ...) -> lief.ELF.Segment: ...
@@ -680,6 +682,8 @@ class CoreFile(Note):
     def __init__(self, *args, **kwargs) -> None: ...
     def __iter__(self) -> Iterator[lief.ELF.CoreFile.entry_t]: ...
     def __len__(self) -> int: ...
+    @property
+    def page_size(self) -> int: ...
 
 class CorePrPsInfo(Note):
     class info_t:
@@ -933,6 +937,58 @@ class CoreSigInfo(Note):
     signo: Optional[int]
     def __init__(self, *args, **kwargs) -> None: ...
 
+class CoreUnwinder:
+    class METHOD:
+        CFI: ClassVar[CoreUnwinder.METHOD] = ...
+        CONTEXT: ClassVar[CoreUnwinder.METHOD] = ...
+        FRAME_POINTER: ClassVar[CoreUnwinder.METHOD] = ...
+        __name__: str
+        def __init__(self, *args, **kwargs) -> None: ...
+        @staticmethod
+        def from_value(arg: int, /) -> lief.ELF.CoreUnwinder.METHOD: ...
+        def __ge__(self, other) -> bool: ...
+        def __gt__(self, other) -> bool: ...
+        def __hash__(self) -> int: ...
+        def __index__(self) -> Any: ...
+        def __int__(self) -> int: ...
+        def __le__(self, other) -> bool: ...
+        def __lt__(self, other) -> bool: ...
+        @property
+        def value(self) -> int: ...
+
+    class frame_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def method(self) -> lief.ELF.CoreUnwinder.METHOD: ...
+        @property
+        def module(self) -> str: ...
+        @property
+        def offset(self) -> int: ...
+        @property
+        def pc(self) -> int: ...
+        @property
+        def sp(self) -> int: ...
+
+    class thread_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def frames(self) -> list[lief.ELF.CoreUnwinder.frame_t]: ...
+        @property
+        def signal(self) -> int: ...
+        @property
+        def tid(self) -> int: ...
+    max_frames: int
+    sysroot: str
+    def __init__(self) -> None: ...
+    def add_module(self, path: str, module: lief.ELF.Binary) -> None: ...
+    def clear_cache(self) -> None: ...
+    @overload
+    def unwind(self, core: lief.ELF.Binary, nb_threads: int = ...) -> Union[list[lief.ELF.CoreUnwinder.thread_t],lief.lief_errors]: ...
+    @overload
+    def unwind(self, core: lief.ELF.Binary, status: lief.ELF.CorePrStatus) -> Union[lief.ELF.CoreUnwinder.thread_t,lief.lief_errors]: ...
+    @property
+    def nb_modules(self) -> int: ...
+
 class DynamicEntry(lief.Object):
     class TAG:
         AARCH64_BTI_PLT: ClassVar[DynamicEntry.TAG] = ...
@@ -1179,6 +1235,29 @@ class DynamicEntryRunPath(DynamicEntry):
     def __iadd__(self, arg: str, /) -> lief.ELF.DynamicEntryRunPath: ...
     def __isub__(self, arg: str, /) -> lief.ELF.DynamicEntryRunPath: ...
 
+class DynamicPatcher:
+    def __init__(self, *args, **kwargs) -> None: ...
+    def add_needed(self, library: str) -> Union[lief.ok_t,lief.lief_errors]: ...
+    @staticmethod
+    def apply(path: str, interpreter: str = ..., soname: str = ..., runpath: str = ..., rpath: str = ..., needed: list[str] = ...) -> Union[bool,lief.lief_errors]: ...
+    def commit(self) -> Union[lief.ok_t,lief.lief_errors]: ...
+    def interpreter(self, path: str) -> Union[lief.ok_t,lief.lief_errors]: ...
+    @staticmethod
+    def open(path: str) -> Union[lief.ELF.DynamicPatcher,lief.lief_errors]: ...
+    def rpath(self, path: str) -> Union[lief.ok_t,lief.lief_errors]: ...
+    def runpath(self, path: str) -> Union[lief.ok_t,lief.lief_errors]: ...
+    def soname(self, name: str) -> Union[lief.ok_t,lief.lief_errors]: ...
+    @property
+    def current_interpreter(self) -> str: ...
+    @property
+    def dynstr_slack(self) -> int: ...
+    @property
+    def modifications(self) -> list[tuple[int,int]]: ...
+    @property
+    def needed(self) -> list[str]: ...
+    @property
+    def spare_dynamic_slots(self) -> int: ...
+
 class DynamicSharedObject(DynamicEntry):
     name: Union[str,bytes]
     def __init__(self, library_name: str) -> None: ...
@@ -1580,6 +1659,7 @@ class ParserConfig:
         def __lt__(self, other) -> bool: ...
         @property
         def value(self) -> int: ...
+    budget: lief.ParserBudget
     count_mtd: lief.ELF.ParserConfig.DYNSYM_COUNT
     parse_dyn_symbols: bool
     parse_notes: bool
@@ -1265,6 +1265,7 @@ class PPC_RELOCATION:
     def value(self) -> int: ...
 
 class ParserConfig:
+    budget: lief.ParserBudget
     fix_from_memory: bool
     from_dyld_shared_cache: bool
     parse_dyld_bindings: bool
@@ -1714,6 +1715,56 @@ class UnknownCommand(LoadCommand):
     @property
     def original_command(self) -> int: ...
 
+class UnwindInfo:
+    class entry_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def address(self) -> int: ...
+        @property
+        def encoding(self) -> int: ...
+        @property
+        def has_lsda(self) -> bool: ...
+        @property
+        def is_function_start(self) -> bool: ...
+        @property
+        def lsda(self) -> int: ...
+        @property
+        def personality(self) -> int: ...
+        @property
+        def size(self) -> int: ...
+
+    class fde_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def address(self) -> int: ...
+        @property
+        def pc_begin(self) -> int: ...
+        @property
+        def pc_end(self) -> int: ...
+    def __init__(self, *args, **kwargs) -> None: ...
+    def fde(self, entry: lief.MachO.UnwindInfo.entry_t) -> Union[lief.MachO.UnwindInfo.fde_t,lief.lief_errors]: ...
+    @staticmethod
+    def from_binary(binary: lief.MachO.Binary) -> Union[lief.MachO.UnwindInfo,lief.lief_errors]: ...
+    def is_dwarf(self, encoding: int) -> bool: ...
+    @overload
+    def lookup(self, address: int) -> Union[lief.MachO.UnwindInfo.entry_t,lief.lief_errors]: ...
+    @overload
+    def lookup(self, addresses: list[int]) -> list[lief.MachO.UnwindInfo.entry_t]: ...
+    @property
+    def arch(self) -> lief.MachO.Header.CPU_TYPE: ...
+    @property
+    def common_encodings(self) -> list[int]: ...
+    @property
+    def entries(self) -> Iterator[lief.MachO.UnwindInfo.entry_t]: ...
+    @property
+    def imagebase(self) -> int: ...
+    @property
+    def nb_pages(self) -> int: ...
+    @property
+    def personalities(self) -> list[int]: ...
+    @property
+    def version(self) -> int: ...
+
 class VersionMin(LoadCommand):
     sdk: list[int]
     version: list[int]
@@ -255,11 +255,14 @@ class OAT_CLASS_TYPES:
     def __lt__(self, other) -> bool: ...
 
 def android_version(arg: int, /) -> lief.Android.ANDROID_VERSIONS: ...
+def light_config() -> lief.ELF.ParserConfig: ...
 @overload
 def parse(oat_file: str) -> Optional[lief.OAT.Binary]: ...
 @overload
 def parse(oat_file: str, vdex_file: str) -> Optional[lief.OAT.Binary]: ...
 @overload
+def parse(oat_file: str, config: lief.ELF.ParserConfig) -> Optional[lief.OAT.Binary]: ...
+@overload
 def parse(raw: list[int]) -> Optional[lief.OAT.Binary]: ...
 @overload
 def parse(obj: Union[io.IOBase|os.PathLike]) -> Optional[lief.OAT.Binary]: ...
@@ -307,6 +307,38 @@ class ALGORITHMS:
     @property
     def value(self) -> int: ...
 
+class ApiSet:
+    class entry_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def is_sealed(self) -> bool: ...
+        @property
+        def name(self) -> str: ...
+        @property
+        def values(self) -> list[lief.PE.ApiSet.value_t]: ...
+
+    class value_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def host(self) -> str: ...
+        @property
+        def importer(self) -> str: ...
+    def __init__(self, *args, **kwargs) -> None: ...
+    def find(self, name: str) -> Optional[lief.PE.ApiSet.entry_t]: ...
+    @staticmethod
+    def is_api_set(name: str) -> bool: ...
+    @overload
+    @staticmethod
+    def parse(apisetschema: lief.PE.Binary) -> Union[lief.PE.ApiSet,lief.lief_errors]: ...
+    @overload
+    @staticmethod
+    def parse(raw: bytes) -> Union[lief.PE.ApiSet,lief.lief_errors]: ...
+    def resolve(self, name: str, importer: str = ...) -> Union[str,lief.lief_errors]: ...
+    @property
+    def entries(self) -> list[lief.PE.ApiSet.entry_t]: ...
+    @property
+    def version(self) -> int: ...
+
 class Attribute(lief.Object):
     class TYPE:
         CONTENT_TYPE: ClassVar[Attribute.TYPE] = ...
@@ -413,6 +445,7 @@ class Binary(lief.Binary):
     def get_section(self, section_name: str) -> lief.PE.Section: ...
     def has_delay_import(self, import_name: str) -> bool: ...
     def has_import(self, import_name: str) -> bool: ...
+    def page_hash(self, offset: int, algorithm: lief.PE.ALGORITHMS) -> Union[bytes,lief.lief_errors]: ...
     def predict_function_rva(self, library: str, function: str) -> int: ...
     def remove(self, section: lief.PE.Section, clear: bool = ...) -> None: ...
     def remove_all_libraries(self) -> None: ...
@@ -423,6 +456,14 @@ class Binary(lief.Binary):
     def section_from_rva(self, rva: int) -> lief.PE.Section: ...
     def va_to_offset(self, va_address: int) -> int: ...
     @overload
+    def verify_page(self, rva: int) -> Union[bool,lief.lief_errors]: ...
+    @overload
+    def verify_page(self, rva: int, signature: lief.PE.Signature) -> Union[bool,lief.lief_errors]: ...
+    @overload
+    def verify_pages(self, nb_threads: int = ...) -> Union[list[int],lief.lief_errors]: ...
+    @overload
+    def verify_pages(self, signature: lief.PE.Signature, nb_threads: int = ...) -> Union[list[int],lief.lief_errors]: ...
+    @overload
     def verify_signature(self, checks: lief.PE.Signature.VERIFICATION_CHECKS = ...) -> lief.PE.Signature.VERIFICATION_FLAGS: ...
     @overload
     def verify_signature(self, signature: lief.PE.Signature, checks: lief.PE.Signature.VERIFICATION_CHECKS = ...) -> lief.PE.Signature.VERIFICATION_FLAGS: ...
@@ -984,6 +1025,22 @@ class ExportEntry(lief.Symbol):
     @property
     def is_forwarded(self) -> bool: ...
 
+class ExportResolver:
+    def __init__(self, *args, **kwargs) -> None: ...
+    @staticmethod
+    def from_binary(binary: lief.PE.Binary) -> Union[lief.PE.ExportResolver,lief.lief_errors]: ...
+    def find(self, name: str, hint: int = ...) -> Union[lief.PE.ExportEntry,lief.lief_errors]: ...
+    def find_ordinal(self, ordinal: int) -> Union[lief.PE.ExportEntry,lief.lief_errors]: ...
+    def name_at(self, index: int) -> Union[str,lief.lief_errors]: ...
+    @property
+    def name(self) -> Union[str,bytes]: ...
+    @property
+    def nb_functions(self) -> int: ...
+    @property
+    def nb_names(self) -> int: ...
+    @property
+    def ordinal_base(self) -> int: ...
+
 class FIXED_VERSION_FILE_FLAGS:
     DEBUG: ClassVar[FIXED_VERSION_FILE_FLAGS] = ...
     INFOINFERRED: ClassVar[FIXED_VERSION_FILE_FLAGS] = ...
@@ -1212,6 +1269,25 @@ class Header(lief.Object):
     @property
     def characteristics_list(self) -> list[lief.PE.Header.CHARACTERISTICS]: ...
 
+class HeaderPatcher:
+    def __init__(self, *args, **kwargs) -> None: ...
+    def data_directory(self, type: lief.PE.DataDirectory.TYPES, rva: int, size: int) -> Union[lief.ok_t,lief.lief_errors]: ...
+    def dll_characteristics(self, value: int) -> Union[lief.ok_t,lief.lief_errors]: ...
+    def flush(self) -> Union[lief.ok_t,lief.lief_errors]: ...
+    @staticmethod
+    def open(path: str) -> Union[lief.PE.HeaderPatcher,lief.lief_errors]: ...
+    def patch(self, offset: int, data: bytes) -> Union[lief.ok_t,lief.lief_errors]: ...
+    def subsystem(self, value: lief.PE.OptionalHeader.SUBSYSTEM) -> Union[lief.ok_t,lief.lief_errors]: ...
+    def time_date_stamp(self, value: int) -> Union[lief.ok_t,lief.lief_errors]: ...
+    @property
+    def checksum(self) -> int: ...
+    @property
+    def is_signed(self) -> bool: ...
+    @property
+    def signature_invalidated(self) -> bool: ...
+    @property
+    def type(self) -> lief.PE.PE_TYPE: ...
+
 class IMPHASH_MODE:
     DEFAULT: ClassVar[IMPHASH_MODE] = ...
     LIEF: ClassVar[IMPHASH_MODE] = ...
@@ -1285,6 +1361,68 @@ class ImportEntry(lief.Symbol):
     @property
     def ordinal(self) -> int: ...
 
+class ImportResolver:
+    class STATUS:
+        CYCLE: ClassVar[ImportResolver.STATUS] = ...
+        MISSING_API_SET: ClassVar[ImportResolver.STATUS] = ...
+        MISSING_EXPORT: ClassVar[ImportResolver.STATUS] = ...
+        MISSING_LIBRARY: ClassVar[ImportResolver.STATUS] = ...
+        RESOLVED: ClassVar[ImportResolver.STATUS] = ...
+        __name__: str
+        def __init__(self, *args, **kwargs) -> None: ...
+        @staticmethod
+        def from_value(arg: int, /) -> lief.PE.ImportResolver.STATUS: ...
+        def __ge__(self, other) -> bool: ...
+        def __gt__(self, other) -> bool: ...
+        def __hash__(self) -> int: ...
+        def __index__(self) -> Any: ...
+        def __int__(self) -> int: ...
+        def __le__(self, other) -> bool: ...
+        def __lt__(self, other) -> bool: ...
+        @property
+        def value(self) -> int: ...
+
+    class import_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def function(self) -> str: ...
+        @property
+        def is_delayed(self) -> bool: ...
+        @property
+        def is_ordinal(self) -> bool: ...
+        @property
+        def library(self) -> str: ...
+        @property
+        def ordinal(self) -> int: ...
+        @property
+        def resolution(self) -> lief.PE.ImportResolver.resolution_t: ...
+
+    class resolution_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def chain(self) -> list[str]: ...
+        @property
+        def function(self) -> str: ...
+        @property
+        def is_resolved(self) -> bool: ...
+        @property
+        def library(self) -> str: ...
+        @property
+        def ordinal(self) -> int: ...
+        @property
+        def rva(self) -> int: ...
+        @property
+        def status(self) -> lief.PE.ImportResolver.STATUS: ...
+    def __init__(self) -> None: ...
+    def add(self, dll: lief.PE.Binary, name: str = ...) -> Union[lief.ok_t,lief.lief_errors]: ...
+    def apiset(self, schema: lief.PE.ApiSet) -> None: ...
+    def clear_cache(self) -> None: ...
+    def resolve(self, library: str, function: str, importer: str = ...) -> lief.PE.ImportResolver.resolution_t: ...
+    def resolve_imports(self, binary: lief.PE.Binary, name: str = ...) -> list[lief.PE.ImportResolver.import_t]: ...
+    def resolve_ordinal(self, library: str, ordinal: int, importer: str = ...) -> lief.PE.ImportResolver.resolution_t: ...
+    @property
+    def size(self) -> int: ...
+
 class LangCodeItem(lief.Object):
     code_page: lief.PE.CODE_PAGES
     items: dict
@@ -1699,6 +1837,7 @@ class PKCS9TSTInfo(ContentInfo.Content):
     def __init__(self, *args, **kwargs) -> None: ...
 
 class ParserConfig:
+    budget: lief.ParserBudget
     parse_exports: bool
     parse_imports: bool
     parse_reloc: bool
@@ -2697,6 +2836,12 @@ class SigningCertificateV2(Attribute):
     def __init__(self, *args, **kwargs) -> None: ...
 
 class SpcIndirectData(ContentInfo.Content):
+    class page_hash_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def digest(self) -> memoryview: ...
+        @property
+        def offset(self) -> int: ...
     def __init__(self, *args, **kwargs) -> None: ...
     @property
     def digest(self) -> memoryview: ...
@@ -2704,6 +2849,10 @@ class SpcIndirectData(ContentInfo.Content):
     def digest_algorithm(self) -> lief.PE.ALGORITHMS: ...
     @property
     def file(self) -> str: ...
+    @property
+    def page_hash_algorithm(self) -> lief.PE.ALGORITHMS: ...
+    @property
+    def page_hashes(self) -> list[lief.PE.SpcIndirectData.page_hash_t]: ...
 
 class SpcRelaxedPeMarkerCheck(Attribute):
     def __init__(self, *args, **kwargs) -> None: ...
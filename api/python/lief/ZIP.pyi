@@ -0,0 +1,101 @@
+from typing import Any, ClassVar, Optional, Union
+
+from typing import overload
+import io
+import lief # type: ignore
+import lief.ZIP # type: ignore
+import os
+
+class Archive:
+    class dex_pool_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def strings(self) -> list: ...
+        @property
+        def strings_map(self) -> list[list[int]]: ...
+        @property
+        def types(self) -> list[int]: ...
+        @property
+        def types_map(self) -> list[list[int]]: ...
+
+    class it_const_entries:
+        def __init__(self, *args, **kwargs) -> None: ...
+        def __getitem__(self, arg: int, /) -> lief.ZIP.Entry: ...
+        def __iter__(self) -> lief.ZIP.Archive.it_const_entries: ...
+        def __len__(self) -> int: ...
+        def __next__(self) -> lief.ZIP.Entry: ...
+    def __init__(self, *args, **kwargs) -> None: ...
+    def dex_pool(self) -> Union[lief.ZIP.Archive.dex_pool_t,lief.lief_errors]: ...
+    def extract(self, entry: lief.ZIP.Entry, check_crc: bool = ...) -> Union[bytes,lief.lief_errors]: ...
+    def get_entry(self, name: str) -> Optional[lief.ZIP.Entry]: ...
+    def native_libraries(self, abi: str = ...) -> list: ...
+    def parse(self, entry: lief.ZIP.Entry) -> Optional[lief.Binary]: ...
+    def parse_all(self, entries: list[lief.ZIP.Entry], nb_threads: int = ...) -> list: ...
+    def parse_dex(self, entry: lief.ZIP.Entry) -> Optional[lief.DEX.File]: ...
+    def parse_dex_all(self, entries: list[lief.ZIP.Entry], nb_threads: int = ...) -> list: ...
+    @property
+    def dex_files(self) -> list: ...
+    @property
+    def entries(self) -> lief.ZIP.Archive.it_const_entries: ...
+    @property
+    def raw(self) -> bytes: ...
+
+class Entry:
+    class METHOD:
+        DEFLATED: ClassVar[Entry.METHOD] = ...
+        STORED: ClassVar[Entry.METHOD] = ...
+        __name__: str
+        def __init__(self, *args, **kwargs) -> None: ...
+        @staticmethod
+        def from_value(arg: int, /) -> lief.ZIP.Entry.METHOD: ...
+        def __ge__(self, other) -> bool: ...
+        def __gt__(self, other) -> bool: ...
+        def __hash__(self) -> int: ...
+        def __index__(self) -> Any: ...
+        def __int__(self) -> int: ...
+        def __le__(self, other) -> bool: ...
+        def __lt__(self, other) -> bool: ...
+        @property
+        def value(self) -> int: ...
+    def __init__(self, *args, **kwargs) -> None: ...
+    def is_page_aligned(self, page_size: int = ...) -> bool: ...
+    @property
+    def compressed_size(self) -> int: ...
+    @property
+    def crc32(self) -> int: ...
+    @property
+    def data_offset(self) -> int: ...
+    @property
+    def flags(self) -> int: ...
+    @property
+    def is_dex(self) -> bool: ...
+    @property
+    def is_directory(self) -> bool: ...
+    @property
+    def is_encrypted(self) -> bool: ...
+    @property
+    def is_native_library(self) -> bool: ...
+    @property
+    def is_stored(self) -> bool: ...
+    @property
+    def method(self) -> lief.ZIP.Entry.METHOD: ...
+    @property
+    def name(self) -> str: ...
+    @property
+    def offset(self) -> int: ...
+    @property
+    def raw_content(self) -> memoryview: ...
+    @property
+    def size(self) -> int: ...
+
+def crc32(data: bytes, crc: int = ...) -> int: ...
+@overload
+def is_zip(path: str) -> bool: ...
+@overload
+def is_zip(raw: list[int]) -> bool: ...
+@overload
+def parse(filename: str) -> Optional[lief.ZIP.Archive]: ...
+@overload
+def parse(raw: list[int]) -> Optional[lief.ZIP.Archive]: ...
+@overload
+def parse(obj: Union[io.IOBase|os.PathLike]) -> Optional[lief.ZIP.Archive]: ...
@@ -1,6 +1,6 @@
-from typing import Any, ClassVar, Optional, Union
+from typing import Any, Callable, ClassVar, Optional, Union
 
-from . import ART, Android, DEX, ELF, MachO, OAT, PE, VDEX, dwarf, logging, objc, pdb # type: ignore
+from . import AR, ART, Android, DEX, ELF, MachO, OAT, PE, VDEX, ZIP, checksec, dwarf, logging, objc, pdb # type: ignore
 from typing import overload
 import io
 import lief # type: ignore
@@ -103,6 +103,7 @@ class Binary(Object):
     @overload
     def patch_address(self, address: int, patch_value: int, size: int = ..., va_type: lief.Binary.VA_TYPES = ...) -> None: ...
     def remove_section(self, name: str, clear: bool = ...) -> None: ...
+    def symbolizer(self) -> lief.Symbolizer: ...
     def xref(self, virtual_address: int) -> list[int]: ...
     @property
     def abstract(self) -> lief.Binary: ...
@@ -131,6 +132,8 @@ class Binary(Object):
     @property
     def libraries(self) -> list[Union[str,bytes]]: ...
     @property
+    def is_truncated(self) -> bool: ...
+    @property
     def original_size(self) -> int: ...
     @property
     def relocations(self) -> lief.Binary.it_relocations: ...
@@ -138,6 +141,8 @@ class Binary(Object):
     def sections(self) -> lief.Binary.it_sections: ...
     @property
     def symbols(self) -> lief.Binary.it_symbols: ...
+    @property
+    def truncation(self) -> lief.ParserBudget.TRUNCATION: ...
 
 class DebugInfo:
     class FORMAT:
@@ -208,6 +213,78 @@ class Function(Symbol):
     @property
     def flags(self) -> list[lief.Function.FLAGS]: ...
 
+class GoPclntab:
+    class VERSION:
+        GO_1_16: ClassVar[GoPclntab.VERSION] = ...
+        GO_1_18: ClassVar[GoPclntab.VERSION] = ...
+        GO_1_2: ClassVar[GoPclntab.VERSION] = ...
+        GO_1_20: ClassVar[GoPclntab.VERSION] = ...
+        UNKNOWN: ClassVar[GoPclntab.VERSION] = ...
+        __name__: str
+        def __init__(self, *args, **kwargs) -> None: ...
+        @staticmethod
+        def from_value(arg: int, /) -> lief.GoPclntab.VERSION: ...
+        def __ge__(self, other) -> bool: ...
+        def __gt__(self, other) -> bool: ...
+        def __hash__(self) -> int: ...
+        def __index__(self) -> Any: ...
+        def __int__(self) -> int: ...
+        def __le__(self, other) -> bool: ...
+        def __lt__(self, other) -> bool: ...
+        @property
+        def value(self) -> int: ...
+
+    class location_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def file(self) -> str: ...
+        @property
+        def line(self) -> int: ...
+
+    class moduledata_t:
+        def __init__(self, *args, **kwargs) -> None: ...
+        @property
+        def address(self) -> int: ...
+        @property
+        def etext(self) -> int: ...
+        @property
+        def maxpc(self) -> int: ...
+        @property
+        def minpc(self) -> int: ...
+        @property
+        def text(self) -> int: ...
+    NOT_FOUND: ClassVar[int] = ...
+    def __init__(self, *args, **kwargs) -> None: ...
+    def end(self, index: int) -> int: ...
+    def entry(self, index: int) -> int: ...
+    @staticmethod
+    def find(raw: bytes) -> Union[int,lief.lief_errors]: ...
+    @staticmethod
+    def from_binary(binary: lief.Binary) -> Union[lief.GoPclntab,lief.lief_errors]: ...
+    @staticmethod
+    def is_go(binary: lief.Binary) -> bool: ...
+    def location(self, address: int) -> Union[lief.GoPclntab.location_t,lief.lief_errors]: ...
+    def lookup(self, address: int) -> int: ...
+    def moduledata(self, binary: lief.Binary) -> Union[lief.GoPclntab.moduledata_t,lief.lief_errors]: ...
+    def name(self, index: int) -> str: ...
+    @staticmethod
+    def parse(raw: bytes, address: int = ..., text_start: int = ...) -> Union[lief.GoPclntab,lief.lief_errors]: ...
+    def __len__(self) -> int: ...
+    @property
+    def address(self) -> int: ...
+    @property
+    def functions(self) -> list[lief.Function]: ...
+    @property
+    def is_big_endian(self) -> bool: ...
+    @property
+    def pointer_size(self) -> int: ...
+    @property
+    def quantum(self) -> int: ...
+    @property
+    def text_start(self) -> int: ...
+    @property
+    def version(self) -> lief.GoPclntab.VERSION: ...
+
 class Header(Object):
     architecture: lief.ARCHITECTURES
     endianness: lief.ENDIANNESS
@@ -274,6 +351,40 @@ class Object:
     def __init__(self, *args, **kwargs) -> None: ...
     def __hash__(self) -> int: ...
 
+class ParserBudget:
+    class CancellationToken:
+        def __init__(self) -> None: ...
+        def cancel(self) -> None: ...
+        def reset(self) -> None: ...
+        @property
+        def is_cancelled(self) -> bool: ...
+
+    class TRUNCATION:
+        CANCELLED: ClassVar[ParserBudget.TRUNCATION] = ...
+        MEMORY: ClassVar[ParserBudget.TRUNCATION] = ...
+        NONE: ClassVar[ParserBudget.TRUNCATION] = ...
+        OBJECTS: ClassVar[ParserBudget.TRUNCATION] = ...
+        TIME: ClassVar[ParserBudget.TRUNCATION] = ...
+        __name__: str
+        def __init__(self, *args, **kwargs) -> None: ...
+        @staticmethod
+        def from_value(arg: int, /) -> lief.ParserBudget.TRUNCATION: ...
+        def __ge__(self, other) -> bool: ...
+        def __gt__(self, other) -> bool: ...
+        def __hash__(self) -> int: ...
+        def __index__(self) -> Any: ...
+        def __int__(self) -> int: ...
+        def __le__(self, other) -> bool: ...
+        def __lt__(self, other) -> bool: ...
+        @property
+        def value(self) -> int: ...
+    cancellation: lief.ParserBudget.CancellationToken
+    max_memory: int
+    max_objects: int
+    max_time: int
+    progress: Callable[[str, float], None]
+    def __init__(self) -> None: ...
+
 class PLATFORMS:
     ANDROID: ClassVar[PLATFORMS] = ...
     IOS: ClassVar[PLATFORMS] = ...
@@ -328,6 +439,19 @@ class Symbol(Object):
     value: int
     def __init__(self, *args, **kwargs) -> None: ...
 
+class Symbolizer:
+    NOT_FOUND: ClassVar[int] = ...
+    def __init__(self, *args, **kwargs) -> None: ...
+    def end(self, index: int) -> int: ...
+    @overload
+    def lookup(self, address: int) -> int: ...
+    @overload
+    def lookup(self, addresses: list[int]) -> list[int]: ...
+    def name(self, index: int) -> str: ...
+    def start(self, index: int) -> int: ...
+    def symbolize(self, address: int) -> Optional[str]: ...
+    def __len__(self) -> int: ...
+
 class debug_location_t:
     file: str
     line: int
@@ -0,0 +1,116 @@
+from typing import Any, ClassVar, Optional, Union
+
+from typing import overload
+import lief # type: ignore
+import lief.checksec # type: ignore
+
+class FORMAT:
+    ELF: ClassVar[FORMAT] = ...
+    MACHO: ClassVar[FORMAT] = ...
+    PE: ClassVar[FORMAT] = ...
+    UNKNOWN: ClassVar[FORMAT] = ...
+    __name__: str
+    def __init__(self, *args, **kwargs) -> None: ...
+    @staticmethod
+    def from_value(arg: int, /) -> lief.checksec.FORMAT: ...
+    def __ge__(self, other) -> bool: ...
+    def __gt__(self, other) -> bool: ...
+    def __hash__(self) -> int: ...
+    def __index__(self) -> Any: ...
+    def __int__(self) -> int: ...
+    def __le__(self, other) -> bool: ...
+    def __lt__(self, other) -> bool: ...
+    @property
+    def value(self) -> int: ...
+
+class PROPERTY:
+    APPCONTAINER: ClassVar[PROPERTY] = ...
+    BIND_NOW: ClassVar[PROPERTY] = ...
+    CANARY: ClassVar[PROPERTY] = ...
+    CFG: ClassVar[PROPERTY] = ...
+    ENCRYPTED: ClassVar[PROPERTY] = ...
+    FORCE_INTEGRITY: ClassVar[PROPERTY] = ...
+    FORTIFY: ClassVar[PROPERTY] = ...
+    HARDENED_RUNTIME: ClassVar[PROPERTY] = ...
+    HIGH_ENTROPY_VA: ClassVar[PROPERTY] = ...
+    IBT: ClassVar[PROPERTY] = ...
+    LIBRARY_VALIDATION: ClassVar[PROPERTY] = ...
+    NONE: ClassVar[PROPERTY] = ...
+    NO_SEH: ClassVar[PROPERTY] = ...
+    NX: ClassVar[PROPERTY] = ...
+    NX_HEAP: ClassVar[PROPERTY] = ...
+    PAC: ClassVar[PROPERTY] = ...
+    PIE: ClassVar[PROPERTY] = ...
+    RELRO: ClassVar[PROPERTY] = ...
+    RESTRICT: ClassVar[PROPERTY] = ...
+    RPATH: ClassVar[PROPERTY] = ...
+    RUNPATH: ClassVar[PROPERTY] = ...
+    SAFESEH: ClassVar[PROPERTY] = ...
+    SHSTK: ClassVar[PROPERTY] = ...
+    SIGNED: ClassVar[PROPERTY] = ...
+    XFG: ClassVar[PROPERTY] = ...
+    __name__: str
+    def __init__(self, *args, **kwargs) -> None: ...
+    @staticmethod
+    def from_value(arg: int, /) -> lief.checksec.PROPERTY: ...
+    def __abs__(self) -> Any: ...
+    def __add__(self, other) -> Any: ...
+    @overload
+    def __and__(self, arg: int, /) -> int: ...
+    @overload
+    def __and__(self, arg: lief.checksec.PROPERTY, /) -> int: ...
+    def __floordiv__(self, other) -> Any: ...
+    def __ge__(self, arg: int, /) -> bool: ...
+    def __gt__(self, arg: int, /) -> bool: ...
+    def __hash__(self) -> int: ...
+    def __index__(self) -> Any: ...
+    def __int__(self) -> int: ...
+    def __invert__(self) -> int: ...
+    def __le__(self, arg: int, /) -> bool: ...
+    def __lshift__(self, other) -> Any: ...
+    def __lt__(self, arg: int, /) -> bool: ...
+    def __mul__(self, other) -> Any: ...
+    def __neg__(self) -> Any: ...
+    @overload
+    def __or__(self, arg: int, /) -> int: ...
+    @overload
+    def __or__(self, arg: lief.checksec.PROPERTY, /) -> lief.checksec.PROPERTY: ...
+    def __radd__(self, other) -> Any: ...
+    def __rand__(self, arg: int, /) -> int: ...
+    def __rfloordiv__(self, other) -> Any: ...
+    def __rlshift__(self, other) -> Any: ...
+    def __rmul__(self, other) -> Any: ...
+    def __ror__(self, arg: int, /) -> int: ...
+    def __rrshift__(self, other) -> Any: ...
+    def __rshift__(self, other) -> Any: ...
+    def __rsub__(self, other) -> Any: ...
+    def __rxor__(self, arg: int, /) -> int: ...
+    def __sub__(self, other) -> Any: ...
+    @overload
+    def __xor__(self, arg: int, /) -> int: ...
+    @overload
+    def __xor__(self, arg: lief.checksec.PROPERTY, /) -> int: ...
+    @property
+    def value(self) -> int: ...
+
+class report_t:
+    def __init__(self, *args, **kwargs) -> None: ...
+    def has(self, property: lief.checksec.PROPERTY) -> bool: ...
+    def is_checked(self, property: lief.checksec.PROPERTY) -> bool: ...
+    @property
+    def checked(self) -> lief.checksec.PROPERTY: ...
+    @property
+    def format(self) -> lief.checksec.FORMAT: ...
+    @property
+    def full_relro(self) -> bool: ...
+    @property
+    def nb_slices(self) -> int: ...
+    @property
+    def properties(self) -> lief.checksec.PROPERTY: ...
+
+@overload
+def audit(path: str) -> Union[lief.checksec.report_t,lief.lief_errors]: ...
+@overload
+def audit(raw: bytes) -> Union[lief.checksec.report_t,lief.lief_errors]: ...
+@overload
+def audit(paths: list[str], nb_threads: int = ...) -> list[Union[lief.checksec.report_t,lief.lief_errors]]: ...
@@ -0,0 +1,138 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "LIEF/AR/Archive.hpp"
+#include "LIEF/AR/Member.hpp"
+#include "LIEF/Abstract/Binary.hpp"
+
+#include "AR/pyAR.hpp"
+#include "pyIterator.hpp"
+#include "enums_wrapper.hpp"
+
+#include <sstream>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/unique_ptr.h>
+
+namespace LIEF::AR::py {
+template<>
+void create<Archive>(nb::module_& m) {
+  using namespace LIEF::py;
+
+  nb::class_<Archive> archive(m, "Archive",
+      R"delim(
+      This class represents a static archive (``.a``, ``.lib``) made of object
+      files.
+
+      The members of MSVC ``.lib`` archives are bare COFF objects which are
+      not supported by LIEF's PE parser: their symbols are indexed but
+      :meth:`~lief.AR.Archive.parse` returns ``None`` for them.
+
+      .. code-block:: python
+
+        ar = lief.AR.parse("libfoo.a")
+        member = ar.find_symbol("foo_init")
+        elf = ar.parse(member)
+      )delim"_doc);
+
+  #define ENTRY(X) .value(to_string(Archive::KIND::X), Archive::KIND::X)
+  enum_<Archive::KIND>(archive, "KIND")
+    ENTRY(UNKNOWN)
+    ENTRY(GNU)
+    ENTRY(BSD)
+    ENTRY(COFF);
+  #undef ENTRY
+
+  init_ref_iterator<Archive::it_const_members>(archive, "it_const_members");
+
+  archive
+    .def_prop_ro("kind", &Archive::kind,
+        "Flavor of the archive"_doc)
+
+    .def_prop_ro("members", &Archive::members,
+        R"delim(
+        Iterator over the regular members of the archive (i.e. without the
+        symbol tables and the long names table)
+        )delim"_doc,
+        nb::keep_alive<0, 1>())
+
+    .def("get_member", &Archive::get_member,
+        "Return the member with the given name or None if not found"_doc,
+        "name"_a, nb::rv_policy::reference_internal)
+
+    .def_prop_ro("symbols",
+        [] (const Archive& self) {
+          nb::dict symbols;
+          nb::handle parent = nb::find(self);
+          for (const auto& [name, member] : self.symbols()) {
+            nb::object py_member = nb::cast(member, nb::rv_policy::reference);
+            // Same as reference_internal: the member keeps the archive alive
+            nb::detail::keep_alive(py_member.ptr(), parent.ptr());
+            symbols[nb::str(name.c_str(), name.size())] = std::move(py_member);
+          }
+          return symbols;
+        },
+        R"delim(
+        Symbols indexed by the archive's symbol table as a dictionary
+        ``name -> member``
+        )delim"_doc)
+
+    .def("find_symbol", &Archive::find_symbol,
+        R"delim(
+        Return the member that defines the given symbol according to the
+        archive's symbol table (or None). It does not require to parse the
+        members.
+        )delim"_doc,
+        "name"_a, nb::rv_policy::reference_internal)
+
+    .def("has_symbol", &Archive::has_symbol,
+        "Check if the given symbol is defined in the archive's symbol table"_doc,
+        "name"_a)
+
+    .def("parse", nb::overload_cast<const Member&>(&Archive::parse, nb::const_),
+        R"delim(
+        Parse the given member with the format-specific parser (ELF, PE,
+        Mach-O) or return None if the member is not supported.
+        )delim"_doc,
+        "member"_a, nb::rv_policy::take_ownership)
+
+    .def("parse",
+        [] (const Archive& self, uint32_t nb_threads) {
+          std::vector<std::unique_ptr<Binary>> binaries;
+          {
+            nb::gil_scoped_release release;
+            binaries = self.parse(nb_threads);
+          }
+          nb::list out;
+          for (std::unique_ptr<Binary>& bin : binaries) {
+            out.append(nb::cast(bin.release(), nb::rv_policy::take_ownership));
+          }
+          return out;
+        },
+        R"delim(
+        Parse all the members of the archive that are supported by LIEF from at
+        most ``nb_threads`` threads (0: number of hardware threads)
+        )delim"_doc,
+        "nb_threads"_a = 0)
+
+    .def_prop_ro("raw",
+        [] (const Archive& self) {
+          const std::vector<uint8_t>& raw = self.raw();
+          return nb::bytes(reinterpret_cast<const char*>(raw.data()), raw.size());
+        }, "Raw data of the archive"_doc)
+
+    LIEF_DEFAULT_STR(Archive);
+}
+
+}
@@ -0,0 +1,73 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "LIEF/AR/Member.hpp"
+
+#include "AR/pyAR.hpp"
+
+#include <sstream>
+#include <nanobind/stl/string.h>
+#include "nanobind/extra/memoryview.hpp"
+
+namespace LIEF::AR::py {
+template<>
+void create<Member>(nb::module_& m) {
+  nb::class_<Member>(m, "Member",
+      R"delim(
+      This class represents a member (i.e. an embedded file) of a static
+      archive. Its content references the data of the
+      :class:`~lief.AR.Archive` that contains it.
+      )delim"_doc)
+
+    .def_prop_ro("name", &Member::name,
+        "Name of the member (resolved from the GNU/BSD long name tables)"_doc)
+
+    .def_prop_ro("date", &Member::date,
+        "Modification timestamp"_doc)
+
+    .def_prop_ro("uid", &Member::uid,
+        "User ID"_doc)
+
+    .def_prop_ro("gid", &Member::gid,
+        "Group ID"_doc)
+
+    .def_prop_ro("mode", &Member::mode,
+        "File mode"_doc)
+
+    .def_prop_ro("offset", &Member::offset,
+        "Offset of the member's header in the archive"_doc)
+
+    .def_prop_ro("data_offset", &Member::data_offset,
+        "Offset of the member's content in the archive"_doc)
+
+    .def_prop_ro("size", &Member::size,
+        "Size of the member's content"_doc)
+
+    .def_prop_ro("content",
+        [] (const Member& self) {
+          const span<const uint8_t> content = self.content();
+          return nb::memoryview::from_memory(content.data(), content.size());
+        }, "Raw content of the member"_doc)
+
+    .def_prop_ro("format", &Member::format,
+        R"delim(
+        Executable format (:class:`lief.Binary.FORMATS`) of the member or
+        ``UNKNOWN`` for other kind of members (e.g. COFF objects).
+        )delim"_doc)
+
+    LIEF_DEFAULT_STR(Member);
+}
+
+}
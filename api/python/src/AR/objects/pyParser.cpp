@@ -0,0 +1,68 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "LIEF/AR/Parser.hpp"
+#include "LIEF/AR/Archive.hpp"
+#include "LIEF/logging.hpp"
+
+#include "AR/pyAR.hpp"
+
+#include "typing/InputParser.hpp"
+#include "pyutils.hpp"
+#include "pyIOStream.hpp"
+
+#include <string>
+#include <memory>
+
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+#include <nanobind/stl/unique_ptr.h>
+
+namespace LIEF::AR::py {
+
+template<>
+void create<Parser>(nb::module_& m) {
+  using namespace LIEF::py;
+
+  m.def("parse",
+    nb::overload_cast<const std::string&>(&Parser::parse),
+    "Parse the given filename and return an " RST_CLASS_REF(lief.AR.Archive) " object"_doc,
+    "filename"_a,
+    nb::rv_policy::take_ownership);
+
+  m.def("parse",
+    nb::overload_cast<std::vector<uint8_t>>(&Parser::parse),
+    "Parse the given raw data and return an " RST_CLASS_REF(lief.AR.Archive) " object"_doc,
+    "raw"_a,
+    nb::rv_policy::take_ownership);
+
+  m.def("parse",
+    [] (typing::InputParser obj) -> std::unique_ptr<Archive> {
+      if (auto path_str = path_to_str(obj)) {
+        return Parser::parse(std::move(*path_str));
+      }
+
+      if (auto stream = PyIOStream::from_python(obj)) {
+        return Parser::parse(stream->move_content());
+      }
+      logging::log(logging::LEVEL::ERR,
+                   "LIEF parser interface does not support Python object: " +
+                   type2str(obj));
+      return nullptr;
+    },
+    "obj"_a,
+    nb::rv_policy::take_ownership);
+}
+}
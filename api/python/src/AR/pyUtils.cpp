@@ -0,0 +1,34 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AR/pyAR.hpp"
+
+#include "LIEF/AR/utils.hpp"
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+
+namespace LIEF::AR::py {
+
+void init_utils(nb::module_& m) {
+  m.def("is_archive", nb::overload_cast<const std::string&>(&is_archive),
+      "Check if the **file** given in parameter is a static archive"_doc,
+      "path"_a);
+
+  m.def("is_archive", nb::overload_cast<const std::vector<uint8_t>&>(&is_archive),
+      "Check if the **raw data** given in parameter is a static archive"_doc,
+      "raw"_a);
+}
+
+}
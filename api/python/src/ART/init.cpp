@@ -19,6 +19,7 @@
 #include "LIEF/ART/Parser.hpp"
 #include "LIEF/ART/File.hpp"
 #include "LIEF/ART/Header.hpp"
+#include "LIEF/ART/ImageReader.hpp"
 #include "LIEF/ART/enums.hpp"
 #include "LIEF/ART/EnumToString.hpp"
 
@@ -32,6 +33,7 @@ inline void init_objects(nb::module_& m) {
   CREATE(Parser, m);
   CREATE(File, m);
   CREATE(Header, m);
+  CREATE(ImageReader, m);
 }
 
 inline void init_enums(nb::module_& m) {
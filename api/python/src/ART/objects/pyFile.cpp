@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "LIEF/ART/File.hpp"
+#include "LIEF/ART/ImageReader.hpp"
 
 #include "ART/pyART.hpp"
 
@@ -30,6 +31,13 @@ void create<File>(nb::module_& m) {
         nb::overload_cast<>(&File::header),
         "Return the ART " RST_CLASS_REF(lief.ART.Header) ""_doc,
         nb::rv_policy::reference_internal)
+
+    .def_prop_ro("image", &File::image,
+        R"delim(
+        Lazy reader (:class:`~lief.ART.ImageReader`) over the image sections
+        or None if they can't be read
+        )delim"_doc,
+        nb::rv_policy::reference_internal)
     LIEF_DEFAULT_STR(Header);
 }
 
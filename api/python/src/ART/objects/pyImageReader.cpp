@@ -0,0 +1,219 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ART/pyART.hpp"
+#include "pyErr.hpp"
+
+#include "LIEF/ART/ImageReader.hpp"
+
+#include "enums_wrapper.hpp"
+
+#include <string>
+#include <nanobind/make_iterator.h>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+
+namespace LIEF::ART::py {
+
+template<>
+void create<ImageReader>(nb::module_& m) {
+  using namespace LIEF::py;
+
+  nb::class_<ImageReader> reader(m, "ImageReader",
+      R"delim(
+      Lazy reader over the sections of an ART image (objects, ArtFields,
+      ArtMethods, DexCache, interned strings, class table).
+
+      The data are read when they are queried and the LZ4 compressed images
+      are decompressed on the first access to their content.
+
+      .. code-block:: python
+
+        boot = lief.ART.parse("boot.art")
+        image = boot.image
+
+        for cls in image.class_table:
+          print(image.class_name(cls))
+
+        obj = image.find_object(0x70a7ea64)
+        print(obj.kind, image.class_name(obj.klass))
+      )delim"_doc);
+
+  #define ENTRY(X) .value(to_string(ImageReader::SECTION::X), ImageReader::SECTION::X)
+  enum_<ImageReader::SECTION>(reader, "SECTION")
+    ENTRY(UNKNOWN)
+    ENTRY(OBJECTS)
+    ENTRY(ART_FIELDS)
+    ENTRY(ART_METHODS)
+    ENTRY(RUNTIME_METHODS)
+    ENTRY(IM_TABLES)
+    ENTRY(IMT_CONFLICT_TABLES)
+    ENTRY(DEX_CACHE_ARRAYS)
+    ENTRY(INTERNED_STRINGS)
+    ENTRY(CLASS_TABLE)
+    ENTRY(IMAGE_BITMAP);
+  #undef ENTRY
+
+  #define ENTRY(X) .value(to_string(ImageReader::OBJECT_KIND::X), ImageReader::OBJECT_KIND::X)
+  enum_<ImageReader::OBJECT_KIND>(reader, "OBJECT_KIND")
+    ENTRY(INSTANCE)
+    ENTRY(CLASS)
+    ENTRY(ARRAY)
+    ENTRY(STRING);
+  #undef ENTRY
+
+  nb::class_<ImageReader::section_t>(reader, "section_t")
+    .def_ro("type", &ImageReader::section_t::type)
+    .def_ro("offset", &ImageReader::section_t::offset)
+    .def_ro("size", &ImageReader::section_t::size);
+
+  nb::class_<ImageReader::object_t>(reader, "object_t")
+    .def_ro("address", &ImageReader::object_t::address)
+    .def_ro("klass", &ImageReader::object_t::klass,
+            "Address of the class of this object"_doc)
+    .def_ro("size", &ImageReader::object_t::size)
+    .def_ro("kind", &ImageReader::object_t::kind)
+    .def_ro("length", &ImageReader::object_t::length,
+            "Number of elements for an array or number of characters for a string"_doc);
+
+  nb::class_<ImageReader::art_field_t>(reader, "art_field_t")
+    .def_ro("address", &ImageReader::art_field_t::address)
+    .def_ro("declaring_class", &ImageReader::art_field_t::declaring_class)
+    .def_ro("access_flags", &ImageReader::art_field_t::access_flags)
+    .def_ro("dex_field_index", &ImageReader::art_field_t::dex_field_index)
+    .def_ro("offset", &ImageReader::art_field_t::offset);
+
+  nb::class_<ImageReader::art_method_t>(reader, "art_method_t")
+    .def_ro("address", &ImageReader::art_method_t::address)
+    .def_ro("declaring_class", &ImageReader::art_method_t::declaring_class)
+    .def_ro("access_flags", &ImageReader::art_method_t::access_flags)
+    .def_ro("dex_code_item_offset", &ImageReader::art_method_t::dex_code_item_offset)
+    .def_ro("dex_method_index", &ImageReader::art_method_t::dex_method_index)
+    .def_ro("method_index", &ImageReader::art_method_t::method_index)
+    .def_ro("entry_point", &ImageReader::art_method_t::entry_point,
+            "Quick (compiled) code entry point"_doc);
+
+  nb::class_<ImageReader::dex_cache_t>(reader, "dex_cache_t")
+    .def_ro("address", &ImageReader::dex_cache_t::address)
+    .def_ro("location", &ImageReader::dex_cache_t::location)
+    .def_ro("strings", &ImageReader::dex_cache_t::strings)
+    .def_ro("nb_strings", &ImageReader::dex_cache_t::nb_strings)
+    .def_ro("resolved_types", &ImageReader::dex_cache_t::resolved_types)
+    .def_ro("nb_resolved_types", &ImageReader::dex_cache_t::nb_resolved_types)
+    .def_ro("resolved_methods", &ImageReader::dex_cache_t::resolved_methods)
+    .def_ro("nb_resolved_methods", &ImageReader::dex_cache_t::nb_resolved_methods)
+    .def_ro("resolved_fields", &ImageReader::dex_cache_t::resolved_fields)
+    .def_ro("nb_resolved_fields", &ImageReader::dex_cache_t::nb_resolved_fields);
+
+  reader
+    .def_prop_ro("image_begin", &ImageReader::image_begin,
+        "Base address of the image"_doc)
+    .def_prop_ro("image_size", &ImageReader::image_size)
+    .def_prop_ro("pointer_size", &ImageReader::pointer_size)
+    .def_prop_ro("sections", &ImageReader::sections,
+        nb::rv_policy::reference_internal)
+
+    .def("get", &ImageReader::get,
+        "Return the section with the given type or None"_doc,
+        "type"_a, nb::rv_policy::reference_internal)
+
+    .def("contains", &ImageReader::contains,
+        "Whether the given address is located in the image"_doc,
+        "address"_a)
+
+    .def("read",
+        [] (const ImageReader& self, uint64_t address, size_t size) {
+          return error_or([&] () -> result<nb::bytes> {
+            auto data = self.read(address, size);
+            if (!data) {
+              return make_error_code(get_error(data));
+            }
+            return nb::bytes(reinterpret_cast<const char*>(data->data()), data->size());
+          });
+        },
+        "Read ``size`` bytes at the given address"_doc,
+        "address"_a, "size"_a)
+
+    .def_prop_ro("objects",
+        [] (const ImageReader& self) {
+          auto objects = self.objects();
+          return nb::make_iterator(nb::type<ImageReader>(), "objects_it", objects);
+        }, nb::keep_alive<0, 1>(),
+        "Iterator over the objects of the ``OBJECTS`` section (decoded on the fly)"_doc)
+
+    .def("object",
+        [] (const ImageReader& self, uint64_t address) {
+          return error_or(&ImageReader::object, self, address);
+        },
+        "Decode the object that starts at the given address"_doc,
+        "address"_a)
+
+    .def("find_object",
+        [] (const ImageReader& self, uint64_t address) {
+          return error_or(&ImageReader::find_object, self, address);
+        },
+        "Return the object that **contains** the given address"_doc,
+        "address"_a)
+
+    .def("string",
+        [] (const ImageReader& self, uint64_t address) {
+          return error_or(&ImageReader::string, self, address);
+        },
+        "Decode the ``java.lang.String`` at the given address"_doc,
+        "address"_a)
+
+    .def("class_name",
+        [] (const ImageReader& self, uint64_t address) {
+          return error_or(&ImageReader::class_name, self, address);
+        },
+        "Name of the ``java.lang.Class`` at the given address"_doc,
+        "address"_a)
+
+    .def_prop_ro("class_roots", &ImageReader::class_roots,
+        "Classes referenced by the ``CLASS_ROOTS`` image root"_doc)
+
+    .def_prop_ro("dex_caches", &ImageReader::dex_caches,
+        "``java.lang.DexCache`` objects referenced by the ``DEX_CACHES`` image root"_doc)
+
+    .def_prop_ro("art_fields", &ImageReader::art_fields,
+        "``ArtField`` of the ``ART_FIELDS`` section"_doc)
+
+    .def_prop_ro("art_methods", &ImageReader::art_methods,
+        "``ArtMethod`` of the ``ART_METHODS`` and ``RUNTIME_METHODS`` sections"_doc)
+
+    .def("art_field",
+        [] (const ImageReader& self, uint64_t address) {
+          return error_or(&ImageReader::art_field, self, address);
+        },
+        "Decode the ``ArtField`` at the given address"_doc,
+        "address"_a)
+
+    .def("art_method",
+        [] (const ImageReader& self, uint64_t address) {
+          return error_or(&ImageReader::art_method, self, address);
+        },
+        "Decode the ``ArtMethod`` at the given address"_doc,
+        "address"_a)
+
+    .def_prop_ro("interned_strings", &ImageReader::interned_strings,
+        "Addresses of the strings registered in the intern table"_doc)
+
+    .def_prop_ro("class_table", &ImageReader::class_table,
+        "Addresses of the classes registered in the class table"_doc)
+
+    .def_prop_ro("nb_decoded_blocks", &ImageReader::nb_decoded_blocks,
+        "Number of compressed blocks that have been decompressed so far"_doc);
+}
+}
@@ -21,9 +21,12 @@
 #include "LIEF/Abstract/Binary.hpp"
 #include "LIEF/Abstract/Section.hpp"
 #include "LIEF/Abstract/Symbol.hpp"
+#include "LIEF/Abstract/Symbolizer.hpp"
 #include "LIEF/Abstract/Parser.hpp"
+#include "LIEF/Abstract/ParserBudget.hpp"
 #include "LIEF/Abstract/Relocation.hpp"
 #include "LIEF/Abstract/Function.hpp"
+#include "LIEF/Abstract/GoPclntab.hpp"
 #include "LIEF/Abstract/DebugInfo.hpp"
 
 #define CREATE(X,Y) create<X>(Y)
@@ -31,13 +34,16 @@
 namespace LIEF::py {
 
 void init_objects(nb::module_& m) {
+  CREATE(ParserBudget, m);
   CREATE(Header, m);
   CREATE(Binary, m);
   CREATE(Section, m);
   CREATE(Symbol, m);
+  CREATE(Symbolizer, m);
   CREATE(Parser, m);
   CREATE(Relocation, m);
   CREATE(Function, m);
+  CREATE(GoPclntab, m);
   CREATE(DebugInfo, m);
 }
 void init_abstract(nb::module_& m) {
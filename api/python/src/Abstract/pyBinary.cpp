@@ -31,6 +31,7 @@
 #include "LIEF/Abstract/Binary.hpp"
 #include "LIEF/Abstract/Relocation.hpp"
 #include "LIEF/Abstract/Symbol.hpp"
+#include "LIEF/Abstract/Symbolizer.hpp"
 #include "LIEF/Abstract/Section.hpp"
 #include "LIEF/Abstract/Header.hpp"
 #include "LIEF/Abstract/EnumToString.hpp"
@@ -269,6 +270,13 @@ void create<Binary>(nb::module_& m) {
         &Binary::ctor_functions,
         "Constructor functions that are called prior to any other functions"_doc)
 
+    .def("symbolizer",
+        &Binary::symbolizer,
+        R"delim(
+        Build a :class:`~lief.Symbolizer` that resolves virtual addresses into
+        the name of the symbol or the function that contains them.
+        )delim"_doc)
+
     .def("xref",
         &Binary::xref,
         "Return all **virtual addresses** that *use* the ``address`` given in parameter"_doc,
@@ -289,6 +297,15 @@ void create<Binary>(nb::module_& m) {
         nb::overload_cast<>(&LIEF::Binary::original_size, nb::const_),
         "Original size of the binary"_doc)
 
+    .def_prop_ro("truncation", &LIEF::Binary::truncation,
+        R"delim(
+        Reason (:class:`~lief.ParserBudget.TRUNCATION`) why the parsing stopped
+        before completion (c.f. :class:`~lief.ParserBudget`)
+        )delim"_doc)
+
+    .def_prop_ro("is_truncated", &LIEF::Binary::is_truncated,
+        "Whether the binary is only partially parsed because of the parser's budget"_doc)
+
     LIEF_DEFAULT_STR(Binary);
 
 }
@@ -0,0 +1,158 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+
+#include "Abstract/init.hpp"
+#include "pyLIEF.hpp"
+#include "pyErr.hpp"
+#include "enums_wrapper.hpp"
+
+#include "LIEF/Abstract/Binary.hpp"
+#include "LIEF/Abstract/Function.hpp"
+#include "LIEF/Abstract/GoPclntab.hpp"
+
+namespace LIEF::py {
+
+template<>
+void create<GoPclntab>(nb::module_& m) {
+  nb::class_<GoPclntab> tab(m, "GoPclntab",
+      R"delim(
+      This class decodes the function table (``runtime.pclntab``) that the Go
+      toolchain embeds in the ELF, PE and Mach-O binaries. The table is still
+      present in stripped binaries and provides the boundaries, the names and
+      the source locations of all the Go functions (Go 1.2+).
+
+      The entries are decoded lazily from the content of the binary which must
+      outlive this object.
+
+      .. code-block:: python
+
+        binary = lief.parse("go-stripped.exe")
+        pclntab = lief.GoPclntab.from_binary(binary)
+        idx = pclntab.lookup(0x4a1234)
+        print(pclntab.name(idx), pclntab.location(0x4a1234))
+      )delim"_doc);
+
+  #define ENTRY(X) .value(to_string(GoPclntab::VERSION::X), GoPclntab::VERSION::X)
+  enum_<GoPclntab::VERSION>(tab, "VERSION")
+    ENTRY(UNKNOWN)
+    ENTRY(GO_1_2)
+    ENTRY(GO_1_16)
+    ENTRY(GO_1_18)
+    ENTRY(GO_1_20);
+  #undef ENTRY
+
+  nb::class_<GoPclntab::location_t>(tab, "location_t")
+    .def_ro("file", &GoPclntab::location_t::file)
+    .def_ro("line", &GoPclntab::location_t::line);
+
+  nb::class_<GoPclntab::moduledata_t>(tab, "moduledata_t")
+    .def_ro("address", &GoPclntab::moduledata_t::address,
+            "Virtual address of the structure"_doc)
+    .def_ro("minpc", &GoPclntab::moduledata_t::minpc)
+    .def_ro("maxpc", &GoPclntab::moduledata_t::maxpc)
+    .def_ro("text", &GoPclntab::moduledata_t::text)
+    .def_ro("etext", &GoPclntab::moduledata_t::etext);
+
+  tab
+    .def_prop_ro_static("NOT_FOUND",
+        [] (nb::handle) { return GoPclntab::NOT_FOUND; },
+        "Value returned by :meth:`~.lookup` for an address out of the table"_doc)
+
+    .def_static("from_binary",
+        [] (const Binary& bin) {
+          return error_or(&GoPclntab::from_binary, bin);
+        },
+        "Locate and decode the table of the given binary"_doc,
+        "binary"_a, nb::keep_alive<0, 1>())
+
+    .def_static("parse",
+        [] (nb::bytes raw, uint64_t address, uint64_t text_start) {
+          auto ptr = reinterpret_cast<const uint8_t*>(raw.c_str());
+          return error_or(&GoPclntab::parse, span<const uint8_t>(ptr, raw.size()),
+                          address, text_start);
+        },
+        R"delim(
+        Decode the table from its raw content. The ``text_start`` is only used
+        (Go 1.18+) if the table's field is not relocated.
+        )delim"_doc,
+        "raw"_a, "address"_a = 0, "text_start"_a = 0, nb::keep_alive<0, 1>())
+
+    .def_static("find",
+        [] (nb::bytes raw) {
+          auto ptr = reinterpret_cast<const uint8_t*>(raw.c_str());
+          return error_or(&GoPclntab::find, span<const uint8_t>(ptr, raw.size()));
+        },
+        "Offset of the first valid table header in the given buffer"_doc,
+        "raw"_a)
+
+    .def_static("is_go", &GoPclntab::is_go,
+        "Whether the given binary has been produced by the Go toolchain"_doc,
+        "binary"_a)
+
+    .def_prop_ro("version", &GoPclntab::version)
+
+    .def_prop_ro("address", &GoPclntab::address,
+        "Virtual address of the table"_doc)
+
+    .def_prop_ro("quantum", &GoPclntab::quantum,
+        "Instruction size quantum (1 on x86, 4 on ARM, ...)"_doc)
+
+    .def_prop_ro("pointer_size", &GoPclntab::pointer_size)
+
+    .def_prop_ro("is_big_endian", &GoPclntab::is_big_endian)
+
+    .def_prop_ro("text_start", &GoPclntab::text_start,
+        "Base address of the function offsets (Go 1.18+)"_doc)
+
+    .def("entry", &GoPclntab::entry,
+        "Entry address of the function at the given index"_doc, "index"_a)
+
+    .def("end", &GoPclntab::end,
+        "End address (excluded) of the function at the given index"_doc, "index"_a)
+
+    .def("name", &GoPclntab::name,
+        "Name of the function at the given index"_doc, "index"_a)
+
+    .def("lookup", &GoPclntab::lookup,
+        R"delim(
+        Index of the function that contains the given address or
+        :attr:`~.NOT_FOUND`
+        )delim"_doc, "address"_a)
+
+    .def("location",
+        [] (const GoPclntab& self, uint64_t address) {
+          return error_or(&GoPclntab::location, self, address);
+        },
+        "Source file and line of the given address"_doc, "address"_a)
+
+    .def_prop_ro("functions", &GoPclntab::functions,
+        "All the functions of the table"_doc)
+
+    .def("moduledata",
+        [] (const GoPclntab& self, const Binary& bin) {
+          return error_or(&GoPclntab::moduledata, self, bin);
+        },
+        R"delim(
+        Find the ``moduledata`` structure that references this table in the
+        data of the given binary
+        )delim"_doc, "binary"_a)
+
+    .def("__len__", &GoPclntab::size);
+}
+
+}
@@ -0,0 +1,80 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/function.h>
+
+#include "Abstract/init.hpp"
+#include "pyLIEF.hpp"
+
+#include "LIEF/Abstract/ParserBudget.hpp"
+
+#define PY_ENUM(x) LIEF::to_string(x), x
+
+namespace LIEF::py {
+
+template<>
+void create<ParserBudget>(nb::module_& m) {
+  nb::class_<ParserBudget> pybudget(m, "ParserBudget",
+      R"delim(
+      This class defines the resources (memory, time, number of objects) that
+      a parser can use. It is embedded in :attr:`lief.ELF.ParserConfig.budget`,
+      :attr:`lief.PE.ParserConfig.budget` and :attr:`lief.MachO.ParserConfig.budget`.
+
+      When a budget is exhausted or when the parsing is cancelled, the parser
+      returns the objects parsed so far and the reason is available with
+      :attr:`lief.Binary.truncation`.
+      )delim"_doc);
+
+  nb::enum_<ParserBudget::TRUNCATION>(pybudget, "TRUNCATION")
+    .value(PY_ENUM(ParserBudget::TRUNCATION::NONE))
+    .value(PY_ENUM(ParserBudget::TRUNCATION::CANCELLED))
+    .value(PY_ENUM(ParserBudget::TRUNCATION::TIME))
+    .value(PY_ENUM(ParserBudget::TRUNCATION::MEMORY))
+    .value(PY_ENUM(ParserBudget::TRUNCATION::OBJECTS));
+
+  nb::class_<ParserBudget::CancellationToken>(pybudget, "CancellationToken",
+      R"delim(
+      Token that can be used (from another thread) to stop a parsing in progress
+      )delim"_doc)
+    .def(nb::init<>())
+    .def("cancel", &ParserBudget::CancellationToken::cancel)
+    .def("reset", &ParserBudget::CancellationToken::reset)
+    .def_prop_ro("is_cancelled", &ParserBudget::CancellationToken::is_cancelled);
+
+  pybudget
+    .def(nb::init<>())
+    .def_rw("max_memory", &ParserBudget::max_memory,
+            "Maximum amount of memory (in bytes) used by the parsed objects (0: unlimited)"_doc)
+
+    .def_rw("max_time", &ParserBudget::max_time,
+            "Maximum duration of the parsing in milliseconds (0: unlimited)"_doc)
+
+    .def_rw("max_objects", &ParserBudget::max_objects,
+            R"delim(
+            Maximum number of entries processed for a table (symbols, relocations, ...).
+            It can't exceed the format's default limits which apply when it is 0.
+            )delim"_doc)
+
+    .def_rw("cancellation", &ParserBudget::cancellation,
+            "Token used to cancel the parsing"_doc)
+
+    .def_rw("progress", &ParserBudget::progress,
+            R"delim(
+            Callback triggered at the beginning of each parsing stage with the
+            stage name and the progress in the range ``[0, 1]``
+            )delim"_doc);
+}
+}
@@ -0,0 +1,84 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+
+#include "Abstract/init.hpp"
+#include "pyLIEF.hpp"
+
+#include "LIEF/Abstract/Symbolizer.hpp"
+
+namespace LIEF::py {
+
+template<>
+void create<Symbolizer>(nb::module_& m) {
+  nb::class_<Symbolizer>(m, "Symbolizer",
+      R"delim(
+      This class resolves virtual addresses into the name of the symbol
+      (or the function) that contains them.
+
+      It is created with :meth:`lief.Binary.symbolizer` which merges the
+      symbols of the binary with the functions discovered from format-specific
+      sources. The lookups return the index of a range or
+      :attr:`~.Symbolizer.NOT_FOUND`.
+
+      .. code-block:: python
+
+        sym = binary.symbolizer()
+        print(sym.symbolize(0x401126))
+
+        indexes = sym.lookup([0x401126, 0x401200])
+      )delim"_doc)
+
+    .def_prop_ro_static("NOT_FOUND",
+        [] (nb::handle) { return Symbolizer::NOT_FOUND; },
+        "Value returned by the lookup functions for an unresolved address"_doc)
+
+    .def("lookup",
+        nb::overload_cast<uint64_t>(&Symbolizer::lookup, nb::const_),
+        "Return the index of the range that contains the given address"_doc,
+        "address"_a)
+
+    .def("lookup",
+        nb::overload_cast<const std::vector<uint64_t>&>(&Symbolizer::lookup, nb::const_),
+        "Batch version of :meth:`~.lookup`"_doc,
+        "addresses"_a)
+
+    .def("symbolize",
+        [] (const Symbolizer& self, uint64_t address) -> nb::object {
+          if (const std::string* name = self.symbolize(address)) {
+            return nb::str(name->c_str());
+          }
+          return nb::none();
+        },
+        R"delim(
+        Return the name of the symbol that contains the given address or
+        None if it can't be resolved
+        )delim"_doc, "address"_a)
+
+    .def("start", &Symbolizer::start,
+        "Start address of the range at the given index"_doc, "index"_a)
+
+    .def("end", &Symbolizer::end,
+        "End address (excluded) of the range at the given index"_doc, "index"_a)
+
+    .def("name", &Symbolizer::name,
+        "Name of the range at the given index (can be empty)"_doc, "index"_a)
+
+    .def("__len__", &Symbolizer::size);
+}
+
+}
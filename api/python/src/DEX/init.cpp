@@ -27,6 +27,7 @@
 #include "LIEF/DEX/MapList.hpp"
 #include "LIEF/DEX/MapItem.hpp"
 #include "LIEF/DEX/CodeInfo.hpp"
+#include "LIEF/DEX/XRef.hpp"
 
 #define CREATE(X,Y) create<X>(Y)
 
@@ -43,6 +44,7 @@ void init_objects(nb::module_& m) {
   CREATE(MapList, m);
   CREATE(MapItem, m);
   CREATE(CodeInfo, m);
+  CREATE(XRef, m);
 }
 
 void init(nb::module_& m) {
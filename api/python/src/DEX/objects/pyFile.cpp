@@ -93,9 +93,18 @@ void create<File>(nb::module_& m) {
         "Dex " RST_CLASS_REF(lief.DEX.MapList) ""_doc)
 
     .def("raw", &File::raw,
-        "Original raw file"_doc,
+        R"delim(
+        Original raw file. If ``deoptimize`` is set, the dex2dex instructions
+        are reverted and the checksum and the signature are recomputed.
+        )delim"_doc,
         "deoptimize"_a = true)
 
+    .def("verify_checksum", &File::verify_checksum,
+        "Check the Adler-32 checksum of the header against the original file"_doc)
+
+    .def("verify_signature", &File::verify_signature,
+        "Check the SHA-1 signature of the header against the original file"_doc)
+
     .def_prop_rw("name",
         nb::overload_cast<>(&File::name, nb::const_),
         nb::overload_cast<const std::string&>(&File::name),
@@ -0,0 +1,123 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DEX/pyDEX.hpp"
+
+#include "LIEF/DEX/XRef.hpp"
+#include "LIEF/DEX/File.hpp"
+#include "LIEF/DEX/Method.hpp"
+#include "LIEF/DEX/Field.hpp"
+
+#include <nanobind/stl/vector.h>
+
+namespace LIEF::DEX::py {
+
+template<>
+void create<XRef>(nb::module_& m) {
+  // Copy the (sorted) indexes in a Python list
+  using getter_t = span<const uint32_t>(XRef::*)(uint32_t) const;
+  auto to_list = [] (getter_t fn) {
+    return [fn] (const XRef& self, uint32_t idx) {
+      span<const uint32_t> indexes = (self.*fn)(idx);
+      return std::vector<uint32_t>(indexes.begin(), indexes.end());
+    };
+  };
+
+  nb::class_<XRef>(m, "XRef",
+    R"delim(
+    Cross-references between the methods of a DEX file and the methods,
+    fields, strings and types they use.
+
+    The index is built in a single pass over the bytecode and the queries
+    return the sorted pool indexes in both directions.
+
+    .. code-block:: python
+
+      dex = lief.DEX.parse("classes.dex")
+      xref = lief.DEX.XRef.build(dex)
+      for method in xref.method_callers(dex.methods[0]):
+          print(method.name)
+    )delim"_doc)
+
+    .def_static("build",
+        [] (const File& file, uint32_t nb_threads) {
+          nb::gil_scoped_release release;
+          return XRef::build(file, nb_threads);
+        },
+        R"delim(
+        Build the index for the given :class:`~lief.DEX.File`.
+
+        The bytecode is decoded from at most ``nb_threads`` threads
+        (0: number of hardware threads) and the result does not depend on it.
+        )delim"_doc,
+        "file"_a, "nb_threads"_a = 0, nb::keep_alive<0, 1>())
+
+    .def("callees", to_list(&XRef::callees),
+        "Indexes of the methods invoked by the given method"_doc,
+        "method_idx"_a)
+
+    .def("callers", to_list(&XRef::callers),
+        "Indexes of the methods that invoke the given method"_doc,
+        "method_idx"_a)
+
+    .def("strings", to_list(&XRef::strings),
+        "Indexes of the strings loaded by the given method"_doc,
+        "method_idx"_a)
+
+    .def("string_users", to_list(&XRef::string_users),
+        "Indexes of the methods that load the given string"_doc,
+        "string_idx"_a)
+
+    .def("fields", to_list(&XRef::fields),
+        "Indexes of the fields accessed by the given method"_doc,
+        "method_idx"_a)
+
+    .def("field_users", to_list(&XRef::field_users),
+        "Indexes of the methods that access the given field"_doc,
+        "field_idx"_a)
+
+    .def("types", to_list(&XRef::types),
+        "Indexes of the types referenced by the given method"_doc,
+        "method_idx"_a)
+
+    .def("type_users", to_list(&XRef::type_users),
+        "Indexes of the methods that reference the given type"_doc,
+        "type_idx"_a)
+
+    .def("method", &XRef::method,
+        "Method associated with the given index"_doc,
+        "method_idx"_a, nb::rv_policy::reference_internal)
+
+    .def("field", &XRef::field,
+        "Field associated with the given index"_doc,
+        "field_idx"_a, nb::rv_policy::reference_internal)
+
+    .def("method_callers",
+        nb::overload_cast<const Method&>(&XRef::callers, nb::const_),
+        "Methods that invoke the given method"_doc,
+        "method"_a, nb::rv_policy::reference_internal)
+
+    .def("method_callees",
+        nb::overload_cast<const Method&>(&XRef::callees, nb::const_),
+        "Methods invoked by the given method"_doc,
+        "method"_a, nb::rv_policy::reference_internal)
+
+    .def("accessors",
+        nb::overload_cast<const Field&>(&XRef::field_users, nb::const_),
+        "Methods that access the given field"_doc,
+        "field"_a, nb::rv_policy::reference_internal);
+}
+
+}
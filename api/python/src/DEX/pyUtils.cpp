@@ -14,15 +14,19 @@
  * limitations under the License.
  */
 #include "DEX/pyDEX.hpp"
+#include "pyErr.hpp"
 
 #include "LIEF/DEX/utils.hpp"
+#include "LIEF/DEX/File.hpp"
 
 #include <nanobind/stl/string.h>
 #include <nanobind/stl/vector.h>
+#include <nanobind/stl/array.h>
 
 namespace LIEF::DEX::py {
 
 void init_utils(nb::module_& m) {
+  using namespace LIEF::py;
   lief_mod->def("is_dex",
       nb::overload_cast<const std::string&>(&is_dex),
       "Check if the **file** given in parameter is a DEX"_doc,
@@ -42,6 +46,90 @@ void init_utils(nb::module_& m) {
       nb::overload_cast<const std::vector<uint8_t>&>(&version),
       "Return the DEX version of the **raw data** given in parameter"_doc,
       "raw"_a);
+
+  m.def("adler32",
+      [] (nb::bytes data, uint32_t adler) {
+        auto ptr = reinterpret_cast<const uint8_t*>(data.c_str());
+        return adler32(span<const uint8_t>(ptr, data.size()), adler);
+      },
+      "Adler-32 of the given data"_doc,
+      "data"_a, "adler"_a = 1);
+
+  m.def("compute_checksum",
+      [] (nb::bytes raw) {
+        auto ptr = reinterpret_cast<const uint8_t*>(raw.c_str());
+        return error_or(&compute_checksum, span<const uint8_t>(ptr, raw.size()));
+      },
+      "Compute the Adler-32 checksum of the header for the given raw DEX file"_doc,
+      "raw"_a);
+
+  m.def("compute_signature",
+      [] (nb::bytes raw) {
+        auto ptr = reinterpret_cast<const uint8_t*>(raw.c_str());
+        return error_or(&compute_signature, span<const uint8_t>(ptr, raw.size()));
+      },
+      "Compute the SHA-1 signature of the header for the given raw DEX file"_doc,
+      "raw"_a);
+
+  m.def("update_checksums",
+      [] (nb::bytes raw) {
+        return error_or([&] () -> result<nb::bytes> {
+          std::vector<uint8_t> data(raw.c_str(), raw.c_str() + raw.size());
+          if (auto is_ok = update_checksums(data); !is_ok) {
+            return make_error_code(get_error(is_ok));
+          }
+          return nb::bytes(reinterpret_cast<const char*>(data.data()), data.size());
+        });
+      },
+      R"delim(
+      Return a copy of the given raw DEX file with the signature and the
+      checksum of the header recomputed
+      )delim"_doc,
+      "raw"_a);
+
+  nb::class_<verify_t>(m, "verify_t",
+      "Status of the header of a DEX file (see: :func:`~lief.DEX.verify`)"_doc)
+    .def_ro("checksum", &verify_t::checksum,
+        "Whether the Adler-32 checksum matches the content"_doc)
+    .def_ro("signature", &verify_t::signature,
+        "Whether the SHA-1 signature matches the content"_doc)
+    .def_prop_ro("is_valid", &verify_t::is_valid,
+        "Whether both the checksum and the signature match the content"_doc);
+
+  m.def("verify",
+      [] (const std::vector<File*>& files, uint32_t nb_threads) {
+        nb::gil_scoped_release release;
+        return verify(std::vector<const File*>(files.begin(), files.end()), nb_threads);
+      },
+      R"delim(
+      Verify the checksum and the signature of the given DEX files (e.g. the
+      DEX files of an OAT, a VDEX or an APK) from at most ``nb_threads``
+      threads (0: number of hardware threads).
+
+      The i-th element of the returned list is the status of ``files[i]``.
+      )delim"_doc,
+      "files"_a, "nb_threads"_a = 0);
+
+  m.def("fix",
+      [] (const std::vector<File*>& files, bool deoptimize, uint32_t nb_threads) {
+        std::vector<std::vector<uint8_t>> raws;
+        {
+          nb::gil_scoped_release release;
+          raws = fix(std::vector<const File*>(files.begin(), files.end()),
+                     deoptimize, nb_threads);
+        }
+        nb::list out;
+        for (const std::vector<uint8_t>& raw : raws) {
+          out.append(nb::bytes(reinterpret_cast<const char*>(raw.data()), raw.size()));
+        }
+        return out;
+      },
+      R"delim(
+      Raw content of the given DEX files (see: :meth:`lief.DEX.File.raw`) with
+      their signature and their checksum recomputed, from at most
+      ``nb_threads`` threads (0: number of hardware threads).
+      )delim"_doc,
+      "files"_a, "deoptimize"_a = true, "nb_threads"_a = 0);
 }
 
 }
@@ -21,12 +21,14 @@
 #include <nanobind/stl/vector.h>
 
 #include "LIEF/ELF/Builder.hpp"
+#include "LIEF/ELF/CoreUnwinder.hpp"
 #include "LIEF/ELF/DynamicEntry.hpp"
 #include "LIEF/ELF/DynamicEntryArray.hpp"
 #include "LIEF/ELF/DynamicEntryFlags.hpp"
 #include "LIEF/ELF/DynamicEntryLibrary.hpp"
 #include "LIEF/ELF/DynamicEntryRpath.hpp"
 #include "LIEF/ELF/DynamicEntryRunPath.hpp"
+#include "LIEF/ELF/DynamicPatcher.hpp"
 #include "LIEF/ELF/DynamicSharedObject.hpp"
 #include "LIEF/ELF/GnuHash.hpp"
 #include "LIEF/ELF/Header.hpp"
@@ -92,9 +94,11 @@ void init_objects(nb::module_& m) {
   CREATE(DynamicEntryRpath, m);
   CREATE(DynamicEntryRunPath, m);
   CREATE(DynamicEntryFlags, m);
+  CREATE(DynamicPatcher, m);
   CREATE(GnuHash, m);
   CREATE(SysvHash, m);
   CREATE(Builder, m);
+  CREATE(CoreUnwinder, m);
 
   init_notes(m);
 }
@@ -52,6 +52,9 @@ void create<CoreFile>(nb::module_& m) {
         nb::overload_cast<const CoreFile::files_t&>(&CoreFile::files),
         "List of files mapped in core. (list of " RST_CLASS_REF(lief.ELF.CoreFileEntry) ")"_doc)
 
+    .def_prop_ro("page_size", &CoreFile::page_size,
+        "Unit of the entries' :attr:`~lief.ELF.CoreFile.entry_t.file_ofs`"_doc)
+
     .def("__len__",
         &CoreFile::count,
         "Number of files mapped in core"_doc)
@@ -210,6 +210,37 @@ void create<Binary>(nb::module_& m) {
         "Return an iterator over object " RST_CLASS_REF(lief.ELF.Relocation) ""_doc,
         nb::keep_alive<0, 1>())
 
+    .def("relocate",
+        [] (Binary& self, const nb::dict& layout, nb::object resolver) {
+          Binary::sections_layout_t sections_layout;
+          for (auto [section, address] : layout) {
+            sections_layout[nb::cast<const Section*>(section)] = nb::cast<uint64_t>(address);
+          }
+
+          Binary::symbol_resolver_t symbol_resolver;
+          if (!resolver.is_none()) {
+            symbol_resolver = [resolver] (const Symbol& sym) -> LIEF::result<uint64_t> {
+              nb::object value = resolver(nb::cast(&sym, nb::rv_policy::reference));
+              if (value.is_none()) {
+                return make_error_code(lief_errors::not_found);
+              }
+              return nb::cast<uint64_t>(value);
+            };
+          }
+          return error_or(&Binary::relocate, self, sections_layout, symbol_resolver);
+        },
+        R"delim(
+        Apply the relocations of an object file (``ET_REL``) on the sections'
+        content according to the given ``layout`` which is a dictionary
+        :class:`~lief.ELF.Section` -> address.
+
+        The optional ``resolver`` is a callback that takes an undefined
+        :class:`~lief.ELF.Symbol` and returns its address (or ``None``).
+
+        It returns the number of relocations applied.
+        )delim"_doc,
+        "layout"_a, "resolver"_a = nb::none())
+
     .def_prop_ro("relocations",
         nb::overload_cast<>(&Binary::relocations),
         "Return an iterator over **all** " RST_CLASS_REF(lief.ELF.Relocation) ""_doc,
@@ -567,6 +598,17 @@ void create<Binary>(nb::module_& m) {
         "Apply the given permutation on the dynamic symbols table"_doc,
         "permutation"_a)
 
+    .def("clone", &Binary::clone,
+        R"delim(
+        Create a copy of this binary that can be modified (and written)
+        independently.
+
+        The objects (sections, segments, symbols, relocations, ...) are copied
+        but the raw content is shared until one of the copies modifies it
+        (copy-on-write). Cloning a parsed binary is therefore much cheaper
+        than parsing it again.
+        )delim"_doc)
+
     .def("write",
         nb::overload_cast<const std::string&>(&Binary::write),
         "Rebuild the binary and write it in a file"_doc,
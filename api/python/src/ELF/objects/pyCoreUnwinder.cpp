@@ -0,0 +1,131 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+
+#include "ELF/pyELF.hpp"
+#include "pyErr.hpp"
+#include "enums_wrapper.hpp"
+
+#include "LIEF/ELF/Binary.hpp"
+#include "LIEF/ELF/CoreUnwinder.hpp"
+#include "LIEF/ELF/NoteDetails/core/CorePrStatus.hpp"
+
+namespace LIEF::ELF::py {
+
+template<>
+void create<CoreUnwinder>(nb::module_& m) {
+  using namespace LIEF::py;
+
+  nb::class_<CoreUnwinder> unwinder(m, "CoreUnwinder",
+      R"delim(
+      This class unwinds the stacks of the threads saved in an ELF core dump
+      (x86, x86-64 and AArch64).
+
+      The module of each program counter is found with the ``NT_FILE``
+      mappings and its ``.eh_frame`` CFI is executed against the memory of the
+      core. When a frame is not covered by the CFI, the unwinder falls back on
+      the frame-pointer chain.
+
+      The modules and their CIE/FDE tables are cached in the unwinder so that
+      unwinding several cores of the same program only parses them once.
+      The modules are identified by their path and their build-id: a module
+      whose build-id differs from the core's one is not used.
+
+      .. code-block:: python
+
+        core = lief.ELF.parse("core.1234")
+        unwinder = lief.ELF.CoreUnwinder()
+        unwinder.sysroot = "/srv/symbols/rootfs"
+        for thread in unwinder.unwind(core):
+            for frame in thread.frames:
+                print(f"{frame.module}+{frame.offset:#x}")
+      )delim"_doc);
+
+  #define ENTRY(X) .value(to_string(CoreUnwinder::METHOD::X), CoreUnwinder::METHOD::X)
+  enum_<CoreUnwinder::METHOD>(unwinder, "METHOD")
+    ENTRY(CONTEXT)
+    ENTRY(CFI)
+    ENTRY(FRAME_POINTER);
+  #undef ENTRY
+
+  nb::class_<CoreUnwinder::frame_t>(unwinder, "frame_t")
+    .def_ro("pc", &CoreUnwinder::frame_t::pc,
+            "Program counter (return address for the caller frames)"_doc)
+    .def_ro("sp", &CoreUnwinder::frame_t::sp,
+            "Stack pointer"_doc)
+    .def_ro("module", &CoreUnwinder::frame_t::module,
+            "Path of the module that contains the program counter"_doc)
+    .def_ro("offset", &CoreUnwinder::frame_t::offset,
+            "Virtual address of the program counter in the module"_doc)
+    .def_ro("method", &CoreUnwinder::frame_t::method,
+            "How the frame has been recovered"_doc);
+
+  nb::class_<CoreUnwinder::thread_t>(unwinder, "thread_t")
+    .def_ro("tid", &CoreUnwinder::thread_t::tid)
+    .def_ro("signal", &CoreUnwinder::thread_t::signal,
+            "Signal that was being delivered to the thread (or 0)"_doc)
+    .def_ro("frames", &CoreUnwinder::thread_t::frames,
+            "Frames, from the innermost one"_doc);
+
+  unwinder
+    .def(nb::init<>())
+
+    .def_prop_rw("sysroot",
+        nb::overload_cast<>(&CoreUnwinder::sysroot, nb::const_),
+        nb::overload_cast<std::string>(&CoreUnwinder::sysroot),
+        "Directory prepended to the ``NT_FILE`` paths to load the modules"_doc)
+
+    .def_prop_rw("max_frames",
+        nb::overload_cast<>(&CoreUnwinder::max_frames, nb::const_),
+        nb::overload_cast<size_t>(&CoreUnwinder::max_frames),
+        "Maximum number of frames per thread"_doc)
+
+    .def("add_module",
+        nb::overload_cast<const std::string&, const Binary&>(&CoreUnwinder::add_module),
+        "Use the given binary for the module mapped at ``path`` in the cores"_doc,
+        "path"_a, "module"_a, nb::keep_alive<1, 3>())
+
+    .def_prop_ro("nb_modules", &CoreUnwinder::nb_modules,
+        "Number of modules in the cache (including the ones that can't be loaded)"_doc)
+
+    .def("clear_cache", &CoreUnwinder::clear_cache,
+        "Drop the cached modules and their CFI tables"_doc)
+
+    .def("unwind",
+        [] (CoreUnwinder& self, const Binary& core, uint32_t nb_threads) {
+          return error_or([&] {
+            nb::gil_scoped_release release;
+            return self.unwind(core, nb_threads);
+          });
+        },
+        R"delim(
+        Unwind all the threads of the given core from at most ``nb_threads``
+        threads (0: number of hardware threads)
+        )delim"_doc,
+        "core"_a, "nb_threads"_a = 0)
+
+    .def("unwind",
+        [] (CoreUnwinder& self, const Binary& core, const CorePrStatus& status) {
+          return error_or(
+            nb::overload_cast<const Binary&, const CorePrStatus&>(&CoreUnwinder::unwind),
+            self, core, status);
+        },
+        "Unwind the thread associated with the given ``NT_PRSTATUS`` note"_doc,
+        "core"_a, "status"_a);
+}
+}
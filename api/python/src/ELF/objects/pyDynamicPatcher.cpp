@@ -0,0 +1,152 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+#include <nanobind/stl/pair.h>
+
+#include "ELF/pyELF.hpp"
+#include "pyErr.hpp"
+
+#include "LIEF/ELF/DynamicPatcher.hpp"
+
+namespace LIEF::ELF::py {
+
+template<>
+void create<DynamicPatcher>(nb::module_& m) {
+  using namespace LIEF::py;
+
+  nb::class_<DynamicPatcher>(m, "DynamicPatcher",
+      R"delim(
+      This class modifies the interpreter and the string-based dynamic entries
+      (``DT_NEEDED``, ``DT_SONAME``, ``DT_RPATH``, ``DT_RUNPATH``) **in place**,
+      like ``patchelf`` does for the edits that don't require a new layout.
+
+      - A string that is not longer than the original one (and that is not
+        shared with another reference) is overwritten.
+      - Otherwise, the string is written in the slack of ``.dynstr``.
+      - A new dynamic entry uses one of the spare ``DT_NULL`` slots.
+
+      When an edit does not fit, the function returns
+      :attr:`lief.lief_errors.data_too_large` and nothing is written.
+      :meth:`~.apply` uses this to fall back on the full rebuild.
+
+      .. code-block:: python
+
+        patcher = lief.ELF.DynamicPatcher.open("libfoo.so")
+        if patcher.runpath("$ORIGIN"):
+            patcher.commit()
+      )delim"_doc)
+
+    .def_static("open",
+        [] (const std::string& path) -> typing_error<result<DynamicPatcher>> {
+          auto patcher = DynamicPatcher::open(path);
+          if (!patcher) {
+            return nb::cast(LIEF::as_lief_err(patcher));
+          }
+          // DynamicPatcher is move-only
+          return nb::cast(std::move(*patcher));
+        },
+        R"delim(
+        Load the file at the given path. The modifications are written back
+        with :meth:`~.commit`
+        )delim"_doc,
+        "path"_a)
+
+    .def_static("apply",
+        [] (const std::string& path, const std::string& interpreter,
+            const std::string& soname, const std::string& runpath,
+            const std::string& rpath, const std::vector<std::string>& needed)
+        {
+          DynamicPatcher::changes_t changes;
+          changes.interpreter = interpreter;
+          changes.soname = soname;
+          changes.runpath = runpath;
+          changes.rpath = rpath;
+          changes.needed = needed;
+          return error_or(&DynamicPatcher::apply, path, changes);
+        },
+        R"delim(
+        Apply the given changes on the file (an empty value means
+        *unchanged*). The changes are first processed in place and if one of
+        them does not fit, the file is parsed, modified and rebuilt.
+
+        It returns ``True`` if the changes have been applied in place.
+        )delim"_doc,
+        "path"_a, "interpreter"_a = "", "soname"_a = "", "runpath"_a = "",
+        "rpath"_a = "", "needed"_a = std::vector<std::string>{})
+
+    .def("interpreter",
+        [] (DynamicPatcher& self, const std::string& path) {
+          return error_or(nb::overload_cast<const std::string&>(&DynamicPatcher::interpreter), self, path);
+        },
+        "Change the interpreter. It must fit in the ``PT_INTERP`` segment."_doc,
+        "path"_a)
+
+    .def("soname",
+        [] (DynamicPatcher& self, const std::string& name) {
+          return error_or(&DynamicPatcher::soname, self, name);
+        },
+        "Change (or add) the ``DT_SONAME`` entry"_doc,
+        "name"_a)
+
+    .def("runpath",
+        [] (DynamicPatcher& self, const std::string& path) {
+          return error_or(&DynamicPatcher::runpath, self, path);
+        },
+        "Change (or add) the ``DT_RUNPATH`` entry"_doc,
+        "path"_a)
+
+    .def("rpath",
+        [] (DynamicPatcher& self, const std::string& path) {
+          return error_or(&DynamicPatcher::rpath, self, path);
+        },
+        "Change (or add) the ``DT_RPATH`` entry"_doc,
+        "path"_a)
+
+    .def("add_needed",
+        [] (DynamicPatcher& self, const std::string& library) {
+          return error_or(&DynamicPatcher::add_needed, self, library);
+        },
+        R"delim(
+        Add a ``DT_NEEDED`` entry after the existing ones. It does nothing
+        if the library is already present.
+        )delim"_doc,
+        "library"_a)
+
+    .def_prop_ro("current_interpreter",
+        nb::overload_cast<>(&DynamicPatcher::interpreter, nb::const_),
+        "Current interpreter (empty if the binary does not have a ``PT_INTERP``)"_doc)
+
+    .def_prop_ro("needed", &DynamicPatcher::needed,
+        "Libraries referenced by the ``DT_NEEDED`` entries"_doc)
+
+    .def_prop_ro("spare_dynamic_slots", &DynamicPatcher::spare_dynamic_slots,
+        "Number of spare ``DT_NULL`` slots that can be used for new entries"_doc)
+
+    .def_prop_ro("dynstr_slack", &DynamicPatcher::dynstr_slack,
+        "Number of bytes that can be used in ``.dynstr`` for new strings"_doc)
+
+    .def_prop_ro("modifications", &DynamicPatcher::modifications,
+        "File ranges ``(offset, size)`` modified so far"_doc)
+
+    .def("commit",
+        [] (DynamicPatcher& self) {
+          return error_or(&DynamicPatcher::commit, self);
+        },
+        "Write the modifications in the file used by :meth:`~.open`"_doc);
+}
+}
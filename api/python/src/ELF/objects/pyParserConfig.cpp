@@ -57,6 +57,9 @@ void create<ParserConfig>(nb::module_& m) {
             :attr:`lief.ELF.DYNSYM_COUNT_METHODS.COUNT_AUTO`
             )delim"_doc)
 
+    .def_rw("budget", &ParserConfig::budget,
+            "Resources that the parser can use (c.f. :class:`lief.ParserBudget`)"_doc)
+
     .def_prop_ro_static("all",
       [] (const nb::object& /* self */) { return ParserConfig::all(); },
       R"delim(
@@ -65,6 +65,7 @@
 #include <LIEF/MachO/TwoLevelHints.hpp>
 #include <LIEF/MachO/UUIDCommand.hpp>
 #include <LIEF/MachO/UnknownCommand.hpp>
+#include <LIEF/MachO/UnwindInfo.hpp>
 #include <LIEF/MachO/VersionMin.hpp>
 
 #define CREATE(X,Y) create<X>(Y)
@@ -120,6 +121,7 @@ void init_objects(nb::module_& m) {
   CREATE(LinkerOptHint, m);
   CREATE(IndirectBindingInfo, m);
   CREATE(UnknownCommand, m);
+  CREATE(UnwindInfo, m);
   CREATE(Stub, m);
   CREATE(Builder, m);
 }
@@ -62,6 +62,9 @@ void create<ParserConfig>(nb::module_& m) {
             Enabling this flag can slow down the parsing
          )delim"_doc, "flag"_a)
 
+    .def_rw("budget", &ParserConfig::budget,
+            "Resources that the parser can use (c.f. :class:`lief.ParserBudget`)"_doc)
+
     .def_prop_ro_static("deep",
       [] (const nb::object& /* self */) { return ParserConfig::deep(); },
       R"delim(
@@ -0,0 +1,133 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nanobind/stl/vector.h>
+#include <nanobind/make_iterator.h>
+
+#include "LIEF/MachO/Binary.hpp"
+#include "LIEF/MachO/UnwindInfo.hpp"
+
+#include "MachO/pyMachO.hpp"
+#include "pyErr.hpp"
+
+namespace LIEF::MachO::py {
+
+template<>
+void create<UnwindInfo>(nb::module_& m) {
+  using namespace LIEF::py;
+
+  nb::class_<UnwindInfo> info(m, "UnwindInfo",
+      R"delim(
+      This class decodes the compact unwind table (``__TEXT,__unwind_info``)
+      straight from the content of the section. The first-level index and the
+      second-level pages are binary-searched so that only the looked-up
+      entries are decoded.
+
+      The binary must outlive this object.
+
+      .. code-block:: python
+
+        macho = lief.MachO.parse("libfoo.dylib").at(0)
+        unwind = lief.MachO.UnwindInfo.from_binary(macho)
+        entry = unwind.lookup(0x100003f20)
+        if unwind.is_dwarf(entry.encoding):
+          print(unwind.fde(entry))
+      )delim"_doc);
+
+  nb::class_<UnwindInfo::entry_t>(info, "entry_t")
+    .def_ro("address", &UnwindInfo::entry_t::address,
+            "Virtual address of the function"_doc)
+    .def_ro("size", &UnwindInfo::entry_t::size,
+            R"delim(
+            Size of the range covered by the encoding (which can span several
+            adjacent functions)
+            )delim"_doc)
+    .def_ro("encoding", &UnwindInfo::entry_t::encoding,
+            "Compact unwind encoding"_doc)
+    .def_ro("lsda", &UnwindInfo::entry_t::lsda,
+            "Virtual address of the language-specific data area (or 0)"_doc)
+    .def_ro("personality", &UnwindInfo::entry_t::personality,
+            "Virtual address of the personality function's pointer (or 0)"_doc)
+    .def_prop_ro("has_lsda", &UnwindInfo::entry_t::has_lsda)
+    .def_prop_ro("is_function_start", &UnwindInfo::entry_t::is_function_start);
+
+  nb::class_<UnwindInfo::fde_t>(info, "fde_t")
+    .def_ro("address", &UnwindInfo::fde_t::address,
+            "Virtual address of the FDE"_doc)
+    .def_ro("pc_begin", &UnwindInfo::fde_t::pc_begin)
+    .def_ro("pc_end", &UnwindInfo::fde_t::pc_end);
+
+  info
+    .def_static("from_binary",
+        [] (const Binary& bin) {
+          return error_or(&UnwindInfo::from_binary, bin);
+        },
+        "Create the decoder for the ``__unwind_info`` section of the given binary"_doc,
+        "binary"_a, nb::keep_alive<0, 1>())
+
+    .def_prop_ro("version", &UnwindInfo::version)
+
+    .def_prop_ro("arch", &UnwindInfo::arch)
+
+    .def_prop_ro("imagebase", &UnwindInfo::imagebase)
+
+    .def_prop_ro("nb_pages", &UnwindInfo::nb_pages,
+        "Number of second-level pages"_doc)
+
+    .def_prop_ro("common_encodings", &UnwindInfo::common_encodings,
+        "Encodings shared by all the compressed pages"_doc)
+
+    .def_prop_ro("personalities", &UnwindInfo::personalities,
+        "Virtual addresses of the personality functions' pointers"_doc)
+
+    .def_prop_ro("entries",
+        [] (const UnwindInfo& self) {
+          auto entries = self.entries();
+          return nb::make_iterator(nb::type<UnwindInfo>(), "entries_it", entries);
+        }, nb::keep_alive<0, 1>(),
+        "Iterator over the entries of the table"_doc)
+
+    .def("lookup",
+        [] (const UnwindInfo& self, uint64_t address) {
+          return error_or(
+            nb::overload_cast<uint64_t>(&UnwindInfo::lookup, nb::const_),
+            self, address);
+        },
+        "Return the entry that covers the given virtual address"_doc,
+        "address"_a)
+
+    .def("lookup",
+        nb::overload_cast<const std::vector<uint64_t>&>(&UnwindInfo::lookup, nb::const_),
+        R"delim(
+        Batch version of :meth:`~.lookup`. The entries of the addresses that
+        can't be resolved have an :attr:`~.entry_t.address` set to 0.
+        )delim"_doc,
+        "addresses"_a)
+
+    .def("is_dwarf", &UnwindInfo::is_dwarf,
+        "Whether the given encoding defers to the DWARF unwind information"_doc,
+        "encoding"_a)
+
+    .def("fde",
+        [] (const UnwindInfo& self, const UnwindInfo::entry_t& entry) {
+          return error_or(&UnwindInfo::fde, self, entry);
+        },
+        R"delim(
+        Resolve the FDE (in ``__eh_frame``) referenced by the encoding of an
+        entry that uses the DWARF mode
+        )delim"_doc,
+        "entry"_a);
+}
+}
@@ -21,6 +21,7 @@
 
 #include "LIEF/OAT/Parser.hpp"
 #include "LIEF/OAT/Binary.hpp"
+#include "LIEF/ELF/ParserConfig.hpp"
 #include "LIEF/logging.hpp"
 
 #include <string>
@@ -49,6 +50,25 @@ void create<Parser>(nb::module_& m) {
     "Parse the given raw data and return a " RST_CLASS_REF(lief.OAT.Binary) " object"_doc,
     "raw"_a, nb::rv_policy::take_ownership);
 
+  m.def("parse",
+    nb::overload_cast<const std::string&, const ELF::ParserConfig&>(&Parser::parse),
+    R"delim(
+    Parse the given OAT file with the given configuration for the ELF
+    container.
+
+    :func:`lief.OAT.light_config` only parses the segments, the sections
+    and the dynamic symbols of the ELF container.
+    )delim"_doc,
+    "oat_file"_a, "config"_a, nb::rv_policy::take_ownership);
+
+  m.def("light_config", &Parser::light_config,
+    R"delim(
+    Configuration of the ELF parser that only parses what is needed by the
+    OAT format: the relocations, the static symbols, the symbol versions and
+    the notes are skipped. By default, :func:`lief.OAT.parse` parses the
+    complete ELF container.
+    )delim"_doc);
+
   m.def("parse",
     [] (typing::InputParser obj) -> std::unique_ptr<Binary> {
       if (auto path_str = path_to_str(obj)) {
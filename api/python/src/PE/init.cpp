@@ -20,6 +20,10 @@
 #include "LIEF/PE/Binary.hpp"
 #include "LIEF/PE/CodeIntegrity.hpp"
 #include "LIEF/PE/Export.hpp"
+#include "LIEF/PE/ExportResolver.hpp"
+#include "LIEF/PE/ApiSet.hpp"
+#include "LIEF/PE/ImportResolver.hpp"
+#include "LIEF/PE/HeaderPatcher.hpp"
 #include "LIEF/PE/LoadConfigurations.hpp"
 #include "LIEF/PE/Parser.hpp"
 #include "LIEF/PE/ParserConfig.hpp"
@@ -127,6 +131,10 @@ void init_objects(nb::module_& m) {
   CREATE(RelocationEntry, m);
   CREATE(Export, m);
   CREATE(ExportEntry, m);
+  CREATE(ExportResolver, m);
+  CREATE(ApiSet, m);
+  CREATE(ImportResolver, m);
+  CREATE(HeaderPatcher, m);
   CREATE(TLS, m);
   CREATE(Symbol, m);
   CREATE(Import, m);
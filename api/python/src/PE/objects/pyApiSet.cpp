@@ -0,0 +1,102 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "PE/pyPE.hpp"
+#include "pyErr.hpp"
+
+#include "LIEF/PE/ApiSet.hpp"
+#include "LIEF/PE/Binary.hpp"
+
+#include <string>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+
+namespace LIEF::PE::py {
+
+template<>
+void create<ApiSet>(nb::module_& m) {
+  using namespace LIEF::py;
+
+  nb::class_<ApiSet> apiset(m, "ApiSet",
+      R"delim(
+      This class represents the API set schema of Windows (``apisetschema.dll``)
+      which maps the API set contracts (``api-ms-win-*``, ``ext-ms-*``) to the
+      DLLs that implement them.
+
+      The schemas of Windows 7 (v2), Windows 8.1 (v4) and Windows 10+ (v6) are
+      supported.
+
+      .. code-block:: python
+
+        schema = lief.PE.ApiSet.parse(lief.PE.parse("apisetschema.dll"))
+        print(schema.resolve("api-ms-win-core-file-l1-2-4.dll")) # kernelbase.dll
+      )delim"_doc);
+
+  nb::class_<ApiSet::value_t>(apiset, "value_t")
+    .def_ro("importer", &ApiSet::value_t::importer,
+            "Importing module for which this host applies (empty for the default host)"_doc)
+    .def_ro("host", &ApiSet::value_t::host,
+            "DLL that implements the contract"_doc);
+
+  nb::class_<ApiSet::entry_t>(apiset, "entry_t")
+    .def_ro("name", &ApiSet::entry_t::name,
+            "Name of the contract as stored in the schema (in lower case)"_doc)
+    .def_ro("is_sealed", &ApiSet::entry_t::is_sealed)
+    .def_ro("values", &ApiSet::entry_t::values);
+
+  apiset
+    .def_static("parse",
+        [] (const Binary& apisetschema) {
+          return error_or(nb::overload_cast<const Binary&>(&ApiSet::parse), apisetschema);
+        },
+        "Parse the ``.apiset`` section of the given ``apisetschema.dll``"_doc,
+        "apisetschema"_a)
+
+    .def_static("parse",
+        [] (nb::bytes raw) {
+          auto ptr = reinterpret_cast<const uint8_t*>(raw.c_str());
+          return error_or(nb::overload_cast<span<const uint8_t>>(&ApiSet::parse),
+                          span<const uint8_t>(ptr, raw.size()));
+        },
+        "Parse the raw API set namespace (content of the ``.apiset`` section)"_doc,
+        "raw"_a)
+
+    .def_static("is_api_set", &ApiSet::is_api_set,
+        "Whether the given module name is an API set contract"_doc,
+        "name"_a)
+
+    .def_prop_ro("version", &ApiSet::version,
+        "Version of the schema (2, 4 or 6)"_doc)
+
+    .def_prop_ro("entries", &ApiSet::entries,
+        nb::rv_policy::reference_internal)
+
+    .def("find", &ApiSet::find,
+        "Return the contract matching the given module name or None"_doc,
+        "name"_a, nb::rv_policy::reference_internal)
+
+    .def("resolve",
+        [] (const ApiSet& self, const std::string& name, const std::string& importer) {
+          return error_or(
+            nb::overload_cast<const std::string&, const std::string&>(&ApiSet::resolve, nb::const_),
+            self, name, importer);
+        },
+        R"delim(
+        Resolve the given contract into its host DLL. The ``importer`` is the
+        name of the module that imports the contract.
+        )delim"_doc,
+        "name"_a, "importer"_a = "");
+}
+}
@@ -218,6 +218,67 @@ void create<Binary>(nb::module_& m) {
         "given in the first parameter"_doc,
         "algorithm"_a)
 
+    .def("page_hash",
+        [] (const Binary& bin, uint32_t offset, ALGORITHMS algo) {
+          return error_or([&] () -> result<nb::bytes> {
+            auto hash = bin.page_hash(offset, algo);
+            if (!hash) {
+              return make_error_code(get_error(hash));
+            }
+            return nb::to_bytes(*hash);
+          });
+        },
+        R"delim(
+        Compute the Authenticode hash of the page that starts at the given file
+        offset (as stored in :attr:`lief.PE.SpcIndirectData.page_hashes`)
+        )delim"_doc,
+        "offset"_a, "algorithm"_a)
+
+    .def("verify_page",
+        [] (const Binary& bin, uint64_t rva) {
+          return error_or(nb::overload_cast<uint64_t>(&Binary::verify_page, nb::const_),
+                          bin, rva);
+        },
+        R"delim(
+        Check that the page which contains the given RVA matches the page
+        hashes embedded in the first signature. Only this page is hashed.
+        )delim"_doc,
+        "rva"_a)
+
+    .def("verify_page",
+        [] (const Binary& bin, uint64_t rva, const Signature& sig) {
+          return error_or(nb::overload_cast<uint64_t, const Signature&>(&Binary::verify_page, nb::const_),
+                          bin, rva, sig);
+        },
+        "Check the page which contains the given RVA against the given signature"_doc,
+        "rva"_a, "signature"_a)
+
+    .def("verify_pages",
+        [] (const Binary& bin, uint32_t nb_threads) {
+          return error_or([&] {
+            nb::gil_scoped_release release;
+            return bin.verify_pages(nb_threads);
+          });
+        },
+        R"delim(
+        Check all the pages against the page hashes embedded in the first
+        signature and return the file offsets of the pages that don't match.
+
+        The pages are hashed from at most ``nb_threads`` threads
+        (0: number of hardware threads).
+        )delim"_doc,
+        "nb_threads"_a = 0)
+
+    .def("verify_pages",
+        [] (const Binary& bin, const Signature& sig, uint32_t nb_threads) {
+          return error_or([&] {
+            nb::gil_scoped_release release;
+            return bin.verify_pages(sig, nb_threads);
+          });
+        },
+        "Check all the pages against the page hashes of the given signature"_doc,
+        "signature"_a, "nb_threads"_a = 0)
+
     .def("verify_signature",
         nb::overload_cast<Signature::VERIFICATION_CHECKS>(&Binary::verify_signature, nb::const_),
         R"delim(
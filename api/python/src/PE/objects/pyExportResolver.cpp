@@ -0,0 +1,101 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "PE/pyPE.hpp"
+#include "pyErr.hpp"
+#include "pySafeString.hpp"
+
+#include "LIEF/PE/Binary.hpp"
+#include "LIEF/PE/ExportResolver.hpp"
+
+#include <string>
+#include <nanobind/stl/string.h>
+
+namespace LIEF::PE::py {
+
+template<>
+void create<ExportResolver>(nb::module_& m) {
+  using namespace LIEF::py;
+
+  nb::class_<ExportResolver>(m, "ExportResolver",
+      R"delim(
+      This class resolves exported functions straight from the export directory,
+      as ``GetProcAddress`` does (binary search in the name pointer table,
+      direct access to the export address table for the ordinals).
+
+      Only the looked-up entries are decoded. It can be used on a binary parsed
+      with :attr:`lief.PE.ParserConfig.parse_exports` set to ``False``:
+
+      .. code-block:: python
+
+        config = lief.PE.ParserConfig()
+        config.parse_exports = False
+        kernel32 = lief.PE.parse("kernel32.dll", config)
+
+        resolver = lief.PE.ExportResolver.from_binary(kernel32)
+        entry = resolver.find("CreateFileW")
+        if entry.is_forwarded:
+          print(entry.forward_information)
+      )delim"_doc)
+
+    .def_static("from_binary",
+        [] (const Binary& bin) {
+          return error_or(&ExportResolver::from_binary, bin);
+        },
+        "Create a resolver for the export directory of the given binary"_doc,
+        "binary"_a, nb::keep_alive<0, 1>())
+
+    .def_prop_ro("name",
+        [] (const ExportResolver& self) {
+          return safe_string(self.name());
+        },
+        "Name of the library as stored in the export directory"_doc)
+
+    .def_prop_ro("nb_functions", &ExportResolver::nb_functions,
+        "Number of entries in the export address table"_doc)
+
+    .def_prop_ro("nb_names", &ExportResolver::nb_names,
+        "Number of entries in the name pointer table"_doc)
+
+    .def_prop_ro("ordinal_base", &ExportResolver::ordinal_base)
+
+    .def("find",
+        [] (const ExportResolver& self, const std::string& name, uint32_t hint) {
+          return error_or(
+            nb::overload_cast<const std::string&, uint32_t>(&ExportResolver::find, nb::const_),
+            self, name, hint);
+        },
+        R"delim(
+        Find the export with the given name. The ``hint`` (e.g.
+        :attr:`lief.PE.ImportEntry.hint`) is the index in the name pointer table
+        checked before the binary search.
+        )delim"_doc,
+        "name"_a, "hint"_a = ExportResolver::NO_HINT)
+
+    .def("find_ordinal",
+        [] (const ExportResolver& self, uint32_t ordinal) {
+          return error_or(&ExportResolver::find_ordinal, self, ordinal);
+        },
+        "Find the export associated with the given (biased) ordinal"_doc,
+        "ordinal"_a)
+
+    .def("name_at",
+        [] (const ExportResolver& self, uint32_t idx) {
+          return error_or(&ExportResolver::name_at, self, idx);
+        },
+        "Name associated with the given index of the name pointer table"_doc,
+        "index"_a);
+}
+}
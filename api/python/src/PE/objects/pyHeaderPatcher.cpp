@@ -0,0 +1,120 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "PE/pyPE.hpp"
+#include "pyErr.hpp"
+
+#include "LIEF/PE/HeaderPatcher.hpp"
+
+#include <string>
+#include <nanobind/stl/string.h>
+
+namespace LIEF::PE::py {
+
+template<>
+void create<HeaderPatcher>(nb::module_& m) {
+  using namespace LIEF::py;
+
+  nb::class_<HeaderPatcher>(m, "HeaderPatcher",
+      R"delim(
+      This class patches fields of the PE headers **in place**: only the
+      modified bytes (and the checksum) are written to the file, without
+      parsing nor rebuilding the binary.
+
+      The checksum is updated from the old and the new values of the patched
+      words instead of being recomputed over the whole file. A checksum set
+      to 0 is left as-is.
+
+      Authenticode does not hash the checksum and the certificate table's
+      data directory. Patching other bytes of a signed binary invalidates its
+      signature which is reported by :attr:`~.signature_invalidated`.
+
+      .. code-block:: python
+
+        patcher = lief.PE.HeaderPatcher.open("program.exe")
+        patcher.time_date_stamp(0x5f5e1000)
+        patcher.flush()
+      )delim"_doc)
+
+    .def_static("open",
+        [] (const std::string& path) -> typing_error<result<HeaderPatcher>> {
+          auto patcher = HeaderPatcher::open(path);
+          if (!patcher) {
+            return nb::cast(LIEF::as_lief_err(patcher));
+          }
+          // HeaderPatcher is move-only
+          return nb::cast(std::move(*patcher));
+        },
+        "Patch the file at the given path"_doc,
+        "path"_a)
+
+    .def_prop_ro("type", &HeaderPatcher::type)
+
+    .def_prop_ro("checksum", &HeaderPatcher::checksum,
+        "Current value of the checksum"_doc)
+
+    .def_prop_ro("is_signed", &HeaderPatcher::is_signed,
+        "Whether the binary has an Authenticode signature"_doc)
+
+    .def_prop_ro("signature_invalidated", &HeaderPatcher::signature_invalidated,
+        "Whether a patch modified bytes hashed by Authenticode"_doc)
+
+    .def("time_date_stamp",
+        [] (HeaderPatcher& self, uint32_t value) {
+          return error_or(&HeaderPatcher::time_date_stamp, self, value);
+        },
+        "Patch :attr:`lief.PE.Header.time_date_stamps`"_doc,
+        "value"_a)
+
+    .def("subsystem",
+        [] (HeaderPatcher& self, OptionalHeader::SUBSYSTEM value) {
+          return error_or(&HeaderPatcher::subsystem, self, value);
+        },
+        "Patch :attr:`lief.PE.OptionalHeader.subsystem`"_doc,
+        "value"_a)
+
+    .def("dll_characteristics",
+        [] (HeaderPatcher& self, uint32_t value) {
+          return error_or(&HeaderPatcher::dll_characteristics, self, value);
+        },
+        "Patch :attr:`lief.PE.OptionalHeader.dll_characteristics`"_doc,
+        "value"_a)
+
+    .def("data_directory",
+        [] (HeaderPatcher& self, DataDirectory::TYPES type, uint32_t rva, uint32_t size) {
+          return error_or(&HeaderPatcher::data_directory, self, type, rva, size);
+        },
+        "Patch the RVA and the size of the given data directory"_doc,
+        "type"_a, "rva"_a, "size"_a)
+
+    .def("patch",
+        [] (HeaderPatcher& self, uint64_t offset, nb::bytes data) {
+          auto ptr = reinterpret_cast<const uint8_t*>(data.c_str());
+          return error_or(&HeaderPatcher::patch, self, offset,
+                          span<const uint8_t>(ptr, data.size()));
+        },
+        R"delim(
+        Write the given bytes at the given file offset. The checksum field
+        can't be patched with this function.
+        )delim"_doc,
+        "offset"_a, "data"_a)
+
+    .def("flush",
+        [] (HeaderPatcher& self) {
+          return error_or(&HeaderPatcher::flush, self);
+        },
+        "Flush the pending writes"_doc);
+}
+}
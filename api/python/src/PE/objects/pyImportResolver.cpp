@@ -0,0 +1,123 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "PE/pyPE.hpp"
+#include "pyErr.hpp"
+
+#include "LIEF/PE/Binary.hpp"
+#include "LIEF/PE/ImportResolver.hpp"
+
+#include "enums_wrapper.hpp"
+
+#include <string>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+
+namespace LIEF::PE::py {
+
+template<>
+void create<ImportResolver>(nb::module_& m) {
+  using namespace LIEF::py;
+
+  nb::class_<ImportResolver> resolver(m, "ImportResolver",
+      R"delim(
+      This class resolves imported functions across a set of DLLs (e.g. a
+      ``system32`` snapshot). The API set contracts are mapped to their host
+      with :class:`~lief.PE.ApiSet` and the export forwarders are followed
+      from DLL to DLL. The resolutions are memoized and the cycles detected.
+
+      .. code-block:: python
+
+        resolver = lief.PE.ImportResolver()
+        resolver.apiset(lief.PE.ApiSet.parse(lief.PE.parse("apisetschema.dll")))
+
+        dlls = [lief.PE.parse(p) for p in pathlib.Path("system32").glob("*.dll")]
+        for dll in dlls:
+          resolver.add(dll, dll.name)
+
+        for imp in resolver.resolve_imports(lief.PE.parse("notepad.exe")):
+          print(imp.library, imp.function, imp.resolution.chain)
+      )delim"_doc);
+
+  #define ENTRY(X) .value(to_string(ImportResolver::STATUS::X), ImportResolver::STATUS::X)
+  enum_<ImportResolver::STATUS>(resolver, "STATUS")
+    ENTRY(RESOLVED)
+    ENTRY(MISSING_LIBRARY)
+    ENTRY(MISSING_EXPORT)
+    ENTRY(MISSING_API_SET)
+    ENTRY(CYCLE);
+  #undef ENTRY
+
+  nb::class_<ImportResolver::resolution_t>(resolver, "resolution_t")
+    .def_ro("status", &ImportResolver::resolution_t::status)
+    .def_ro("library", &ImportResolver::resolution_t::library,
+            "Library that implements the function or where the resolution stopped"_doc)
+    .def_ro("function", &ImportResolver::resolution_t::function)
+    .def_ro("ordinal", &ImportResolver::resolution_t::ordinal)
+    .def_ro("rva", &ImportResolver::resolution_t::rva,
+            "RVA of the function in the last library"_doc)
+    .def_ro("chain", &ImportResolver::resolution_t::chain,
+            "Hops followed (``library!function`` or ``library!#ordinal``)"_doc)
+    .def_prop_ro("is_resolved", &ImportResolver::resolution_t::is_resolved);
+
+  nb::class_<ImportResolver::import_t>(resolver, "import_t")
+    .def_ro("library", &ImportResolver::import_t::library)
+    .def_ro("function", &ImportResolver::import_t::function)
+    .def_ro("ordinal", &ImportResolver::import_t::ordinal)
+    .def_ro("is_ordinal", &ImportResolver::import_t::is_ordinal)
+    .def_ro("is_delayed", &ImportResolver::import_t::is_delayed)
+    .def_ro("resolution", &ImportResolver::import_t::resolution);
+
+  resolver
+    .def(nb::init<>())
+
+    .def("apiset", &ImportResolver::apiset,
+        "Set the API set schema used to resolve the API set contracts"_doc,
+        "schema"_a)
+
+    .def("add",
+        [] (ImportResolver& self, const Binary& dll, const std::string& name) {
+          if (name.empty()) {
+            return error_or(nb::overload_cast<const Binary&>(&ImportResolver::add), self, dll);
+          }
+          return error_or(nb::overload_cast<const Binary&, const std::string&>(&ImportResolver::add),
+                          self, dll, name);
+        },
+        R"delim(
+        Add a DLL to the set. The ``name`` is the name used by the importers
+        (e.g. ``kernel32.dll``). If it is empty, the name stored in the export
+        directory is used.
+        )delim"_doc,
+        "dll"_a, "name"_a = "", nb::keep_alive<1, 2>())
+
+    .def_prop_ro("size", &ImportResolver::size,
+        "Number of DLLs in the set"_doc)
+
+    .def("resolve", &ImportResolver::resolve,
+        "Resolve the function exported by ``library`` under the given name"_doc,
+        "library"_a, "function"_a, "importer"_a = "")
+
+    .def("resolve_ordinal", &ImportResolver::resolve_ordinal,
+        "Resolve the function exported by ``library`` with the given ordinal"_doc,
+        "library"_a, "ordinal"_a, "importer"_a = "")
+
+    .def("resolve_imports", &ImportResolver::resolve_imports,
+        "Resolve all the imports (and the delayed imports) of the given binary"_doc,
+        "binary"_a, "name"_a = "")
+
+    .def("clear_cache", &ImportResolver::clear_cache,
+        "Drop the memoized resolutions"_doc);
+}
+}
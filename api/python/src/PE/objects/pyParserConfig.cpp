@@ -46,6 +46,9 @@ void create<ParserConfig>(nb::module_& m) {
     .def_rw("parse_reloc", &ParserConfig::parse_reloc,
              "Parse PE relocations"_doc)
 
+    .def_rw("budget", &ParserConfig::budget,
+            "Resources that the parser can use (c.f. :class:`lief.ParserBudget`)"_doc)
+
     .def_prop_ro_static("all",
       [] (const nb::object& /* self */) { return ParserConfig::all(); },
       R"delim(
@@ -21,13 +21,24 @@
 #include <string>
 #include <sstream>
 #include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
 #include <nanobind/extra/memoryview.hpp>
 
 namespace LIEF::PE::py {
 
 template<>
 void create<SpcIndirectData>(nb::module_& m) {
-  nb::class_<SpcIndirectData, ContentInfo::Content>(m, "SpcIndirectData")
+  nb::class_<SpcIndirectData, ContentInfo::Content> spc(m, "SpcIndirectData");
+
+  nb::class_<SpcIndirectData::page_hash_t>(spc, "page_hash_t",
+    "Entry of the page hashes table (``SPC_PE_IMAGE_PAGE_HASHES``)"_doc)
+    .def_ro("offset", &SpcIndirectData::page_hash_t::offset,
+            "File offset of the page"_doc)
+    .def_prop_ro("digest", [] (const SpcIndirectData::page_hash_t& entry) {
+                   return nb::memoryview::from_memory(entry.digest.data(), entry.digest.size());
+                 }, "Digest of the page (zero-filled for the last entry)"_doc);
+
+  spc
     .def_prop_ro("digest_algorithm", &SpcIndirectData::digest_algorithm,
                  R"delim(
                  Digest used to hash the file. This should match
@@ -39,6 +50,24 @@ void create<SpcIndirectData>(nb::module_& m) {
                    return nb::memoryview::from_memory(digest.data(), digest.size());
                  })
     .def_prop_ro("file", &SpcIndirectData::file)
+
+    .def_prop_ro("page_hash_algorithm", &SpcIndirectData::page_hash_algorithm,
+                 R"delim(
+                 Algorithm used for the page hashes (:attr:`~lief.PE.ALGORITHMS.SHA_1`
+                 or :attr:`~lief.PE.ALGORITHMS.SHA_256`) or :attr:`~lief.PE.ALGORITHMS.UNKNOWN`
+                 if the signature does not embed page hashes
+                 )delim"_doc)
+
+    .def_prop_ro("page_hashes", &SpcIndirectData::page_hashes,
+                 R"delim(
+                 Per-page hashes, sorted by file offset. The last entry marks the
+                 end of the hashed data.
+
+                 .. seealso::
+
+                    :meth:`lief.PE.Binary.verify_page`
+                 )delim"_doc,
+                 nb::rv_policy::reference_internal)
     LIEF_DEFAULT_STR(SpcIndirectData);
 }
 
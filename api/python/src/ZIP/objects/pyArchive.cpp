@@ -0,0 +1,215 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "LIEF/ZIP/Archive.hpp"
+#include "LIEF/ZIP/Entry.hpp"
+#include "LIEF/Abstract/Binary.hpp"
+#include "LIEF/DEX/File.hpp"
+
+#include "ZIP/pyZIP.hpp"
+#include "pyErr.hpp"
+#include "pyIterator.hpp"
+
+#include <sstream>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+#include <nanobind/stl/unique_ptr.h>
+
+namespace LIEF::ZIP::py {
+
+namespace {
+// Python list of entries that keep the archive alive
+nb::list to_list(const Archive& self, const std::vector<const Entry*>& entries) {
+  nb::list out;
+  nb::handle parent = nb::find(self);
+  for (const Entry* entry : entries) {
+    nb::object py_entry = nb::cast(entry, nb::rv_policy::reference);
+    // Same as reference_internal: the entry keeps the archive alive
+    nb::detail::keep_alive(py_entry.ptr(), parent.ptr());
+    out.append(std::move(py_entry));
+  }
+  return out;
+}
+
+std::vector<const Entry*> from_list(const std::vector<Entry*>& entries) {
+  return {entries.begin(), entries.end()};
+}
+
+template<class T>
+nb::list to_list(std::vector<std::unique_ptr<T>> objects) {
+  nb::list out;
+  for (std::unique_ptr<T>& obj : objects) {
+    out.append(nb::cast(obj.release(), nb::rv_policy::take_ownership));
+  }
+  return out;
+}
+}
+
+template<>
+void create<Archive>(nb::module_& m) {
+  using namespace LIEF::py;
+
+  nb::class_<Archive> archive(m, "Archive",
+      R"delim(
+      This class represents a ZIP archive (e.g. an APK or a JAR) indexed from
+      its central directory.
+
+      Stored entries are accessed without any copy while deflated entries are
+      inflated on demand. An entry can't inflate beyond its declared size.
+
+      .. code-block:: python
+
+        apk = lief.ZIP.parse("app.apk")
+        libs = apk.parse_all(apk.native_libraries("arm64-v8a"))
+        dex = apk.parse_dex(apk.get_entry("classes.dex"))
+      )delim"_doc);
+
+  nb::class_<Archive::dex_pool_t>(archive, "dex_pool_t",
+      "Strings and types shared by the DEX files of a (multi-dex) APK"_doc)
+    .def_prop_ro("strings",
+        [] (const Archive::dex_pool_t& self) {
+          nb::list out;
+          for (const std::string& str : self.strings) {
+            out.append(nb::bytes(str.data(), str.size()));
+          }
+          return out;
+        }, "Unique strings (raw MUTF-8) of all the DEX files"_doc)
+
+    .def_ro("types", &Archive::dex_pool_t::types,
+        "Unique type descriptors as indexes in :attr:`~.strings`"_doc)
+
+    .def_ro("strings_map", &Archive::dex_pool_t::strings_map,
+        R"delim(
+        For each DEX file, map a local string index to its index in
+        :attr:`~.strings`
+        )delim"_doc)
+
+    .def_ro("types_map", &Archive::dex_pool_t::types_map,
+        R"delim(
+        For each DEX file, map a local type index to its index in
+        :attr:`~.types`
+        )delim"_doc);
+
+  init_ref_iterator<Archive::it_const_entries>(archive, "it_const_entries");
+
+  archive
+    .def_prop_ro("entries", &Archive::entries,
+        "Iterator over the entries of the central directory"_doc,
+        nb::keep_alive<0, 1>())
+
+    .def("get_entry", &Archive::get_entry,
+        "Return the entry with the given name or None if not found"_doc,
+        "name"_a, nb::rv_policy::reference_internal)
+
+    .def_prop_ro("dex_files",
+        [] (const Archive& self) {
+          return to_list(self, self.dex_files());
+        },
+        R"delim(
+        DEX files of the APK in the order used by the runtime
+        (``classes.dex``, ``classes2.dex``, ...)
+        )delim"_doc)
+
+    .def("native_libraries",
+        [] (const Archive& self, const std::string& abi) {
+          return to_list(self, self.native_libraries(abi));
+        },
+        R"delim(
+        Native libraries (``lib/<abi>/*.so``). If ``abi`` is not empty
+        (e.g. ``arm64-v8a``), only the libraries of this ABI are returned.
+        )delim"_doc,
+        "abi"_a = "")
+
+    .def("extract",
+        [] (const Archive& self, const Entry& entry, bool check_crc) {
+          return error_or([&] () -> result<nb::bytes> {
+            std::vector<uint8_t> buffer;
+            auto data = self.content(entry, buffer, check_crc);
+            if (!data) {
+              return make_error_code(get_error(data));
+            }
+            return nb::bytes(reinterpret_cast<const char*>(data->data()), data->size());
+          });
+        },
+        R"delim(
+        Uncompressed content of the given entry. The CRC-32 is checked if
+        ``check_crc`` is true.
+        )delim"_doc,
+        "entry"_a, "check_crc"_a = true)
+
+    .def("parse", &Archive::parse,
+        R"delim(
+        Parse the given entry with the format-specific parser (ELF, PE,
+        Mach-O) or return None if the entry is not supported.
+        )delim"_doc,
+        "entry"_a, nb::rv_policy::take_ownership)
+
+    .def("parse_dex", &Archive::parse_dex,
+        "Parse the given entry as a DEX file"_doc,
+        "entry"_a, nb::rv_policy::take_ownership)
+
+    .def("parse_all",
+        [] (const Archive& self, const std::vector<Entry*>& entries, uint32_t nb_threads) {
+          std::vector<std::unique_ptr<Binary>> binaries;
+          {
+            nb::gil_scoped_release release;
+            binaries = self.parse_all(from_list(entries), nb_threads);
+          }
+          return to_list(std::move(binaries));
+        },
+        R"delim(
+        Parse the given entries (e.g. :meth:`~.native_libraries`) from at most
+        ``nb_threads`` threads (0: number of hardware threads).
+
+        The i-th element of the returned list is the binary of ``entries[i]``
+        or None if it can't be parsed.
+        )delim"_doc,
+        "entries"_a, "nb_threads"_a = 0)
+
+    .def("parse_dex_all",
+        [] (const Archive& self, const std::vector<Entry*>& entries, uint32_t nb_threads) {
+          std::vector<std::unique_ptr<DEX::File>> files;
+          {
+            nb::gil_scoped_release release;
+            files = self.parse_dex_all(from_list(entries), nb_threads);
+          }
+          return to_list(std::move(files));
+        },
+        R"delim(
+        Parse the given entries (e.g. :attr:`~.dex_files`) as DEX files from at
+        most ``nb_threads`` threads (0: number of hardware threads)
+        )delim"_doc,
+        "entries"_a, "nb_threads"_a = 0)
+
+    .def("dex_pool",
+        [] (const Archive& self) {
+          return error_or(&Archive::dex_pool, self);
+        },
+        R"delim(
+        Deduplicate the strings and the type descriptors of all the DEX files
+        of the APK (see: :attr:`~.dex_files`). The DEX files do not need to be
+        parsed.
+        )delim"_doc)
+
+    .def_prop_ro("raw",
+        [] (const Archive& self) {
+          const std::vector<uint8_t>& raw = self.raw();
+          return nb::bytes(reinterpret_cast<const char*>(raw.data()), raw.size());
+        }, "Raw data of the archive"_doc)
+
+    LIEF_DEFAULT_STR(Archive);
+}
+
+}
@@ -0,0 +1,110 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "LIEF/ZIP/Entry.hpp"
+
+#include "ZIP/pyZIP.hpp"
+#include "enums_wrapper.hpp"
+
+#include <sstream>
+#include <nanobind/stl/string.h>
+#include "nanobind/extra/memoryview.hpp"
+
+namespace LIEF::ZIP::py {
+template<>
+void create<Entry>(nb::module_& m) {
+  using namespace LIEF::py;
+
+  nb::class_<Entry> entry(m, "Entry",
+      R"delim(
+      This class represents an entry (i.e. a file) of a ZIP archive. Its raw
+      content references the data of the :class:`~lief.ZIP.Archive` that
+      contains it.
+      )delim"_doc);
+
+  #define ENTRY(X) .value(to_string(Entry::METHOD::X), Entry::METHOD::X)
+  enum_<Entry::METHOD>(entry, "METHOD")
+    ENTRY(STORED)
+    ENTRY(DEFLATED);
+  #undef ENTRY
+
+  entry
+    .def_prop_ro("name", &Entry::name,
+        "Full path of the entry (e.g. ``lib/arm64-v8a/libfoo.so``)"_doc)
+
+    .def_prop_ro("method", &Entry::method,
+        R"delim(
+        Compression method. Other values than ``STORED`` and ``DEFLATED`` are
+        not supported.
+        )delim"_doc)
+
+    .def_prop_ro("flags", &Entry::flags,
+        "General purpose flags"_doc)
+
+    .def_prop_ro("crc32", &Entry::crc32,
+        "CRC-32 of the uncompressed data"_doc)
+
+    .def_prop_ro("size", &Entry::size,
+        "Size of the uncompressed data"_doc)
+
+    .def_prop_ro("compressed_size", &Entry::compressed_size,
+        "Size of the data as stored in the archive"_doc)
+
+    .def_prop_ro("offset", &Entry::offset,
+        "Offset of the local header in the archive"_doc)
+
+    .def_prop_ro("data_offset", &Entry::data_offset,
+        "Offset of the (compressed) data in the archive"_doc)
+
+    .def_prop_ro("raw_content",
+        [] (const Entry& self) {
+          const span<const uint8_t> content = self.raw_content();
+          return nb::memoryview::from_memory(content.data(), content.size());
+        },
+        R"delim(
+        Data as stored in the archive (i.e. compressed for deflated entries)
+        )delim"_doc)
+
+    .def_prop_ro("is_stored", &Entry::is_stored,
+        "Whether the entry is stored without compression"_doc)
+
+    .def_prop_ro("is_directory", &Entry::is_directory,
+        "Whether the entry is a directory"_doc)
+
+    .def_prop_ro("is_encrypted", &Entry::is_encrypted,
+        "Whether the entry is encrypted (not supported)"_doc)
+
+    .def("is_page_aligned", &Entry::is_page_aligned,
+        R"delim(
+        Whether the entry is stored uncompressed at an offset aligned on the
+        given page size. This is the layout that Android uses for the native
+        libraries so that they can be mapped from the APK
+        (``android:extractNativeLibs="false"``).
+        )delim"_doc,
+        "page_size"_a = 0x1000)
+
+    .def_prop_ro("is_dex", &Entry::is_dex,
+        R"delim(
+        Whether the entry is a DEX file of an APK (``classes.dex``,
+        ``classes2.dex``, ...)
+        )delim"_doc)
+
+    .def_prop_ro("is_native_library", &Entry::is_native_library,
+        "Whether the entry is a native library of an APK (``lib/<abi>/*.so``)"_doc)
+
+    LIEF_DEFAULT_STR(Entry);
+}
+
+}
@@ -0,0 +1,46 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ZIP/pyZIP.hpp"
+
+#include "LIEF/ZIP/utils.hpp"
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+
+namespace LIEF::ZIP::py {
+
+void init_utils(nb::module_& m) {
+  m.def("is_zip", nb::overload_cast<const std::string&>(&is_zip),
+      "Check if the **file** given in parameter is a ZIP archive"_doc,
+      "path"_a);
+
+  m.def("is_zip", nb::overload_cast<const std::vector<uint8_t>&>(&is_zip),
+      "Check if the **raw data** given in parameter is a ZIP archive"_doc,
+      "raw"_a);
+
+  m.def("crc32",
+      [] (nb::bytes data, uint32_t crc) {
+        auto ptr = reinterpret_cast<const uint8_t*>(data.c_str());
+        return crc32(span<const uint8_t>(ptr, data.size()), crc);
+      },
+      R"delim(
+      CRC-32 (ISO-HDLC) of the given data as used by ZIP and GZIP. ``crc`` is
+      the CRC-32 of the previous data when the checksum is computed in
+      several steps.
+      )delim"_doc,
+      "data"_a, "crc"_a = 0);
+}
+
+}
@@ -0,0 +1,152 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "checksec/init.hpp"
+
+#include "LIEF/checksec.hpp"
+
+#include "pyErr.hpp"
+#include "enums_wrapper.hpp"
+
+#include <sstream>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+
+namespace LIEF::checksec::py {
+
+void init(nb::module_& m) {
+  using namespace LIEF::py;
+  nb::module_ mod = m.def_submodule("checksec",
+      "Hardening audit (à la ``checksec``) of ELF, PE and Mach-O binaries"_doc);
+
+  enum_<FORMAT>(mod, "FORMAT")
+  #define PY_ENUM(x) to_string(x), x
+    .value(PY_ENUM(FORMAT::UNKNOWN))
+    .value(PY_ENUM(FORMAT::ELF))
+    .value(PY_ENUM(FORMAT::PE))
+    .value(PY_ENUM(FORMAT::MACHO))
+  #undef PY_ENUM
+  ;
+
+  enum_<PROPERTY>(mod, "PROPERTY", nb::is_arithmetic())
+  #define PY_ENUM(x) to_string(x), x
+    .value(PY_ENUM(PROPERTY::NONE))
+    .value(PY_ENUM(PROPERTY::PIE))
+    .value(PY_ENUM(PROPERTY::NX))
+    .value(PY_ENUM(PROPERTY::CANARY))
+    .value(PY_ENUM(PROPERTY::FORTIFY))
+    .value(PY_ENUM(PROPERTY::RELRO))
+    .value(PY_ENUM(PROPERTY::BIND_NOW))
+    .value(PY_ENUM(PROPERTY::RPATH))
+    .value(PY_ENUM(PROPERTY::RUNPATH))
+    .value(PY_ENUM(PROPERTY::IBT))
+    .value(PY_ENUM(PROPERTY::SHSTK))
+    .value(PY_ENUM(PROPERTY::PAC))
+    .value(PY_ENUM(PROPERTY::HIGH_ENTROPY_VA))
+    .value(PY_ENUM(PROPERTY::FORCE_INTEGRITY))
+    .value(PY_ENUM(PROPERTY::NO_SEH))
+    .value(PY_ENUM(PROPERTY::SAFESEH))
+    .value(PY_ENUM(PROPERTY::CFG))
+    .value(PY_ENUM(PROPERTY::XFG))
+    .value(PY_ENUM(PROPERTY::APPCONTAINER))
+    .value(PY_ENUM(PROPERTY::SIGNED))
+    .value(PY_ENUM(PROPERTY::NX_HEAP))
+    .value(PY_ENUM(PROPERTY::RESTRICT))
+    .value(PY_ENUM(PROPERTY::HARDENED_RUNTIME))
+    .value(PY_ENUM(PROPERTY::LIBRARY_VALIDATION))
+    .value(PY_ENUM(PROPERTY::ENCRYPTED))
+  #undef PY_ENUM
+  ;
+
+  nb::class_<report_t>(mod, "report_t", "Hardening report of a binary"_doc)
+    .def_ro("format", &report_t::format,
+            "Format of the audited binary"_doc)
+
+    .def_ro("properties", &report_t::properties,
+            "Properties that are enabled"_doc)
+
+    .def_ro("checked", &report_t::checked,
+        R"delim(
+        Properties that have been checked. A property which is not set in
+        :attr:`~.properties` but which is set in this mask is disabled.
+        Otherwise, it does not apply to the format or it could not be
+        determined.
+        )delim"_doc)
+
+    .def_ro("nb_slices", &report_t::nb_slices,
+        R"delim(
+        Number of slices audited (greater than 1 for a FAT Mach-O). For a FAT
+        Mach-O, a property is enabled (or checked) if it is enabled (or
+        checked) in all the slices.
+        )delim"_doc)
+
+    .def("has", &report_t::has,
+         "Check if the given property is enabled"_doc,
+         "property"_a)
+
+    .def("is_checked", &report_t::is_checked,
+         "Check if the given property has been checked"_doc,
+         "property"_a)
+
+    .def_prop_ro("full_relro", &report_t::full_relro,
+                 "ELF: RELRO + BIND_NOW"_doc)
+
+    LIEF_DEFAULT_STR(report_t);
+
+  mod.def("audit",
+      [] (const std::string& path) {
+        return error_or(nb::overload_cast<const std::string&>(&audit), path);
+      },
+      R"delim(
+      Audit the binary located at the given path. Only the blocks of the file
+      that contain the headers and the tables needed by the audit are read.
+      )delim"_doc,
+      "path"_a);
+
+  mod.def("audit",
+      [] (nb::bytes raw) {
+        auto ptr = reinterpret_cast<const uint8_t*>(raw.c_str());
+        return error_or(nb::overload_cast<span<const uint8_t>>(&audit),
+                        span<const uint8_t>(ptr, raw.size()));
+      },
+      "Audit the binary in the given buffer"_doc,
+      "raw"_a);
+
+  mod.def("audit",
+      [] (const std::vector<std::string>& paths, uint32_t nb_threads) {
+        std::vector<result<report_t>> reports;
+        {
+          nb::gil_scoped_release release;
+          reports = audit(paths, nb_threads);
+        }
+        nb::list out;
+        for (result<report_t>& report : reports) {
+          if (report) {
+            out.append(nb::cast(*report));
+          } else {
+            out.append(nb::cast(as_lief_err(report)));
+          }
+        }
+        return out;
+      },
+      R"delim(
+      Audit the files located at the given paths from at most ``nb_threads``
+      threads (0: number of hardware threads). The i-th element of the
+      returned list is the :class:`~.report_t` (or the error) of the i-th
+      path.
+      )delim"_doc,
+      "paths"_a, "nb_threads"_a = 0);
+}
+}
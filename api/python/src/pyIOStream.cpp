@@ -41,6 +41,28 @@ result<PyIOStream> PyIOStream::from_python(nb::object object) {
     return make_error_code(lief_errors::read_error);
   }
 
+  if (nb::hasattr(object, "seekable") && !nb::cast<bool>(object.attr("seekable")())) {
+    // Pipes, sockets, ...: consume the object until EOF
+    static constexpr size_t CHUNK_SIZE = 0x10000;
+    std::vector<uint8_t> data;
+    auto read = object.attr("read");
+    while (true) {
+      nb::object chunk = read(CHUNK_SIZE);
+      if (chunk.is_none()) {
+        logging::log(logging::LEVEL::ERR,
+            "Non-blocking io objects are not supported");
+        return make_error_code(lief_errors::read_error);
+      }
+      auto content = nb::cast<nb::bytes>(chunk);
+      if (content.size() == 0) {
+        break;
+      }
+      const auto* raw = reinterpret_cast<const uint8_t*>(content.c_str());
+      data.insert(data.end(), raw, raw + content.size());
+    }
+    return PyIOStream(std::move(object), std::move(data));
+  }
+
   auto seek = object.attr("seek");
   seek(0, PY_SEEK_SET);
   seek(0, PY_SEEK_END);
@@ -59,6 +59,10 @@
   #include "DEX/init.hpp"
 #endif
 
+#include "AR/init.hpp"
+#include "ZIP/init.hpp"
+#include "checksec/init.hpp"
+
 #if defined(LIEF_VDEX_SUPPORT)
   #include "VDEX/init.hpp"
 #endif
@@ -243,6 +247,9 @@ void init(nb::module_& m) {
   LIEF::dwarf::py::init(m);
   LIEF::pdb::py::init(m);
   LIEF::objc::py::init(m);
+  LIEF::AR::py::init(m);
+  LIEF::ZIP::py::init(m);
+  LIEF::checksec::py::init(m);
 
 #if defined(LIEF_ELF_SUPPORT)
   LIEF::ELF::py::init(m);
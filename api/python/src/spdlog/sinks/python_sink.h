@@ -24,11 +24,15 @@ class python_base_sink final : public base_sink<Mutex> {
     base_sink<Mutex>::formatter_->format(msg, formatted);
     std::string msg_str(formatted.data(), formatted.size());
 
+    // LIEF can log from its worker threads (e.g. parallel parsing) which
+    // do not hold the GIL
+    const PyGILState_STATE gil = PyGILState_Ensure();
     if constexpr (std::is_same_v<ErrOrOut, py_stderr_tag>) {
       PySys_WriteStderr("%s", msg_str.c_str());
     } else {
       PySys_WriteStdout("%s", msg_str.c_str());
     }
+    PyGILState_Release(gil);
   }
 };
 
@@ -4,7 +4,7 @@ use super::elf;
 use super::macho;
 use super::pe;
 use crate::common::FromFFI;
-use std::io::{Read, Seek};
+use std::io::{Read, Seek, SeekFrom};
 
 #[derive(Debug)]
 /// Enum that wraps all the executable formats supported by LIEF
@@ -36,6 +36,12 @@ impl Binary {
     }
     /// Parse from an input that implements `Read + Seek` traits
     ///
+    /// The input is read on demand, from its current position, while it is
+    /// parsed. This does not save memory compared to reading the whole input
+    /// first: the ELF parser (as the other parsers) buffers all the data pulled
+    /// from the reader. [`Binary::from_slice`] is the only entry point that
+    /// avoids a copy of the input.
+    ///
     /// ```
     /// let mut file = std::fs::File::open("C:/test.ext").expect("Can't open the file");
     /// if let Some(Binary::PE(pe)) = Binary::from(&mut file) {
@@ -43,15 +49,46 @@ impl Binary {
     /// }
     /// ```
     pub fn from<R: Read + Seek>(reader: &mut R) -> Option<Binary> {
-        let mut buffer = std::vec::Vec::new();
-        if reader.read_to_end(&mut buffer).is_err() {
-            return None;
-        }
+        let start = reader.stream_position().ok()?;
+        let end = reader.seek(SeekFrom::End(0)).ok()?;
+        reader.seek(SeekFrom::Start(start)).ok()?;
+
+        // `reader` is borrowed for the whole call and the C++ stream
+        // does not outlive the parsing
+        let ffi_stream = unsafe {
+            ffi::RustStream::from_rust_reader(
+                read_callback::<R> as usize,
+                reader as *mut R as usize,
+                end.saturating_sub(start),
+            )
+        };
+        Binary::from_ffi_stream(ffi_stream)
+    }
 
-        let mut ffi_stream =
-            unsafe { ffi::RustStream::from_rust(buffer.as_mut_ptr(), buffer.len()) };
-        buffer.clear();
+    /// Parse from a borrowed buffer (e.g. the content of a memory-mapped file)
+    ///
+    /// This is the only entry point that does not copy the input: the parsers
+    /// only copy the parts they need to own while the slice is borrowed for
+    /// the duration of the call. For a file, pass the content of a memory
+    /// mapping (e.g. `&mmap[..]`) to avoid loading it in memory.
+    ///
+    /// The returned binaries are not `Send`: the C++ objects behind them give
+    /// no guarantee that they can be moved across threads. To parse from a
+    /// thread pool, call `from_slice` on each worker thread.
+    ///
+    /// ```
+    /// let data = std::fs::read("/bin/ls").expect("Can't read the file");
+    /// if let Some(Binary::ELF(elf)) = Binary::from_slice(&data) {
+    ///     // ...
+    /// }
+    /// ```
+    pub fn from_slice(data: &[u8]) -> Option<Binary> {
+        let ffi_stream =
+            unsafe { ffi::RustStream::from_rust_slice(data.as_ptr(), data.len()) };
+        Binary::from_ffi_stream(ffi_stream)
+    }
 
+    fn from_ffi_stream(mut ffi_stream: cxx::UniquePtr<ffi::RustStream>) -> Option<Binary> {
         if ffi_stream.is_elf() {
             return Some(Binary::ELF(elf::Binary::from_ffi(
                 ffi_stream.pin_mut().as_elf(),
@@ -70,3 +107,17 @@ impl Binary {
         None
     }
 }
+
+/// Callback used by the C++ stream to pull the data from the reader given
+/// to [`Binary::from`]
+extern "C" fn read_callback<R: Read>(ctx: *mut std::ffi::c_void, dst: *mut u8, size: usize) -> usize {
+    let reader = unsafe { &mut *(ctx as *mut R) };
+    let buffer = unsafe { std::slice::from_raw_parts_mut(dst, size) };
+    loop {
+        match reader.read(buffer) {
+            Ok(count) => return count,
+            Err(err) if err.kind() == std::io::ErrorKind::Interrupted => continue,
+            Err(_) => return 0,
+        }
+    }
+}
@@ -14,7 +14,7 @@ pub struct Section<'a> {
     _owner: PhantomData<&'a ()>
 }
 
-impl Section<'_> {
+impl<'a> Section<'a> {
     /// Type of the section
     pub fn get_type(&self) -> Type {
         Type::from(self.ptr.get_type())
@@ -62,7 +62,10 @@ impl Section<'_> {
     }
 
     /// Content of the section as a slice of bytes
-    pub fn content(&self) -> &[u8] {
+    ///
+    /// The slice borrows the binary (not this object): it remains valid as
+    /// long as the binary is alive and it is not copied from the C++ side.
+    pub fn content(&self) -> &'a [u8] {
         to_slice!(self.ptr.content());
     }
 }
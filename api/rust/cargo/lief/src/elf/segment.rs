@@ -129,7 +129,10 @@ impl FromFFI<ffi::ELF_Segment> for Segment<'_> {
 
 impl<'a> Segment<'a> {
     /// Content of the segment as a slice of bytes
-    pub fn content(&self) -> &[u8] {
+    ///
+    /// The slice borrows the binary (not this object): it remains valid as
+    /// long as the binary is alive and it is not copied from the C++ side.
+    pub fn content(&self) -> &'a [u8] {
         to_slice!(self.ptr.content());
     }
 
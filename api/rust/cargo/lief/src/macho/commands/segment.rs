@@ -14,7 +14,7 @@ pub struct Segment<'a> {
     _owner: PhantomData<&'a ffi::MachO_Binary>
 }
 
-impl Segment<'_> {
+impl<'a> Segment<'a> {
     /// Name of the segment (e.g. `__TEXT`)
     pub fn name(&self) -> String {
         self.ptr.name().to_string()
@@ -61,7 +61,10 @@ impl Segment<'_> {
     }
 
     /// The raw content of this segment as a slice of bytes
-    pub fn content(&self) -> &[u8] {
+    ///
+    /// The slice borrows the binary (not this object): it remains valid as
+    /// long as the binary is alive and it is not copied from the C++ side.
+    pub fn content(&self) -> &'a [u8] {
         to_slice!(self.ptr.content());
     }
 
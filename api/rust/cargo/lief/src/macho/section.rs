@@ -7,6 +7,7 @@ use std::marker::PhantomData;
 use crate::common::{into_optional, FromFFI};
 use crate::declare_iterator;
 use crate::generic;
+use crate::to_slice;
 
 use bitflags::bitflags;
 
@@ -132,7 +133,15 @@ impl std::fmt::Display for Flags {
     }
 }
 
-impl Section<'_> {
+impl<'a> Section<'a> {
+    /// Content of the section as a slice of bytes
+    ///
+    /// The slice borrows the binary (not this object): it remains valid as
+    /// long as the binary is alive and it is not copied from the C++ side.
+    pub fn content(&self) -> &'a [u8] {
+        to_slice!(generic::Section::as_generic(self).content());
+    }
+
     /// Name of the segment that owns this section
     pub fn segment_name(&self) -> String {
         self.ptr.segment_name().to_string()
@@ -76,7 +76,15 @@ impl std::fmt::Display for Characteristics {
     }
 }
 
-impl Section<'_> {
+impl<'a> Section<'a> {
+    /// Content of the section as a slice of bytes
+    ///
+    /// The slice borrows the binary (not this object): it remains valid as
+    /// long as the binary is alive and it is not copied from the C++ side.
+    pub fn content(&self) -> &'a [u8] {
+        to_slice!(generic::Section::as_generic(self).content());
+    }
+
     /// Return the size of the data in the section.
     pub fn sizeof_raw_data(&self) -> u32 {
         self.ptr.sizeof_raw_data()
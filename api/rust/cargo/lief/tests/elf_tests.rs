@@ -221,3 +221,26 @@ fn test_api() {
     test_with("simple-gcc-c.bin");
 }
 
+
+#[test]
+fn test_from_slice() {
+    let path = utils::get_elf_sample("ELF64_x86-64_binary_etterlog.bin").unwrap();
+    let data = std::fs::read(&path).expect("Can't read the file");
+
+    let Some(Binary::ELF(elf)) = Binary::from_slice(&data) else {
+        panic!("Can't parse {path:?}");
+    };
+    let mut file = std::fs::File::open(&path).expect("Can't open the file");
+    let Some(Binary::ELF(reference)) = Binary::from(&mut file) else {
+        panic!("Can't parse {path:?}");
+    };
+    assert!(elf.sections().count() > 0);
+    assert_eq!(elf.sections().count(), reference.sections().count());
+    assert_eq!(elf.entrypoint(), reference.entrypoint());
+
+    // The content borrows the binary, not the section or the segment
+    let text = elf.section_by_name(".text").expect("Missing .text").content();
+    assert!(!text.is_empty());
+    let contents: Vec<&[u8]> = elf.segments().map(|segment| segment.content()).collect();
+    assert!(contents.iter().any(|content| !content.is_empty()));
+}
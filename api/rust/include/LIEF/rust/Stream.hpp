@@ -16,6 +16,8 @@
 #include <memory>
 
 #include "LIEF/BinaryStream/VectorStream.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
+#include "LIEF/BinaryStream/ForwardStream.hpp"
 
 #include "LIEF/rust/ELF/Binary.hpp"
 #include "LIEF/ELF/utils.hpp"
@@ -36,12 +38,28 @@ struct IRustStream;
 class RustStream {
   public:
   RustStream() = delete;
-  RustStream(std::unique_ptr<LIEF::VectorStream> stream) :
+  RustStream(std::unique_ptr<LIEF::BinaryStream> stream) :
     stream_(std::move(stream))
   {}
   LIEF_API
   static std::unique_ptr<RustStream> from_rust(uint8_t* buffer , size_t size);
 
+  /// Create a stream that borrows the given buffer (no copy).
+  /// The buffer must outlive the parsing (i.e. the `as_xxx()` calls).
+  LIEF_API
+  static std::unique_ptr<RustStream> from_rust_slice(const uint8_t* buffer, size_t size);
+
+  /// Signature of the callback used by from_rust_reader(): it reads at most
+  /// `size` bytes in `dst` and returns the number of bytes read (0 at the end
+  /// of the input)
+  using read_fn_t = size_t(*)(void* ctx, uint8_t* dst, size_t size);
+
+  /// Create a stream that pulls the data on demand from a Rust reader.
+  /// `read_fn` is a `read_fn_t` called with `ctx` and `size` is the size of the
+  /// input (0 if unknown). The reader must outlive the parsing.
+  LIEF_API
+  static std::unique_ptr<RustStream> from_rust_reader(size_t read_fn, size_t ctx, uint64_t size);
+
   bool is_elf() const {
     return LIEF::ELF::is_elf(*stream_);
   }
@@ -68,5 +86,5 @@ class RustStream {
 
   ~RustStream() = default;
   private:
-  std::unique_ptr<LIEF::VectorStream> stream_;
+  std::unique_ptr<LIEF::BinaryStream> stream_;
 };
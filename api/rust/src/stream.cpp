@@ -17,9 +17,28 @@
 #include <vector>
 #include "LIEF/rust/Stream.hpp"
 #include "LIEF/BinaryStream/VectorStream.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
+#include "LIEF/BinaryStream/ForwardStream.hpp"
 
 std::unique_ptr<RustStream> RustStream::from_rust(uint8_t* buffer, size_t size) {
   std::vector<uint8_t> vector{buffer, buffer + size};
   auto vstream = std::make_unique<LIEF::VectorStream>(std::move(vector));
   return std::make_unique<RustStream>(std::move(vstream));
 }
+
+std::unique_ptr<RustStream> RustStream::from_rust_slice(const uint8_t* buffer, size_t size) {
+  auto sstream = std::make_unique<LIEF::SpanStream>(buffer, size);
+  return std::make_unique<RustStream>(std::move(sstream));
+}
+
+std::unique_ptr<RustStream> RustStream::from_rust_reader(size_t read_fn, size_t ctx, uint64_t size) {
+  auto reader = reinterpret_cast<read_fn_t>(read_fn);
+  auto* context = reinterpret_cast<void*>(ctx);
+  LIEF::ForwardStream::config_t config;
+  config.size = size;
+  auto fstream = std::make_unique<LIEF::ForwardStream>(
+    [reader, context] (uint8_t* dst, size_t len) {
+      return reader(context, dst, len);
+    }, config);
+  return std::make_unique<RustStream>(std::move(fstream));
+}
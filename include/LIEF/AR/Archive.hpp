@@ -0,0 +1,139 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_AR_ARCHIVE_H
+#define LIEF_AR_ARCHIVE_H
+#include <ostream>
+#include <string>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+#include "LIEF/visibility.h"
+#include "LIEF/iterators.hpp"
+
+namespace LIEF {
+class Binary;
+namespace AR {
+class Parser;
+class Member;
+
+//! This class represents a static archive (``.a``, ``.lib``) made of
+//! object files.
+//!
+//! The archive owns the raw data once and the LIEF::AR::Member objects only
+//! reference sub-ranges of this data. Therefore, an archive must outlive
+//! its members and the streams created from them.
+//!
+//! @warning The members of MSVC ``.lib`` archives are bare COFF objects (or
+//! import descriptors) which are not supported by LIEF's PE parser since it
+//! requires a DOS/PE header. For these archives, the symbol table is
+//! available but the members are not parsed (LIEF::AR::Member::format()
+//! is LIEF::Binary::FORMATS::UNKNOWN).
+class LIEF_API Archive {
+  friend class Parser;
+
+  public:
+  //! Flavor of the archive, based on its symbol table and long names
+  enum class KIND {
+    UNKNOWN = 0,
+    GNU, ///< SysV/GNU archive (``/`` and ``//`` special members)
+    BSD, ///< BSD/Apple archive (``#1/`` names and ``__.SYMDEF``)
+    COFF, ///< MSVC archive (two ``/`` linker members)
+  };
+
+  using members_t = std::vector<std::unique_ptr<Member>>;
+  using it_const_members = const_ref_iterator<const members_t&, const Member*>;
+
+  //! Symbol name -> member that defines this symbol
+  using symbols_t = std::unordered_map<std::string, const Member*>;
+
+  Archive(const Archive&) = delete;
+  Archive& operator=(const Archive&) = delete;
+
+  KIND kind() const {
+    return kind_;
+  }
+
+  //! Iterator over the regular members of the archive (i.e. without the
+  //! symbol tables and the long names table)
+  it_const_members members() const {
+    return members_;
+  }
+
+  //! Return the member with the given name or a nullptr if not found
+  const Member* get_member(const std::string& name) const;
+
+  //! Symbols indexed by the archive's symbol table
+  //! (SysV/GNU, ``/SYM64/``, MSVC linker member or ``__.SYMDEF``).
+  const symbols_t& symbols() const {
+    return symbols_;
+  }
+
+  //! Return the member that defines the given symbol according to the
+  //! archive's symbol table. It does not require to parse the members.
+  //!
+  //! If the symbol is defined multiple times, the first member is returned
+  //! (as a linker would do).
+  const Member* find_symbol(const std::string& name) const {
+    auto it = symbols_.find(name);
+    return it != symbols_.end() ? it->second : nullptr;
+  }
+
+  //! Check if the given symbol is defined in the archive's symbol table
+  bool has_symbol(const std::string& name) const {
+    return find_symbol(name) != nullptr;
+  }
+
+  //! Parse the given member with the format-specific parser
+  //! (ELF, PE, Mach-O) or return a nullptr if the member is not supported
+  //! (e.g. COFF objects).
+  //!
+  //! The member is read through a stream over the archive's data so it is
+  //! not extracted, but the returned binary owns a copy of the content
+  //! (as for any LIEF::Parser::parse) and does not depend on the archive.
+  //!
+  //! Since each member has its own stream, members can be parsed
+  //! concurrently from different threads.
+  std::unique_ptr<Binary> parse(const Member& member) const;
+
+  //! Parse all the members of the archive that are supported by LIEF from
+  //! at most ``nb_threads`` threads (0: number of hardware threads).
+  //! The binaries are returned in the order of the members.
+  std::vector<std::unique_ptr<Binary>> parse(uint32_t nb_threads = 0) const;
+
+  //! Raw data of the archive
+  const std::vector<uint8_t>& raw() const {
+    return data_;
+  }
+
+  LIEF_API friend std::ostream& operator<<(std::ostream& os, const Archive& ar);
+
+  ~Archive();
+
+  private:
+  Archive();
+
+  KIND kind_ = KIND::UNKNOWN;
+  std::vector<uint8_t> data_;
+  members_t members_;
+  symbols_t symbols_;
+};
+
+LIEF_API const char* to_string(Archive::KIND e);
+
+}
+}
+#endif
@@ -0,0 +1,114 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_AR_MEMBER_H
+#define LIEF_AR_MEMBER_H
+#include <ostream>
+#include <string>
+#include <memory>
+
+#include "LIEF/visibility.h"
+#include "LIEF/span.hpp"
+#include "LIEF/Abstract/Binary.hpp"
+
+namespace LIEF {
+class SpanStream;
+namespace AR {
+class Parser;
+
+//! This class represents a member (i.e. an embedded file) of a static archive.
+//!
+//! The content of the member is **not** copied: it references the
+//! data owned by the LIEF::AR::Archive that contains this member.
+class LIEF_API Member {
+  friend class Parser;
+
+  public:
+  Member() = default;
+  Member(const Member&) = delete;
+  Member& operator=(const Member&) = delete;
+
+  //! Name of the member (resolved from the GNU/BSD long name tables)
+  const std::string& name() const {
+    return name_;
+  }
+
+  //! Modification timestamp
+  uint64_t date() const {
+    return date_;
+  }
+
+  //! User ID
+  uint32_t uid() const {
+    return uid_;
+  }
+
+  //! Group ID
+  uint32_t gid() const {
+    return gid_;
+  }
+
+  //! File mode (octal value as written in the header)
+  uint32_t mode() const {
+    return mode_;
+  }
+
+  //! Offset of the member's header in the archive
+  uint64_t offset() const {
+    return offset_;
+  }
+
+  //! Offset of the member's content in the archive
+  uint64_t data_offset() const {
+    return data_offset_;
+  }
+
+  //! Size of the member's content
+  uint64_t size() const {
+    return content_.size();
+  }
+
+  //! Raw content of the member (without the BSD long name, if any)
+  span<const uint8_t> content() const {
+    return content_;
+  }
+
+  //! Executable format of the member (ELF, PE, Mach-O) inferred from its
+  //! magic or LIEF::Binary::FORMATS::UNKNOWN for other kind of members
+  //! (e.g. COFF objects).
+  Binary::FORMATS format() const;
+
+  //! Stream that is bound to the content of the member. It does not copy
+  //! the data.
+  std::unique_ptr<SpanStream> stream() const;
+
+  LIEF_API friend std::ostream& operator<<(std::ostream& os, const Member& member);
+
+  ~Member();
+
+  private:
+  std::string name_;
+  uint64_t date_ = 0;
+  uint32_t uid_ = 0;
+  uint32_t gid_ = 0;
+  uint32_t mode_ = 0;
+  uint64_t offset_ = 0;
+  uint64_t data_offset_ = 0;
+  span<const uint8_t> content_;
+};
+
+}
+}
+#endif
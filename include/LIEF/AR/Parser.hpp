@@ -0,0 +1,72 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_AR_PARSER_H
+#define LIEF_AR_PARSER_H
+#include <string>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+#include "LIEF/visibility.h"
+#include "LIEF/errors.hpp"
+
+namespace LIEF {
+class SpanStream;
+namespace AR {
+class Archive;
+class Member;
+
+//! Class that parses a static archive (``ar`` format) into a
+//! LIEF::AR::Archive.
+//!
+//! The parser only indexes the members and the symbol table: the members
+//! themselves are parsed on demand through LIEF::AR::Archive::parse.
+class LIEF_API Parser {
+  public:
+  static std::unique_ptr<Archive> parse(const std::string& file);
+  static std::unique_ptr<Archive> parse(std::vector<uint8_t> data);
+
+  Parser& operator=(const Parser& copy) = delete;
+  Parser(const Parser& copy)            = delete;
+
+  private:
+  Parser(std::unique_ptr<Archive> archive);
+  ~Parser();
+
+  ok_error_t parse_members();
+  ok_error_t parse_sysv_symtab(const Member& member, bool is64);
+  ok_error_t parse_coff_symtab(const Member& member);
+  ok_error_t parse_bsd_symtab(const Member& member, bool is64);
+
+  ok_error_t resolve_name(Member& member, const std::string& raw_name);
+
+  void add_symbol(std::string name, uint64_t hdr_offset);
+
+  std::unique_ptr<Archive> archive_;
+  std::unique_ptr<SpanStream> stream_;
+
+  // Long name table (GNU/COFF ``//`` member)
+  const Member* long_names_ = nullptr;
+
+  // Raw symbols (name, header offset) resolved once all the
+  // members are indexed
+  std::vector<std::pair<std::string, uint64_t>> symbols_;
+  std::unordered_map<uint64_t, const Member*> members_offset_;
+};
+
+}
+}
+#endif
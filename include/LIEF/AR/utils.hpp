@@ -0,0 +1,39 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_AR_UTILS_H
+#define LIEF_AR_UTILS_H
+#include <string>
+#include <vector>
+
+#include "LIEF/visibility.h"
+#include "LIEF/types.hpp"
+
+namespace LIEF {
+class BinaryStream;
+namespace AR {
+
+//! Check if the given stream wraps a static archive (``!<arch>``)
+LIEF_API bool is_archive(BinaryStream& stream);
+
+//! Check if the given file is a static archive
+LIEF_API bool is_archive(const std::string& file);
+
+//! Check if the given raw data is a static archive
+LIEF_API bool is_archive(const std::vector<uint8_t>& raw);
+
+}
+}
+#endif
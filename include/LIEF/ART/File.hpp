@@ -15,6 +15,7 @@
  */
 #ifndef LIEF_ART_FILE_H
 #define LIEF_ART_FILE_H
+#include <memory>
 #include <ostream>
 
 #include "LIEF/ART/Header.hpp"
@@ -25,6 +26,7 @@
 namespace LIEF {
 namespace ART {
 class Parser;
+class ImageReader;
 
 class LIEF_API File : public Object {
   friend class Parser;
@@ -36,6 +38,12 @@ class LIEF_API File : public Object {
   const Header& header() const;
   Header& header();
 
+  //! Lazy reader over the image sections (objects, ArtMethods, ...).
+  //! It returns a nullptr if the sections can't be read.
+  const ImageReader* image() const {
+    return image_.get();
+  }
+
   void accept(Visitor& visitor) const override;
 
 
@@ -47,6 +55,7 @@ class LIEF_API File : public Object {
   File();
 
   Header header_;
+  std::unique_ptr<ImageReader> image_;
 };
 
 }
@@ -0,0 +1,294 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ART_IMAGE_READER_H
+#define LIEF_ART_IMAGE_READER_H
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "LIEF/errors.hpp"
+#include "LIEF/iterators.hpp"
+#include "LIEF/visibility.h"
+
+namespace LIEF {
+class BinaryStream;
+namespace ART {
+class Parser;
+
+namespace details {
+struct image_layout_t;
+}
+
+//! Lazy reader over the sections of an ART image (objects, ArtFields,
+//! ArtMethods, DexCache, interned strings, class table).
+//!
+//! Nothing is decoded when the image is parsed. The data are read from the
+//! underlying stream when they are queried and the LZ4 compressed images
+//! are decompressed (block by block) on the first access to their content.
+//!
+//! The addresses used by this API are the virtual addresses of the image
+//! (i.e. based on Header::image_begin).
+class LIEF_API ImageReader {
+  friend class Parser;
+  public:
+  //! Version-independent identifier of the image sections
+  enum class SECTION : uint32_t {
+    UNKNOWN = 0,
+    OBJECTS,
+    ART_FIELDS,
+    ART_METHODS,
+    RUNTIME_METHODS,
+    IM_TABLES,
+    IMT_CONFLICT_TABLES,
+    DEX_CACHE_ARRAYS,
+    INTERNED_STRINGS,
+    CLASS_TABLE,
+    IMAGE_BITMAP,
+  };
+
+  struct LIEF_API section_t {
+    SECTION type = SECTION::UNKNOWN;
+
+    //! Offset of the section in the image. For the image bitmap, this is
+    //! an offset in the file.
+    uint32_t offset = 0;
+    uint32_t size = 0;
+  };
+
+  enum class OBJECT_KIND : uint32_t {
+    INSTANCE = 0,
+    CLASS,
+    ARRAY,
+    STRING,
+  };
+
+  //! Object of the managed heap (``mirror::Object``)
+  struct LIEF_API object_t {
+    uint64_t address = 0;
+
+    //! Address of the class (``java.lang.Class``) of this object
+    uint64_t klass = 0;
+
+    //! Size of the object (not aligned)
+    uint32_t size = 0;
+
+    OBJECT_KIND kind = OBJECT_KIND::INSTANCE;
+
+    //! Number of elements for an array or number of characters for a string
+    uint32_t length = 0;
+  };
+
+  //! Native ``ArtField``
+  struct LIEF_API art_field_t {
+    uint64_t address = 0;
+    uint64_t declaring_class = 0;
+    uint32_t access_flags = 0;
+    uint32_t dex_field_index = 0;
+    uint32_t offset = 0;
+  };
+
+  //! Native ``ArtMethod``
+  struct LIEF_API art_method_t {
+    uint64_t address = 0;
+    uint64_t declaring_class = 0;
+    uint32_t access_flags = 0;
+    uint32_t dex_code_item_offset = 0;
+    uint32_t dex_method_index = 0;
+    uint32_t method_index = 0;
+
+    //! Quick (compiled) code entry point
+    uint64_t entry_point = 0;
+  };
+
+  //! ``java.lang.DexCache`` object
+  struct LIEF_API dex_cache_t {
+    uint64_t address = 0;
+    std::string location;
+
+    uint64_t strings = 0;
+    uint32_t nb_strings = 0;
+
+    uint64_t resolved_types = 0;
+    uint32_t nb_resolved_types = 0;
+
+    uint64_t resolved_methods = 0;
+    uint32_t nb_resolved_methods = 0;
+
+    uint64_t resolved_fields = 0;
+    uint32_t nb_resolved_fields = 0;
+  };
+
+  //! Forward iterator over the objects of the image. The objects are
+  //! decoded one at a time.
+  class LIEF_API ObjectIterator {
+    public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = object_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const object_t*;
+    using reference = const object_t&;
+
+    ObjectIterator() = default;
+    ObjectIterator(const ImageReader& reader, object_t obj) :
+      reader_(&reader), obj_(obj)
+    {}
+
+    ObjectIterator& operator++();
+
+    ObjectIterator operator++(int) {
+      ObjectIterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    reference operator*() const {
+      return obj_;
+    }
+
+    pointer operator->() const {
+      return &obj_;
+    }
+
+    friend bool operator==(const ObjectIterator& LHS, const ObjectIterator& RHS) {
+      return LHS.reader_ == RHS.reader_ && LHS.obj_.address == RHS.obj_.address;
+    }
+
+    friend bool operator!=(const ObjectIterator& LHS, const ObjectIterator& RHS) {
+      return !(LHS == RHS);
+    }
+
+    private:
+    const ImageReader* reader_ = nullptr;
+    object_t obj_;
+  };
+
+  using objects_it = iterator_range<ObjectIterator>;
+
+  ImageReader(const ImageReader&) = delete;
+  ImageReader& operator=(const ImageReader&) = delete;
+
+  ~ImageReader();
+
+  //! Base address of the image
+  uint64_t image_begin() const;
+
+  //! Size of the image (as mapped in memory)
+  uint32_t image_size() const;
+
+  //! Size of a native pointer (4 or 8)
+  uint32_t pointer_size() const;
+
+  const std::vector<section_t>& sections() const;
+
+  //! Return the section with the given type or a nullptr
+  const section_t* get(SECTION type) const;
+
+  //! Whether the given address is located in the image
+  bool contains(uint64_t address) const {
+    return image_begin() <= address && address < image_begin() + image_size();
+  }
+
+  //! Read ``size`` bytes at the given address
+  result<std::vector<uint8_t>> read(uint64_t address, size_t size) const;
+
+  //! Iterator over the objects of the ``OBJECTS`` section
+  objects_it objects() const;
+
+  //! Decode the object that starts at the given address
+  result<object_t> object(uint64_t address) const;
+
+  //! Return the object that **contains** the given address
+  result<object_t> find_object(uint64_t address) const;
+
+  //! Object that follows the given one (an error if it is the last one)
+  result<object_t> next(const object_t& obj) const;
+
+  //! Decode the ``java.lang.String`` at the given address
+  result<std::string> string(uint64_t address) const;
+
+  //! Name of the ``java.lang.Class`` at the given address
+  result<std::string> class_name(uint64_t address) const;
+
+  //! Classes referenced by the ``CLASS_ROOTS`` image root
+  //! (``java.lang.Class``, ``java.lang.Object``, ...)
+  std::vector<uint64_t> class_roots() const;
+
+  //! ``java.lang.DexCache`` objects referenced by the ``DEX_CACHES`` image root
+  std::vector<dex_cache_t> dex_caches() const;
+
+  //! ``ArtField`` of the ``ART_FIELDS`` section
+  std::vector<art_field_t> art_fields() const;
+
+  //! ``ArtMethod`` of the ``ART_METHODS`` and ``RUNTIME_METHODS`` sections
+  std::vector<art_method_t> art_methods() const;
+
+  //! Decode the ``ArtField`` at the given address
+  result<art_field_t> art_field(uint64_t address) const;
+
+  //! Decode the ``ArtMethod`` at the given address
+  result<art_method_t> art_method(uint64_t address) const;
+
+  //! Addresses of the strings registered in the intern table
+  std::vector<uint64_t> interned_strings() const;
+
+  //! Addresses of the classes registered in the class table
+  std::vector<uint64_t> class_table() const;
+
+  //! Number of compressed blocks that have been decompressed so far
+  size_t nb_decoded_blocks() const;
+
+  private:
+  ImageReader(std::unique_ptr<BinaryStream> stream,
+              std::unique_ptr<details::image_layout_t> layout);
+
+  ok_error_t read_at(uint64_t offset, void* dst, size_t size) const;
+
+  template<class T>
+  result<T> read_at(uint64_t offset) const {
+    T value{};
+    if (auto is_ok = read_at(offset, &value, sizeof(T)); !is_ok) {
+      return make_error_code(get_error(is_ok));
+    }
+    return value;
+  }
+
+  const std::vector<uint8_t>* block(size_t idx) const;
+  result<uint32_t> read_u32(uint64_t address) const;
+  bool has_bitmap() const;
+  result<uint8_t> bitmap_byte(uint64_t index) const;
+  result<object_t> first_object() const;
+  uint64_t string_class() const;
+  std::vector<uint64_t> hash_set(SECTION type) const;
+  std::vector<uint64_t> array_refs(uint64_t address) const;
+
+  std::unique_ptr<BinaryStream> stream_;
+  std::unique_ptr<details::image_layout_t> layout_;
+
+  mutable std::vector<std::unique_ptr<std::vector<uint8_t>>> blocks_;
+  mutable std::vector<uint8_t> buffer_;
+  mutable std::vector<uint8_t> bitmap_window_;
+  mutable uint64_t bitmap_window_offset_ = 0;
+  mutable std::vector<uint32_t> object_index_;
+  mutable uint64_t string_class_ = 0;
+};
+
+LIEF_API const char* to_string(ImageReader::SECTION e);
+LIEF_API const char* to_string(ImageReader::OBJECT_KIND e);
+
+}
+}
+#endif
@@ -51,53 +51,9 @@ class LIEF_API Parser {
   template<typename ART_T>
   size_t parse_header();
 
-  template<typename ART_T, typename PTR_T>
+  template<typename ART_T>
   void parse_sections();
 
-  template<typename ART_T, typename PTR_T>
-  void parse_roots();
-
-  template<typename ART_T, typename PTR_T>
-  void parse_methods();
-
-  // Section parsing
-  template<typename ART_T, typename PTR_T>
-  void parse_objects(size_t offset, size_t size);
-
-  template<typename ART_T, typename PTR_T>
-  void parse_art_fields(size_t offset, size_t size);
-
-  template<typename ART_T, typename PTR_T>
-  void parse_art_methods(size_t offset, size_t size);
-
-  template<typename ART_T, typename PTR_T>
-  void parse_interned_strings(size_t offset, size_t size);
-
-  // Parse an **Array** of java.lang.DexCache objects
-  template<typename ART_T, typename PTR_T>
-  void parse_dex_caches(size_t offset, size_t size);
-
-  // Parse a **Single** java.lang.DexCache object
-  template<typename ART_T, typename PTR_T>
-  void parse_dex_cache(size_t object_offset);
-
-  // Parse an **Array** of java.lang.Class objects
-  template<typename ART_T, typename PTR_T>
-  void parse_class_roots(size_t offset, size_t size);
-
-  // Parse java.lang.Class objects
-  template<typename ART_T, typename PTR_T>
-  void parse_class(size_t offset);
-
-  // Parse java.lang.String objects
-  template<typename ART_T, typename PTR_T>
-  void parse_jstring(size_t offset);
-
-
-  //// Parse a **Single** java.lang.DexCache object
-  //template<typename ART_T, typename PTR_T>
-  //void parse_class_roots(size_t object_offset);
-
   std::unique_ptr<File> file_;
   std::unique_ptr<BinaryStream> stream_;
   uint32_t imagebase_ = 0;
@@ -20,9 +20,12 @@
 #include <LIEF/Abstract/enums.hpp>
 #include <LIEF/Abstract/EnumToString.hpp>
 #include <LIEF/Abstract/Parser.hpp>
+#include <LIEF/Abstract/ParserBudget.hpp>
 #include <LIEF/Abstract/Relocation.hpp>
 #include <LIEF/Abstract/Function.hpp>
+#include <LIEF/Abstract/GoPclntab.hpp>
 #include <LIEF/Abstract/Symbol.hpp>
+#include <LIEF/Abstract/Symbolizer.hpp>
 #include <LIEF/Abstract/Section.hpp>
 
 #endif
@@ -27,12 +27,14 @@
 
 #include "LIEF/Abstract/Header.hpp"
 #include "LIEF/Abstract/Function.hpp"
+#include "LIEF/Abstract/ParserBudget.hpp"
 
 //! LIEF namespace
 namespace LIEF {
 class Section;
 class Relocation;
 class Symbol;
+class Symbolizer;
 
 class DebugInfo;
 
@@ -136,6 +138,17 @@ class LIEF_API Binary : public Object {
     return original_size_;
   }
 
+  //! Reason why the parsing of this binary stopped before completion
+  //! (c.f. ParserBudget)
+  ParserBudget::TRUNCATION truncation() const {
+    return truncation_;
+  }
+
+  //! Whether the binary is only partially parsed because of the ParserBudget
+  bool is_truncated() const {
+    return truncation_ != ParserBudget::TRUNCATION::NONE;
+  }
+
   //! Return the functions exported by the binary
   functions_t exported_functions() const;
 
@@ -148,6 +161,13 @@ class LIEF_API Binary : public Object {
   //! Return the address of the given function name
   virtual result<uint64_t> get_function_address(const std::string& func_name) const;
 
+  //! Build a Symbolizer that resolves virtual addresses into the name of
+  //! the symbol or the function that contains them.
+  //!
+  //! The table merges the symbols with the functions discovered from
+  //! format-specific sources (exports, unwinding information, ...).
+  virtual std::unique_ptr<Symbolizer> symbolizer() const;
+
   //! Method so that a ``visitor`` can visit us
   void accept(Visitor& visitor) const override;
 
@@ -247,6 +267,7 @@ class LIEF_API Binary : public Object {
   FORMATS format_ = FORMATS::UNKNOWN;
   mutable std::unique_ptr<DebugInfo> debug_info_;
   uint64_t original_size_ = 0;
+  ParserBudget::TRUNCATION truncation_ = ParserBudget::TRUNCATION::NONE;
 
   // These functions need to be overloaded by the object that claims to extend this Abstract Binary
   virtual Header get_abstract_header() const = 0;
@@ -0,0 +1,195 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ABSTRACT_GO_PCLNTAB_H
+#define LIEF_ABSTRACT_GO_PCLNTAB_H
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LIEF/errors.hpp"
+#include "LIEF/span.hpp"
+#include "LIEF/visibility.h"
+
+namespace LIEF {
+class Binary;
+class Function;
+
+//! This class decodes the function table (``runtime.pclntab``) that the Go
+//! toolchain embeds in the ELF, PE and Mach-O binaries it produces.
+//!
+//! The table is still present in stripped binaries and provides the
+//! boundaries, the names and the source locations of all the Go functions.
+//! The layouts of Go 1.2 up to the latest releases are supported.
+//!
+//! The entries are decoded lazily from the raw table which is not copied:
+//! the binary (or the buffer) from which this object is created must
+//! outlive it.
+//!
+//! @warning Before Go 1.18, the entries of a position-independent binary are
+//! absolute addresses relocated at load time and are thus not available in
+//! the file.
+class LIEF_API GoPclntab {
+  public:
+  //! Value returned by lookup() when the address is not covered by
+  //! any function
+  static constexpr uint32_t NOT_FOUND = uint32_t(-1);
+
+  enum class VERSION : uint32_t {
+    UNKNOWN = 0,
+    GO_1_2,  ///< Go 1.2 to Go 1.15 (magic: ``0xfffffffb``)
+    GO_1_16, ///< Go 1.16 and Go 1.17 (magic: ``0xfffffffa``)
+    GO_1_18, ///< Go 1.18 and Go 1.19 (magic: ``0xfffffff0``)
+    GO_1_20, ///< Go 1.20 and above (magic: ``0xfffffff1``)
+  };
+
+  //! Source location of an address
+  struct LIEF_API location_t {
+    std::string file;
+    int32_t line = 0;
+  };
+
+  //! Fields of the runtime's ``moduledata`` structure that references
+  //! the table
+  struct LIEF_API moduledata_t {
+    //! Virtual address of the structure
+    uint64_t address = 0;
+
+    //! Lowest and highest (excluded) program counters covered by the table
+    uint64_t minpc = 0;
+    uint64_t maxpc = 0;
+
+    //! Bounds of the text segment
+    uint64_t text = 0;
+    uint64_t etext = 0;
+  };
+
+  //! Decode the table from its raw content
+  //!
+  //! @param[in] raw         Content of the table, starting with its header
+  //! @param[in] address     Virtual address of the table
+  //! @param[in] text_start  Start address of the text. It is only used by
+  //!                        Go 1.18+ when the table's field is not relocated.
+  static result<GoPclntab> parse(span<const uint8_t> raw, uint64_t address = 0,
+                                 uint64_t text_start = 0);
+
+  //! Locate and decode the table of the given binary.
+  //!
+  //! The table is looked up with the name of its section (``.gopclntab``,
+  //! ``__gopclntab``) and, for the binaries built by Go, with a scan of the
+  //! sections for the header of the table.
+  static result<GoPclntab> from_binary(const Binary& bin);
+
+  //! Offset of the first valid table header in the given buffer
+  static result<size_t> find(span<const uint8_t> data);
+
+  //! Whether the given binary has been produced by the Go toolchain
+  static bool is_go(const Binary& bin);
+
+  GoPclntab(const GoPclntab&) = default;
+  GoPclntab& operator=(const GoPclntab&) = default;
+
+  GoPclntab(GoPclntab&&) noexcept = default;
+  GoPclntab& operator=(GoPclntab&&) noexcept = default;
+
+  ~GoPclntab() = default;
+
+  VERSION version() const {
+    return version_;
+  }
+
+  //! Virtual address of the table
+  uint64_t address() const {
+    return address_;
+  }
+
+  //! Instruction size quantum (1 on x86, 4 on ARM, ...)
+  uint8_t quantum() const {
+    return quantum_;
+  }
+
+  //! Size of a pointer (4 or 8)
+  uint8_t pointer_size() const {
+    return ptr_size_;
+  }
+
+  bool is_big_endian() const {
+    return big_endian_;
+  }
+
+  //! Base address of the function offsets (Go 1.18+)
+  uint64_t text_start() const {
+    return text_start_;
+  }
+
+  //! Number of functions in the table
+  size_t size() const {
+    return nb_func_;
+  }
+
+  //! Entry address of the function at the given index
+  uint64_t entry(uint32_t idx) const;
+
+  //! End address (excluded) of the function at the given index
+  uint64_t end(uint32_t idx) const;
+
+  //! Name of the function at the given index
+  std::string name(uint32_t idx) const;
+
+  //! Index of the function that contains the given address or
+  //! GoPclntab::NOT_FOUND
+  uint32_t lookup(uint64_t address) const;
+
+  //! Source file and line of the given address
+  result<location_t> location(uint64_t address) const;
+
+  //! Return all the functions of the table
+  std::vector<Function> functions() const;
+
+  //! Find the ``moduledata`` structure that references this table in the
+  //! data of the given binary
+  result<moduledata_t> moduledata(const Binary& bin) const;
+
+  private:
+  GoPclntab() = default;
+
+  uint32_t read_u32(uint64_t offset) const;
+  uint64_t read_ptr(uint64_t offset) const;
+  uint64_t read_field(uint64_t offset) const;
+  uint64_t func_offset(uint32_t idx) const;
+  std::string read_str(uint64_t offset) const;
+  int32_t pcvalue(uint64_t offset, uint64_t entry, uint64_t target) const;
+
+  span<const uint8_t> raw_;
+  VERSION version_ = VERSION::UNKNOWN;
+  uint64_t address_ = 0;
+  uint64_t text_start_ = 0;
+  uint8_t quantum_ = 1;
+  uint8_t ptr_size_ = 8;
+  bool big_endian_ = false;
+  uint32_t nb_func_ = 0;
+
+  uint64_t funcnametab_ = 0;
+  uint64_t cutab_ = 0;
+  uint64_t filetab_ = 0;
+  uint64_t pctab_ = 0;
+  uint64_t functab_ = 0;
+  uint32_t nb_files_ = 0;
+};
+
+LIEF_API const char* to_string(GoPclntab::VERSION e);
+
+}
+#endif
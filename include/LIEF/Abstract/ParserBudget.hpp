@@ -0,0 +1,92 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ABSTRACT_PARSER_BUDGET_H
+#define LIEF_ABSTRACT_PARSER_BUDGET_H
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "LIEF/visibility.h"
+
+namespace LIEF {
+
+//! This structure defines the resources that a parser (ELF, PE, Mach-O) can
+//! consume. It is embedded in the ``ParserConfig`` of these formats.
+//!
+//! When a budget is exhausted (or the parsing is cancelled), the parser stops
+//! at the next check point and returns the objects parsed so far. The reason
+//! is reported by LIEF::Binary::truncation().
+struct LIEF_API ParserBudget {
+  //! Reason why the parsing has been stopped before completion
+  enum class TRUNCATION {
+    NONE = 0,  ///< The binary has been fully parsed
+    CANCELLED, ///< The parsing has been cancelled with the CancellationToken
+    TIME,      ///< ParserBudget::max_time has been reached
+    MEMORY,    ///< ParserBudget::max_memory has been reached
+    OBJECTS,   ///< A table has more entries than ParserBudget::max_objects
+  };
+
+  //! Token that can be shared with another thread to stop a parsing
+  //! in progress
+  class LIEF_API CancellationToken {
+    public:
+    CancellationToken() :
+      flag_(std::make_shared<std::atomic<bool>>(false))
+    {}
+
+    void cancel() {
+      flag_->store(true, std::memory_order_relaxed);
+    }
+
+    void reset() {
+      flag_->store(false, std::memory_order_relaxed);
+    }
+
+    bool is_cancelled() const {
+      return flag_->load(std::memory_order_relaxed);
+    }
+
+    private:
+    std::shared_ptr<std::atomic<bool>> flag_;
+  };
+
+  //! Callback triggered at the beginning of each parsing stage with the name
+  //! of the stage and the progress in the range ``[0, 1]``
+  using progress_callback_t = std::function<void(const std::string& stage, float progress)>;
+
+  //! Maximum amount of memory (in bytes) that can be used by the parsed
+  //! objects. 0 means unlimited.
+  uint64_t max_memory = 0;
+
+  //! Maximum duration (in milliseconds) of the parsing. 0 means unlimited.
+  uint64_t max_time = 0;
+
+  //! Maximum number of entries processed for a table (symbols, relocations,
+  //! load commands, ...). It can't exceed the format's default limits which
+  //! apply when it is 0.
+  uint64_t max_objects = 0;
+
+  CancellationToken cancellation;
+
+  progress_callback_t progress;
+};
+
+LIEF_API const char* to_string(ParserBudget::TRUNCATION e);
+
+}
+#endif
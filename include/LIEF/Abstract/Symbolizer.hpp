@@ -0,0 +1,129 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ABSTRACT_SYMBOLIZER_H
+#define LIEF_ABSTRACT_SYMBOLIZER_H
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "LIEF/visibility.h"
+
+namespace LIEF {
+
+//! This class maps virtual addresses back to the name of the symbol
+//! (or function) that contains them.
+//!
+//! It is built once from the different sources of a binary
+//! (c.f. LIEF::Binary::symbolizer()) and stores a sorted table of
+//! non-overlapping ranges on which the lookups are performed with a
+//! branchless binary search.
+//!
+//! @warning The table is a snapshot of the binary: it must be re-built
+//! if the symbols of the binary are modified.
+class LIEF_API Symbolizer {
+  public:
+  //! Value returned by the lookup functions when the address
+  //! is not covered by any range
+  static constexpr uint32_t NOT_FOUND = uint32_t(-1);
+
+  Symbolizer() = default;
+
+  Symbolizer(const Symbolizer&) = default;
+  Symbolizer& operator=(const Symbolizer&) = default;
+
+  Symbolizer(Symbolizer&&) noexcept = default;
+  Symbolizer& operator=(Symbolizer&&) noexcept = default;
+
+  ~Symbolizer() = default;
+
+  //! Register the range ``[start, start + size)`` associated with the
+  //! given name.
+  //!
+  //! If @p size is 0, the range extends up to the next registered address.
+  //! An empty name can be used to register a function boundary for which
+  //! the name is unknown (e.g. from the unwinding information).
+  void add(uint64_t start, uint64_t size, const std::string& name);
+
+  //! Sort and merge the registered ranges. This function must be called
+  //! before the lookups.
+  //!
+  //! @param[in] end  Upper bound (excluded) of the last range when its size
+  //!                 is unknown (e.g. the end of the binary's image).
+  void finalize(uint64_t end = 0);
+
+  //! Number of ranges in the table
+  size_t size() const {
+    return starts_.size();
+  }
+
+  bool empty() const {
+    return starts_.empty();
+  }
+
+  //! Start address of the range at the given index
+  uint64_t start(uint32_t idx) const {
+    return starts_[idx];
+  }
+
+  //! End address (excluded) of the range at the given index
+  uint64_t end(uint32_t idx) const {
+    return ends_[idx];
+  }
+
+  //! Name of the range at the given index. It can be empty for
+  //! the ranges that come from function boundaries.
+  const std::string& name(uint32_t idx) const {
+    return names_[names_idx_[idx]];
+  }
+
+  //! Return the index of the range that contains the given address
+  //! or Symbolizer::NOT_FOUND
+  uint32_t lookup(uint64_t address) const;
+
+  //! Batch version of lookup(): the index of the range for @p addresses[i]
+  //! is written in @p indexes[i].
+  //!
+  //! The searches are interleaved so that the memory accesses of
+  //! independent lookups overlap.
+  void lookup(const uint64_t* addresses, size_t count, uint32_t* indexes) const;
+
+  std::vector<uint32_t> lookup(const std::vector<uint64_t>& addresses) const;
+
+  //! Return the name of the symbol that contains the given address or
+  //! a nullptr if the address can't be resolved
+  const std::string* symbolize(uint64_t address) const;
+
+  private:
+  struct entry_t {
+    uint64_t start = 0;
+    uint64_t size = 0;
+    uint32_t name = 0;
+  };
+
+  uint32_t name_idx(const std::string& name);
+
+  std::vector<entry_t> entries_;
+  std::unordered_map<std::string, uint32_t> names_map_;
+
+  std::vector<uint64_t> starts_;
+  std::vector<uint64_t> ends_;
+  std::vector<uint32_t> names_idx_;
+  std::vector<std::string> names_ = {""};
+};
+
+}
+#endif
@@ -41,6 +41,8 @@ class BinaryStream {
     MEMORY,
     SPAN,
     FILE,
+    COMPRESSED,
+    FORWARD,
 
     ELF_DATA_HANDLER,
   };
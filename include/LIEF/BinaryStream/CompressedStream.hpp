@@ -0,0 +1,163 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_COMPRESSED_STREAM_H
+#define LIEF_COMPRESSED_STREAM_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "LIEF/errors.hpp"
+#include "LIEF/visibility.h"
+#include "LIEF/BinaryStream/BinaryStream.hpp"
+
+namespace LIEF {
+
+//! Stream interface over compressed data (e.g. a ``.gz`` file).
+//!
+//! When the stream is created, the data are decompressed once to build an
+//! index of *seek points*. Then, a read at a random offset only decompresses
+//! the chunk(s) between two seek points that cover the requested range.
+//! The decompressed chunks are kept in a bounded LRU cache.
+//!
+//! The ELF parser needs the whole image in memory (the sections and the
+//! segments reference the content of the file): it loads it once with
+//! content(). The other parsers only access the chunks they read.
+//!
+//! This stream can be used with LIEF::Parser::parse() and the format-specific
+//! parsers that take a std::unique_ptr<BinaryStream>.
+//!
+//! The decompressed size is bounded (see: config_t::max_size and
+//! config_t::max_ratio) and the integrity trailers (gzip CRC-32/ISIZE,
+//! zlib Adler-32) are verified while building the index.
+class LIEF_API CompressedStream : public BinaryStream {
+  public:
+  enum class FORMAT {
+    UNKNOWN = 0,
+    GZIP,
+    ZLIB,
+    ZSTD,
+    XZ,
+  };
+
+  struct config_t {
+    //! Distance (in decompressed bytes) between two seek points. A smaller
+    //! value speeds up the random accesses at the cost of 32KB per seek point.
+    uint64_t index_span = 1llu << 20;
+
+    //! Maximum number of decompressed chunks kept in memory
+    size_t cache_size = 8;
+
+    //! Maximum size of the decompressed data (0: no limit)
+    uint64_t max_size = 1llu << 32;
+
+    //! Maximum ratio between the decompressed and the compressed sizes
+    //! (0: no limit). It only applies beyond the first MiB of output.
+    uint64_t max_ratio = 100;
+
+    //! Whether raw zlib streams are accepted. Their 2-byte header is weak
+    //! (one in ~1000 random inputs matches), so they are opt-in.
+    bool zlib = false;
+
+    //! Verify the trailers (CRC-32 and size for gzip, Adler-32 for zlib)
+    bool check_integrity = true;
+  };
+
+  //! Identify the compression format from the magic of the given stream.
+  //! FORMAT::ZLIB is only reported if ``zlib`` is true.
+  static FORMAT detect(BinaryStream& stream, bool zlib = false);
+
+  static result<CompressedStream> from_file(const std::string& file,
+                                            const config_t& config);
+
+  static result<CompressedStream> from_file(const std::string& file) {
+    return from_file(file, config_t());
+  }
+
+  static result<CompressedStream> from_stream(std::unique_ptr<BinaryStream> stream,
+                                              const config_t& config);
+
+  static result<CompressedStream> from_stream(std::unique_ptr<BinaryStream> stream) {
+    return from_stream(std::move(stream), config_t());
+  }
+
+  CompressedStream() = delete;
+
+  CompressedStream(const CompressedStream&) = delete;
+  CompressedStream& operator=(const CompressedStream&) = delete;
+
+  CompressedStream(CompressedStream&& other) noexcept;
+  CompressedStream& operator=(CompressedStream&& other) noexcept;
+
+  ~CompressedStream() override;
+
+  //! Size of the **decompressed** data
+  uint64_t size() const override {
+    return size_;
+  }
+
+  FORMAT format() const {
+    return format_;
+  }
+
+  //! Number of seek points in the index
+  size_t nb_seek_points() const;
+
+  //! Whole decompressed content. The stream is decoded sequentially, without
+  //! going through the cache of chunks, but the returned buffer holds the
+  //! whole decompressed data.
+  std::vector<uint8_t> content() const;
+
+  static bool classof(const BinaryStream& stream) {
+    return stream.type() == STREAM_TYPE::COMPRESSED;
+  }
+
+  ok_error_t peek_in(void* dst, uint64_t offset, uint64_t size,
+                     uint64_t virtual_address = 0) const override;
+
+  //! Number of read_at() calls during which a returned pointer stays valid
+  static constexpr size_t READ_AT_LEASES = 16;
+
+  //! Return a pointer to the decompressed data at the given offset.
+  //!
+  //! The pointer remains valid for the next READ_AT_LEASES calls to this
+  //! function (e.g. through read_array()): the chunk that holds the data is
+  //! kept alive even if it is evicted from the LRU cache, and the ranges that
+  //! span several chunks are copied in a buffer owned by the stream. Hence,
+  //! the memory used by the stream stays bounded.
+  result<const void*> read_at(uint64_t offset, uint64_t size,
+                              uint64_t virtual_address = 0) const override;
+
+  private:
+  struct index_t;
+  using data_t = std::shared_ptr<const std::vector<uint8_t>>;
+  CompressedStream(std::unique_ptr<BinaryStream> raw, FORMAT fmt);
+
+  //! Decompressed data located between the seek point at the given
+  //! index and the next one
+  data_t chunk(size_t idx) const;
+
+  std::unique_ptr<BinaryStream> raw_;
+  std::unique_ptr<index_t> index_;
+  FORMAT format_ = FORMAT::UNKNOWN;
+  uint64_t size_ = 0;
+};
+
+LIEF_API const char* to_string(CompressedStream::FORMAT e);
+
+}
+
+#endif
@@ -0,0 +1,148 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_FORWARD_STREAM_H
+#define LIEF_FORWARD_STREAM_H
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <vector>
+
+#include "LIEF/errors.hpp"
+#include "LIEF/span.hpp"
+#include "LIEF/visibility.h"
+#include "LIEF/BinaryStream/BinaryStream.hpp"
+
+namespace LIEF {
+
+//! Stream interface over a source that can only be read forward
+//! (pipe, socket, decompressor output, ...).
+//!
+//! The data are pulled from the source *on demand*: a read at a given offset
+//! only consumes the source up to the end of the requested range. The bytes
+//! that have been consumed are kept so that the parsers can revisit them.
+//!
+//! When the size of the input is known beforehand (e.g. transmitted by the
+//! protocol), the bytes located after the last range requested by the parser
+//! are never buffered and can be forwarded with drain(). The data that follow
+//! the input in the source are never consumed.
+//! Otherwise, the first call to size() consumes the whole source.
+//!
+//! @warning The ELF parser is not streamed: the sections and the segments
+//!          reference the content of the file, so it buffers the whole input
+//!          (up to config_t::size) before parsing it. In this case, drain()
+//!          has nothing left to forward and the memory footprint is the same
+//!          as reading the input in a VectorStream.
+class LIEF_API ForwardStream : public BinaryStream {
+  public:
+  //! Function that reads at most ``size`` bytes in ``dst`` and returns the
+  //! number of bytes read. 0 means the end of the source.
+  using read_fn_t = std::function<size_t(uint8_t* dst, size_t size)>;
+
+  //! Function that receives the bytes consumed by drain()
+  using drain_fn_t = std::function<void(span<const uint8_t> data)>;
+
+  struct config_t {
+    //! Size of the input if known, 0 otherwise
+    uint64_t size = 0;
+
+    //! Maximum number of bytes that can be buffered (0 means unlimited).
+    //! The reads beyond this limit fail.
+    uint64_t max_buffer = 0;
+  };
+
+  ForwardStream(read_fn_t reader, const config_t& config);
+
+  ForwardStream(read_fn_t reader) :
+    ForwardStream(std::move(reader), config_t())
+  {}
+
+  //! Create a stream that reads from the given std::istream. The istream
+  //! must outlive this object.
+  static ForwardStream from_istream(std::istream& is, const config_t& config);
+
+  static ForwardStream from_istream(std::istream& is) {
+    return from_istream(is, config_t());
+  }
+
+  ForwardStream(const ForwardStream&) = delete;
+  ForwardStream& operator=(const ForwardStream&) = delete;
+
+  ForwardStream(ForwardStream&& other) noexcept = default;
+  ForwardStream& operator=(ForwardStream&& other) noexcept = default;
+
+  ~ForwardStream() override = default;
+
+  uint64_t size() const override;
+
+  //! Number of bytes consumed from the source and kept in memory
+  uint64_t buffered() const {
+    return buffer_.size();
+  }
+
+  //! Whether the input has been fully consumed
+  bool is_eof() const {
+    return eof_;
+  }
+
+  //! Consume the rest of the input (without buffering it) and forward the
+  //! data to the given callback. It returns the number of bytes drained.
+  //!
+  //! If the size of the input is known, the drain stops at the end of the
+  //! input.
+  uint64_t drain(const drain_fn_t& fn);
+
+  //! Consume and buffer the input up to its end (config_t::size if known,
+  //! the end of the source otherwise)
+  ok_error_t fill_to_end() const;
+
+  //! Data buffered so far
+  span<const uint8_t> content() const {
+    return buffer_;
+  }
+
+  //! Move the buffered data out of this stream. The stream must not be used
+  //! afterwards.
+  std::vector<uint8_t>&& move_content() {
+    return std::move(buffer_);
+  }
+
+  static bool classof(const BinaryStream& stream) {
+    return stream.type() == STREAM_TYPE::FORWARD;
+  }
+
+  ok_error_t peek_in(void* dst, uint64_t offset, uint64_t size,
+                     uint64_t virtual_address = 0) const override;
+
+  //! The returned pointer is only valid until the next read on this stream
+  result<const void*> read_at(uint64_t offset, uint64_t size,
+                              uint64_t virtual_address = 0) const override;
+
+  private:
+  //! Consume the source until ``end`` bytes are buffered
+  ok_error_t fill(uint64_t end) const;
+
+  mutable read_fn_t reader_;
+  mutable std::vector<uint8_t> buffer_;
+  mutable bool eof_ = false;
+  mutable uint64_t size_ = 0;
+  uint64_t max_buffer_ = 0;
+  uint64_t drained_ = 0;
+};
+
+}
+
+#endif
@@ -27,6 +27,7 @@
 #include "LIEF/DEX/Method.hpp"
 #include "LIEF/DEX/Field.hpp"
 #include "LIEF/DEX/EnumToString.hpp"
+#include "LIEF/DEX/XRef.hpp"
 #endif
 
 #endif
@@ -135,8 +135,19 @@ class LIEF_API File : public Object {
   //! Extract the current dex file and deoptimize it
   std::string save(const std::string& path = "", bool deoptimize = true) const;
 
+  //! Raw content of the file. If ``deoptimize`` is set, the dex2dex
+  //! instructions are reverted and the checksum and the signature of the
+  //! header are recomputed.
   std::vector<uint8_t> raw(bool deoptimize = true) const;
 
+  //! Check that the Adler-32 checksum of the header matches the content
+  //! of the original file
+  bool verify_checksum() const;
+
+  //! Check that the SHA-1 signature of the header matches the content
+  //! of the original file
+  bool verify_signature() const;
+
   void accept(Visitor& visitor) const override;
 
 
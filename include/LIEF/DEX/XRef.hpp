@@ -0,0 +1,154 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_DEX_XREF_H
+#define LIEF_DEX_XREF_H
+#include <cstdint>
+#include <vector>
+
+#include "LIEF/visibility.h"
+#include "LIEF/span.hpp"
+
+namespace LIEF {
+namespace DEX {
+class File;
+class Method;
+class Field;
+
+//! Cross-references between the methods of a DEX file and the methods,
+//! fields, strings and types they use.
+//!
+//! The index is built in a single pass over the bytecode of the methods and
+//! each relation is stored in both directions as a compressed (CSR)
+//! adjacency list. A query returns the sorted pool indexes (``method_ids``,
+//! ``field_ids``, ``string_ids``, ``type_ids``) in O(degree).
+//!
+//! The DEX::File must outlive this object.
+class LIEF_API XRef {
+  public:
+  //! Compressed adjacency list: the neighbors of ``i`` are
+  //! ``targets[offsets[i]:offsets[i + 1]]``
+  struct LIEF_API csr_t {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> targets;
+
+    span<const uint32_t> get(uint32_t idx) const {
+      if (idx + 1 >= offsets.size()) {
+        return {};
+      }
+      return {targets.data() + offsets[idx], targets.data() + offsets[idx + 1]};
+    }
+
+    //! Number of edges
+    size_t size() const {
+      return targets.size();
+    }
+  };
+
+  //! Build the index for the given DEX file.
+  //!
+  //! The bytecode is decoded from at most ``nb_threads`` threads
+  //! (0: number of hardware threads) and the result does not depend on it.
+  static XRef build(const File& file, uint32_t nb_threads = 0);
+
+  XRef(const XRef&) = delete;
+  XRef& operator=(const XRef&) = delete;
+
+  XRef(XRef&&) noexcept = default;
+  XRef& operator=(XRef&&) noexcept = default;
+
+  ~XRef() = default;
+
+  //! Methods invoked by the given method (``invoke-*``)
+  span<const uint32_t> callees(uint32_t method_idx) const {
+    return calls_.get(method_idx);
+  }
+
+  //! Methods that invoke the given method
+  span<const uint32_t> callers(uint32_t method_idx) const {
+    return callers_.get(method_idx);
+  }
+
+  //! Strings loaded by the given method (``const-string*``)
+  span<const uint32_t> strings(uint32_t method_idx) const {
+    return strings_.get(method_idx);
+  }
+
+  //! Methods that load the given string
+  span<const uint32_t> string_users(uint32_t string_idx) const {
+    return string_users_.get(string_idx);
+  }
+
+  //! Fields accessed by the given method (``iget*``, ``iput*``, ``sget*``,
+  //! ``sput*``)
+  span<const uint32_t> fields(uint32_t method_idx) const {
+    return fields_.get(method_idx);
+  }
+
+  //! Methods that access the given field
+  span<const uint32_t> field_users(uint32_t field_idx) const {
+    return field_users_.get(field_idx);
+  }
+
+  //! Types referenced by the given method (``const-class``, ``check-cast``,
+  //! ``instance-of``, ``new-instance``, ``new-array``, ``filled-new-array*``)
+  span<const uint32_t> types(uint32_t method_idx) const {
+    return types_.get(method_idx);
+  }
+
+  //! Methods that reference the given type
+  span<const uint32_t> type_users(uint32_t type_idx) const {
+    return type_users_.get(type_idx);
+  }
+
+  //! Method associated with the given ``method_ids`` index or a nullptr
+  const Method* method(uint32_t method_idx) const {
+    return method_idx < methods_.size() ? methods_[method_idx] : nullptr;
+  }
+
+  //! Field associated with the given ``field_ids`` index or a nullptr
+  const Field* field(uint32_t field_idx) const {
+    return field_idx < fields_idx_.size() ? fields_idx_[field_idx] : nullptr;
+  }
+
+  //! Methods that invoke the given method
+  std::vector<const Method*> callers(const Method& method) const;
+
+  //! Methods invoked by the given method
+  std::vector<const Method*> callees(const Method& method) const;
+
+  //! Methods that access the given field
+  std::vector<const Method*> field_users(const Field& field) const;
+
+  private:
+  XRef() = default;
+  std::vector<const Method*> resolve(span<const uint32_t> indexes) const;
+
+  std::vector<const Method*> methods_;
+  std::vector<const Field*> fields_idx_;
+
+  csr_t calls_;
+  csr_t callers_;
+  csr_t strings_;
+  csr_t string_users_;
+  csr_t fields_;
+  csr_t field_users_;
+  csr_t types_;
+  csr_t type_users_;
+};
+
+}
+}
+#endif
@@ -20,13 +20,17 @@
 #include <vector>
 
 #include "LIEF/DEX/types.hpp"
+#include "LIEF/DEX/Header.hpp"
 
+#include "LIEF/errors.hpp"
+#include "LIEF/span.hpp"
 #include "LIEF/types.hpp"
 #include "LIEF/visibility.h"
 
 namespace LIEF {
 class BinaryStream;
 namespace DEX {
+class File;
 
 //! Check if the given file is a DEX.
 LIEF_API bool is_dex(const std::string& file);
@@ -42,6 +46,52 @@ LIEF_API dex_version_t version(const std::vector<uint8_t>& raw);
 
 dex_version_t version(BinaryStream& stream);
 
+//! Adler-32 of the given data. ``adler`` is the value of the previous chunk
+//! (if any) so that the checksum can be computed in a streaming fashion.
+LIEF_API uint32_t adler32(span<const uint8_t> data, uint32_t adler = 1);
+
+//! Compute the checksum of the header (Adler-32 of the file, except the
+//! magic and the checksum itself) for the given raw DEX file
+LIEF_API result<uint32_t> compute_checksum(span<const uint8_t> raw);
+
+//! Compute the signature of the header (SHA-1 of the file, except the magic,
+//! the checksum and the signature itself) for the given raw DEX file
+LIEF_API result<Header::signature_t> compute_signature(span<const uint8_t> raw);
+
+//! Recompute the signature and then the checksum of the given raw DEX file
+//! and update its header accordingly.
+LIEF_API ok_error_t update_checksums(span<uint8_t> raw);
+
+//! Status of the header of a DEX file (see: verify())
+struct LIEF_API verify_t {
+  //! Whether the Adler-32 checksum matches the content
+  bool checksum = false;
+
+  //! Whether the SHA-1 signature matches the content
+  bool signature = false;
+
+  bool is_valid() const {
+    return checksum && signature;
+  }
+};
+
+//! Verify the checksum and the signature of the given DEX files (e.g. the
+//! DEX files of an OAT, a VDEX or an APK) from at most ``nb_threads``
+//! threads (0: number of hardware threads).
+//!
+//! The i-th element of the result is the status of ``files[i]``.
+LIEF_API std::vector<verify_t> verify(const std::vector<const File*>& files,
+                                      uint32_t nb_threads = 0);
+
+//! Raw content of the given DEX files (see: File::raw()) with their
+//! signature and their checksum recomputed, from at most ``nb_threads``
+//! threads (0: number of hardware threads).
+//!
+//! The i-th element of the result is the content of ``files[i]``.
+LIEF_API std::vector<std::vector<uint8_t>> fix(const std::vector<const File*>& files,
+                                               bool deoptimize = true,
+                                               uint32_t nb_threads = 0);
+
 }
 }
 
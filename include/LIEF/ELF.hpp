@@ -28,6 +28,7 @@
 #include "LIEF/ELF/Binary.hpp"
 #include "LIEF/ELF/Segment.hpp"
 #include "LIEF/ELF/Builder.hpp"
+#include "LIEF/ELF/CoreUnwinder.hpp"
 #include "LIEF/ELF/EnumToString.hpp"
 #include "LIEF/ELF/Relocation.hpp"
 #include "LIEF/ELF/DynamicEntryArray.hpp"
@@ -36,6 +37,7 @@
 #include "LIEF/ELF/DynamicEntryLibrary.hpp"
 #include "LIEF/ELF/DynamicEntryRpath.hpp"
 #include "LIEF/ELF/DynamicEntryRunPath.hpp"
+#include "LIEF/ELF/DynamicPatcher.hpp"
 #include "LIEF/ELF/DynamicSharedObject.hpp"
 #include "LIEF/ELF/GnuHash.hpp"
 #include "LIEF/ELF/Note.hpp"
@@ -18,6 +18,8 @@
 
 #include <vector>
 #include <memory>
+#include <functional>
+#include <unordered_map>
 
 #include "LIEF/visibility.h"
 #include "LIEF/errors.hpp"
@@ -33,6 +35,8 @@
 #include "LIEF/ELF/Builder.hpp"
 
 namespace LIEF {
+class GoPclntab;
+
 //! Namespace related to the LIEF's ELF module
 namespace ELF {
 namespace DataHandler {
@@ -147,6 +151,13 @@ class LIEF_API Binary : public LIEF::Binary {
   //! Iterator which outputs const Relocation& object
   using it_const_relocations = const_ref_iterator<const relocations_t&, const Relocation*>;
 
+  //! Virtual address assigned to the sections of a relocatable object.
+  //! See: relocate()
+  using sections_layout_t = std::unordered_map<const Section*, uint64_t>;
+
+  //! Callback used by relocate() to resolve the value of undefined symbols
+  using symbol_resolver_t = std::function<result<uint64_t>(const Symbol&)>;
+
   //! Internal container for storing ELF's Symbol
   using symbols_t = std::vector<std::unique_ptr<Symbol>>;
 
@@ -227,6 +238,15 @@ class LIEF_API Binary : public LIEF::Binary {
   Binary& operator=(const Binary& ) = delete;
   Binary(const Binary& copy) = delete;
 
+  //! Create a copy of this binary that can be modified (and written)
+  //! independently.
+  //!
+  //! The objects (sections, segments, symbols, relocations, ...) are copied
+  //! but the raw content of the binary is shared until one of the copies
+  //! modifies it (copy-on-write). Cloning a parsed binary is therefore much
+  //! cheaper than parsing it again.
+  std::unique_ptr<Binary> clone() const;
+
   //! Return binary's class (ELF32 or ELF64)
   Header::CLASS type() const {
     return type_;
@@ -391,6 +411,22 @@ class LIEF_API Binary : public LIEF::Binary {
   //! the relocation added.
   Relocation* add_object_relocation(const Relocation& relocation, const Section& section);
 
+  //! Apply the relocations of an object file (``ET_REL``) on the content
+  //! of the sections, as a static linker would do for the given layout.
+  //!
+  //! @param[in] layout   Address assigned to each section. The relocations
+  //!                     that target sections which are not present in the
+  //!                     layout are not applied.
+  //! @param[in] resolver Optional callback that resolves the undefined
+  //!                     symbols (e.g. kernel exports).
+  //!
+  //! This function supports the static relocations of x86-64, i386,
+  //! AArch64, ARM and RISC-V. It returns the number of relocations applied
+  //! or an error if the architecture is not supported. The relocations whose
+  //! value overflows the relocated field are not applied.
+  result<size_t> relocate(const sections_layout_t& layout,
+                          const symbol_resolver_t& resolver = nullptr);
+
   //! Return `plt.got` relocations
   it_pltgot_relocations       pltgot_relocations();
   it_const_pltgot_relocations pltgot_relocations() const;
@@ -824,6 +860,10 @@ class LIEF_API Binary : public LIEF::Binary {
   //! List of the functions found the in the binary.
   LIEF::Binary::functions_t functions() const;
 
+  //! Build a LIEF::Symbolizer from the symbols and the functions found in
+  //! the binary (``.symtab``, ``.dynsym``, ``.eh_frame``, ...)
+  std::unique_ptr<Symbolizer> symbolizer() const override;
+
   //! ``true`` if the binary embeds notes
   bool has_notes() const;
 
@@ -993,6 +1033,9 @@ class LIEF_API Binary : public LIEF::Binary {
   LIEF::Binary::functions_t eh_frame_functions() const;
   LIEF::Binary::functions_t armexid_functions() const;
 
+  //! functions() with an already-decoded Go pclntab (or none)
+  LIEF::Binary::functions_t functions(const GoPclntab* gopclntab) const;
+
   template<Header::FILE_TYPE OBJECT_TYPE, bool note = false>
   Segment* add_segment(const Segment& segment, uint64_t base);
 
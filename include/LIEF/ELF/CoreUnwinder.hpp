@@ -0,0 +1,180 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ELF_CORE_UNWINDER_H
+#define LIEF_ELF_CORE_UNWINDER_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "LIEF/errors.hpp"
+#include "LIEF/visibility.h"
+
+namespace LIEF {
+namespace ELF {
+class Binary;
+class CorePrStatus;
+
+//! This class unwinds the stacks of the threads saved in an ELF core dump
+//! (x86, x86-64 and AArch64):
+//!
+//! - The registers of each thread come from its ``NT_PRSTATUS`` note.
+//! - The module of a program counter is found with the ``NT_FILE`` mappings
+//!   and the module is loaded from the file system (or given with add_module()).
+//! - The ``.eh_frame`` CFI of the module is executed against the memory of
+//!   the core (``PT_LOAD`` segments) to recover the caller's registers.
+//! - When a frame is not covered by the CFI, the unwinder falls back on the
+//!   frame-pointer chain.
+//!
+//! The modules and their CIE/FDE tables are cached in the unwinder so that
+//! unwinding several cores of the same program only parses the modules once.
+//! The modules are identified by their path and their build-id
+//! (``NT_GNU_BUILD_ID``) which is read from the memory of the core when the
+//! first page of the file is dumped. A module whose build-id differs from
+//! the core's one is not used.
+//!
+//! The threads of a core are unwound concurrently.
+//!
+//! \code{.cpp}
+//! std::unique_ptr<LIEF::ELF::Binary> core = LIEF::ELF::Parser::parse("core.1234");
+//! LIEF::ELF::CoreUnwinder unwinder;
+//! unwinder.sysroot("/srv/symbols/rootfs");
+//! if (auto threads = unwinder.unwind(*core)) {
+//!   for (const LIEF::ELF::CoreUnwinder::thread_t& thread : *threads) {
+//!     for (const LIEF::ELF::CoreUnwinder::frame_t& frame : thread.frames) {
+//!       std::cout << frame.module << "+0x" << std::hex << frame.offset << '\n';
+//!     }
+//!   }
+//! }
+//! \endcode
+class LIEF_API CoreUnwinder {
+  public:
+  //! How the frame has been recovered
+  enum class METHOD {
+    CONTEXT = 0,   ///< Registers of the thread (first frame)
+    CFI,           ///< Call frame information (``.eh_frame``) of the callee
+    FRAME_POINTER, ///< Frame-pointer chain
+  };
+
+  struct LIEF_API frame_t {
+    //! Program counter. For the caller frames, this is the return address.
+    uint64_t pc = 0;
+
+    //! Stack pointer
+    uint64_t sp = 0;
+
+    //! Path of the module that contains the program counter (as referenced
+    //! by ``NT_FILE``) or an empty string
+    std::string module;
+
+    //! Virtual address of the program counter in the module (i.e. without
+    //! the load bias) or 0 if the module can't be loaded
+    uint64_t offset = 0;
+
+    METHOD method = METHOD::CONTEXT;
+  };
+
+  struct LIEF_API thread_t {
+    //! Thread ID (``pr_pid``)
+    int32_t tid = 0;
+
+    //! Signal that was being delivered to the thread (or 0)
+    uint16_t signal = 0;
+
+    //! Frames, from the innermost one
+    std::vector<frame_t> frames;
+  };
+
+  static constexpr size_t DEFAULT_MAX_FRAMES = 256;
+
+  CoreUnwinder();
+
+  CoreUnwinder(const CoreUnwinder&) = delete;
+  CoreUnwinder& operator=(const CoreUnwinder&) = delete;
+
+  CoreUnwinder(CoreUnwinder&&) noexcept;
+  CoreUnwinder& operator=(CoreUnwinder&&) noexcept;
+
+  ~CoreUnwinder();
+
+  //! Directory prepended to the ``NT_FILE`` paths to load the modules
+  void sysroot(std::string path) {
+    sysroot_ = std::move(path);
+  }
+
+  const std::string& sysroot() const {
+    return sysroot_;
+  }
+
+  //! Maximum number of frames per thread
+  void max_frames(size_t count) {
+    max_frames_ = count;
+  }
+
+  size_t max_frames() const {
+    return max_frames_;
+  }
+
+  //! Use the given binary for the module mapped at ``path`` in the cores.
+  //! If the binary has a build-id, it is only used for the cores that map the
+  //! same build of the module.
+  void add_module(const std::string& path, std::unique_ptr<Binary> module);
+
+  //! Same as above but the binary is not owned and must outlive the unwinder
+  void add_module(const std::string& path, const Binary& module);
+
+  //! Number of modules in the cache (including the ones that can't be loaded)
+  size_t nb_modules() const;
+
+  //! Drop the cached modules and their CFI tables
+  void clear_cache();
+
+  //! Unwind all the threads of the given core from at most ``nb_threads``
+  //! threads (0: number of hardware threads)
+  result<std::vector<thread_t>> unwind(const Binary& core, uint32_t nb_threads = 0);
+
+  //! Unwind the thread associated with the given ``NT_PRSTATUS`` note
+  result<thread_t> unwind(const Binary& core, const CorePrStatus& status);
+
+  private:
+  //! Module loaded from the file system or given with add_module()
+  struct module_t;
+
+  //! Address space of a core (``PT_LOAD`` segments and ``NT_FILE`` mappings)
+  struct core_t;
+
+  module_t* module(const std::string& path, const std::vector<uint8_t>& build_id);
+  void insert_module(const std::string& path, std::unique_ptr<module_t> entry);
+  thread_t unwind(const core_t& core, const CorePrStatus& status);
+
+  std::string sysroot_;
+  size_t max_frames_ = DEFAULT_MAX_FRAMES;
+
+  //! Modules indexed by path. A path can be associated with several builds.
+  std::unordered_map<std::string, std::vector<std::unique_ptr<module_t>>> modules_;
+
+  //! Serialize the accesses to modules_ from the workers of unwind()
+  std::unique_ptr<std::mutex> lock_;
+};
+
+LIEF_API const char* to_string(CoreUnwinder::METHOD e);
+
+}
+}
+#endif
@@ -0,0 +1,214 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ELF_DYNAMIC_PATCHER_H
+#define LIEF_ELF_DYNAMIC_PATCHER_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "LIEF/errors.hpp"
+#include "LIEF/span.hpp"
+#include "LIEF/visibility.h"
+
+#include "LIEF/ELF/DynamicEntry.hpp"
+
+namespace LIEF {
+namespace ELF {
+
+//! This class modifies the interpreter and the string-based dynamic entries
+//! (``DT_NEEDED``, ``DT_SONAME``, ``DT_RPATH``, ``DT_RUNPATH``) **in place**,
+//! like ``patchelf`` does for the edits that don't require a new layout.
+//!
+//! Compared to Binary::interpreter() or Binary::add_library() followed by
+//! Builder, only the modified bytes are written:
+//!
+//! - A string that is not longer than the original one (and that is not
+//!   shared with another reference) is overwritten.
+//! - Otherwise, the string is written in the slack of ``.dynstr``: after the
+//!   last referenced string or in the zero-padding that follows the section.
+//! - A new dynamic entry uses one of the spare ``DT_NULL`` slots of the
+//!   dynamic table.
+//!
+//! When an edit does not fit, the function returns lief_errors::data_too_large
+//! and nothing is written. DynamicPatcher::apply() uses this to fall back on
+//! the full rebuild.
+//!
+//! \code{.cpp}
+//! auto patcher = LIEF::ELF::DynamicPatcher::open("libfoo.so");
+//! if (patcher && patcher->runpath("$ORIGIN")) {
+//!   patcher->commit();
+//! }
+//! \endcode
+class LIEF_API DynamicPatcher {
+  public:
+  //! Modifications processed by apply(). An empty value means *unchanged*
+  struct LIEF_API changes_t {
+    std::string interpreter;
+    std::string soname;
+    std::string runpath;
+    std::string rpath;
+
+    //! Libraries to add (if not already present)
+    std::vector<std::string> needed;
+  };
+
+  //! Load the file at the given path. The modifications are written back
+  //! with commit()
+  static result<DynamicPatcher> open(const std::string& path);
+
+  //! Patch the given buffer
+  static result<DynamicPatcher> from_buffer(span<uint8_t> buffer);
+
+  //! Apply the given changes on the file. The changes are first processed
+  //! in place and if one of them does not fit, the file is parsed, modified
+  //! and rebuilt with the ELF::Builder.
+  //!
+  //! It returns true if the changes have been applied in place.
+  static result<bool> apply(const std::string& path, const changes_t& changes);
+
+  DynamicPatcher(const DynamicPatcher&) = delete;
+  DynamicPatcher& operator=(const DynamicPatcher&) = delete;
+
+  DynamicPatcher(DynamicPatcher&&) noexcept;
+  DynamicPatcher& operator=(DynamicPatcher&&) noexcept;
+
+  ~DynamicPatcher();
+
+  //! Current interpreter (empty if the binary does not have a ``PT_INTERP``)
+  std::string interpreter() const;
+
+  //! Change the interpreter. It must fit in the ``PT_INTERP`` segment.
+  ok_error_t interpreter(const std::string& path);
+
+  //! Change (or add) the ``DT_SONAME`` entry
+  ok_error_t soname(const std::string& name) {
+    return set_string_entry(DynamicEntry::TAG::SONAME, name);
+  }
+
+  //! Change (or add) the ``DT_RUNPATH`` entry
+  ok_error_t runpath(const std::string& path) {
+    return set_string_entry(DynamicEntry::TAG::RUNPATH, path);
+  }
+
+  //! Change (or add) the ``DT_RPATH`` entry
+  ok_error_t rpath(const std::string& path) {
+    return set_string_entry(DynamicEntry::TAG::RPATH, path);
+  }
+
+  //! Add a ``DT_NEEDED`` entry after the existing ones. It does nothing
+  //! if the library is already present.
+  ok_error_t add_needed(const std::string& library);
+
+  //! Libraries referenced by the ``DT_NEEDED`` entries
+  std::vector<std::string> needed() const;
+
+  //! Number of spare ``DT_NULL`` slots that can be used for new entries
+  size_t spare_dynamic_slots() const {
+    return spare_slots_;
+  }
+
+  //! Number of bytes that can be used in ``.dynstr`` for new strings
+  uint64_t dynstr_slack() const {
+    return strtab_capacity_ - strtab_used_;
+  }
+
+  //! File ranges (offset, size) modified so far
+  const std::vector<std::pair<uint64_t, uint64_t>>& modifications() const {
+    return modifications_;
+  }
+
+  //! Write the modifications in the file used by open(). It is a no-op
+  //! for from_buffer()
+  ok_error_t commit();
+
+  private:
+  struct dynamic_entry_t {
+    uint64_t tag = 0;
+    uint64_t value = 0;
+  };
+
+  DynamicPatcher();
+  ok_error_t init();
+
+  template<class ELF_T>
+  ok_error_t init();
+
+  //! Collect the references to ``.dynstr`` from the given symbol tables
+  //! (offset, number of symbols) and from the symbol versions
+  template<class ELF_T>
+  bool collect_string_refs(const std::vector<std::pair<uint64_t, uint64_t>>& symtabs);
+
+  ok_error_t set_string_entry(DynamicEntry::TAG tag, const std::string& value);
+
+  //! Offset in ``.dynstr`` of a string equal to ``value``: the string is
+  //! reused, overwritten (``owner`` is the index of the entry that
+  //! references the string to replace) or added in the slack.
+  result<uint64_t> place_string(const std::string& value, size_t owner);
+
+  //! Whether a reference other than the dynamic entry ``owner`` points
+  //! into [start, end) or to a string that runs into this range (tail-merged
+  //! strings)
+  bool is_referenced(uint64_t start, uint64_t end, size_t owner) const;
+
+  std::string string_at(uint64_t offset) const;
+
+  result<uint64_t> va2offset(uint64_t va) const;
+
+  void write(uint64_t offset, span<const uint8_t> data);
+  void write_entry(size_t idx);
+
+  template<class T>
+  void write_int(uint64_t offset, T value);
+
+  std::vector<uint8_t> data_;
+  span<uint8_t> buffer_;
+  std::string path_;
+
+  bool is64_ = true;
+  bool swap_ = false;
+
+  struct load_t {
+    uint64_t offset = 0;
+    uint64_t vaddr = 0;
+    uint64_t size = 0;
+  };
+  std::vector<load_t> loads_;
+
+  uint64_t interp_offset_ = 0;
+  uint64_t interp_size_ = 0;
+
+  uint64_t dynamic_offset_ = 0;
+  size_t spare_slots_ = 0;
+  std::vector<dynamic_entry_t> entries_;
+
+  uint64_t strtab_offset_ = 0;
+  uint64_t strtab_size_ = 0;
+  uint64_t strtab_used_ = 0;
+  uint64_t strtab_capacity_ = 0;
+  uint64_t strtab_shdr_size_offset_ = 0;
+  bool refs_known_ = false;
+
+  //! References to ``.dynstr`` from the symbols and the symbol versions
+  std::vector<uint64_t> string_refs_;
+
+  std::vector<std::pair<uint64_t, uint64_t>> modifications_;
+};
+
+}
+}
+#endif
@@ -45,6 +45,10 @@ class LIEF_API CoreFile : public Note {
   using iterator       = files_t::iterator;
   using const_iterator = files_t::const_iterator;
 
+  //! Maximum number of entries parsed from the note. The ELF parser can
+  //! lower it with ParserBudget::max_objects.
+  static constexpr uint64_t NB_MAX_ENTRIES = 6000;
+
   public:
   CoreFile(ARCH arch, Header::CLASS cls, std::string name,
            uint32_t type, Note::description_t description);
@@ -63,6 +67,11 @@ class LIEF_API CoreFile : public Note {
     return files_;
   }
 
+  //! Unit of the entries' file_ofs (usually the page size of the process)
+  uint64_t page_size() const {
+    return page_size_;
+  }
+
   iterator begin() {
     return files_.begin();
   }
@@ -97,6 +106,8 @@ class LIEF_API CoreFile : public Note {
   }
 
   protected:
+  friend class Parser;
+
   template<class T>
   LIEF_LOCAL void read_files();
 
@@ -28,6 +28,7 @@
 
 namespace LIEF {
 class BinaryStream;
+class BudgetTracker;
 
 namespace OAT {
 class Parser;
@@ -55,6 +56,9 @@ class LIEF_API Parser : public LIEF::Parser {
   static constexpr uint32_t NB_MAX_MASKWORD        = 512;
   static constexpr uint32_t MAX_SEGMENT_SIZE       = 3_GB;
 
+  //! Number of stages reported to the ParserBudget's progress callback
+  static constexpr size_t NB_STAGES = 10;
+
   enum ELF_TYPE {
     ELF_UNKNOWN,
     ELF32, ELF64
@@ -258,6 +262,7 @@ class LIEF_API Parser : public LIEF::Parser {
   std::unique_ptr<BinaryStream> stream_;
   std::unique_ptr<Binary> binary_;
   ParserConfig config_;
+  std::unique_ptr<BudgetTracker> budget_;
   /*
    * parse_sections() may skip some sections so that
    * binary_->sections_ is not contiguous based on the index of the sections.
@@ -16,6 +16,7 @@
 #ifndef LIEF_ELF_PARSER_CONFIG_H
 #define LIEF_ELF_PARSER_CONFIG_H
 #include "LIEF/visibility.h"
+#include "LIEF/Abstract/ParserBudget.hpp"
 #include "LIEF/ELF/enums.hpp"
 
 namespace LIEF {
@@ -48,6 +49,10 @@ struct LIEF_API ParserConfig {
 
   /** The method used to count the number of dynamic symbols */
   DYNSYM_COUNT count_mtd = DYNSYM_COUNT::AUTO;
+
+  /** Resources (memory, time, number of objects) that the parser can use
+      and hooks for cancellation and progress */
+  ParserBudget budget;
 };
 
 }
@@ -35,6 +35,7 @@ class Section;
 class LIEF_API Symbol : public LIEF::Symbol {
   friend class Parser;
   friend class Binary;
+  friend class Layout;
   public:
 
   enum class BINDING {
@@ -266,6 +267,8 @@ class LIEF_API Symbol : public LIEF::Symbol {
   Section* section_ = nullptr;
   SymbolVersion* symbol_version_ = nullptr;
   ARCH arch_ = ARCH::NONE;
+  uint32_t name_offset_ = 0; // Original offset of the name in the string table
+  uint32_t symtab_idx_ = -1u; // Original index in the .symtab (-1u if added)
 };
 
 LIEF_API const char* to_string(Symbol::BINDING binding);
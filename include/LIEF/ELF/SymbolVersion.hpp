@@ -31,6 +31,7 @@ class SymbolVersionAuxRequirement;
 //! dynamic entry
 class LIEF_API SymbolVersion : public Object {
   friend class Parser;
+  friend class Binary;
 
   public:
   SymbolVersion(uint16_t value) :
@@ -36,6 +36,7 @@ struct Elf32_Verdef;
 //! Class which represents an entry defined in `DT_VERDEF` or `.gnu.version_d`
 class LIEF_API SymbolVersionDefinition : public Object {
   friend class Parser;
+  friend class Binary;
   public:
   using version_aux_t        = std::vector<std::unique_ptr<SymbolVersionAux>>;
   using it_version_aux       = ref_iterator<version_aux_t&, SymbolVersionAux*>;
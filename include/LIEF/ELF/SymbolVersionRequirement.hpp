@@ -38,6 +38,7 @@ struct Elf32_Verneed;
 //! Class which represents an entry in the `DT_VERNEED` or `.gnu.version_r` table
 class LIEF_API SymbolVersionRequirement : public Object {
   friend class Parser;
+  friend class Binary;
 
   public:
   using aux_requirement_t        = std::vector<std::unique_ptr<SymbolVersionAuxRequirement>>;
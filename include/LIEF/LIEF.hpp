@@ -18,6 +18,10 @@
 #include <LIEF/config.h>
 
 #include <LIEF/Abstract.hpp>
+#include <LIEF/AR.hpp>
+#include <LIEF/ZIP.hpp>
+#include <LIEF/carving.hpp>
+#include <LIEF/checksec.hpp>
 
 #include <LIEF/OAT.hpp>
 #include <LIEF/VDEX.hpp>
@@ -73,6 +73,7 @@
 #include "LIEF/MachO/TwoLevelHints.hpp"
 #include "LIEF/MachO/UUIDCommand.hpp"
 #include "LIEF/MachO/UnknownCommand.hpp"
+#include "LIEF/MachO/UnwindInfo.hpp"
 #include "LIEF/MachO/VersionMin.hpp"
 #include "LIEF/MachO/enums.hpp"
 #include "LIEF/MachO/hash.hpp"
@@ -20,6 +20,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 #include "LIEF/MachO/LoadCommand.hpp"
 #include "LIEF/MachO/Header.hpp"
@@ -43,6 +44,7 @@ class Metadata;
 namespace MachO {
 
 class BinaryParser;
+class BindingInfo;
 class BuildVersion;
 class Builder;
 class CodeSignature;
@@ -428,10 +430,15 @@ class LIEF_API Binary : public LIEF::Binary  {
   //! Remove the symbol with the given name
   bool remove_symbol(const std::string& name);
 
-  //! Remove the given symbol
+  //! Remove the given symbol (which must belong to this binary). Other
+  //! symbols with the same name are left untouched.
   bool remove(const Symbol& sym);
 
   //! Check if the given symbol can be safely removed.
+  //!
+  //! A symbol can be removed if it is not referenced by a binding
+  //! (LC_DYLD_INFO or LC_DYLD_CHAINED_FIXUPS). The lookup runs in constant time
+  //! through a reverse index that is built on the first call.
   bool can_remove(const Symbol& sym) const;
 
   //! Check if the MachO::Symbol with the given name can be safely removed.
@@ -825,6 +832,10 @@ class LIEF_API Binary : public LIEF::Binary  {
   //! Return the functions found in the ``__unwind_info`` section
   LIEF::Binary::functions_t unwind_functions() const;
 
+  //! Build a LIEF::Symbolizer from the symbols and the functions found in
+  //! the binary (``LC_SYMTAB``, ``LC_FUNCTION_STARTS`` and ``__unwind_info``)
+  std::unique_ptr<Symbolizer> symbolizer() const override;
+
   //! ``true`` if the binary has a LoadCommand::TYPE::FILESET_ENTRY command
   bool has_filesets() const {
     return filesets_.empty();
@@ -908,6 +919,12 @@ class LIEF_API Binary : public LIEF::Binary  {
     return this->relocations_;
   }
 
+  //! Reverse index: Symbol -> bindings that reference this symbol
+  using symbol_bindings_t = std::unordered_map<const Symbol*, std::vector<const BindingInfo*>>;
+
+  //! Return the reverse index of the bindings (lazily built)
+  const symbol_bindings_t& symbol_bindings() const;
+
   size_t pointer_size() const {
     return this->is64_ ? sizeof(uint64_t) : sizeof(uint32_t);
   }
@@ -937,6 +954,10 @@ class LIEF_API Binary : public LIEF::Binary  {
   // offset_to_virtual_address
   std::map<uint64_t, SegmentCommand*> offset_seg_;
 
+  // Used by can_remove() to avoid a lookup in all the bindings.
+  // A null value means that the index is not built yet.
+  mutable std::unique_ptr<symbol_bindings_t> symbol_bindings_;
+
   protected:
   uint64_t fat_offset_ = 0;
   uint64_t fileset_offset_ = 0;
@@ -35,6 +35,7 @@
 
 namespace LIEF {
 class BinaryStream;
+class BudgetTracker;
 class SpanStream;
 
 namespace MachO {
@@ -81,6 +82,9 @@ class LIEF_API BinaryParser : public LIEF::Parser {
   //! Maximum number of MachO LoadCommand
   constexpr static size_t MAX_COMMANDS = (std::numeric_limits<uint16_t>::max)();
 
+  //! Number of stages reported to the ParserBudget's progress callback
+  constexpr static size_t NB_STAGES = 10;
+
   public:
   static std::unique_ptr<Binary> parse(const std::string& file);
   static std::unique_ptr<Binary> parse(const std::string& file, const ParserConfig& conf);
@@ -264,6 +268,7 @@ class LIEF_API BinaryParser : public LIEF::Parser {
   MACHO_TYPES                    type_ = MACHO_TYPES::MH_MAGIC_64;
   bool                           is64_ = true;
   ParserConfig                   config_;
+  std::unique_ptr<BudgetTracker> budget_;
   std::set<uint64_t>             visited_;
   std::unordered_map<std::string, Symbol*> memoized_symbols_;
   std::map<uint64_t, Symbol*>    memoized_symbols_by_address_;
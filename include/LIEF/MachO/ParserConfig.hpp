@@ -16,6 +16,7 @@
 #ifndef LIEF_MACHO_PARSER_CONFIG_H
 #define LIEF_MACHO_PARSER_CONFIG_H
 #include "LIEF/visibility.h"
+#include "LIEF/Abstract/ParserBudget.hpp"
 
 namespace LIEF {
 namespace MachO {
@@ -50,6 +51,10 @@ struct LIEF_API ParserConfig {
 
   /// Whether the binary is coming/extracted from Dyld shared cache
   bool from_dyld_shared_cache = false;
+
+  /// Resources (memory, time, number of objects) that the parser can use
+  /// and hooks for cancellation and progress
+  ParserBudget budget;
 };
 
 }
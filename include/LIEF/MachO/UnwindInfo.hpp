@@ -0,0 +1,255 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_MACHO_UNWIND_INFO_H
+#define LIEF_MACHO_UNWIND_INFO_H
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "LIEF/errors.hpp"
+#include "LIEF/iterators.hpp"
+#include "LIEF/span.hpp"
+#include "LIEF/visibility.h"
+#include "LIEF/MachO/Header.hpp"
+
+namespace LIEF {
+namespace MachO {
+class Binary;
+
+//! This class decodes the compact unwind table (``__TEXT,__unwind_info``)
+//! straight from the content of the section:
+//!
+//! - The first-level index is binary-searched to find the second-level page
+//!   that covers an address.
+//! - The (regular or compressed) page is then binary-searched to find the
+//!   function and its compact unwind encoding.
+//!
+//! The entries are only decoded when they are looked up or iterated. When the
+//! encoding defers to DWARF, the FDE can be resolved in ``__eh_frame`` with
+//! UnwindInfo::fde().
+//!
+//! The MachO::Binary (or the buffers) must outlive this object.
+class LIEF_API UnwindInfo {
+  public:
+  static constexpr uint32_t IS_NOT_FUNCTION_START = 0x80000000;
+  static constexpr uint32_t HAS_LSDA              = 0x40000000;
+  static constexpr uint32_t PERSONALITY_MASK      = 0x30000000;
+  static constexpr uint32_t MODE_MASK             = 0x0f000000;
+  static constexpr uint32_t DWARF_SECTION_OFFSET  = 0x00ffffff;
+
+  //! Function covered by the table
+  struct LIEF_API entry_t {
+    //! Virtual address of the function (0 if the lookup failed)
+    uint64_t address = 0;
+
+    //! Size of the range covered by the encoding. The linker merges the
+    //! adjacent functions that share the same encoding so that the range
+    //! can span several functions.
+    uint64_t size = 0;
+
+    //! Compact unwind encoding
+    uint32_t encoding = 0;
+
+    //! Virtual address of the language-specific data area (or 0)
+    uint64_t lsda = 0;
+
+    //! Virtual address of the personality function's pointer (or 0)
+    uint64_t personality = 0;
+
+    bool has_lsda() const {
+      return (encoding & HAS_LSDA) != 0;
+    }
+
+    bool is_function_start() const {
+      return (encoding & IS_NOT_FUNCTION_START) == 0;
+    }
+  };
+
+  //! DWARF Frame Description Entry (``__eh_frame``)
+  struct LIEF_API fde_t {
+    //! Virtual address of the FDE
+    uint64_t address = 0;
+
+    //! Range of addresses described by the FDE
+    uint64_t pc_begin = 0;
+    uint64_t pc_end = 0;
+  };
+
+  //! Forward iterator over the entries of the table
+  class LIEF_API Iterator {
+    public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = entry_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const entry_t*;
+    using reference = const entry_t&;
+
+    Iterator() = default;
+    Iterator(const UnwindInfo& info, uint32_t page, uint32_t idx);
+
+    Iterator& operator++();
+
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    reference operator*() const {
+      return entry_;
+    }
+
+    pointer operator->() const {
+      return &entry_;
+    }
+
+    friend bool operator==(const Iterator& LHS, const Iterator& RHS) {
+      return LHS.info_ == RHS.info_ && LHS.page_ == RHS.page_ && LHS.idx_ == RHS.idx_;
+    }
+
+    friend bool operator!=(const Iterator& LHS, const Iterator& RHS) {
+      return !(LHS == RHS);
+    }
+
+    private:
+    void skip_empty_pages();
+
+    const UnwindInfo* info_ = nullptr;
+    uint32_t page_ = 0;
+    uint32_t idx_ = 0;
+    entry_t entry_;
+  };
+
+  using entries_it = iterator_range<Iterator>;
+
+  //! Create the decoder for the ``__unwind_info`` section of the given binary
+  static result<UnwindInfo> from_binary(const Binary& bin);
+
+  //! Create the decoder from the raw content of ``__unwind_info``
+  //!
+  //! @param[in] raw        Content of ``__unwind_info``
+  //! @param[in] imagebase  Base address of the image (the table stores
+  //!                       offsets relative to this address)
+  //! @param[in] arch       Architecture which defines the compact encodings
+  //! @param[in] eh_frame   Content of ``__eh_frame`` (optional)
+  //! @param[in] eh_frame_address Virtual address of ``__eh_frame``
+  static result<UnwindInfo> parse(span<const uint8_t> raw, uint64_t imagebase,
+                                  Header::CPU_TYPE arch,
+                                  span<const uint8_t> eh_frame = {},
+                                  uint64_t eh_frame_address = 0);
+
+  UnwindInfo(const UnwindInfo&) = default;
+  UnwindInfo& operator=(const UnwindInfo&) = default;
+
+  UnwindInfo(UnwindInfo&&) noexcept = default;
+  UnwindInfo& operator=(UnwindInfo&&) noexcept = default;
+
+  ~UnwindInfo() = default;
+
+  //! Version of the table (1)
+  uint32_t version() const {
+    return version_;
+  }
+
+  Header::CPU_TYPE arch() const {
+    return arch_;
+  }
+
+  uint64_t imagebase() const {
+    return imagebase_;
+  }
+
+  //! Number of second-level pages
+  uint32_t nb_pages() const {
+    return nb_index_ > 0 ? nb_index_ - 1 : 0;
+  }
+
+  //! Encodings shared by all the compressed pages
+  std::vector<uint32_t> common_encodings() const;
+
+  //! Virtual addresses of the personality functions' pointers
+  std::vector<uint64_t> personalities() const;
+
+  //! Iterator over the entries of the table
+  entries_it entries() const;
+
+  //! Return the entry that covers the given virtual address
+  result<entry_t> lookup(uint64_t address) const;
+
+  //! Batch version of lookup(): the entry of @p addresses[i] is written in
+  //! @p entries[i] (with an address set to 0 if it can't be resolved).
+  //!
+  //! Consecutive addresses that fall in the same page (e.g. sorted
+  //! addresses) do not search the first-level index again.
+  void lookup(const uint64_t* addresses, size_t count, entry_t* entries) const;
+
+  std::vector<entry_t> lookup(const std::vector<uint64_t>& addresses) const;
+
+  //! Whether the given encoding defers to the DWARF unwind information
+  bool is_dwarf(uint32_t encoding) const;
+
+  //! Resolve the FDE (in ``__eh_frame``) referenced by the encoding of an
+  //! entry that uses the DWARF mode
+  result<fde_t> fde(const entry_t& entry) const;
+
+  private:
+  friend class Iterator;
+
+  //! Second-level page of the table
+  struct page_t {
+    uint32_t kind = 0;
+    uint32_t entries_offset = 0;
+    uint32_t nb_entries = 0;
+    uint32_t encodings_offset = 0;
+    uint32_t nb_encodings = 0;
+
+    //! Range of function offsets covered by the page
+    uint32_t start = 0;
+    uint32_t end = 0;
+
+    //! Range of the LSDA entries associated with the page
+    uint32_t lsda_start = 0;
+    uint32_t lsda_end = 0;
+  };
+
+  UnwindInfo() = default;
+
+  uint32_t read_u32(uint32_t offset) const;
+  uint32_t index_function(uint32_t idx) const;
+  page_t page(uint32_t idx) const;
+  uint32_t function_offset(const page_t& page, uint32_t idx) const;
+  entry_t entry(const page_t& page, uint32_t idx) const;
+  uint32_t find_page(uint32_t offset) const;
+  uint32_t find_entry(const page_t& page, uint32_t offset) const;
+
+  span<const uint8_t> raw_;
+  span<const uint8_t> eh_frame_;
+  uint64_t eh_frame_address_ = 0;
+  uint64_t imagebase_ = 0;
+  Header::CPU_TYPE arch_ = Header::CPU_TYPE::ANY;
+
+  uint32_t version_ = 0;
+  uint32_t encodings_offset_ = 0;
+  uint32_t nb_encodings_ = 0;
+  uint32_t personalities_offset_ = 0;
+  uint32_t nb_personalities_ = 0;
+  uint32_t index_offset_ = 0;
+  uint32_t nb_index_ = 0;
+};
+
+}
+}
+#endif
@@ -35,6 +35,11 @@ class Binary;
 class Class;
 
 //! Class to parse an OAT file to produce an OAT::Binary
+//!
+//! By default, the ELF container is completely parsed
+//! (ELF::ParserConfig::all()). When only the OAT data are needed,
+//! light_config() can be provided to skip the relocations, the static
+//! symbols, the symbol versions and the notes.
 class LIEF_API Parser : public ELF::Parser {
   public:
   //! Parse an OAT file
@@ -44,13 +49,24 @@ class LIEF_API Parser : public ELF::Parser {
 
   static std::unique_ptr<Binary> parse(std::vector<uint8_t> data);
 
+  //! Parse an OAT file with the given configuration for the ELF container
+  static std::unique_ptr<Binary> parse(const std::string& oat_file,
+                                       const ELF::ParserConfig& conf);
+  static std::unique_ptr<Binary> parse(std::vector<uint8_t> data,
+                                       const ELF::ParserConfig& conf);
+
+  //! Configuration of the ELF parser that only parses what is needed by the
+  //! OAT format (segments, sections and dynamic symbols). It must be
+  //! explicitly provided to parse()
+  static ELF::ParserConfig light_config();
+
   Parser& operator=(const Parser& copy) = delete;
   Parser(const Parser& copy)            = delete;
 
   protected:
   Parser();
-  Parser(const std::string& oat_file);
-  Parser(std::vector<uint8_t> data);
+  Parser(const std::string& oat_file, const ELF::ParserConfig& conf = ELF::ParserConfig::all());
+  Parser(std::vector<uint8_t> data, const ELF::ParserConfig& conf = ELF::ParserConfig::all());
   ~Parser() override;
 
   Binary& oat_binary() {
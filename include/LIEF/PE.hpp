@@ -25,6 +25,10 @@
 #include "LIEF/PE/TLS.hpp"
 #include "LIEF/PE/Export.hpp"
 #include "LIEF/PE/ExportEntry.hpp"
+#include "LIEF/PE/ExportResolver.hpp"
+#include "LIEF/PE/ApiSet.hpp"
+#include "LIEF/PE/ImportResolver.hpp"
+#include "LIEF/PE/HeaderPatcher.hpp"
 #include "LIEF/PE/Import.hpp"
 #include "LIEF/PE/ImportEntry.hpp"
 #include "LIEF/PE/DelayImport.hpp"
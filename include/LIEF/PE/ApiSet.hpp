@@ -0,0 +1,123 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_PE_API_SET_H
+#define LIEF_PE_API_SET_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "LIEF/errors.hpp"
+#include "LIEF/span.hpp"
+#include "LIEF/visibility.h"
+
+namespace LIEF {
+namespace PE {
+class Binary;
+
+//! This class represents the API set schema of Windows (``apisetschema.dll``)
+//! which maps the API set contracts (``api-ms-win-*``, ``ext-ms-*``) to the
+//! DLLs that implement them.
+//!
+//! The schemas of Windows 7 (v2), Windows 8.1 (v4) and Windows 10+ (v6) are
+//! supported.
+class LIEF_API ApiSet {
+  public:
+  //! Host of a contract
+  struct LIEF_API value_t {
+    //! Name of the importing module for which this host applies. It is
+    //! empty for the default host.
+    std::string importer;
+
+    //! DLL that implements the contract (e.g. ``kernelbase.dll``)
+    std::string host;
+  };
+
+  //! API set contract
+  struct LIEF_API entry_t {
+    //! Name of the contract as stored in the schema (in lower case)
+    std::string name;
+
+    //! Whether the contract is sealed
+    bool is_sealed = false;
+
+    std::vector<value_t> values;
+  };
+
+  using entries_t = std::vector<entry_t>;
+
+  //! Parse the ``.apiset`` section of the given ``apisetschema.dll``
+  static result<ApiSet> parse(const Binary& apisetschema);
+
+  //! Parse the raw API set namespace (content of the ``.apiset`` section)
+  static result<ApiSet> parse(span<const uint8_t> raw);
+
+  ApiSet(const ApiSet&) = default;
+  ApiSet& operator=(const ApiSet&) = default;
+
+  ApiSet(ApiSet&&) noexcept = default;
+  ApiSet& operator=(ApiSet&&) noexcept = default;
+
+  ~ApiSet() = default;
+
+  //! Version of the schema (2, 4 or 6)
+  uint32_t version() const {
+    return version_;
+  }
+
+  const entries_t& entries() const {
+    return entries_;
+  }
+
+  //! Whether the given module name (e.g. ``api-ms-win-core-file-l1-2-4.dll``)
+  //! is an API set contract (according to its prefix)
+  static bool is_api_set(const std::string& name);
+
+  //! Return the contract matching the given module name or a nullptr
+  const entry_t* find(const std::string& name) const;
+
+  //! Resolve the given contract into its host DLL.
+  //!
+  //! @param[in] name      Name of the contract (e.g. ``api-ms-win-core-file-l1-2-4.dll``)
+  //! @param[in] importer  Name of the module that imports the contract.
+  //!                      Some contracts are redirected for specific modules.
+  result<std::string> resolve(const std::string& name,
+                              const std::string& importer) const;
+
+  result<std::string> resolve(const std::string& name) const {
+    return resolve(name, "");
+  }
+
+  private:
+  ApiSet() = default;
+  ok_error_t parse_v2(span<const uint8_t> raw);
+  ok_error_t parse_v4(span<const uint8_t> raw);
+  ok_error_t parse_v6(span<const uint8_t> raw);
+
+  //! Key used to index the given (normalized) contract name
+  std::string key(const std::string& name) const;
+
+  uint32_t version_ = 0;
+  entries_t entries_;
+
+  //! Hashed prefix table: contract name (without its version) -> entry index
+  std::unordered_map<std::string, size_t> index_;
+};
+
+}
+}
+#endif
@@ -333,6 +333,39 @@ class LIEF_API Binary : public LIEF::Binary {
   //! parameter
   std::vector<uint8_t> authentihash(ALGORITHMS algo) const;
 
+  //! Compute the Authenticode hash of the page that starts at the given
+  //! file offset. The first page covers the headers (without the checksum
+  //! and the certificate table entry) and the other pages are
+  //! ``section_alignment`` chunks of the sections' content. They are
+  //! zero-padded to a full page.
+  //!
+  //! This is the hash stored in the ``SPC_PE_IMAGE_PAGE_HASHES`` table of the
+  //! signature (c.f. SpcIndirectData::page_hashes)
+  result<std::vector<uint8_t>> page_hash(uint32_t offset, ALGORITHMS algo) const;
+
+  //! Check that the page which contains the given RVA matches the page
+  //! hashes embedded in the first signature. Only this page is hashed.
+  //!
+  //! It returns an error if the binary is not signed, if the signature does
+  //! not embed page hashes or if the RVA is not backed by the file.
+  result<bool> verify_page(uint64_t rva) const;
+
+  //! Check that the page which contains the given RVA matches the page
+  //! hashes of the given signature
+  result<bool> verify_page(uint64_t rva, const Signature& sig) const;
+
+  //! Check all the pages against the page hashes embedded in the first
+  //! signature and return the file offsets of the pages that don't match
+  //! (an empty vector means that all the pages are valid).
+  //!
+  //! The pages are hashed from at most ``nb_threads`` threads
+  //! (0: number of hardware threads).
+  result<std::vector<uint32_t>> verify_pages(uint32_t nb_threads = 0) const;
+
+  //! Check all the pages against the page hashes of the given signature
+  result<std::vector<uint32_t>> verify_pages(const Signature& sig,
+                                             uint32_t nb_threads = 0) const;
+
   //! Try to predict the RVA of the function `function` in the import library `library`
   //!
   //! @warning
@@ -658,6 +691,11 @@ class LIEF_API Binary : public LIEF::Binary {
   //! Functions found in the Exception table directory
   LIEF::Binary::functions_t exception_functions() const;
 
+  //! Build a LIEF::Symbolizer from the symbols and the functions found in
+  //! the binary (exports and exception table).
+  //! The ranges are expressed as absolute virtual addresses.
+  std::unique_ptr<Symbolizer> symbolizer() const override;
+
   static bool classof(const LIEF::Binary* bin) {
     return bin->format() == Binary::FORMATS::PE;
   }
@@ -688,6 +726,10 @@ class LIEF_API Binary : public LIEF::Binary {
   void update_lookup_address_table_offset();
   void update_iat();
 
+  //! Headers as hashed by Authenticode (i.e. without the checksum and the
+  //! certificate table's data directory)
+  std::vector<uint8_t> authenticode_headers() const;
+
   PE_TYPE        type_ = PE_TYPE::PE32_PLUS;
   DosHeader      dos_header_;
   Header         header_;
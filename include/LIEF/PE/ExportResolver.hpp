@@ -0,0 +1,125 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_PE_EXPORT_RESOLVER_H
+#define LIEF_PE_EXPORT_RESOLVER_H
+
+#include <cstdint>
+#include <string>
+
+#include "LIEF/errors.hpp"
+#include "LIEF/span.hpp"
+#include "LIEF/visibility.h"
+#include "LIEF/PE/ExportEntry.hpp"
+
+namespace LIEF {
+namespace PE {
+class Binary;
+
+//! This class resolves exported functions straight from the on-disk export
+//! directory, as ``GetProcAddress`` does:
+//!
+//! - A lookup by name is a binary search in the (sorted) name pointer table
+//!   followed by an access to the ordinal table.
+//! - A lookup by ordinal directly indexes the export address table.
+//!
+//! Only the entries that are looked up are decoded, which makes this class
+//! suitable to resolve a few imports against a DLL with thousands of exports.
+//! It can be used on a PE::Binary parsed with ParserConfig::parse_exports set
+//! to ``false``.
+//!
+//! The PE::Binary must outlive this object.
+class LIEF_API ExportResolver {
+  public:
+  static result<ExportResolver> from_binary(const Binary& bin);
+
+  ExportResolver(const ExportResolver&) = default;
+  ExportResolver& operator=(const ExportResolver&) = default;
+
+  ExportResolver(ExportResolver&&) noexcept = default;
+  ExportResolver& operator=(ExportResolver&&) noexcept = default;
+
+  ~ExportResolver() = default;
+
+  //! Name of the library as stored in the export directory (e.g. ``KERNEL32.dll``)
+  const std::string& name() const {
+    return name_;
+  }
+
+  //! Number of entries in the export address table
+  uint32_t nb_functions() const {
+    return nb_functions_;
+  }
+
+  //! Number of entries in the name pointer table
+  uint32_t nb_names() const {
+    return nb_names_;
+  }
+
+  uint32_t ordinal_base() const {
+    return ordinal_base_;
+  }
+
+  //! Find the export with the given name.
+  //!
+  //! @param[in] name  Name of the exported function
+  //! @param[in] hint  Index in the name pointer table to check first (e.g.
+  //!                  ImportEntry::hint). The binary search is only performed
+  //!                  if the hint does not match.
+  result<ExportEntry> find(const std::string& name, uint32_t hint) const;
+
+  result<ExportEntry> find(const std::string& name) const {
+    return find(name, NO_HINT);
+  }
+
+  //! Find the export associated with the given (biased) ordinal
+  result<ExportEntry> find_ordinal(uint32_t ordinal) const;
+
+  //! Return the name associated with the entry at the given index of the
+  //! name pointer table
+  result<std::string> name_at(uint32_t idx) const;
+
+  static constexpr uint32_t NO_HINT = uint32_t(-1);
+
+  private:
+  ExportResolver() = default;
+
+  //! Content located at the given RVA (up to the end of its section)
+  span<const uint8_t> content_at(uint32_t rva) const;
+
+  //! Name pointed by the idx-th entry of the name pointer table
+  span<const uint8_t> name_span(uint32_t idx) const;
+
+  //! Build the entry for the idx-th element of the export address table
+  result<ExportEntry> make_entry(uint32_t idx) const;
+
+  const Binary* bin_ = nullptr;
+  std::string name_;
+
+  span<const uint8_t> address_table_;
+  span<const uint8_t> ordinal_table_;
+  span<const uint8_t> name_table_;
+
+  uint32_t nb_functions_ = 0;
+  uint32_t nb_names_ = 0;
+  uint32_t ordinal_base_ = 0;
+
+  uint32_t dir_start_ = 0;
+  uint64_t dir_end_ = 0;
+};
+
+}
+}
+#endif
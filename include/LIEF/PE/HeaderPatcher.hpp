@@ -0,0 +1,144 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_PE_HEADER_PATCHER_H
+#define LIEF_PE_HEADER_PATCHER_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "LIEF/errors.hpp"
+#include "LIEF/span.hpp"
+#include "LIEF/visibility.h"
+
+#include "LIEF/PE/enums.hpp"
+#include "LIEF/PE/DataDirectory.hpp"
+#include "LIEF/PE/OptionalHeader.hpp"
+
+namespace LIEF {
+namespace PE {
+
+//! This class patches fields of the PE headers **in place**: only the
+//! modified bytes (and the checksum) are written to the file or the buffer,
+//! without parsing nor rebuilding the binary.
+//!
+//! The checksum is a ones' complement sum of the 16-bit words of the file
+//! so that it is updated from the old and the new values of the patched
+//! words instead of being recomputed over the whole file. This assumes that
+//! the original checksum is correct. A checksum set to 0 is left as-is.
+//!
+//! Authenticode does not hash the checksum and the certificate table's
+//! data directory. Patching other bytes of a signed binary invalidates its
+//! signature which is reported by signature_invalidated().
+//!
+//! \code{.cpp}
+//! auto patcher = LIEF::PE::HeaderPatcher::open("program.exe");
+//! if (patcher) {
+//!   patcher->time_date_stamp(0x5f5e1000);
+//! }
+//! \endcode
+class LIEF_API HeaderPatcher {
+  public:
+  //! Patch the file at the given path
+  static result<HeaderPatcher> open(const std::string& path);
+
+  //! Patch the given buffer
+  static result<HeaderPatcher> from_buffer(span<uint8_t> buffer);
+
+  HeaderPatcher(const HeaderPatcher&) = delete;
+  HeaderPatcher& operator=(const HeaderPatcher&) = delete;
+
+  HeaderPatcher(HeaderPatcher&&) noexcept;
+  HeaderPatcher& operator=(HeaderPatcher&&) noexcept;
+
+  ~HeaderPatcher();
+
+  PE_TYPE type() const {
+    return type_;
+  }
+
+  //! Current value of the checksum
+  uint32_t checksum() const {
+    return checksum_;
+  }
+
+  //! Whether the binary has an Authenticode signature
+  bool is_signed() const {
+    return cert_size_ > 0;
+  }
+
+  //! Whether a patch modified bytes hashed by Authenticode (the signature
+  //! is no longer valid)
+  bool signature_invalidated() const {
+    return signature_invalidated_;
+  }
+
+  //! Patch Header::time_date_stamp
+  ok_error_t time_date_stamp(uint32_t value);
+
+  //! Patch OptionalHeader::subsystem
+  ok_error_t subsystem(OptionalHeader::SUBSYSTEM value);
+
+  //! Patch OptionalHeader::dll_characteristics
+  ok_error_t dll_characteristics(uint32_t value);
+
+  //! Patch the RVA and the size of the given data directory
+  ok_error_t data_directory(DataDirectory::TYPES type, uint32_t rva, uint32_t size);
+
+  //! Write the given bytes at the given file offset. The checksum field
+  //! can't be patched with this function.
+  ok_error_t patch(uint64_t offset, span<const uint8_t> data);
+
+  //! Flush the pending writes (only relevant for a file)
+  ok_error_t flush();
+
+  private:
+  HeaderPatcher();
+  ok_error_t init();
+
+  ok_error_t read(uint64_t offset, span<uint8_t> out) const;
+  ok_error_t write(uint64_t offset, span<const uint8_t> data);
+
+  template<class T>
+  ok_error_t write_field(uint64_t offset, T value) {
+    return patch(offset, {reinterpret_cast<const uint8_t*>(&value), sizeof(T)});
+  }
+
+  bool is_excluded_from_authentihash(uint64_t offset, uint64_t size) const;
+
+  span<uint8_t> buffer_;
+  std::unique_ptr<std::fstream> file_;
+  uint64_t size_ = 0;
+
+  PE_TYPE type_ = PE_TYPE::PE32;
+  uint64_t header_offset_ = 0;
+  uint64_t opt_header_offset_ = 0;
+  uint64_t data_dirs_offset_ = 0;
+  uint32_t nb_data_dirs_ = 0;
+
+  uint32_t checksum_ = 0;
+  bool update_checksum_ = false;
+
+  uint32_t cert_offset_ = 0;
+  uint32_t cert_size_ = 0;
+  bool signature_invalidated_ = false;
+};
+
+}
+}
+#endif
@@ -0,0 +1,158 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_PE_IMPORT_RESOLVER_H
+#define LIEF_PE_IMPORT_RESOLVER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "LIEF/errors.hpp"
+#include "LIEF/visibility.h"
+#include "LIEF/PE/ApiSet.hpp"
+#include "LIEF/PE/ExportResolver.hpp"
+
+namespace LIEF {
+namespace PE {
+class Binary;
+
+//! This class resolves imported functions across a set of DLLs (e.g. a
+//! ``system32`` snapshot):
+//!
+//! - API set contracts (``api-ms-win-*``, ``ext-ms-*``) are mapped to their
+//!   host DLL with the ApiSet schema.
+//! - Export forwarders are followed from DLL to DLL until the function that
+//!   implements the export is found.
+//!
+//! The resolutions are memoized so that resolving the imports of many
+//! binaries only walks each forwarder chain once. Cycles in the chains are
+//! detected.
+//!
+//! The DLLs (PE::Binary) must outlive this object.
+class LIEF_API ImportResolver {
+  public:
+  enum class STATUS {
+    RESOLVED = 0,
+    MISSING_LIBRARY,  ///< The library (or the API set host) is not in the set
+    MISSING_EXPORT,   ///< The library does not export the function
+    MISSING_API_SET,  ///< The API set contract can't be resolved
+    CYCLE,            ///< The forwarder chain loops (or is too long)
+  };
+
+  //! Result of a resolution
+  struct LIEF_API resolution_t {
+    STATUS status = STATUS::MISSING_LIBRARY;
+
+    //! Library (lower case, without ``.dll``) that implements the function
+    //! or where the resolution stopped
+    std::string library;
+
+    //! Name of the function (empty if the last hop is by ordinal and the
+    //! name is not known)
+    std::string function;
+
+    //! Ordinal of the function in the last library
+    uint32_t ordinal = 0;
+
+    //! RVA of the function in the last library
+    uint32_t rva = 0;
+
+    //! Hops followed: ``library!function`` or ``library!#ordinal``
+    std::vector<std::string> chain;
+
+    bool is_resolved() const {
+      return status == STATUS::RESOLVED;
+    }
+  };
+
+  //! Imported function resolved by resolve_imports()
+  struct LIEF_API import_t {
+    std::string library;
+    std::string function;
+    uint32_t ordinal = 0;
+    bool is_ordinal = false;
+    bool is_delayed = false;
+    resolution_t resolution;
+  };
+
+  ImportResolver() = default;
+
+  ImportResolver(const ImportResolver&) = delete;
+  ImportResolver& operator=(const ImportResolver&) = delete;
+
+  ImportResolver(ImportResolver&&) noexcept = default;
+  ImportResolver& operator=(ImportResolver&&) noexcept = default;
+
+  ~ImportResolver() = default;
+
+  //! Set the API set schema used to resolve the API set contracts
+  void apiset(ApiSet schema);
+
+  //! Add a DLL to the set. The ``name`` is the name used by the importers
+  //! (usually the file name, e.g. ``kernel32.dll``).
+  ok_error_t add(const Binary& dll, const std::string& name);
+
+  //! Add a DLL to the set, using the name stored in its export directory
+  ok_error_t add(const Binary& dll);
+
+  //! Number of DLLs in the set
+  size_t size() const {
+    return modules_.size();
+  }
+
+  //! Resolve the function exported by ``library`` under the given name.
+  //! The ``importer`` is the name of the importing module which can change
+  //! the host of an API set contract.
+  resolution_t resolve(const std::string& library, const std::string& function,
+                       const std::string& importer = "") const;
+
+  //! Resolve the function exported by ``library`` with the given ordinal
+  resolution_t resolve_ordinal(const std::string& library, uint32_t ordinal,
+                               const std::string& importer = "") const;
+
+  //! Resolve all the imports (and the delayed imports) of the given binary
+  std::vector<import_t> resolve_imports(const Binary& bin,
+                                        const std::string& name = "") const;
+
+  //! Drop the memoized resolutions
+  void clear_cache() {
+    cache_.clear();
+  }
+
+  //! Lower-case name without the ``.dll`` extension
+  static std::string normalize(const std::string& name);
+
+  private:
+  static constexpr uint32_t MAX_DEPTH = 32;
+  resolution_t resolve_impl(const std::string& library, const std::string& function,
+                            uint32_t ordinal, uint32_t hint, const std::string& importer,
+                            uint32_t depth) const;
+
+  std::unique_ptr<ApiSet> apiset_;
+  std::unordered_map<std::string, ExportResolver> modules_;
+
+  mutable std::unordered_map<std::string, resolution_t> cache_;
+  mutable std::unordered_set<std::string> visiting_;
+};
+
+LIEF_API const char* to_string(ImportResolver::STATUS e);
+
+}
+}
+#endif
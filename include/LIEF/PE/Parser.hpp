@@ -30,6 +30,7 @@
 
 namespace LIEF {
 class BinaryStream;
+class BudgetTracker;
 
 namespace PE {
 class Debug;
@@ -52,6 +53,9 @@ class LIEF_API Parser : public LIEF::Parser {
 
   static constexpr size_t MAX_TLS_CALLBACKS = 3000;
 
+  //! Number of stages reported to the ParserBudget's progress callback
+  static constexpr size_t NB_STAGES = 15;
+
   // According to https://stackoverflow.com/a/265782/87207
   static constexpr size_t MAX_DLL_NAME_SIZE = 255;
 
@@ -154,6 +158,7 @@ class LIEF_API Parser : public LIEF::Parser {
   std::set<uint32_t> resource_visited_;
   std::unique_ptr<BinaryStream> stream_;
   ParserConfig config_;
+  std::unique_ptr<BudgetTracker> budget_;
 };
 
 
@@ -16,6 +16,7 @@
 #ifndef LIEF_PE_PARSER_CONFIG_H
 #define LIEF_PE_PARSER_CONFIG_H
 #include "LIEF/visibility.h"
+#include "LIEF/Abstract/ParserBudget.hpp"
 
 namespace LIEF {
 namespace PE {
@@ -32,6 +33,7 @@ struct LIEF_API ParserConfig {
   bool parse_imports   = true; ///< Parse PE Import Directory
   bool parse_rsrc      = true; ///< Parse PE resources tree
   bool parse_reloc     = true; ///< Parse PE relocations
+  ParserBudget budget; ///< Resources (memory, time, objects) limits, cancellation and progress
 };
 
 }
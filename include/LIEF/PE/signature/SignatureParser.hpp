@@ -18,6 +18,7 @@
 #include <memory>
 #include <string>
 #include <array>
+#include <vector>
 
 #include "LIEF/errors.hpp"
 
@@ -37,8 +38,15 @@ class PKCS9TSTInfo;
 class LIEF_API SignatureParser {
   friend class Parser;
   struct SpcPeImageData {
-    uint32_t flags;
+    uint32_t flags = 0;
     std::string file;
+    ALGORITHMS page_hash_algorithm = ALGORITHMS::UNKNOWN;
+    std::vector<uint8_t> page_hashes;
+  };
+
+  struct SpcPageHashes {
+    ALGORITHMS algorithm = ALGORITHMS::UNKNOWN;
+    std::vector<uint8_t> hashes;
   };
 
   struct SpcSpOpusInfo {
@@ -93,6 +101,7 @@ class LIEF_API SignatureParser {
   static result<std::string> parse_spc_link(BinaryStream& stream);
   static result<std::unique_ptr<Attribute>> parse_spc_relaxed_pe_marker_check(BinaryStream& stream);
   static result<SpcPeImageData> parse_spc_pe_image_data(BinaryStream& stream);
+  static result<SpcPageHashes> parse_spc_serialized_object(BinaryStream& stream);
   static result<std::unique_ptr<SpcIndirectData>> parse_spc_indirect_data(BinaryStream& stream, range_t& range);
   static result<std::unique_ptr<Attribute>> parse_ms_platform_manifest_binary_id(BinaryStream& stream);
 
@@ -61,6 +61,30 @@ class LIEF_API SpcIndirectData : public ContentInfo::Content {
     return file_;
   }
 
+  //! Entry of the page hashes table (``SPC_PE_IMAGE_PAGE_HASHES``)
+  struct LIEF_API page_hash_t {
+    //! File offset of the page
+    uint32_t offset = 0;
+
+    //! Digest of the page (zero-filled for the last entry which marks the
+    //! end of the hashed data)
+    std::vector<uint8_t> digest;
+  };
+  using page_hashes_t = std::vector<page_hash_t>;
+
+  //! Algorithm used for the page hashes (ALGORITHMS::SHA_1 or ALGORITHMS::SHA_256)
+  //! or ALGORITHMS::UNKNOWN if the signature does not embed page hashes
+  ALGORITHMS page_hash_algorithm() const {
+    return page_hash_algorithm_;
+  }
+
+  //! Per-page hashes, sorted by file offset
+  //!
+  //! @see LIEF::PE::Binary::verify_page
+  const page_hashes_t& page_hashes() const {
+    return page_hashes_;
+  }
+
   void print(std::ostream& os) const override;
 
   void accept(Visitor& visitor) const override;
@@ -81,6 +105,8 @@ class LIEF_API SpcIndirectData : public ContentInfo::Content {
   uint8_t flags_ = 0;
   ALGORITHMS digest_algorithm_ = ALGORITHMS::UNKNOWN;
   std::vector<uint8_t> digest_;
+  ALGORITHMS page_hash_algorithm_ = ALGORITHMS::UNKNOWN;
+  page_hashes_t page_hashes_;
 };
 }
 }
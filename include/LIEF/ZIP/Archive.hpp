@@ -0,0 +1,155 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ZIP_ARCHIVE_H
+#define LIEF_ZIP_ARCHIVE_H
+#include <ostream>
+#include <string>
+#include <memory>
+#include <vector>
+
+#include "LIEF/visibility.h"
+#include "LIEF/errors.hpp"
+#include "LIEF/span.hpp"
+#include "LIEF/iterators.hpp"
+
+namespace LIEF {
+class Binary;
+class BinaryStream;
+
+namespace DEX {
+class File;
+}
+
+namespace ZIP {
+class Parser;
+class Entry;
+
+//! This class represents a ZIP archive (e.g. an APK or a JAR) indexed from
+//! its central directory.
+//!
+//! The archive owns the raw data once and the LIEF::ZIP::Entry objects only
+//! reference sub-ranges of this data. Stored entries are accessed without
+//! any copy while deflated entries are inflated on demand.
+//!
+//! Since the archive is not modified by the accessors, the entries can be
+//! inflated and parsed concurrently from different threads as long as each
+//! thread uses its own buffer (see: parse_all() and parse_dex_all()).
+class LIEF_API Archive {
+  friend class Parser;
+
+  public:
+  using entries_t = std::vector<std::unique_ptr<Entry>>;
+  using it_const_entries = const_ref_iterator<const entries_t&, const Entry*>;
+
+  //! Strings and types shared by the DEX files of a (multi-dex) APK
+  struct LIEF_API dex_pool_t {
+    //! Unique strings (raw MUTF-8) of all the DEX files
+    std::vector<std::string> strings;
+
+    //! Unique type descriptors as indexes in dex_pool_t::strings
+    std::vector<uint32_t> types;
+
+    //! For each DEX file, map a local string index to its index in
+    //! dex_pool_t::strings
+    std::vector<std::vector<uint32_t>> strings_map;
+
+    //! For each DEX file, map a local type index to its index in
+    //! dex_pool_t::types
+    std::vector<std::vector<uint32_t>> types_map;
+  };
+
+  Archive(const Archive&) = delete;
+  Archive& operator=(const Archive&) = delete;
+
+  //! Iterator over the entries of the central directory
+  it_const_entries entries() const {
+    return entries_;
+  }
+
+  //! Return the entry with the given name or a nullptr if not found
+  const Entry* get_entry(const std::string& name) const;
+
+  //! DEX files of the APK in the order used by the runtime
+  //! (``classes.dex``, ``classes2.dex``, ...)
+  std::vector<const Entry*> dex_files() const;
+
+  //! Native libraries (``lib/<abi>/*.so``). If ``abi`` is not empty
+  //! (e.g. ``arm64-v8a``), only the libraries of this ABI are returned.
+  std::vector<const Entry*> native_libraries(const std::string& abi = "") const;
+
+  //! Uncompressed content of the given entry.
+  //!
+  //! For a stored entry, the returned span references the archive's data and
+  //! ``buffer`` is not used. For a deflated entry, the data is inflated into
+  //! ``buffer`` which is resized (its capacity is reused) and the span
+  //! references this buffer.
+  //!
+  //! The CRC-32 is checked if ``check_crc`` is true.
+  result<span<const uint8_t>> content(const Entry& entry, std::vector<uint8_t>& buffer,
+                                      bool check_crc = true) const;
+
+  //! Uncompressed content of the given entry as a new buffer
+  result<std::vector<uint8_t>> extract(const Entry& entry, bool check_crc = true) const;
+
+  //! Stream over the uncompressed content of the given entry. It does not
+  //! copy the data of stored entries.
+  std::unique_ptr<BinaryStream> stream(const Entry& entry) const;
+
+  //! Parse the given entry with the format-specific parser (ELF, PE, Mach-O).
+  //! Stored entries (e.g. page-aligned native libraries) are parsed from a
+  //! stream that references the archive's data.
+  std::unique_ptr<Binary> parse(const Entry& entry) const;
+
+  //! Parse the given entry as a DEX file
+  std::unique_ptr<DEX::File> parse_dex(const Entry& entry) const;
+
+  //! Parse the given entries (e.g. native_libraries()) with parse() from at
+  //! most ``nb_threads`` threads (0: number of hardware threads).
+  //!
+  //! The i-th element of the result is the binary of ``entries[i]`` or a
+  //! nullptr if it can't be parsed.
+  std::vector<std::unique_ptr<Binary>>
+    parse_all(const std::vector<const Entry*>& entries, uint32_t nb_threads = 0) const;
+
+  //! Parse the given entries (e.g. dex_files()) with parse_dex() from at most
+  //! ``nb_threads`` threads (0: number of hardware threads).
+  std::vector<std::unique_ptr<DEX::File>>
+    parse_dex_all(const std::vector<const Entry*>& entries, uint32_t nb_threads = 0) const;
+
+  //! Deduplicate the strings and the type descriptors of all the DEX files
+  //! of the APK (see: dex_files()). The DEX files do not need to be parsed
+  //! and a single buffer is used to inflate them.
+  result<dex_pool_t> dex_pool() const;
+
+  //! Raw data of the archive
+  const std::vector<uint8_t>& raw() const {
+    return data_;
+  }
+
+  LIEF_API friend std::ostream& operator<<(std::ostream& os, const Archive& zip);
+
+  ~Archive();
+
+  private:
+  Archive();
+
+  std::vector<uint8_t> data_;
+  entries_t entries_;
+};
+
+}
+}
+#endif
@@ -0,0 +1,138 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ZIP_ENTRY_H
+#define LIEF_ZIP_ENTRY_H
+#include <ostream>
+#include <string>
+#include <cstdint>
+
+#include "LIEF/visibility.h"
+#include "LIEF/span.hpp"
+
+namespace LIEF {
+namespace ZIP {
+class Parser;
+
+//! This class represents an entry (i.e. a file) of a ZIP archive, as
+//! described by the central directory.
+//!
+//! The entry does not own its data: it references the (compressed) bytes
+//! owned by the LIEF::ZIP::Archive.
+class LIEF_API Entry {
+  friend class Parser;
+
+  public:
+  //! Compression method
+  enum class METHOD : uint16_t {
+    STORED   = 0,
+    DEFLATED = 8,
+  };
+
+  Entry() = default;
+  Entry(const Entry&) = delete;
+  Entry& operator=(const Entry&) = delete;
+
+  //! Full path of the entry (e.g. ``lib/arm64-v8a/libfoo.so``)
+  const std::string& name() const {
+    return name_;
+  }
+
+  //! Compression method. Other values than METHOD::STORED and
+  //! METHOD::DEFLATED are not supported.
+  METHOD method() const {
+    return method_;
+  }
+
+  //! General purpose flags
+  uint16_t flags() const {
+    return flags_;
+  }
+
+  //! CRC-32 of the uncompressed data
+  uint32_t crc32() const {
+    return crc32_;
+  }
+
+  //! Size of the uncompressed data
+  uint64_t size() const {
+    return size_;
+  }
+
+  //! Size of the data as stored in the archive
+  uint64_t compressed_size() const {
+    return raw_.size();
+  }
+
+  //! Offset of the local header in the archive
+  uint64_t offset() const {
+    return offset_;
+  }
+
+  //! Offset of the (compressed) data in the archive
+  uint64_t data_offset() const {
+    return data_offset_;
+  }
+
+  //! Data as stored in the archive (i.e. compressed for deflated entries)
+  span<const uint8_t> raw_content() const {
+    return raw_;
+  }
+
+  bool is_stored() const {
+    return method_ == METHOD::STORED;
+  }
+
+  bool is_directory() const {
+    return !name_.empty() && name_.back() == '/';
+  }
+
+  bool is_encrypted() const;
+
+  //! Whether the entry is stored uncompressed at an offset aligned on the
+  //! given page size. This is the layout that Android uses for the native
+  //! libraries so that they can be mapped from the APK
+  //! (``android:extractNativeLibs="false"``).
+  bool is_page_aligned(uint64_t page_size = 0x1000) const {
+    return is_stored() && page_size > 0 && (data_offset_ % page_size) == 0;
+  }
+
+  //! Whether the entry is a DEX file of an APK
+  //! (``classes.dex``, ``classes2.dex``, ...)
+  bool is_dex() const;
+
+  //! Whether the entry is a native library of an APK (``lib/<abi>/*.so``)
+  bool is_native_library() const;
+
+  LIEF_API friend std::ostream& operator<<(std::ostream& os, const Entry& entry);
+
+  ~Entry();
+
+  private:
+  std::string name_;
+  METHOD method_ = METHOD::STORED;
+  uint16_t flags_ = 0;
+  uint32_t crc32_ = 0;
+  uint64_t size_ = 0;
+  uint64_t offset_ = 0;
+  uint64_t data_offset_ = 0;
+  span<const uint8_t> raw_;
+};
+
+LIEF_API const char* to_string(Entry::METHOD e);
+
+}
+}
+#endif
@@ -0,0 +1,67 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ZIP_PARSER_H
+#define LIEF_ZIP_PARSER_H
+#include <string>
+#include <memory>
+#include <vector>
+
+#include "LIEF/visibility.h"
+#include "LIEF/errors.hpp"
+
+namespace LIEF {
+class SpanStream;
+namespace ZIP {
+class Archive;
+class Entry;
+
+//! Class that parses a ZIP archive (``.zip``, ``.apk``, ``.jar``, ...)
+//! into a LIEF::ZIP::Archive.
+//!
+//! The parser only reads the central directory and the local headers: the
+//! entries are inflated and parsed on demand through LIEF::ZIP::Archive.
+class LIEF_API Parser {
+  public:
+  static std::unique_ptr<Archive> parse(const std::string& file);
+  static std::unique_ptr<Archive> parse(std::vector<uint8_t> data);
+
+  Parser& operator=(const Parser& copy) = delete;
+  Parser(const Parser& copy)            = delete;
+
+  private:
+  Parser(std::unique_ptr<Archive> archive);
+  ~Parser();
+
+  struct cd_info_t {
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    uint64_t nb_entries = 0;
+  };
+
+  result<cd_info_t> parse_eocd();
+  ok_error_t parse_central_directory(const cd_info_t& info);
+  ok_error_t parse_local_header(Entry& entry, uint64_t compressed_size);
+
+  std::unique_ptr<Archive> archive_;
+  std::unique_ptr<SpanStream> stream_;
+
+  // Size of the data prepended to the archive
+  uint64_t bias_ = 0;
+};
+
+}
+}
+#endif
@@ -0,0 +1,44 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ZIP_UTILS_H
+#define LIEF_ZIP_UTILS_H
+#include <string>
+#include <vector>
+
+#include "LIEF/visibility.h"
+#include "LIEF/types.hpp"
+#include "LIEF/span.hpp"
+
+namespace LIEF {
+class BinaryStream;
+namespace ZIP {
+
+//! Check if the given stream wraps a ZIP archive (``PK\3\4`` or an empty
+//! archive)
+LIEF_API bool is_zip(BinaryStream& stream);
+
+//! Check if the given file is a ZIP archive
+LIEF_API bool is_zip(const std::string& file);
+
+//! Check if the given raw data is a ZIP archive
+LIEF_API bool is_zip(const std::vector<uint8_t>& raw);
+
+//! CRC-32 (ISO-HDLC) as used by ZIP and GZIP
+LIEF_API uint32_t crc32(span<const uint8_t> data, uint32_t crc = 0);
+
+}
+}
+#endif
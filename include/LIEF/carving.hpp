@@ -0,0 +1,148 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_CARVING_H
+#define LIEF_CARVING_H
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "LIEF/visibility.h"
+#include "LIEF/span.hpp"
+
+namespace LIEF {
+class Binary;
+class SpanStream;
+
+//! This namespace exposes functions to locate executable formats embedded
+//! in a raw blob of data (firmware image, memory dump, disk extent, ...)
+namespace carving {
+
+enum class FORMAT {
+  UNKNOWN = 0,
+  ELF,
+  PE,
+  MACHO,
+  MACHO_FAT,
+  DEX,
+};
+
+//! Level of confidence for a carved candidate
+enum class CONFIDENCE {
+  //! Only the magic and a few header fields are consistent
+  LOW = 0,
+  //! The header is consistent but the layout tables are truncated by the
+  //! end of the blob
+  MEDIUM,
+  //! The header and the layout tables (segments, sections, load commands, ...)
+  //! are consistent and fit in the blob
+  HIGH,
+};
+
+//! Configuration of the scan
+struct config_t {
+  //! Only consider the offsets that are a multiple of this value.
+  //! For instance, firmware images usually align their components on
+  //! a page boundary.
+  uint32_t alignment = 1;
+
+  //! Report candidates that are located within the extent of another
+  //! candidate (e.g. a PE in the resources of another PE or the slices
+  //! of a FAT Mach-O)
+  bool nested = false;
+
+  //! Minimum confidence of the reported candidates
+  CONFIDENCE min_confidence = CONFIDENCE::MEDIUM;
+};
+
+//! An embedded binary found in the blob
+class LIEF_API Candidate {
+  public:
+  Candidate() = default;
+  Candidate(FORMAT fmt, CONFIDENCE conf, uint64_t offset,
+            span<const uint8_t> content) :
+    format_(fmt),
+    confidence_(conf),
+    offset_(offset),
+    content_(content)
+  {}
+
+  FORMAT format() const {
+    return format_;
+  }
+
+  CONFIDENCE confidence() const {
+    return confidence_;
+  }
+
+  //! Offset of the candidate in the scanned blob
+  uint64_t offset() const {
+    return offset_;
+  }
+
+  //! Size of the candidate as computed from its layout tables.
+  //! The size is bounded by the end of the blob.
+  uint64_t size() const {
+    return content_.size();
+  }
+
+  //! Raw content of the candidate. This is a view on the scanned blob
+  //! which must outlive this object.
+  span<const uint8_t> content() const {
+    return content_;
+  }
+
+  //! Create a stream on the content of the candidate without copying data
+  std::unique_ptr<SpanStream> stream() const;
+
+  //! Parse the candidate with the parser associated with its format.
+  //!
+  //! It returns a nullptr for the formats that are not represented by
+  //! a LIEF::Binary (i.e. DEX) or if the parsing failed.
+  std::unique_ptr<Binary> parse() const;
+
+  LIEF_API friend std::ostream& operator<<(std::ostream& os, const Candidate& C);
+
+  private:
+  FORMAT format_ = FORMAT::UNKNOWN;
+  CONFIDENCE confidence_ = CONFIDENCE::LOW;
+  uint64_t offset_ = 0;
+  span<const uint8_t> content_;
+};
+
+//! Scan the given blob and return the embedded binaries sorted by offset.
+//!
+//! Candidates are first located with their magic and then validated by
+//! only reading their headers and layout tables (bounded by the blob) so that
+//! the scan does not depend on the size of the embedded binaries.
+LIEF_API std::vector<Candidate> scan(span<const uint8_t> blob,
+                                     const config_t& config = config_t());
+
+//! Parse the given candidates (e.g. the result of scan()) from at most
+//! ``nb_threads`` threads (0: number of hardware threads). Each candidate is
+//! parsed from its own stream over the blob.
+//!
+//! The i-th element of the result is the binary of ``candidates[i]`` or a
+//! nullptr if it can't be parsed (see: Candidate::parse()).
+LIEF_API std::vector<std::unique_ptr<Binary>>
+  parse(const std::vector<Candidate>& candidates, uint32_t nb_threads = 0);
+
+LIEF_API const char* to_string(FORMAT e);
+LIEF_API const char* to_string(CONFIDENCE e);
+
+}
+}
+#endif
@@ -0,0 +1,196 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_CHECKSEC_H
+#define LIEF_CHECKSEC_H
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "LIEF/visibility.h"
+#include "LIEF/errors.hpp"
+#include "LIEF/enums.hpp"
+#include "LIEF/span.hpp"
+
+namespace LIEF {
+class BinaryStream;
+
+//! This namespace exposes a hardening audit (à la ``checksec``) of ELF, PE
+//! and Mach-O binaries.
+//!
+//! Contrary to LIEF::Parser::parse(), the audit does not build a LIEF::Binary:
+//! it only reads the headers and the tables needed to check the properties
+//! (program headers and dynamic table for ELF, load configuration and
+//! debug directory for PE, load commands and code signature for Mach-O).
+//! The imports are looked up in the dynamic symbol table through the
+//! on-disk hash tables (ELF) or the undefined-symbols range of the symbol
+//! table (Mach-O).
+namespace checksec {
+
+enum class FORMAT {
+  UNKNOWN = 0,
+  ELF,
+  PE,
+  MACHO,
+};
+
+//! Hardening properties. A property only makes sense for some formats
+//! (see report_t::checked)
+enum class PROPERTY : uint32_t {
+  NONE = 0,
+
+  //! Position-independent executable (ELF: ``ET_DYN`` with an interpreter
+  //! or ``DF_1_PIE``, PE: ``DYNAMIC_BASE``, Mach-O: ``MH_PIE``)
+  PIE = 1 << 0,
+
+  //! Non-executable stack (ELF: ``PT_GNU_STACK``, PE: ``NX_COMPAT``,
+  //! Mach-O: no ``MH_ALLOW_STACK_EXECUTION``)
+  NX = 1 << 1,
+
+  //! Stack protector (ELF, Mach-O: ``__stack_chk_fail`` is imported,
+  //! PE: ``/GS`` security cookie in the load configuration)
+  CANARY = 1 << 2,
+
+  //! At least one ``__*_chk`` function is imported (ELF, Mach-O)
+  FORTIFY = 1 << 3,
+
+  //! ELF: ``PT_GNU_RELRO``
+  RELRO = 1 << 4,
+
+  //! ELF: the relocations are processed at load time (``DF_BIND_NOW``,
+  //! ``DF_1_NOW``, ``DT_BIND_NOW``). RELRO with BIND_NOW is *full RELRO*
+  BIND_NOW = 1 << 5,
+
+  //! ELF: ``DT_RPATH``
+  RPATH = 1 << 6,
+
+  //! ELF: ``DT_RUNPATH``
+  RUNPATH = 1 << 7,
+
+  //! Indirect branch tracking (ELF: x86 CET ``IBT`` or AArch64 ``BTI``
+  //! GNU property)
+  IBT = 1 << 8,
+
+  //! Shadow stack (ELF: x86 CET ``SHSTK`` GNU property, PE: ``CET_COMPAT``
+  //! extended DLL characteristic)
+  SHSTK = 1 << 9,
+
+  //! ELF: AArch64 ``PAC`` GNU property
+  PAC = 1 << 10,
+
+  //! PE: ``HIGH_ENTROPY_VA``
+  HIGH_ENTROPY_VA = 1 << 11,
+
+  //! PE: ``FORCE_INTEGRITY``
+  FORCE_INTEGRITY = 1 << 12,
+
+  //! PE: ``NO_SEH``
+  NO_SEH = 1 << 13,
+
+  //! PE (x86 only): the load configuration registers a SafeSEH handler table
+  SAFESEH = 1 << 14,
+
+  //! PE: Control Flow Guard (``GUARD_CF`` with instrumented code)
+  CFG = 1 << 15,
+
+  //! PE: eXtended Flow Guard
+  XFG = 1 << 16,
+
+  //! PE: ``APPCONTAINER``
+  APPCONTAINER = 1 << 17,
+
+  //! PE: Authenticode signature, Mach-O: ``LC_CODE_SIGNATURE``
+  SIGNED = 1 << 18,
+
+  //! Mach-O: ``MH_NO_HEAP_EXECUTION``
+  NX_HEAP = 1 << 19,
+
+  //! Mach-O: ``__RESTRICT`` segment or ``CS_RESTRICT`` code signing flag
+  RESTRICT = 1 << 20,
+
+  //! Mach-O: hardened runtime (``CS_RUNTIME``)
+  HARDENED_RUNTIME = 1 << 21,
+
+  //! Mach-O: library validation (``CS_REQUIRE_LV``)
+  LIBRARY_VALIDATION = 1 << 22,
+
+  //! Mach-O: ``LC_ENCRYPTION_INFO`` with a non-null ``cryptid``
+  ENCRYPTED = 1 << 23,
+};
+
+//! Hardening report of a binary
+struct LIEF_API report_t {
+  FORMAT format = FORMAT::UNKNOWN;
+
+  //! Properties that are enabled
+  PROPERTY properties = PROPERTY::NONE;
+
+  //! Properties that have been checked. A property which is not set in
+  //! properties but which is set in this mask is disabled. Otherwise, it
+  //! does not apply to the format or it could not be determined (e.g. the
+  //! stack canary of a statically-linked ELF binary).
+  PROPERTY checked = PROPERTY::NONE;
+
+  //! Number of slices audited (greater than 1 for a FAT Mach-O). For a FAT
+  //! Mach-O, a property is enabled (or checked) if it is enabled (or checked)
+  //! in all the slices.
+  uint32_t nb_slices = 0;
+
+  bool has(PROPERTY p) const {
+    return (static_cast<uint32_t>(properties) & static_cast<uint32_t>(p)) ==
+           static_cast<uint32_t>(p);
+  }
+
+  bool is_checked(PROPERTY p) const {
+    return (static_cast<uint32_t>(checked) & static_cast<uint32_t>(p)) ==
+           static_cast<uint32_t>(p);
+  }
+
+  //! ELF: RELRO + BIND_NOW
+  bool full_relro() const {
+    return has(PROPERTY::RELRO) && has(PROPERTY::BIND_NOW);
+  }
+
+  //! Print the format followed by the checked properties (prefixed with
+  //! ``!`` when they are disabled)
+  LIEF_API friend std::ostream& operator<<(std::ostream& os, const report_t& R);
+};
+
+//! Audit the binary read from the given stream
+LIEF_API result<report_t> audit(BinaryStream& stream);
+
+//! Audit the binary located at the given path. Only the blocks of the file
+//! that contain the headers and the tables needed by the audit are read.
+LIEF_API result<report_t> audit(const std::string& path);
+
+//! Audit the binary in the given buffer
+LIEF_API result<report_t> audit(span<const uint8_t> raw);
+
+//! Audit the files located at the given paths from at most ``nb_threads``
+//! threads (0: number of hardware threads). The i-th element is the report
+//! (or the error) of the i-th path.
+LIEF_API std::vector<result<report_t>>
+  audit(const std::vector<std::string>& paths, uint32_t nb_threads = 0);
+
+LIEF_API const char* to_string(FORMAT e);
+LIEF_API const char* to_string(PROPERTY e);
+
+}
+}
+
+ENABLE_BITMASK_OPERATORS(LIEF::checksec::PROPERTY)
+
+#endif
@@ -0,0 +1,93 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+
+#include "logging.hpp"
+#include "frozen.hpp"
+#include "parallel.hpp"
+
+#include "LIEF/AR/Archive.hpp"
+#include "LIEF/AR/Member.hpp"
+#include "LIEF/Abstract/Parser.hpp"
+#include "LIEF/Abstract/Binary.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
+
+namespace LIEF {
+namespace AR {
+
+Archive::Archive() = default;
+Archive::~Archive() = default;
+
+const Member* Archive::get_member(const std::string& name) const {
+  const auto it = std::find_if(members_.begin(), members_.end(),
+      [&name] (const std::unique_ptr<Member>& m) {
+        return m->name() == name;
+      });
+  return it != members_.end() ? it->get() : nullptr;
+}
+
+std::unique_ptr<Binary> Archive::parse(const Member& member) const {
+  if (member.format() == Binary::FORMATS::UNKNOWN) {
+    LIEF_DEBUG("Member '{}' is not supported by LIEF", member.name());
+    return nullptr;
+  }
+  return LIEF::Parser::parse(member.stream());
+}
+
+std::vector<std::unique_ptr<Binary>> Archive::parse(uint32_t nb_threads) const {
+  std::vector<std::unique_ptr<Binary>> parsed(members_.size());
+  parallel_for(members_.size(), nb_threads, [&] (size_t i) {
+    parsed[i] = parse(*members_[i]);
+  });
+
+  std::vector<std::unique_ptr<Binary>> binaries;
+  binaries.reserve(parsed.size());
+  for (std::unique_ptr<Binary>& bin : parsed) {
+    if (bin != nullptr) {
+      binaries.push_back(std::move(bin));
+    }
+  }
+  return binaries;
+}
+
+std::ostream& operator<<(std::ostream& os, const Archive& ar) {
+  os << "Kind: " << to_string(ar.kind()) << '\n'
+     << "Members (" << ar.members_.size() << "):\n";
+  for (const Member& member : ar.members()) {
+    os << "  " << member << '\n';
+  }
+  os << "Symbols: " << ar.symbols().size() << '\n';
+  return os;
+}
+
+const char* to_string(Archive::KIND e) {
+  #define ENTRY(X) std::pair(Archive::KIND::X, #X)
+  STRING_MAP enums2str {
+    ENTRY(UNKNOWN),
+    ENTRY(GNU),
+    ENTRY(BSD),
+    ENTRY(COFF),
+  };
+  #undef ENTRY
+
+  if (auto it = enums2str.find(e); it != enums2str.end()) {
+    return it->second;
+  }
+  return "UNKNOWN";
+}
+
+}
+}
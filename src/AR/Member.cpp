@@ -0,0 +1,73 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <spdlog/fmt/fmt.h>
+
+#include "LIEF/config.h"
+#include "LIEF/AR/Member.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
+
+#if defined(LIEF_ELF_SUPPORT)
+#include "LIEF/ELF/utils.hpp"
+#endif
+
+#if defined(LIEF_PE_SUPPORT)
+#include "LIEF/PE/utils.hpp"
+#endif
+
+#if defined(LIEF_MACHO_SUPPORT)
+#include "LIEF/MachO/utils.hpp"
+#endif
+
+namespace LIEF {
+namespace AR {
+
+Member::~Member() = default;
+
+std::unique_ptr<SpanStream> Member::stream() const {
+  return std::make_unique<SpanStream>(content_);
+}
+
+Binary::FORMATS Member::format() const {
+  SpanStream strm(content_);
+#if defined(LIEF_ELF_SUPPORT)
+  if (ELF::is_elf(strm)) {
+    return Binary::FORMATS::ELF;
+  }
+#endif
+
+#if defined(LIEF_PE_SUPPORT)
+  if (PE::is_pe(strm)) {
+    return Binary::FORMATS::PE;
+  }
+#endif
+
+#if defined(LIEF_MACHO_SUPPORT)
+  if (MachO::is_macho(strm)) {
+    return Binary::FORMATS::MACHO;
+  }
+#endif
+  return Binary::FORMATS::UNKNOWN;
+}
+
+std::ostream& operator<<(std::ostream& os, const Member& member) {
+  os << fmt::format("{:20} offset=0x{:08x} size=0x{:06x} mode={:o} uid={} gid={}",
+                    member.name(), member.offset(), member.size(), member.mode(),
+                    member.uid(), member.gid());
+  return os;
+}
+
+}
+}
@@ -0,0 +1,470 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include "logging.hpp"
+
+#include "LIEF/AR/Parser.hpp"
+#include "LIEF/AR/Archive.hpp"
+#include "LIEF/AR/Member.hpp"
+#include "LIEF/AR/utils.hpp"
+
+#include "LIEF/BinaryStream/SpanStream.hpp"
+#include "LIEF/BinaryStream/VectorStream.hpp"
+
+#include "AR/Structures.hpp"
+
+namespace LIEF {
+namespace AR {
+
+namespace {
+// Fields of ar_hdr are ASCII numbers padded with spaces
+template<size_t N>
+uint64_t parse_number(const char (&field)[N], int base = 10) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < N; ++i) {
+    const char c = field[i];
+    if (c < '0' || c >= ('0' + base)) {
+      break;
+    }
+    value = value * base + (c - '0');
+  }
+  return value;
+}
+
+template<size_t N>
+std::string trim_name(const char (&field)[N]) {
+  std::string name(field, N);
+  name.erase(name.find_last_not_of(' ') + 1);
+  return name;
+}
+
+inline bool starts_with(const std::string& str, const char* prefix) {
+  return str.rfind(prefix, 0) == 0;
+}
+
+inline bool is_bsd_symdef(const std::string& name) {
+  return starts_with(name, details::BSD_SYMDEF);
+}
+}
+
+Parser::Parser(std::unique_ptr<Archive> archive) :
+  archive_{std::move(archive)},
+  stream_{std::make_unique<SpanStream>(archive_->data_)}
+{}
+
+Parser::~Parser() = default;
+
+std::unique_ptr<Archive> Parser::parse(const std::string& file) {
+  auto stream = VectorStream::from_file(file);
+  if (!stream) {
+    LIEF_ERR("Can't read '{}'", file);
+    return nullptr;
+  }
+  return parse(stream->move_content());
+}
+
+std::unique_ptr<Archive> Parser::parse(std::vector<uint8_t> data) {
+  {
+    SpanStream strm(data);
+    if (!is_archive(strm)) {
+      if (strm.size() >= details::AR_THIN_MAGIC.size() &&
+          std::equal(details::AR_THIN_MAGIC.begin(), details::AR_THIN_MAGIC.end(),
+                     data.begin()))
+      {
+        LIEF_ERR("Thin archives are not supported");
+      } else {
+        LIEF_ERR("The input is not an archive");
+      }
+      return nullptr;
+    }
+  }
+
+  std::unique_ptr<Archive> archive(new Archive{});
+  archive->data_ = std::move(data);
+
+  Parser parser{std::move(archive)};
+  if (!parser.parse_members()) {
+    LIEF_WARN("The archive is likely corrupted");
+  }
+  return std::move(parser.archive_);
+}
+
+ok_error_t Parser::resolve_name(Member& member, const std::string& raw_name) {
+  // BSD long name: "#1/<length>", name stored at the beginning of the data
+  if (starts_with(raw_name, details::BSD_LONG_NAME_PREFIX)) {
+    const std::string len_str = raw_name.substr(sizeof(details::BSD_LONG_NAME_PREFIX) - 1);
+    const uint64_t len = std::strtoull(len_str.c_str(), nullptr, 10);
+    if (len > member.content_.size()) {
+      LIEF_ERR("BSD name length ({}) exceeds member size", len);
+      return make_error_code(lief_errors::corrupted);
+    }
+    auto raw = member.content_.first(len);
+    const auto it_end = std::find(raw.begin(), raw.end(), '\0');
+    member.name_ = std::string(raw.begin(), it_end);
+    member.content_ = member.content_.subspan(len);
+    member.data_offset_ += len;
+    return ok();
+  }
+
+  // GNU/COFF long name: "/<offset>" in the "//" member
+  if (raw_name.size() > 1 && raw_name[0] == '/' &&
+      std::isdigit(static_cast<unsigned char>(raw_name[1])))
+  {
+    if (long_names_ == nullptr) {
+      LIEF_ERR("Missing long names table for '{}'", raw_name);
+      member.name_ = raw_name;
+      return make_error_code(lief_errors::corrupted);
+    }
+    const uint64_t offset = std::strtoull(raw_name.c_str() + 1, nullptr, 10);
+    span<const uint8_t> table = long_names_->content();
+    if (offset >= table.size()) {
+      LIEF_ERR("Long name offset out of bound: {}", offset);
+      member.name_ = raw_name;
+      return make_error_code(lief_errors::corrupted);
+    }
+    auto raw = table.subspan(offset);
+    // GNU names end with "/\n" while COFF names end with '\0'
+    const auto it_end = std::find_if(raw.begin(), raw.end(),
+        [] (uint8_t c) { return c == '\n' || c == '\0'; });
+    std::string name(raw.begin(), it_end);
+    if (!name.empty() && name.back() == '/') {
+      name.pop_back();
+    }
+    member.name_ = std::move(name);
+    return ok();
+  }
+
+  // Short GNU names end with a '/'
+  std::string name = raw_name;
+  if (name.size() > 1 && name.back() == '/') {
+    name.pop_back();
+  }
+  member.name_ = std::move(name);
+  return ok();
+}
+
+ok_error_t Parser::parse_members() {
+  std::vector<uint8_t>& data = archive_->data_;
+  const span<const uint8_t> content = data;
+  uint64_t offset = details::AR_MAGIC.size();
+
+  size_t nb_linker_members = 0;
+  const Member* coff_symtab = nullptr;
+  const Member* sysv_symtab = nullptr;
+  const Member* sysv_symtab64 = nullptr;
+  const Member* bsd_symtab = nullptr;
+  bool is_bsd_symtab64 = false;
+
+  // Special members are not exposed by the archive, but they must
+  // outlive the parsing of the symbol tables
+  std::vector<std::unique_ptr<Member>> special_members;
+
+  while (offset + sizeof(details::ar_hdr) <= content.size()) {
+    auto res_hdr = stream_->peek<details::ar_hdr>(offset);
+    if (!res_hdr) {
+      break;
+    }
+    const details::ar_hdr& hdr = *res_hdr;
+    if (!std::equal(std::begin(hdr.fmag), std::end(hdr.fmag), details::AR_FMAG.begin())) {
+      LIEF_ERR("Wrong member's magic at offset 0x{:x}", offset);
+      return make_error_code(lief_errors::corrupted);
+    }
+
+    const uint64_t data_offset = offset + sizeof(details::ar_hdr);
+    const uint64_t size = parse_number(hdr.size);
+    if (data_offset + size > content.size()) {
+      LIEF_ERR("Member at 0x{:x} is truncated (size: 0x{:x})", offset, size);
+      return make_error_code(lief_errors::corrupted);
+    }
+
+    auto member = std::make_unique<Member>();
+    member->date_        = parse_number(hdr.date);
+    member->uid_         = parse_number(hdr.uid);
+    member->gid_         = parse_number(hdr.gid);
+    member->mode_        = parse_number(hdr.mode, /*base=*/8);
+    member->offset_      = offset;
+    member->data_offset_ = data_offset;
+    member->content_     = content.subspan(data_offset, size);
+
+    // Members are aligned on 2 bytes
+    offset = data_offset + size + (size & 1);
+
+    const std::string raw_name = trim_name(hdr.name);
+
+    if (raw_name == details::SYMTAB_NAME) {
+      // GNU: only one "/" member. COFF: a second "/" linker member follows
+      // the first one with a little-endian, sorted, table.
+      if (nb_linker_members++ == 0) {
+        sysv_symtab = member.get();
+        archive_->kind_ = Archive::KIND::GNU;
+      } else {
+        coff_symtab = member.get();
+        archive_->kind_ = Archive::KIND::COFF;
+      }
+      special_members.push_back(std::move(member));
+      continue;
+    }
+
+    if (raw_name == details::SYMTAB64_NAME) {
+      sysv_symtab64 = member.get();
+      archive_->kind_ = Archive::KIND::GNU;
+      special_members.push_back(std::move(member));
+      continue;
+    }
+
+    if (raw_name == details::LONG_NAMES) {
+      long_names_ = member.get();
+      if (archive_->kind_ == Archive::KIND::UNKNOWN) {
+        archive_->kind_ = Archive::KIND::GNU;
+      }
+      special_members.push_back(std::move(member));
+      continue;
+    }
+
+    if (raw_name == details::EC_SYMTAB_NAME) {
+      special_members.push_back(std::move(member));
+      continue;
+    }
+
+    resolve_name(*member, raw_name);
+
+    if (is_bsd_symdef(member->name())) {
+      archive_->kind_ = Archive::KIND::BSD;
+      is_bsd_symtab64 = starts_with(member->name(), details::BSD_SYMDEF_64);
+      bsd_symtab = member.get();
+      special_members.push_back(std::move(member));
+      continue;
+    }
+
+    if (archive_->kind_ == Archive::KIND::UNKNOWN &&
+        starts_with(raw_name, details::BSD_LONG_NAME_PREFIX))
+    {
+      archive_->kind_ = Archive::KIND::BSD;
+    }
+    members_offset_[member->offset()] = member.get();
+    archive_->members_.push_back(std::move(member));
+  }
+
+  // The COFF (MSVC) linker member is preferred as it is sorted and
+  // does not require big-endian conversions
+  if (coff_symtab != nullptr) {
+    parse_coff_symtab(*coff_symtab);
+  } else if (sysv_symtab64 != nullptr) {
+    parse_sysv_symtab(*sysv_symtab64, /*is64=*/true);
+  } else if (sysv_symtab != nullptr) {
+    parse_sysv_symtab(*sysv_symtab, /*is64=*/false);
+  } else if (bsd_symtab != nullptr) {
+    parse_bsd_symtab(*bsd_symtab, is_bsd_symtab64);
+  }
+
+  archive_->symbols_.reserve(symbols_.size());
+  for (auto& [name, hdr_offset] : symbols_) {
+    auto it = members_offset_.find(hdr_offset);
+    if (it == members_offset_.end()) {
+      LIEF_DEBUG("Can't find the member at 0x{:x} for the symbol '{}'", hdr_offset, name);
+      continue;
+    }
+    // emplace() keeps the first definition
+    archive_->symbols_.emplace(std::move(name), it->second);
+  }
+
+  // The long names table is only needed during the parsing
+  long_names_ = nullptr;
+  return ok();
+}
+
+void Parser::add_symbol(std::string name, uint64_t hdr_offset) {
+  symbols_.emplace_back(std::move(name), hdr_offset);
+}
+
+ok_error_t Parser::parse_sysv_symtab(const Member& member, bool is64) {
+  // Format: nb_symbols | offsets[nb_symbols] | names (null-terminated)
+  // The integers are big-endian and encoded on 4 or 8 bytes
+  SpanStream stream(member.content());
+  stream.set_endian_swap(true);
+  const size_t int_size = is64 ? sizeof(uint64_t) : sizeof(uint32_t);
+
+  auto read_int = [&stream, is64] () -> result<uint64_t> {
+    if (is64) {
+      return stream.read_conv<uint64_t>();
+    }
+    if (auto res = stream.read_conv<uint32_t>()) {
+      return *res;
+    }
+    return make_error_code(lief_errors::read_error);
+  };
+
+  auto res_nb = read_int();
+  if (!res_nb) {
+    return make_error_code(lief_errors::read_error);
+  }
+  const uint64_t nb_symbols = *res_nb;
+  if (nb_symbols > stream.size() / int_size) {
+    LIEF_ERR("Corrupted symbol table (#symbols: {})", nb_symbols);
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  std::vector<uint64_t> offsets;
+  offsets.reserve(nb_symbols);
+  for (size_t i = 0; i < nb_symbols; ++i) {
+    auto res_off = read_int();
+    if (!res_off) {
+      return make_error_code(lief_errors::read_error);
+    }
+    offsets.push_back(*res_off);
+  }
+
+  symbols_.reserve(nb_symbols);
+  for (size_t i = 0; i < nb_symbols; ++i) {
+    auto res_name = stream.read_string();
+    if (!res_name) {
+      LIEF_ERR("Can't read symbol name #{}", i);
+      return make_error_code(lief_errors::read_error);
+    }
+    add_symbol(std::move(*res_name), offsets[i]);
+  }
+  return ok();
+}
+
+ok_error_t Parser::parse_coff_symtab(const Member& member) {
+  // Format: nb_members | offsets[nb_members] | nb_symbols |
+  //         indices[nb_symbols] (uint16_t, 1-based) | names
+  SpanStream stream(member.content());
+
+  auto res_nb_members = stream.read<uint32_t>();
+  if (!res_nb_members) {
+    return make_error_code(lief_errors::read_error);
+  }
+  const uint32_t nb_members = *res_nb_members;
+  if (uint64_t(nb_members) * sizeof(uint32_t) > stream.size()) {
+    LIEF_ERR("Corrupted COFF linker member (#members: {})", nb_members);
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  const auto* offsets = stream.read_array<uint32_t>(nb_members);
+  if (offsets == nullptr && nb_members > 0) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  auto res_nb_symbols = stream.read<uint32_t>();
+  if (!res_nb_symbols) {
+    return make_error_code(lief_errors::read_error);
+  }
+  const uint32_t nb_symbols = *res_nb_symbols;
+  if (uint64_t(nb_symbols) * sizeof(uint16_t) > stream.size()) {
+    LIEF_ERR("Corrupted COFF linker member (#symbols: {})", nb_symbols);
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  const auto* indices = stream.read_array<uint16_t>(nb_symbols);
+  if (indices == nullptr && nb_symbols > 0) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  symbols_.reserve(nb_symbols);
+  for (size_t i = 0; i < nb_symbols; ++i) {
+    auto res_name = stream.read_string();
+    if (!res_name) {
+      LIEF_ERR("Can't read symbol name #{}", i);
+      return make_error_code(lief_errors::read_error);
+    }
+    const uint16_t idx = indices[i];
+    if (idx == 0 || idx > nb_members) {
+      LIEF_DEBUG("Wrong member index ({}) for '{}'", idx, *res_name);
+      continue;
+    }
+    add_symbol(std::move(*res_name), offsets[idx - 1]);
+  }
+  return ok();
+}
+
+ok_error_t Parser::parse_bsd_symtab(const Member& member, bool is64) {
+  // Format: ranlib_size | ranlib[] | strtab_size | strtab
+  // The integers are encoded with the endianness of the producer
+  SpanStream stream(member.content());
+  const size_t int_size = is64 ? sizeof(uint64_t) : sizeof(uint32_t);
+
+  auto read_int = [&stream, is64] () -> result<uint64_t> {
+    if (is64) {
+      return stream.read_conv<uint64_t>();
+    }
+    if (auto res = stream.read_conv<uint32_t>()) {
+      return *res;
+    }
+    return make_error_code(lief_errors::read_error);
+  };
+
+  auto res_ranlib_size = read_int();
+  if (!res_ranlib_size) {
+    return make_error_code(lief_errors::read_error);
+  }
+  uint64_t ranlib_size = *res_ranlib_size;
+  if (ranlib_size > stream.size()) {
+    // Try big-endian
+    stream.set_endian_swap(true);
+    stream.setpos(0);
+    ranlib_size = read_int().value_or(0);
+    if (ranlib_size > stream.size()) {
+      LIEF_ERR("Corrupted __.SYMDEF (ranlib size: 0x{:x})", ranlib_size);
+      return make_error_code(lief_errors::corrupted);
+    }
+  }
+
+  const uint64_t ranlib_start = stream.pos();
+  const uint64_t nb_ranlibs = ranlib_size / (2 * int_size);
+  stream.increment_pos(ranlib_size);
+
+  auto res_strtab_size = read_int();
+  if (!res_strtab_size) {
+    return make_error_code(lief_errors::read_error);
+  }
+  // The size has been read so that strtab_offset <= stream.size(). The check
+  // is done on the remaining bytes as strtab_offset + strtab_size can
+  // wrap around with a 64-bit size.
+  const uint64_t strtab_offset = stream.pos();
+  const uint64_t strtab_size = *res_strtab_size;
+  if (strtab_size > uint64_t(stream.size()) - strtab_offset) {
+    LIEF_ERR("Corrupted __.SYMDEF (string table size: 0x{:x})", strtab_size);
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  stream.setpos(ranlib_start);
+  symbols_.reserve(nb_ranlibs);
+  for (size_t i = 0; i < nb_ranlibs; ++i) {
+    auto res_strx = read_int();
+    auto res_off  = read_int();
+    if (!res_strx || !res_off) {
+      return make_error_code(lief_errors::read_error);
+    }
+    if (*res_strx >= strtab_size) {
+      LIEF_DEBUG("Wrong string index: 0x{:x}", *res_strx);
+      continue;
+    }
+    auto res_name = stream.peek_string_at(strtab_offset + *res_strx,
+                                          strtab_size - *res_strx);
+    if (!res_name) {
+      continue;
+    }
+    add_symbol(std::move(*res_name), *res_off);
+  }
+  return ok();
+}
+
+}
+}
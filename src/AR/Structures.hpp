@@ -0,0 +1,65 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_AR_STRUCTURES_H
+#define LIEF_AR_STRUCTURES_H
+#include <cstdint>
+#include <array>
+
+namespace LIEF {
+namespace AR {
+namespace details {
+
+static constexpr std::array<char, 8> AR_MAGIC      = {'!', '<', 'a', 'r', 'c', 'h', '>', '\n'};
+static constexpr std::array<char, 8> AR_THIN_MAGIC = {'!', '<', 't', 'h', 'i', 'n', '>', '\n'};
+static constexpr std::array<char, 2> AR_FMAG       = {'`', '\n'};
+
+// BSD names that are longer than 16 chars (or which contain spaces)
+// are stored right after the header with the name "#1/<length>"
+static constexpr char BSD_LONG_NAME_PREFIX[] = "#1/";
+
+static constexpr char SYMTAB_NAME[]    = "/";
+static constexpr char SYMTAB64_NAME[]  = "/SYM64/";
+static constexpr char LONG_NAMES[]     = "//";
+static constexpr char EC_SYMTAB_NAME[] = "/<ECSYMBOLS>/";
+static constexpr char BSD_SYMDEF[]     = "__.SYMDEF";
+static constexpr char BSD_SYMDEF_64[]  = "__.SYMDEF_64";
+
+struct ar_hdr {
+  char name[16];
+  char date[12];
+  char uid[6];
+  char gid[6];
+  char mode[8];
+  char size[10];
+  char fmag[2];
+};
+
+static_assert(sizeof(ar_hdr) == 60, "Wrong ar_hdr size");
+
+struct ranlib_32 {
+  uint32_t ran_strx;
+  uint32_t ran_off;
+};
+
+struct ranlib_64 {
+  uint64_t ran_strx;
+  uint64_t ran_off;
+};
+
+}
+}
+}
+#endif
@@ -0,0 +1,52 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+
+#include "LIEF/AR/utils.hpp"
+#include "LIEF/BinaryStream/FileStream.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
+
+#include "AR/Structures.hpp"
+
+namespace LIEF {
+namespace AR {
+
+bool is_archive(BinaryStream& stream) {
+  using magic_t = std::array<char, sizeof(details::AR_MAGIC)>;
+  if (auto magic_res = stream.peek<magic_t>(0)) {
+    const auto magic = *magic_res;
+    return std::equal(std::begin(magic), std::end(magic),
+                      std::begin(details::AR_MAGIC));
+  }
+  return false;
+}
+
+bool is_archive(const std::string& file) {
+  if (auto stream = FileStream::from_file(file)) {
+    return is_archive(*stream);
+  }
+  return false;
+}
+
+bool is_archive(const std::vector<uint8_t>& raw) {
+  if (auto stream = SpanStream::from_vector(raw)) {
+    return is_archive(*stream);
+  }
+  return false;
+}
+
+}
+}
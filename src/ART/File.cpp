@@ -16,6 +16,7 @@
 
 
 #include "LIEF/ART/File.hpp"
+#include "LIEF/ART/ImageReader.hpp"
 #include "LIEF/ART/hash.hpp"
 
 namespace LIEF {
@@ -0,0 +1,147 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ART_IMAGE_LAYOUT_H
+#define LIEF_ART_IMAGE_LAYOUT_H
+#include <cstdint>
+#include <vector>
+
+#include "LIEF/ART/types.hpp"
+#include "LIEF/ART/ImageReader.hpp"
+
+namespace LIEF {
+namespace ART {
+namespace details {
+
+//! Version-specific layout of an image, computed by Parser::parse_sections()
+//! from the ART structures of the version. It is used by the ImageReader
+//! to decode the objects and the native structures.
+struct image_layout_t {
+  //! Part of the image stored (and maybe compressed) in the file
+  struct block_t {
+    uint32_t image_offset = 0;
+    uint32_t image_size = 0;
+    uint32_t file_offset = 0;
+    uint32_t file_size = 0;
+    bool is_compressed = false;
+  };
+
+  //! Native array referenced by a DexCache
+  struct dex_cache_array_t {
+    uint32_t offset = 0;
+
+    //! Offset of the number of elements. When it is 0, the array is a
+    //! managed array (ART 17) whose length is stored in the object.
+    uint32_t count = 0;
+  };
+
+  // Indexes in the image roots array
+  static constexpr uint32_t ROOT_DEX_CACHES  = 0;
+  static constexpr uint32_t ROOT_CLASS_ROOTS = 1;
+
+  // Index of java.lang.String in the class roots
+  static constexpr uint32_t CLASS_ROOT_STRING = 4;
+
+  // Managed objects are aligned on 8 bytes (kObjectAlignment)
+  static constexpr uint32_t OBJECT_ALIGNMENT = 8;
+
+  // Offset of the length in a mirror::Array
+  static constexpr uint32_t ARRAY_LENGTH = 8;
+  static constexpr uint32_t ARRAY_DATA = 12;
+
+  // Offset of the count in a mirror::String
+  static constexpr uint32_t STRING_COUNT = 8;
+  static constexpr uint32_t STRING_VALUE = 16;
+
+  static constexpr uint32_t ART_FIELD_SIZE = 16;
+
+  art_version_t version = 0;
+  uint32_t pointer_size = 0;
+  uint32_t header_size = 0;
+  uint64_t image_begin = 0;
+  uint32_t image_size = 0;
+  uint32_t image_roots = 0;
+
+  std::vector<ImageReader::section_t> sections;
+  std::vector<block_t> blocks;
+
+  // java.lang.Class
+  uint32_t class_component_type = 0;
+  uint32_t class_name = 0;
+  uint32_t class_class_size = 0;
+  uint32_t class_object_size = 0;
+  uint32_t class_primitive_type = 0;
+
+  // java.lang.String: the LSB of the count is the compression flag (ART 44+)
+  bool compressed_strings = false;
+
+  // java.lang.DexCache
+  uint32_t dex_cache_location = 0;
+  dex_cache_array_t dex_cache_strings;
+  dex_cache_array_t dex_cache_types;
+  dex_cache_array_t dex_cache_methods;
+  dex_cache_array_t dex_cache_fields;
+
+  // ArtField and ArtMethod arrays are LengthPrefixedArray (ART 29+)
+  bool length_prefixed = false;
+
+  // ArtMethod
+  uint32_t method_access_flags = 0;
+  uint32_t method_code_item = 0;
+  uint32_t method_dex_index = 0;
+  uint32_t method_index = 0;
+  uint32_t method_index_size = 0;
+  uint32_t method_entry_point = 0;
+  uint32_t method_size = 0;
+};
+
+// Image sections of the different versions (in the order of the header)
+static constexpr ImageReader::SECTION SECTIONS_ART17[] = {
+  ImageReader::SECTION::OBJECTS,
+  ImageReader::SECTION::ART_FIELDS,
+  ImageReader::SECTION::ART_METHODS,
+  ImageReader::SECTION::INTERNED_STRINGS,
+  ImageReader::SECTION::IMAGE_BITMAP,
+};
+
+static constexpr ImageReader::SECTION SECTIONS_ART29[] = {
+  ImageReader::SECTION::OBJECTS,
+  ImageReader::SECTION::ART_FIELDS,
+  ImageReader::SECTION::ART_METHODS,
+  ImageReader::SECTION::RUNTIME_METHODS,
+  ImageReader::SECTION::IMT_CONFLICT_TABLES,
+  ImageReader::SECTION::DEX_CACHE_ARRAYS,
+  ImageReader::SECTION::INTERNED_STRINGS,
+  ImageReader::SECTION::CLASS_TABLE,
+  ImageReader::SECTION::IMAGE_BITMAP,
+};
+
+static constexpr ImageReader::SECTION SECTIONS_ART30[] = {
+  ImageReader::SECTION::OBJECTS,
+  ImageReader::SECTION::ART_FIELDS,
+  ImageReader::SECTION::ART_METHODS,
+  ImageReader::SECTION::RUNTIME_METHODS,
+  ImageReader::SECTION::IM_TABLES,
+  ImageReader::SECTION::IMT_CONFLICT_TABLES,
+  ImageReader::SECTION::DEX_CACHE_ARRAYS,
+  ImageReader::SECTION::INTERNED_STRINGS,
+  ImageReader::SECTION::CLASS_TABLE,
+  ImageReader::SECTION::IMAGE_BITMAP,
+};
+
+}
+}
+}
+#endif
@@ -0,0 +1,748 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+
+#include "logging.hpp"
+#include "frozen.hpp"
+
+#include "LIEF/utils.hpp"
+#include "LIEF/BinaryStream/BinaryStream.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
+#include "LIEF/ART/ImageReader.hpp"
+
+#include "ART/ImageLayout.hpp"
+#include "BinaryStream/LZ4.hpp"
+
+namespace LIEF {
+namespace ART {
+
+using layout_t = details::image_layout_t;
+
+// Upper bound on the number of elements read from a managed array
+static constexpr uint32_t MAX_ARRAY_ELEMENTS = 0x100000;
+
+static constexpr size_t BITMAP_WINDOW = 0x1000;
+static constexpr uint64_t UNKNOWN_CLASS = uint64_t(-1);
+
+// A LZ4 sequence can't expand more than 255 times
+static constexpr uint64_t LZ4_MAX_RATIO = 255;
+
+// Size of the elements of an array given the primitive type of its component.
+// Since ART 29, the upper 16 bits of the primitive type contain the size shift.
+static uint32_t component_size(uint32_t primitive_type) {
+  switch (primitive_type & 0xFFFF) {
+    case 1: // boolean
+    case 2: // byte
+      return 1;
+    case 3: // char
+    case 4: // short
+      return 2;
+    case 6: // long
+    case 8: // double
+      return 8;
+    default: // reference, int, float
+      return 4;
+  }
+}
+
+static ImageReader::art_field_t decode_field(BinaryStream& stream, uint64_t offset,
+                                             uint64_t address)
+{
+  ImageReader::art_field_t field;
+  field.address         = address;
+  field.declaring_class = stream.peek<uint32_t>(offset + 0).value_or(0);
+  field.access_flags    = stream.peek<uint32_t>(offset + 4).value_or(0);
+  field.dex_field_index = stream.peek<uint32_t>(offset + 8).value_or(0);
+  field.offset          = stream.peek<uint32_t>(offset + 12).value_or(0);
+  return field;
+}
+
+static ImageReader::art_method_t decode_method(const layout_t& layout, BinaryStream& stream,
+                                               uint64_t offset, uint64_t address)
+{
+  ImageReader::art_method_t method;
+  method.address              = address;
+  method.declaring_class      = stream.peek<uint32_t>(offset).value_or(0);
+  method.access_flags         = stream.peek<uint32_t>(offset + layout.method_access_flags).value_or(0);
+  method.dex_code_item_offset = stream.peek<uint32_t>(offset + layout.method_code_item).value_or(0);
+  method.dex_method_index     = stream.peek<uint32_t>(offset + layout.method_dex_index).value_or(0);
+  method.method_index = layout.method_index_size == sizeof(uint16_t) ?
+                        stream.peek<uint16_t>(offset + layout.method_index).value_or(0) :
+                        stream.peek<uint32_t>(offset + layout.method_index).value_or(0);
+  method.entry_point = layout.pointer_size == sizeof(uint64_t) ?
+                       stream.peek<uint64_t>(offset + layout.method_entry_point).value_or(0) :
+                       stream.peek<uint32_t>(offset + layout.method_entry_point).value_or(0);
+  return method;
+}
+
+ImageReader::ImageReader(std::unique_ptr<BinaryStream> stream,
+                         std::unique_ptr<details::image_layout_t> layout) :
+  stream_(std::move(stream)),
+  layout_(std::move(layout))
+{
+  blocks_.resize(layout_->blocks.size());
+}
+
+ImageReader::~ImageReader() = default;
+
+uint64_t ImageReader::image_begin() const {
+  return layout_->image_begin;
+}
+
+uint32_t ImageReader::image_size() const {
+  return layout_->image_size;
+}
+
+uint32_t ImageReader::pointer_size() const {
+  return layout_->pointer_size;
+}
+
+const std::vector<ImageReader::section_t>& ImageReader::sections() const {
+  return layout_->sections;
+}
+
+const ImageReader::section_t* ImageReader::get(SECTION type) const {
+  auto it = std::find_if(layout_->sections.begin(), layout_->sections.end(),
+    [type] (const section_t& section) { return section.type == type; });
+  return it != layout_->sections.end() ? &*it : nullptr;
+}
+
+size_t ImageReader::nb_decoded_blocks() const {
+  return std::count_if(blocks_.begin(), blocks_.end(),
+    [] (const std::unique_ptr<std::vector<uint8_t>>& block) {
+      return block != nullptr && !block->empty();
+    });
+}
+
+const std::vector<uint8_t>* ImageReader::block(size_t idx) const {
+  if (blocks_[idx] != nullptr) {
+    // An empty block is a block that can't be decompressed
+    return blocks_[idx]->empty() ? nullptr : blocks_[idx].get();
+  }
+  const layout_t::block_t& info = layout_->blocks[idx];
+  LIEF_DEBUG("Decompressing block #{:d}: 0x{:x} -> 0x{:x} bytes", idx,
+             info.file_size, info.image_size);
+  blocks_[idx] = std::make_unique<std::vector<uint8_t>>();
+
+  if (uint64_t(info.image_size) > uint64_t(info.file_size) * LZ4_MAX_RATIO) {
+    LIEF_ERR("The block at 0x{:x} can't be decompressed in 0x{:x} bytes",
+             info.file_offset, info.image_size);
+    return nullptr;
+  }
+
+  std::vector<uint8_t> compressed;
+  if (!stream_->peek_data(compressed, info.file_offset, info.file_size)) {
+    LIEF_ERR("Can't read the compressed block at 0x{:x}", info.file_offset);
+    return nullptr;
+  }
+
+  std::vector<uint8_t> data(info.image_size);
+  result<size_t> size = LIEF::details::lz4_decompress(compressed, data);
+  if (!size) {
+    LIEF_ERR("Can't decompress the block at 0x{:x}", info.file_offset);
+    return nullptr;
+  }
+  if (*size != info.image_size) {
+    LIEF_WARN("The block at 0x{:x} is decompressed in 0x{:x} bytes (expected: 0x{:x})",
+              info.file_offset, *size, info.image_size);
+  }
+  *blocks_[idx] = std::move(data);
+  return blocks_[idx].get();
+}
+
+ok_error_t ImageReader::read_at(uint64_t offset, void* dst, size_t size) const {
+  if (offset > layout_->image_size || size > layout_->image_size - offset) {
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  auto* out = static_cast<uint8_t*>(dst);
+
+  while (size > 0) {
+    size_t chunk = 0;
+    if (offset < layout_->header_size) {
+      // The header is never compressed
+      chunk = std::min<size_t>(size, layout_->header_size - offset);
+      if (!stream_->peek_data(buffer_, offset, chunk)) {
+        return make_error_code(lief_errors::read_error);
+      }
+      std::memcpy(out, buffer_.data(), chunk);
+    } else {
+      const auto& blocks = layout_->blocks;
+      auto it = std::find_if(blocks.begin(), blocks.end(),
+        [offset] (const layout_t::block_t& block) {
+          return block.image_offset <= offset &&
+                 offset < uint64_t(block.image_offset) + block.image_size;
+        });
+      if (it == blocks.end()) {
+        return make_error_code(lief_errors::read_out_of_bound);
+      }
+      const uint64_t delta = offset - it->image_offset;
+      chunk = std::min<size_t>(size, it->image_size - delta);
+      if (!it->is_compressed) {
+        if (!stream_->peek_data(buffer_, it->file_offset + delta, chunk)) {
+          return make_error_code(lief_errors::read_error);
+        }
+        std::memcpy(out, buffer_.data(), chunk);
+      } else {
+        const std::vector<uint8_t>* data = block(std::distance(blocks.begin(), it));
+        if (data == nullptr) {
+          return make_error_code(lief_errors::corrupted);
+        }
+        std::memcpy(out, data->data() + delta, chunk);
+      }
+    }
+    out    += chunk;
+    offset += chunk;
+    size   -= chunk;
+  }
+  return ok();
+}
+
+result<std::vector<uint8_t>> ImageReader::read(uint64_t address, size_t size) const {
+  if (!contains(address) || size > image_begin() + image_size() - address) {
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  std::vector<uint8_t> data(size);
+  if (auto is_ok = read_at(address - image_begin(), data.data(), size); !is_ok) {
+    return make_error_code(get_error(is_ok));
+  }
+  return data;
+}
+
+result<uint32_t> ImageReader::read_u32(uint64_t address) const {
+  if (!contains(address)) {
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  return read_at<uint32_t>(address - image_begin());
+}
+
+std::vector<uint64_t> ImageReader::array_refs(uint64_t address) const {
+  std::vector<uint64_t> refs;
+  auto length = read_u32(address + layout_t::ARRAY_LENGTH);
+  if (!length) {
+    return refs;
+  }
+  if (*length > MAX_ARRAY_ELEMENTS) {
+    LIEF_WARN("The array at 0x{:x} is too large ({:d} elements)", address, *length);
+    return refs;
+  }
+  refs.reserve(*length);
+  for (uint32_t i = 0; i < *length; ++i) {
+    auto ref = read_u32(address + layout_t::ARRAY_DATA + i * sizeof(uint32_t));
+    if (!ref) {
+      break;
+    }
+    refs.push_back(*ref);
+  }
+  return refs;
+}
+
+std::vector<uint64_t> ImageReader::class_roots() const {
+  const std::vector<uint64_t> roots = array_refs(layout_->image_roots);
+  if (roots.size() <= layout_t::ROOT_CLASS_ROOTS) {
+    return {};
+  }
+  return array_refs(roots[layout_t::ROOT_CLASS_ROOTS]);
+}
+
+uint64_t ImageReader::string_class() const {
+  if (string_class_ == 0) {
+    const std::vector<uint64_t> roots = class_roots();
+    string_class_ = roots.size() > layout_t::CLASS_ROOT_STRING ?
+                    roots[layout_t::CLASS_ROOT_STRING] : UNKNOWN_CLASS;
+  }
+  return string_class_;
+}
+
+result<ImageReader::object_t> ImageReader::object(uint64_t address) const {
+  if (!contains(address) || address % layout_t::OBJECT_ALIGNMENT != 0) {
+    return make_error_code(lief_errors::not_found);
+  }
+
+  auto klass = read_u32(address);
+  if (!klass || *klass == 0) {
+    return make_error_code(lief_errors::not_found);
+  }
+  // The class of java.lang.Class is itself
+  auto klass_class = read_u32(*klass);
+  if (!klass_class) {
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  object_t obj;
+  obj.address = address;
+  obj.klass   = *klass;
+
+  uint64_t size = 0;
+  if (*klass_class == *klass) {
+    obj.kind = OBJECT_KIND::CLASS;
+    size = read_u32(address + layout_->class_class_size).value_or(0);
+  }
+  else if (obj.klass == string_class()) {
+    obj.kind = OBJECT_KIND::STRING;
+    const uint32_t count = read_u32(address + layout_t::STRING_COUNT).value_or(0);
+    bool is_compressed = false;
+    obj.length = count;
+    if (layout_->compressed_strings) {
+      is_compressed = (count & 1) == 0;
+      obj.length = count >> 1;
+    }
+    size = layout_t::STRING_VALUE + uint64_t(obj.length) * (is_compressed ? 1 : 2);
+  }
+  else {
+    const uint32_t component = read_u32(obj.klass + layout_->class_component_type).value_or(0);
+    if (component != 0) {
+      obj.kind = OBJECT_KIND::ARRAY;
+      const uint32_t primitive = read_u32(component + layout_->class_primitive_type).value_or(0);
+      const uint32_t elt_size = component_size(primitive);
+      obj.length = read_u32(address + layout_t::ARRAY_LENGTH).value_or(0);
+      size = align(layout_t::ARRAY_DATA, elt_size) + uint64_t(obj.length) * elt_size;
+    } else {
+      obj.kind = OBJECT_KIND::INSTANCE;
+      size = read_u32(obj.klass + layout_->class_object_size).value_or(0);
+    }
+  }
+
+  if (size == 0 || size > image_begin() + image_size() - address) {
+    LIEF_DEBUG("Wrong size for the object at 0x{:x}: 0x{:x}", address, size);
+    return make_error_code(lief_errors::corrupted);
+  }
+  obj.size = static_cast<uint32_t>(size);
+  return obj;
+}
+
+bool ImageReader::has_bitmap() const {
+  const section_t* bitmap = get(SECTION::IMAGE_BITMAP);
+  return bitmap != nullptr && bitmap->size > 0 &&
+         uint64_t(bitmap->offset) + bitmap->size <= stream_->size();
+}
+
+// The image bitmap has one bit per 8-byte slot of the objects section.
+// A bit is set if an object starts at this slot.
+result<uint8_t> ImageReader::bitmap_byte(uint64_t index) const {
+  const section_t* bitmap = get(SECTION::IMAGE_BITMAP);
+  if (bitmap == nullptr || index >= bitmap->size) {
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  if (bitmap_window_.empty() || index < bitmap_window_offset_ ||
+      index >= bitmap_window_offset_ + bitmap_window_.size())
+  {
+    const uint64_t start = index - index % BITMAP_WINDOW;
+    const uint64_t size = std::min<uint64_t>(BITMAP_WINDOW, bitmap->size - start);
+    if (!stream_->peek_data(bitmap_window_, bitmap->offset + start, size)) {
+      bitmap_window_.clear();
+      return make_error_code(lief_errors::read_error);
+    }
+    bitmap_window_offset_ = start;
+  }
+  return bitmap_window_[index - bitmap_window_offset_];
+}
+
+result<ImageReader::object_t> ImageReader::first_object() const {
+  const uint64_t start = image_begin() + align(layout_->header_size, layout_t::OBJECT_ALIGNMENT);
+  if (auto obj = object(start)) {
+    return obj;
+  }
+  if (!has_bitmap()) {
+    return make_error_code(lief_errors::not_found);
+  }
+  object_t before;
+  before.address = start - layout_t::OBJECT_ALIGNMENT;
+  return next(before);
+}
+
+result<ImageReader::object_t> ImageReader::next(const object_t& obj) const {
+  const section_t* objects = get(SECTION::OBJECTS);
+  if (objects == nullptr) {
+    return make_error_code(lief_errors::not_found);
+  }
+  const uint64_t end = uint64_t(objects->offset) + objects->size;
+
+  if (!has_bitmap()) {
+    const uint64_t address = obj.address + align(obj.size, layout_t::OBJECT_ALIGNMENT);
+    if (obj.size == 0 || address - image_begin() >= end) {
+      return make_error_code(lief_errors::not_found);
+    }
+    return object(address);
+  }
+
+  const uint64_t end_slot = end / layout_t::OBJECT_ALIGNMENT;
+  uint64_t slot = (obj.address - image_begin()) / layout_t::OBJECT_ALIGNMENT + 1;
+  while (slot < end_slot) {
+    auto byte = bitmap_byte(slot / 8);
+    if (!byte) {
+      break;
+    }
+    const uint32_t bits = *byte >> (slot % 8);
+    if (bits == 0) {
+      slot += 8 - slot % 8;
+      continue;
+    }
+    for (uint32_t i = 0; (bits & (1u << i)) == 0; ++i) {
+      ++slot;
+    }
+    if (slot >= end_slot) {
+      break;
+    }
+    return object(image_begin() + slot * layout_t::OBJECT_ALIGNMENT);
+  }
+  return make_error_code(lief_errors::not_found);
+}
+
+ImageReader::objects_it ImageReader::objects() const {
+  auto first = first_object();
+  if (!first) {
+    return make_range(ObjectIterator(), ObjectIterator());
+  }
+  return make_range(ObjectIterator(*this, *first), ObjectIterator(*this, object_t()));
+}
+
+ImageReader::ObjectIterator& ImageReader::ObjectIterator::operator++() {
+  auto next = reader_->next(obj_);
+  obj_ = next ? *next : object_t();
+  return *this;
+}
+
+result<ImageReader::object_t> ImageReader::find_object(uint64_t address) const {
+  const section_t* objects = get(SECTION::OBJECTS);
+  if (objects == nullptr || !contains(address)) {
+    return make_error_code(lief_errors::not_found);
+  }
+  const uint64_t offset = address - image_begin();
+  const uint64_t start = align(layout_->header_size, layout_t::OBJECT_ALIGNMENT);
+  if (offset < start || offset >= uint64_t(objects->offset) + objects->size) {
+    return make_error_code(lief_errors::not_found);
+  }
+
+  uint64_t obj_offset = 0;
+  if (has_bitmap()) {
+    // Look for the closest object start before (or at) the address
+    const uint64_t first_slot = start / layout_t::OBJECT_ALIGNMENT;
+    uint64_t slot = offset / layout_t::OBJECT_ALIGNMENT;
+    bool found = false;
+    while (slot >= first_slot) {
+      auto byte = bitmap_byte(slot / 8);
+      if (!byte) {
+        break;
+      }
+      const uint32_t bits = *byte & ((2u << (slot % 8)) - 1);
+      if (bits == 0) {
+        if (slot < 8) {
+          break;
+        }
+        slot = slot - slot % 8 - 1;
+        continue;
+      }
+      uint32_t msb = 7;
+      while ((bits & (1u << msb)) == 0) {
+        --msb;
+      }
+      slot = slot - slot % 8 + msb;
+      found = slot >= first_slot;
+      break;
+    }
+    if (!found) {
+      return make_error_code(lief_errors::not_found);
+    }
+    obj_offset = slot * layout_t::OBJECT_ALIGNMENT;
+  } else {
+    // Without bitmap, the start of the objects are indexed once
+    if (object_index_.empty()) {
+      for (const object_t& obj : this->objects()) {
+        object_index_.push_back(static_cast<uint32_t>(obj.address - image_begin()));
+      }
+    }
+    auto it = std::upper_bound(object_index_.begin(), object_index_.end(), offset);
+    if (it == object_index_.begin()) {
+      return make_error_code(lief_errors::not_found);
+    }
+    obj_offset = *std::prev(it);
+  }
+
+  auto obj = object(image_begin() + obj_offset);
+  if (!obj) {
+    return make_error_code(get_error(obj));
+  }
+  if (address >= obj->address + obj->size) {
+    return make_error_code(lief_errors::not_found);
+  }
+  return obj;
+}
+
+result<std::string> ImageReader::string(uint64_t address) const {
+  auto count = read_u32(address + layout_t::STRING_COUNT);
+  if (!count) {
+    return make_error_code(get_error(count));
+  }
+  uint32_t length = *count;
+  bool is_compressed = false;
+  if (layout_->compressed_strings) {
+    is_compressed = (*count & 1) == 0;
+    length = *count >> 1;
+  }
+
+  const uint64_t value = address + layout_t::STRING_VALUE;
+  if (is_compressed) {
+    auto raw = read(value, length);
+    if (!raw) {
+      return make_error_code(get_error(raw));
+    }
+    return std::string(raw->begin(), raw->end());
+  }
+
+  auto raw = read(value, uint64_t(length) * sizeof(char16_t));
+  if (!raw) {
+    return make_error_code(get_error(raw));
+  }
+  std::u16string str(length, u'\0');
+  std::memcpy(str.data(), raw->data(), raw->size());
+  return u16tou8(str);
+}
+
+result<std::string> ImageReader::class_name(uint64_t address) const {
+  auto name = read_u32(address + layout_->class_name);
+  if (!name) {
+    return make_error_code(get_error(name));
+  }
+  if (*name == 0) {
+    return make_error_code(lief_errors::not_found);
+  }
+  return string(*name);
+}
+
+std::vector<ImageReader::dex_cache_t> ImageReader::dex_caches() const {
+  std::vector<dex_cache_t> caches;
+  const std::vector<uint64_t> roots = array_refs(layout_->image_roots);
+  if (roots.size() <= layout_t::ROOT_DEX_CACHES) {
+    return caches;
+  }
+
+  const auto read_array = [this] (uint64_t address, const layout_t::dex_cache_array_t& info,
+                                  uint64_t& array, uint32_t& count)
+  {
+    if (info.count != 0) {
+      array = read_at<uint64_t>(address - image_begin() + info.offset).value_or(0);
+      count = read_u32(address + info.count).value_or(0);
+      return;
+    }
+    // ART 17: the arrays are managed objects
+    array = read_u32(address + info.offset).value_or(0);
+    count = array != 0 ? read_u32(array + layout_t::ARRAY_LENGTH).value_or(0) : 0;
+  };
+
+  for (uint64_t address : array_refs(roots[layout_t::ROOT_DEX_CACHES])) {
+    if (!contains(address)) {
+      continue;
+    }
+    dex_cache_t cache;
+    cache.address = address;
+    if (uint32_t location = read_u32(address + layout_->dex_cache_location).value_or(0)) {
+      cache.location = string(location).value_or("");
+    }
+    read_array(address, layout_->dex_cache_strings, cache.strings, cache.nb_strings);
+    read_array(address, layout_->dex_cache_types, cache.resolved_types, cache.nb_resolved_types);
+    read_array(address, layout_->dex_cache_methods, cache.resolved_methods, cache.nb_resolved_methods);
+    read_array(address, layout_->dex_cache_fields, cache.resolved_fields, cache.nb_resolved_fields);
+    caches.push_back(std::move(cache));
+  }
+  return caches;
+}
+
+std::vector<ImageReader::art_field_t> ImageReader::art_fields() const {
+  std::vector<art_field_t> fields;
+  const section_t* section = get(SECTION::ART_FIELDS);
+  if (section == nullptr || section->size == 0) {
+    return fields;
+  }
+  auto raw = read(image_begin() + section->offset, section->size);
+  if (!raw) {
+    return fields;
+  }
+  SpanStream stream(*raw);
+  const uint64_t base = image_begin() + section->offset;
+  const uint64_t size = raw->size();
+
+  if (!layout_->length_prefixed) {
+    for (uint64_t pos = 0; pos + layout_t::ART_FIELD_SIZE <= size; pos += layout_t::ART_FIELD_SIZE) {
+      fields.push_back(decode_field(stream, pos, base + pos));
+    }
+    return fields;
+  }
+
+  // Sequence of LengthPrefixedArray<ArtField>
+  uint64_t pos = 0;
+  while (pos + sizeof(uint32_t) <= size) {
+    const uint32_t count = stream.peek<uint32_t>(pos).value_or(0);
+    pos += sizeof(uint32_t);
+    if (count > (size - pos) / layout_t::ART_FIELD_SIZE) {
+      LIEF_WARN("Corrupted ArtField array at 0x{:x}", base + pos - sizeof(uint32_t));
+      break;
+    }
+    for (uint32_t i = 0; i < count; ++i, pos += layout_t::ART_FIELD_SIZE) {
+      fields.push_back(decode_field(stream, pos, base + pos));
+    }
+  }
+  return fields;
+}
+
+std::vector<ImageReader::art_method_t> ImageReader::art_methods() const {
+  std::vector<art_method_t> methods;
+  const uint32_t stride = layout_->method_size;
+
+  if (const section_t* section = get(SECTION::ART_METHODS); section != nullptr && section->size > 0) {
+    if (auto raw = read(image_begin() + section->offset, section->size)) {
+      SpanStream stream(*raw);
+      const uint64_t base = image_begin() + section->offset;
+      const uint64_t size = raw->size();
+      uint64_t pos = 0;
+      while (pos + (layout_->length_prefixed ? sizeof(uint32_t) : stride) <= size) {
+        uint64_t count = (size - pos) / stride;
+        if (layout_->length_prefixed) {
+          // LengthPrefixedArray<ArtMethod>: the methods are aligned on the
+          // pointer size
+          count = stream.peek<uint32_t>(pos).value_or(0);
+          pos += align(sizeof(uint32_t), layout_->pointer_size);
+          if (pos > size || count > (size - pos) / stride) {
+            LIEF_WARN("Corrupted ArtMethod array at 0x{:x}", base + pos);
+            break;
+          }
+        }
+        for (uint64_t i = 0; i < count; ++i, pos += stride) {
+          methods.push_back(decode_method(*layout_, stream, pos, base + pos));
+        }
+      }
+    }
+  }
+
+  if (const section_t* section = get(SECTION::RUNTIME_METHODS); section != nullptr && section->size > 0) {
+    if (auto raw = read(image_begin() + section->offset, section->size)) {
+      SpanStream stream(*raw);
+      const uint64_t base = image_begin() + section->offset;
+      for (uint64_t pos = 0; pos + stride <= raw->size(); pos += stride) {
+        methods.push_back(decode_method(*layout_, stream, pos, base + pos));
+      }
+    }
+  }
+  return methods;
+}
+
+result<ImageReader::art_field_t> ImageReader::art_field(uint64_t address) const {
+  auto raw = read(address, layout_t::ART_FIELD_SIZE);
+  if (!raw) {
+    return make_error_code(get_error(raw));
+  }
+  SpanStream stream(*raw);
+  return decode_field(stream, 0, address);
+}
+
+result<ImageReader::art_method_t> ImageReader::art_method(uint64_t address) const {
+  auto raw = read(address, layout_->method_size);
+  if (!raw) {
+    return make_error_code(get_error(raw));
+  }
+  SpanStream stream(*raw);
+  return decode_method(*layout_, stream, 0, address);
+}
+
+// The intern table and the class table are serialized as a HashSet:
+//   uint64_t num_elements, num_buckets, elements_until_expand
+//   double   min_load_factor, max_load_factor
+//   uint32_t buckets[num_buckets]
+std::vector<uint64_t> ImageReader::hash_set(SECTION type) const {
+  static constexpr size_t HEADER_SIZE = 3 * sizeof(uint64_t) + 2 * sizeof(double);
+  std::vector<uint64_t> values;
+  const section_t* section = get(type);
+  if (section == nullptr || section->size < HEADER_SIZE) {
+    return values;
+  }
+  auto raw = read(image_begin() + section->offset, section->size);
+  if (!raw) {
+    return values;
+  }
+  SpanStream stream(*raw);
+  const uint64_t nb_elements = stream.peek<uint64_t>(0).value_or(0);
+  uint64_t nb_buckets = stream.peek<uint64_t>(sizeof(uint64_t)).value_or(0);
+  if (nb_buckets > (raw->size() - HEADER_SIZE) / sizeof(uint32_t)) {
+    LIEF_WARN("{}: the number of buckets is corrupted ({:d})", to_string(type), nb_buckets);
+    nb_buckets = (raw->size() - HEADER_SIZE) / sizeof(uint32_t);
+  }
+
+  values.reserve(nb_elements <= nb_buckets ? nb_elements : nb_buckets);
+  for (uint64_t i = 0; i < nb_buckets; ++i) {
+    // Since ART 44, the lower bits of the class table slots contain a part
+    // of the hash
+    const uint32_t slot = stream.peek<uint32_t>(HEADER_SIZE + i * sizeof(uint32_t)).value_or(0) &
+                          ~(layout_t::OBJECT_ALIGNMENT - 1);
+    if (slot != 0) {
+      values.push_back(slot);
+    }
+  }
+  if (values.size() != nb_elements) {
+    LIEF_DEBUG("{}: {:d} elements found (expected: {:d})", to_string(type),
+               values.size(), nb_elements);
+  }
+  return values;
+}
+
+std::vector<uint64_t> ImageReader::interned_strings() const {
+  return hash_set(SECTION::INTERNED_STRINGS);
+}
+
+std::vector<uint64_t> ImageReader::class_table() const {
+  return hash_set(SECTION::CLASS_TABLE);
+}
+
+const char* to_string(ImageReader::SECTION e) {
+  #define ENTRY(X) std::pair(ImageReader::SECTION::X, #X)
+  STRING_MAP enums2str {
+    ENTRY(UNKNOWN),
+    ENTRY(OBJECTS),
+    ENTRY(ART_FIELDS),
+    ENTRY(ART_METHODS),
+    ENTRY(RUNTIME_METHODS),
+    ENTRY(IM_TABLES),
+    ENTRY(IMT_CONFLICT_TABLES),
+    ENTRY(DEX_CACHE_ARRAYS),
+    ENTRY(INTERNED_STRINGS),
+    ENTRY(CLASS_TABLE),
+    ENTRY(IMAGE_BITMAP),
+  };
+  #undef ENTRY
+
+  if (auto it = enums2str.find(e); it != enums2str.end()) {
+    return it->second;
+  }
+  return "UNKNOWN";
+}
+
+const char* to_string(ImageReader::OBJECT_KIND e) {
+  #define ENTRY(X) std::pair(ImageReader::OBJECT_KIND::X, #X)
+  STRING_MAP enums2str {
+    ENTRY(INSTANCE),
+    ENTRY(CLASS),
+    ENTRY(ARRAY),
+    ENTRY(STRING),
+  };
+  #undef ENTRY
+
+  if (auto it = enums2str.find(e); it != enums2str.end()) {
+    return it->second;
+  }
+  return "UNKNOWN";
+}
+
+}
+}
@@ -18,6 +18,7 @@
 
 #include "logging.hpp"
 
+#include "LIEF/BinaryStream/FileStream.hpp"
 #include "LIEF/BinaryStream/VectorStream.hpp"
 #include "LIEF/ART/Parser.hpp"
 #include "LIEF/ART/utils.hpp"
@@ -68,16 +69,21 @@ Parser::Parser(std::vector<uint8_t> data) :
 Parser::Parser(const std::string& file) :
   file_{new File{}}
 {
-  auto stream = VectorStream::from_file(file);
+  // The image is read on demand (see ImageReader) so we don't load
+  // the whole file in memory
+  auto stream = FileStream::from_file(file);
   if (!stream) {
     LIEF_ERR("Can't create the stream");
     return;
   }
-  stream_ = std::make_unique<VectorStream>(std::move(*stream));
+  stream_ = std::make_unique<FileStream>(std::move(*stream));
 }
 
 
 void Parser::init(const std::string& /*name*/, art_version_t version) {
+  if (stream_ == nullptr) {
+    return;
+  }
 
   if (version <= details::ART_17::art_version) {
     return parse_file<details::ART17>();
@@ -19,6 +19,9 @@
 #include "LIEF/ART/Parser.hpp"
 #include "LIEF/ART/File.hpp"
 #include "LIEF/ART/EnumToString.hpp"
+#include "LIEF/ART/ImageReader.hpp"
+
+#include "ART/ImageLayout.hpp"
 
 namespace LIEF {
 namespace ART {
@@ -26,7 +29,11 @@ namespace ART {
 template<typename ART_T>
 void Parser::parse_file() {
   LIEF_DEBUG("Parsing ART version {}", ART_T::art_version);
-  /* const size_t ptr_size = */ parse_header<ART_T>();
+  const size_t ptr_size = parse_header<ART_T>();
+  if (ptr_size == 0) {
+    return;
+  }
+  parse_sections<ART_T>();
 }
 
 template<typename ART_T>
@@ -48,289 +55,134 @@ size_t Parser::parse_header() {
   return hdr.pointer_size;
 }
 
-#if 0
-template<typename ART_T, typename PTR_T>
+template<typename ART_T>
 void Parser::parse_sections() {
-  using IMAGE_SECTIONS = typename ART_T::IMAGE_SECTIONS;
-  using art_header_t   = typename ART_T::art_header_t;
-  using jarray_t       = typename ART_T::template jarray_t<>;
-  using jclass_t       = typename ART_T::template jclass_t<>;
-  using jobject_t      = typename ART_T::template jobject_t<>;
-
-  VLOG(VDEBUG) << "Parsing Image Sections" << '\n';
-  size_t nb_sections = file_->header().nb_sections_;
-
-  const art_header_t& hdr = stream_->peek<art_header_t>(0);
+  using art_header_t = typename ART_T::art_header_t;
+  using jclass_t     = typename ART_T::template jclass_t<>;
+  using jdex_cache_t = typename ART_T::template jdex_cache_t<>;
+  using layout_t     = details::image_layout_t;
 
-  VLOG(VDEBUG) << "Parsing " << std::dec << file_->header().nb_sections_ << " sections";
+  const auto res_hdr = stream_->peek<art_header_t>(0);
+  if (!res_hdr) {
+    return;
+  }
+  const art_header_t& hdr = *res_hdr;
+  constexpr size_t nb_sections = std::extent_v<decltype(art_header_t::sections)>;
+
+  auto layout = std::make_unique<layout_t>();
+  layout->version      = ART_T::art_version;
+  layout->pointer_size = hdr.pointer_size;
+  layout->header_size  = sizeof(art_header_t);
+  layout->image_begin  = hdr.image_begin;
+  layout->image_size   = hdr.image_size;
+  layout->image_roots  = hdr.image_roots;
+
+  const ImageReader::SECTION* types = nullptr;
+  if constexpr (nb_sections == std::size(details::SECTIONS_ART17)) {
+    types = details::SECTIONS_ART17;
+  } else if constexpr (nb_sections == std::size(details::SECTIONS_ART29)) {
+    types = details::SECTIONS_ART29;
+  } else {
+    static_assert(nb_sections == std::size(details::SECTIONS_ART30));
+    types = details::SECTIONS_ART30;
+  }
 
-  size_t start_offset = align(sizeof(art_header_t), sizeof(uint64_t));
-  // TODO: Check section size number
   for (size_t i = 0; i < nb_sections; ++i) {
-    IMAGE_SECTIONS section_type = static_cast<IMAGE_SECTIONS>(i);
-    ART::image_section_t section_header = hdr.sections[i];
-
-    uint64_t jarray_offset = start_offset;
-    if (i == 1) {
-      jarray_offset = align(sizeof(art_header_t) + sizeof(jarray_t) + (3409 - 1) * sizeof(uint32_t), sizeof(uint64_t));
-    }
-
-    if (i == 2) {
-      jarray_offset = align(sizeof(art_header_t) + sizeof(jarray_t) + (3409 - 1) * sizeof(uint32_t), sizeof(uint64_t));
-      jarray_offset += sizeof(jarray_t) + 2 * (32062 - 1) * (sizeof(uint32_t));
-      jarray_offset = align(jarray_offset, sizeof(uint64_t));
-      //jarray_offset = 0x700e1db0 - imagebase_;
-    }
-    std::cout << "addr:" << std::hex << imagebase_ + jarray_offset << '\n';
-
-    const jarray_t* array = reinterpret_cast<const jarray_t*>(stream_->read(jarray_offset, sizeof(jarray_t)));
-    uint64_t elements_offset = jarray_offset + offsetof(jarray_t, elements);
-
-
-
-    VLOG(VDEBUG) << to_string(section_type) << "@" << std::hex << section_header.offset
-                 << " --> " << (section_header.offset + section_header.size)
-                 << " #" << std::dec << array->length;
-
-    std::cout << std::hex << stream_->read_integer<uint32_t>(jarray_offset) << '\n';
-    std::cout << std::hex << stream_->read_integer<uint32_t>(jarray_offset + sizeof(uint32_t)) << '\n';
-    std::cout << std::hex << stream_->read_integer<uint32_t>(jarray_offset + 2 * sizeof(uint32_t)) << '\n';
-    std::cout << std::hex << stream_->read_integer<uint32_t>(jarray_offset + 3 * sizeof(uint32_t)) << '\n';
-    std::cout << std::hex << stream_->read_integer<uint32_t>(jarray_offset + 4 * sizeof(uint32_t)) << '\n';
-
-
-    uint32_t parent  = array->object.klass - imagebase_;
-    const jclass_t* pp = reinterpret_cast<const jclass_t*>(stream_->read(parent, sizeof(jclass_t)));
-    parse_jstring<ART_T, PTR_T>(pp->name - imagebase_);
-
-    switch (section_type) {
-      case IMAGE_SECTIONS::SECTION_OBJECTS:
-        {
-
-          // '0x70000090'
-          parse_objects<ART_T, PTR_T>(elements_offset, array->length);
-          break;
-        }
-
-      case IMAGE_SECTIONS::SECTION_ART_FIELDS:
-        {
-          // '0x700035e0'
-          parse_art_fields<ART_T, PTR_T>(elements_offset, array->length);
-          break;
-        }
-
-      case IMAGE_SECTIONS::SECTION_ART_METHODS:
-        {
-          // 0x6ff99db0: long[] length:65533
-          parse_art_methods<ART_T, PTR_T>(elements_offset, array->length);
-          break;
-        }
-
-      case IMAGE_SECTIONS::SECTION_INTERNED_STRINGS:
-        {
-          parse_interned_strings<ART_T, PTR_T>(elements_offset, array->length);
-          break;
-        }
-
-      default:
-        {
-          LOG(WARNING) << to_string(section_type) << " is !handle yet!";
-        }
-    }
-
+    const details::image_section_t& section = hdr.sections[i];
+    LIEF_DEBUG("{}: 0x{:08x} - 0x{:08x}", to_string(types[i]),
+               section.offset, section.offset + section.size);
+    layout->sections.push_back({types[i], section.offset, section.size});
   }
-}
-
-
-template<typename ART_T, typename PTR_T>
-void Parser::parse_roots() {
-  using jarray_t = typename ART_T::template jarray_t<>;
-  VLOG(VDEBUG) << "Parsing Image Roots" << '\n';
-  using IMAGE_ROOTS = typename ART_T::IMAGE_ROOTS;
 
-  uint32_t image_root_offset = file_->header().image_roots_ - file_->header().image_begin_;
-
-  VLOG(VDEBUG) << "Image root at: " << std::hex << std::showbase << file_->header().image_roots_;
-  VLOG(VDEBUG) << "Image root offset: " << std::hex << std::showbase << image_root_offset;
-
-  const jarray_t* array = reinterpret_cast<const jarray_t*>(stream_->read(image_root_offset, sizeof(jarray_t)));
-  std::cout << "Nb elements: " << array->length << '\n';
-
-  const uint32_t* array_values = reinterpret_cast<const uint32_t*>(
-      stream_->read(
-        image_root_offset + offsetof(jarray_t, elements),
-        array->length * sizeof(uint32_t)
-      ));
-
-
-  for (size_t i = 0; i < ART_T::nb_image_roots; ++i) {
-    IMAGE_ROOTS type = static_cast<IMAGE_ROOTS>(i);
-    uint64_t struct_offset = array_values[i] - imagebase_;
-    std::cout << std::hex << struct_offset << '\n';
-    const jarray_t* array = reinterpret_cast<const jarray_t*>(stream_->read(struct_offset, sizeof(jarray_t)));
-    std::cout << "Nb elements: " << std::dec << array->length << '\n';
-    switch (type) {
-      case IMAGE_ROOTS::DEX_CACHES:
-        {
-          parse_dex_caches<ART_T, PTR_T>(struct_offset + offsetof(jarray_t, elements), array->length);
-          break;
-        }
-
-      case IMAGE_ROOTS::CLASS_ROOTS:
-        {
-          parse_class_roots<ART_T, PTR_T>(struct_offset + offsetof(jarray_t, elements), array->length);
-          break;
-        }
-
-      case ART_44::IMAGE_ROOTS::CLASS_LOADER:
-        {
-          //parse_dex_caches<ART_T, PTR_T>(struct_offset + offsetof(jarray_t, elements), array->length);
-          break;
-        }
-
-      default:
-        {
-          LOG(WARNING) << to_string(type) << " is !handle yet!";
-        }
+  // The image data that follow the header might be compressed as a
+  // single LZ4 block
+  layout_t::block_t block;
+  block.image_offset = layout->header_size;
+  block.image_size   = hdr.image_size > block.image_offset ?
+                       hdr.image_size - block.image_offset : 0;
+  block.file_offset  = layout->header_size;
+  block.file_size    = block.image_size;
+  if constexpr (ART_T::art_version > details::ART_17::art_version) {
+    if (hdr.storage_mode == STORAGE_MODES::STORAGE_LZ4 ||
+        hdr.storage_mode == STORAGE_MODES::STORAGE_LZ4HC)
+    {
+      block.file_size     = hdr.data_size;
+      block.is_compressed = true;
+    }
+    else if (hdr.storage_mode != STORAGE_MODES::STORAGE_UNCOMPRESSED) {
+      LIEF_WARN("Unknown storage mode: {}", hdr.storage_mode);
+      return;
     }
-
-  }
-}
-
-
-template<typename ART_T, typename PTR_T>
-void Parser::parse_class_roots(size_t offset, size_t size) {
-  using jclass_t = typename ART_T::template jclass_t<>;
-  using jstring_t    = typename ART_T::template jstring_t<>;
-  VLOG(VDEBUG) << "Parsing Class Roots" << '\n';
-
-  for (size_t i = 0; i < size; ++i) {
-    uint32_t object_offset = stream_->read_integer<uint32_t>(offset + i * sizeof(uint32_t)) - imagebase_;
-    parse_class<ART_T, PTR_T>(object_offset);
   }
-}
-
-template<typename ART_T, typename PTR_T>
-void Parser::parse_class(size_t offset) {
-  using jclass_t     = typename ART_T::template jclass_t<>;
-  using jstring_t    = typename ART_T::template jstring_t<>;
-
-  const jclass_t* cls = reinterpret_cast<const jclass_t*>(stream_->read(offset, sizeof(jclass_t)));
-  parse_jstring<ART_T, PTR_T>(cls->name - imagebase_);
-}
-
-template<typename ART_T, typename PTR_T>
-void Parser::parse_jstring(size_t offset) {
-  using jstring_t    = typename ART_T::template jstring_t<>;
-  const jstring_t* jstring = reinterpret_cast<const jstring_t*>(stream_->read(offset, sizeof(jstring_t)));
-  //std::cout << "Class leng: " << std::dec << jstring->count << '\n';
-
-  uint64_t value_offset = offset + offsetof(jstring_t, value);
-
-  std::u16string str = {
-    reinterpret_cast<const char16_t*>(stream_->read(value_offset, static_cast<uint16_t>(jstring->count) * sizeof(char16_t))),
-    static_cast<uint16_t>(jstring->count)
-  };
-  std::cout << u16tou8(str)  << '\n';
-}
-
-template<typename ART_T, typename PTR_T>
-void Parser::parse_dex_caches(size_t offset, size_t size) {
-  using jobject_t    = typename ART_T::template jobject_t<>;
-  using jarray_t     = typename ART_T::template jarray_t<>;
-  using jclass_t     = typename ART_T::template jclass_t<>;
-  using jstring_t    = typename ART_T::template jstring_t<>;
-  using jdex_cache_t = typename ART_T::template jdex_cache_t<>;
-
-  VLOG(VDEBUG) << "Parsing Dex Cache" << '\n';
-
-  for (size_t i = 0; i < size; ++i) {
-    uint32_t object_offset = stream_->read_integer<uint32_t>(offset + i * sizeof(uint32_t)) - imagebase_;
-    parse_dex_cache<ART_T, PTR_T>(object_offset);
+  layout->blocks.push_back(block);
+
+  // java.lang.Class
+  layout->class_component_type = offsetof(jclass_t, component_type);
+  layout->class_name           = offsetof(jclass_t, name);
+  layout->class_class_size     = offsetof(jclass_t, class_size);
+  layout->class_object_size    = offsetof(jclass_t, object_size);
+  layout->class_primitive_type = offsetof(jclass_t, primitive_type);
+
+  // java.lang.String
+  layout->compressed_strings = ART_T::art_version >= details::ART_44::art_version;
+
+  // java.lang.DexCache
+  layout->dex_cache_location = offsetof(jdex_cache_t, location);
+  layout->dex_cache_strings  = {offsetof(jdex_cache_t, strings), 0};
+  layout->dex_cache_types    = {offsetof(jdex_cache_t, resolved_types), 0};
+  layout->dex_cache_methods  = {offsetof(jdex_cache_t, resolved_methods), 0};
+  layout->dex_cache_fields   = {offsetof(jdex_cache_t, resolved_fields), 0};
+  if constexpr (ART_T::art_version > details::ART_17::art_version) {
+    layout->dex_cache_strings.count = offsetof(jdex_cache_t, num_strings);
+    layout->dex_cache_types.count   = offsetof(jdex_cache_t, num_resolved_types);
+    layout->dex_cache_methods.count = offsetof(jdex_cache_t, num_resolved_methods);
+    layout->dex_cache_fields.count  = offsetof(jdex_cache_t, num_resolved_fields);
   }
-}
-
-template<typename ART_T, typename PTR_T>
-void Parser::parse_dex_cache(size_t object_offset) {
-  using jstring_t    = typename ART_T::template jstring_t<>;
-  using jdex_cache_t = typename ART_T::template jdex_cache_t<>;
-  const jdex_cache_t* cache = reinterpret_cast<const jdex_cache_t*>(stream_->read(object_offset, sizeof(jdex_cache_t)));
-  const jstring_t* location = reinterpret_cast<const jstring_t*>(stream_->read(cache->location - imagebase_, sizeof(jstring_t)));
-
-  uint64_t name_offset = cache->location - imagebase_ + offsetof(jstring_t, value);
-
-  if (location->count & 1) {
-    size_t len = location->count >> 1;
 
-    std::string location_string = {
-      reinterpret_cast<const char*>(stream_->read(name_offset, static_cast<uint16_t>(len) * sizeof(char))),
-      len
-    };
-    std::cout << location_string  << '\n';
+  // ArtMethod
+  const uint32_t ptr_size = hdr.pointer_size;
+  uint32_t nb_ptr_fields = 0;
+  uint32_t ptr_fields    = 0;
+  if constexpr (ART_T::art_version <= details::ART_17::art_version) {
+    // declaring_class_, dex_cache_resolved_methods_, dex_cache_resolved_types_
+    // access_flags_, dex_code_item_offset_, dex_method_index_, method_index_
+    // {entry_point_from_interpreter_, entry_point_from_jni_, entry_point_from_quick_compiled_code_}
+    layout->method_access_flags = 12;
+    layout->method_code_item    = 16;
+    layout->method_dex_index    = 20;
+    layout->method_index        = 24;
+    layout->method_index_size   = sizeof(uint32_t);
+    ptr_fields    = 28;
+    nb_ptr_fields = 3;
   } else {
-
-    std::u16string location_string = {
-      reinterpret_cast<const char16_t*>(stream_->read(name_offset, static_cast<uint16_t>(location->count) * sizeof(char16_t))),
-      static_cast<uint16_t>(location->count)
-    };
-    std::cout << u16tou8(location_string)  << '\n';
-  }
-}
-
-template<typename ART_T, typename PTR_T>
-void Parser::parse_methods() {
-  using art_header_t = typename ART_T::art_header_t;
-  using IMAGE_METHODS = typename ART_T::IMAGE_METHODS;
-
-  VLOG(VDEBUG) << "Parsing Image Methods" << '\n';
-
-
-  const art_header_t* hdr = reinterpret_cast<const art_header_t*>(stream_->read(0, sizeof(art_header_t)));
-
-  uint32_t nb_methods = file_->header().nb_methods_;
-  //TODO check with ART::nb_methods... (more secure)
-  for (size_t i = 0; i < nb_methods; ++i) {
-    IMAGE_METHODS type = static_cast<IMAGE_METHODS>(i);
-    uint64_t address = hdr->image_methods[i];
-    VLOG(VDEBUG) << to_string(type) << " at " << std::showbase << std::hex << address;
+    // declaring_class_, access_flags_, dex_code_item_offset_, dex_method_index_,
+    // (uint16_t) method_index_, (uint16_t) hotness_count_
+    layout->method_access_flags = 4;
+    layout->method_code_item    = 8;
+    layout->method_dex_index    = 12;
+    layout->method_index        = 16;
+    layout->method_index_size   = sizeof(uint16_t);
+    ptr_fields = 20;
+    if constexpr (ART_T::art_version <= details::ART_30::art_version) {
+      // {dex_cache_resolved_methods_, dex_cache_resolved_types_,
+      //  entry_point_from_jni_, entry_point_from_quick_compiled_code_}
+      nb_ptr_fields = 4;
+    } else if constexpr (ART_T::art_version <= details::ART_46::art_version) {
+      // {dex_cache_resolved_methods_, data_, entry_point_from_quick_compiled_code_}
+      nb_ptr_fields = 3;
+    } else {
+      // {data_, entry_point_from_quick_compiled_code_}
+      nb_ptr_fields = 2;
+    }
   }
-}
-
-
-template<typename ART_T, typename PTR_T>
-void Parser::parse_objects(size_t offset, size_t size) {
-  using jobject_t = typename ART_T::template jobject_t<>;
-  using jarray_t  = typename ART_T::template jarray_t<>;
-  using jclass_t  = typename ART_T::template jclass_t<>;
-  using jstring_t = typename ART_T::template jstring_t<>;
-
-  VLOG(VDEBUG) << "Paring objects at " << std::hex << offset << '\n';
-  //const jarray_t* array = reinterpret_cast<const jarray_t*>(stream_->read(offset, sizeof(jarray_t)));
-  //std::cout << std::dec << "nb elements " << array->length << '\n';;
-}
-
-
-template<typename ART_T, typename PTR_T>
-void Parser::parse_art_fields(size_t offset, size_t size) {
-  VLOG(VDEBUG) << "Paring ART Fields at " << std::hex << offset << '\n';
-}
-
-template<typename ART_T, typename PTR_T>
-void Parser::parse_art_methods(size_t offset, size_t size) {
-  VLOG(VDEBUG) << "Paring ART Methods at " << std::hex << offset << '\n';
-  // 0x6ff99db0: long[] length:65533
-  const PTR_T* methods = reinterpret_cast<const PTR_T*>(stream_->read(offset, size));
-  // 26740: 0x70a7ea60
-  PTR_T get_device_id = methods[26740];
-
-  std::cout << std::hex << "Get device ID " << get_device_id << '\n';
-}
-
-template<typename ART_T, typename PTR_T>
-void Parser::parse_interned_strings(size_t offset, size_t size) {
+  ptr_fields = static_cast<uint32_t>(align(ptr_fields, ptr_size));
+  layout->method_entry_point = ptr_fields + (nb_ptr_fields - 1) * ptr_size;
+  layout->method_size        = ptr_fields + nb_ptr_fields * ptr_size;
+  layout->length_prefixed    = ART_T::art_version > details::ART_17::art_version;
 
+  file_->image_ = std::unique_ptr<ImageReader>(
+      new ImageReader(std::move(stream_), std::move(layout)));
 }
-#endif
 
 }
 }
@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+
 #include "LIEF/Abstract/Binary.hpp"
 
 #include "LIEF/Visitor.hpp"
@@ -22,6 +24,7 @@
 
 #include "LIEF/Abstract/Section.hpp"
 #include "LIEF/Abstract/Symbol.hpp"
+#include "LIEF/Abstract/Symbolizer.hpp"
 #include "LIEF/Abstract/DebugInfo.hpp"
 
 namespace LIEF {
@@ -106,6 +109,29 @@ result<uint64_t> Binary::get_function_address(const std::string&) const {
   return make_error_code(lief_errors::not_implemented);
 }
 
+std::unique_ptr<Symbolizer> Binary::symbolizer() const {
+  auto sym = std::make_unique<Symbolizer>();
+  for (const Symbol& symbol : symbols()) {
+    if (symbol.value() > 0 && !symbol.name().empty()) {
+      sym->add(symbol.value(), symbol.size(), symbol.name());
+    }
+  }
+
+  for (const Function& func : exported_functions()) {
+    if (func.address() > 0) {
+      sym->add(func.address(), func.size(), func.name());
+    }
+  }
+
+  // The last symbol with an unknown size extends up to the end of the image
+  uint64_t end = 0;
+  for (const Section& section : sections()) {
+    end = std::max<uint64_t>(end, section.virtual_address() + section.size());
+  }
+  sym->finalize(end);
+  return sym;
+}
+
 std::vector<uint64_t> Binary::xref(uint64_t address) const {
   std::vector<uint64_t> result;
 
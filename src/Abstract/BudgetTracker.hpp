@@ -0,0 +1,111 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ABSTRACT_BUDGET_TRACKER_H
+#define LIEF_ABSTRACT_BUDGET_TRACKER_H
+#include <algorithm>
+#include <chrono>
+
+#include "LIEF/Abstract/ParserBudget.hpp"
+
+namespace LIEF {
+
+//! Runtime state associated with a ParserBudget while a binary is parsed.
+//!
+//! The parsers call stage() at the boundaries of their stages and tick()
+//! in the loops that iterate over (potentially) large tables.
+class BudgetTracker {
+  public:
+  using clock_t = std::chrono::steady_clock;
+  using TRUNCATION = ParserBudget::TRUNCATION;
+
+  BudgetTracker() = default;
+  BudgetTracker(ParserBudget budget, size_t nb_stages) :
+    budget_(std::move(budget)),
+    nb_stages_(nb_stages),
+    start_(clock_t::now())
+  {}
+
+  //! Notify the beginning of a new stage. It returns false if the parsing
+  //! must stop.
+  bool stage(const char* name);
+
+  //! Account for an object of ``size`` bytes. It returns false if the
+  //! parsing must stop.
+  bool tick(size_t size = 0) {
+    if (reason_ != TRUNCATION::NONE) {
+      return false;
+    }
+    if (size > 0) {
+      memory_ += size;
+      if (budget_.max_memory > 0 && memory_ > budget_.max_memory) {
+        return stop(TRUNCATION::MEMORY);
+      }
+    }
+    // Time and cancellation are only checked periodically
+    if ((++ticks_ & (CHECK_PERIOD - 1)) != 0) {
+      return true;
+    }
+    return check();
+  }
+
+  //! Return the number of entries of a table that can be processed given
+  //! the number of entries (``count``) and the format's default limit.
+  //! ParserBudget::max_objects can only lower this limit.
+  //!
+  //! Contrary to the other budgets, a table that is too large does not stop
+  //! the parsing of the other tables.
+  uint64_t limit(uint64_t count, uint64_t default_max) {
+    const uint64_t max = budget_.max_objects > 0 ?
+                         std::min(budget_.max_objects, default_max) : default_max;
+    if (count > max) {
+      objects_truncated_ = true;
+      return max;
+    }
+    return count;
+  }
+
+  //! Check the time and the cancellation budgets. It returns false if the
+  //! parsing must stop.
+  bool check();
+
+  //! Budget left for a nested parsing (e.g. the slices of a FAT Mach-O):
+  //! the time and the memory consumed so far are deducted
+  ParserBudget remaining() const;
+
+  TRUNCATION reason() const {
+    if (reason_ == TRUNCATION::NONE && objects_truncated_) {
+      return TRUNCATION::OBJECTS;
+    }
+    return reason_;
+  }
+
+  private:
+  static constexpr size_t CHECK_PERIOD = 1024;
+
+  bool stop(TRUNCATION reason);
+
+  ParserBudget budget_;
+  size_t nb_stages_ = 0;
+  size_t stage_idx_ = 0;
+  size_t ticks_ = 0;
+  uint64_t memory_ = 0;
+  clock_t::time_point start_;
+  TRUNCATION reason_ = TRUNCATION::NONE;
+  bool objects_truncated_ = false;
+};
+
+}
+#endif
@@ -0,0 +1,513 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+
+#include "LIEF/Abstract/Binary.hpp"
+#include "LIEF/Abstract/Function.hpp"
+#include "LIEF/Abstract/GoPclntab.hpp"
+#include "LIEF/Abstract/Section.hpp"
+
+#include "logging.hpp"
+#include "frozen.hpp"
+
+namespace LIEF {
+
+static constexpr uint32_t GO12_MAGIC  = 0xfffffffb;
+static constexpr uint32_t GO116_MAGIC = 0xfffffffa;
+static constexpr uint32_t GO118_MAGIC = 0xfffffff0;
+static constexpr uint32_t GO120_MAGIC = 0xfffffff1;
+
+// Number of leading entries checked when scanning for a table header
+static constexpr uint32_t NB_CHECKED_ENTRIES = 16;
+
+static constexpr char GO_BUILDID_PREFIX[] = "\xff Go build ID: \"";
+static constexpr char GO_BUILDINFO_MAGIC[] = "\xff Go buildinf:";
+
+// Window (from the beginning of the text) in which the build ID is searched
+static constexpr size_t BUILDID_WINDOW = 0x100;
+
+static bool contains(span<const uint8_t> content, const char* needle, size_t len) {
+  if (content.size() < len) {
+    return false;
+  }
+  // Compare bytes: the needles contain characters above 0x7f
+  const auto* raw = reinterpret_cast<const uint8_t*>(needle);
+  auto it = std::search(content.begin(), content.end(), raw, raw + len);
+  return it != content.end();
+}
+
+static uint64_t read_uint(span<const uint8_t> data, uint64_t offset,
+                          size_t size, bool big_endian)
+{
+  if (offset > data.size() || data.size() - offset < size) {
+    return 0;
+  }
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; ++i) {
+    const size_t pos = big_endian ? i : size - 1 - i;
+    value = (value << 8) | data[offset + pos];
+  }
+  return value;
+}
+
+static GoPclntab::VERSION version_from_magic(uint32_t magic) {
+  switch (magic) {
+    case GO12_MAGIC:  return GoPclntab::VERSION::GO_1_2;
+    case GO116_MAGIC: return GoPclntab::VERSION::GO_1_16;
+    case GO118_MAGIC: return GoPclntab::VERSION::GO_1_18;
+    case GO120_MAGIC: return GoPclntab::VERSION::GO_1_20;
+    default: return GoPclntab::VERSION::UNKNOWN;
+  }
+}
+
+// Cheap check on the fixed part of the header:
+// magic (4 bytes), 0, 0, pc quantum, pointer size
+static bool check_header(span<const uint8_t> raw, size_t offset) {
+  if (offset > raw.size() || raw.size() - offset < 16) {
+    return false;
+  }
+  const uint8_t* hdr = raw.data() + offset;
+  if (hdr[4] != 0 || hdr[5] != 0 ||
+      (hdr[6] != 1 && hdr[6] != 2 && hdr[6] != 4) ||
+      (hdr[7] != 4 && hdr[7] != 8))
+  {
+    return false;
+  }
+  // The magics share their upper 28 bits in both endiannesses
+  if (hdr[0] == 0xff && hdr[1] == 0xff && hdr[2] == 0xff && (hdr[3] & 0xf0) == 0xf0) {
+    return version_from_magic(read_uint(raw, offset, 4, /*big_endian=*/true)) != GoPclntab::VERSION::UNKNOWN;
+  }
+  if (hdr[3] == 0xff && hdr[2] == 0xff && hdr[1] == 0xff && (hdr[0] & 0xf0) == 0xf0) {
+    return version_from_magic(read_uint(raw, offset, 4, /*big_endian=*/false)) != GoPclntab::VERSION::UNKNOWN;
+  }
+  return false;
+}
+
+result<GoPclntab> GoPclntab::parse(span<const uint8_t> raw, uint64_t address,
+                                   uint64_t text_start)
+{
+  if (!check_header(raw, 0)) {
+    return make_error_code(lief_errors::file_format_error);
+  }
+
+  GoPclntab tab;
+  tab.raw_ = raw;
+  tab.address_ = address;
+  tab.quantum_ = raw[6];
+  tab.ptr_size_ = raw[7];
+  tab.big_endian_ = raw[0] == 0xff;
+  tab.version_ = version_from_magic(tab.read_u32(0));
+
+  const uint8_t psize = tab.ptr_size_;
+  const auto word = [&tab, psize] (uint32_t idx) {
+    return tab.read_ptr(8 + idx * psize);
+  };
+
+  uint64_t nb_func = 0;
+  switch (tab.version_) {
+    case VERSION::GO_1_2:
+      {
+        nb_func = word(0);
+        tab.functab_ = 8 + psize;
+        break;
+      }
+
+    case VERSION::GO_1_16:
+      {
+        nb_func          = word(0);
+        tab.nb_files_    = static_cast<uint32_t>(word(1));
+        tab.funcnametab_ = word(2);
+        tab.cutab_       = word(3);
+        tab.filetab_     = word(4);
+        tab.pctab_       = word(5);
+        tab.functab_     = word(6);
+        break;
+      }
+
+    case VERSION::GO_1_18:
+    case VERSION::GO_1_20:
+      {
+        nb_func          = word(0);
+        tab.nb_files_    = static_cast<uint32_t>(word(1));
+        tab.text_start_  = word(2);
+        tab.funcnametab_ = word(3);
+        tab.cutab_       = word(4);
+        tab.filetab_     = word(5);
+        tab.pctab_       = word(6);
+        tab.functab_     = word(7);
+        // The field is relocated at load time for the PIE binaries
+        if (tab.text_start_ == 0) {
+          tab.text_start_ = text_start;
+        }
+        break;
+      }
+
+    case VERSION::UNKNOWN:
+      return make_error_code(lief_errors::file_format_error);
+  }
+
+  const uint64_t field_size = tab.version_ >= VERSION::GO_1_18 ? 4 : psize;
+  // The functab is followed by the end address of the last function
+  if (nb_func == 0 || tab.functab_ > raw.size() ||
+      (raw.size() - tab.functab_) / field_size < 2 * nb_func + 1)
+  {
+    LIEF_DEBUG("Go pclntab: functab out of bounds (#{} functions)", nb_func);
+    return make_error_code(lief_errors::corrupted);
+  }
+  tab.nb_func_ = static_cast<uint32_t>(nb_func);
+
+  if (tab.version_ == VERSION::GO_1_2) {
+    tab.filetab_ = tab.read_u32(tab.functab_ + (2 * nb_func + 1) * field_size);
+    tab.nb_files_ = tab.read_u32(tab.filetab_);
+  }
+
+  if (tab.funcnametab_ > raw.size() || tab.cutab_ > raw.size() ||
+      tab.filetab_ > raw.size() || tab.pctab_ > raw.size())
+  {
+    LIEF_DEBUG("Go pclntab: sub-table out of bounds");
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  if (tab.version_ < VERSION::GO_1_18 && tab.end(tab.nb_func_ - 1) == 0) {
+    LIEF_WARN("The Go pclntab is not relocated (position-independent binary?)");
+    return make_error_code(lief_errors::not_supported);
+  }
+  return tab;
+}
+
+result<size_t> GoPclntab::find(span<const uint8_t> data) {
+  // The table is aligned on (at least) 4 bytes
+  for (size_t offset = 0; offset + 16 <= data.size(); offset += 4) {
+    if (!check_header(data, offset)) {
+      continue;
+    }
+    auto tab = parse(data.subspan(offset));
+    if (!tab) {
+      continue;
+    }
+    // Discard the false positives: the entries are sorted and the
+    // functions are named
+    const uint32_t nb_checked = std::min(tab->nb_func_, NB_CHECKED_ENTRIES);
+    bool is_valid = tab->end(tab->nb_func_ - 1) > tab->entry(0);
+    for (uint32_t i = 0; is_valid && i < nb_checked; ++i) {
+      is_valid = tab->entry(i) <= tab->entry(i + 1) && !tab->name(i).empty();
+    }
+    if (is_valid) {
+      return offset;
+    }
+  }
+  return make_error_code(lief_errors::not_found);
+}
+
+bool GoPclntab::is_go(const Binary& bin) {
+  for (const Section& section : bin.sections()) {
+    const std::string& name = section.name();
+    if (name == ".go.buildinfo" || name == "__go_buildinfo" ||
+        name == ".note.go.buildid" || name == ".gopclntab" ||
+        name == "__gopclntab")
+    {
+      return true;
+    }
+    // The linker puts the build ID at the beginning of the text (after
+    // some thunks on x86) and the build info at the beginning of the data
+    if (name == ".text" || name == "__text") {
+      span<const uint8_t> content = section.content();
+      content = content.first(std::min(content.size(), BUILDID_WINDOW));
+      if (contains(content, GO_BUILDID_PREFIX, sizeof(GO_BUILDID_PREFIX) - 1)) {
+        return true;
+      }
+    }
+    if (name == ".data") {
+      span<const uint8_t> content = section.content();
+      const size_t len = sizeof(GO_BUILDINFO_MAGIC) - 1;
+      if (content.size() >= len &&
+          std::memcmp(content.data(), GO_BUILDINFO_MAGIC, len) == 0)
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+result<GoPclntab> GoPclntab::from_binary(const Binary& bin) {
+  // PE sections are addressed relatively to the imagebase
+  const uint64_t base = bin.format() == Binary::FORMATS::PE ? bin.imagebase() : 0;
+
+  uint64_t text_start = 0;
+  for (const Section& section : bin.sections()) {
+    const std::string& name = section.name();
+    if (name == ".text" || name == "__text") {
+      text_start = base + section.virtual_address();
+      break;
+    }
+  }
+
+  for (const Section& section : bin.sections()) {
+    const std::string& name = section.name();
+    if (name == ".gopclntab" || name == ".data.rel.ro.gopclntab" ||
+        name == "__gopclntab")
+    {
+      return parse(section.content(), base + section.virtual_address(), text_start);
+    }
+  }
+
+  // Stripped binaries (e.g. PE) don't name the section of the table
+  if (!is_go(bin)) {
+    return make_error_code(lief_errors::not_found);
+  }
+
+  for (const Section& section : bin.sections()) {
+    const std::string& name = section.name();
+    if (name == ".text" || name == "__text") {
+      continue;
+    }
+    span<const uint8_t> content = section.content();
+    if (auto offset = find(content)) {
+      LIEF_DEBUG("Go pclntab found in {} (offset: 0x{:x})", name, *offset);
+      return parse(content.subspan(*offset),
+                   base + section.virtual_address() + *offset, text_start);
+    }
+  }
+  return make_error_code(lief_errors::not_found);
+}
+
+uint32_t GoPclntab::read_u32(uint64_t offset) const {
+  return static_cast<uint32_t>(read_uint(raw_, offset, sizeof(uint32_t), big_endian_));
+}
+
+uint64_t GoPclntab::read_ptr(uint64_t offset) const {
+  return read_uint(raw_, offset, ptr_size_, big_endian_);
+}
+
+uint64_t GoPclntab::read_field(uint64_t offset) const {
+  // Since Go 1.18, the functab stores 32-bit offsets instead of pointers
+  return version_ >= VERSION::GO_1_18 ? read_u32(offset) : read_ptr(offset);
+}
+
+std::string GoPclntab::read_str(uint64_t offset) const {
+  if (offset >= raw_.size()) {
+    return "";
+  }
+  const auto* start = reinterpret_cast<const char*>(raw_.data() + offset);
+  const size_t max_len = raw_.size() - offset;
+  const auto* nul = static_cast<const char*>(std::memchr(start, '\0', max_len));
+  return std::string(start, nul != nullptr ? nul - start : max_len);
+}
+
+uint64_t GoPclntab::entry(uint32_t idx) const {
+  if (idx > nb_func_) {
+    return 0;
+  }
+  const uint64_t field_size = version_ >= VERSION::GO_1_18 ? 4 : ptr_size_;
+  const uint64_t value = read_field(functab_ + 2 * uint64_t(idx) * field_size);
+  return version_ >= VERSION::GO_1_18 ? text_start_ + value : value;
+}
+
+uint64_t GoPclntab::end(uint32_t idx) const {
+  return idx < nb_func_ ? entry(idx + 1) : 0;
+}
+
+uint64_t GoPclntab::func_offset(uint32_t idx) const {
+  const uint64_t field_size = version_ >= VERSION::GO_1_18 ? 4 : ptr_size_;
+  const uint64_t offset = read_field(functab_ + (2 * uint64_t(idx) + 1) * field_size);
+  // Go 1.2 offsets are relative to the beginning of the table
+  return version_ == VERSION::GO_1_2 ? offset : functab_ + offset;
+}
+
+std::string GoPclntab::name(uint32_t idx) const {
+  if (idx >= nb_func_) {
+    return "";
+  }
+  // _func: entry (uintptr or uint32 since Go 1.18), nameoff (int32), ...
+  const uint64_t entry_size = version_ >= VERSION::GO_1_18 ? 4 : ptr_size_;
+  const uint32_t nameoff = read_u32(func_offset(idx) + entry_size);
+  return read_str(funcnametab_ + nameoff);
+}
+
+uint32_t GoPclntab::lookup(uint64_t address) const {
+  if (nb_func_ == 0 || address < entry(0) || address >= entry(nb_func_)) {
+    return NOT_FOUND;
+  }
+  uint32_t lo = 0;
+  uint32_t hi = nb_func_;
+  while (hi - lo > 1) {
+    const uint32_t mid = lo + (hi - lo) / 2;
+    if (entry(mid) <= address) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+int32_t GoPclntab::pcvalue(uint64_t offset, uint64_t entry, uint64_t target) const {
+  // Sequence of (value delta, pc delta) pairs: the value delta is a
+  // zig-zag varint, the pc delta is a varint scaled by the quantum
+  const auto read_varint = [this] (uint64_t& pos, uint32_t& value) {
+    value = 0;
+    for (uint32_t shift = 0; shift < 35; shift += 7) {
+      if (pos >= raw_.size()) {
+        return false;
+      }
+      const uint8_t byte = raw_[pos++];
+      value |= uint32_t(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  uint64_t pos = offset;
+  uint64_t pc = entry;
+  int32_t value = -1;
+  for (bool first = true;; first = false) {
+    uint32_t uvdelta = 0;
+    uint32_t pcdelta = 0;
+    if (!read_varint(pos, uvdelta) || (uvdelta == 0 && !first)) {
+      return -1;
+    }
+    const uint32_t vdelta = (uvdelta & 1) != 0 ? ~(uvdelta >> 1) : (uvdelta >> 1);
+    if (!read_varint(pos, pcdelta)) {
+      return -1;
+    }
+    pc += uint64_t(pcdelta) * quantum_;
+    value += static_cast<int32_t>(vdelta);
+    if (target < pc) {
+      return value;
+    }
+  }
+}
+
+result<GoPclntab::location_t> GoPclntab::location(uint64_t address) const {
+  const uint32_t idx = lookup(address);
+  if (idx == NOT_FOUND) {
+    return make_error_code(lief_errors::not_found);
+  }
+
+  // _func: entry, nameoff, args, deferreturn, pcsp, pcfile, pcln, npcdata, cuOffset
+  const uint64_t func = func_offset(idx);
+  const uint64_t entry_size = version_ >= VERSION::GO_1_18 ? 4 : ptr_size_;
+  const auto field = [&] (uint32_t n) {
+    return read_u32(func + entry_size + (n - 1) * sizeof(uint32_t));
+  };
+
+  const uint32_t pcfile = field(5);
+  const uint32_t pcln = field(6);
+  if (pcfile == 0 || pcln == 0) {
+    return make_error_code(lief_errors::not_found);
+  }
+
+  const uint64_t func_entry = entry(idx);
+  location_t loc;
+  loc.line = pcvalue(pctab_ + pcln, func_entry, address);
+  const int32_t fileno = pcvalue(pctab_ + pcfile, func_entry, address);
+
+  if (version_ == VERSION::GO_1_2) {
+    if (fileno > 0 && uint32_t(fileno) < nb_files_) {
+      loc.file = read_str(read_u32(filetab_ + 4 * uint64_t(fileno)));
+    }
+  } else if (fileno >= 0) {
+    const uint64_t cu_offset = field(8);
+    const uint32_t fnoff = read_u32(cutab_ + 4 * (cu_offset + fileno));
+    if (fnoff != uint32_t(-1)) {
+      loc.file = read_str(filetab_ + fnoff);
+    }
+  }
+  return loc;
+}
+
+std::vector<Function> GoPclntab::functions() const {
+  std::vector<Function> funcs;
+  funcs.reserve(nb_func_);
+  for (uint32_t i = 0; i < nb_func_; ++i) {
+    const uint64_t start = entry(i);
+    Function& func = funcs.emplace_back(name(i), start);
+    func.size(end(i) - start);
+  }
+  return funcs;
+}
+
+result<GoPclntab::moduledata_t> GoPclntab::moduledata(const Binary& bin) const {
+  if (address_ == 0) {
+    return make_error_code(lief_errors::not_found);
+  }
+  const uint64_t base = bin.format() == Binary::FORMATS::PE ? bin.imagebase() : 0;
+  const size_t psize = ptr_size_;
+
+  // moduledata starts with the pcHeader pointer followed by the funcnametab
+  // slice (Go 1.16+) or with the pclntable slice (Go 1.5 - 1.15)
+  const bool is_116 = version_ >= VERSION::GO_1_16;
+  const size_t minpc_idx = is_116 ? 20 : 10;
+
+  for (const Section& section : bin.sections()) {
+    const std::string& name = section.name();
+    if (name != ".noptrdata" && name != "__noptrdata" && name != ".data" &&
+        name != "__data")
+    {
+      continue;
+    }
+    span<const uint8_t> content = section.content();
+    const auto word = [&] (uint64_t offset, size_t idx) {
+      return read_uint(content, offset + idx * psize, psize, big_endian_);
+    };
+
+    for (uint64_t offset = 0; offset + (minpc_idx + 4) * psize <= content.size();
+         offset += psize)
+    {
+      if (word(offset, 0) != address_) {
+        continue;
+      }
+      const bool is_valid = is_116 ?
+        word(offset, 1) == address_ + funcnametab_ :
+        word(offset, 1) != 0 && word(offset, 1) == word(offset, 2) &&
+        word(offset, 1) <= raw_.size();
+      if (!is_valid) {
+        continue;
+      }
+      moduledata_t mod;
+      mod.address = base + section.virtual_address() + offset;
+      mod.minpc = word(offset, minpc_idx);
+      mod.maxpc = word(offset, minpc_idx + 1);
+      mod.text  = word(offset, minpc_idx + 2);
+      mod.etext = word(offset, minpc_idx + 3);
+      return mod;
+    }
+  }
+  return make_error_code(lief_errors::not_found);
+}
+
+const char* to_string(GoPclntab::VERSION e) {
+  #define ENTRY(X) std::pair(GoPclntab::VERSION::X, #X)
+  STRING_MAP enums2str {
+    ENTRY(UNKNOWN),
+    ENTRY(GO_1_2),
+    ENTRY(GO_1_16),
+    ENTRY(GO_1_18),
+    ENTRY(GO_1_20),
+  };
+  #undef ENTRY
+
+  if (auto it = enums2str.find(e); it != enums2str.end()) {
+    return it->second;
+  }
+  return "UNKNOWN";
+}
+
+}
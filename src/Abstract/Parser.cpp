@@ -20,6 +20,8 @@
 #include "LIEF/Abstract/Parser.hpp"
 #include "LIEF/Abstract/Binary.hpp"
 #include "LIEF/BinaryStream/BinaryStream.hpp"
+#include "LIEF/BinaryStream/CompressedStream.hpp"
+#include "LIEF/BinaryStream/FileStream.hpp"
 
 
 #if defined(LIEF_OAT_SUPPORT)
@@ -85,6 +87,13 @@ std::unique_ptr<Binary> Parser::parse(const std::string& filename) {
   }
 #endif
 
+  // Compressed file (e.g. .gz)
+  if (auto stream = FileStream::from_file(filename)) {
+    if (CompressedStream::detect(*stream) != CompressedStream::FORMAT::UNKNOWN) {
+      return parse(std::make_unique<FileStream>(std::move(*stream)));
+    }
+  }
+
   LIEF_ERR("Unknown format");
   return nullptr;
 }
@@ -152,6 +161,18 @@ std::unique_ptr<Binary> Parser::parse(std::unique_ptr<BinaryStream> stream) {
   }
 #endif
 
+  // Only one level of compression is supported: a compressed stream
+  // that wraps another compressed stream is rejected
+  if (!CompressedStream::classof(*stream) &&
+      CompressedStream::detect(*stream) != CompressedStream::FORMAT::UNKNOWN)
+  {
+    auto cstream = CompressedStream::from_stream(std::move(stream));
+    if (!cstream) {
+      return nullptr;
+    }
+    return parse(std::make_unique<CompressedStream>(std::move(*cstream)));
+  }
+
   LIEF_ERR("Unknown format");
   return nullptr;
 }
@@ -0,0 +1,93 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+
+#include "logging.hpp"
+#include "frozen.hpp"
+
+#include "LIEF/Abstract/ParserBudget.hpp"
+#include "Abstract/BudgetTracker.hpp"
+
+namespace LIEF {
+
+bool BudgetTracker::stage(const char* name) {
+  if (reason_ != TRUNCATION::NONE || !check()) {
+    return false;
+  }
+  LIEF_DEBUG("Parsing stage: {}", name);
+  if (budget_.progress) {
+    const size_t total = std::max<size_t>(nb_stages_, 1);
+    const float progress = std::min<float>(1.0f, float(stage_idx_) / float(total));
+    budget_.progress(name, progress);
+  }
+  ++stage_idx_;
+  return true;
+}
+
+bool BudgetTracker::check() {
+  if (budget_.cancellation.is_cancelled()) {
+    return stop(TRUNCATION::CANCELLED);
+  }
+  if (budget_.max_time > 0) {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        clock_t::now() - start_).count();
+    if (uint64_t(elapsed) > budget_.max_time) {
+      return stop(TRUNCATION::TIME);
+    }
+  }
+  return true;
+}
+
+ParserBudget BudgetTracker::remaining() const {
+  ParserBudget budget = budget_;
+  // The budgets can't drop to 0 which would mean unlimited
+  if (budget.max_time > 0) {
+    const auto elapsed = uint64_t(std::chrono::duration_cast<std::chrono::milliseconds>(
+        clock_t::now() - start_).count());
+    budget.max_time = elapsed < budget.max_time ? budget.max_time - elapsed : 1;
+  }
+  if (budget.max_memory > 0) {
+    budget.max_memory = memory_ < budget.max_memory ? budget.max_memory - memory_ : 1;
+  }
+  return budget;
+}
+
+bool BudgetTracker::stop(TRUNCATION reason) {
+  if (reason_ == TRUNCATION::NONE) {
+    LIEF_WARN("Parsing stopped before completion: {}", to_string(reason));
+    reason_ = reason;
+  }
+  return false;
+}
+
+const char* to_string(ParserBudget::TRUNCATION e) {
+  #define ENTRY(X) std::pair(ParserBudget::TRUNCATION::X, #X)
+  STRING_MAP enums2str {
+    ENTRY(NONE),
+    ENTRY(CANCELLED),
+    ENTRY(TIME),
+    ENTRY(MEMORY),
+    ENTRY(OBJECTS),
+  };
+  #undef ENTRY
+
+  if (auto it = enums2str.find(e); it != enums2str.end()) {
+    return it->second;
+  }
+  return "UNKNOWN";
+}
+
+}
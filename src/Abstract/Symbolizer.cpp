@@ -0,0 +1,194 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <limits>
+
+#include "LIEF/Abstract/Symbolizer.hpp"
+
+#include "logging.hpp"
+
+namespace LIEF {
+
+// Number of lookups that are performed in lockstep by the batch API
+static constexpr size_t NB_LANES = 8;
+
+uint32_t Symbolizer::name_idx(const std::string& name) {
+  if (name.empty()) {
+    return 0;
+  }
+  const auto it = names_map_.find(name);
+  if (it != names_map_.end()) {
+    return it->second;
+  }
+  const auto idx = static_cast<uint32_t>(names_.size());
+  names_.push_back(name);
+  names_map_.emplace(name, idx);
+  return idx;
+}
+
+void Symbolizer::add(uint64_t start, uint64_t size, const std::string& name) {
+  entries_.push_back({start, size, name_idx(name)});
+}
+
+void Symbolizer::finalize(uint64_t end) {
+  static constexpr uint64_t MAX_ADDR = std::numeric_limits<uint64_t>::max();
+
+  // For a given address, keep the named entry with the largest size
+  std::sort(entries_.begin(), entries_.end(),
+    [] (const entry_t& lhs, const entry_t& rhs) {
+      if (lhs.start != rhs.start) {
+        return lhs.start < rhs.start;
+      }
+      if ((lhs.name == 0) != (rhs.name == 0)) {
+        return lhs.name != 0;
+      }
+      return lhs.size > rhs.size;
+    });
+
+  entries_.erase(std::unique(entries_.begin(), entries_.end(),
+    [] (const entry_t& lhs, const entry_t& rhs) {
+      return lhs.start == rhs.start;
+    }), entries_.end());
+
+  starts_.clear();
+  ends_.clear();
+  names_idx_.clear();
+
+  starts_.reserve(entries_.size());
+  ends_.reserve(entries_.size());
+  names_idx_.reserve(entries_.size());
+
+  const auto push = [this] (uint64_t start, uint64_t end, uint32_t name) {
+    if (start >= end) {
+      return;
+    }
+    starts_.push_back(start);
+    ends_.push_back(end);
+    names_idx_.push_back(name);
+  };
+
+  // The ranges are clipped on the next start address so that they do not
+  // overlap. When a sized range encloses the following ones (e.g. a local
+  // label within a function), the uncovered tail is attributed to the
+  // enclosing range.
+  entry_t cover;
+  uint64_t cover_end = 0;
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    const entry_t& entry = entries_[i];
+    const uint64_t next = i + 1 < entries_.size() ? entries_[i + 1].start :
+                          end > entry.start       ? end : MAX_ADDR;
+
+    uint64_t raw_end = next;
+    if (entry.size > 0) {
+      raw_end = entry.size > MAX_ADDR - entry.start ? MAX_ADDR :
+                                                      entry.start + entry.size;
+    }
+    const uint64_t clipped = std::min(raw_end, next);
+    push(entry.start, clipped, entry.name);
+
+    if (cover_end > clipped) {
+      push(clipped, std::min(cover_end, next), cover.name);
+    }
+
+    if (entry.size > 0 && raw_end > cover_end) {
+      cover = entry;
+      cover_end = raw_end;
+    }
+  }
+
+  LIEF_DEBUG("Symbolizer: {} ranges ({} names)", starts_.size(), names_.size());
+
+  entries_.clear();
+  entries_.shrink_to_fit();
+  names_map_.clear();
+}
+
+uint32_t Symbolizer::lookup(uint64_t address) const {
+  const size_t nb_ranges = starts_.size();
+  if (nb_ranges == 0 || address < starts_[0]) {
+    return NOT_FOUND;
+  }
+
+  const uint64_t* base = starts_.data();
+  size_t len = nb_ranges;
+  while (len > 1) {
+    const size_t half = len / 2;
+    base += (base[half] <= address) ? half : 0;
+    len -= half;
+  }
+  const auto idx = static_cast<uint32_t>(base - starts_.data());
+  return address < ends_[idx] ? idx : NOT_FOUND;
+}
+
+void Symbolizer::lookup(const uint64_t* addresses, size_t count,
+                        uint32_t* indexes) const
+{
+  const size_t nb_ranges = starts_.size();
+  if (nb_ranges == 0) {
+    std::fill(indexes, indexes + count, NOT_FOUND);
+    return;
+  }
+
+  const uint64_t* starts = starts_.data();
+  size_t i = 0;
+
+  // As the length of the search interval only depends on the number of
+  // ranges, the lanes follow the same sequence of steps and their
+  // (independent) loads can be issued together.
+  for (; i + NB_LANES <= count; i += NB_LANES) {
+    const uint64_t* base[NB_LANES];
+    for (size_t l = 0; l < NB_LANES; ++l) {
+      base[l] = starts;
+    }
+
+    size_t len = nb_ranges;
+    while (len > 1) {
+      const size_t half = len / 2;
+      for (size_t l = 0; l < NB_LANES; ++l) {
+        base[l] += (base[l][half] <= addresses[i + l]) ? half : 0;
+      }
+      len -= half;
+    }
+
+    for (size_t l = 0; l < NB_LANES; ++l) {
+      const uint64_t address = addresses[i + l];
+      const auto idx = static_cast<uint32_t>(base[l] - starts);
+      const bool found = address >= starts[idx] && address < ends_[idx];
+      indexes[i + l] = found ? idx : NOT_FOUND;
+    }
+  }
+
+  for (; i < count; ++i) {
+    indexes[i] = lookup(addresses[i]);
+  }
+}
+
+std::vector<uint32_t> Symbolizer::lookup(const std::vector<uint64_t>& addresses) const {
+  std::vector<uint32_t> indexes(addresses.size(), NOT_FOUND);
+  lookup(addresses.data(), addresses.size(), indexes.data());
+  return indexes;
+}
+
+const std::string* Symbolizer::symbolize(uint64_t address) const {
+  const uint32_t idx = lookup(address);
+  if (idx == NOT_FOUND) {
+    return nullptr;
+  }
+  const std::string& value = name(idx);
+  return value.empty() ? nullptr : &value;
+}
+
+}
@@ -0,0 +1,566 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <unordered_map>
+
+#include "logging.hpp"
+#include "frozen.hpp"
+
+#include "LIEF/BinaryStream/CompressedStream.hpp"
+#include "LIEF/BinaryStream/FileStream.hpp"
+#include "LIEF/ZIP/utils.hpp"
+
+#include "BinaryStream/Inflate.hpp"
+
+namespace LIEF {
+
+static constexpr uint8_t GZIP_FHCRC    = 1 << 1;
+static constexpr uint8_t GZIP_FEXTRA   = 1 << 2;
+static constexpr uint8_t GZIP_FNAME    = 1 << 3;
+static constexpr uint8_t GZIP_FCOMMENT = 1 << 4;
+
+static constexpr size_t GZIP_TRAILER_SIZE = 8; // CRC32 + ISIZE
+
+// config_t::max_ratio is not checked below this decompressed size
+static constexpr uint64_t RATIO_MIN_SIZE = 1llu << 20;
+
+struct seek_point_t {
+  uint64_t bit_offset = 0; // Offset of a deflate block header
+  uint64_t out_offset = 0; // Decompressed offset of this block
+  std::vector<uint8_t> window;
+};
+
+struct CompressedStream::index_t {
+  using lru_t = std::list<size_t>;
+  using data_t = std::shared_ptr<const std::vector<uint8_t>>;
+  struct chunk_t {
+    data_t data;
+    lru_t::iterator it;
+  };
+
+  std::vector<seek_point_t> points;
+  size_t cache_size = 0;
+
+  lru_t lru;
+  std::unordered_map<size_t, chunk_t> chunks;
+
+  // Data referenced by the pointers returned by the last read_at() calls.
+  // A chunk evicted from the LRU cache stays alive while it is referenced.
+  std::deque<data_t> leases;
+};
+
+static uint32_t adler32(span<const uint8_t> data, uint32_t adler) {
+  static constexpr uint32_t BASE = 65521;
+  // Largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1
+  static constexpr size_t NMAX = 5552;
+  uint32_t a = adler & 0xffff;
+  uint32_t b = adler >> 16;
+  while (!data.empty()) {
+    const size_t count = std::min(data.size(), NMAX);
+    for (uint8_t byte : data.subspan(0, count)) {
+      a += byte;
+      b += a;
+    }
+    a %= BASE;
+    b %= BASE;
+    data = data.subspan(count);
+  }
+  return (b << 16) | a;
+}
+
+// Return the offset of the deflate data that follows the gzip header
+// located at the given offset
+static result<uint64_t> parse_gzip_header(BinaryStream& stream, uint64_t offset) {
+  ScopedStream scoped(stream, offset);
+  auto id1 = scoped->read<uint8_t>();
+  auto id2 = scoped->read<uint8_t>();
+  auto cm  = scoped->read<uint8_t>();
+  auto flg = scoped->read<uint8_t>();
+  if (!id1 || !id2 || !cm || !flg || *id1 != 0x1f || *id2 != 0x8b) {
+    return make_error_code(lief_errors::file_format_error);
+  }
+  if (*cm != 8) {
+    LIEF_ERR("Unsupported gzip compression method: {}", *cm);
+    return make_error_code(lief_errors::not_supported);
+  }
+  scoped->increment_pos(/* MTIME */ 4 + /* XFL */ 1 + /* OS */ 1);
+
+  if (*flg & GZIP_FEXTRA) {
+    auto xlen = scoped->read<uint16_t>();
+    if (!xlen) {
+      return make_error_code(lief_errors::read_error);
+    }
+    scoped->increment_pos(*xlen);
+  }
+
+  if (*flg & GZIP_FNAME) {
+    if (!scoped->read_string()) {
+      return make_error_code(lief_errors::read_error);
+    }
+  }
+
+  if (*flg & GZIP_FCOMMENT) {
+    if (!scoped->read_string()) {
+      return make_error_code(lief_errors::read_error);
+    }
+  }
+
+  if (*flg & GZIP_FHCRC) {
+    scoped->increment_pos(2);
+  }
+
+  if (scoped->pos() >= stream.size()) {
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  return scoped->pos();
+}
+
+// Drive the Inflater over the members of the compressed stream
+class Decoder {
+  public:
+  // If ``verify`` is true, the decoder must start at the beginning of the
+  // stream and the trailer of each member is checked
+  Decoder(BinaryStream& raw, CompressedStream::FORMAT fmt,
+          const seek_point_t& point, bool verify = false) :
+    raw_(raw),
+    fmt_(fmt),
+    inflater_(raw, point.bit_offset, point.window),
+    verify_(verify)
+  {}
+
+  // Decode the next block. Return false at the end of the stream.
+  result<bool> next() {
+    if (done_) {
+      return false;
+    }
+    if (inflater_.is_final()) {
+      auto has_member = next_member();
+      if (!has_member) {
+        return make_error_code(get_error(has_member));
+      }
+      if (!*has_member) {
+        done_ = true;
+        return false;
+      }
+    }
+    if (auto is_ok = inflater_.next_block(); !is_ok) {
+      return make_error_code(get_error(is_ok));
+    }
+    if (verify_) {
+      span<const uint8_t> out = inflater_.output();
+      checksum_ = fmt_ == CompressedStream::FORMAT::ZLIB ?
+                  adler32(out, checksum_) : ZIP::crc32(out, checksum_);
+      member_size_ += out.size();
+    }
+    return true;
+  }
+
+  // Whether the reader is located on the header of a block that belongs to
+  // the current member
+  bool on_block_header() const {
+    return !inflater_.is_final();
+  }
+
+  uint64_t bit_offset() {
+    return inflater_.reader().bit_offset();
+  }
+
+  details::Inflater& inflater() {
+    return inflater_;
+  }
+
+  private:
+  // Check the trailer of the current member and move to the next one
+  // (if any)
+  result<bool> next_member() {
+    details::BitReader& reader = inflater_.reader();
+    reader.align();
+    const uint64_t trailer = reader.bit_offset() / 8;
+    if (verify_ && !check_trailer(trailer)) {
+      return make_error_code(lief_errors::corrupted);
+    }
+
+    if (fmt_ != CompressedStream::FORMAT::GZIP) {
+      return false;
+    }
+    const uint64_t next = trailer + GZIP_TRAILER_SIZE;
+    if (next + 2 > raw_.size()) {
+      return false;
+    }
+    // Concatenated gzip files (e.g. produced by pigz or bgzip)
+    auto data_offset = parse_gzip_header(raw_, next);
+    if (!data_offset) {
+      LIEF_DEBUG("Trailing data after the gzip member at 0x{:x}", next);
+      return false;
+    }
+    inflater_.restart(*data_offset * 8);
+    checksum_ = 0;
+    member_size_ = 0;
+    return true;
+  }
+
+  bool check_trailer(uint64_t offset) {
+    if (fmt_ == CompressedStream::FORMAT::ZLIB) {
+      ScopedStream scoped(raw_, offset);
+      scoped->set_endian_swap(true);
+      auto adler = scoped->read_conv<uint32_t>();
+      if (!adler || *adler != checksum_) {
+        LIEF_ERR("zlib stream: Adler-32 mismatch");
+        return false;
+      }
+      return true;
+    }
+
+    auto crc   = raw_.peek<uint32_t>(offset);
+    auto isize = raw_.peek<uint32_t>(offset + sizeof(uint32_t));
+    if (!crc || !isize) {
+      LIEF_ERR("gzip member: missing trailer at 0x{:x}", offset);
+      return false;
+    }
+    if (*crc != checksum_) {
+      LIEF_ERR("gzip member: CRC-32 mismatch (0x{:08x} vs 0x{:08x})", *crc, checksum_);
+      return false;
+    }
+    if (*isize != static_cast<uint32_t>(member_size_)) {
+      LIEF_ERR("gzip member: size mismatch (0x{:x} vs 0x{:x})", *isize, member_size_);
+      return false;
+    }
+    return true;
+  }
+
+  BinaryStream& raw_;
+  CompressedStream::FORMAT fmt_;
+  details::Inflater inflater_;
+  bool verify_ = false;
+  bool done_ = false;
+  // Adler-32 starts from 1
+  uint32_t checksum_ = fmt_ == CompressedStream::FORMAT::ZLIB ? 1 : 0;
+  uint64_t member_size_ = 0;
+};
+
+CompressedStream::CompressedStream(std::unique_ptr<BinaryStream> raw, FORMAT fmt) :
+  BinaryStream(STREAM_TYPE::COMPRESSED),
+  raw_(std::move(raw)),
+  index_(std::make_unique<index_t>()),
+  format_(fmt)
+{}
+
+CompressedStream::CompressedStream(CompressedStream&& other) noexcept = default;
+CompressedStream& CompressedStream::operator=(CompressedStream&& other) noexcept = default;
+CompressedStream::~CompressedStream() = default;
+
+CompressedStream::FORMAT CompressedStream::detect(BinaryStream& stream, bool zlib) {
+  ScopedStream scoped(stream, 0);
+  std::vector<uint8_t> magic;
+  if (!scoped->peek_data(magic, 0, std::min<uint64_t>(6, stream.size()))) {
+    return FORMAT::UNKNOWN;
+  }
+
+  if (magic.size() >= 3 && magic[0] == 0x1f && magic[1] == 0x8b && magic[2] == 8) {
+    return FORMAT::GZIP;
+  }
+
+  if (magic.size() >= 4 && magic[0] == 0x28 && magic[1] == 0xb5 &&
+      magic[2] == 0x2f && magic[3] == 0xfd)
+  {
+    return FORMAT::ZSTD;
+  }
+
+  static constexpr uint8_t XZ_MAGIC[] = {0xfd, '7', 'z', 'X', 'Z', 0x00};
+  if (magic.size() >= sizeof(XZ_MAGIC) &&
+      std::equal(std::begin(XZ_MAGIC), std::end(XZ_MAGIC), magic.begin()))
+  {
+    return FORMAT::XZ;
+  }
+
+  // CMF/FLG: deflate with a window <= 32K and a valid FCHECK
+  if (zlib && magic.size() >= 2 && (magic[0] & 0x0f) == 8 && (magic[0] >> 4) <= 7 &&
+      ((uint32_t(magic[0]) << 8) | magic[1]) % 31 == 0)
+  {
+    return FORMAT::ZLIB;
+  }
+  return FORMAT::UNKNOWN;
+}
+
+result<CompressedStream> CompressedStream::from_file(const std::string& file,
+                                                     const config_t& config)
+{
+  auto stream = FileStream::from_file(file);
+  if (!stream) {
+    return make_error_code(get_error(stream));
+  }
+  return from_stream(std::make_unique<FileStream>(std::move(*stream)), config);
+}
+
+result<CompressedStream> CompressedStream::from_stream(std::unique_ptr<BinaryStream> stream,
+                                                       const config_t& config)
+{
+  const FORMAT fmt = detect(*stream, config.zlib);
+  uint64_t data_offset = 0;
+  switch (fmt) {
+    case FORMAT::GZIP:
+      {
+        auto offset = parse_gzip_header(*stream, 0);
+        if (!offset) {
+          return make_error_code(get_error(offset));
+        }
+        data_offset = *offset;
+        break;
+      }
+
+    case FORMAT::ZLIB:
+      {
+        const auto flg = stream->peek<uint8_t>(1);
+        if (!flg || (*flg & 0x20) != 0) {
+          LIEF_ERR("zlib streams with a preset dictionary are not supported");
+          return make_error_code(lief_errors::not_supported);
+        }
+        data_offset = 2;
+        break;
+      }
+
+    case FORMAT::ZSTD:
+    case FORMAT::XZ:
+      {
+        LIEF_ERR("{} streams are not supported (only deflate-based formats are)",
+                 to_string(fmt));
+        return make_error_code(lief_errors::not_supported);
+      }
+
+    case FORMAT::UNKNOWN:
+      {
+        LIEF_ERR("Unknown compression format");
+        return make_error_code(lief_errors::file_format_error);
+      }
+  }
+
+  CompressedStream cstream(std::move(stream), fmt);
+  index_t& index = *cstream.index_;
+  index.cache_size = std::max<size_t>(config.cache_size, 1);
+  const uint64_t index_span = std::max<uint64_t>(config.index_span, details::Inflater::WINDOW_SIZE);
+
+  uint64_t max_size = config.max_size == 0 ? UINT64_MAX : config.max_size;
+  if (config.max_ratio > 0) {
+    const uint64_t raw_size = cstream.raw_->size();
+    if (raw_size <= (UINT64_MAX - RATIO_MIN_SIZE) / config.max_ratio) {
+      max_size = std::min(max_size,
+                          std::max(RATIO_MIN_SIZE, raw_size * config.max_ratio));
+    }
+  }
+
+  seek_point_t start;
+  start.bit_offset = data_offset * 8;
+
+  // First pass: decompress the whole stream to record the seek points.
+  // The limit is enforced by the inflater while a block is decoded so that
+  // a single (huge) block can't exhaust the memory.
+  Decoder decoder(*cstream.raw_, fmt, start, config.check_integrity);
+  decoder.inflater().set_limit(max_size);
+  index.points.push_back(std::move(start));
+  uint64_t out_offset = 0;
+  uint64_t last_point = 0;
+  while (true) {
+    auto has_block = decoder.next();
+    if (!has_block) {
+      if (get_error(has_block) == lief_errors::data_too_large) {
+        LIEF_ERR("The decompressed data exceed the limit of 0x{:x} bytes "
+                 "(compressed size: 0x{:x})", max_size, cstream.raw_->size());
+      } else {
+        LIEF_ERR("Error while decompressing the {} stream at 0x{:x}",
+                 to_string(fmt), decoder.bit_offset() / 8);
+      }
+      return make_error_code(get_error(has_block));
+    }
+    if (!*has_block) {
+      break;
+    }
+    details::Inflater& inflater = decoder.inflater();
+    out_offset += inflater.output().size();
+
+    if (out_offset - last_point >= index_span && decoder.on_block_header()) {
+      span<const uint8_t> window = inflater.window();
+      seek_point_t point;
+      point.bit_offset = decoder.bit_offset();
+      point.out_offset = out_offset;
+      point.window = {window.begin(), window.end()};
+      index.points.push_back(std::move(point));
+      last_point = out_offset;
+    }
+    inflater.consume();
+  }
+
+  cstream.size_ = out_offset;
+  LIEF_DEBUG("{} stream: 0x{:x} bytes, {} seek points", to_string(fmt),
+             out_offset, index.points.size());
+  return cstream;
+}
+
+size_t CompressedStream::nb_seek_points() const {
+  return index_->points.size();
+}
+
+CompressedStream::data_t CompressedStream::chunk(size_t idx) const {
+  index_t& index = *index_;
+  if (auto it = index.chunks.find(idx); it != index.chunks.end()) {
+    index.lru.splice(index.lru.begin(), index.lru, it->second.it);
+    return it->second.data;
+  }
+
+  const seek_point_t& point = index.points[idx];
+  const uint64_t end = idx + 1 < index.points.size() ?
+                       index.points[idx + 1].out_offset : size_;
+  const uint64_t chunk_size = end - point.out_offset;
+
+  auto data = std::make_shared<std::vector<uint8_t>>();
+  data->reserve(chunk_size);
+  Decoder decoder(*raw_, format_, point);
+  // The chunk ends on a block boundary: the decoder never needs to produce
+  // more than the size recorded in the index
+  decoder.inflater().set_limit(chunk_size);
+  while (data->size() < chunk_size) {
+    auto has_block = decoder.next();
+    if (!has_block || !*has_block) {
+      LIEF_ERR("Can't decompress the chunk #{:d}", idx);
+      return nullptr;
+    }
+    span<const uint8_t> out = decoder.inflater().output();
+    data->insert(data->end(), out.begin(), out.end());
+    decoder.inflater().consume();
+  }
+
+  if (index.chunks.size() >= index.cache_size) {
+    index.chunks.erase(index.lru.back());
+    index.lru.pop_back();
+  }
+  index.lru.push_front(idx);
+  auto& chunk = index.chunks[idx];
+  chunk.data = std::move(data);
+  chunk.it = index.lru.begin();
+  return chunk.data;
+}
+
+ok_error_t CompressedStream::peek_in(void* dst, uint64_t offset, uint64_t size,
+                                     uint64_t /* virtual_address */) const
+{
+  if (offset > size_ || size > size_ - offset) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  const std::vector<seek_point_t>& points = index_->points;
+  auto* out = static_cast<uint8_t*>(dst);
+  while (size > 0) {
+    const auto it = std::upper_bound(points.begin(), points.end(), offset,
+      [] (uint64_t value, const seek_point_t& point) {
+        return value < point.out_offset;
+      });
+    const size_t idx = std::distance(points.begin(), it) - 1;
+
+    const data_t data = chunk(idx);
+    if (data == nullptr) {
+      return make_error_code(lief_errors::corrupted);
+    }
+
+    const uint64_t delta = offset - points[idx].out_offset;
+    const uint64_t count = std::min<uint64_t>(size, data->size() - delta);
+    memcpy(out, data->data() + delta, count);
+    out += count;
+    offset += count;
+    size -= count;
+  }
+  return ok();
+}
+
+result<const void*> CompressedStream::read_at(uint64_t offset, uint64_t size,
+                                              uint64_t /* virtual_address */) const
+{
+  if (offset > size_ || size > size_ - offset) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  const std::vector<seek_point_t>& points = index_->points;
+  const auto it = std::upper_bound(points.begin(), points.end(), offset,
+    [] (uint64_t value, const seek_point_t& point) {
+      return value < point.out_offset;
+    });
+  const size_t idx = std::distance(points.begin(), it) - 1;
+  const uint64_t chunk_end = it != points.end() ? it->out_offset : size_;
+
+  index_t& index = *index_;
+  data_t data;
+  const uint8_t* ptr = nullptr;
+  if (offset + size <= chunk_end) {
+    // Fast path: the range is covered by a single chunk
+    data = chunk(idx);
+    if (data == nullptr) {
+      return make_error_code(lief_errors::corrupted);
+    }
+    ptr = data->data() + (offset - points[idx].out_offset);
+  } else {
+    auto copy = std::make_shared<std::vector<uint8_t>>(size);
+    if (!peek_in(copy->data(), offset, size)) {
+      return make_error_code(lief_errors::read_error);
+    }
+    ptr = copy->data();
+    data = std::move(copy);
+  }
+
+  index.leases.push_back(std::move(data));
+  if (index.leases.size() > READ_AT_LEASES) {
+    index.leases.pop_front();
+  }
+  return ptr;
+}
+
+std::vector<uint8_t> CompressedStream::content() const {
+  // Decode the stream sequentially (without going through the chunk cache)
+  std::vector<uint8_t> data;
+  data.reserve(size_);
+  Decoder decoder(*raw_, format_, index_->points.front());
+  decoder.inflater().set_limit(size_);
+  while (data.size() < size_) {
+    auto has_block = decoder.next();
+    if (!has_block || !*has_block) {
+      LIEF_ERR("Can't decompress the {} stream", to_string(format_));
+      return {};
+    }
+    span<const uint8_t> out = decoder.inflater().output();
+    data.insert(data.end(), out.begin(), out.end());
+    decoder.inflater().consume();
+  }
+  return data;
+}
+
+const char* to_string(CompressedStream::FORMAT e) {
+  #define ENTRY(X) std::pair(CompressedStream::FORMAT::X, #X)
+  STRING_MAP enums2str {
+    ENTRY(UNKNOWN),
+    ENTRY(GZIP),
+    ENTRY(ZLIB),
+    ENTRY(ZSTD),
+    ENTRY(XZ),
+  };
+  #undef ENTRY
+
+  if (auto it = enums2str.find(e); it != enums2str.end()) {
+    return it->second;
+  }
+  return "UNKNOWN";
+}
+
+}
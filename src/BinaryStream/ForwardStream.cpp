@@ -0,0 +1,167 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "logging.hpp"
+
+#include "LIEF/BinaryStream/ForwardStream.hpp"
+
+namespace LIEF {
+
+static constexpr size_t READ_CHUNK = 0x10000;
+
+ForwardStream::ForwardStream(read_fn_t reader, const config_t& config) :
+  BinaryStream(STREAM_TYPE::FORWARD),
+  reader_(std::move(reader)),
+  size_(config.size),
+  max_buffer_(config.max_buffer)
+{}
+
+ForwardStream ForwardStream::from_istream(std::istream& is, const config_t& config) {
+  return ForwardStream([&is] (uint8_t* dst, size_t size) -> size_t {
+    is.read(reinterpret_cast<char*>(dst), size);
+    return static_cast<size_t>(is.gcount());
+  }, config);
+}
+
+ok_error_t ForwardStream::fill(uint64_t end) const {
+  if (max_buffer_ > 0 && end > max_buffer_) {
+    LIEF_ERR("Can't buffer 0x{:x} bytes (limit: 0x{:x})", end, max_buffer_);
+    return make_error_code(lief_errors::data_too_large);
+  }
+
+  while (buffer_.size() < end && !eof_) {
+    const size_t offset = buffer_.size();
+    if (size_ > 0 && offset >= size_) {
+      eof_ = true;
+      break;
+    }
+    uint64_t chunk = READ_CHUNK;
+    // Do not consume more than needed: the data that follow the input
+    // (or that exceed the limit) must stay in the source
+    if (size_ > 0) {
+      chunk = std::min<uint64_t>(chunk, size_ - offset);
+    }
+    if (max_buffer_ > 0) {
+      chunk = std::min<uint64_t>(chunk, max_buffer_ - offset);
+    }
+    if (chunk == 0) {
+      break;
+    }
+    buffer_.resize(offset + chunk);
+    const size_t nb_read = reader_(buffer_.data() + offset, chunk);
+    buffer_.resize(offset + nb_read);
+    if (nb_read == 0) {
+      eof_ = true;
+    }
+  }
+
+  if (buffer_.size() < end) {
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  return ok();
+}
+
+uint64_t ForwardStream::size() const {
+  if (size_ > 0) {
+    return size_;
+  }
+  if (!eof_) {
+    LIEF_DEBUG("ForwardStream: unknown size, consuming the whole input");
+    if (!fill_to_end()) {
+      LIEF_WARN("The input is larger than the buffer limit (0x{:x}) and "
+                "has been truncated", max_buffer_);
+    }
+    size_ = buffer_.size();
+  }
+  return buffer_.size();
+}
+
+ok_error_t ForwardStream::fill_to_end() const {
+  if (size_ > 0) {
+    if (buffer_.size() < size_ && drained_ > 0) {
+      LIEF_ERR("The input has been drained");
+      return make_error_code(lief_errors::read_error);
+    }
+    return fill(size_);
+  }
+  fill(max_buffer_ > 0 ? max_buffer_ : std::numeric_limits<uint64_t>::max());
+  if (!eof_) {
+    return make_error_code(lief_errors::data_too_large);
+  }
+  return ok();
+}
+
+uint64_t ForwardStream::drain(const drain_fn_t& fn) {
+  uint64_t total = 0;
+  std::vector<uint8_t> chunk(READ_CHUNK);
+  while (!eof_) {
+    size_t count = chunk.size();
+    if (size_ > 0) {
+      // Do not consume the data that follow the input
+      const uint64_t consumed = buffer_.size() + drained_ + total;
+      if (consumed >= size_) {
+        eof_ = true;
+        break;
+      }
+      count = std::min<uint64_t>(count, size_ - consumed);
+    }
+    const size_t nb_read = reader_(chunk.data(), count);
+    if (nb_read == 0) {
+      eof_ = true;
+      break;
+    }
+    fn({chunk.data(), nb_read});
+    total += nb_read;
+  }
+  drained_ += total;
+  return total;
+}
+
+ok_error_t ForwardStream::peek_in(void* dst, uint64_t offset, uint64_t size,
+                                  uint64_t /* virtual_address */) const
+{
+  auto raw = read_at(offset, size);
+  if (!raw) {
+    return make_error_code(get_error(raw));
+  }
+  memcpy(dst, *raw, size);
+  return ok();
+}
+
+result<const void*> ForwardStream::read_at(uint64_t offset, uint64_t size,
+                                           uint64_t /* virtual_address */) const
+{
+  const uint64_t end = offset + size;
+  if (end < offset || (size_ > 0 && end > size_)) {
+    return make_error_code(lief_errors::read_error);
+  }
+  if (end > buffer_.size()) {
+    if (drained_ > 0) {
+      LIEF_ERR("Can't read 0x{:x} bytes at 0x{:x}: the input has been drained",
+               size, offset);
+      return make_error_code(lief_errors::read_error);
+    }
+    if (!fill(end)) {
+      return make_error_code(lief_errors::read_error);
+    }
+  }
+  return buffer_.data() + offset;
+}
+
+}
@@ -0,0 +1,366 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+
+#include "BinaryStream/Inflate.hpp"
+#include "LIEF/BinaryStream/BinaryStream.hpp"
+
+#include "logging.hpp"
+
+namespace LIEF::details {
+
+static constexpr uint32_t MAX_BITS   = 15;
+static constexpr uint32_t FAST_BITS  = 9;
+static constexpr size_t MAX_LCODES   = 286;
+static constexpr size_t MAX_DCODES   = 30;
+static constexpr size_t FIXED_LCODES = 288;
+
+BitReader::BitReader(BinaryStream& stream, uint64_t bit_offset) :
+  stream_(&stream),
+  size_(stream.size())
+{
+  seek(bit_offset);
+}
+
+void BitReader::seek(uint64_t bit_offset) {
+  pos_ = bit_offset / 8;
+  acc_ = 0;
+  nbits_ = 0;
+  if (const uint32_t shift = bit_offset % 8) {
+    ensure(8);
+    drop(shift);
+  }
+}
+
+uint8_t BitReader::next_byte() {
+  if (pos_ >= size_) {
+    ++pos_;
+    return 0;
+  }
+  if (pos_ < chunk_offset_ || pos_ >= chunk_offset_ + chunk_.size()) {
+    const uint64_t size = std::min<uint64_t>(CHUNK_SIZE, size_ - pos_);
+    if (!stream_->peek_data(chunk_, pos_, size)) {
+      chunk_.clear();
+      pos_ = size_ + 1;
+      return 0;
+    }
+    chunk_offset_ = pos_;
+  }
+  return chunk_[pos_++ - chunk_offset_];
+}
+
+// Canonical Huffman code as described in RFC 1951 (3.2.2). Codes that are
+// shorter than FAST_BITS are resolved with a single table lookup
+// (indexed with the bit-reversed code) while the other ones are decoded
+// bit by bit from the count/symbol tables.
+struct Inflater::huffman_t {
+  std::array<uint16_t, MAX_BITS + 1> count = {};
+  std::array<uint16_t, FIXED_LCODES> symbol = {};
+  std::array<uint16_t, 1 << FAST_BITS> fast = {};
+
+  // Return 0 for a complete code, a negative value for an over-subscribed
+  // code and a positive value for an incomplete code
+  int build(const uint16_t* lengths, size_t nb_codes) {
+    count.fill(0);
+    fast.fill(0);
+    for (size_t i = 0; i < nb_codes; ++i) {
+      ++count[lengths[i]];
+    }
+    if (count[0] == nb_codes) {
+      return 0;
+    }
+
+    int left = 1;
+    for (uint32_t len = 1; len <= MAX_BITS; ++len) {
+      left <<= 1;
+      left -= count[len];
+      if (left < 0) {
+        return left;
+      }
+    }
+
+    std::array<uint16_t, MAX_BITS + 1> offs = {};
+    std::array<uint16_t, MAX_BITS + 1> next = {};
+    uint32_t code = 0;
+    for (uint32_t len = 1; len < MAX_BITS; ++len) {
+      offs[len + 1] = offs[len] + count[len];
+    }
+    for (uint32_t len = 1; len <= MAX_BITS; ++len) {
+      code = (code + (len > 1 ? count[len - 1] : 0)) << 1;
+      next[len] = static_cast<uint16_t>(code);
+    }
+
+    for (size_t sym = 0; sym < nb_codes; ++sym) {
+      const uint16_t len = lengths[sym];
+      if (len == 0) {
+        continue;
+      }
+      symbol[offs[len]++] = static_cast<uint16_t>(sym);
+      const uint32_t value = next[len]++;
+      if (len > FAST_BITS) {
+        continue;
+      }
+      uint32_t rev = 0;
+      for (uint32_t i = 0; i < len; ++i) {
+        rev |= ((value >> i) & 1) << (len - 1 - i);
+      }
+      for (uint32_t i = rev; i < (1u << FAST_BITS); i += (1u << len)) {
+        fast[i] = static_cast<uint16_t>(sym | (len << 9));
+      }
+    }
+    return left;
+  }
+
+  int decode(BitReader& reader) const {
+    if (const uint16_t entry = fast[reader.peek(FAST_BITS)]) {
+      reader.drop(entry >> 9);
+      return entry & 0x1ff;
+    }
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    for (uint32_t len = 1; len <= MAX_BITS; ++len) {
+      code |= static_cast<int>(reader.bits(1));
+      const int cnt = count[len];
+      if (code - cnt < first) {
+        return symbol[index + (code - first)];
+      }
+      index += cnt;
+      first += cnt;
+      first <<= 1;
+      code <<= 1;
+    }
+    return -1;
+  }
+};
+
+Inflater::Inflater(BinaryStream& stream, uint64_t bit_offset,
+                   span<const uint8_t> window) :
+  reader_(stream, bit_offset),
+  buffer_(window.begin(), window.end()),
+  start_(window.size())
+{}
+
+void Inflater::restart(uint64_t bit_offset) {
+  reader_.seek(bit_offset);
+  final_ = false;
+}
+
+void Inflater::consume() {
+  if (buffer_.size() > WINDOW_SIZE) {
+    buffer_.erase(buffer_.begin(), buffer_.end() - WINDOW_SIZE);
+  }
+  start_ = buffer_.size();
+}
+
+ok_error_t Inflater::next_block() {
+  final_ = reader_.bits(1) == 1;
+  const uint32_t type = reader_.bits(2);
+  ok_error_t res = make_error_code(lief_errors::corrupted);
+  switch (type) {
+    case 0: res = stored();  break;
+    case 1: res = fixed();   break;
+    case 2: res = dynamic(); break;
+    default:
+      {
+        LIEF_DEBUG("Invalid deflate block type");
+        return make_error_code(lief_errors::corrupted);
+      }
+  }
+  if (reader_.overrun()) {
+    LIEF_DEBUG("Truncated deflate stream");
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  return res;
+}
+
+ok_error_t Inflater::stored() {
+  reader_.align();
+  const uint32_t len  = reader_.bits(16);
+  const uint32_t nlen = reader_.bits(16);
+  if (len != (~nlen & 0xffff)) {
+    LIEF_DEBUG("Invalid stored block length");
+    return make_error_code(lief_errors::corrupted);
+  }
+  if (!reserve(len)) {
+    return make_error_code(lief_errors::data_too_large);
+  }
+  buffer_.reserve(buffer_.size() + len);
+  for (size_t i = 0; i < len; ++i) {
+    buffer_.push_back(static_cast<uint8_t>(reader_.bits(8)));
+  }
+  return ok();
+}
+
+ok_error_t Inflater::codes(const huffman_t& lencode, const huffman_t& distcode) {
+  static constexpr std::array<uint16_t, 29> LBASE = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+  };
+  static constexpr std::array<uint8_t, 29> LEXT = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+  };
+  static constexpr std::array<uint16_t, 30> DBASE = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577
+  };
+  static constexpr std::array<uint8_t, 30> DEXT = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+  };
+
+  while (true) {
+    int sym = lencode.decode(reader_);
+    if (sym < 0) {
+      return make_error_code(lief_errors::corrupted);
+    }
+    if (sym < 256) {
+      if (!reserve(1)) {
+        return make_error_code(lief_errors::data_too_large);
+      }
+      buffer_.push_back(static_cast<uint8_t>(sym));
+      continue;
+    }
+    if (sym == 256) {
+      return ok();
+    }
+
+    sym -= 257;
+    if (sym >= static_cast<int>(LBASE.size())) {
+      return make_error_code(lief_errors::corrupted);
+    }
+    const size_t len = LBASE[sym] + reader_.bits(LEXT[sym]);
+
+    const int dsym = distcode.decode(reader_);
+    if (dsym < 0 || dsym >= static_cast<int>(DBASE.size())) {
+      return make_error_code(lief_errors::corrupted);
+    }
+    const size_t dist = DBASE[dsym] + reader_.bits(DEXT[dsym]);
+    if (dist > buffer_.size()) {
+      LIEF_DEBUG("Deflate distance too far back");
+      return make_error_code(lief_errors::corrupted);
+    }
+    if (!reserve(len)) {
+      return make_error_code(lief_errors::data_too_large);
+    }
+
+    const size_t from = buffer_.size() - dist;
+    for (size_t i = 0; i < len; ++i) {
+      const uint8_t value = buffer_[from + i];
+      buffer_.push_back(value);
+    }
+
+    if (reader_.overrun()) {
+      return make_error_code(lief_errors::read_out_of_bound);
+    }
+  }
+}
+
+ok_error_t Inflater::fixed() {
+  struct fixed_codes_t {
+    fixed_codes_t() {
+      std::array<uint16_t, FIXED_LCODES> lengths = {};
+      size_t sym = 0;
+      for (; sym < 144; ++sym) { lengths[sym] = 8; }
+      for (; sym < 256; ++sym) { lengths[sym] = 9; }
+      for (; sym < 280; ++sym) { lengths[sym] = 7; }
+      for (; sym < FIXED_LCODES; ++sym) { lengths[sym] = 8; }
+      lencode.build(lengths.data(), FIXED_LCODES);
+
+      lengths.fill(5);
+      distcode.build(lengths.data(), MAX_DCODES);
+    }
+    huffman_t lencode;
+    huffman_t distcode;
+  };
+  static const fixed_codes_t FIXED;
+  return codes(FIXED.lencode, FIXED.distcode);
+}
+
+ok_error_t Inflater::dynamic() {
+  static constexpr std::array<uint8_t, 19> ORDER = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+  };
+
+  const uint32_t nlen  = reader_.bits(5) + 257;
+  const uint32_t ndist = reader_.bits(5) + 1;
+  const uint32_t ncode = reader_.bits(4) + 4;
+  if (nlen > MAX_LCODES || ndist > MAX_DCODES) {
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  std::array<uint16_t, MAX_LCODES + MAX_DCODES> lengths = {};
+  for (size_t i = 0; i < ncode; ++i) {
+    lengths[ORDER[i]] = static_cast<uint16_t>(reader_.bits(3));
+  }
+
+  huffman_t lencode;
+  huffman_t distcode;
+  if (lencode.build(lengths.data(), ORDER.size()) != 0) {
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  size_t idx = 0;
+  while (idx < nlen + ndist) {
+    const int sym = lencode.decode(reader_);
+    if (sym < 0) {
+      return make_error_code(lief_errors::corrupted);
+    }
+    if (sym < 16) {
+      lengths[idx++] = static_cast<uint16_t>(sym);
+      continue;
+    }
+    uint16_t len = 0;
+    size_t repeat = 0;
+    if (sym == 16) {
+      if (idx == 0) {
+        return make_error_code(lief_errors::corrupted);
+      }
+      len = lengths[idx - 1];
+      repeat = 3 + reader_.bits(2);
+    } else if (sym == 17) {
+      repeat = 3 + reader_.bits(3);
+    } else {
+      repeat = 11 + reader_.bits(7);
+    }
+    if (idx + repeat > nlen + ndist) {
+      return make_error_code(lief_errors::corrupted);
+    }
+    while (repeat-- > 0) {
+      lengths[idx++] = len;
+    }
+  }
+
+  if (lengths[256] == 0) {
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  // Incomplete codes are only allowed for a single length-1 code
+  int err = lencode.build(lengths.data(), nlen);
+  if (err < 0 || (err > 0 && nlen - lencode.count[0] != 1)) {
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  err = distcode.build(lengths.data() + nlen, ndist);
+  if (err < 0 || (err > 0 && ndist - distcode.count[0] != 1)) {
+    return make_error_code(lief_errors::corrupted);
+  }
+  return codes(lencode, distcode);
+}
+
+}
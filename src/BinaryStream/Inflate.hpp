@@ -0,0 +1,172 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_BINARYSTREAM_INFLATE_H
+#define LIEF_BINARYSTREAM_INFLATE_H
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "LIEF/errors.hpp"
+#include "LIEF/span.hpp"
+
+namespace LIEF {
+class BinaryStream;
+
+namespace details {
+
+//! LSB-first bit reader over a BinaryStream. The input is loaded by chunks
+//! so that the (compressed) stream does not need to be mapped in memory.
+class BitReader {
+  public:
+  static constexpr size_t CHUNK_SIZE = 0x10000;
+
+  BitReader(BinaryStream& stream, uint64_t bit_offset);
+
+  //! Move the reader to the given offset (in bits)
+  void seek(uint64_t bit_offset);
+
+  uint32_t peek(uint32_t nbits) {
+    ensure(nbits);
+    return static_cast<uint32_t>(acc_ & ((uint64_t(1) << nbits) - 1));
+  }
+
+  void drop(uint32_t nbits) {
+    acc_ >>= nbits;
+    nbits_ -= nbits;
+  }
+
+  uint32_t bits(uint32_t nbits) {
+    const uint32_t value = peek(nbits);
+    drop(nbits);
+    return value;
+  }
+
+  //! Skip the remaining bits of the current byte
+  void align() {
+    drop(nbits_ % 8);
+  }
+
+  //! Offset (in bits) of the next bit to be consumed
+  uint64_t bit_offset() const {
+    return pos_ * 8 - nbits_;
+  }
+
+  //! Whether more bits than available have been consumed
+  bool overrun() const {
+    return bit_offset() > size_ * 8;
+  }
+
+  private:
+  void ensure(uint32_t nbits) {
+    while (nbits_ < nbits) {
+      acc_ |= uint64_t(next_byte()) << nbits_;
+      nbits_ += 8;
+    }
+  }
+
+  uint8_t next_byte();
+
+  BinaryStream* stream_ = nullptr;
+  uint64_t size_ = 0;
+  uint64_t pos_ = 0;
+  uint64_t acc_ = 0;
+  uint32_t nbits_ = 0;
+
+  std::vector<uint8_t> chunk_;
+  uint64_t chunk_offset_ = 0;
+};
+
+//! Raw DEFLATE (RFC 1951) decoder that can be (re)started at any block
+//! boundary given the 32KB of output that precede the block.
+class Inflater {
+  public:
+  static constexpr size_t WINDOW_SIZE = 0x8000;
+
+  //! @param[in] stream      Compressed stream
+  //! @param[in] bit_offset  Offset (in bits) of a block header
+  //! @param[in] window      Output that precedes this block (up to 32KB)
+  Inflater(BinaryStream& stream, uint64_t bit_offset,
+           span<const uint8_t> window = {});
+
+  //! Decode the next block and append its data to output()
+  ok_error_t next_block();
+
+  //! Limit the number of bytes that can be produced (in total) by this
+  //! decoder. The decoding fails with lief_errors::data_too_large as soon as
+  //! a block (even partially decoded) exceeds this limit.
+  void set_limit(uint64_t limit) {
+    limit_ = limit;
+  }
+
+  //! Number of bytes produced so far (the initial window excluded)
+  uint64_t produced() const {
+    return produced_;
+  }
+
+  //! Whether the last decoded block has the BFINAL flag
+  bool is_final() const {
+    return final_;
+  }
+
+  //! Data produced since the last call to consume()
+  span<const uint8_t> output() const {
+    return {buffer_.data() + start_, buffer_.size() - start_};
+  }
+
+  //! Last 32KB of output (used as window of a seek point)
+  span<const uint8_t> window() const {
+    const size_t size = std::min<size_t>(buffer_.size(), WINDOW_SIZE);
+    return {buffer_.data() + buffer_.size() - size, size};
+  }
+
+  //! Discard the produced data but keep the window for the back-references
+  void consume();
+
+  BitReader& reader() {
+    return reader_;
+  }
+
+  //! Restart at the given bit offset (e.g. next gzip member). The current
+  //! window is kept.
+  void restart(uint64_t bit_offset);
+
+  private:
+  struct huffman_t;
+  ok_error_t stored();
+  ok_error_t codes(const huffman_t& lencode, const huffman_t& distcode);
+  ok_error_t dynamic();
+  ok_error_t fixed();
+
+  //! Account ``size`` bytes of output against the limit
+  bool reserve(uint64_t size) {
+    if (size > limit_ - produced_) {
+      return false;
+    }
+    produced_ += size;
+    return true;
+  }
+
+  BitReader reader_;
+  std::vector<uint8_t> buffer_;
+  size_t start_ = 0;
+  bool final_ = false;
+  uint64_t limit_ = UINT64_MAX;
+  uint64_t produced_ = 0;
+};
+
+}
+}
+#endif
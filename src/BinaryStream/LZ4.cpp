@@ -0,0 +1,103 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+
+#include "BinaryStream/LZ4.hpp"
+
+#include "logging.hpp"
+
+namespace LIEF::details {
+
+static constexpr size_t MIN_MATCH = 4;
+
+// LSIC-encoded length: a run of 0xFF bytes terminated by a byte < 0xFF
+static bool read_length(span<const uint8_t> input, size_t& ipos, size_t& length) {
+  uint8_t byte = 0;
+  do {
+    if (ipos >= input.size()) {
+      return false;
+    }
+    byte = input[ipos++];
+    length += byte;
+  } while (byte == 0xFF);
+  return true;
+}
+
+result<size_t> lz4_decompress(span<const uint8_t> input, span<uint8_t> output) {
+  size_t ipos = 0;
+  size_t opos = 0;
+
+  while (ipos < input.size()) {
+    const uint8_t token = input[ipos++];
+
+    size_t literals = token >> 4;
+    if (literals == 0xF && !read_length(input, ipos, literals)) {
+      LIEF_DEBUG("LZ4: truncated literal length");
+      return make_error_code(lief_errors::read_error);
+    }
+
+    if (literals > input.size() - ipos || literals > output.size() - opos) {
+      LIEF_DEBUG("LZ4: literals out of bounds (0x{:x} bytes)", literals);
+      return make_error_code(lief_errors::corrupted);
+    }
+    std::memcpy(output.data() + opos, input.data() + ipos, literals);
+    ipos += literals;
+    opos += literals;
+
+    // The last sequence only has literals
+    if (ipos == input.size()) {
+      break;
+    }
+
+    if (input.size() - ipos < sizeof(uint16_t)) {
+      LIEF_DEBUG("LZ4: truncated match offset");
+      return make_error_code(lief_errors::read_error);
+    }
+    const size_t offset = input[ipos] | (size_t(input[ipos + 1]) << 8);
+    ipos += sizeof(uint16_t);
+    if (offset == 0 || offset > opos) {
+      LIEF_DEBUG("LZ4: invalid match offset: 0x{:x}", offset);
+      return make_error_code(lief_errors::corrupted);
+    }
+
+    size_t length = token & 0xF;
+    if (length == 0xF && !read_length(input, ipos, length)) {
+      LIEF_DEBUG("LZ4: truncated match length");
+      return make_error_code(lief_errors::read_error);
+    }
+    length += MIN_MATCH;
+
+    if (length > output.size() - opos) {
+      LIEF_DEBUG("LZ4: match out of bounds (0x{:x} bytes)", length);
+      return make_error_code(lief_errors::corrupted);
+    }
+
+    uint8_t* dst = output.data() + opos;
+    const uint8_t* src = dst - offset;
+    if (offset >= length) {
+      std::memcpy(dst, src, length);
+    } else {
+      // Overlapping match (e.g. a run of the same byte)
+      for (size_t i = 0; i < length; ++i) {
+        dst[i] = src[i];
+      }
+    }
+    opos += length;
+  }
+  return opos;
+}
+
+}
@@ -0,0 +1,38 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_BINARYSTREAM_LZ4_H
+#define LIEF_BINARYSTREAM_LZ4_H
+#include <cstdint>
+
+#include "LIEF/errors.hpp"
+#include "LIEF/span.hpp"
+
+namespace LIEF {
+namespace details {
+
+//! Decode a raw LZ4 block (no frame header) as produced by
+//! ``LZ4_compress_default()`` or ``LZ4_compress_HC()``.
+//!
+//! @param[in]  input   Compressed block
+//! @param[out] output  Buffer that receives the decompressed data. It must
+//!                     be large enough for the whole block.
+//!
+//! @return The number of bytes written in ``output``
+result<size_t> lz4_decompress(span<const uint8_t> input, span<uint8_t> output);
+
+}
+}
+#endif
@@ -347,9 +347,24 @@ std::vector<uint8_t> File::raw(bool deoptimize) const {
     }
   }
 
+  // The instructions have been patched: the checksum and the signature
+  // of the original file are no longer valid
+  if (!update_checksums(raw)) {
+    LIEF_WARN("Can't update the checksum of the deoptimized file");
+  }
   return raw;
 }
 
+bool File::verify_checksum() const {
+  auto checksum = compute_checksum(original_data_);
+  return checksum && *checksum == header_.checksum();
+}
+
+bool File::verify_signature() const {
+  auto signature = compute_signature(original_data_);
+  return signature && *signature == header_.signature();
+}
+
 void File::deoptimize_nop(uint8_t* inst_ptr, uint32_t /*value*/) {
   *inst_ptr = OPCODES::OP_CHECK_CAST;
 }
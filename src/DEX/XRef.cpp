@@ -0,0 +1,278 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <array>
+
+#include "logging.hpp"
+#include "parallel.hpp"
+
+#include "LIEF/DEX/XRef.hpp"
+#include "LIEF/DEX/File.hpp"
+#include "LIEF/DEX/Method.hpp"
+#include "LIEF/DEX/Field.hpp"
+#include "LIEF/DEX/instructions.hpp"
+
+namespace LIEF {
+namespace DEX {
+
+namespace {
+enum class KIND : uint8_t {
+  NONE = 0,
+  METHOD,
+  FIELD,
+  STRING,
+  STRING_JUMBO,
+  TYPE,
+};
+
+struct opcode_info_t {
+  uint8_t size = 0; // In bytes (0 for unused opcodes)
+  KIND kind = KIND::NONE;
+};
+
+// inst_size_from_opcode() goes through a std::map: cache the sizes and the
+// kind of reference of the 256 opcodes in a flat table.
+std::array<opcode_info_t, 256> make_opcodes_table() {
+  std::array<opcode_info_t, 256> table;
+  for (size_t op = 0; op < table.size(); ++op) {
+    const size_t size = inst_size_from_opcode(static_cast<OPCODES>(op));
+    table[op].size = size < 0xff ? static_cast<uint8_t>(size) : 0;
+  }
+
+  auto set = [&table] (uint8_t first, uint8_t last, KIND kind) {
+    for (size_t op = first; op <= last; ++op) {
+      table[op].kind = kind;
+    }
+  };
+
+  set(OP_CONST_STRING,        OP_CONST_STRING,           KIND::STRING);
+  set(OP_CONST_STRING_JUMBO,  OP_CONST_STRING_JUMBO,     KIND::STRING_JUMBO);
+  set(OP_CONST_CLASS,         OP_CONST_CLASS,            KIND::TYPE);
+  set(OP_CHECK_CAST,          OP_INSTANCE_OF,            KIND::TYPE);
+  set(OP_NEW_INSTANCE,        OP_FILLED_NEW_ARRAY_RANGE, KIND::TYPE);
+  set(OP_IGET,                OP_SPUT_SHORT,             KIND::FIELD);
+  set(OP_INVOKE_VIRTUAL,      OP_INVOKE_INTERFACE,       KIND::METHOD);
+  set(OP_INVOKE_VIRTUAL_RANGE, OP_INVOKE_INTERFACE_RANGE, KIND::METHOD);
+  set(OP_INVOKE_POLYMORPHIC,  OP_INVOKE_POLYMORPHIC_RANGE, KIND::METHOD);
+  return table;
+}
+
+inline uint32_t read_u16(const uint8_t* ptr) {
+  return ptr[0] | (uint32_t(ptr[1]) << 8);
+}
+
+inline uint32_t read_u32(const uint8_t* ptr) {
+  return read_u16(ptr) | (read_u16(ptr + 2) << 16);
+}
+
+// Number of methods decoded by a job of XRef::build()
+constexpr size_t CHUNK_SIZE = 512;
+
+void append(XRef::csr_t& csr, std::vector<uint32_t>& targets) {
+  std::sort(targets.begin(), targets.end());
+  targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+  csr.targets.insert(csr.targets.end(), targets.begin(), targets.end());
+  csr.offsets.push_back(csr.targets.size());
+  targets.clear();
+}
+
+// Append the adjacency lists of ``chunk`` (whose offsets start at 0) after the
+// lists of ``csr``
+void merge(XRef::csr_t& csr, const XRef::csr_t& chunk) {
+  const uint32_t base = csr.targets.size();
+  csr.targets.insert(csr.targets.end(), chunk.targets.begin(), chunk.targets.end());
+  for (size_t i = 1; i < chunk.offsets.size(); ++i) {
+    csr.offsets.push_back(base + chunk.offsets[i]);
+  }
+}
+
+// Transpose the given adjacency list. Since the sources are visited in
+// increasing order, the lists of the transposed graph are sorted.
+XRef::csr_t transpose(const XRef::csr_t& csr, size_t nb_nodes) {
+  XRef::csr_t out;
+  out.offsets.assign(nb_nodes + 1, 0);
+  for (uint32_t target : csr.targets) {
+    ++out.offsets[target + 1];
+  }
+  for (size_t i = 1; i < out.offsets.size(); ++i) {
+    out.offsets[i] += out.offsets[i - 1];
+  }
+  out.targets.resize(csr.targets.size());
+  std::vector<uint32_t> cursor(out.offsets.begin(), out.offsets.end() - 1);
+  for (size_t src = 0; src + 1 < csr.offsets.size(); ++src) {
+    for (uint32_t i = csr.offsets[src]; i < csr.offsets[src + 1]; ++i) {
+      out.targets[cursor[csr.targets[i]]++] = src;
+    }
+  }
+  return out;
+}
+
+// Edges of the methods [begin, end) decoded by a job of XRef::build()
+struct edges_t {
+  XRef::csr_t calls;
+  XRef::csr_t strings;
+  XRef::csr_t fields;
+  XRef::csr_t types;
+};
+}
+
+XRef XRef::build(const File& file, uint32_t nb_threads) {
+  static const std::array<opcode_info_t, 256> OPCODES_INFO = make_opcodes_table();
+
+  const Header& hdr = file.header();
+  const size_t nb_methods = hdr.methods().second;
+  const size_t nb_fields  = hdr.fields().second;
+  const size_t nb_strings = hdr.strings().second;
+  const size_t nb_types   = hdr.types().second;
+
+  XRef xref;
+  xref.methods_.resize(nb_methods, nullptr);
+  for (const Method& method : file.methods()) {
+    if (method.index() < nb_methods) {
+      xref.methods_[method.index()] = &method;
+    }
+  }
+
+  xref.fields_idx_.resize(nb_fields, nullptr);
+  for (const Field& field : file.fields()) {
+    if (field.index() < nb_fields) {
+      xref.fields_idx_[field.index()] = &field;
+    }
+  }
+
+  // Decode the bytecode of the methods by chunks: each job only writes the
+  // edges of its own chunk which are then merged in the order of the methods
+  // so that the index does not depend on the scheduling of the jobs.
+  const size_t nb_chunks = (nb_methods + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  std::vector<edges_t> chunks(nb_chunks);
+
+  parallel_for(nb_chunks, nb_threads, [&] (size_t chunk_idx) {
+    edges_t& edges = chunks[chunk_idx];
+    for (csr_t* csr : {&edges.calls, &edges.strings, &edges.fields, &edges.types}) {
+      csr->offsets.push_back(0);
+    }
+
+    std::vector<uint32_t> calls;
+    std::vector<uint32_t> strings;
+    std::vector<uint32_t> fields;
+    std::vector<uint32_t> types;
+
+    const size_t first = chunk_idx * CHUNK_SIZE;
+    const size_t last = std::min(first + CHUNK_SIZE, nb_methods);
+    for (size_t idx = first; idx < last; ++idx) {
+      const Method* method = xref.methods_[idx];
+      if (method != nullptr && !method->bytecode().empty()) {
+        const Method::bytecode_t& bytecode = method->bytecode();
+        const uint8_t* start = bytecode.data();
+        const uint8_t* end = start + bytecode.size();
+        const uint8_t* ptr = start;
+
+        while (ptr < end) {
+          if (is_switch_array(ptr, end)) {
+            const size_t size = switch_array_size(ptr, end);
+            if (size == 0 || size > size_t(end - ptr)) {
+              break;
+            }
+            ptr += size;
+            continue;
+          }
+
+          const opcode_info_t& info = OPCODES_INFO[*ptr];
+          if (info.size == 0 || info.size > end - ptr) {
+            LIEF_DEBUG("{}: unknown opcode 0x{:02x} at pc=0x{:x}", method->name(),
+                       *ptr, (ptr - start) / sizeof(uint16_t));
+            break;
+          }
+
+          switch (info.kind) {
+            case KIND::METHOD: calls.push_back(read_u16(ptr + 2)); break;
+            case KIND::FIELD:  fields.push_back(read_u16(ptr + 2)); break;
+            case KIND::TYPE:   types.push_back(read_u16(ptr + 2)); break;
+            case KIND::STRING: strings.push_back(read_u16(ptr + 2)); break;
+            case KIND::STRING_JUMBO: strings.push_back(read_u32(ptr + 2)); break;
+            case KIND::NONE: break;
+          }
+          ptr += info.size;
+        }
+
+        // Drop the (corrupted) indexes that are out of the pools
+        auto drop = [] (std::vector<uint32_t>& v, size_t size) {
+          v.erase(std::remove_if(v.begin(), v.end(),
+                                 [size] (uint32_t i) { return i >= size; }), v.end());
+        };
+        drop(calls, nb_methods);
+        drop(fields, nb_fields);
+        drop(types, nb_types);
+        drop(strings, nb_strings);
+      }
+
+      append(edges.calls, calls);
+      append(edges.strings, strings);
+      append(edges.fields, fields);
+      append(edges.types, types);
+    }
+  });
+
+  for (csr_t* csr : {&xref.calls_, &xref.strings_, &xref.fields_, &xref.types_}) {
+    csr->offsets.reserve(nb_methods + 1);
+    csr->offsets.push_back(0);
+  }
+
+  for (const edges_t& edges : chunks) {
+    merge(xref.calls_, edges.calls);
+    merge(xref.strings_, edges.strings);
+    merge(xref.fields_, edges.fields);
+    merge(xref.types_, edges.types);
+  }
+  chunks.clear();
+
+  // The four transposed graphs are independent
+  parallel_for(4, nb_threads, [&] (size_t i) {
+    switch (i) {
+      case 0: xref.callers_      = transpose(xref.calls_, nb_methods); break;
+      case 1: xref.string_users_ = transpose(xref.strings_, nb_strings); break;
+      case 2: xref.field_users_  = transpose(xref.fields_, nb_fields); break;
+      case 3: xref.type_users_   = transpose(xref.types_, nb_types); break;
+    }
+  });
+  return xref;
+}
+
+std::vector<const Method*> XRef::resolve(span<const uint32_t> indexes) const {
+  std::vector<const Method*> methods;
+  methods.reserve(indexes.size());
+  for (uint32_t idx : indexes) {
+    if (const Method* method = this->method(idx)) {
+      methods.push_back(method);
+    }
+  }
+  return methods;
+}
+
+std::vector<const Method*> XRef::callers(const Method& method) const {
+  return resolve(callers(method.index()));
+}
+
+std::vector<const Method*> XRef::callees(const Method& method) const {
+  return resolve(callees(method.index()));
+}
+
+std::vector<const Method*> XRef::field_users(const Field& field) const {
+  return resolve(field_users(field.index()));
+}
+
+}
+}
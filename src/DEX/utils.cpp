@@ -14,13 +14,20 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
 
 #include "LIEF/BinaryStream/FileStream.hpp"
 #include "LIEF/BinaryStream/SpanStream.hpp"
 
 #include "LIEF/DEX/utils.hpp"
+#include "LIEF/DEX/File.hpp"
 #include "DEX/Structures.hpp"
 
+#include "hash_stream.hpp"
+#include "logging.hpp"
+#include "parallel.hpp"
+
 namespace LIEF {
 namespace DEX {
 
@@ -84,5 +91,104 @@ dex_version_t version(const std::vector<uint8_t>& raw) {
 }
 
 
+uint32_t adler32(span<const uint8_t> data, uint32_t adler) {
+  static constexpr uint32_t BASE = 65521;
+  // Largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1 (zlib)
+  static constexpr size_t NMAX = 5552;
+  static constexpr size_t BLOCK = 16;
+  static_assert(NMAX % BLOCK == 0);
+
+  uint32_t a = adler & 0xffff;
+  uint32_t b = adler >> 16;
+  const uint8_t* ptr = data.data();
+  size_t len = data.size();
+
+  while (len > 0) {
+    size_t n = std::min(len, NMAX);
+    len -= n;
+    // Process the bytes by blocks: the sums of a block do not depend on
+    // each other, which lets the compiler vectorize the inner loop.
+    for (; n >= BLOCK; n -= BLOCK, ptr += BLOCK) {
+      uint32_t sum = 0;
+      uint32_t weighted = 0;
+      for (size_t i = 0; i < BLOCK; ++i) {
+        sum      += ptr[i];
+        weighted += static_cast<uint32_t>(BLOCK - i) * ptr[i];
+      }
+      b += BLOCK * a + weighted;
+      a += sum;
+    }
+    for (; n > 0; --n) {
+      a += *ptr++;
+      b += a;
+    }
+    a %= BASE;
+    b %= BASE;
+  }
+  return (b << 16) | a;
+}
+
+result<uint32_t> compute_checksum(span<const uint8_t> raw) {
+  static constexpr size_t OFFSET = offsetof(details::header, signature);
+  if (raw.size() < sizeof(details::header)) {
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  return adler32(raw.subspan(OFFSET));
+}
+
+result<Header::signature_t> compute_signature(span<const uint8_t> raw) {
+  static constexpr size_t OFFSET = offsetof(details::header, file_size);
+  if (raw.size() < sizeof(details::header)) {
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  Header::signature_t signature;
+  hashstream hs(hashstream::HASH::SHA1);
+  const std::vector<uint8_t>& sha1 = hs.write(raw.data() + OFFSET, raw.size() - OFFSET).raw();
+  std::copy(sha1.begin(), sha1.end(), signature.begin());
+  return signature;
+}
+
+ok_error_t update_checksums(span<uint8_t> raw) {
+  // The checksum covers the signature: it must be computed last
+  auto signature = compute_signature(raw);
+  if (!signature) {
+    return make_error_code(get_error(signature));
+  }
+  std::memcpy(raw.data() + offsetof(details::header, signature),
+              signature->data(), signature->size());
+
+  auto checksum = compute_checksum(raw);
+  if (!checksum) {
+    return make_error_code(get_error(checksum));
+  }
+  const uint32_t value = *checksum;
+  std::memcpy(raw.data() + offsetof(details::header, checksum), &value, sizeof(value));
+  return ok();
+}
+
+std::vector<verify_t> verify(const std::vector<const File*>& files, uint32_t nb_threads) {
+  std::vector<verify_t> results(files.size());
+  parallel_for(files.size(), nb_threads, [&] (size_t i) {
+    results[i].checksum  = files[i]->verify_checksum();
+    results[i].signature = files[i]->verify_signature();
+  });
+  return results;
+}
+
+std::vector<std::vector<uint8_t>> fix(const std::vector<const File*>& files,
+                                      bool deoptimize, uint32_t nb_threads)
+{
+  std::vector<std::vector<uint8_t>> raws(files.size());
+  parallel_for(files.size(), nb_threads, [&] (size_t i) {
+    raws[i] = files[i]->raw(deoptimize);
+    // raw() only recomputes the header of the files that have been
+    // deoptimized
+    if (!update_checksums(raws[i])) {
+      LIEF_WARN("Can't update the checksum of '{}'", files[i]->name());
+    }
+  });
+  return raws;
+}
+
 }
 }
@@ -18,6 +18,7 @@
 #include <numeric>
 #include <sstream>
 #include <cctype>
+#include <unordered_map>
 
 #include "LIEF/DWARF/enums.hpp"
 
@@ -44,6 +45,8 @@
 #include "LIEF/ELF/Segment.hpp"
 #include "LIEF/ELF/Relocation.hpp"
 #include "LIEF/ELF/Symbol.hpp"
+#include "LIEF/Abstract/Symbolizer.hpp"
+#include "LIEF/Abstract/GoPclntab.hpp"
 #include "LIEF/ELF/SymbolVersion.hpp"
 #include "LIEF/ELF/SymbolVersionDefinition.hpp"
 #include "LIEF/ELF/SymbolVersionRequirement.hpp"
@@ -79,6 +82,146 @@ Binary::Binary() :
   sizing_info_{std::make_unique<sizing_info_t>()}
 {}
 
+std::unique_ptr<Binary> Binary::clone() const {
+  std::unique_ptr<Binary> copy(new Binary{});
+  copy->original_size_   = original_size_;
+  copy->truncation_      = truncation_;
+  copy->type_            = type_;
+  copy->header_          = header_;
+  copy->interpreter_     = interpreter_;
+  copy->overlay_         = overlay_;
+  copy->phdr_reloc_info_ = phdr_reloc_info_;
+  *copy->sizing_info_    = *sizing_info_;
+
+  if (datahandler_ != nullptr) {
+    copy->datahandler_ = datahandler_->clone();
+  }
+
+  if (gnu_hash_ != nullptr) {
+    copy->gnu_hash_ = std::make_unique<GnuHash>(*gnu_hash_);
+  }
+
+  if (sysv_hash_ != nullptr) {
+    copy->sysv_hash_ = std::make_unique<SysvHash>(*sysv_hash_);
+  }
+
+  // The copy constructors of the objects drop the references to the other
+  // objects of the binary: they are re-linked with the following maps
+  std::unordered_map<const Section*, Section*> sections_map;
+  std::unordered_map<const Segment*, Segment*> segments_map;
+  std::unordered_map<const Symbol*, Symbol*> symbols_map;
+  std::unordered_map<const SymbolVersion*, SymbolVersion*> versions_map;
+  std::unordered_map<const SymbolVersionAux*, SymbolVersionAux*> version_aux_map;
+
+  copy->sections_.reserve(sections_.size());
+  for (const std::unique_ptr<Section>& section : sections_) {
+    auto new_section = std::make_unique<Section>(*section);
+    if (section->datahandler_ != nullptr) {
+      new_section->datahandler_ = copy->datahandler_.get();
+    }
+    sections_map[section.get()] = new_section.get();
+    copy->sections_.push_back(std::move(new_section));
+  }
+
+  copy->segments_.reserve(segments_.size());
+  for (const std::unique_ptr<Segment>& segment : segments_) {
+    auto new_segment = std::make_unique<Segment>(*segment);
+    if (segment->datahandler_ != nullptr) {
+      new_segment->datahandler_ = copy->datahandler_.get();
+    }
+    segments_map[segment.get()] = new_segment.get();
+    copy->segments_.push_back(std::move(new_segment));
+  }
+
+  const auto get_section = [&sections_map] (const Section* section) -> Section* {
+    if (section == nullptr) {
+      return nullptr;
+    }
+    auto it = sections_map.find(section);
+    return it != sections_map.end() ? it->second : nullptr;
+  };
+
+  for (size_t i = 0; i < sections_.size(); ++i) {
+    for (const Segment* segment : sections_[i]->segments_) {
+      copy->sections_[i]->segments_.push_back(segments_map[segment]);
+    }
+  }
+
+  for (size_t i = 0; i < segments_.size(); ++i) {
+    for (const Section* section : segments_[i]->sections_) {
+      copy->segments_[i]->sections_.push_back(sections_map[section]);
+    }
+  }
+
+  copy->symbol_version_requirements_.reserve(symbol_version_requirements_.size());
+  for (const std::unique_ptr<SymbolVersionRequirement>& req : symbol_version_requirements_) {
+    auto new_req = std::make_unique<SymbolVersionRequirement>(*req);
+    for (size_t i = 0; i < req->aux_requirements_.size(); ++i) {
+      version_aux_map[req->aux_requirements_[i].get()] = new_req->aux_requirements_[i].get();
+    }
+    copy->symbol_version_requirements_.push_back(std::move(new_req));
+  }
+
+  copy->symbol_version_definition_.reserve(symbol_version_definition_.size());
+  for (const std::unique_ptr<SymbolVersionDefinition>& def : symbol_version_definition_) {
+    auto new_def = std::make_unique<SymbolVersionDefinition>(*def);
+    for (size_t i = 0; i < def->symbol_version_aux_.size(); ++i) {
+      version_aux_map[def->symbol_version_aux_[i].get()] = new_def->symbol_version_aux_[i].get();
+    }
+    copy->symbol_version_definition_.push_back(std::move(new_def));
+  }
+
+  copy->symbol_version_table_.reserve(symbol_version_table_.size());
+  for (const std::unique_ptr<SymbolVersion>& version : symbol_version_table_) {
+    auto new_version = std::make_unique<SymbolVersion>(*version);
+    if (version->symbol_aux_ != nullptr) {
+      new_version->symbol_aux_ = version_aux_map[version->symbol_aux_];
+    }
+    versions_map[version.get()] = new_version.get();
+    copy->symbol_version_table_.push_back(std::move(new_version));
+  }
+
+  const auto copy_symbols = [&] (const symbols_t& from, symbols_t& to) {
+    to.reserve(from.size());
+    for (const std::unique_ptr<Symbol>& symbol : from) {
+      auto new_symbol = std::make_unique<Symbol>(*symbol);
+      new_symbol->section_ = get_section(symbol->section_);
+      if (symbol->symbol_version_ != nullptr) {
+        new_symbol->symbol_version_ = versions_map[symbol->symbol_version_];
+      }
+      symbols_map[symbol.get()] = new_symbol.get();
+      to.push_back(std::move(new_symbol));
+    }
+  };
+  copy_symbols(dynamic_symbols_, copy->dynamic_symbols_);
+  copy_symbols(symtab_symbols_, copy->symtab_symbols_);
+
+  copy->relocations_.reserve(relocations_.size());
+  for (const std::unique_ptr<Relocation>& reloc : relocations_) {
+    auto new_reloc = std::make_unique<Relocation>(*reloc);
+    new_reloc->purpose_      = reloc->purpose_;
+    new_reloc->info_         = reloc->info_;
+    new_reloc->section_      = get_section(reloc->section_);
+    new_reloc->symbol_table_ = get_section(reloc->symbol_table_);
+    if (reloc->symbol_ != nullptr) {
+      new_reloc->symbol_ = symbols_map[reloc->symbol_];
+    }
+    copy->relocations_.push_back(std::move(new_reloc));
+  }
+
+  copy->dynamic_entries_.reserve(dynamic_entries_.size());
+  for (const std::unique_ptr<DynamicEntry>& entry : dynamic_entries_) {
+    copy->dynamic_entries_.push_back(entry->clone());
+  }
+
+  copy->notes_.reserve(notes_.size());
+  for (const std::unique_ptr<Note>& note : notes_) {
+    copy->notes_.push_back(note->clone());
+  }
+
+  return copy;
+}
+
 size_t Binary::hash(const std::string& name) {
   if (type_ == Header::CLASS::ELF32) {
     return hash32(name.c_str());
@@ -1574,7 +1717,11 @@ void Binary::strip() {
 
 
 Symbol& Binary::add_symtab_symbol(const Symbol& symbol) {
-  symtab_symbols_.push_back(std::make_unique<Symbol>(symbol));
+  auto sym = std::make_unique<Symbol>(symbol);
+  // The name of a new symbol is not located in the original string table
+  sym->name_offset_ = 0;
+  sym->symtab_idx_ = -1u;
+  symtab_symbols_.push_back(std::move(sym));
   return *symtab_symbols_.back();
 }
 
@@ -2532,7 +2679,11 @@ LIEF::Binary::functions_t Binary::eh_frame_functions() const {
 
 
 LIEF::Binary::functions_t Binary::functions() const {
+  auto gopclntab = GoPclntab::from_binary(*this);
+  return functions(gopclntab ? &*gopclntab : nullptr);
+}
 
+LIEF::Binary::functions_t Binary::functions(const GoPclntab* gopclntab) const {
   static const auto func_cmd = [] (const Function& lhs, const Function& rhs) {
     return lhs.address() < rhs.address();
   };
@@ -2551,6 +2702,12 @@ LIEF::Binary::functions_t Binary::functions() const {
     }
   }
 
+  if (gopclntab != nullptr) {
+    LIEF::Binary::functions_t go_functions = gopclntab->functions();
+    std::move(std::begin(go_functions), std::end(go_functions),
+              std::inserter(functions_set, std::end(functions_set)));
+  }
+
   std::move(std::begin(ctors), std::end(ctors),
             std::inserter(functions_set, std::end(functions_set)));
 
@@ -2566,6 +2723,45 @@ LIEF::Binary::functions_t Binary::functions() const {
   return {std::begin(functions_set), std::end(functions_set)};
 }
 
+std::unique_ptr<Symbolizer> Binary::symbolizer() const {
+  auto sym = std::make_unique<Symbolizer>();
+  const bool is_arm = header().machine_type() == ARCH::ARM;
+
+  for (const Symbol& s : symbols()) {
+    const Symbol::TYPE type = s.type();
+    if (s.value() == 0 || s.shndx() == 0 || s.name().empty() ||
+        type == Symbol::TYPE::SECTION || type == Symbol::TYPE::FILE ||
+        type == Symbol::TYPE::TLS)
+    {
+      continue;
+    }
+    uint64_t value = s.value();
+    if (is_arm && type == Symbol::TYPE::FUNC) {
+      value &= ~uint64_t(1); // Thumb bit
+    }
+    sym->add(value, s.size(), s.name());
+  }
+
+  // The Go functions are added with their names: they are not collected
+  // again by functions()
+  auto gopclntab = GoPclntab::from_binary(*this);
+  if (gopclntab) {
+    for (uint32_t i = 0; i < gopclntab->size(); ++i) {
+      const uint64_t entry = gopclntab->entry(i);
+      sym->add(entry, gopclntab->end(i) - entry, gopclntab->name(i));
+    }
+  }
+
+  // Unnamed functions (e.g. from .eh_frame) bound the ranges of the
+  // symbols without size
+  for (const Function& f : functions(/*gopclntab=*/nullptr)) {
+    if (f.address() > 0) {
+      sym->add(f.address(), f.size(), "");
+    }
+  }
+  sym->finalize(imagebase() + virtual_size());
+  return sym;
+}
 
 uint64_t Binary::eof_offset() const {
   uint64_t last_offset_sections = 0;
@@ -0,0 +1,1737 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mutex>
+
+#include "logging.hpp"
+#include "frozen.hpp"
+#include "parallel.hpp"
+
+#include "LIEF/BinaryStream/SpanStream.hpp"
+#include "LIEF/DWARF/enums.hpp"
+#include "LIEF/ELF/Binary.hpp"
+#include "LIEF/ELF/CoreUnwinder.hpp"
+#include "LIEF/ELF/EnumToString.hpp"
+#include "LIEF/ELF/Note.hpp"
+#include "LIEF/ELF/NoteDetails/core/CoreFile.hpp"
+#include "LIEF/ELF/NoteDetails/core/CorePrStatus.hpp"
+#include "LIEF/ELF/Parser.hpp"
+#include "LIEF/ELF/ParserConfig.hpp"
+#include "LIEF/ELF/Section.hpp"
+#include "LIEF/ELF/Segment.hpp"
+#include "LIEF/utils.hpp"
+
+namespace LIEF {
+namespace ELF {
+
+namespace {
+// DWARF register columns tracked by the unwinder (x0-x30 and sp for AArch64)
+static constexpr size_t NB_REGS = 33;
+
+// Limits against malformed CFI
+static constexpr size_t MAX_STATES = 64;
+static constexpr size_t MAX_STACK = 64;
+static constexpr size_t MAX_OPS = 4096;
+
+enum CFA_OP : uint8_t {
+  DW_CFA_nop                        = 0x00,
+  DW_CFA_set_loc                    = 0x01,
+  DW_CFA_advance_loc1               = 0x02,
+  DW_CFA_advance_loc2               = 0x03,
+  DW_CFA_advance_loc4               = 0x04,
+  DW_CFA_offset_extended            = 0x05,
+  DW_CFA_restore_extended           = 0x06,
+  DW_CFA_undefined                  = 0x07,
+  DW_CFA_same_value                 = 0x08,
+  DW_CFA_register                   = 0x09,
+  DW_CFA_remember_state             = 0x0a,
+  DW_CFA_restore_state              = 0x0b,
+  DW_CFA_def_cfa                    = 0x0c,
+  DW_CFA_def_cfa_register           = 0x0d,
+  DW_CFA_def_cfa_offset             = 0x0e,
+  DW_CFA_def_cfa_expression         = 0x0f,
+  DW_CFA_expression                 = 0x10,
+  DW_CFA_offset_extended_sf         = 0x11,
+  DW_CFA_def_cfa_sf                 = 0x12,
+  DW_CFA_def_cfa_offset_sf          = 0x13,
+  DW_CFA_val_offset                 = 0x14,
+  DW_CFA_val_offset_sf              = 0x15,
+  DW_CFA_val_expression             = 0x16,
+  DW_CFA_AARCH64_negate_ra_state    = 0x2d,
+  DW_CFA_GNU_args_size              = 0x2e,
+  DW_CFA_GNU_negative_offset_extended = 0x2f,
+
+  DW_CFA_advance_loc                = 0x40,
+  DW_CFA_offset                     = 0x80,
+  DW_CFA_restore                    = 0xc0,
+};
+
+enum EXPR_OP : uint8_t {
+  DW_OP_addr        = 0x03,
+  DW_OP_deref       = 0x06,
+  DW_OP_const1u     = 0x08,
+  DW_OP_const1s     = 0x09,
+  DW_OP_const2u     = 0x0a,
+  DW_OP_const2s     = 0x0b,
+  DW_OP_const4u     = 0x0c,
+  DW_OP_const4s     = 0x0d,
+  DW_OP_const8u     = 0x0e,
+  DW_OP_const8s     = 0x0f,
+  DW_OP_constu      = 0x10,
+  DW_OP_consts      = 0x11,
+  DW_OP_dup         = 0x12,
+  DW_OP_drop        = 0x13,
+  DW_OP_over        = 0x14,
+  DW_OP_pick        = 0x15,
+  DW_OP_swap        = 0x16,
+  DW_OP_rot         = 0x17,
+  DW_OP_abs         = 0x19,
+  DW_OP_and         = 0x1a,
+  DW_OP_div         = 0x1b,
+  DW_OP_minus       = 0x1c,
+  DW_OP_mod         = 0x1d,
+  DW_OP_mul         = 0x1e,
+  DW_OP_neg         = 0x1f,
+  DW_OP_not         = 0x20,
+  DW_OP_or          = 0x21,
+  DW_OP_plus        = 0x22,
+  DW_OP_plus_uconst = 0x23,
+  DW_OP_shl         = 0x24,
+  DW_OP_shr         = 0x25,
+  DW_OP_shra        = 0x26,
+  DW_OP_xor         = 0x27,
+  DW_OP_bra         = 0x28,
+  DW_OP_eq          = 0x29,
+  DW_OP_ge          = 0x2a,
+  DW_OP_gt          = 0x2b,
+  DW_OP_le          = 0x2c,
+  DW_OP_lt          = 0x2d,
+  DW_OP_ne          = 0x2e,
+  DW_OP_skip        = 0x2f,
+  DW_OP_lit0        = 0x30,
+  DW_OP_lit31       = 0x4f,
+  DW_OP_breg0       = 0x70,
+  DW_OP_breg31      = 0x8f,
+  DW_OP_bregx       = 0x92,
+  DW_OP_deref_size  = 0x94,
+  DW_OP_nop         = 0x96,
+};
+
+//! Registers of a frame indexed by their DWARF number
+struct regs_t {
+  std::array<uint64_t, NB_REGS> values = {};
+  uint64_t valid = 0;
+
+  bool has(uint32_t reg) const {
+    return reg < NB_REGS && (valid & (uint64_t(1) << reg)) != 0;
+  }
+
+  uint64_t get(uint32_t reg) const {
+    return has(reg) ? values[reg] : 0;
+  }
+
+  void set(uint32_t reg, uint64_t value) {
+    if (reg < NB_REGS) {
+      values[reg] = value;
+      valid |= uint64_t(1) << reg;
+    }
+  }
+
+  void clear(uint32_t reg) {
+    if (reg < NB_REGS) {
+      valid &= ~(uint64_t(1) << reg);
+    }
+  }
+};
+
+//! Register conventions of the supported architectures
+struct arch_t {
+  size_t ptr_size = 0;
+  uint32_t sp = 0; ///< DWARF number of the stack pointer
+  uint32_t fp = 0; ///< DWARF number of the frame pointer
+};
+
+result<arch_t> get_arch(ARCH arch) {
+  switch (arch) {
+    case ARCH::X86_64:  return arch_t{8, 7, 6};
+    case ARCH::I386:    return arch_t{4, 4, 5};
+    case ARCH::AARCH64: return arch_t{8, 31, 29};
+    default:
+      return make_error_code(lief_errors::not_supported);
+  }
+}
+
+//! Translate the registers of ``NT_PRSTATUS`` into their DWARF numbering
+regs_t get_regs(const CorePrStatus& status) {
+  using X86_64 = CorePrStatus::Registers::X86_64;
+  using X86 = CorePrStatus::Registers::X86;
+  regs_t regs;
+  const std::vector<uint64_t> values = status.register_values();
+  if (values.empty()) {
+    return regs;
+  }
+  switch (status.architecture()) {
+    case ARCH::X86_64:
+      {
+        static constexpr X86_64 DWARF_REGS[] = {
+          X86_64::RAX, X86_64::RDX, X86_64::RCX, X86_64::RBX,
+          X86_64::RSI, X86_64::RDI, X86_64::RBP, X86_64::RSP,
+          X86_64::R8,  X86_64::R9,  X86_64::R10, X86_64::R11,
+          X86_64::R12, X86_64::R13, X86_64::R14, X86_64::R15,
+          X86_64::RIP,
+        };
+        for (size_t i = 0; i < std::size(DWARF_REGS); ++i) {
+          regs.set(i, values[static_cast<size_t>(DWARF_REGS[i])]);
+        }
+        break;
+      }
+    case ARCH::I386:
+      {
+        static constexpr X86 DWARF_REGS[] = {
+          X86::EAX, X86::ECX, X86::EDX, X86::EBX,
+          X86::ESP, X86::EBP, X86::ESI, X86::EDI,
+          X86::EIP,
+        };
+        for (size_t i = 0; i < std::size(DWARF_REGS); ++i) {
+          regs.set(i, values[static_cast<size_t>(DWARF_REGS[i])]);
+        }
+        break;
+      }
+    case ARCH::AARCH64:
+      {
+        // x0-x30 and sp (X31) share the DWARF numbering
+        for (size_t i = 0; i <= 31; ++i) {
+          regs.set(i, values[i]);
+        }
+        break;
+      }
+    default:
+      break;
+  }
+  return regs;
+}
+
+result<uint64_t> read_encoded(SpanStream& stream, uint8_t encoding,
+                              size_t ptr_size)
+{
+  switch (static_cast<dwarf::EH_ENCODING>(encoding & 0x0f)) {
+    case dwarf::EH_ENCODING::ABSPTR:
+      {
+        if (ptr_size == sizeof(uint64_t)) {
+          return stream.read<uint64_t>();
+        }
+        return stream.read<uint32_t>();
+      }
+    case dwarf::EH_ENCODING::ULEB128: return stream.read_uleb128();
+    case dwarf::EH_ENCODING::SLEB128: return stream.read_sleb128();
+    case dwarf::EH_ENCODING::UDATA2:  return stream.read<uint16_t>();
+    case dwarf::EH_ENCODING::UDATA4:  return stream.read<uint32_t>();
+    case dwarf::EH_ENCODING::UDATA8:  return stream.read<uint64_t>();
+    case dwarf::EH_ENCODING::SDATA2:
+      {
+        auto value = stream.read<int16_t>();
+        if (!value) {
+          return make_error_code(value.error());
+        }
+        return static_cast<uint64_t>(static_cast<int64_t>(*value));
+      }
+    case dwarf::EH_ENCODING::SDATA4:
+      {
+        auto value = stream.read<int32_t>();
+        if (!value) {
+          return make_error_code(value.error());
+        }
+        return static_cast<uint64_t>(static_cast<int64_t>(*value));
+      }
+    case dwarf::EH_ENCODING::SDATA8: return stream.read<uint64_t>();
+    default:
+      return make_error_code(lief_errors::not_supported);
+  }
+}
+
+//! Read a pointer encoded with ``encoding`` located at ``address``
+result<uint64_t> read_pointer(SpanStream& stream, uint8_t encoding,
+                              size_t ptr_size, uint64_t address,
+                              uint64_t datarel = 0)
+{
+  if (encoding == static_cast<uint8_t>(dwarf::EH_ENCODING::OMIT)) {
+    return make_error_code(lief_errors::not_found);
+  }
+  auto value = read_encoded(stream, encoding, ptr_size);
+  if (!value) {
+    return make_error_code(value.error());
+  }
+  switch (static_cast<dwarf::EH_ENCODING>(encoding & 0x70)) {
+    case dwarf::EH_ENCODING::ABSPTR:
+      break;
+    case dwarf::EH_ENCODING::PCREL:
+      *value += address;
+      break;
+    case dwarf::EH_ENCODING::DATAREL:
+      *value += datarel;
+      break;
+    default:
+      return make_error_code(lief_errors::not_supported);
+  }
+  if (ptr_size == sizeof(uint32_t)) {
+    *value &= 0xffffffff;
+  }
+  return *value;
+}
+
+//! ``value * factor`` without signed overflow on malformed CFI
+int64_t scale(uint64_t value, int64_t factor) {
+  return static_cast<int64_t>(value * static_cast<uint64_t>(factor));
+}
+
+//! Rule to recover a register of the caller
+struct rule_t {
+  enum KIND : uint8_t {
+    SAME = 0, UNDEFINED, OFFSET, VAL_OFFSET, REGISTER, EXPRESSION, VAL_EXPRESSION,
+  };
+  KIND kind = SAME;
+  int64_t value = 0;
+  span<const uint8_t> expr;
+};
+
+//! Row of the CFI table for a given address
+struct row_t {
+  bool cfa_is_expr = false;
+  uint32_t cfa_reg = 0;
+  int64_t cfa_offset = 0;
+  span<const uint8_t> cfa_expr;
+  bool negate_ra = false;
+  std::array<rule_t, NB_REGS> rules;
+};
+}
+
+struct CoreUnwinder::core_t {
+  struct region_t {
+    uint64_t start = 0;
+    uint64_t end = 0;
+    const uint8_t* data = nullptr;
+  };
+
+  struct mapping_t {
+    uint64_t start = 0;
+    uint64_t end = 0;
+    uint64_t offset = 0;
+    const std::string* path = nullptr;
+    //! Build-id of the mapped file (empty if its first page is not dumped)
+    std::vector<uint8_t> build_id;
+  };
+
+  arch_t arch;
+  std::vector<region_t> regions;
+  std::vector<mapping_t> mappings;
+
+  static result<core_t> create(const Binary& core) {
+    if (core.header().file_type() != Header::FILE_TYPE::CORE) {
+      LIEF_ERR("The binary is not a core file");
+      return make_error_code(lief_errors::file_format_error);
+    }
+
+    auto arch = get_arch(core.header().machine_type());
+    if (!arch) {
+      LIEF_ERR("Architecture not supported: {}",
+               to_string(core.header().machine_type()));
+      return make_error_code(arch.error());
+    }
+
+    core_t out;
+    out.arch = *arch;
+    for (const Segment& segment : core.segments()) {
+      if (segment.type() != Segment::TYPE::LOAD) {
+        continue;
+      }
+      span<const uint8_t> content = segment.content();
+      if (content.empty()) {
+        continue;
+      }
+      const uint64_t start = segment.virtual_address();
+      out.regions.push_back({start, start + content.size(), content.data()});
+    }
+    std::sort(out.regions.begin(), out.regions.end(),
+              [] (const region_t& lhs, const region_t& rhs) {
+                return lhs.start < rhs.start;
+              });
+
+    for (const Note& note : core.notes()) {
+      if (!CoreFile::classof(&note)) {
+        continue;
+      }
+      const auto* file = static_cast<const CoreFile*>(&note);
+      for (const CoreFile::entry_t& entry : file->files()) {
+        out.mappings.push_back({entry.start, entry.end,
+                                entry.file_ofs * file->page_size(), &entry.path, {}});
+      }
+    }
+    std::sort(out.mappings.begin(), out.mappings.end(),
+              [] (const mapping_t& lhs, const mapping_t& rhs) {
+                return lhs.start < rhs.start;
+              });
+
+    // The build-id is read from the ELF header mapped at the offset 0 of the
+    // file and shared with the other mappings of the file
+    std::unordered_map<std::string, std::vector<uint8_t>> build_ids;
+    for (const mapping_t& map : out.mappings) {
+      if (map.offset == 0 && build_ids.count(*map.path) == 0) {
+        build_ids.emplace(*map.path, out.read_build_id(map.start, map.end - map.start));
+      }
+    }
+    for (mapping_t& map : out.mappings) {
+      if (auto it = build_ids.find(*map.path); it != build_ids.end()) {
+        map.build_id = it->second;
+      }
+    }
+    return out;
+  }
+
+  //! Memory of the core at ``[address, address + size)`` or a nullptr if the
+  //! range is not entirely dumped in a single segment
+  const uint8_t* data(uint64_t address, uint64_t size) const {
+    auto it = std::upper_bound(regions.begin(), regions.end(), address,
+        [] (uint64_t addr, const region_t& region) {
+          return addr < region.start;
+        });
+    if (it == regions.begin()) {
+      return nullptr;
+    }
+    --it;
+    if (address + size < address || address + size > it->end) {
+      return nullptr;
+    }
+    return it->data + (address - it->start);
+  }
+
+  bool read(uint64_t address, size_t size, uint64_t& value) const {
+    const uint8_t* ptr = data(address, size);
+    if (ptr == nullptr) {
+      return false;
+    }
+    value = 0;
+    std::memcpy(&value, ptr, size);
+    return true;
+  }
+
+  bool read_ptr(uint64_t address, uint64_t& value) const {
+    return read(address, arch.ptr_size, value);
+  }
+
+  const mapping_t* mapping(uint64_t address) const {
+    auto it = std::upper_bound(mappings.begin(), mappings.end(), address,
+        [] (uint64_t addr, const mapping_t& map) {
+          return addr < map.start;
+        });
+    if (it == mappings.begin()) {
+      return nullptr;
+    }
+    --it;
+    return address < it->end ? &*it : nullptr;
+  }
+
+  //! Evaluate a DWARF expression of the CFI
+  result<uint64_t> evaluate(span<const uint8_t> expr, const regs_t& regs,
+                            bool push_cfa, uint64_t cfa) const;
+
+  //! Read the ``NT_GNU_BUILD_ID`` note of the (little-endian) ELF file
+  //! whose first ``size`` bytes are mapped at ``base``
+  std::vector<uint8_t> read_build_id(uint64_t base, uint64_t size) const;
+};
+
+std::vector<uint8_t> CoreUnwinder::core_t::read_build_id(uint64_t base, uint64_t size) const {
+  static constexpr uint32_t PT_NOTE = 4;
+  static constexpr uint32_t NT_GNU_BUILD_ID = 3;
+  static constexpr uint8_t ELFCLASS64 = 2;
+  static constexpr uint8_t ELFDATA2LSB = 1;
+
+  const uint8_t* ident = data(base, 0x40);
+  if (ident == nullptr || size < 0x40 || std::memcmp(ident, "\x7f" "ELF", 4) != 0 ||
+      ident[5] != ELFDATA2LSB)
+  {
+    return {};
+  }
+  const bool is64 = ident[4] == ELFCLASS64;
+  uint64_t phoff = 0;
+  uint64_t phentsize = 0;
+  uint64_t phnum = 0;
+  if (!read(base + (is64 ? 0x20 : 0x1c), is64 ? 8 : 4, phoff) ||
+      !read(base + (is64 ? 0x36 : 0x2a), 2, phentsize) ||
+      !read(base + (is64 ? 0x38 : 0x2c), 2, phnum))
+  {
+    return {};
+  }
+
+  for (uint64_t i = 0; i < phnum; ++i) {
+    const uint64_t phdr = phoff + i * phentsize;
+    uint64_t type = 0;
+    uint64_t offset = 0;
+    uint64_t filesz = 0;
+    if (phdr + phentsize > size || !read(base + phdr, 4, type) ||
+        !read(base + phdr + (is64 ? 0x08 : 0x04), is64 ? 8 : 4, offset) ||
+        !read(base + phdr + (is64 ? 0x20 : 0x10), is64 ? 8 : 4, filesz))
+    {
+      return {};
+    }
+    if (type != PT_NOTE || offset > size || filesz > size - offset) {
+      continue;
+    }
+    const uint8_t* notes = data(base + offset, filesz);
+    if (notes == nullptr) {
+      continue;
+    }
+    SpanStream stream(notes, filesz);
+    while (stream.pos() + 3 * sizeof(uint32_t) <= stream.size()) {
+      const uint32_t namesz = *stream.read<uint32_t>();
+      const uint32_t descsz = *stream.read<uint32_t>();
+      const uint32_t ntype = *stream.read<uint32_t>();
+      const uint64_t name_pos = stream.pos();
+      const uint64_t desc_pos = name_pos + align(namesz, sizeof(uint32_t));
+      const uint64_t next = desc_pos + align(descsz, sizeof(uint32_t));
+      if (next > stream.size()) {
+        break;
+      }
+      if (ntype == NT_GNU_BUILD_ID && namesz == 4 &&
+          std::memcmp(notes + name_pos, "GNU", 4) == 0)
+      {
+        return {notes + desc_pos, notes + desc_pos + descsz};
+      }
+      stream.setpos(next);
+    }
+  }
+  return {};
+}
+
+struct CoreUnwinder::module_t {
+  struct cie_t {
+    uint64_t code_align = 1;
+    int64_t data_align = 0;
+    uint32_t ra = 0;
+    uint8_t fde_encoding = 0;
+    bool has_augmentation = false;
+    bool signal_frame = false;
+    span<const uint8_t> instructions;
+  };
+
+  struct fde_t {
+    uint64_t pc_begin = 0;
+    uint64_t pc_end = 0;
+    const cie_t* cie = nullptr;
+    span<const uint8_t> instructions;
+  };
+
+  std::unique_ptr<Binary> owned;
+  const Binary* bin = nullptr;
+  size_t ptr_size = 8;
+
+  //! ``NT_GNU_BUILD_ID`` of the module (empty if unknown)
+  std::vector<uint8_t> build_id;
+
+  //! Protect the tables that are lazily built (index, cies) when the
+  //! threads are unwound concurrently
+  std::mutex lock;
+
+  span<const uint8_t> eh_frame;
+  uint64_t eh_frame_address = 0;
+
+  //! Binary search table of ``.eh_frame_hdr`` (``DW_EH_PE_datarel | DW_EH_PE_sdata4``)
+  span<const uint8_t> hdr_table;
+  uint64_t hdr_address = 0;
+
+  //! Sorted (pc_begin, FDE offset) built from ``.eh_frame`` when the table
+  //! of ``.eh_frame_hdr`` is not usable
+  std::vector<std::pair<uint64_t, uint64_t>> index;
+
+  std::unordered_map<uint64_t, cie_t> cies;
+
+  explicit module_t(const Binary* binary) :
+    bin(binary)
+  {
+    if (bin != nullptr) {
+      init();
+    }
+  }
+
+  //! Whether this module can be used for a file with the given build-id.
+  //! An unknown build-id matches any module.
+  bool matches(const std::vector<uint8_t>& id) const {
+    return id.empty() || build_id.empty() || id == build_id;
+  }
+
+  void init();
+  void build_index();
+  const cie_t* cie(uint64_t offset);
+  result<fde_t> parse_fde(uint64_t offset);
+  result<fde_t> find_fde(uint64_t address);
+  ok_error_t execute(const fde_t& fde, uint64_t address, row_t& row) const;
+  ok_error_t execute(span<const uint8_t> instructions, const cie_t& cie,
+                     uint64_t pc_begin, uint64_t address, const row_t& initial,
+                     row_t& row) const;
+
+  //! Load bias of the module for the given mapping
+  result<uint64_t> bias(const core_t::mapping_t& map) const {
+    for (const Segment& segment : bin->segments()) {
+      if (segment.type() != Segment::TYPE::LOAD) {
+        continue;
+      }
+      const uint64_t align = std::max<uint64_t>(segment.alignment(), 1);
+      const uint64_t start = segment.file_offset() & ~(align - 1);
+      if (start <= map.offset && map.offset < segment.file_offset() + segment.physical_size()) {
+        return map.start - map.offset -
+               (segment.virtual_address() - segment.file_offset());
+      }
+    }
+    return make_error_code(lief_errors::not_found);
+  }
+};
+
+void CoreUnwinder::module_t::init() {
+  ptr_size = bin->header().identity_class() == Header::CLASS::ELF32 ?
+             sizeof(uint32_t) : sizeof(uint64_t);
+
+  if (const Note* note = bin->get(Note::TYPE::GNU_BUILD_ID)) {
+    span<const uint8_t> desc = note->description();
+    build_id.assign(desc.begin(), desc.end());
+  }
+
+  if (const Section* section = bin->get_section(".eh_frame")) {
+    eh_frame = section->content();
+    eh_frame_address = section->virtual_address();
+  }
+
+  span<const uint8_t> hdr;
+  if (const Segment* segment = bin->get(Segment::TYPE::GNU_EH_FRAME)) {
+    hdr = segment->content();
+    hdr_address = segment->virtual_address();
+  }
+
+  if (hdr.size() >= 4 && hdr[0] == 1) {
+    SpanStream stream(hdr);
+    stream.setpos(4);
+    const uint8_t eh_frame_ptr_enc = hdr[1];
+    const uint8_t fde_count_enc = hdr[2];
+    const uint8_t table_enc = hdr[3];
+    auto eh_frame_ptr = read_pointer(stream, eh_frame_ptr_enc, ptr_size,
+                                     hdr_address + stream.pos());
+    auto fde_count = read_pointer(stream, fde_count_enc, ptr_size,
+                                  hdr_address + stream.pos());
+
+    if (eh_frame.empty() && eh_frame_ptr) {
+      // Stripped section table: .eh_frame spans up to the end of its segment
+      if (const Segment* segment = bin->segment_from_virtual_address(Segment::TYPE::LOAD, *eh_frame_ptr)) {
+        span<const uint8_t> content = segment->content();
+        const uint64_t offset = *eh_frame_ptr - segment->virtual_address();
+        if (offset < content.size()) {
+          eh_frame = content.subspan(offset);
+          eh_frame_address = *eh_frame_ptr;
+        }
+      }
+    }
+
+    static constexpr uint8_t DATAREL_SDATA4 = 0x3b;
+    if (fde_count && table_enc == DATAREL_SDATA4 &&
+        eh_frame_ptr && *eh_frame_ptr == eh_frame_address)
+    {
+      const uint64_t size = *fde_count * 2 * sizeof(int32_t);
+      if (*fde_count <= hdr.size() && stream.pos() + size <= hdr.size()) {
+        hdr_table = hdr.subspan(stream.pos(), size);
+      }
+    }
+  }
+}
+
+void CoreUnwinder::module_t::build_index() {
+  SpanStream stream(eh_frame);
+  while (stream.pos() + sizeof(uint32_t) <= stream.size()) {
+    const uint64_t offset = stream.pos();
+    uint64_t length = *stream.read<uint32_t>();
+    if (length == 0) {
+      break;
+    }
+    if (length == 0xffffffff) {
+      auto length64 = stream.read<uint64_t>();
+      if (!length64) {
+        break;
+      }
+      length = *length64;
+    }
+    const uint64_t next = stream.pos() + length;
+    if (next < stream.pos() || next > stream.size()) {
+      break;
+    }
+    auto cie_ptr = stream.read<uint32_t>();
+    if (cie_ptr && *cie_ptr != 0) {
+      if (auto fde = parse_fde(offset)) {
+        index.emplace_back(fde->pc_begin, offset);
+      }
+    }
+    stream.setpos(next);
+  }
+  std::sort(index.begin(), index.end());
+  LIEF_DEBUG("{} FDEs indexed from .eh_frame", index.size());
+}
+
+const CoreUnwinder::module_t::cie_t* CoreUnwinder::module_t::cie(uint64_t offset) {
+  if (auto it = cies.find(offset); it != cies.end()) {
+    return &it->second;
+  }
+
+  if (offset + sizeof(uint32_t) > eh_frame.size()) {
+    return nullptr;
+  }
+
+  SpanStream stream(eh_frame);
+  stream.setpos(offset);
+  uint64_t length = *stream.read<uint32_t>();
+  if (length == 0xffffffff) {
+    auto length64 = stream.read<uint64_t>();
+    if (!length64) {
+      return nullptr;
+    }
+    length = *length64;
+  }
+  const uint64_t end = stream.pos() + length;
+  if (end < stream.pos() || end > stream.size()) {
+    return nullptr;
+  }
+
+  auto id = stream.read<uint32_t>();
+  auto version = stream.read<uint8_t>();
+  auto augmentation = stream.read_string();
+  if (!id || *id != 0 || !version || !augmentation) {
+    return nullptr;
+  }
+
+  cie_t entry;
+  auto code_align = stream.read_uleb128();
+  auto data_align = stream.read_sleb128();
+  if (!code_align || !data_align) {
+    return nullptr;
+  }
+  entry.code_align = *code_align;
+  entry.data_align = static_cast<int64_t>(*data_align);
+
+  if (*version == 1) {
+    auto ra = stream.read<uint8_t>();
+    if (!ra) {
+      return nullptr;
+    }
+    entry.ra = *ra;
+  } else {
+    auto ra = stream.read_uleb128();
+    if (!ra) {
+      return nullptr;
+    }
+    entry.ra = static_cast<uint32_t>(*ra);
+  }
+
+  uint64_t instructions = stream.pos();
+  if (!augmentation->empty() && (*augmentation)[0] == 'z') {
+    entry.has_augmentation = true;
+    auto aug_size = stream.read_uleb128();
+    if (!aug_size) {
+      return nullptr;
+    }
+    instructions = stream.pos() + *aug_size;
+    for (char c : augmentation->substr(1)) {
+      if (c == 'R') {
+        auto encoding = stream.read<uint8_t>();
+        if (!encoding) {
+          return nullptr;
+        }
+        entry.fde_encoding = *encoding;
+      } else if (c == 'P') {
+        auto encoding = stream.read<uint8_t>();
+        if (!encoding || !read_encoded(stream, *encoding, ptr_size)) {
+          return nullptr;
+        }
+      } else if (c == 'L') {
+        if (!stream.read<uint8_t>()) {
+          return nullptr;
+        }
+      } else if (c == 'S') {
+        entry.signal_frame = true;
+      } else if (c != 'B') {
+        LIEF_DEBUG("Unknown CIE augmentation: '{}'", *augmentation);
+        break;
+      }
+    }
+  } else if (!augmentation->empty()) {
+    LIEF_DEBUG("Unsupported CIE augmentation: '{}'", *augmentation);
+    return nullptr;
+  }
+
+  if (instructions > end) {
+    return nullptr;
+  }
+  entry.instructions = eh_frame.subspan(instructions, end - instructions);
+  return &cies.emplace(offset, entry).first->second;
+}
+
+result<CoreUnwinder::module_t::fde_t> CoreUnwinder::module_t::parse_fde(uint64_t offset) {
+  if (offset + sizeof(uint32_t) > eh_frame.size()) {
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  SpanStream stream(eh_frame);
+  stream.setpos(offset);
+  uint64_t length = *stream.read<uint32_t>();
+  if (length == 0xffffffff) {
+    auto length64 = stream.read<uint64_t>();
+    if (!length64) {
+      return make_error_code(lief_errors::read_out_of_bound);
+    }
+    length = *length64;
+  }
+  const uint64_t end = stream.pos() + length;
+  if (end < stream.pos() || end > stream.size()) {
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  const uint64_t cie_pointer_pos = stream.pos();
+  auto cie_pointer = stream.read<uint32_t>();
+  if (!cie_pointer || *cie_pointer == 0 || *cie_pointer > cie_pointer_pos) {
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  const cie_t* entry_cie = cie(cie_pointer_pos - *cie_pointer);
+  if (entry_cie == nullptr) {
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  fde_t fde;
+  fde.cie = entry_cie;
+  auto pc_begin = read_pointer(stream, entry_cie->fde_encoding, ptr_size,
+                               eh_frame_address + stream.pos());
+  auto pc_range = read_encoded(stream, entry_cie->fde_encoding & 0x0f, ptr_size);
+  if (!pc_begin || !pc_range) {
+    return make_error_code(lief_errors::corrupted);
+  }
+  fde.pc_begin = *pc_begin;
+  fde.pc_end = *pc_begin + *pc_range;
+
+  if (entry_cie->has_augmentation) {
+    auto aug_size = stream.read_uleb128();
+    if (!aug_size) {
+      return make_error_code(lief_errors::corrupted);
+    }
+    stream.increment_pos(*aug_size);
+  }
+  if (stream.pos() > end) {
+    return make_error_code(lief_errors::corrupted);
+  }
+  fde.instructions = eh_frame.subspan(stream.pos(), end - stream.pos());
+  return fde;
+}
+
+result<CoreUnwinder::module_t::fde_t> CoreUnwinder::module_t::find_fde(uint64_t address) {
+  if (eh_frame.empty()) {
+    return make_error_code(lief_errors::not_found);
+  }
+  std::lock_guard<std::mutex> guard(lock);
+
+  uint64_t offset = 0;
+  if (!hdr_table.empty()) {
+    // The table is sorted by initial location: find the last one <= address
+    const size_t count = hdr_table.size() / (2 * sizeof(int32_t));
+    auto location = [&] (size_t idx, size_t field) {
+      int32_t value = 0;
+      std::memcpy(&value, hdr_table.data() + idx * 2 * sizeof(int32_t) +
+                          field * sizeof(int32_t), sizeof(value));
+      return hdr_address + static_cast<int64_t>(value);
+    };
+    size_t lo = 0;
+    size_t hi = count;
+    while (lo < hi) {
+      const size_t mid = lo + (hi - lo) / 2;
+      if (location(mid, 0) <= address) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    if (lo == 0) {
+      return make_error_code(lief_errors::not_found);
+    }
+    offset = location(lo - 1, 1) - eh_frame_address;
+  } else {
+    if (index.empty()) {
+      build_index();
+    }
+    auto it = std::upper_bound(index.begin(), index.end(), address,
+        [] (uint64_t addr, const std::pair<uint64_t, uint64_t>& entry) {
+          return addr < entry.first;
+        });
+    if (it == index.begin()) {
+      return make_error_code(lief_errors::not_found);
+    }
+    offset = std::prev(it)->second;
+  }
+
+  auto fde = parse_fde(offset);
+  if (!fde) {
+    return make_error_code(fde.error());
+  }
+  if (address < fde->pc_begin || address >= fde->pc_end) {
+    return make_error_code(lief_errors::not_found);
+  }
+  return fde;
+}
+
+ok_error_t CoreUnwinder::module_t::execute(const fde_t& fde, uint64_t address,
+                                           row_t& row) const
+{
+  row_t initial;
+  if (!execute(fde.cie->instructions, *fde.cie, fde.pc_begin, UINT64_MAX, initial, initial)) {
+    return make_error_code(lief_errors::corrupted);
+  }
+  row = initial;
+  return execute(fde.instructions, *fde.cie, fde.pc_begin, address, initial, row);
+}
+
+ok_error_t CoreUnwinder::module_t::execute(
+    span<const uint8_t> instructions, const cie_t& cie, uint64_t pc_begin,
+    uint64_t address, const row_t& initial, row_t& row) const
+{
+  SpanStream stream(instructions);
+  std::vector<row_t> states;
+  uint64_t loc = pc_begin;
+
+  auto reg_rule = [&] (uint64_t reg) -> rule_t* {
+    return reg < NB_REGS ? &row.rules[reg] : nullptr;
+  };
+
+  auto set_rule = [&] (uint64_t reg, rule_t::KIND kind, int64_t value = 0,
+                       span<const uint8_t> expr = {}) {
+    if (rule_t* rule = reg_rule(reg)) {
+      *rule = {kind, value, expr};
+    }
+  };
+
+  auto restore = [&] (uint64_t reg) {
+    if (reg < NB_REGS) {
+      row.rules[reg] = initial.rules[reg];
+    }
+  };
+
+  auto read_block = [&] () -> result<span<const uint8_t>> {
+    auto size = stream.read_uleb128();
+    if (!size || stream.pos() + *size > stream.size()) {
+      return make_error_code(lief_errors::corrupted);
+    }
+    span<const uint8_t> block = instructions.subspan(stream.pos(), *size);
+    stream.increment_pos(*size);
+    return block;
+  };
+
+  while (stream.pos() < stream.size()) {
+    const uint8_t opcode = *stream.read<uint8_t>();
+    const uint8_t high = opcode & 0xc0;
+    const uint8_t low = opcode & 0x3f;
+
+    if (high == DW_CFA_advance_loc) {
+      loc += low * cie.code_align;
+      if (loc > address) {
+        return ok();
+      }
+      continue;
+    }
+
+    if (high == DW_CFA_offset) {
+      auto offset = stream.read_uleb128();
+      if (!offset) {
+        return make_error_code(lief_errors::corrupted);
+      }
+      set_rule(low, rule_t::OFFSET, scale(*offset, cie.data_align));
+      continue;
+    }
+
+    if (high == DW_CFA_restore) {
+      restore(low);
+      continue;
+    }
+
+    switch (opcode) {
+      case DW_CFA_nop:
+      case DW_CFA_GNU_args_size:
+        {
+          if (opcode == DW_CFA_GNU_args_size && !stream.read_uleb128()) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          break;
+        }
+
+      case DW_CFA_set_loc:
+        {
+          auto value = read_pointer(stream, cie.fde_encoding, ptr_size,
+                                    eh_frame_address + (instructions.data() - eh_frame.data()) + stream.pos());
+          if (!value) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          loc = *value;
+          if (loc > address) {
+            return ok();
+          }
+          break;
+        }
+
+      case DW_CFA_advance_loc1:
+      case DW_CFA_advance_loc2:
+      case DW_CFA_advance_loc4:
+        {
+          result<uint64_t> delta = make_error_code(lief_errors::corrupted);
+          if (opcode == DW_CFA_advance_loc1) {
+            delta = stream.read<uint8_t>();
+          } else if (opcode == DW_CFA_advance_loc2) {
+            delta = stream.read<uint16_t>();
+          } else {
+            delta = stream.read<uint32_t>();
+          }
+          if (!delta) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          loc += *delta * cie.code_align;
+          if (loc > address) {
+            return ok();
+          }
+          break;
+        }
+
+      case DW_CFA_offset_extended:
+      case DW_CFA_offset_extended_sf:
+      case DW_CFA_val_offset:
+      case DW_CFA_val_offset_sf:
+      case DW_CFA_GNU_negative_offset_extended:
+        {
+          auto reg = stream.read_uleb128();
+          const bool is_signed = opcode == DW_CFA_offset_extended_sf ||
+                                 opcode == DW_CFA_val_offset_sf;
+          auto value = is_signed ? stream.read_sleb128() : stream.read_uleb128();
+          if (!reg || !value) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          int64_t offset = scale(*value, cie.data_align);
+          if (opcode == DW_CFA_GNU_negative_offset_extended) {
+            offset = scale(offset, -1);
+          }
+          const bool is_val = opcode == DW_CFA_val_offset || opcode == DW_CFA_val_offset_sf;
+          set_rule(*reg, is_val ? rule_t::VAL_OFFSET : rule_t::OFFSET, offset);
+          break;
+        }
+
+      case DW_CFA_restore_extended:
+      case DW_CFA_undefined:
+      case DW_CFA_same_value:
+        {
+          auto reg = stream.read_uleb128();
+          if (!reg) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          if (opcode == DW_CFA_restore_extended) {
+            restore(*reg);
+          } else {
+            set_rule(*reg, opcode == DW_CFA_undefined ? rule_t::UNDEFINED : rule_t::SAME);
+          }
+          break;
+        }
+
+      case DW_CFA_register:
+        {
+          auto reg = stream.read_uleb128();
+          auto other = stream.read_uleb128();
+          if (!reg || !other) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          set_rule(*reg, rule_t::REGISTER, static_cast<int64_t>(*other));
+          break;
+        }
+
+      case DW_CFA_remember_state:
+        {
+          if (states.size() >= MAX_STATES) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          states.push_back(row);
+          break;
+        }
+
+      case DW_CFA_restore_state:
+        {
+          if (states.empty()) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          // Like libgcc and libunwind, the CFA rule is part of the saved row
+          row = states.back();
+          states.pop_back();
+          break;
+        }
+
+      case DW_CFA_def_cfa:
+      case DW_CFA_def_cfa_sf:
+        {
+          auto reg = stream.read_uleb128();
+          auto offset = opcode == DW_CFA_def_cfa_sf ? stream.read_sleb128() :
+                                                      stream.read_uleb128();
+          if (!reg || !offset) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          row.cfa_is_expr = false;
+          row.cfa_reg = static_cast<uint32_t>(*reg);
+          row.cfa_offset = opcode == DW_CFA_def_cfa_sf ?
+                           scale(*offset, cie.data_align) :
+                           static_cast<int64_t>(*offset);
+          break;
+        }
+
+      case DW_CFA_def_cfa_register:
+        {
+          auto reg = stream.read_uleb128();
+          if (!reg) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          row.cfa_is_expr = false;
+          row.cfa_reg = static_cast<uint32_t>(*reg);
+          break;
+        }
+
+      case DW_CFA_def_cfa_offset:
+      case DW_CFA_def_cfa_offset_sf:
+        {
+          auto offset = opcode == DW_CFA_def_cfa_offset_sf ? stream.read_sleb128() :
+                                                             stream.read_uleb128();
+          if (!offset) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          row.cfa_offset = opcode == DW_CFA_def_cfa_offset_sf ?
+                           scale(*offset, cie.data_align) :
+                           static_cast<int64_t>(*offset);
+          break;
+        }
+
+      case DW_CFA_def_cfa_expression:
+        {
+          auto block = read_block();
+          if (!block) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          row.cfa_is_expr = true;
+          row.cfa_expr = *block;
+          break;
+        }
+
+      case DW_CFA_expression:
+      case DW_CFA_val_expression:
+        {
+          auto reg = stream.read_uleb128();
+          if (!reg) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          auto block = read_block();
+          if (!block) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          set_rule(*reg, opcode == DW_CFA_expression ? rule_t::EXPRESSION :
+                                                       rule_t::VAL_EXPRESSION, 0, *block);
+          break;
+        }
+
+      case DW_CFA_AARCH64_negate_ra_state:
+        {
+          row.negate_ra = !row.negate_ra;
+          break;
+        }
+
+      default:
+        {
+          LIEF_DEBUG("Unsupported CFA instruction: 0x{:02x}", opcode);
+          return make_error_code(lief_errors::not_supported);
+        }
+    }
+  }
+  return ok();
+}
+
+result<uint64_t> CoreUnwinder::core_t::evaluate(
+    span<const uint8_t> expr, const regs_t& regs, bool push_cfa, uint64_t cfa) const
+{
+  SpanStream stream(expr);
+  std::vector<uint64_t> stack;
+  if (push_cfa) {
+    stack.push_back(cfa);
+  }
+
+  auto pop = [&] (uint64_t& value) {
+    if (stack.empty()) {
+      return false;
+    }
+    value = stack.back();
+    stack.pop_back();
+    return true;
+  };
+
+  for (size_t nb_ops = 0; stream.pos() < stream.size(); ++nb_ops) {
+    if (nb_ops > MAX_OPS || stack.size() > MAX_STACK) {
+      return make_error_code(lief_errors::corrupted);
+    }
+    const uint8_t op = *stream.read<uint8_t>();
+
+    if (DW_OP_lit0 <= op && op <= DW_OP_lit31) {
+      stack.push_back(op - DW_OP_lit0);
+      continue;
+    }
+
+    if (DW_OP_breg0 <= op && op <= DW_OP_breg31) {
+      auto offset = stream.read_sleb128();
+      if (!offset || !regs.has(op - DW_OP_breg0)) {
+        return make_error_code(lief_errors::corrupted);
+      }
+      stack.push_back(regs.get(op - DW_OP_breg0) + *offset);
+      continue;
+    }
+
+    switch (op) {
+      case DW_OP_nop:
+        break;
+
+      case DW_OP_addr:
+        {
+          auto value = read_encoded(stream, 0, arch.ptr_size);
+          if (!value) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          stack.push_back(*value);
+          break;
+        }
+
+      case DW_OP_const1u: case DW_OP_const1s:
+      case DW_OP_const2u: case DW_OP_const2s:
+      case DW_OP_const4u: case DW_OP_const4s:
+      case DW_OP_const8u: case DW_OP_const8s:
+      case DW_OP_constu:  case DW_OP_consts:
+        {
+          static constexpr uint8_t ENCODINGS[] = {
+            /* const1u */ 0x00, /* const1s */ 0x00,
+            /* const2u */ 0x02, /* const2s */ 0x0a,
+            /* const4u */ 0x03, /* const4s */ 0x0b,
+            /* const8u */ 0x04, /* const8s */ 0x0c,
+            /* constu  */ 0x01, /* consts  */ 0x09,
+          };
+          result<uint64_t> value = make_error_code(lief_errors::corrupted);
+          if (op == DW_OP_const1u) {
+            value = stream.read<uint8_t>();
+          } else if (op == DW_OP_const1s) {
+            auto byte = stream.read<int8_t>();
+            if (byte) {
+              value = static_cast<uint64_t>(static_cast<int64_t>(*byte));
+            }
+          } else {
+            value = read_encoded(stream, ENCODINGS[op - DW_OP_const1u], arch.ptr_size);
+          }
+          if (!value) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          stack.push_back(*value);
+          break;
+        }
+
+      case DW_OP_bregx:
+        {
+          auto reg = stream.read_uleb128();
+          auto offset = stream.read_sleb128();
+          if (!reg || !offset || !regs.has(*reg)) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          stack.push_back(regs.get(*reg) + *offset);
+          break;
+        }
+
+      case DW_OP_dup:
+      case DW_OP_over:
+      case DW_OP_pick:
+        {
+          uint64_t idx = op == DW_OP_over ? 1 : 0;
+          if (op == DW_OP_pick) {
+            auto value = stream.read<uint8_t>();
+            if (!value) {
+              return make_error_code(lief_errors::corrupted);
+            }
+            idx = *value;
+          }
+          if (idx >= stack.size()) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          stack.push_back(stack[stack.size() - 1 - idx]);
+          break;
+        }
+
+      case DW_OP_drop:
+        {
+          uint64_t value = 0;
+          if (!pop(value)) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          break;
+        }
+
+      case DW_OP_swap:
+        {
+          if (stack.size() < 2) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          std::swap(stack[stack.size() - 1], stack[stack.size() - 2]);
+          break;
+        }
+
+      case DW_OP_rot:
+        {
+          if (stack.size() < 3) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          const size_t top = stack.size() - 1;
+          std::rotate(stack.begin() + top - 2, stack.begin() + top, stack.end());
+          break;
+        }
+
+      case DW_OP_deref:
+      case DW_OP_deref_size:
+        {
+          size_t size = arch.ptr_size;
+          if (op == DW_OP_deref_size) {
+            auto value = stream.read<uint8_t>();
+            if (!value || *value == 0 || *value > sizeof(uint64_t)) {
+              return make_error_code(lief_errors::corrupted);
+            }
+            size = *value;
+          }
+          uint64_t address = 0;
+          uint64_t value = 0;
+          if (!pop(address) || !read(address, size, value)) {
+            return make_error_code(lief_errors::read_error);
+          }
+          stack.push_back(value);
+          break;
+        }
+
+      case DW_OP_abs:
+      case DW_OP_neg:
+      case DW_OP_not:
+      case DW_OP_plus_uconst:
+        {
+          uint64_t value = 0;
+          if (!pop(value)) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          if (op == DW_OP_abs) {
+            value = static_cast<int64_t>(value) < 0 ? -value : value;
+          } else if (op == DW_OP_neg) {
+            value = -value;
+          } else if (op == DW_OP_not) {
+            value = ~value;
+          } else {
+            auto addend = stream.read_uleb128();
+            if (!addend) {
+              return make_error_code(lief_errors::corrupted);
+            }
+            value += *addend;
+          }
+          stack.push_back(value);
+          break;
+        }
+
+      case DW_OP_and:   case DW_OP_div:   case DW_OP_minus:
+      case DW_OP_mod:   case DW_OP_mul:   case DW_OP_or:
+      case DW_OP_plus:  case DW_OP_shl:   case DW_OP_shr:
+      case DW_OP_shra:  case DW_OP_xor:   case DW_OP_eq:
+      case DW_OP_ge:    case DW_OP_gt:    case DW_OP_le:
+      case DW_OP_lt:    case DW_OP_ne:
+        {
+          uint64_t rhs = 0;
+          uint64_t lhs = 0;
+          if (!pop(rhs) || !pop(lhs)) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          const auto slhs = static_cast<int64_t>(lhs);
+          const auto srhs = static_cast<int64_t>(rhs);
+          uint64_t value = 0;
+          switch (op) {
+            case DW_OP_and:   value = lhs & rhs; break;
+            case DW_OP_minus: value = lhs - rhs; break;
+            case DW_OP_mul:   value = lhs * rhs; break;
+            case DW_OP_or:    value = lhs | rhs; break;
+            case DW_OP_plus:  value = lhs + rhs; break;
+            case DW_OP_shl:   value = rhs < 64 ? lhs << rhs : 0; break;
+            case DW_OP_shr:   value = rhs < 64 ? lhs >> rhs : 0; break;
+            case DW_OP_shra:  value = static_cast<uint64_t>(slhs >> std::min<uint64_t>(rhs, 63)); break;
+            case DW_OP_xor:   value = lhs ^ rhs; break;
+            case DW_OP_eq:    value = slhs == srhs; break;
+            case DW_OP_ge:    value = slhs >= srhs; break;
+            case DW_OP_gt:    value = slhs > srhs; break;
+            case DW_OP_le:    value = slhs <= srhs; break;
+            case DW_OP_lt:    value = slhs < srhs; break;
+            case DW_OP_ne:    value = slhs != srhs; break;
+            case DW_OP_div:
+            case DW_OP_mod:
+              {
+                if (rhs == 0) {
+                  return make_error_code(lief_errors::corrupted);
+                }
+                if (op == DW_OP_mod) {
+                  value = lhs % rhs;
+                } else if (srhs == -1) {
+                  value = -lhs;
+                } else {
+                  value = static_cast<uint64_t>(slhs / srhs);
+                }
+                break;
+              }
+            default: break;
+          }
+          stack.push_back(value);
+          break;
+        }
+
+      case DW_OP_skip:
+      case DW_OP_bra:
+        {
+          auto offset = stream.read<int16_t>();
+          if (!offset) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          uint64_t cond = 1;
+          if (op == DW_OP_bra && !pop(cond)) {
+            return make_error_code(lief_errors::corrupted);
+          }
+          if (cond != 0) {
+            const int64_t target = static_cast<int64_t>(stream.pos()) + *offset;
+            if (target < 0 || static_cast<uint64_t>(target) > stream.size()) {
+              return make_error_code(lief_errors::corrupted);
+            }
+            stream.setpos(target);
+          }
+          break;
+        }
+
+      default:
+        {
+          LIEF_DEBUG("Unsupported DWARF expression operation: 0x{:02x}", op);
+          return make_error_code(lief_errors::not_supported);
+        }
+    }
+  }
+
+  if (stack.empty()) {
+    return make_error_code(lief_errors::corrupted);
+  }
+  return stack.back();
+}
+
+CoreUnwinder::CoreUnwinder() :
+  lock_(std::make_unique<std::mutex>())
+{}
+CoreUnwinder::CoreUnwinder(CoreUnwinder&&) noexcept = default;
+CoreUnwinder& CoreUnwinder::operator=(CoreUnwinder&&) noexcept = default;
+CoreUnwinder::~CoreUnwinder() = default;
+
+void CoreUnwinder::insert_module(const std::string& path, std::unique_ptr<module_t> entry) {
+  std::vector<std::unique_ptr<module_t>>& builds = modules_[path];
+  // Replace the module with the same build-id and the negative entries
+  builds.erase(std::remove_if(builds.begin(), builds.end(),
+    [&entry] (const std::unique_ptr<module_t>& mod) {
+      return mod->bin == nullptr || mod->build_id == entry->build_id;
+    }), builds.end());
+  builds.push_back(std::move(entry));
+}
+
+void CoreUnwinder::add_module(const std::string& path, std::unique_ptr<Binary> module) {
+  const Binary* bin = module.get();
+  auto entry = std::make_unique<module_t>(bin);
+  entry->owned = std::move(module);
+  insert_module(path, std::move(entry));
+}
+
+void CoreUnwinder::add_module(const std::string& path, const Binary& module) {
+  insert_module(path, std::make_unique<module_t>(&module));
+}
+
+size_t CoreUnwinder::nb_modules() const {
+  size_t count = 0;
+  for (const auto& [_, builds] : modules_) {
+    count += builds.size();
+  }
+  return count;
+}
+
+void CoreUnwinder::clear_cache() {
+  modules_.clear();
+}
+
+CoreUnwinder::module_t* CoreUnwinder::module(const std::string& path,
+                                             const std::vector<uint8_t>& build_id)
+{
+  std::lock_guard<std::mutex> guard(*lock_);
+  if (auto it = modules_.find(path); it != modules_.end()) {
+    for (const std::unique_ptr<module_t>& mod : it->second) {
+      if (mod->matches(build_id)) {
+        return mod->bin != nullptr ? mod.get() : nullptr;
+      }
+    }
+  }
+
+  ParserConfig config;
+  config.parse_relocations = false;
+  config.parse_dyn_symbols = false;
+  config.parse_symtab_symbols = false;
+  config.parse_symbol_versions = false;
+  config.parse_overlay = false;
+
+  const std::string fullpath = sysroot_ + path;
+  std::unique_ptr<Binary> bin = Parser::parse(fullpath, config);
+  auto entry = std::make_unique<module_t>(bin.get());
+  entry->owned = std::move(bin);
+  if (entry->bin == nullptr || !entry->matches(build_id)) {
+    if (entry->bin == nullptr) {
+      LIEF_WARN("Can't load the module '{}'", fullpath);
+    } else {
+      LIEF_WARN("The build-id of '{}' does not match the core", fullpath);
+    }
+    // Negative entry: don't try to load the file again for this build-id
+    entry = std::make_unique<module_t>(nullptr);
+    entry->build_id = build_id;
+    modules_[path].push_back(std::move(entry));
+    return nullptr;
+  }
+  module_t* mod = entry.get();
+  modules_[path].push_back(std::move(entry));
+  return mod;
+}
+
+CoreUnwinder::thread_t CoreUnwinder::unwind(const core_t& core, const CorePrStatus& status) {
+  thread_t thread;
+  const CorePrStatus::pr_status_t info = status.status();
+  thread.tid = info.pid;
+  thread.signal = info.cursig;
+
+  regs_t regs = get_regs(status);
+  auto pc = status.pc();
+  if (!pc || !regs.has(core.arch.sp)) {
+    LIEF_WARN("Can't read the registers of the thread {}", thread.tid);
+    return thread;
+  }
+
+  const uint32_t sp_reg = core.arch.sp;
+  const uint32_t fp_reg = core.arch.fp;
+  const size_t ptr_size = core.arch.ptr_size;
+  const uint64_t ptr_mask = ptr_size == sizeof(uint32_t) ? 0xffffffff : UINT64_MAX;
+
+  uint64_t current_pc = *pc;
+  METHOD method = METHOD::CONTEXT;
+  // Whether the current pc is exact (first frame or interrupted by a signal)
+  bool exact_pc = true;
+
+  while (thread.frames.size() < max_frames_) {
+    frame_t frame;
+    frame.pc = current_pc;
+    frame.sp = regs.get(sp_reg);
+    frame.method = method;
+
+    const uint64_t lookup = exact_pc ? current_pc : current_pc - 1;
+    module_t* mod = nullptr;
+    uint64_t bias = 0;
+    if (const core_t::mapping_t* map = core.mapping(lookup)) {
+      frame.module = *map->path;
+      mod = module(*map->path, map->build_id);
+      if (mod != nullptr) {
+        if (auto res = mod->bias(*map)) {
+          bias = *res;
+          frame.offset = current_pc - bias;
+        } else {
+          mod = nullptr;
+        }
+      }
+    }
+    thread.frames.push_back(std::move(frame));
+
+    regs_t caller = regs;
+    uint64_t caller_pc = 0;
+    bool unwound = false;
+    bool is_signal = false;
+
+    // CFI of the module
+    row_t row;
+    result<module_t::fde_t> fde = make_error_code(lief_errors::not_found);
+    if (mod != nullptr) {
+      fde = mod->find_fde(lookup - bias);
+    }
+    if (fde && mod->execute(*fde, lookup - bias, row)) {
+      uint64_t cfa = 0;
+      bool valid = true;
+      if (row.cfa_is_expr) {
+        auto value = core.evaluate(row.cfa_expr, regs, false, 0);
+        valid = (bool)value;
+        cfa = value.value_or(0);
+      } else {
+        valid = regs.has(row.cfa_reg);
+        cfa = regs.get(row.cfa_reg) + row.cfa_offset;
+      }
+      cfa &= ptr_mask;
+
+      for (size_t reg = 0; valid && reg < NB_REGS; ++reg) {
+        const rule_t& rule = row.rules[reg];
+        uint64_t value = 0;
+        switch (rule.kind) {
+          case rule_t::SAME:
+            break;
+          case rule_t::UNDEFINED:
+            caller.clear(reg);
+            break;
+          case rule_t::OFFSET:
+            if (core.read_ptr(cfa + rule.value, value)) {
+              caller.set(reg, value);
+            } else {
+              caller.clear(reg);
+            }
+            break;
+          case rule_t::VAL_OFFSET:
+            caller.set(reg, (cfa + rule.value) & ptr_mask);
+            break;
+          case rule_t::REGISTER:
+            if (regs.has(rule.value)) {
+              caller.set(reg, regs.get(rule.value));
+            } else {
+              caller.clear(reg);
+            }
+            break;
+          case rule_t::EXPRESSION:
+          case rule_t::VAL_EXPRESSION:
+            {
+              auto res = core.evaluate(rule.expr, regs, true, cfa);
+              if (res && rule.kind == rule_t::EXPRESSION && core.read_ptr(*res, value)) {
+                caller.set(reg, value);
+              } else if (res && rule.kind == rule_t::VAL_EXPRESSION) {
+                caller.set(reg, *res & ptr_mask);
+              } else {
+                caller.clear(reg);
+              }
+              break;
+            }
+        }
+      }
+
+      const uint32_t ra = fde->cie->ra;
+      if (valid && row.rules[ra < NB_REGS ? ra : 0].kind == rule_t::UNDEFINED) {
+        // Outermost frame (e.g. _start or the thread's entry point)
+        break;
+      }
+
+      if (valid && caller.has(ra)) {
+        caller_pc = caller.get(ra);
+        if (row.negate_ra) {
+          // Strip the pointer authentication code
+          caller_pc &= (uint64_t(1) << 48) - 1;
+        }
+        caller.set(sp_reg, cfa);
+        unwound = true;
+        is_signal = fde->cie->signal_frame;
+        method = METHOD::CFI;
+      }
+    }
+
+    // Frame-pointer chain
+    if (!unwound && regs.has(fp_reg)) {
+      const uint64_t fp = regs.get(fp_reg);
+      uint64_t next_fp = 0;
+      uint64_t ra = 0;
+      if (fp >= regs.get(sp_reg) && fp % ptr_size == 0 &&
+          core.read_ptr(fp, next_fp) && core.read_ptr(fp + ptr_size, ra))
+      {
+        caller.set(fp_reg, next_fp);
+        caller.set(sp_reg, fp + 2 * ptr_size);
+        caller_pc = ra;
+        unwound = true;
+        method = METHOD::FRAME_POINTER;
+      }
+    }
+
+    if (!unwound || caller_pc == 0) {
+      break;
+    }
+
+    // The stack must grow up unless the frame is a signal trampoline
+    const uint64_t sp = regs.get(sp_reg);
+    const uint64_t caller_sp = caller.get(sp_reg);
+    if (!is_signal && (caller_sp < sp || (caller_sp == sp && caller_pc == current_pc))) {
+      LIEF_DEBUG("Unwinding of thread {} stopped at 0x{:x} (bad stack pointer)",
+                 thread.tid, current_pc);
+      break;
+    }
+
+    regs = caller;
+    current_pc = caller_pc & ptr_mask;
+    exact_pc = is_signal;
+  }
+  return thread;
+}
+
+result<CoreUnwinder::thread_t> CoreUnwinder::unwind(const Binary& core,
+                                                    const CorePrStatus& status)
+{
+  auto ctx = core_t::create(core);
+  if (!ctx) {
+    return make_error_code(ctx.error());
+  }
+  return unwind(*ctx, status);
+}
+
+result<std::vector<CoreUnwinder::thread_t>> CoreUnwinder::unwind(const Binary& core,
+                                                                 uint32_t nb_threads)
+{
+  auto ctx = core_t::create(core);
+  if (!ctx) {
+    return make_error_code(ctx.error());
+  }
+
+  std::vector<const CorePrStatus*> status;
+  for (const Note& note : core.notes()) {
+    if (CorePrStatus::classof(&note)) {
+      status.push_back(static_cast<const CorePrStatus*>(&note));
+    }
+  }
+
+  std::vector<thread_t> threads(status.size());
+  parallel_for(status.size(), nb_threads, [&] (size_t i) {
+    threads[i] = unwind(*ctx, *status[i]);
+  });
+  return threads;
+}
+
+const char* to_string(CoreUnwinder::METHOD e) {
+  #define ENTRY(X) std::pair(CoreUnwinder::METHOD::X, #X)
+  STRING_MAP enums2str {
+    ENTRY(CONTEXT),
+    ENTRY(CFI),
+    ENTRY(FRAME_POINTER),
+  };
+  #undef ENTRY
+
+  if (auto it = enums2str.find(e); it != enums2str.end()) {
+    return it->second;
+  }
+  return "UNKNOWN";
+}
+
+}
+}
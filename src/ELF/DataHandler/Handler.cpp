@@ -22,6 +22,8 @@
 #include "LIEF/BinaryStream/VectorStream.hpp"
 #include "LIEF/BinaryStream/SpanStream.hpp"
 #include "LIEF/BinaryStream/FileStream.hpp"
+#include "LIEF/BinaryStream/CompressedStream.hpp"
+#include "LIEF/BinaryStream/ForwardStream.hpp"
 
 #include "ELF/DataHandler/Handler.hpp"
 
@@ -59,24 +61,52 @@ result<std::unique_ptr<Handler>> Handler::from_stream(std::unique_ptr<BinaryStre
   if (VectorStream::classof(*stream)) {
     auto& vs = static_cast<VectorStream&>(*stream);
 
-    hdl->data_ = std::move(vs.move_content());
+    *hdl->data_ = std::move(vs.move_content());
     const uint64_t pos = vs.pos();
-    stream = std::make_unique<DataHandlerStream>(hdl->data_);
+    stream = std::make_unique<DataHandlerStream>(*hdl->data_);
     stream->setpos(pos);
     return hdl;
   }
 
   if (SpanStream::classof(*stream)) {
     auto& vs = static_cast<SpanStream&>(*stream);
-    hdl->data_ = vs.content();
+    *hdl->data_ = vs.content();
     return hdl;
   }
 
   if (FileStream::classof(*stream)) {
     auto& vs = static_cast<FileStream&>(*stream);
-    hdl->data_ = vs.content();
+    *hdl->data_ = vs.content();
     const uint64_t pos = vs.pos();
-    stream = std::make_unique<DataHandlerStream>(hdl->data_);
+    stream = std::make_unique<DataHandlerStream>(*hdl->data_);
+    stream->setpos(pos);
+    return hdl;
+  }
+
+  if (CompressedStream::classof(*stream)) {
+    // The sections and the segments reference the content of the file so
+    // that it must be fully decompressed. This is done in a single
+    // sequential pass, then the compressed stream (index and cache) is
+    // released.
+    auto& cs = static_cast<CompressedStream&>(*stream);
+    *hdl->data_ = cs.content();
+    const uint64_t pos = cs.pos();
+    stream = std::make_unique<DataHandlerStream>(*hdl->data_);
+    stream->setpos(pos);
+    return hdl;
+  }
+
+  if (ForwardStream::classof(*stream)) {
+    // Same as the compressed streams: the ELF parsing is not streamed and
+    // the whole input is buffered (see the warning of ForwardStream)
+    auto& fs = static_cast<ForwardStream&>(*stream);
+    if (!fs.fill_to_end()) {
+      LIEF_ERR("Can't buffer the whole input");
+      return make_error_code(lief_errors::read_error);
+    }
+    const uint64_t pos = fs.pos();
+    *hdl->data_ = fs.move_content();
+    stream = std::make_unique<DataHandlerStream>(*hdl->data_);
     stream->setpos(pos);
     return hdl;
   }
@@ -141,12 +171,23 @@ Node& Handler::add(const Node& node) {
   return *nodes_.back();
 }
 
+std::unique_ptr<Handler> Handler::clone() const {
+  auto hdl = std::unique_ptr<Handler>(new Handler{});
+  hdl->data_ = data_;
+  hdl->nodes_.reserve(nodes_.size());
+  for (const std::unique_ptr<Node>& node : nodes_) {
+    hdl->nodes_.push_back(std::make_unique<Node>(*node));
+  }
+  return hdl;
+}
+
 ok_error_t Handler::make_hole(uint64_t offset, uint64_t size) {
   auto res = reserve(offset, size);
   if (!res) {
     return res;
   }
-  data_.insert(std::begin(data_) + offset, size, 0);
+  std::vector<uint8_t>& data = content();
+  data.insert(std::begin(data) + offset, size, 0);
   return ok();
 }
 
@@ -159,7 +200,7 @@ ok_error_t Handler::reserve(uint64_t offset, uint64_t size) {
     return make_error_code(lief_errors::corrupted);
   }
 
-  if (static_cast<uint64_t>(full_size) > data_.max_size()) {
+  if (static_cast<uint64_t>(full_size) > data_->max_size()) {
     return make_error_code(lief_errors::corrupted);
   }
 
@@ -167,12 +208,12 @@ ok_error_t Handler::reserve(uint64_t offset, uint64_t size) {
     return make_error_code(lief_errors::corrupted);
   }
 
-  const bool must_resize = data_.size() < (offset + size);
+  const bool must_resize = data_->size() < (offset + size);
   if (!must_resize) {
     return ok();
   }
 
-  data_.resize(offset + size, 0);
+  content().resize(offset + size, 0);
   return ok();
 }
 
@@ -37,7 +37,7 @@ class LIEF_API Handler {
 
   static constexpr size_t MAX_SIZE = 4_GB;
   Handler(std::vector<uint8_t> content) :
-    data_(std::move(content))
+    data_(std::make_shared<std::vector<uint8_t>>(std::move(content)))
   {}
 
   ~Handler() = default;
@@ -51,13 +51,32 @@ class LIEF_API Handler {
   Handler(Handler&&) noexcept = default;
 
   const std::vector<uint8_t>& content() const {
-    return data_;
+    return *data_;
   }
 
+  //! Mutable access to the content. If the content is shared with a
+  //! clone, it is copied first (copy-on-write)
   std::vector<uint8_t>& content() {
-    return data_;
+    detach();
+    return *data_;
   }
 
+  //! Make a private copy of the content if it is shared
+  void detach() {
+    if (data_.use_count() > 1) {
+      data_ = std::make_shared<std::vector<uint8_t>>(*data_);
+    }
+  }
+
+  //! Whether the content is shared with another Handler
+  bool is_shared() const {
+    return data_.use_count() > 1;
+  }
+
+  //! Create a new Handler with the same nodes and that shares the
+  //! content of this one until one of them modifies it
+  std::unique_ptr<Handler> clone() const;
+
   Node& add(const Node& node);
 
   bool has(uint64_t offset, uint64_t size, Node::Type type);
@@ -77,7 +96,7 @@ class LIEF_API Handler {
   private:
   Handler() = default;
   Handler(BinaryStream& stream);
-  std::vector<uint8_t> data_;
+  std::shared_ptr<std::vector<uint8_t>> data_ = std::make_shared<std::vector<uint8_t>>();
   std::vector<std::unique_ptr<Node>> nodes_;
 };
 } // namespace DataHandler
@@ -0,0 +1,790 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "logging.hpp"
+
+#include "LIEF/BinaryStream/Convert.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
+
+#include "LIEF/ELF/Binary.hpp"
+#include "LIEF/ELF/DynamicEntryRpath.hpp"
+#include "LIEF/ELF/DynamicEntryRunPath.hpp"
+#include "LIEF/ELF/DynamicPatcher.hpp"
+#include "LIEF/ELF/DynamicSharedObject.hpp"
+#include "LIEF/ELF/Header.hpp"
+#include "LIEF/ELF/Parser.hpp"
+#include "LIEF/ELF/Section.hpp"
+#include "LIEF/ELF/Segment.hpp"
+
+#include "ELF/Structures.hpp"
+
+namespace LIEF {
+namespace ELF {
+
+static constexpr size_t MAX_VERSION_ENTRIES = 0x10000;
+static constexpr uint64_t MAX_SYMBOLS = 0x1000000;
+
+constexpr bool is_host_big_endian() {
+  #if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__)
+    return __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+  #else
+    return false;
+  #endif
+}
+
+//! Dynamic entries whose value is an offset in ``.dynstr``
+inline bool is_string_tag(uint64_t tag) {
+  switch (tag) {
+    case uint64_t(DynamicEntry::TAG::NEEDED):
+    case uint64_t(DynamicEntry::TAG::SONAME):
+    case uint64_t(DynamicEntry::TAG::RPATH):
+    case uint64_t(DynamicEntry::TAG::RUNPATH):
+    case 0x6ffffefa: // DT_CONFIG
+    case 0x6ffffefb: // DT_DEPAUDIT
+    case 0x6ffffefc: // DT_AUDIT
+    case 0x7ffffffd: // DT_AUXILIARY
+    case 0x7fffffff: // DT_FILTER
+      return true;
+    default:
+      return false;
+  }
+}
+
+DynamicPatcher::DynamicPatcher() = default;
+DynamicPatcher::DynamicPatcher(DynamicPatcher&&) noexcept = default;
+DynamicPatcher& DynamicPatcher::operator=(DynamicPatcher&&) noexcept = default;
+DynamicPatcher::~DynamicPatcher() = default;
+
+result<DynamicPatcher> DynamicPatcher::open(const std::string& path) {
+  std::ifstream ifs(path, std::ios::in | std::ios::binary);
+  if (!ifs) {
+    LIEF_ERR("Can't open '{}'", path);
+    return make_error_code(lief_errors::file_error);
+  }
+
+  DynamicPatcher patcher;
+  patcher.data_ = {std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+  patcher.buffer_ = patcher.data_;
+  patcher.path_ = path;
+  if (auto is_ok = patcher.init(); !is_ok) {
+    return make_error_code(get_error(is_ok));
+  }
+  return patcher;
+}
+
+result<DynamicPatcher> DynamicPatcher::from_buffer(span<uint8_t> buffer) {
+  DynamicPatcher patcher;
+  patcher.buffer_ = buffer;
+  if (auto is_ok = patcher.init(); !is_ok) {
+    return make_error_code(get_error(is_ok));
+  }
+  return patcher;
+}
+
+ok_error_t DynamicPatcher::init() {
+  static constexpr uint8_t ELF_MAGIC[] = {0x7f, 'E', 'L', 'F'};
+  if (buffer_.size() < sizeof(details::Elf32_Ehdr) ||
+      memcmp(buffer_.data(), ELF_MAGIC, sizeof(ELF_MAGIC)) != 0)
+  {
+    LIEF_ERR("Wrong ELF magic");
+    return make_error_code(lief_errors::file_format_error);
+  }
+
+  const auto elf_class = static_cast<Header::CLASS>(buffer_[Header::ELI_CLASS]);
+  const auto elf_data  = static_cast<Header::ELF_DATA>(buffer_[Header::ELI_DATA]);
+
+  if (elf_data != Header::ELF_DATA::LSB && elf_data != Header::ELF_DATA::MSB) {
+    LIEF_ERR("Unknown ELF endianness");
+    return make_error_code(lief_errors::file_format_error);
+  }
+  swap_ = (elf_data == Header::ELF_DATA::MSB) != is_host_big_endian();
+
+  if (elf_class == Header::CLASS::ELF32) {
+    is64_ = false;
+    return init<details::ELF32>();
+  }
+  if (elf_class == Header::CLASS::ELF64) {
+    is64_ = true;
+    return init<details::ELF64>();
+  }
+  LIEF_ERR("Unknown ELF class");
+  return make_error_code(lief_errors::file_format_error);
+}
+
+template<class ELF_T>
+ok_error_t DynamicPatcher::init() {
+  using Elf_Ehdr = typename ELF_T::Elf_Ehdr;
+  using Elf_Phdr = typename ELF_T::Elf_Phdr;
+  using Elf_Shdr = typename ELF_T::Elf_Shdr;
+  using Elf_Dyn  = typename ELF_T::Elf_Dyn;
+  using Elf_Sym  = typename ELF_T::Elf_Sym;
+
+  SpanStream stream(buffer_);
+  stream.set_endian_swap(swap_);
+
+  auto hdr = stream.peek_conv<Elf_Ehdr>(0);
+  if (!hdr) {
+    LIEF_ERR("Can't read the ELF header");
+    return make_error_code(lief_errors::read_error);
+  }
+
+  uint64_t dynamic_size = 0;
+  bool has_dynamic = false;
+  for (size_t i = 0; i < hdr->e_phnum; ++i) {
+    auto phdr = stream.peek_conv<Elf_Phdr>(hdr->e_phoff + i * sizeof(Elf_Phdr));
+    if (!phdr) {
+      LIEF_ERR("Can't read the segment #{}", i);
+      return make_error_code(lief_errors::read_error);
+    }
+    const uint64_t p_offset = phdr->p_offset;
+    const uint64_t p_filesz = phdr->p_filesz;
+    if (p_offset > buffer_.size() || p_filesz > buffer_.size() - p_offset) {
+      continue;
+    }
+    switch (static_cast<Segment::TYPE>(phdr->p_type)) {
+      case Segment::TYPE::LOAD:
+        loads_.push_back({phdr->p_offset, phdr->p_vaddr, phdr->p_filesz});
+        break;
+      case Segment::TYPE::INTERP:
+        interp_offset_ = phdr->p_offset;
+        interp_size_   = phdr->p_filesz;
+        break;
+      case Segment::TYPE::DYNAMIC:
+        dynamic_offset_ = phdr->p_offset;
+        dynamic_size    = phdr->p_filesz;
+        has_dynamic = true;
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (!has_dynamic) {
+    LIEF_ERR("The binary does not have a PT_DYNAMIC segment");
+    return make_error_code(lief_errors::not_found);
+  }
+
+  const size_t nb_slots = dynamic_size / sizeof(Elf_Dyn);
+  size_t idx = 0;
+  for (; idx < nb_slots; ++idx) {
+    auto dyn = stream.peek_conv<Elf_Dyn>(dynamic_offset_ + idx * sizeof(Elf_Dyn));
+    if (!dyn) {
+      return make_error_code(lief_errors::read_error);
+    }
+    if (dyn->d_tag == 0) {
+      break;
+    }
+    entries_.push_back({static_cast<uint64_t>(dyn->d_tag), dyn->d_un.d_val});
+  }
+
+  if (idx == nb_slots) {
+    LIEF_ERR("The dynamic table is not terminated by DT_NULL");
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  // Trailing DT_NULL entries (after the terminator) that can be used for
+  // new entries
+  for (++idx; idx < nb_slots; ++idx) {
+    auto dyn = stream.peek_conv<Elf_Dyn>(dynamic_offset_ + idx * sizeof(Elf_Dyn));
+    if (!dyn || dyn->d_tag != 0) {
+      break;
+    }
+    ++spare_slots_;
+  }
+
+  const auto get_entry = [this] (DynamicEntry::TAG tag) -> const dynamic_entry_t* {
+    auto it = std::find_if(entries_.begin(), entries_.end(),
+      [tag] (const dynamic_entry_t& e) { return e.tag == uint64_t(tag); });
+    return it == entries_.end() ? nullptr : &*it;
+  };
+
+  const dynamic_entry_t* dt_strtab = get_entry(DynamicEntry::TAG::STRTAB);
+  const dynamic_entry_t* dt_strsz  = get_entry(DynamicEntry::TAG::STRSZ);
+  if (dt_strtab == nullptr || dt_strsz == nullptr) {
+    LIEF_ERR("Missing DT_STRTAB/DT_STRSZ");
+    return make_error_code(lief_errors::not_found);
+  }
+
+  auto strtab_offset = va2offset(dt_strtab->value);
+  if (!strtab_offset || *strtab_offset > buffer_.size() ||
+      dt_strsz->value > buffer_.size() - *strtab_offset)
+  {
+    LIEF_ERR("Can't resolve the location of .dynstr");
+    return make_error_code(lief_errors::corrupted);
+  }
+  strtab_offset_   = *strtab_offset;
+  strtab_size_     = dt_strsz->value;
+  strtab_used_     = strtab_size_;
+  strtab_capacity_ = strtab_size_;
+
+  // .dynstr can only grow within its PT_LOAD segment
+  uint64_t strtab_limit = strtab_offset_ + strtab_size_;
+  for (const load_t& load : loads_) {
+    if (load.offset <= strtab_offset_ && strtab_offset_ - load.offset < load.size) {
+      strtab_limit = load.offset + load.size;
+      break;
+    }
+  }
+
+  // Symbol tables (offset, count) that use .dynstr
+  std::vector<std::pair<uint64_t, uint64_t>> symtabs;
+  bool has_dynstr_section = false;
+  bool refs_known = true;
+
+  const bool has_sections = hdr->e_shoff > 0 && hdr->e_shnum > 0 &&
+                            hdr->e_shentsize == sizeof(Elf_Shdr);
+  std::vector<Elf_Shdr> sections;
+  if (has_sections) {
+    for (size_t i = 0; i < hdr->e_shnum; ++i) {
+      auto shdr = stream.peek_conv<Elf_Shdr>(hdr->e_shoff + i * sizeof(Elf_Shdr));
+      if (!shdr) {
+        sections.clear();
+        break;
+      }
+      sections.push_back(*shdr);
+    }
+  }
+
+  size_t dynstr_idx = sections.size();
+  for (size_t i = 0; i < sections.size(); ++i) {
+    const Elf_Shdr& shdr = sections[i];
+    if (shdr.sh_type == uint32_t(Section::TYPE::STRTAB) && shdr.sh_offset == strtab_offset_) {
+      dynstr_idx = i;
+      has_dynstr_section = true;
+      strtab_shdr_size_offset_ = hdr->e_shoff + i * sizeof(Elf_Shdr) +
+                                 offsetof(Elf_Shdr, sh_size);
+      continue;
+    }
+    if (shdr.sh_type != uint32_t(Section::TYPE::NOBITS) && shdr.sh_size > 0 &&
+        shdr.sh_offset > strtab_offset_)
+    {
+      strtab_limit = std::min<uint64_t>(strtab_limit, shdr.sh_offset);
+    }
+  }
+  if (hdr->e_shoff > strtab_offset_) {
+    strtab_limit = std::min<uint64_t>(strtab_limit, hdr->e_shoff);
+  }
+  if (hdr->e_phoff > strtab_offset_) {
+    strtab_limit = std::min<uint64_t>(strtab_limit, hdr->e_phoff);
+  }
+
+  if (has_dynstr_section) {
+    for (const Elf_Shdr& shdr : sections) {
+      if (shdr.sh_link != dynstr_idx) {
+        continue;
+      }
+      switch (static_cast<Section::TYPE>(shdr.sh_type)) {
+        case Section::TYPE::SYMTAB:
+        case Section::TYPE::DYNSYM:
+          symtabs.emplace_back(shdr.sh_offset, shdr.sh_size / sizeof(Elf_Sym));
+          break;
+        case Section::TYPE::DYNAMIC:
+        case Section::TYPE::GNU_VERDEF:
+        case Section::TYPE::GNU_VERNEED:
+          break;
+        default:
+          // Unknown user of .dynstr
+          refs_known = false;
+      }
+    }
+  } else if (const dynamic_entry_t* dt_hash = get_entry(DynamicEntry::TAG::HASH)) {
+    // Without the sections, the number of symbols is given by the
+    // nchain value of the SYSV hash table
+    const dynamic_entry_t* dt_symtab = get_entry(DynamicEntry::TAG::SYMTAB);
+    auto hash_offset = va2offset(dt_hash->value);
+    auto symtab_offset = dt_symtab != nullptr ? va2offset(dt_symtab->value) :
+                                                make_error_code(lief_errors::not_found);
+    auto nchain = hash_offset ? stream.peek_conv<uint32_t>(*hash_offset + sizeof(uint32_t)) :
+                                make_error_code(lief_errors::not_found);
+    if (symtab_offset && nchain) {
+      symtabs.emplace_back(*symtab_offset, *nchain);
+    } else {
+      refs_known = false;
+    }
+  } else {
+    refs_known = false;
+  }
+
+  refs_known_ = refs_known && collect_string_refs<ELF_T>(symtabs);
+  if (!refs_known_) {
+    LIEF_DEBUG("Can't find all the references to .dynstr: "
+               "the existing strings won't be modified");
+    string_refs_.clear();
+    return ok();
+  }
+
+  // Strings that are not referenced after the last referenced string are
+  // considered as free
+  strtab_used_ = 1;
+  const auto update_used = [this] (uint64_t ref) {
+    const std::string str = string_at(ref);
+    strtab_used_ = std::max<uint64_t>(strtab_used_, ref + str.size() + 1);
+  };
+  for (const dynamic_entry_t& entry : entries_) {
+    if (is_string_tag(entry.tag)) {
+      update_used(entry.value);
+    }
+  }
+  for (uint64_t ref : string_refs_) {
+    update_used(ref);
+  }
+  strtab_used_ = std::min(strtab_used_, strtab_size_);
+
+  // .dynstr can grow in its zero-padding if the section headers can be
+  // updated accordingly
+  if (has_dynstr_section) {
+    strtab_limit = std::min<uint64_t>(strtab_limit, buffer_.size());
+    uint64_t end = strtab_offset_ + strtab_size_;
+    while (end < strtab_limit && buffer_[end] == 0) {
+      ++end;
+    }
+    strtab_capacity_ = end - strtab_offset_;
+  }
+  return ok();
+}
+
+template<class ELF_T>
+bool DynamicPatcher::collect_string_refs(const std::vector<std::pair<uint64_t, uint64_t>>& symtabs) {
+  using Elf_Sym     = typename ELF_T::Elf_Sym;
+  using Elf_Verneed = typename ELF_T::Elf_Verneed;
+  using Elf_Vernaux = typename ELF_T::Elf_Vernaux;
+  using Elf_Verdef  = typename ELF_T::Elf_Verdef;
+  using Elf_Verdaux = typename ELF_T::Elf_Verdaux;
+
+  SpanStream stream(buffer_);
+  stream.set_endian_swap(swap_);
+
+  for (const auto& [offset, count] : symtabs) {
+    if (count > MAX_SYMBOLS) {
+      return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      auto sym = stream.peek_conv<Elf_Sym>(offset + i * sizeof(Elf_Sym));
+      if (!sym) {
+        return false;
+      }
+      string_refs_.push_back(sym->st_name);
+    }
+  }
+
+  const auto get_value = [this] (DynamicEntry::TAG tag) -> uint64_t {
+    for (const dynamic_entry_t& entry : entries_) {
+      if (entry.tag == uint64_t(tag)) {
+        return entry.value;
+      }
+    }
+    return 0;
+  };
+
+  if (const uint64_t verneed = get_value(DynamicEntry::TAG::VERNEED); verneed != 0) {
+    auto offset = va2offset(verneed);
+    if (!offset) {
+      return false;
+    }
+    const size_t nb_entries = std::min<size_t>(get_value(DynamicEntry::TAG::VERNEEDNUM),
+                                               MAX_VERSION_ENTRIES);
+    uint64_t vn_offset = *offset;
+    for (size_t i = 0; i < nb_entries; ++i) {
+      auto vn = stream.peek_conv<Elf_Verneed>(vn_offset);
+      if (!vn) {
+        return false;
+      }
+      string_refs_.push_back(vn->vn_file);
+      uint64_t vna_offset = vn_offset + vn->vn_aux;
+      for (size_t j = 0; j < vn->vn_cnt; ++j) {
+        auto vna = stream.peek_conv<Elf_Vernaux>(vna_offset);
+        if (!vna) {
+          return false;
+        }
+        string_refs_.push_back(vna->vna_name);
+        if (vna->vna_next == 0) {
+          break;
+        }
+        vna_offset += vna->vna_next;
+      }
+      if (vn->vn_next == 0) {
+        break;
+      }
+      vn_offset += vn->vn_next;
+    }
+  }
+
+  if (const uint64_t verdef = get_value(DynamicEntry::TAG::VERDEF); verdef != 0) {
+    auto offset = va2offset(verdef);
+    if (!offset) {
+      return false;
+    }
+    const size_t nb_entries = std::min<size_t>(get_value(DynamicEntry::TAG::VERDEFNUM),
+                                               MAX_VERSION_ENTRIES);
+    uint64_t vd_offset = *offset;
+    for (size_t i = 0; i < nb_entries; ++i) {
+      auto vd = stream.peek_conv<Elf_Verdef>(vd_offset);
+      if (!vd) {
+        return false;
+      }
+      uint64_t vda_offset = vd_offset + vd->vd_aux;
+      for (size_t j = 0; j < vd->vd_cnt; ++j) {
+        auto vda = stream.peek_conv<Elf_Verdaux>(vda_offset);
+        if (!vda) {
+          return false;
+        }
+        string_refs_.push_back(vda->vda_name);
+        if (vda->vda_next == 0) {
+          break;
+        }
+        vda_offset += vda->vda_next;
+      }
+      if (vd->vd_next == 0) {
+        break;
+      }
+      vd_offset += vd->vd_next;
+    }
+  }
+  return true;
+}
+
+result<uint64_t> DynamicPatcher::va2offset(uint64_t va) const {
+  for (const load_t& load : loads_) {
+    if (load.vaddr <= va && va - load.vaddr < load.size) {
+      return load.offset + (va - load.vaddr);
+    }
+  }
+  return make_error_code(lief_errors::not_found);
+}
+
+std::string DynamicPatcher::string_at(uint64_t offset) const {
+  if (offset >= strtab_size_) {
+    return "";
+  }
+  const auto* start = reinterpret_cast<const char*>(buffer_.data() + strtab_offset_ + offset);
+  const size_t max_size = strtab_size_ - offset;
+  const void* end = memchr(start, 0, max_size);
+  if (end == nullptr) {
+    return std::string(start, max_size);
+  }
+  return std::string(start, static_cast<const char*>(end));
+}
+
+bool DynamicPatcher::is_referenced(uint64_t start, uint64_t end, size_t owner) const {
+  // With tail merging (e.g. "libfoo.so" and "foo.so" sharing their bytes),
+  // a string that starts before ``start`` can reach the range
+  auto overlaps = [this, start, end] (uint64_t ref) {
+    if (ref >= start) {
+      return ref < end;
+    }
+    return ref < strtab_size_ && ref + string_at(ref).size() > start;
+  };
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    const dynamic_entry_t& entry = entries_[i];
+    if (i != owner && is_string_tag(entry.tag) && overlaps(entry.value)) {
+      return true;
+    }
+  }
+  return std::any_of(string_refs_.begin(), string_refs_.end(), overlaps);
+}
+
+template<class T>
+void DynamicPatcher::write_int(uint64_t offset, T value) {
+  if (swap_) {
+    value = BinaryStream::swap_endian(value);
+  }
+  write(offset, {reinterpret_cast<const uint8_t*>(&value), sizeof(T)});
+}
+
+void DynamicPatcher::write(uint64_t offset, span<const uint8_t> data) {
+  std::copy(data.begin(), data.end(), buffer_.begin() + offset);
+  modifications_.emplace_back(offset, data.size());
+}
+
+void DynamicPatcher::write_entry(size_t idx) {
+  const dynamic_entry_t& entry = entries_[idx];
+  if (is64_) {
+    details::Elf64_Dyn dyn;
+    dyn.d_tag = static_cast<int64_t>(entry.tag);
+    dyn.d_un.d_val = entry.value;
+    if (swap_) {
+      Convert::swap_endian(&dyn);
+    }
+    write(dynamic_offset_ + idx * sizeof(dyn), {reinterpret_cast<const uint8_t*>(&dyn), sizeof(dyn)});
+  } else {
+    details::Elf32_Dyn dyn;
+    dyn.d_tag = static_cast<int32_t>(entry.tag);
+    dyn.d_un.d_val = static_cast<uint32_t>(entry.value);
+    if (swap_) {
+      Convert::swap_endian(&dyn);
+    }
+    write(dynamic_offset_ + idx * sizeof(dyn), {reinterpret_cast<const uint8_t*>(&dyn), sizeof(dyn)});
+  }
+}
+
+result<uint64_t> DynamicPatcher::place_string(const std::string& value, size_t owner) {
+  if (value.find('\0') != std::string::npos) {
+    LIEF_ERR("The string can't contain a null byte");
+    return make_error_code(lief_errors::not_supported);
+  }
+
+  // 1. Reuse an existing string (or the suffix of a string)
+  {
+    const uint8_t* start = buffer_.data() + strtab_offset_;
+    const uint8_t* end   = start + strtab_used_;
+    const auto* needle = reinterpret_cast<const uint8_t*>(value.c_str());
+    const uint8_t* it = std::search(start, end, needle, needle + value.size() + 1);
+    if (it != end) {
+      return static_cast<uint64_t>(it - start);
+    }
+  }
+
+  // 2. Overwrite the string being replaced if no other reference overlaps
+  //    it. Otherwise, the string is appended (3.)
+  if (refs_known_ && owner < entries_.size() && entries_[owner].value < strtab_size_) {
+    const uint64_t offset = entries_[owner].value;
+    const std::string original = string_at(offset);
+    if (value.size() <= original.size() &&
+        !is_referenced(offset, offset + original.size(), owner))
+    {
+      std::vector<uint8_t> raw(original.size(), 0);
+      std::copy(value.begin(), value.end(), raw.begin());
+      write(strtab_offset_ + offset, raw);
+      return offset;
+    }
+  }
+
+  // 3. Add the string in the slack of .dynstr
+  const uint64_t size = value.size() + 1;
+  if (strtab_used_ + size > strtab_capacity_) {
+    LIEF_DEBUG("'{}' does not fit in .dynstr (slack: {} bytes)", value, dynstr_slack());
+    return make_error_code(lief_errors::data_too_large);
+  }
+
+  const uint64_t offset = strtab_used_;
+  write(strtab_offset_ + offset, {reinterpret_cast<const uint8_t*>(value.c_str()), size});
+  strtab_used_ += size;
+
+  if (strtab_used_ > strtab_size_) {
+    strtab_size_ = strtab_used_;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      if (entries_[i].tag == uint64_t(DynamicEntry::TAG::STRSZ)) {
+        entries_[i].value = strtab_size_;
+        write_entry(i);
+      }
+    }
+    if (strtab_shdr_size_offset_ > 0) {
+      if (is64_) {
+        write_int<uint64_t>(strtab_shdr_size_offset_, strtab_size_);
+      } else {
+        write_int<uint32_t>(strtab_shdr_size_offset_, static_cast<uint32_t>(strtab_size_));
+      }
+    }
+  }
+  return offset;
+}
+
+std::string DynamicPatcher::interpreter() const {
+  if (interp_size_ == 0) {
+    return "";
+  }
+  const auto* start = reinterpret_cast<const char*>(buffer_.data() + interp_offset_);
+  const void* end = memchr(start, 0, interp_size_);
+  return end == nullptr ? std::string(start, interp_size_) :
+                          std::string(start, static_cast<const char*>(end));
+}
+
+ok_error_t DynamicPatcher::interpreter(const std::string& path) {
+  if (interp_size_ == 0) {
+    LIEF_ERR("The binary does not have an interpreter");
+    return make_error_code(lief_errors::not_found);
+  }
+  if (path.size() + 1 > interp_size_) {
+    LIEF_DEBUG("'{}' does not fit in PT_INTERP ({} bytes)", path, interp_size_);
+    return make_error_code(lief_errors::data_too_large);
+  }
+  std::vector<uint8_t> raw(interp_size_, 0);
+  std::copy(path.begin(), path.end(), raw.begin());
+  write(interp_offset_, raw);
+  return ok();
+}
+
+ok_error_t DynamicPatcher::set_string_entry(DynamicEntry::TAG tag, const std::string& value) {
+  auto it = std::find_if(entries_.begin(), entries_.end(),
+    [tag] (const dynamic_entry_t& e) { return e.tag == uint64_t(tag); });
+
+  if (it != entries_.end()) {
+    const size_t idx = std::distance(entries_.begin(), it);
+    auto offset = place_string(value, idx);
+    if (!offset) {
+      return make_error_code(get_error(offset));
+    }
+    entries_[idx].value = *offset;
+    write_entry(idx);
+    return ok();
+  }
+
+  if (spare_slots_ == 0) {
+    LIEF_DEBUG("No spare DT_NULL entry for {}", to_string(tag));
+    return make_error_code(lief_errors::data_too_large);
+  }
+
+  auto offset = place_string(value, entries_.size());
+  if (!offset) {
+    return make_error_code(get_error(offset));
+  }
+  entries_.push_back({uint64_t(tag), *offset});
+  --spare_slots_;
+  write_entry(entries_.size() - 1);
+  return ok();
+}
+
+std::vector<std::string> DynamicPatcher::needed() const {
+  std::vector<std::string> libraries;
+  for (const dynamic_entry_t& entry : entries_) {
+    if (entry.tag == uint64_t(DynamicEntry::TAG::NEEDED)) {
+      libraries.push_back(string_at(entry.value));
+    }
+  }
+  return libraries;
+}
+
+ok_error_t DynamicPatcher::add_needed(const std::string& library) {
+  size_t pos = 0;
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    const dynamic_entry_t& entry = entries_[i];
+    if (entry.tag != uint64_t(DynamicEntry::TAG::NEEDED)) {
+      continue;
+    }
+    if (string_at(entry.value) == library) {
+      return ok();
+    }
+    pos = i + 1;
+  }
+
+  if (spare_slots_ == 0) {
+    LIEF_DEBUG("No spare DT_NULL entry for {}", library);
+    return make_error_code(lief_errors::data_too_large);
+  }
+
+  auto offset = place_string(library, entries_.size());
+  if (!offset) {
+    return make_error_code(get_error(offset));
+  }
+
+  // The loader processes the DT_NEEDED entries in order: the new library
+  // is inserted after the existing ones
+  entries_.insert(entries_.begin() + pos, {uint64_t(DynamicEntry::TAG::NEEDED), *offset});
+  --spare_slots_;
+  for (size_t i = pos; i < entries_.size(); ++i) {
+    write_entry(i);
+  }
+  return ok();
+}
+
+ok_error_t DynamicPatcher::commit() {
+  if (path_.empty() || modifications_.empty()) {
+    return ok();
+  }
+  std::fstream fs(path_, std::ios::in | std::ios::out | std::ios::binary);
+  if (!fs) {
+    LIEF_ERR("Can't open '{}' (read/write)", path_);
+    return make_error_code(lief_errors::file_error);
+  }
+  for (const auto& [offset, size] : modifications_) {
+    fs.seekp(offset);
+    fs.write(reinterpret_cast<const char*>(buffer_.data() + offset), size);
+  }
+  if (!fs.flush()) {
+    return make_error_code(lief_errors::file_error);
+  }
+  modifications_.clear();
+  return ok();
+}
+
+result<bool> DynamicPatcher::apply(const std::string& path, const changes_t& changes) {
+  if (auto patcher = open(path)) {
+    bool in_place = true;
+    if (!changes.interpreter.empty()) {
+      in_place = in_place && patcher->interpreter(changes.interpreter);
+    }
+    if (!changes.soname.empty()) {
+      in_place = in_place && patcher->soname(changes.soname);
+    }
+    if (!changes.runpath.empty()) {
+      in_place = in_place && patcher->runpath(changes.runpath);
+    }
+    if (!changes.rpath.empty()) {
+      in_place = in_place && patcher->rpath(changes.rpath);
+    }
+    for (const std::string& lib : changes.needed) {
+      in_place = in_place && patcher->add_needed(lib);
+    }
+    if (in_place) {
+      if (auto is_ok = patcher->commit(); !is_ok) {
+        return make_error_code(get_error(is_ok));
+      }
+      return true;
+    }
+    // The patcher works on a copy of the file: the partial modifications
+    // are discarded
+    LIEF_DEBUG("The changes don't fit in '{}': rebuilding the binary", path);
+  }
+
+  std::unique_ptr<Binary> bin = Parser::parse(path);
+  if (bin == nullptr) {
+    return make_error_code(lief_errors::parsing_error);
+  }
+
+  if (!changes.interpreter.empty()) {
+    bin->interpreter(changes.interpreter);
+  }
+
+  if (!changes.soname.empty()) {
+    if (auto* entry = bin->get(DynamicEntry::TAG::SONAME)) {
+      static_cast<DynamicSharedObject*>(entry)->name(changes.soname);
+    } else {
+      bin->add(DynamicSharedObject(changes.soname));
+    }
+  }
+
+  if (!changes.runpath.empty()) {
+    if (auto* entry = bin->get(DynamicEntry::TAG::RUNPATH)) {
+      static_cast<DynamicEntryRunPath*>(entry)->runpath(changes.runpath);
+    } else {
+      bin->add(DynamicEntryRunPath(changes.runpath));
+    }
+  }
+
+  if (!changes.rpath.empty()) {
+    if (auto* entry = bin->get(DynamicEntry::TAG::RPATH)) {
+      static_cast<DynamicEntryRpath*>(entry)->rpath(changes.rpath);
+    } else {
+      bin->add(DynamicEntryRpath(changes.rpath));
+    }
+  }
+
+  for (const std::string& lib : changes.needed) {
+    if (!bin->has_library(lib)) {
+      bin->add_library(lib);
+    }
+  }
+
+  bin->write(path);
+  return false;
+}
+
+}
+}
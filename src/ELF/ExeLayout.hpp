@@ -115,14 +115,13 @@ class LIEF_LOCAL ExeLayout : public Layout {
     vector_iostream raw_dynstr;
     raw_dynstr.write<uint8_t>(0);
 
-    std::vector<std::string> opt_list;
+    // The views reference the strings owned by the binary
+    std::vector<std::string_view> opt_list;
+    opt_list.reserve(binary_->dynamic_symbols_.size());
 
-    std::transform(binary_->dynamic_symbols_.begin(),
-                   binary_->dynamic_symbols_.end(),
-                   std::back_inserter(opt_list),
-                   [] (const std::unique_ptr<Symbol>& sym) {
-                     return sym->name();
-                   });
+    for (const std::unique_ptr<Symbol>& sym : binary_->dynamic_symbols_) {
+      opt_list.emplace_back(sym->name());
+    }
 
     for (std::unique_ptr<DynamicEntry>& entry : binary_->dynamic_entries_) {
       switch (entry->tag()) {
@@ -183,12 +182,11 @@ class LIEF_LOCAL ExeLayout : public Layout {
 
     size_t offset_counter = raw_dynstr.tellp();
 
-    std::vector<std::string> string_table_optimized = optimize(opt_list,
-                     [] (const std::string& name) { return name; },
-                     offset_counter, &offset_name_map_);
+    std::vector<std::string_view> string_table_optimized =
+      optimize_strings(std::move(opt_list), offset_counter, &offset_name_map_);
 
-    for (const std::string& name : string_table_optimized) {
-      raw_dynstr.write(name);
+    for (std::string_view name : string_table_optimized) {
+      write_string(raw_dynstr, name);
     }
 
     raw_dynstr.move(raw_dynstr_);
@@ -16,7 +16,9 @@
 #include "LIEF/ELF/Binary.hpp"
 #include "LIEF/ELF/Symbol.hpp"
 #include "LIEF/ELF/Section.hpp"
+#include "ELF/SizingInfo.hpp"
 #include "internal_utils.hpp"
+#include "logging.hpp"
 
 #include <LIEF/iostream.hpp>
 
@@ -42,6 +44,58 @@ bool Layout::is_strtab_shared_shstrtab() const {
   return is_shared;
 }
 
+bool Layout::reuse_strtab() {
+  const Section* symtab = binary_->get(Section::TYPE::SYMTAB);
+  if (symtab == nullptr) {
+    return false;
+  }
+  const size_t strtab_idx = symtab->link();
+  if (strtab_idx == 0 || strtab_idx >= binary_->sections_.size()) {
+    return false;
+  }
+  span<const uint8_t> strtab = binary_->sections_[strtab_idx]->content();
+  if (strtab.empty() || strtab[0] != 0) {
+    return false;
+  }
+
+  // The symbols must be exactly the original ones: if a symbol has been
+  // removed, its name would leak in the new binary, and an added symbol
+  // can't be told apart from its name offset (0).
+  const size_t nb_symbols = binary_->sizing_info_->nb_symtab_symbols;
+  if (binary_->symtab_symbols_.size() != nb_symbols) {
+    return false;
+  }
+
+  std::vector<bool> seen(nb_symbols, false);
+  for (const std::unique_ptr<Symbol>& sym : binary_->symtab_symbols_) {
+    const uint32_t idx = sym->symtab_idx_;
+    if (idx >= nb_symbols || seen[idx]) {
+      return false;
+    }
+    seen[idx] = true;
+  }
+
+  // Check that every name is still located at its original offset
+  for (const std::unique_ptr<Symbol>& sym : binary_->symtab_symbols_) {
+    const std::string& name = sym->name();
+    const uint64_t offset = sym->name_offset_;
+    if (offset + name.size() >= strtab.size() || strtab[offset + name.size()] != 0 ||
+        name.compare(0, name.size(), reinterpret_cast<const char*>(strtab.data() + offset),
+                     name.size()) != 0)
+    {
+      return false;
+    }
+  }
+
+  strtab_name_map_.reserve(binary_->symtab_symbols_.size() + 1);
+  strtab_name_map_[""] = 0;
+  for (const std::unique_ptr<Symbol>& sym : binary_->symtab_symbols_) {
+    strtab_name_map_.emplace(sym->name(), sym->name_offset_);
+  }
+  raw_strtab_ = {strtab.begin(), strtab.end()};
+  return true;
+}
+
 size_t Layout::section_strtab_size() {
   // could be moved in the class base.
   if (!raw_strtab_.empty()) {
@@ -53,21 +107,30 @@ size_t Layout::section_strtab_size() {
     return 0;
   }
 
+  if (binary_->symtab_symbols_.empty()) {
+    return 0;
+  }
+
+  // If the symbols have not been renamed (or added), keep the original
+  // string table as-is instead of re-computing a new layout
+  if (reuse_strtab()) {
+    LIEF_DEBUG("Reuse the original .strtab (0x{:x} bytes)", raw_strtab_.size());
+    return raw_strtab_.size();
+  }
+
   vector_iostream raw_strtab;
   raw_strtab.write<uint8_t>(0);
 
   size_t offset_counter = raw_strtab.tellp();
 
-  if (binary_->symtab_symbols_.empty()) {
-    return 0;
+  std::vector<std::string_view> names;
+  names.reserve(binary_->symtab_symbols_.size());
+  for (const std::unique_ptr<Symbol>& sym : binary_->symtab_symbols_) {
+    names.emplace_back(sym->name());
   }
 
-  std::vector<std::string> symstr_opt = optimize(binary_->symtab_symbols_,
-                      [] (const std::unique_ptr<Symbol>& sym) { return sym->name(); },
-                      offset_counter, &strtab_name_map_);
-
-  for (const std::string& name : symstr_opt) {
-    raw_strtab.write(name);
+  for (std::string_view name : optimize_strings(std::move(names), offset_counter, &strtab_name_map_)) {
+    write_string(raw_strtab, name);
   }
   raw_strtab.move(raw_strtab_);
   return raw_strtab_.size();
@@ -125,11 +188,13 @@ size_t Layout::section_shstr_size() {
   // in this case, include the symtab symbol names
   if (!binary_->symtab_symbols_.empty() && is_strtab_shared_shstrtab()) {
     offset_counter = raw_shstrtab.tellp();
-    std::vector<std::string> symstr_opt = optimize(binary_->symtab_symbols_,
-                       [] (const std::unique_ptr<Symbol>& sym) { return sym->name(); },
-                       offset_counter, &shstr_name_map_);
-    for (const std::string& name : symstr_opt) {
-      raw_shstrtab.write(name);
+    std::vector<std::string_view> names;
+    names.reserve(binary_->symtab_symbols_.size());
+    for (const std::unique_ptr<Symbol>& sym : binary_->symtab_symbols_) {
+      names.emplace_back(sym->name());
+    }
+    for (std::string_view name : optimize_strings(std::move(names), offset_counter, &shstr_name_map_)) {
+      write_string(raw_shstrtab, name);
     }
   }
 
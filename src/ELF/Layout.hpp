@@ -18,8 +18,11 @@
 #include <cstdint>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "LIEF/iostream.hpp"
+
 namespace LIEF {
 namespace ELF {
 class Section;
@@ -62,6 +65,15 @@ class Layout {
   Layout() = delete;
 
   protected:
+  //! Write a null-terminated string (from a string table layout)
+  static void write_string(vector_iostream& os, std::string_view str) {
+    os.write(reinterpret_cast<const uint8_t*>(str.data()), str.size())
+      .write<uint8_t>(0);
+  }
+
+  //! Try to use the original .strtab content (if the names did not change)
+  bool reuse_strtab();
+
   Binary* binary_ = nullptr;
 
   std::unordered_map<std::string, size_t> shstr_name_map_;
@@ -26,7 +26,6 @@ namespace ELF {
 
 template<class ELF_T>
 void CoreFile::read_files() {
-  static constexpr auto MAX_ENTRIES = 6000;
   using Elf_Addr      = typename ELF_T::Elf_Addr;
   using Elf_FileEntry = typename ELF_T::Elf_FileEntry;
 
@@ -40,8 +39,8 @@ void CoreFile::read_files() {
     return;
   }
 
-  if (*count > MAX_ENTRIES) {
-    LIEF_ERR("Too many entries ({} while limited at {})", *count, MAX_ENTRIES);
+  if (*count > NB_MAX_ENTRIES) {
+    LIEF_ERR("Too many entries ({} while limited at {})", *count, NB_MAX_ENTRIES);
     return;
   }
 
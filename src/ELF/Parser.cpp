@@ -29,9 +29,11 @@
 #include "LIEF/ELF/Section.hpp"
 #include "LIEF/ELF/Symbol.hpp"
 #include "LIEF/ELF/Note.hpp"
+#include "LIEF/ELF/NoteDetails/core/CoreFile.hpp"
 #include "LIEF/ELF/SysvHash.hpp"
 
 #include "ELF/DataHandler/Handler.hpp"
+#include "Abstract/BudgetTracker.hpp"
 
 #include "Parser.tcc"
 
@@ -287,6 +289,7 @@ ok_error_t Parser::init() {
   }
 
   binary_->original_size_ = stream_->size();
+  budget_ = std::make_unique<BudgetTracker>(config_.budget, NB_STAGES);
 
   auto res = DataHandler::Handler::from_stream(stream_);
   if (!res) {
@@ -305,9 +308,10 @@ ok_error_t Parser::init() {
 
   binary_->type_ = determine_elf_class(*stream_);
 
+  ok_error_t is_ok = ok();
   switch (binary_->type_) {
-    case Header::CLASS::ELF32: return parse_binary<details::ELF32>();
-    case Header::CLASS::ELF64: return parse_binary<details::ELF64>();
+    case Header::CLASS::ELF32: is_ok = parse_binary<details::ELF32>(); break;
+    case Header::CLASS::ELF64: is_ok = parse_binary<details::ELF64>(); break;
     case Header::CLASS::NONE:
       {
         LIEF_ERR("Can't determine the ELF class ({})",
@@ -316,7 +320,8 @@ ok_error_t Parser::init() {
       }
   }
 
-  return ok();
+  binary_->truncation_ = budget_->reason();
+  return is_ok;
 }
 
 std::unique_ptr<Binary> Parser::parse(const std::string& filename,
@@ -578,6 +583,13 @@ ok_error_t Parser::parse_notes(uint64_t offset, uint64_t size) {
         binary_->header().identity_class()
     );
 
+    if (note != nullptr && CoreFile::classof(note.get())) {
+      // The mapped files are a (potentially) large table: only keep the
+      // entries allowed by the budget. The raw description is left untouched.
+      auto& core = static_cast<CoreFile&>(*note);
+      core.files_.resize(budget_->limit(core.files_.size(), CoreFile::NB_MAX_ENTRIES));
+    }
+
     if (note != nullptr) {
       const auto it_note = std::find_if(
           std::begin(binary_->notes_), std::end(binary_->notes_),
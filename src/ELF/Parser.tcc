@@ -56,6 +56,9 @@ ok_error_t Parser::parse_binary() {
   using Elf_Off  = typename ELF_T::Elf_Off;
 
   LIEF_DEBUG("Start parsing");
+  if (!budget_->stage("header")) {
+    return ok();
+  }
   // Parse header
   // ============
   auto res = parse_header<ELF_T>();
@@ -63,6 +66,9 @@ ok_error_t Parser::parse_binary() {
     LIEF_WARN("ELF Header parsed with errors");
   }
 
+  if (!budget_->stage("sections")) {
+    return ok();
+  }
   // Parse Sections
   // ==============
   if (binary_->header_.section_headers_offset() > 0) {
@@ -71,6 +77,9 @@ ok_error_t Parser::parse_binary() {
     LIEF_WARN("The current binary doesn't have a section header");
   }
 
+  if (!budget_->stage("segments")) {
+    return ok();
+  }
   // Parse segments
   // ==============
   if (binary_->header_.program_headers_offset() > 0) {
@@ -81,6 +90,9 @@ ok_error_t Parser::parse_binary() {
     }
   }
 
+  if (!budget_->stage("dynamic")) {
+    return ok();
+  }
   // Parse Dynamic elements
   // ======================
 
@@ -95,9 +107,12 @@ ok_error_t Parser::parse_binary() {
 
   process_dynamic_table<ELF_T>();
 
+  if (!budget_->stage("symtab")) {
+    return ok();
+  }
   if (const Section* sec_symbtab = binary_->get(Section::TYPE::SYMTAB)) {
     auto nb_entries = static_cast<uint32_t>((sec_symbtab->size() / sizeof(typename ELF_T::Elf_Sym)));
-    nb_entries = std::min(nb_entries, Parser::NB_MAX_SYMBOLS);
+    nb_entries = budget_->limit(nb_entries, Parser::NB_MAX_SYMBOLS);
 
     if (sec_symbtab->link() == 0 || sec_symbtab->link() >= binary_->sections_.size()) {
       LIEF_WARN("section->link() is not valid !");
@@ -113,6 +128,9 @@ ok_error_t Parser::parse_binary() {
   }
 
 
+  if (!budget_->stage("hash")) {
+    return ok();
+  }
   // Parse Symbols's hash
   // ====================
   if (DynamicEntry* dt_hash = binary_->get(DynamicEntry::TAG::HASH)) {
@@ -132,6 +150,9 @@ ok_error_t Parser::parse_binary() {
     }
   }
 
+  if (!budget_->stage("notes")) {
+    return ok();
+  }
   if (config_.parse_notes) {
     // Parse Note segment
     // ==================
@@ -153,6 +174,9 @@ ok_error_t Parser::parse_binary() {
     }
   }
 
+  if (!budget_->stage("relocations")) {
+    return ok();
+  }
   // Try to parse using sections
   // If we don't have any relocations, we parse all relocation sections
   // otherwise, only the non-allocated sections to avoid parsing dynamic
@@ -171,10 +195,16 @@ ok_error_t Parser::parse_binary() {
       }
     }
   }
+  if (!budget_->stage("symbol versions")) {
+    return ok();
+  }
   if (config_.parse_symbol_versions) {
     link_symbol_version();
   }
 
+  if (!budget_->stage("overlay")) {
+    return ok();
+  }
   if (config_.parse_overlay) {
     parse_overlay();
   }
@@ -324,8 +354,8 @@ ok_error_t Parser::process_dynamic_table() {
 
     if (dt_verneed != nullptr && dt_verneed_num != nullptr) {
       const uint64_t virtual_address = dt_verneed->value();
-      const uint32_t nb_entries = std::min(Parser::NB_MAX_SYMBOLS,
-                                           static_cast<uint32_t>(dt_verneed_num->value()));
+      const auto nb_entries = static_cast<uint32_t>(
+          budget_->limit(static_cast<uint32_t>(dt_verneed_num->value()), Parser::NB_MAX_SYMBOLS));
 
       if (auto res = binary_->virtual_address_to_offset(virtual_address)) {
         parse_symbol_version_requirement<ELF_T>(*res, nb_entries);
@@ -774,6 +804,9 @@ ok_error_t Parser::parse_sections() {
   DataHandler::Handler& handler = *binary_->datahandler_;
   const ARCH arch = binary_->header().machine_type();
   for (size_t i = 0; i < numberof_sections; ++i) {
+    if (!budget_->tick(sizeof(Section))) {
+      break;
+    }
     LIEF_DEBUG("  Elf_Shdr#{:02d}.offset: 0x{:x} ", i, stream_->pos());
     const auto shdr = stream_->read_conv<Elf_Shdr>();
     if (!shdr) {
@@ -813,6 +846,10 @@ ok_error_t Parser::parse_sections() {
         read_size = Section::MAX_SECTION_SIZE;
       }
 
+      if (!budget_->tick(read_size)) {
+        break;
+      }
+
       handler.create(section->file_offset(), read_size,
                      DataHandler::Node::SECTION);
 
@@ -878,13 +915,16 @@ ok_error_t Parser::parse_segments() {
   LIEF_DEBUG("== Parse Segments ==");
   const Header& hdr = binary_->header();
   const Elf_Off segment_headers_offset = hdr.program_headers_offset();
-  const auto nbof_segments = std::min<uint32_t>(hdr.numberof_segments(), Parser::NB_MAX_SEGMENTS);
+  const auto nbof_segments = budget_->limit(hdr.numberof_segments(), Parser::NB_MAX_SEGMENTS);
 
   stream_->setpos(segment_headers_offset);
 
   const ARCH arch = binary_->header().machine_type();
 
   for (size_t i = 0; i < nbof_segments; ++i) {
+    if (!budget_->tick(sizeof(Segment))) {
+      break;
+    }
     const auto elf_phdr = stream_->read_conv<Elf_Phdr>();
     if (!elf_phdr) {
       LIEF_ERR("Can't parse segement #{:d}", i);
@@ -908,6 +948,10 @@ ok_error_t Parser::parse_segments() {
         read_size = stream_->size();
       }
 
+      if (!budget_->tick(read_size)) {
+        break;
+      }
+
       segment->datahandler_->create(segment->file_offset(), read_size,
                                     DataHandler::Node::SEGMENT);
       segment->handler_size_ = read_size;
@@ -1011,6 +1055,9 @@ ok_error_t Parser::parse_packed_relocations(uint64_t offset, uint64_t size) {
   LIEF_DEBUG("Nb relocs: {}", nb_relocs);
 
   while (nb_relocs > 0) {
+    if (!budget_->tick()) {
+      break;
+    }
     auto nb_reloc_group_r = rel_stream->read_sleb128();
     if (!nb_reloc_group_r) {
       break;
@@ -1105,6 +1152,9 @@ ok_error_t Parser::parse_relative_relocations(uint64_t offset, uint64_t size) {
   }
 
   while (rel_stream->pos() < (offset + size)) {
+    if (!budget_->tick()) {
+      break;
+    }
     auto opt_relr = rel_stream->read<Elf_Relr>();
     if (!opt_relr) {
       break;
@@ -1147,7 +1197,7 @@ ok_error_t Parser::parse_dynamic_relocations(uint64_t relocations_offset, uint64
 
   auto nb_entries = static_cast<uint32_t>(size / sizeof(REL_T));
 
-  nb_entries = std::min<uint32_t>(nb_entries, Parser::NB_MAX_RELOCATIONS);
+  nb_entries = budget_->limit(nb_entries, Parser::NB_MAX_RELOCATIONS);
   binary_->relocations_.reserve(nb_entries);
 
   stream_->setpos(relocations_offset);
@@ -1157,6 +1207,9 @@ ok_error_t Parser::parse_dynamic_relocations(uint64_t relocations_offset, uint64
                                                      Relocation::ENCODING::RELA;
 
   for (uint32_t i = 0; i < nb_entries; ++i) {
+    if (!budget_->tick(sizeof(Relocation))) {
+      break;
+    }
     const auto raw_reloc = stream_->read_conv<REL_T>();
     if (!raw_reloc) {
       break;
@@ -1184,6 +1237,9 @@ ok_error_t Parser::parse_symtab_symbols(uint64_t offset, uint32_t nb_symbols,
   stream_->setpos(offset);
   const ARCH arch = binary_->header().machine_type();
   for (uint32_t i = 0; i < nb_symbols; ++i) {
+    if (!budget_->tick(sizeof(Symbol))) {
+      break;
+    }
     const auto raw_sym = stream_->read_conv<Elf_Sym>();
     if (!raw_sym) {
       break;
@@ -1196,9 +1252,11 @@ ok_error_t Parser::parse_symtab_symbols(uint64_t offset, uint32_t nb_symbols,
     } else {
       LIEF_ERR("Can't read the symbol's name for symbol #{}", i);
     }
+    symbol->symtab_idx_ = i;
     link_symbol_section(*symbol);
     binary_->symtab_symbols_.push_back(std::move(symbol));
   }
+  binary_->sizing_info_->nb_symtab_symbols = binary_->symtab_symbols_.size();
   return ok();
 }
 
@@ -1235,6 +1293,9 @@ ok_error_t Parser::parse_dynamic_symbols(uint64_t offset) {
   stream_->setpos(dynamic_symbols_offset);
 
   for (size_t i = 0; i < nb_symbols; ++i) {
+    if (!budget_->tick(sizeof(Symbol))) {
+      break;
+    }
     const auto symbol_header = stream_->read_conv<Elf_Sym>();
     if (!symbol_header) {
       LIEF_DEBUG("Break on symbol #{:d}", i);
@@ -1285,6 +1346,9 @@ ok_error_t Parser::parse_dynamic_entries(uint64_t offset, uint64_t size) {
   bool end_of_dynamic = false;
   stream_->setpos(offset);
   for (size_t dynIdx = 0; dynIdx < nb_entries; ++dynIdx) {
+    if (!budget_->tick(sizeof(DynamicEntry))) {
+      break;
+    }
     const auto res_entry = stream_->read_conv<Elf_Dyn>();
     if (!res_entry) {
       break;
@@ -1491,7 +1555,7 @@ ok_error_t Parser::parse_pltgot_relocations(uint64_t offset, uint64_t size) {
 
   auto nb_entries = static_cast<uint32_t>(size / sizeof(REL_T));
 
-  nb_entries = std::min<uint32_t>(nb_entries, Parser::NB_MAX_RELOCATIONS);
+  nb_entries = budget_->limit(nb_entries, Parser::NB_MAX_RELOCATIONS);
 
   const ARCH arch = binary_->header_.machine_type();
   const Relocation::ENCODING enc =
@@ -1499,6 +1563,9 @@ ok_error_t Parser::parse_pltgot_relocations(uint64_t offset, uint64_t size) {
                                                      Relocation::ENCODING::RELA;
   stream_->setpos(offset_relocations);
   for (uint32_t i = 0; i < nb_entries; ++i) {
+    if (!budget_->tick(sizeof(Relocation))) {
+      break;
+    }
     const auto rel_hdr = stream_->read_conv<REL_T>();
     if (!rel_hdr) {
       break;
@@ -1581,11 +1648,14 @@ ok_error_t Parser::parse_section_relocations(const Section& section) {
                                                      Relocation::ENCODING::RELA;
 
   auto nb_entries = static_cast<uint32_t>(section.size() / sizeof(REL_T));
-  nb_entries = std::min<uint32_t>(nb_entries, Parser::NB_MAX_RELOCATIONS);
+  nb_entries = budget_->limit(nb_entries, Parser::NB_MAX_RELOCATIONS);
 
   std::unordered_set<Relocation*, RelocationSetHash, RelocationSetEq> reloc_hash;
   stream_->setpos(offset_relocations);
   for (uint32_t i = 0; i < nb_entries; ++i) {
+    if (!budget_->tick(sizeof(Relocation))) {
+      break;
+    }
     const auto rel_hdr = stream_->read_conv<REL_T>();
     if (!rel_hdr) {
       break;
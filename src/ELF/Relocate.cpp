@@ -0,0 +1,825 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <set>
+#include <unordered_map>
+
+#include "logging.hpp"
+
+#include "LIEF/ELF/Binary.hpp"
+#include "LIEF/ELF/EnumToString.hpp"
+#include "LIEF/ELF/Relocation.hpp"
+#include "LIEF/ELF/Section.hpp"
+#include "LIEF/ELF/Symbol.hpp"
+
+namespace LIEF {
+namespace ELF {
+
+namespace {
+using TYPE = Relocation::TYPE;
+
+// Relocations targeting a section, stored in a columnar way so that the
+// appliers iterate over contiguous arrays
+struct reloc_columns_t {
+  std::vector<uint64_t> offset; // r_offset (relative to the section)
+  std::vector<uint64_t> S;      // Value of the symbol
+  std::vector<int64_t>  A;      // Explicit addend (RELA)
+  std::vector<TYPE>     type;
+  std::vector<uint8_t>  is_rel; // The addend is stored in the section
+
+  size_t size() const {
+    return offset.size();
+  }
+};
+
+// Location (P) of a relocation
+struct location_t {
+  uint8_t* ptr = nullptr;
+  size_t avail = 0;
+  uint64_t P = 0;
+};
+
+template<class T>
+T read_le(const uint8_t* p) {
+  using U = typename std::make_unsigned<T>::type;
+  U value = 0;
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    value |= U(p[i]) << (8 * i);
+  }
+  return static_cast<T>(value);
+}
+
+template<class T>
+void write_le(uint8_t* p, T value) {
+  using U = typename std::make_unsigned<T>::type;
+  const auto uvalue = static_cast<U>(value);
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    p[i] = static_cast<uint8_t>(uvalue >> (8 * i));
+  }
+}
+
+inline int64_t sign_extend(uint64_t value, uint32_t bits) {
+  const uint64_t mask = uint64_t(1) << (bits - 1);
+  value &= (bits == 64) ? ~uint64_t(0) : ((uint64_t(1) << bits) - 1);
+  return static_cast<int64_t>((value ^ mask) - mask);
+}
+
+inline bool is_int(int64_t value, uint32_t bits) {
+  const int64_t min = -(int64_t(1) << (bits - 1));
+  const int64_t max = (int64_t(1) << (bits - 1)) - 1;
+  return min <= value && value <= max;
+}
+
+inline bool is_uint(uint64_t value, uint32_t bits) {
+  return bits >= 64 || (value >> bits) == 0;
+}
+
+// Write the value V (truncated) on sizeof(T) bytes
+template<class T>
+ok_error_t write_value(const location_t& loc, uint64_t V) {
+  if (loc.avail < sizeof(T)) {
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  write_le<T>(loc.ptr, static_cast<T>(V));
+  return ok();
+}
+
+template<class T>
+result<int64_t> implicit_addend(const location_t& loc) {
+  if (loc.avail < sizeof(T)) {
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  return sign_extend(read_le<T>(loc.ptr), sizeof(T) * 8);
+}
+
+// ============================================================================
+// Appliers: one specialization per architecture so that the switch on the
+// relocation type is resolved within a tight, arch-specific loop
+// ============================================================================
+template<ARCH A>
+struct Applier;
+
+template<>
+struct Applier<ARCH::X86_64> {
+  void prepare(const reloc_columns_t&, uint64_t) {}
+
+  ok_error_t apply(TYPE type, const location_t& loc, uint64_t S, int64_t A) {
+    const uint64_t P = loc.P;
+    switch (type) {
+      case TYPE::X86_64_NONE:
+        return ok();
+      case TYPE::X86_64_64:
+        return write_value<uint64_t>(loc, S + A);
+      case TYPE::X86_64_PC64:
+        return write_value<uint64_t>(loc, S + A - P);
+      case TYPE::X86_64_32:
+        if (!is_uint(S + A, 32)) {
+          return make_error_code(lief_errors::data_too_large);
+        }
+        return write_value<uint32_t>(loc, S + A);
+      case TYPE::X86_64_32S:
+        if (!is_int(static_cast<int64_t>(S + A), 32)) {
+          return make_error_code(lief_errors::data_too_large);
+        }
+        return write_value<uint32_t>(loc, S + A);
+      case TYPE::X86_64_PC32:
+      case TYPE::X86_64_PLT32:
+        if (!is_int(static_cast<int64_t>(S + A - P), 32)) {
+          return make_error_code(lief_errors::data_too_large);
+        }
+        return write_value<uint32_t>(loc, S + A - P);
+      case TYPE::X86_64_16:
+        return write_value<uint16_t>(loc, S + A);
+      case TYPE::X86_64_PC16:
+        return write_value<uint16_t>(loc, S + A - P);
+      case TYPE::X86_64_8:
+        return write_value<uint8_t>(loc, S + A);
+      case TYPE::X86_64_PC8:
+        return write_value<uint8_t>(loc, S + A - P);
+      default:
+        return make_error_code(lief_errors::not_supported);
+    }
+  }
+
+  result<int64_t> addend(TYPE type, const location_t& loc) {
+    switch (type) {
+      case TYPE::X86_64_64:
+      case TYPE::X86_64_PC64:
+        return implicit_addend<uint64_t>(loc);
+      case TYPE::X86_64_16:
+      case TYPE::X86_64_PC16:
+        return implicit_addend<uint16_t>(loc);
+      case TYPE::X86_64_8:
+      case TYPE::X86_64_PC8:
+        return implicit_addend<uint8_t>(loc);
+      default:
+        return implicit_addend<uint32_t>(loc);
+    }
+  }
+};
+
+template<>
+struct Applier<ARCH::I386> {
+  void prepare(const reloc_columns_t&, uint64_t) {}
+
+  ok_error_t apply(TYPE type, const location_t& loc, uint64_t S, int64_t A) {
+    const uint64_t P = loc.P;
+    switch (type) {
+      case TYPE::X86_NONE:
+        return ok();
+      case TYPE::X86_32:
+        return write_value<uint32_t>(loc, S + A);
+      case TYPE::X86_PC32:
+      case TYPE::X86_PLT32:
+        {
+          // The 32-bit address space wraps around: the value must fit in
+          // 32 bits, either signed or unsigned
+          const uint64_t V = S + A - P;
+          if (!is_int(static_cast<int64_t>(V), 32) && !is_uint(V, 32)) {
+            return make_error_code(lief_errors::data_too_large);
+          }
+          return write_value<uint32_t>(loc, V);
+        }
+      case TYPE::X86_16:
+        return write_value<uint16_t>(loc, S + A);
+      case TYPE::X86_PC16:
+        return write_value<uint16_t>(loc, S + A - P);
+      case TYPE::X86_8:
+        return write_value<uint8_t>(loc, S + A);
+      case TYPE::X86_PC8:
+        return write_value<uint8_t>(loc, S + A - P);
+      default:
+        return make_error_code(lief_errors::not_supported);
+    }
+  }
+
+  result<int64_t> addend(TYPE type, const location_t& loc) {
+    switch (type) {
+      case TYPE::X86_16:
+      case TYPE::X86_PC16:
+        return implicit_addend<uint16_t>(loc);
+      case TYPE::X86_8:
+      case TYPE::X86_PC8:
+        return implicit_addend<uint8_t>(loc);
+      default:
+        return implicit_addend<uint32_t>(loc);
+    }
+  }
+};
+
+template<>
+struct Applier<ARCH::AARCH64> {
+  void prepare(const reloc_columns_t&, uint64_t) {}
+
+  static uint64_t page(uint64_t x) {
+    return x & ~uint64_t(0xfff);
+  }
+
+  static ok_error_t patch_insn(const location_t& loc, uint32_t mask, uint32_t bits) {
+    if (loc.avail < sizeof(uint32_t)) {
+      return make_error_code(lief_errors::read_out_of_bound);
+    }
+    const uint32_t insn = read_le<uint32_t>(loc.ptr);
+    write_le<uint32_t>(loc.ptr, (insn & ~mask) | (bits & mask));
+    return ok();
+  }
+
+  static ok_error_t patch_imm12(const location_t& loc, uint64_t V, uint32_t shift) {
+    return patch_insn(loc, 0x003ffc00, uint32_t(((V & 0xfff) >> shift) << 10));
+  }
+
+  static ok_error_t patch_movw(const location_t& loc, uint64_t V, uint32_t shift) {
+    return patch_insn(loc, 0x001fffe0, uint32_t(((V >> shift) & 0xffff) << 5));
+  }
+
+  // Overflow check of the data relocations: -2^(bits-1) <= V < 2^bits
+  static bool fits(uint64_t V, uint32_t bits) {
+    return is_int(static_cast<int64_t>(V), bits) || is_uint(V, bits);
+  }
+
+  ok_error_t apply(TYPE type, const location_t& loc, uint64_t S, int64_t A) {
+    const uint64_t P = loc.P;
+    switch (type) {
+      case TYPE::AARCH64_NONE:
+        return ok();
+      case TYPE::AARCH64_ABS64:
+        return write_value<uint64_t>(loc, S + A);
+      case TYPE::AARCH64_ABS32:
+        if (!fits(S + A, 32)) {
+          return make_error_code(lief_errors::data_too_large);
+        }
+        return write_value<uint32_t>(loc, S + A);
+      case TYPE::AARCH64_ABS16:
+        if (!fits(S + A, 16)) {
+          return make_error_code(lief_errors::data_too_large);
+        }
+        return write_value<uint16_t>(loc, S + A);
+      case TYPE::AARCH64_PREL64:
+        return write_value<uint64_t>(loc, S + A - P);
+      case TYPE::AARCH64_PREL32:
+        if (!fits(S + A - P, 32)) {
+          return make_error_code(lief_errors::data_too_large);
+        }
+        return write_value<uint32_t>(loc, S + A - P);
+      case TYPE::AARCH64_PREL16:
+        if (!fits(S + A - P, 16)) {
+          return make_error_code(lief_errors::data_too_large);
+        }
+        return write_value<uint16_t>(loc, S + A - P);
+
+      case TYPE::AARCH64_CALL26:
+      case TYPE::AARCH64_JUMP26:
+        {
+          const auto V = static_cast<int64_t>(S + A - P);
+          if (!is_int(V, 28)) {
+            return make_error_code(lief_errors::data_too_large);
+          }
+          return patch_insn(loc, 0x03ffffff, uint32_t(V >> 2));
+        }
+
+      case TYPE::AARCH64_CONDBR19:
+      case TYPE::AARCH64_LD_PREL_LO19:
+        {
+          const auto V = static_cast<int64_t>(S + A - P);
+          if (!is_int(V, 21)) {
+            return make_error_code(lief_errors::data_too_large);
+          }
+          return patch_insn(loc, 0x00ffffe0, uint32_t(((V >> 2) & 0x7ffff) << 5));
+        }
+
+      case TYPE::AARCH64_TSTBR14:
+        {
+          const auto V = static_cast<int64_t>(S + A - P);
+          if (!is_int(V, 16)) {
+            return make_error_code(lief_errors::data_too_large);
+          }
+          return patch_insn(loc, 0x0007ffe0, uint32_t(((V >> 2) & 0x3fff) << 5));
+        }
+
+      case TYPE::AARCH64_ADR_PREL_LO21:
+      case TYPE::AARCH64_ADR_PREL_PG_HI21:
+      case TYPE::AARCH64_ADR_PREL_PG_HI21_NC:
+        {
+          int64_t V = 0;
+          if (type == TYPE::AARCH64_ADR_PREL_LO21) {
+            V = static_cast<int64_t>(S + A - P);
+            if (!is_int(V, 21)) {
+              return make_error_code(lief_errors::data_too_large);
+            }
+          } else {
+            V = static_cast<int64_t>(page(S + A) - page(P)) >> 12;
+            if (type == TYPE::AARCH64_ADR_PREL_PG_HI21 && !is_int(V, 21)) {
+              return make_error_code(lief_errors::data_too_large);
+            }
+          }
+          const auto imm = static_cast<uint32_t>(V);
+          return patch_insn(loc, 0x60ffffe0,
+                            ((imm & 0x3) << 29) | (((imm >> 2) & 0x7ffff) << 5));
+        }
+
+      case TYPE::AARCH64_ADD_ABS_LO12_NC:
+      case TYPE::AARCH64_LDST8_ABS_LO12_NC:
+        return patch_imm12(loc, S + A, 0);
+      case TYPE::AARCH64_LDST16_ABS_LO12_NC:
+        return patch_imm12(loc, S + A, 1);
+      case TYPE::AARCH64_LDST32_ABS_LO12_NC:
+        return patch_imm12(loc, S + A, 2);
+      case TYPE::AARCH64_LDST64_ABS_LO12_NC:
+        return patch_imm12(loc, S + A, 3);
+      case TYPE::AARCH64_LDST128_ABS_LO12_NC:
+        return patch_imm12(loc, S + A, 4);
+
+      case TYPE::AARCH64_MOVW_UABS_G0:
+      case TYPE::AARCH64_MOVW_UABS_G1:
+      case TYPE::AARCH64_MOVW_UABS_G2:
+        {
+          // The checked variants must hold the whole value
+          const uint32_t shift = type == TYPE::AARCH64_MOVW_UABS_G0 ? 0 :
+                                 type == TYPE::AARCH64_MOVW_UABS_G1 ? 16 : 32;
+          if (!is_uint(S + A, shift + 16)) {
+            return make_error_code(lief_errors::data_too_large);
+          }
+          return patch_movw(loc, S + A, shift);
+        }
+      case TYPE::AARCH64_MOVW_UABS_G0_NC:
+        return patch_movw(loc, S + A, 0);
+      case TYPE::AARCH64_MOVW_UABS_G1_NC:
+        return patch_movw(loc, S + A, 16);
+      case TYPE::AARCH64_MOVW_UABS_G2_NC:
+        return patch_movw(loc, S + A, 32);
+      case TYPE::AARCH64_MOVW_UABS_G3:
+        return patch_movw(loc, S + A, 48);
+
+      default:
+        return make_error_code(lief_errors::not_supported);
+    }
+  }
+
+  result<int64_t> addend(TYPE type, const location_t& loc) {
+    switch (type) {
+      case TYPE::AARCH64_ABS64:
+      case TYPE::AARCH64_PREL64:
+        return implicit_addend<uint64_t>(loc);
+      case TYPE::AARCH64_ABS32:
+      case TYPE::AARCH64_PREL32:
+        return implicit_addend<uint32_t>(loc);
+      case TYPE::AARCH64_ABS16:
+      case TYPE::AARCH64_PREL16:
+        return implicit_addend<uint16_t>(loc);
+      default:
+        // AArch64 objects use RELA relocations for the instructions
+        return 0;
+    }
+  }
+};
+
+template<>
+struct Applier<ARCH::ARM> {
+  void prepare(const reloc_columns_t&, uint64_t) {}
+
+  ok_error_t apply(TYPE type, const location_t& loc, uint64_t S, int64_t A) {
+    const uint64_t P = loc.P;
+    if (loc.avail < sizeof(uint32_t) && type != TYPE::ARM_NONE) {
+      return make_error_code(lief_errors::read_out_of_bound);
+    }
+    switch (type) {
+      case TYPE::ARM_NONE:
+      case TYPE::ARM_V4BX:
+        return ok();
+      case TYPE::ARM_ABS32:
+        return write_value<uint32_t>(loc, S + A);
+      case TYPE::ARM_REL32:
+        return write_value<uint32_t>(loc, S + A - P);
+      case TYPE::ARM_PREL31:
+        {
+          const uint32_t insn = read_le<uint32_t>(loc.ptr);
+          const uint64_t V = S + A - P;
+          write_le<uint32_t>(loc.ptr, (insn & 0x80000000) | (V & 0x7fffffff));
+          return ok();
+        }
+
+      case TYPE::ARM_PC24:
+      case TYPE::ARM_CALL:
+      case TYPE::ARM_JUMP24:
+        {
+          uint32_t insn = read_le<uint32_t>(loc.ptr);
+          const auto V = static_cast<int64_t>(S + A - P);
+          if (!is_int(V, 26)) {
+            return make_error_code(lief_errors::data_too_large);
+          }
+          if (type == TYPE::ARM_CALL && (S & 1) != 0) {
+            // BL to a Thumb function: switch to BLX (H bit = bit 1 of the offset)
+            insn = 0xfa000000 | (((V >> 1) & 1) << 24);
+          }
+          write_le<uint32_t>(loc.ptr, (insn & 0xff000000) | ((V >> 2) & 0x00ffffff));
+          return ok();
+        }
+
+      case TYPE::ARM_MOVW_ABS_NC:
+      case TYPE::ARM_MOVT_ABS:
+        {
+          const uint32_t insn = read_le<uint32_t>(loc.ptr);
+          uint64_t V = S + A;
+          if (type == TYPE::ARM_MOVT_ABS) {
+            V >>= 16;
+          }
+          write_le<uint32_t>(loc.ptr, (insn & 0xfff0f000) | ((V & 0xf000) << 4) | (V & 0x0fff));
+          return ok();
+        }
+
+      case TYPE::ARM_THM_CALL:
+      case TYPE::ARM_THM_JUMP24:
+        {
+          uint16_t upper = read_le<uint16_t>(loc.ptr);
+          uint16_t lower = read_le<uint16_t>(loc.ptr + 2);
+          int64_t V = 0;
+          if (type == TYPE::ARM_THM_CALL && (S & 1) == 0) {
+            // BL to an ARM function: switch to BLX
+            lower &= ~0x1000;
+            V = static_cast<int64_t>(S + A - (P & ~uint64_t(3)));
+          } else {
+            if (type == TYPE::ARM_THM_CALL) {
+              lower |= 0x1000;
+            }
+            V = static_cast<int64_t>(S + A - P);
+          }
+          if (!is_int(V, 25)) {
+            return make_error_code(lief_errors::data_too_large);
+          }
+          const uint32_t sign = (V >> 24) & 1;
+          const uint32_t j1 = ((~(V >> 23)) & 1) ^ sign;
+          const uint32_t j2 = ((~(V >> 22)) & 1) ^ sign;
+          upper = (upper & 0xf800) | (sign << 10) | ((V >> 12) & 0x3ff);
+          lower = (lower & 0xd000) | (j1 << 13) | (j2 << 11) | ((V >> 1) & 0x7ff);
+          write_le<uint16_t>(loc.ptr, upper);
+          write_le<uint16_t>(loc.ptr + 2, lower);
+          return ok();
+        }
+      default:
+        return make_error_code(lief_errors::not_supported);
+    }
+  }
+
+  result<int64_t> addend(TYPE type, const location_t& loc) {
+    if (loc.avail < sizeof(uint32_t)) {
+      return make_error_code(lief_errors::read_out_of_bound);
+    }
+    const uint32_t insn = read_le<uint32_t>(loc.ptr);
+    switch (type) {
+      case TYPE::ARM_PREL31:
+        return sign_extend(insn, 31);
+      case TYPE::ARM_PC24:
+      case TYPE::ARM_CALL:
+      case TYPE::ARM_JUMP24:
+        return sign_extend(uint64_t(insn & 0x00ffffff) << 2, 26);
+      case TYPE::ARM_MOVW_ABS_NC:
+      case TYPE::ARM_MOVT_ABS:
+        return sign_extend(((insn >> 4) & 0xf000) | (insn & 0x0fff), 16);
+      case TYPE::ARM_THM_CALL:
+      case TYPE::ARM_THM_JUMP24:
+        {
+          const uint16_t upper = read_le<uint16_t>(loc.ptr);
+          const uint16_t lower = read_le<uint16_t>(loc.ptr + 2);
+          const uint32_t sign = (upper >> 10) & 1;
+          const uint32_t i1 = (~((lower >> 13) ^ sign)) & 1;
+          const uint32_t i2 = (~((lower >> 11) ^ sign)) & 1;
+          const uint32_t imm = (sign << 24) | (i1 << 23) | (i2 << 22) |
+                               ((upper & 0x3ff) << 12) | ((lower & 0x7ff) << 1);
+          return sign_extend(imm, 25);
+        }
+      default:
+        return sign_extend(insn, 32);
+    }
+  }
+};
+
+template<>
+struct Applier<ARCH::RISCV> {
+  // R_RISCV_PCREL_LO12_* relocations reference (through their symbol)
+  // the location of the associated R_RISCV_PCREL_HI20
+  std::unordered_map<uint64_t, uint64_t> pcrel_hi20_;
+
+  void prepare(const reloc_columns_t& columns, uint64_t base) {
+    for (size_t i = 0; i < columns.size(); ++i) {
+      if (columns.type[i] == TYPE::RISCV_PCREL_HI20) {
+        const uint64_t P = base + columns.offset[i];
+        pcrel_hi20_[P] = columns.S[i] + columns.A[i] - P;
+      }
+    }
+  }
+
+  static ok_error_t patch_insn(const location_t& loc, uint32_t mask, uint32_t bits) {
+    if (loc.avail < sizeof(uint32_t)) {
+      return make_error_code(lief_errors::read_out_of_bound);
+    }
+    const uint32_t insn = read_le<uint32_t>(loc.ptr);
+    write_le<uint32_t>(loc.ptr, (insn & ~mask) | (bits & mask));
+    return ok();
+  }
+
+  static ok_error_t patch_insn16(const location_t& loc, uint16_t mask, uint16_t bits) {
+    if (loc.avail < sizeof(uint16_t)) {
+      return make_error_code(lief_errors::read_out_of_bound);
+    }
+    const uint16_t insn = read_le<uint16_t>(loc.ptr);
+    write_le<uint16_t>(loc.ptr, (insn & ~mask) | (bits & mask));
+    return ok();
+  }
+
+  static uint32_t hi20(uint64_t V) {
+    return uint32_t(V + 0x800) & 0xfffff000;
+  }
+
+  static ok_error_t patch_itype(const location_t& loc, uint64_t V) {
+    return patch_insn(loc, 0xfff00000, uint32_t(V & 0xfff) << 20);
+  }
+
+  static ok_error_t patch_stype(const location_t& loc, uint64_t V) {
+    const auto lo = uint32_t(V & 0xfff);
+    return patch_insn(loc, 0xfe000f80, ((lo >> 5) << 25) | ((lo & 0x1f) << 7));
+  }
+
+  template<class T>
+  static ok_error_t add_value(const location_t& loc, uint64_t V) {
+    if (loc.avail < sizeof(T)) {
+      return make_error_code(lief_errors::read_out_of_bound);
+    }
+    write_le<T>(loc.ptr, static_cast<T>(read_le<T>(loc.ptr) + V));
+    return ok();
+  }
+
+  ok_error_t apply(TYPE type, const location_t& loc, uint64_t S, int64_t A) {
+    const uint64_t P = loc.P;
+    switch (type) {
+      case TYPE::RISCV_NONE:
+      case TYPE::RISCV_RELAX:
+      case TYPE::RISCV_ALIGN: // No relaxation: the padding is already correct
+        return ok();
+      case TYPE::RISCV_32:
+        return write_value<uint32_t>(loc, S + A);
+      case TYPE::RISCV_64:
+        return write_value<uint64_t>(loc, S + A);
+      case TYPE::RISCV_32_PCREL:
+      case TYPE::RISCV_PLT32:
+        return write_value<uint32_t>(loc, S + A - P);
+
+      case TYPE::RISCV_BRANCH:
+        {
+          const uint64_t V = S + A - P;
+          return patch_insn(loc, 0xfe000f80,
+                            uint32_t(((V >> 12) & 1) << 31) | uint32_t(((V >> 5) & 0x3f) << 25) |
+                            uint32_t(((V >> 1) & 0xf) << 8) | uint32_t(((V >> 11) & 1) << 7));
+        }
+
+      case TYPE::RISCV_JAL:
+        {
+          const uint64_t V = S + A - P;
+          return patch_insn(loc, 0xfffff000,
+                            uint32_t(((V >> 20) & 1) << 31) | uint32_t(((V >> 1) & 0x3ff) << 21) |
+                            uint32_t(((V >> 11) & 1) << 20) | uint32_t(((V >> 12) & 0xff) << 12));
+        }
+
+      case TYPE::RISCV_CALL:
+      case TYPE::RISCV_CALL_PLT:
+        {
+          // auipc + jalr
+          if (loc.avail < 2 * sizeof(uint32_t)) {
+            return make_error_code(lief_errors::read_out_of_bound);
+          }
+          const uint64_t V = S + A - P;
+          patch_insn(loc, 0xfffff000, hi20(V));
+          const location_t jalr{loc.ptr + 4, loc.avail - 4, P + 4};
+          return patch_itype(jalr, V);
+        }
+
+      case TYPE::RISCV_PCREL_HI20:
+        return patch_insn(loc, 0xfffff000, hi20(S + A - P));
+
+      case TYPE::RISCV_PCREL_LO12_I:
+      case TYPE::RISCV_PCREL_LO12_S:
+        {
+          auto it = pcrel_hi20_.find(S);
+          if (it == pcrel_hi20_.end()) {
+            return make_error_code(lief_errors::not_found);
+          }
+          return type == TYPE::RISCV_PCREL_LO12_I ? patch_itype(loc, it->second) :
+                                                    patch_stype(loc, it->second);
+        }
+
+      case TYPE::RISCV_HI20:
+        return patch_insn(loc, 0xfffff000, hi20(S + A));
+      case TYPE::RISCV_LO12_I:
+        return patch_itype(loc, S + A);
+      case TYPE::RISCV_LO12_S:
+        return patch_stype(loc, S + A);
+
+      case TYPE::RISCV_ADD8:
+        return add_value<uint8_t>(loc, S + A);
+      case TYPE::RISCV_ADD16:
+        return add_value<uint16_t>(loc, S + A);
+      case TYPE::RISCV_ADD32:
+        return add_value<uint32_t>(loc, S + A);
+      case TYPE::RISCV_ADD64:
+        return add_value<uint64_t>(loc, S + A);
+      case TYPE::RISCV_SUB8:
+        return add_value<uint8_t>(loc, -(S + A));
+      case TYPE::RISCV_SUB16:
+        return add_value<uint16_t>(loc, -(S + A));
+      case TYPE::RISCV_SUB32:
+        return add_value<uint32_t>(loc, -(S + A));
+      case TYPE::RISCV_SUB64:
+        return add_value<uint64_t>(loc, -(S + A));
+
+      case TYPE::RISCV_SET6:
+      case TYPE::RISCV_SUB6:
+        {
+          if (loc.avail < 1) {
+            return make_error_code(lief_errors::read_out_of_bound);
+          }
+          const uint8_t current = loc.ptr[0];
+          const uint64_t V = type == TYPE::RISCV_SET6 ? S + A : current - (S + A);
+          loc.ptr[0] = (current & 0xc0) | (V & 0x3f);
+          return ok();
+        }
+      case TYPE::RISCV_SET8:
+        return write_value<uint8_t>(loc, S + A);
+      case TYPE::RISCV_SET16:
+        return write_value<uint16_t>(loc, S + A);
+      case TYPE::RISCV_SET32:
+        return write_value<uint32_t>(loc, S + A);
+
+      case TYPE::RISCV_RVC_BRANCH:
+        {
+          const uint64_t V = S + A - P;
+          return patch_insn16(loc, 0x1c7c,
+                              uint16_t(((V >> 8) & 1) << 12) | uint16_t(((V >> 3) & 3) << 10) |
+                              uint16_t(((V >> 6) & 3) << 5)  | uint16_t(((V >> 1) & 3) << 3) |
+                              uint16_t(((V >> 5) & 1) << 2));
+        }
+
+      case TYPE::RISCV_RVC_JUMP:
+        {
+          const uint64_t V = S + A - P;
+          return patch_insn16(loc, 0x1ffc,
+                              uint16_t(((V >> 11) & 1) << 12) | uint16_t(((V >> 4) & 1) << 11) |
+                              uint16_t(((V >> 8) & 3) << 9)   | uint16_t(((V >> 10) & 1) << 8) |
+                              uint16_t(((V >> 6) & 1) << 7)   | uint16_t(((V >> 7) & 1) << 6) |
+                              uint16_t(((V >> 1) & 7) << 3)   | uint16_t(((V >> 5) & 1) << 2));
+        }
+
+      default:
+        return make_error_code(lief_errors::not_supported);
+    }
+  }
+
+  result<int64_t> addend(TYPE, const location_t&) {
+    // RISC-V only uses RELA relocations
+    return 0;
+  }
+};
+
+template<ARCH arch>
+size_t apply_relocations(span<uint8_t> content, uint64_t base,
+                         const reloc_columns_t& columns)
+{
+  Applier<arch> applier;
+  applier.prepare(columns, base);
+
+  size_t nb_applied = 0;
+  std::set<TYPE> unsupported;
+  const size_t nb_relocs = columns.size();
+  for (size_t i = 0; i < nb_relocs; ++i) {
+    const uint64_t offset = columns.offset[i];
+    if (offset >= content.size()) {
+      LIEF_DEBUG("Relocation offset 0x{:x} is out of the section", offset);
+      continue;
+    }
+    const TYPE type = columns.type[i];
+    const location_t loc{content.data() + offset, content.size() - offset, base + offset};
+
+    int64_t A = columns.A[i];
+    if (columns.is_rel[i] != 0) {
+      auto res = applier.addend(type, loc);
+      if (!res) {
+        continue;
+      }
+      A = *res;
+    }
+
+    auto is_ok = applier.apply(type, loc, columns.S[i], A);
+    if (is_ok) {
+      ++nb_applied;
+      continue;
+    }
+
+    if (is_ok.error() == lief_errors::not_supported) {
+      if (unsupported.insert(type).second) {
+        LIEF_WARN("Relocation {} is not supported", to_string(type));
+      }
+    } else if (is_ok.error() == lief_errors::data_too_large) {
+      LIEF_WARN("Can't apply {} at 0x{:x}: the value overflows the field",
+                to_string(type), base + offset);
+    } else {
+      LIEF_DEBUG("Can't apply {} at 0x{:x}: {}", to_string(type), base + offset,
+                 to_string(is_ok.error()));
+    }
+  }
+  return nb_applied;
+}
+}
+
+result<size_t> Binary::relocate(const sections_layout_t& layout,
+                                const symbol_resolver_t& resolver)
+{
+  const ARCH arch = header().machine_type();
+  if (arch != ARCH::X86_64 && arch != ARCH::I386 && arch != ARCH::AARCH64 &&
+      arch != ARCH::ARM && arch != ARCH::RISCV)
+  {
+    LIEF_ERR("Relocations for {} are not supported", to_string(arch));
+    return make_error_code(lief_errors::not_supported);
+  }
+
+  if (header().identity_data() != Header::ELF_DATA::LSB) {
+    LIEF_ERR("Only little-endian binaries are supported");
+    return make_error_code(lief_errors::not_supported);
+  }
+
+  // Resolve the value (S) of the symbols once
+  std::unordered_map<const Symbol*, result<uint64_t>> symbols_value;
+  auto symbol_value = [&] (const Symbol* sym) -> result<uint64_t> {
+    if (sym == nullptr) {
+      return 0;
+    }
+    if (auto it = symbols_value.find(sym); it != symbols_value.end()) {
+      return it->second;
+    }
+    result<uint64_t> value = make_error_code(lief_errors::not_found);
+    if (sym->shndx() == Symbol::SECTION_INDEX::ABS) {
+      value = sym->value();
+    } else if (const Section* section = sym->section()) {
+      if (auto it = layout.find(section); it != layout.end()) {
+        value = it->second + sym->value();
+      }
+    } else if (sym->shndx() == Symbol::SECTION_INDEX::UNDEF && resolver) {
+      value = resolver(*sym);
+    }
+    symbols_value.emplace(sym, value);
+    return value;
+  };
+
+  // Build the columns for each section that is present in the layout
+  std::unordered_map<Section*, reloc_columns_t> columns;
+  for (Relocation& reloc : object_relocations()) {
+    Section* section = reloc.section();
+    if (section == nullptr || layout.count(section) == 0) {
+      continue;
+    }
+    auto S = symbol_value(reloc.symbol());
+    if (!S) {
+      LIEF_DEBUG("Can't resolve symbol '{}'", reloc.symbol()->name());
+      continue;
+    }
+    reloc_columns_t& cols = columns[section];
+    cols.offset.push_back(reloc.address());
+    cols.S.push_back(*S);
+    cols.A.push_back(reloc.addend());
+    cols.type.push_back(reloc.type());
+    cols.is_rel.push_back(reloc.is_rel() ? 1 : 0);
+  }
+
+  size_t nb_applied = 0;
+  for (auto& [section, cols] : columns) {
+    const uint64_t base = layout.at(section);
+    span<uint8_t> content = section->writable_content();
+    switch (arch) {
+      case ARCH::X86_64:
+        nb_applied += apply_relocations<ARCH::X86_64>(content, base, cols); break;
+      case ARCH::I386:
+        nb_applied += apply_relocations<ARCH::I386>(content, base, cols); break;
+      case ARCH::AARCH64:
+        nb_applied += apply_relocations<ARCH::AARCH64>(content, base, cols); break;
+      case ARCH::ARM:
+        nb_applied += apply_relocations<ARCH::ARM>(content, base, cols); break;
+      case ARCH::RISCV:
+        nb_applied += apply_relocations<ARCH::RISCV>(content, base, cols); break;
+      default:
+        break;
+    }
+  }
+  return nb_applied;
+}
+
+}
+}
@@ -15,6 +15,7 @@
  */
 #include <algorithm>
 #include <iterator>
+#include <utility>
 
 #include "logging.hpp"
 #include "frozen.hpp"
@@ -197,7 +198,7 @@ span<const uint8_t> Section::content() const {
     }
     return {};
   }
-  const std::vector<uint8_t>& binary_content = datahandler_->content();
+  const std::vector<uint8_t>& binary_content = std::as_const(*datahandler_).content();
   DataHandler::Node& node = res.value();
   const uint8_t* ptr = binary_content.data() + node.offset();
   return {ptr, ptr + node.size()};
@@ -370,6 +371,9 @@ span<uint8_t> Section::writable_content() {
   if (is_frame()) {
     return {};
   }
+  if (datahandler_ != nullptr) {
+    datahandler_->detach();
+  }
   span<const uint8_t> ref = static_cast<const Section*>(this)->content();
   return {const_cast<uint8_t*>(ref.data()), ref.size()};
 }
@@ -15,6 +15,7 @@
  */
 #include <algorithm>
 #include <iterator>
+#include <utility>
 
 #include "logging.hpp"
 #include "frozen.hpp"
@@ -154,7 +155,7 @@ span<const uint8_t> Segment::content() const {
   DataHandler::Node& node = res.value();
 
   // Create a span based on our values
-  const std::vector<uint8_t>& binary_content = datahandler_->content();
+  const std::vector<uint8_t>& binary_content = std::as_const(*datahandler_).content();
   const size_t size = binary_content.size();
   if (node.offset() >= size) {
     LIEF_ERR("Can't access content of segment {}:0x{:x}",
@@ -208,7 +209,7 @@ T Segment::get_content_value(size_t offset) const {
       memset(&ret, 0, sizeof(T));
       return ret;
     }
-    const std::vector<uint8_t>& binary_content = datahandler_->content();
+    const std::vector<uint8_t>& binary_content = std::as_const(*datahandler_).content();
     DataHandler::Node& node = res.value();
     memcpy(&ret, binary_content.data() + node.offset() + offset, sizeof(T));
   }
@@ -346,6 +347,9 @@ std::unique_ptr<SpanStream> Segment::stream() const {
 }
 
 span<uint8_t> Segment::writable_content() {
+  if (datahandler_ != nullptr) {
+    datahandler_->detach();
+  }
   span<const uint8_t> ref = static_cast<const Segment*>(this)->content();
   return {const_cast<uint8_t*>(ref.data()), ref.size()};
 }
@@ -40,6 +40,9 @@ struct sizing_info_t {
   uint64_t init_array = 0;
   uint64_t fini_array = 0;
   uint64_t preinit_array = 0;
+
+  // Number of symbols parsed from the .symtab
+  uint64_t nb_symtab_symbols = 0;
 };
 }
 }
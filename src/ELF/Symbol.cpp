@@ -42,7 +42,9 @@ Symbol::Symbol(const Symbol& other) : LIEF::Symbol{other},
   binding_{other.binding_},
   other_{other.other_},
   shndx_{other.shndx_},
-  arch_{other.arch_}
+  arch_{other.arch_},
+  name_offset_{other.name_offset_},
+  symtab_idx_{other.symtab_idx_}
 {}
 
 
@@ -55,6 +57,8 @@ void Symbol::swap(Symbol& other) {
   std::swap(section_,        other.section_);
   std::swap(symbol_version_, other.symbol_version_);
   std::swap(arch_,           other.arch_);
+  std::swap(name_offset_,    other.name_offset_);
+  std::swap(symtab_idx_,     other.symtab_idx_);
 }
 
 template<class T>
@@ -63,7 +67,8 @@ Symbol::Symbol(const T& header, ARCH arch) :
   binding_{binding_from(header.st_info >> 4, arch)},
   other_{header.st_other},
   shndx_{header.st_shndx},
-  arch_{arch}
+  arch_{arch},
+  name_offset_{header.st_name}
 {
   value_ = header.st_value;
   size_  = header.st_size;
@@ -58,9 +58,12 @@
 #include "LIEF/MachO/SubClient.hpp"
 #include "LIEF/MachO/SubFramework.hpp"
 #include "LIEF/MachO/Symbol.hpp"
+#include "LIEF/Abstract/Symbolizer.hpp"
+#include "LIEF/Abstract/GoPclntab.hpp"
 #include "LIEF/MachO/SymbolCommand.hpp"
 #include "LIEF/MachO/ThreadCommand.hpp"
 #include "LIEF/MachO/TwoLevelHints.hpp"
+#include "LIEF/MachO/UnwindInfo.hpp"
 #include "LIEF/MachO/UUIDCommand.hpp"
 #include "LIEF/MachO/VersionMin.hpp"
 #include "MachO/Structures.hpp"
@@ -1086,6 +1089,10 @@ bool Binary::remove(const LoadCommand& command) {
 
   LoadCommand* cmd_rm = it->get();
 
+  if (DyldInfo::classof(cmd_rm) || DyldChainedFixups::classof(cmd_rm)) {
+    symbol_bindings_.reset();
+  }
+
   if (DylibCommand::classof(cmd_rm)) {
     auto it_cache = std::find(std::begin(libraries_), std::end(libraries_), cmd_rm);
     if (it_cache == std::end(libraries_)) {
@@ -1618,40 +1625,45 @@ bool Binary::unexport(const std::string& name) {
 }
 
 bool Binary::unexport(const Symbol& sym) {
-  if (DyldInfo* dyld = dyld_info()) {
-    const auto it_export = std::find_if(
-        std::begin(dyld->export_info_), std::end(dyld->export_info_),
-        [&sym] (const std::unique_ptr<ExportInfo>& info) {
-          return info->has_symbol() && *info->symbol() == sym;
+  // The export entry is reachable from the symbol itself so that we don't
+  // need to look for the symbol in all the exports.
+  const ExportInfo* info = sym.export_info();
+
+  // The symbol is not exported (or only as a re-export alias)
+  if (info == nullptr || info->symbol() != &sym) {
+    return false;
+  }
+
+  const auto erase_export = [info] (std::vector<std::unique_ptr<ExportInfo>>& exports) {
+    const auto it_export = std::find_if(std::begin(exports), std::end(exports),
+        [info] (const std::unique_ptr<ExportInfo>& E) {
+          return E.get() == info;
         });
 
-    // The symbol is not exported
-    if (it_export == std::end(dyld->export_info_)) {
+    if (it_export == std::end(exports)) {
       return false;
     }
-
-    dyld->export_info_.erase(it_export);
+    (*it_export)->symbol_->export_info_ = nullptr;
+    exports.erase(it_export);
     return true;
-  }
+  };
 
+  DyldInfo* dyld = dyld_info();
+  DyldExportsTrie* exports = dyld_exports_trie();
 
-  if (DyldExportsTrie* exports = dyld_exports_trie()) {
-    const auto it_export = std::find_if(
-        std::begin(exports->export_info_), std::end(exports->export_info_),
-        [&sym] (const std::unique_ptr<ExportInfo>& info) {
-          return info->has_symbol() && *info->symbol() == sym;
-        });
+  if (dyld == nullptr && exports == nullptr) {
+    LIEF_INFO("Can't find neither LC_DYLD_INFO / LC_DYLD_EXPORTS_TRIE");
+    return false;
+  }
 
-    // The symbol is not exported
-    if (it_export == std::end(exports->export_info_)) {
-      return false;
-    }
+  if (dyld != nullptr && erase_export(dyld->export_info_)) {
+    return true;
+  }
 
-    exports->export_info_.erase(it_export);
+  if (exports != nullptr && erase_export(exports->export_info_)) {
     return true;
   }
 
-  LIEF_INFO("Can't find neither LC_DYLD_INFO / LC_DYLD_CHAINED_FIXUPS");
   return false;
 }
 
@@ -1659,7 +1671,7 @@ bool Binary::remove(const Symbol& sym) {
   unexport(sym);
   const auto it_sym = std::find_if(std::begin(symbols_), std::end(symbols_),
       [&sym] (const std::unique_ptr<Symbol>& s) {
-        return s->name() == sym.name();
+        return s.get() == &sym;
       });
 
   if (it_sym == std::end(symbols_)) {
@@ -1674,6 +1686,10 @@ bool Binary::remove(const Symbol& sym) {
         std::end(dyst->indirect_symbols_));
   }
 
+  if (symbol_bindings_ != nullptr) {
+    symbol_bindings_->erase(symbol_to_remove);
+  }
+
   symbols_.erase(it_sym);
   return true;
 }
@@ -1690,28 +1706,39 @@ bool Binary::remove_symbol(const std::string& name) {
 }
 
 
-bool Binary::can_remove(const Symbol& sym) const {
-  /*
-   * We consider that a symbol can be removed, if and only if
-   * there are no binding associated with
-   */
+const Binary::symbol_bindings_t& Binary::symbol_bindings() const {
+  if (symbol_bindings_ != nullptr) {
+    return *symbol_bindings_;
+  }
+
+  auto index = std::make_unique<symbol_bindings_t>();
   if (const DyldInfo* dyld = dyld_info()) {
     for (const DyldBindingInfo& binding : dyld->bindings()) {
-      if (binding.has_symbol() && binding.symbol()->name() == sym.name()) {
-        return false;
+      if (const Symbol* sym = binding.symbol()) {
+        (*index)[sym].push_back(&binding);
       }
     }
   }
 
   if (const DyldChainedFixups* fixups = dyld_chained_fixups()) {
     for (const ChainedBindingInfo& binding : fixups->bindings()) {
-      if (binding.has_symbol() && binding.symbol()->name() == sym.name()) {
-        return false;
+      if (const Symbol* sym = binding.symbol()) {
+        (*index)[sym].push_back(&binding);
       }
     }
   }
+  symbol_bindings_ = std::move(index);
+  return *symbol_bindings_;
+}
 
-  return true;
+bool Binary::can_remove(const Symbol& sym) const {
+  /*
+   * We consider that a symbol can be removed, if and only if
+   * there are no binding associated with
+   */
+  const symbol_bindings_t& index = symbol_bindings();
+  const auto it = index.find(&sym);
+  return it == index.end() || it->second.empty();
 }
 
 bool Binary::can_remove_symbol(const std::string& name) const {
@@ -1965,101 +1992,69 @@ LIEF::Binary::functions_t Binary::functions() const {
   std::move(std::begin(exported), std::end(exported),
             std::inserter(functions_set, std::end(functions_set)));
 
+  if (auto gopclntab = GoPclntab::from_binary(*this)) {
+    LIEF::Binary::functions_t go_functions = gopclntab->functions();
+    std::move(std::begin(go_functions), std::end(go_functions),
+              std::inserter(functions_set, std::end(functions_set)));
+  }
+
   return {std::begin(functions_set), std::end(functions_set)};
 
 }
 
-LIEF::Binary::functions_t Binary::unwind_functions() const {
-  static constexpr size_t UNWIND_COMPRESSED = 3;
-  static constexpr size_t UNWIND_UNCOMPRESSED = 2;
-
-  // Set container to have functions with unique address
-  static const auto fcmd = [] (const Function& l, const Function& r) {
-    return l.address() < r.address();
-  };
-  std::set<Function, decltype(fcmd)> functions(fcmd);
+std::unique_ptr<Symbolizer> Binary::symbolizer() const {
+  static constexpr uint8_t N_STAB = 0xe0;
+  auto sym = std::make_unique<Symbolizer>();
+  const uint64_t base = imagebase();
 
-  // Look for the __unwind_info section
-  const Section* unwind_section = get_section("__unwind_info");
-  if (unwind_section == nullptr) {
-    return {};
+  for (const Symbol& s : symbols()) {
+    if ((s.raw_type() & N_STAB) != 0 || s.type() != Symbol::TYPE::SECTION ||
+        s.value() == 0 || s.name().empty())
+    {
+      continue;
+    }
+    sym->add(s.value(), s.size(), s.name());
   }
 
-  SpanStream vs = unwind_section->content();
-
-  // Get section content
-  const auto hdr = vs.read<details::unwind_info_section_header>();
-  if (!hdr) {
-    LIEF_ERR("Can't read unwind section header!");
-    return {};
+  if (auto gopclntab = GoPclntab::from_binary(*this)) {
+    for (uint32_t i = 0; i < gopclntab->size(); ++i) {
+      const uint64_t entry = gopclntab->entry(i);
+      sym->add(entry, gopclntab->end(i) - entry, gopclntab->name(i));
+    }
   }
-  vs.setpos(hdr->index_section_offset);
 
-  size_t lsda_start = -1lu;
-  size_t lsda_stop = 0;
-  for (size_t i = 0; i < hdr->index_count; ++i) {
-    const auto section_hdr = vs.read<details::unwind_info_section_header_index_entry>();
-    if (!section_hdr) {
-      LIEF_ERR("Can't read function information at index #{:d}", i);
-      break;
+  if (const FunctionStarts* fstarts = function_starts()) {
+    for (uint64_t offset : fstarts->functions()) {
+      sym->add(base + offset, 0, "");
     }
+  }
 
-    functions.emplace(section_hdr->function_offset);
-    const size_t second_lvl_off = section_hdr->second_level_pages_section_offset;
-    const size_t lsda_off       = section_hdr->lsda_index_array_section_offset;
-
-    lsda_start = std::min(lsda_off, lsda_start);
-    lsda_stop  = std::max(lsda_off, lsda_stop);
-
-    if (second_lvl_off > 0 && vs.can_read<details::unwind_info_regular_second_level_page_header>(second_lvl_off)) {
-      const size_t saved_pos = vs.pos();
-      {
-        vs.setpos(second_lvl_off);
-        const auto lvl_hdr = vs.peek<details::unwind_info_regular_second_level_page_header>(second_lvl_off);
-        if (!lvl_hdr) {
-          break;
-        }
-        if (lvl_hdr->kind == UNWIND_COMPRESSED) {
-          const auto lvl_compressed_hdr = vs.read<details::unwind_info_compressed_second_level_page_header>();
-          if (!lvl_compressed_hdr) {
-            LIEF_ERR("Can't read lvl_compressed_hdr");
-            break;
-          }
-
-          vs.setpos(second_lvl_off + lvl_compressed_hdr->entry_page_offset);
-          for (size_t j = 0; j < lvl_compressed_hdr->entry_count; ++j) {
-            auto entry = vs.read<uint32_t>();
-            if (!entry) {
-              break;
-            }
-            uint32_t func_off = section_hdr->function_offset + (*entry & 0xffffff);
-            functions.emplace(func_off);
-          }
-        }
-        else if (lvl_hdr->kind == UNWIND_UNCOMPRESSED) {
-          LIEF_WARN("UNWIND_UNCOMPRESSED is not supported yet!");
-        }
-        else {
-          LIEF_WARN("Unknown 2nd level kind: {:d}", lvl_hdr->kind);
-        }
+  // The size of the entries is not used as the linker merges the adjacent
+  // functions that share the same encoding
+  if (auto unwind_info = UnwindInfo::from_binary(*this)) {
+    for (const UnwindInfo::entry_t& entry : unwind_info->entries()) {
+      if (entry.is_function_start()) {
+        sym->add(entry.address, 0, "");
       }
-      vs.setpos(saved_pos);
     }
-
   }
+  sym->finalize(base + virtual_size());
+  return sym;
+}
 
-  const size_t nb_lsda = lsda_stop > lsda_start ? (lsda_stop - lsda_start) / sizeof(details::unwind_info_section_header_lsda_index_entry) : 0;
-  vs.setpos(lsda_start);
-  for (size_t i = 0; i < nb_lsda; ++i) {
-    const auto hdr = vs.read<details::unwind_info_section_header_lsda_index_entry>();
-    if (!hdr) {
-      LIEF_ERR("Can't read LSDA at index #{:d}", i);
-      break;
+LIEF::Binary::functions_t Binary::unwind_functions() const {
+  auto unwind_info = UnwindInfo::from_binary(*this);
+  if (!unwind_info) {
+    return {};
+  }
+  const uint64_t base = imagebase();
+  LIEF::Binary::functions_t functions;
+  for (const UnwindInfo::entry_t& entry : unwind_info->entries()) {
+    if (entry.is_function_start()) {
+      functions.emplace_back(entry.address - base);
     }
-    functions.emplace(hdr->function_offset);
   }
-
-  return {std::begin(functions), std::end(functions)};
+  return functions;
 }
 
 // UUID
@@ -16,6 +16,7 @@
 #include <memory>
 
 #include "logging.hpp"
+#include "Abstract/BudgetTracker.hpp"
 #include "BinaryParser.tcc"
 
 #include "LIEF/BinaryStream/VectorStream.hpp"
@@ -132,9 +133,12 @@ ok_error_t BinaryParser::init_and_parse() {
   binary_->is64_ = is64_;
   type_          = type;
   binary_->original_size_ = stream_->size();
+  budget_ = std::make_unique<BudgetTracker>(config_.budget, NB_STAGES);
 
-  return is64_ ? parse<details::MachO64>() :
-                 parse<details::MachO32>();
+  ok_error_t is_ok = is64_ ? parse<details::MachO64>() :
+                             parse<details::MachO32>();
+  binary_->truncation_ = budget_->reason();
+  return is_ok;
 }
 
 
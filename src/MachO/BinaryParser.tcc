@@ -91,7 +91,14 @@ struct ThreadedBindData {
 
 template<class MACHO_T>
 ok_error_t BinaryParser::parse() {
+  if (!budget_->stage("header")) {
+    return ok();
+  }
   parse_header<MACHO_T>();
+
+  if (!budget_->stage("load commands")) {
+    return ok();
+  }
   if (binary_->header().nb_cmds() > 0) {
     parse_load_commands<MACHO_T>();
   }
@@ -100,6 +107,9 @@ ok_error_t BinaryParser::parse() {
    * We must perform this post-processing BEFORE parsing
    * the exports trie as it could create new symbols and break the DynamicSymbolCommand's indexes
    */
+  if (!budget_->stage("symbols")) {
+    return ok();
+  }
   if (SymbolCommand* symtab = binary_->symbol_command()) {
     post_process<MACHO_T>(*symtab);
   }
@@ -108,10 +118,16 @@ ok_error_t BinaryParser::parse() {
     post_process<MACHO_T>(*dynsym);
   }
 
+  if (!budget_->stage("relocations")) {
+    return ok();
+  }
   for (Section& section : binary_->sections()) {
     parse_relocations<MACHO_T>(section);
   }
 
+  if (!budget_->stage("dyld info")) {
+    return ok();
+  }
   if (binary_->has_dyld_info()) {
 
     if (config_.parse_dyld_exports) {
@@ -127,6 +143,9 @@ ok_error_t BinaryParser::parse() {
     }
   }
 
+  if (!budget_->stage("exports trie")) {
+    return ok();
+  }
   if (config_.parse_dyld_exports && binary_->has_dyld_exports_trie()) {
     parse_dyld_exports();
   }
@@ -145,6 +164,9 @@ ok_error_t BinaryParser::parse() {
   }
 
 
+  if (!budget_->stage("chained fixups")) {
+    return ok();
+  }
   if (DyldChainedFixups* fixups = binary_->dyld_chained_fixups()) {
     LIEF_DEBUG("[+] Parsing LC_DYLD_CHAINED_FIXUPS payload");
     SpanStream stream = fixups->content_;
@@ -158,6 +180,9 @@ ok_error_t BinaryParser::parse() {
   /*
    * Create the slices for the LinkEdit commands
    */
+  if (!budget_->stage("linkedit")) {
+    return ok();
+  }
   if (FunctionStarts* fstart = binary_->function_starts()) {
     post_process<MACHO_T>(*fstart);
   }
@@ -180,12 +205,18 @@ ok_error_t BinaryParser::parse() {
     post_process<MACHO_T>(*opt);
   }
 
+  if (!budget_->stage("indirect bindings")) {
+    return ok();
+  }
   if (binary_->dyld_info() == nullptr &&
       binary_->dyld_chained_fixups() == nullptr)
   {
     infer_indirect_bindings<MACHO_T>();
   }
 
+  if (!budget_->stage("overlay")) {
+    return ok();
+  }
   if (config_.parse_overlay) {
     parse_overlay();
   }
@@ -222,10 +253,9 @@ ok_error_t BinaryParser::parse_load_commands() {
     return make_error_code(lief_errors::corrupted);
   }
 
-  size_t nbcmds = header.nb_cmds();
+  const size_t nbcmds = budget_->limit(header.nb_cmds(), BinaryParser::MAX_COMMANDS);
 
-  if (header.nb_cmds() > BinaryParser::MAX_COMMANDS) {
-    nbcmds = BinaryParser::MAX_COMMANDS;
+  if (nbcmds < header.nb_cmds()) {
     LIEF_WARN("Only the first #{:d} will be parsed", nbcmds);
   }
 
@@ -236,6 +266,9 @@ ok_error_t BinaryParser::parse_load_commands() {
   int64_t imagebase = -1;
 
   for (size_t i = 0; i < nbcmds; ++i) {
+    if (!budget_->tick(sizeof(LoadCommand))) {
+      break;
+    }
     const auto command = stream_->peek<details::load_command>(loadcommands_offset);
     if (!command) {
       break;
@@ -291,7 +324,9 @@ ok_error_t BinaryParser::parse_load_commands() {
             static_cast<MemoryStream&>(*stream_).binary(*binary_);
           }
 
-          if (segment->file_size() > 0) {
+          // The content of the segment is copied: it is accounted in the
+          // memory budget (the next command stops the parsing if exhausted)
+          if (segment->file_size() > 0 && budget_->tick(segment->file_size())) {
             if (MemoryStream::classof(*stream_)) {
               auto& memstream = static_cast<MemoryStream&>(*stream_);
               uintptr_t segment_va = segment->virtual_address();
@@ -1095,9 +1130,9 @@ ok_error_t BinaryParser::parse_relocations(Section& section) {
   LIEF_DEBUG("Parse '{}' relocations (#{:d})", section.name(), section.numberof_relocations());
 
   uint64_t current_reloc_offset = section.relocation_offset();
-  size_t numberof_relocations = section.numberof_relocations();
-  if (section.numberof_relocations() > BinaryParser::MAX_RELOCATIONS) {
-    numberof_relocations = BinaryParser::MAX_RELOCATIONS;
+  const size_t numberof_relocations =
+    budget_->limit(section.numberof_relocations(), BinaryParser::MAX_RELOCATIONS);
+  if (numberof_relocations < section.numberof_relocations()) {
     LIEF_WARN("Huge number of relocations (#{:d}). Only the first #{:d} will be parsed",
               section.numberof_relocations(), numberof_relocations);
 
@@ -1108,6 +1143,9 @@ ok_error_t BinaryParser::parse_relocations(Section& section) {
   }
 
   for (size_t i = 0; i < numberof_relocations; ++i) {
+    if (!budget_->tick(sizeof(RelocationObject))) {
+      break;
+    }
     std::unique_ptr<RelocationObject> reloc;
     int32_t address = 0;
     if (auto res = stream_->peek<int32_t>(current_reloc_offset)) {
@@ -1254,6 +1292,9 @@ ok_error_t BinaryParser::parse_dyldinfo_rebases() {
   stream_->setpos(offset);
 
   while (!done && stream_->pos() < end_offset) {
+    if (!budget_->tick()) {
+      break;
+    }
     auto val = stream_->read<uint8_t>();
     if (!val) {
       break;
@@ -1506,6 +1547,9 @@ ok_error_t BinaryParser::parse_dyldinfo_generic_bind() {
   Binary::it_segments segments = binary_->segments();
   stream_->setpos(offset);
   while (!done && stream_->pos() < end_offset) {
+    if (!budget_->tick()) {
+      break;
+    }
     auto val = stream_->read<uint8_t>();
     if (!val) {
       break;
@@ -1868,6 +1912,9 @@ ok_error_t BinaryParser::parse_dyldinfo_weak_bind() {
   stream_->setpos(offset);
 
   while (!done && stream_->pos() < end_offset) {
+    if (!budget_->tick()) {
+      break;
+    }
     auto val = stream_->read<uint8_t>();
     if (!val) {
       break;
@@ -2113,6 +2160,9 @@ ok_error_t BinaryParser::parse_dyldinfo_lazy_bind() {
   Binary::it_segments segments = binary_->segments();
   stream_->setpos(offset);
   while (stream_->pos() < end_offset) {
+    if (!budget_->tick()) {
+      break;
+    }
     auto val = stream_->read<uint8_t>();
     if (!val) {
       break;
@@ -3767,6 +3817,9 @@ ok_error_t BinaryParser::parse_symtab(SymbolCommand&/*cmd*/,
 
   size_t idx = 0;
   while (nlist_s) {
+    if (!budget_->tick(sizeof(Symbol))) {
+      break;
+    }
     auto nlist = nlist_s.read<nlist_t>();
     if (!nlist) {
       LIEF_ERR("Can't read nlist #{}", idx);
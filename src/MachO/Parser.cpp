@@ -16,6 +16,7 @@
 #include <memory>
 
 #include "logging.hpp"
+#include "Abstract/BudgetTracker.hpp"
 
 
 #include "LIEF/BinaryStream/VectorStream.hpp"
@@ -150,7 +151,14 @@ ok_error_t Parser::build_fat() {
     return make_error_code(lief_errors::parsing_error);
   }
 
+  // The slices share the budget: each of them is parsed with what is left
+  BudgetTracker budget(config_.budget, nb_arch);
+  nb_arch = budget.limit(nb_arch, MAX_FAT_ARCH);
+
   for (size_t i = 0; i < nb_arch; ++i) {
+    if (!budget.check()) {
+      break;
+    }
     auto res_arch = stream_->read<details::fat_arch>();
     if (!res_arch) {
       LIEF_ERR("Can't read arch #{}", i);
@@ -165,20 +173,36 @@ ok_error_t Parser::build_fat() {
     LIEF_DEBUG("    [{:d}].offset: 0x{:06x}", i, offset);
     LIEF_DEBUG("    [{:d}].size  : 0x{:06x}", i, size);
 
+    // The slice is copied
+    if (!budget.tick(size)) {
+      break;
+    }
+
     std::vector<uint8_t> macho_data;
     if (!stream_->peek_data(macho_data, offset, size)) {
       LIEF_ERR("MachO #{:d} is corrupted!", i);
       continue;
     }
 
+    ParserConfig config = config_;
+    config.budget = budget.remaining();
     std::unique_ptr<Binary> bin = BinaryParser::parse(
-        std::move(macho_data), offset, config_
+        std::move(macho_data), offset, config
     );
     if (bin == nullptr) {
       LIEF_ERR("Can't parse the binary at the index #{:d}", i);
       continue;
     }
+    const ParserBudget::TRUNCATION reason = bin->truncation();
     binaries_.push_back(std::move(bin));
+
+    // The budget is exhausted (a table clamped by max_objects does not stop
+    // the parsing of the other slices)
+    if (reason != ParserBudget::TRUNCATION::NONE &&
+        reason != ParserBudget::TRUNCATION::OBJECTS)
+    {
+      break;
+    }
   }
   return ok();
 }
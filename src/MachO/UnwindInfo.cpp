@@ -0,0 +1,546 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <string>
+
+#include "logging.hpp"
+
+#include "LIEF/BinaryStream/SpanStream.hpp"
+#include "LIEF/DWARF/enums.hpp"
+#include "LIEF/MachO/Binary.hpp"
+#include "LIEF/MachO/Section.hpp"
+#include "LIEF/MachO/UnwindInfo.hpp"
+
+#include "MachO/Structures.hpp"
+
+namespace LIEF {
+namespace MachO {
+
+static constexpr uint32_t NOT_FOUND = uint32_t(-1);
+
+static constexpr uint32_t UNWIND_SECOND_LEVEL_REGULAR    = 2;
+static constexpr uint32_t UNWIND_SECOND_LEVEL_COMPRESSED = 3;
+
+static constexpr uint32_t COMPRESSED_OFFSET_MASK = 0x00ffffff;
+
+static constexpr uint32_t MODE_DWARF_X86 = 0x04000000;
+static constexpr uint32_t MODE_DWARF_ARM64 = 0x03000000;
+
+template<class T>
+static T read_at(span<const uint8_t> raw, uint64_t offset) {
+  T value{};
+  if (offset > raw.size() || raw.size() - offset < sizeof(T)) {
+    return value;
+  }
+  std::memcpy(&value, raw.data() + offset, sizeof(T));
+  return value;
+}
+
+// Read a DWARF pointer encoded with the format given by the low nibble of
+// the encoding
+static result<uint64_t> read_encoded(SpanStream& stream, uint8_t encoding,
+                                     size_t ptr_size)
+{
+  switch (static_cast<dwarf::EH_ENCODING>(encoding & 0x0f)) {
+    case dwarf::EH_ENCODING::ABSPTR:
+      {
+        if (ptr_size == sizeof(uint64_t)) {
+          return stream.read<uint64_t>();
+        }
+        return stream.read<uint32_t>();
+      }
+    case dwarf::EH_ENCODING::ULEB128: return stream.read_uleb128();
+    case dwarf::EH_ENCODING::SLEB128: return stream.read_sleb128();
+    case dwarf::EH_ENCODING::UDATA2:  return stream.read<uint16_t>();
+    case dwarf::EH_ENCODING::UDATA4:  return stream.read<uint32_t>();
+    case dwarf::EH_ENCODING::UDATA8:  return stream.read<uint64_t>();
+    case dwarf::EH_ENCODING::SDATA2:
+      {
+        auto value = stream.read<int16_t>();
+        if (!value) {
+          return make_error_code(value.error());
+        }
+        return static_cast<uint64_t>(static_cast<int64_t>(*value));
+      }
+    case dwarf::EH_ENCODING::SDATA4:
+      {
+        auto value = stream.read<int32_t>();
+        if (!value) {
+          return make_error_code(value.error());
+        }
+        return static_cast<uint64_t>(static_cast<int64_t>(*value));
+      }
+    case dwarf::EH_ENCODING::SDATA8: return stream.read<uint64_t>();
+    default:
+      return make_error_code(lief_errors::not_supported);
+  }
+}
+
+result<UnwindInfo> UnwindInfo::from_binary(const Binary& bin) {
+  const Section* unwind_section = bin.get_section("__unwind_info");
+  if (unwind_section == nullptr) {
+    return make_error_code(lief_errors::not_found);
+  }
+
+  span<const uint8_t> eh_frame;
+  uint64_t eh_frame_address = 0;
+  if (const Section* section = bin.get_section("__eh_frame")) {
+    eh_frame = section->content();
+    eh_frame_address = section->virtual_address();
+  }
+  return parse(unwind_section->content(), bin.imagebase(),
+               bin.header().cpu_type(), eh_frame, eh_frame_address);
+}
+
+result<UnwindInfo> UnwindInfo::parse(span<const uint8_t> raw, uint64_t imagebase,
+                                     Header::CPU_TYPE arch,
+                                     span<const uint8_t> eh_frame,
+                                     uint64_t eh_frame_address)
+{
+  if (raw.size() < sizeof(details::unwind_info_section_header)) {
+    LIEF_ERR("Can't read unwind section header!");
+    return make_error_code(lief_errors::read_error);
+  }
+  auto hdr = read_at<details::unwind_info_section_header>(raw, 0);
+
+  if (hdr.version != 1) {
+    LIEF_WARN("Unsupported __unwind_info version: {}", hdr.version);
+    return make_error_code(lief_errors::not_supported);
+  }
+
+  const auto fits = [&raw] (uint64_t offset, uint64_t count, uint64_t size) {
+    return offset <= raw.size() && (raw.size() - offset) / size >= count;
+  };
+
+  if (!fits(hdr.common_encodings_array_section_offset,
+            hdr.common_encodings_arraycount, sizeof(uint32_t)) ||
+      !fits(hdr.personality_array_section_offset,
+            hdr.personality_array_count, sizeof(uint32_t)) ||
+      !fits(hdr.index_section_offset, hdr.index_count,
+            sizeof(details::unwind_info_section_header_index_entry)))
+  {
+    LIEF_ERR("The __unwind_info arrays are out of bounds");
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  UnwindInfo info;
+  info.raw_ = raw;
+  info.eh_frame_ = eh_frame;
+  info.eh_frame_address_ = eh_frame_address;
+  info.imagebase_ = imagebase;
+  info.arch_ = arch;
+  info.version_ = hdr.version;
+  info.encodings_offset_ = hdr.common_encodings_array_section_offset;
+  info.nb_encodings_ = hdr.common_encodings_arraycount;
+  info.personalities_offset_ = hdr.personality_array_section_offset;
+  info.nb_personalities_ = hdr.personality_array_count;
+  info.index_offset_ = hdr.index_section_offset;
+  info.nb_index_ = hdr.index_count;
+  return info;
+}
+
+uint32_t UnwindInfo::read_u32(uint32_t offset) const {
+  return read_at<uint32_t>(raw_, offset);
+}
+
+std::vector<uint32_t> UnwindInfo::common_encodings() const {
+  std::vector<uint32_t> encodings;
+  encodings.reserve(nb_encodings_);
+  for (uint32_t i = 0; i < nb_encodings_; ++i) {
+    encodings.push_back(read_u32(encodings_offset_ + i * sizeof(uint32_t)));
+  }
+  return encodings;
+}
+
+std::vector<uint64_t> UnwindInfo::personalities() const {
+  std::vector<uint64_t> personalities;
+  personalities.reserve(nb_personalities_);
+  for (uint32_t i = 0; i < nb_personalities_; ++i) {
+    personalities.push_back(imagebase_ + read_u32(personalities_offset_ + i * sizeof(uint32_t)));
+  }
+  return personalities;
+}
+
+uint32_t UnwindInfo::index_function(uint32_t idx) const {
+  return read_u32(index_offset_ + idx * sizeof(details::unwind_info_section_header_index_entry));
+}
+
+UnwindInfo::page_t UnwindInfo::page(uint32_t idx) const {
+  using index_entry_t = details::unwind_info_section_header_index_entry;
+  page_t page;
+  if (idx + 1 >= nb_index_) {
+    return page;
+  }
+  const auto current = read_at<index_entry_t>(raw_, index_offset_ + idx * sizeof(index_entry_t));
+  const auto next = read_at<index_entry_t>(raw_, index_offset_ + (idx + 1) * sizeof(index_entry_t));
+
+  page.start = current.function_offset;
+  page.end = next.function_offset;
+  page.lsda_start = current.lsda_index_array_section_offset;
+  page.lsda_end = next.lsda_index_array_section_offset;
+
+  const uint32_t offset = current.second_level_pages_section_offset;
+  if (offset == 0 || page.end < page.start) {
+    return page;
+  }
+
+  const auto kind = read_at<uint32_t>(raw_, offset);
+  if (kind == UNWIND_SECOND_LEVEL_REGULAR) {
+    using header_t = details::unwind_info_regular_second_level_page_header;
+    using regular_entry_t = details::unwind_info_regular_second_level_entry;
+    if (uint64_t(offset) + sizeof(header_t) > raw_.size()) {
+      return page;
+    }
+    const auto hdr = read_at<header_t>(raw_, offset);
+    const uint64_t entries_offset = uint64_t(offset) + hdr.entry_page_offset;
+    if (entries_offset + uint64_t(hdr.entry_count) * sizeof(regular_entry_t) > raw_.size()) {
+      LIEF_DEBUG("Regular page #{} is out of bounds", idx);
+      return page;
+    }
+    page.kind = kind;
+    page.entries_offset = static_cast<uint32_t>(entries_offset);
+    page.nb_entries = hdr.entry_count;
+    return page;
+  }
+
+  if (kind == UNWIND_SECOND_LEVEL_COMPRESSED) {
+    using header_t = details::unwind_info_compressed_second_level_page_header;
+    if (uint64_t(offset) + sizeof(header_t) > raw_.size()) {
+      return page;
+    }
+    const auto hdr = read_at<header_t>(raw_, offset);
+    const uint64_t entries_offset = uint64_t(offset) + hdr.entry_page_offset;
+    const uint64_t encodings_offset = uint64_t(offset) + hdr.encodings_page_offset;
+    if (entries_offset + uint64_t(hdr.entry_count) * sizeof(uint32_t) > raw_.size() ||
+        encodings_offset + uint64_t(hdr.encodings_count) * sizeof(uint32_t) > raw_.size())
+    {
+      LIEF_DEBUG("Compressed page #{} is out of bounds", idx);
+      return page;
+    }
+    page.kind = kind;
+    page.entries_offset = static_cast<uint32_t>(entries_offset);
+    page.nb_entries = hdr.entry_count;
+    page.encodings_offset = static_cast<uint32_t>(encodings_offset);
+    page.nb_encodings = hdr.encodings_count;
+    return page;
+  }
+
+  LIEF_DEBUG("Unknown 2nd level kind: {:d}", kind);
+  return page;
+}
+
+uint32_t UnwindInfo::function_offset(const page_t& page, uint32_t idx) const {
+  if (page.kind == UNWIND_SECOND_LEVEL_REGULAR) {
+    return read_u32(page.entries_offset + idx * sizeof(details::unwind_info_regular_second_level_entry));
+  }
+  // Compressed entries: 8-bit encoding index | 24-bit offset from the page's start
+  return page.start + (read_u32(page.entries_offset + idx * sizeof(uint32_t)) & COMPRESSED_OFFSET_MASK);
+}
+
+UnwindInfo::entry_t UnwindInfo::entry(const page_t& page, uint32_t idx) const {
+  entry_t entry;
+  const uint32_t start = function_offset(page, idx);
+  const uint32_t end = idx + 1 < page.nb_entries ? function_offset(page, idx + 1) : page.end;
+
+  entry.address = imagebase_ + start;
+  entry.size = end > start ? end - start : 0;
+
+  if (page.kind == UNWIND_SECOND_LEVEL_REGULAR) {
+    entry.encoding = read_u32(page.entries_offset + idx * sizeof(details::unwind_info_regular_second_level_entry) +
+                              sizeof(uint32_t));
+  } else {
+    const uint32_t enc_idx = read_u32(page.entries_offset + idx * sizeof(uint32_t)) >> 24;
+    if (enc_idx < nb_encodings_) {
+      entry.encoding = read_u32(encodings_offset_ + enc_idx * sizeof(uint32_t));
+    } else if (enc_idx - nb_encodings_ < page.nb_encodings) {
+      entry.encoding = read_u32(page.encodings_offset + (enc_idx - nb_encodings_) * sizeof(uint32_t));
+    }
+  }
+
+  if (const uint32_t pidx = (entry.encoding & PERSONALITY_MASK) >> 28;
+      pidx > 0 && pidx <= nb_personalities_)
+  {
+    entry.personality = imagebase_ + read_u32(personalities_offset_ + (pidx - 1) * sizeof(uint32_t));
+  }
+
+  // The LSDA entries of the page are sorted by function offset
+  if (entry.has_lsda() && page.lsda_start <= page.lsda_end && page.lsda_end <= raw_.size()) {
+    using lsda_entry_t = details::unwind_info_section_header_lsda_index_entry;
+    uint32_t lo = 0;
+    uint32_t hi = (page.lsda_end - page.lsda_start) / sizeof(lsda_entry_t);
+    while (lo < hi) {
+      const uint32_t mid = lo + (hi - lo) / 2;
+      const auto lsda = read_at<lsda_entry_t>(raw_, page.lsda_start + mid * sizeof(lsda_entry_t));
+      if (lsda.function_offset == start) {
+        entry.lsda = imagebase_ + lsda.lsda_offset;
+        break;
+      }
+      if (lsda.function_offset < start) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+  }
+  return entry;
+}
+
+uint32_t UnwindInfo::find_page(uint32_t offset) const {
+  // The last entry of the first-level index is a sentinel that
+  // holds the end of the range covered by the table
+  if (nb_index_ < 2 || offset < index_function(0) ||
+      offset >= index_function(nb_index_ - 1))
+  {
+    return NOT_FOUND;
+  }
+  uint32_t lo = 0;
+  uint32_t hi = nb_index_ - 1;
+  while (hi - lo > 1) {
+    const uint32_t mid = lo + (hi - lo) / 2;
+    if (index_function(mid) <= offset) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+uint32_t UnwindInfo::find_entry(const page_t& page, uint32_t offset) const {
+  if (page.nb_entries == 0 || offset < function_offset(page, 0)) {
+    return NOT_FOUND;
+  }
+  uint32_t lo = 0;
+  uint32_t hi = page.nb_entries;
+  while (hi - lo > 1) {
+    const uint32_t mid = lo + (hi - lo) / 2;
+    if (function_offset(page, mid) <= offset) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+result<UnwindInfo::entry_t> UnwindInfo::lookup(uint64_t address) const {
+  if (address < imagebase_ || address - imagebase_ > uint32_t(-1)) {
+    return make_error_code(lief_errors::not_found);
+  }
+  const auto offset = static_cast<uint32_t>(address - imagebase_);
+  const uint32_t page_idx = find_page(offset);
+  if (page_idx == NOT_FOUND) {
+    return make_error_code(lief_errors::not_found);
+  }
+  const page_t page = this->page(page_idx);
+  const uint32_t idx = find_entry(page, offset);
+  if (idx == NOT_FOUND) {
+    return make_error_code(lief_errors::not_found);
+  }
+  return entry(page, idx);
+}
+
+void UnwindInfo::lookup(const uint64_t* addresses, size_t count, entry_t* entries) const {
+  page_t page;
+  bool has_page = false;
+  for (size_t i = 0; i < count; ++i) {
+    entries[i] = entry_t{};
+    const uint64_t address = addresses[i];
+    if (address < imagebase_ || address - imagebase_ > uint32_t(-1)) {
+      continue;
+    }
+    const auto offset = static_cast<uint32_t>(address - imagebase_);
+    if (!has_page || offset < page.start || offset >= page.end) {
+      const uint32_t page_idx = find_page(offset);
+      has_page = page_idx != NOT_FOUND;
+      if (!has_page) {
+        continue;
+      }
+      page = this->page(page_idx);
+    }
+    if (const uint32_t idx = find_entry(page, offset); idx != NOT_FOUND) {
+      entries[i] = entry(page, idx);
+    }
+  }
+}
+
+std::vector<UnwindInfo::entry_t> UnwindInfo::lookup(const std::vector<uint64_t>& addresses) const {
+  std::vector<entry_t> entries(addresses.size());
+  lookup(addresses.data(), addresses.size(), entries.data());
+  return entries;
+}
+
+UnwindInfo::entries_it UnwindInfo::entries() const {
+  return {Iterator(*this, 0, 0), Iterator(*this, nb_pages(), 0)};
+}
+
+UnwindInfo::Iterator::Iterator(const UnwindInfo& info, uint32_t page, uint32_t idx) :
+  info_(&info), page_(page), idx_(idx)
+{
+  skip_empty_pages();
+}
+
+void UnwindInfo::Iterator::skip_empty_pages() {
+  const uint32_t nb_pages = info_->nb_pages();
+  while (page_ < nb_pages) {
+    const page_t page = info_->page(page_);
+    if (idx_ < page.nb_entries) {
+      entry_ = info_->entry(page, idx_);
+      return;
+    }
+    ++page_;
+    idx_ = 0;
+  }
+  entry_ = entry_t{};
+}
+
+UnwindInfo::Iterator& UnwindInfo::Iterator::operator++() {
+  ++idx_;
+  skip_empty_pages();
+  return *this;
+}
+
+bool UnwindInfo::is_dwarf(uint32_t encoding) const {
+  const uint32_t mode = encoding & MODE_MASK;
+  switch (arch_) {
+    case Header::CPU_TYPE::ARM64:
+      return mode == MODE_DWARF_ARM64;
+    case Header::CPU_TYPE::X86:
+    case Header::CPU_TYPE::X86_64:
+    case Header::CPU_TYPE::ARM:
+      return mode == MODE_DWARF_X86;
+    default:
+      return false;
+  }
+}
+
+result<UnwindInfo::fde_t> UnwindInfo::fde(const entry_t& entry) const {
+  static constexpr uint32_t EXTENDED_LENGTH = 0xffffffff;
+  if (!is_dwarf(entry.encoding)) {
+    return make_error_code(lief_errors::not_found);
+  }
+  if (eh_frame_.empty()) {
+    LIEF_DEBUG("Missing __eh_frame to resolve the FDE of 0x{:x}", entry.address);
+    return make_error_code(lief_errors::not_found);
+  }
+
+  const size_t ptr_size = (arch_ == Header::CPU_TYPE::X86_64 ||
+                           arch_ == Header::CPU_TYPE::ARM64) ? sizeof(uint64_t) :
+                                                               sizeof(uint32_t);
+
+  // Skip the length of a CIE/FDE record
+  const auto skip_length = [] (SpanStream& stream) {
+    auto length = stream.read<uint32_t>();
+    if (!length || *length == 0) {
+      return false;
+    }
+    if (*length == EXTENDED_LENGTH) {
+      return bool(stream.read<uint64_t>());
+    }
+    return true;
+  };
+
+  fde_t fde;
+  const uint32_t fde_offset = entry.encoding & DWARF_SECTION_OFFSET;
+  fde.address = eh_frame_address_ + fde_offset;
+
+  SpanStream stream(eh_frame_);
+  stream.setpos(fde_offset);
+  if (!skip_length(stream)) {
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  // The CIE pointer is relative to its own position (0 for a CIE)
+  const size_t cie_ptr_pos = stream.pos();
+  auto cie_ptr = stream.read<uint32_t>();
+  if (!cie_ptr || *cie_ptr == 0 || *cie_ptr > cie_ptr_pos) {
+    LIEF_DEBUG("Invalid CIE pointer for the FDE at 0x{:x}", fde.address);
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  uint8_t fde_encoding = 0;
+  {
+    SpanStream cie(eh_frame_);
+    cie.setpos(cie_ptr_pos - *cie_ptr);
+    if (!skip_length(cie)) {
+      return make_error_code(lief_errors::corrupted);
+    }
+    auto cie_id = cie.read<uint32_t>();
+    auto version = cie.read<uint8_t>();
+    auto augmentation = cie.read_string();
+    if (!cie_id || *cie_id != 0 || !version || !augmentation) {
+      return make_error_code(lief_errors::corrupted);
+    }
+    if (augmentation->find("eh") != std::string::npos) {
+      cie.increment_pos(ptr_size);
+    }
+    cie.read_uleb128(); // code alignment
+    cie.read_sleb128(); // data alignment
+    if (*version == 1) {
+      cie.read<uint8_t>();
+    } else {
+      cie.read_uleb128();
+    }
+
+    if (!augmentation->empty() && (*augmentation)[0] == 'z') {
+      cie.read_uleb128(); // augmentation length
+      for (size_t i = 1; i < augmentation->size(); ++i) {
+        const char c = (*augmentation)[i];
+        if (c == 'R') {
+          fde_encoding = cie.read<uint8_t>().value_or(0);
+        } else if (c == 'L') {
+          cie.read<uint8_t>();
+        } else if (c == 'P') {
+          const uint8_t encoding = cie.read<uint8_t>().value_or(0);
+          if (!read_encoded(cie, encoding, ptr_size)) {
+            return make_error_code(lief_errors::corrupted);
+          }
+        } else if (c != 'S' && c != 'B') {
+          LIEF_DEBUG("Unknown CIE augmentation: '{}'", *augmentation);
+          break;
+        }
+      }
+    }
+  }
+
+  const uint64_t pc_begin_address = eh_frame_address_ + stream.pos();
+  auto pc_begin = read_encoded(stream, fde_encoding, ptr_size);
+  auto pc_range = read_encoded(stream, fde_encoding & 0x0f, ptr_size);
+  if (!pc_begin || !pc_range) {
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  switch (static_cast<dwarf::EH_ENCODING>(fde_encoding & 0x70)) {
+    case dwarf::EH_ENCODING::ABSPTR:
+      break;
+    case dwarf::EH_ENCODING::PCREL:
+      *pc_begin += pc_begin_address;
+      break;
+    default:
+      LIEF_DEBUG("Unsupported FDE pointer encoding: 0x{:02x}", fde_encoding);
+      return make_error_code(lief_errors::not_supported);
+  }
+
+  if (ptr_size == sizeof(uint32_t)) {
+    *pc_begin &= 0xffffffff;
+  }
+  fde.pc_begin = *pc_begin;
+  fde.pc_end = *pc_begin + *pc_range;
+  return fde;
+}
+
+}
+}
@@ -0,0 +1,238 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "logging.hpp"
+
+#include "LIEF/BinaryStream/BinaryStream.hpp"
+#include "LIEF/ELF/DynamicEntry.hpp"
+#include "LIEF/ELF/Header.hpp"
+#include "LIEF/ELF/Section.hpp"
+#include "LIEF/ELF/Segment.hpp"
+
+#include "ELF/Structures.hpp"
+#include "OAT/Layout.hpp"
+#include "OAT/Structures.hpp"
+
+namespace LIEF {
+namespace OAT {
+namespace details {
+
+namespace {
+// The dynamic symbol table of an OAT file only contains a handful of symbols
+static constexpr uint64_t MAX_DYNSYM = 0x100;
+
+constexpr bool is_host_big_endian() {
+  #if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__)
+    return __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+  #else
+    return false;
+  #endif
+}
+
+struct load_t {
+  uint64_t offset;
+  uint64_t address;
+  uint64_t size;
+};
+
+result<uint64_t> va2offset(const std::vector<load_t>& loads, uint64_t address) {
+  for (const load_t& load : loads) {
+    if (load.address <= address && address < load.address + load.size) {
+      return load.offset + (address - load.address);
+    }
+  }
+  return make_error_code(lief_errors::conversion_error);
+}
+
+template<class ELF_T>
+result<oat_layout_t> locate_impl(BinaryStream& stream) {
+  using Elf_Ehdr = typename ELF_T::Elf_Ehdr;
+  using Elf_Phdr = typename ELF_T::Elf_Phdr;
+  using Elf_Shdr = typename ELF_T::Elf_Shdr;
+  using Elf_Dyn  = typename ELF_T::Elf_Dyn;
+  using Elf_Sym  = typename ELF_T::Elf_Sym;
+
+  auto hdr = stream.peek_conv<Elf_Ehdr>(0);
+  if (!hdr) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  std::vector<load_t> loads;
+  uint64_t dynamic_offset = 0;
+  uint64_t dynamic_size = 0;
+  for (size_t i = 0; i < hdr->e_phnum; ++i) {
+    auto phdr = stream.peek_conv<Elf_Phdr>(hdr->e_phoff + i * sizeof(Elf_Phdr));
+    if (!phdr) {
+      return make_error_code(lief_errors::read_error);
+    }
+    const auto type = static_cast<ELF::Segment::TYPE>(phdr->p_type);
+    if (type == ELF::Segment::TYPE::LOAD) {
+      loads.push_back({phdr->p_offset, phdr->p_vaddr, phdr->p_filesz});
+    } else if (type == ELF::Segment::TYPE::DYNAMIC) {
+      dynamic_offset = phdr->p_offset;
+      dynamic_size   = phdr->p_filesz;
+    }
+  }
+
+  uint64_t symtab_offset = 0;
+  uint64_t strtab_offset = 0;
+  uint64_t strtab_size   = 0;
+  uint64_t nb_symbols    = 0;
+
+  // Resolve the dynamic symbol table with the dynamic entries
+  // (DT_SYMTAB, DT_STRTAB, DT_HASH) ...
+  uint64_t symtab_addr = 0;
+  uint64_t strtab_addr = 0;
+  uint64_t hash_addr   = 0;
+  for (size_t i = 0; i < dynamic_size / sizeof(Elf_Dyn); ++i) {
+    auto dyn = stream.peek_conv<Elf_Dyn>(dynamic_offset + i * sizeof(Elf_Dyn));
+    if (!dyn || dyn->d_tag == 0) {
+      break;
+    }
+    switch (static_cast<ELF::DynamicEntry::TAG>(dyn->d_tag)) {
+      case ELF::DynamicEntry::TAG::SYMTAB: symtab_addr = dyn->d_un.d_val; break;
+      case ELF::DynamicEntry::TAG::STRTAB: strtab_addr = dyn->d_un.d_val; break;
+      case ELF::DynamicEntry::TAG::STRSZ:  strtab_size = dyn->d_un.d_val; break;
+      case ELF::DynamicEntry::TAG::HASH:   hash_addr   = dyn->d_un.d_val; break;
+      default: break;
+    }
+  }
+
+  if (symtab_addr != 0 && strtab_addr != 0 && hash_addr != 0) {
+    auto sym_off  = va2offset(loads, symtab_addr);
+    auto str_off  = va2offset(loads, strtab_addr);
+    auto hash_off = va2offset(loads, hash_addr);
+    if (sym_off && str_off && hash_off) {
+      // DT_HASH: nbucket, nchain (== number of symbols)
+      if (auto nchain = stream.peek_conv<uint32_t>(*hash_off + sizeof(uint32_t))) {
+        symtab_offset = *sym_off;
+        strtab_offset = *str_off;
+        nb_symbols    = *nchain;
+      }
+    }
+  }
+
+  // ... or with the section headers
+  if (nb_symbols == 0) {
+    for (size_t i = 0; i < hdr->e_shnum; ++i) {
+      auto shdr = stream.peek_conv<Elf_Shdr>(hdr->e_shoff + i * sizeof(Elf_Shdr));
+      if (!shdr) {
+        break;
+      }
+      if (static_cast<ELF::Section::TYPE>(shdr->sh_type) != ELF::Section::TYPE::DYNSYM) {
+        continue;
+      }
+      auto strtab = stream.peek_conv<Elf_Shdr>(hdr->e_shoff + shdr->sh_link * sizeof(Elf_Shdr));
+      if (!strtab) {
+        break;
+      }
+      symtab_offset = shdr->sh_offset;
+      nb_symbols    = shdr->sh_size / sizeof(Elf_Sym);
+      strtab_offset = strtab->sh_offset;
+      strtab_size   = strtab->sh_size;
+      break;
+    }
+  }
+
+  if (nb_symbols == 0) {
+    LIEF_DEBUG("Can't find the dynamic symbol table");
+    return make_error_code(lief_errors::not_found);
+  }
+
+  oat_layout_t layout;
+  for (size_t i = 0; i < std::min(nb_symbols, MAX_DYNSYM); ++i) {
+    auto sym = stream.peek_conv<Elf_Sym>(symtab_offset + i * sizeof(Elf_Sym));
+    if (!sym) {
+      break;
+    }
+    if (sym->st_name == 0 || (strtab_size > 0 && sym->st_name >= strtab_size)) {
+      continue;
+    }
+    auto name = stream.peek_string_at(strtab_offset + sym->st_name, /*maxsize=*/16);
+    if (!name) {
+      continue;
+    }
+    oat_layout_t::symbol_t* target = nullptr;
+    if (*name == "oatdata") {
+      target = &layout.oatdata;
+    } else if (*name == "oatexec") {
+      target = &layout.oatexec;
+    } else if (*name == "oatlastword") {
+      target = &layout.oatlastword;
+    }
+    if (target == nullptr) {
+      continue;
+    }
+    target->address = sym->st_value;
+    target->size    = sym->st_size;
+    if (auto offset = va2offset(loads, sym->st_value)) {
+      target->offset = *offset;
+      target->found  = true;
+    }
+  }
+
+  if (!layout.oatdata.found) {
+    return make_error_code(lief_errors::not_found);
+  }
+  return layout;
+}
+}
+
+result<oat_layout_t> locate(BinaryStream& stream) {
+  static constexpr std::array<uint8_t, 4> ELF_MAGIC = {0x7f, 'E', 'L', 'F'};
+  auto ident = stream.peek<ELF::Header::identity_t>(0);
+  if (!ident || !std::equal(ELF_MAGIC.begin(), ELF_MAGIC.end(), ident->begin())) {
+    return make_error_code(lief_errors::file_format_error);
+  }
+
+  const auto elf_class = static_cast<ELF::Header::CLASS>((*ident)[ELF::Header::ELI_CLASS]);
+  const auto elf_data  = static_cast<ELF::Header::ELF_DATA>((*ident)[ELF::Header::ELI_DATA]);
+
+  const bool should_swap = stream.should_swap();
+  stream.set_endian_swap((elf_data == ELF::Header::ELF_DATA::MSB) != is_host_big_endian());
+
+  result<oat_layout_t> layout = make_error_code(lief_errors::file_format_error);
+  if (elf_class == ELF::Header::CLASS::ELF32) {
+    layout = locate_impl<LIEF::ELF::details::ELF32>(stream);
+  } else if (elf_class == ELF::Header::CLASS::ELF64) {
+    layout = locate_impl<LIEF::ELF::details::ELF64>(stream);
+  }
+  stream.set_endian_swap(should_swap);
+  return layout;
+}
+
+result<uint32_t> version(BinaryStream& stream, const oat_layout_t& layout) {
+  using header_t = std::array<char, sizeof(oat_magic) + sizeof(OAT_064::oat_header::oat_version)>;
+  auto header = stream.peek<header_t>(layout.oatdata.offset);
+  if (!header) {
+    return make_error_code(lief_errors::read_error);
+  }
+  if (!std::equal(std::begin(oat_magic), std::end(oat_magic), header->begin())) {
+    return make_error_code(lief_errors::file_format_error);
+  }
+  // "oat\n" followed by the version as 3 ASCII digits
+  const std::string version(header->data() + sizeof(oat_magic), 3);
+  return static_cast<uint32_t>(std::strtoul(version.c_str(), nullptr, 10));
+}
+
+}
+}
+}
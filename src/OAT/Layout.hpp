@@ -0,0 +1,52 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_OAT_LAYOUT_H
+#define LIEF_OAT_LAYOUT_H
+#include <cstdint>
+
+#include "LIEF/errors.hpp"
+
+namespace LIEF {
+class BinaryStream;
+namespace OAT {
+namespace details {
+
+//! Location of the OAT data in the ELF container, resolved from the
+//! program headers and the dynamic symbol table only (i.e. without parsing
+//! the whole ELF file)
+struct oat_layout_t {
+  struct symbol_t {
+    uint64_t address = 0;
+    uint64_t size = 0;
+    uint64_t offset = 0; ///< File offset of the symbol's address
+    bool found = false;
+  };
+
+  symbol_t oatdata;
+  symbol_t oatexec;
+  symbol_t oatlastword;
+};
+
+//! Resolve the ``oatdata``, ``oatexec`` and ``oatlastword`` symbols
+result<oat_layout_t> locate(BinaryStream& stream);
+
+//! Read the version of the OAT header located by ``locate()``
+result<uint32_t> version(BinaryStream& stream, const oat_layout_t& layout);
+
+}
+}
+}
+#endif
@@ -37,16 +37,7 @@ Parser::Parser()  = default;
 
 
 std::unique_ptr<Binary> Parser::parse(const std::string& oat_file) {
-  if (!is_oat(oat_file)) {
-    LIEF_ERR("{} is not an OAT", oat_file);
-    return nullptr;
-  }
-
-  Parser parser{oat_file};
-  parser.init();
-
-  std::unique_ptr<Binary> oat_binary{static_cast<Binary*>(parser.binary_.release())};
-  return oat_binary;
+  return parse(oat_file, ELF::ParserConfig::all());
 }
 
 
@@ -72,25 +63,55 @@ std::unique_ptr<Binary> Parser::parse(const std::string& oat_file, const std::st
 }
 
 std::unique_ptr<Binary> Parser::parse(std::vector<uint8_t> data) {
-  Parser parser{std::move(data)};
+  return parse(std::move(data), ELF::ParserConfig::all());
+}
+
+std::unique_ptr<Binary> Parser::parse(const std::string& oat_file,
+                                      const ELF::ParserConfig& conf)
+{
+  if (!is_oat(oat_file)) {
+    LIEF_ERR("{} is not an OAT", oat_file);
+    return nullptr;
+  }
+
+  Parser parser{oat_file, conf};
   parser.init();
   std::unique_ptr<Binary> oat_binary{static_cast<Binary*>(parser.binary_.release())};
   return oat_binary;
 }
 
+std::unique_ptr<Binary> Parser::parse(std::vector<uint8_t> data,
+                                      const ELF::ParserConfig& conf)
+{
+  Parser parser{std::move(data), conf};
+  parser.init();
+  std::unique_ptr<Binary> oat_binary{static_cast<Binary*>(parser.binary_.release())};
+  return oat_binary;
+}
+
+ELF::ParserConfig Parser::light_config() {
+  ELF::ParserConfig conf;
+  conf.parse_relocations     = false;
+  conf.parse_symtab_symbols  = false;
+  conf.parse_symbol_versions = false;
+  conf.parse_notes           = false;
+  conf.parse_overlay         = false;
+  conf.count_mtd = ELF::ParserConfig::DYNSYM_COUNT::AUTO;
+  return conf;
+}
 
-Parser::Parser(std::vector<uint8_t> data) {
+Parser::Parser(std::vector<uint8_t> data, const ELF::ParserConfig& conf) {
   stream_    = std::make_unique<VectorStream>(std::move(data));
   binary_    = std::unique_ptr<Binary>(new Binary{});
-  config_.count_mtd = ELF::ParserConfig::DYNSYM_COUNT::AUTO;
+  config_    = conf;
 }
 
-Parser::Parser(const std::string& file) {
+Parser::Parser(const std::string& file, const ELF::ParserConfig& conf) {
   if (auto s = VectorStream::from_file(file)) {
     stream_ = std::make_unique<VectorStream>(std::move(*s));
   }
   binary_    = std::unique_ptr<Binary>(new Binary{});
-  config_.count_mtd = ELF::ParserConfig::DYNSYM_COUNT::AUTO;
+  config_    = conf;
 }
 
 
@@ -16,33 +16,34 @@
  */
 #include <string>
 #include "OAT/Structures.hpp"
+#include "OAT/Layout.hpp"
 #include "LIEF/OAT/utils.hpp"
 #include "LIEF/ELF/Binary.hpp"
 #include "LIEF/ELF/Parser.hpp"
 #include "LIEF/ELF/Symbol.hpp"
 #include "LIEF/ELF/utils.hpp"
+#include "LIEF/BinaryStream/FileStream.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
 #include "frozen.hpp"
 
 namespace LIEF {
 namespace OAT {
 
 bool is_oat(const std::string& file) {
-  if (!ELF::is_elf(file)) {
+  // Only the program headers and the dynamic symbols are read
+  auto stream = FileStream::from_file(file);
+  if (!stream) {
     return false;
   }
-
-  if (const auto elf_binary = ELF::Parser::parse(file)) {
-    return is_oat(*elf_binary);
-  }
-  return false;
+  auto layout = details::locate(*stream);
+  return layout && details::version(*stream, *layout);
 }
 
 
 bool is_oat(const std::vector<uint8_t>& raw) {
-  if (const auto elf_binary = ELF::Parser::parse(raw)) {
-    return is_oat(*elf_binary);
-  }
-  return false;
+  SpanStream stream(raw);
+  auto layout = details::locate(stream);
+  return layout && details::version(stream, *layout);
 }
 
 bool is_oat(const ELF::Binary& elf) {
@@ -57,25 +58,24 @@ bool is_oat(const ELF::Binary& elf) {
 }
 
 oat_version_t version(const std::string& file) {
-  if (!is_oat(file)) {
+  auto stream = FileStream::from_file(file);
+  if (!stream) {
     return 0;
   }
-
-  if (const auto elf = ELF::Parser::parse(file)) {
-    return version(*elf);
+  auto layout = details::locate(*stream);
+  if (!layout) {
+    return 0;
   }
-  return 0;
+  return details::version(*stream, *layout).value_or(0);
 }
 
 oat_version_t version(const std::vector<uint8_t>& raw) {
-  if (!is_oat(raw)) {
+  SpanStream stream(raw);
+  auto layout = details::locate(stream);
+  if (!layout) {
     return 0;
   }
-
-  if (const auto elf = ELF::Parser::parse(raw)) {
-    return version(*elf);
-  }
-  return 0;
+  return details::version(stream, *layout).value_or(0);
 }
 
 
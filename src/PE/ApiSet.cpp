@@ -0,0 +1,412 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include "logging.hpp"
+
+#include "LIEF/utils.hpp"
+#include "LIEF/PE/ApiSet.hpp"
+#include "LIEF/PE/Binary.hpp"
+#include "LIEF/PE/Section.hpp"
+
+namespace LIEF {
+namespace PE {
+
+static constexpr uint32_t MAX_ENTRIES = 0x100000;
+static constexpr uint32_t SEALED = 1;
+
+// Layouts of the API set namespace. All the offsets are relative to the
+// beginning of the namespace and the names are UTF-16 strings.
+namespace details {
+struct apiset_v6_namespace {
+  uint32_t Version;
+  uint32_t Size;
+  uint32_t Flags;
+  uint32_t Count;
+  uint32_t EntryOffset;
+  uint32_t HashOffset;
+  uint32_t HashFactor;
+};
+
+struct apiset_v6_entry {
+  uint32_t Flags;
+  uint32_t NameOffset;
+  uint32_t NameLength;
+  uint32_t HashedLength;
+  uint32_t ValueOffset;
+  uint32_t ValueCount;
+};
+
+struct apiset_value_entry {
+  uint32_t Flags;
+  uint32_t NameOffset;
+  uint32_t NameLength;
+  uint32_t ValueOffset;
+  uint32_t ValueLength;
+};
+
+struct apiset_v4_namespace {
+  uint32_t Version;
+  uint32_t Size;
+  uint32_t Flags;
+  uint32_t Count;
+};
+
+struct apiset_v4_entry {
+  uint32_t Flags;
+  uint32_t NameOffset;
+  uint32_t NameLength;
+  uint32_t AliasOffset;
+  uint32_t AliasLength;
+  uint32_t DataOffset;
+};
+
+struct apiset_v4_value_array {
+  uint32_t Flags;
+  uint32_t Count;
+};
+
+struct apiset_v2_namespace {
+  uint32_t Version;
+  uint32_t Count;
+};
+
+struct apiset_v2_entry {
+  uint32_t NameOffset;
+  uint32_t NameLength;
+  uint32_t DataOffset;
+};
+
+struct apiset_v2_value_entry {
+  uint32_t NameOffset;
+  uint32_t NameLength;
+  uint32_t ValueOffset;
+  uint32_t ValueLength;
+};
+}
+
+template<class T>
+inline result<T> read_struct(span<const uint8_t> raw, uint64_t offset) {
+  if (offset + sizeof(T) > raw.size()) {
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  T value;
+  memcpy(&value, raw.data() + offset, sizeof(T));
+  return value;
+}
+
+inline std::string to_lower(std::string str) {
+  std::transform(str.begin(), str.end(), str.begin(),
+                 [] (unsigned char c) { return std::tolower(c); });
+  return str;
+}
+
+//! Lower-case module name without the ``.dll`` suffix
+inline std::string normalize(const std::string& name) {
+  std::string norm = to_lower(name);
+  if (norm.size() > 4 && norm.compare(norm.size() - 4, 4, ".dll") == 0) {
+    norm.resize(norm.size() - 4);
+  }
+  return norm;
+}
+
+inline bool has_contract_prefix(const std::string& name) {
+  return name.compare(0, 4, "api-") == 0 || name.compare(0, 4, "ext-") == 0;
+}
+
+inline result<std::string> read_u16(span<const uint8_t> raw, uint32_t offset, uint32_t size) {
+  if (uint64_t(offset) + size > raw.size() || size % sizeof(char16_t) != 0) {
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  std::u16string str(size / sizeof(char16_t), 0);
+  memcpy(str.data(), raw.data() + offset, size);
+  return to_lower(u16tou8(str));
+}
+
+result<ApiSet> ApiSet::parse(const Binary& apisetschema) {
+  const Section* section = apisetschema.get_section(".apiset");
+  if (section == nullptr) {
+    LIEF_ERR("Can't find the '.apiset' section");
+    return make_error_code(lief_errors::not_found);
+  }
+  return parse(section->content());
+}
+
+result<ApiSet> ApiSet::parse(span<const uint8_t> raw) {
+  auto version = read_struct<uint32_t>(raw, 0);
+  if (!version) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  ApiSet apiset;
+  apiset.version_ = *version;
+
+  ok_error_t is_ok = ok();
+  switch (apiset.version_) {
+    case 2: is_ok = apiset.parse_v2(raw); break;
+    case 4: is_ok = apiset.parse_v4(raw); break;
+    case 6: is_ok = apiset.parse_v6(raw); break;
+    default:
+      {
+        LIEF_ERR("API set schema version {} is not supported", apiset.version_);
+        return make_error_code(lief_errors::not_supported);
+      }
+  }
+
+  if (!is_ok) {
+    return make_error_code(get_error(is_ok));
+  }
+  return apiset;
+}
+
+ok_error_t ApiSet::parse_v6(span<const uint8_t> raw) {
+  auto hdr = read_struct<details::apiset_v6_namespace>(raw, 0);
+  if (!hdr) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  if (hdr->Count > MAX_ENTRIES) {
+    LIEF_ERR("Too many API set entries: {}", hdr->Count);
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  entries_.reserve(std::min<size_t>(hdr->Count, raw.size() / sizeof(details::apiset_v6_entry)));
+  for (uint32_t i = 0; i < hdr->Count; ++i) {
+    const uint64_t offset = hdr->EntryOffset + uint64_t(i) * sizeof(details::apiset_v6_entry);
+    auto raw_entry = read_struct<details::apiset_v6_entry>(raw, offset);
+    if (!raw_entry) {
+      LIEF_ERR("Can't read the API set entry #{}", i);
+      return make_error_code(lief_errors::read_error);
+    }
+
+    auto name = read_u16(raw, raw_entry->NameOffset, raw_entry->NameLength);
+    if (!name) {
+      LIEF_WARN("Can't read the name of the API set entry #{}", i);
+      continue;
+    }
+
+    entry_t entry;
+    entry.name = std::move(*name);
+    entry.is_sealed = raw_entry->Flags & SEALED;
+
+    if (raw_entry->ValueCount > MAX_ENTRIES) {
+      LIEF_WARN("Too many values for {}", entry.name);
+      continue;
+    }
+
+    for (uint32_t j = 0; j < raw_entry->ValueCount; ++j) {
+      const uint64_t voffset = raw_entry->ValueOffset + uint64_t(j) * sizeof(details::apiset_value_entry);
+      auto raw_value = read_struct<details::apiset_value_entry>(raw, voffset);
+      if (!raw_value) {
+        break;
+      }
+      auto importer = read_u16(raw, raw_value->NameOffset, raw_value->NameLength);
+      auto host = read_u16(raw, raw_value->ValueOffset, raw_value->ValueLength);
+      if (!importer || !host) {
+        continue;
+      }
+      entry.values.push_back({std::move(*importer), std::move(*host)});
+    }
+
+    // The hashed part of the name excludes the version of the contract
+    // (e.g. api-ms-win-core-file-l1-2 for api-ms-win-core-file-l1-2-4)
+    const size_t hashed_size = std::min<size_t>(entry.name.size(),
+                                                raw_entry->HashedLength / sizeof(char16_t));
+    index_[entry.name.substr(0, hashed_size)] = entries_.size();
+    entries_.push_back(std::move(entry));
+  }
+  return ok();
+}
+
+ok_error_t ApiSet::parse_v4(span<const uint8_t> raw) {
+  auto hdr = read_struct<details::apiset_v4_namespace>(raw, 0);
+  if (!hdr) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  if (hdr->Count > MAX_ENTRIES) {
+    LIEF_ERR("Too many API set entries: {}", hdr->Count);
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  entries_.reserve(std::min<size_t>(hdr->Count, raw.size() / sizeof(details::apiset_v4_entry)));
+  for (uint32_t i = 0; i < hdr->Count; ++i) {
+    const uint64_t offset = sizeof(details::apiset_v4_namespace) +
+                            uint64_t(i) * sizeof(details::apiset_v4_entry);
+    auto raw_entry = read_struct<details::apiset_v4_entry>(raw, offset);
+    if (!raw_entry) {
+      LIEF_ERR("Can't read the API set entry #{}", i);
+      return make_error_code(lief_errors::read_error);
+    }
+
+    auto name = read_u16(raw, raw_entry->NameOffset, raw_entry->NameLength);
+    if (!name) {
+      LIEF_WARN("Can't read the name of the API set entry #{}", i);
+      continue;
+    }
+
+    entry_t entry;
+    entry.name = std::move(*name);
+    entry.is_sealed = raw_entry->Flags & SEALED;
+
+    auto values = read_struct<details::apiset_v4_value_array>(raw, raw_entry->DataOffset);
+    if (values && values->Count <= MAX_ENTRIES) {
+      for (uint32_t j = 0; j < values->Count; ++j) {
+        const uint64_t voffset = raw_entry->DataOffset + sizeof(details::apiset_v4_value_array) +
+                                 uint64_t(j) * sizeof(details::apiset_value_entry);
+        auto raw_value = read_struct<details::apiset_value_entry>(raw, voffset);
+        if (!raw_value) {
+          break;
+        }
+        auto importer = read_u16(raw, raw_value->NameOffset, raw_value->NameLength);
+        auto host = read_u16(raw, raw_value->ValueOffset, raw_value->ValueLength);
+        if (!importer || !host) {
+          continue;
+        }
+        entry.values.push_back({std::move(*importer), std::move(*host)});
+      }
+    }
+
+    index_[key(entry.name)] = entries_.size();
+    entries_.push_back(std::move(entry));
+  }
+  return ok();
+}
+
+ok_error_t ApiSet::parse_v2(span<const uint8_t> raw) {
+  auto hdr = read_struct<details::apiset_v2_namespace>(raw, 0);
+  if (!hdr) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  if (hdr->Count > MAX_ENTRIES) {
+    LIEF_ERR("Too many API set entries: {}", hdr->Count);
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  entries_.reserve(std::min<size_t>(hdr->Count, raw.size() / sizeof(details::apiset_v2_entry)));
+  for (uint32_t i = 0; i < hdr->Count; ++i) {
+    const uint64_t offset = sizeof(details::apiset_v2_namespace) +
+                            uint64_t(i) * sizeof(details::apiset_v2_entry);
+    auto raw_entry = read_struct<details::apiset_v2_entry>(raw, offset);
+    if (!raw_entry) {
+      LIEF_ERR("Can't read the API set entry #{}", i);
+      return make_error_code(lief_errors::read_error);
+    }
+
+    auto name = read_u16(raw, raw_entry->NameOffset, raw_entry->NameLength);
+    if (!name) {
+      LIEF_WARN("Can't read the name of the API set entry #{}", i);
+      continue;
+    }
+
+    entry_t entry;
+    entry.name = std::move(*name);
+
+    auto count = read_struct<uint32_t>(raw, raw_entry->DataOffset);
+    if (count && *count <= MAX_ENTRIES) {
+      for (uint32_t j = 0; j < *count; ++j) {
+        const uint64_t voffset = raw_entry->DataOffset + sizeof(uint32_t) +
+                                 uint64_t(j) * sizeof(details::apiset_v2_value_entry);
+        auto raw_value = read_struct<details::apiset_v2_value_entry>(raw, voffset);
+        if (!raw_value) {
+          break;
+        }
+        auto importer = read_u16(raw, raw_value->NameOffset, raw_value->NameLength);
+        auto host = read_u16(raw, raw_value->ValueOffset, raw_value->ValueLength);
+        if (!importer || !host) {
+          continue;
+        }
+        entry.values.push_back({std::move(*importer), std::move(*host)});
+      }
+    }
+
+    index_[key(entry.name)] = entries_.size();
+    entries_.push_back(std::move(entry));
+  }
+  return ok();
+}
+
+std::string ApiSet::key(const std::string& name) const {
+  std::string norm = normalize(name);
+  if (version_ >= 6) {
+    // Only the prefix (without the version of the contract) is hashed
+    if (size_t pos = norm.rfind('-'); pos != std::string::npos) {
+      norm.resize(pos);
+    }
+    return norm;
+  }
+
+  // Prior to v6, the names are stored without the api-/ext- prefix
+  if (has_contract_prefix(norm)) {
+    norm.erase(0, 4);
+  }
+  return norm;
+}
+
+bool ApiSet::is_api_set(const std::string& name) {
+  return has_contract_prefix(to_lower(name.substr(0, 4)));
+}
+
+const ApiSet::entry_t* ApiSet::find(const std::string& name) const {
+  if (!is_api_set(name)) {
+    return nullptr;
+  }
+  auto it = index_.find(key(name));
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  return &entries_[it->second];
+}
+
+result<std::string> ApiSet::resolve(const std::string& name,
+                                    const std::string& importer) const
+{
+  const entry_t* entry = find(name);
+  if (entry == nullptr || entry->values.empty()) {
+    return make_error_code(lief_errors::not_found);
+  }
+
+  // Default host (the first one if there is no importer-agnostic value)
+  const value_t* host = &entry->values[0];
+  for (const value_t& value : entry->values) {
+    if (value.importer.empty()) {
+      host = &value;
+      break;
+    }
+  }
+
+  // Some contracts are redirected for a specific importer
+  if (!importer.empty()) {
+    const std::string importer_norm = normalize(importer);
+    for (const value_t& value : entry->values) {
+      if (!value.importer.empty() && normalize(value.importer) == importer_norm) {
+        host = &value;
+        break;
+      }
+    }
+  }
+
+  if (host->host.empty()) {
+    return make_error_code(lief_errors::not_found);
+  }
+  return host->host;
+}
+
+}
+}
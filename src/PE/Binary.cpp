@@ -48,6 +48,8 @@
 #include "LIEF/PE/RichEntry.hpp"
 #include "LIEF/PE/Section.hpp"
 #include "LIEF/PE/Symbol.hpp"
+#include "LIEF/Abstract/Symbolizer.hpp"
+#include "LIEF/Abstract/GoPclntab.hpp"
 #include "LIEF/PE/TLS.hpp"
 #include "LIEF/PE/utils.hpp"
 
@@ -57,6 +59,7 @@
 #include "PE/checksum.hpp"
 
 #include "frozen.hpp"
+#include "parallel.hpp"
 
 namespace LIEF {
 namespace PE {
@@ -853,23 +856,9 @@ uint32_t Binary::compute_checksum() const {
   return cs.finalize();
 }
 
-std::vector<uint8_t> Binary::authentihash(ALGORITHMS algo) const {
-  static const std::map<ALGORITHMS, hashstream::HASH> HMAP = {
-    {ALGORITHMS::MD5,     hashstream::HASH::MD5},
-    {ALGORITHMS::SHA_1,   hashstream::HASH::SHA1},
-    {ALGORITHMS::SHA_256, hashstream::HASH::SHA256},
-    {ALGORITHMS::SHA_384, hashstream::HASH::SHA384},
-    {ALGORITHMS::SHA_512, hashstream::HASH::SHA512},
-  };
-  auto it_hash = HMAP.find(algo);
-  if (it_hash == std::end(HMAP)) {
-    LIEF_WARN("Unsupported hash algorithm: {}", to_string(algo));
-    return {};
-  }
+std::vector<uint8_t> Binary::authenticode_headers() const {
   const size_t sizeof_ptr = type_ == PE_TYPE::PE32 ? sizeof(uint32_t) : sizeof(uint64_t);
-  const hashstream::HASH hash_type = it_hash->second;
-  hashstream ios(hash_type);
-  //vector_iostream ios;
+  vector_iostream ios;
   ios // Hash dos header
     .write(dos_header_.magic())
     .write(dos_header_.used_bytes_in_last_page())
@@ -964,9 +953,30 @@ std::vector<uint8_t> Binary::authentihash(ALGORITHMS algo) const {
       .write(sec->numberof_line_numbers())
       .write(static_cast<uint32_t>(sec->characteristics()));
   }
-  //LIEF_DEBUG("Section padding at 0x{:x}", ios.tellp());
   ios.write(section_offset_padding_);
 
+  std::vector<uint8_t> raw;
+  ios.move(raw);
+  return raw;
+}
+
+std::vector<uint8_t> Binary::authentihash(ALGORITHMS algo) const {
+  static const std::map<ALGORITHMS, hashstream::HASH> HMAP = {
+    {ALGORITHMS::MD5,     hashstream::HASH::MD5},
+    {ALGORITHMS::SHA_1,   hashstream::HASH::SHA1},
+    {ALGORITHMS::SHA_256, hashstream::HASH::SHA256},
+    {ALGORITHMS::SHA_384, hashstream::HASH::SHA384},
+    {ALGORITHMS::SHA_512, hashstream::HASH::SHA512},
+  };
+  auto it_hash = HMAP.find(algo);
+  if (it_hash == std::end(HMAP)) {
+    LIEF_WARN("Unsupported hash algorithm: {}", to_string(algo));
+    return {};
+  }
+  const hashstream::HASH hash_type = it_hash->second;
+  hashstream ios(hash_type);
+  ios.write(authenticode_headers());
+
   std::vector<Section*> sections;
   sections.reserve(sections_.size());
   std::transform(std::begin(sections_), std::end(sections_),
@@ -1052,6 +1062,157 @@ std::vector<uint8_t> Binary::authentihash(ALGORITHMS algo) const {
   return hash;
 }
 
+result<std::vector<uint8_t>> Binary::page_hash(uint32_t offset, ALGORITHMS algo) const {
+  hashstream::HASH hash_type = hashstream::HASH::SHA256;
+  if (algo == ALGORITHMS::SHA_1) {
+    hash_type = hashstream::HASH::SHA1;
+  } else if (algo != ALGORITHMS::SHA_256) {
+    LIEF_WARN("Unsupported page hash algorithm: {}", to_string(algo));
+    return make_error_code(lief_errors::not_supported);
+  }
+
+  const uint32_t page_size = optional_header_.section_alignment();
+  if (page_size == 0) {
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  hashstream ios(hash_type);
+  if (offset == 0) {
+    // The checksum (4 bytes) and the certificate table's entry (8 bytes)
+    // are skipped but the page is still padded from SizeOfHeaders.
+    static constexpr uint32_t SKIPPED_SIZE = sizeof(uint32_t) + 2 * sizeof(uint32_t);
+    const uint32_t sizeof_headers = optional_header_.sizeof_headers();
+    std::vector<uint8_t> headers = authenticode_headers();
+    headers.resize(sizeof_headers > SKIPPED_SIZE ? sizeof_headers - SKIPPED_SIZE : 0, 0);
+    ios.write(headers);
+    if (sizeof_headers < page_size) {
+      ios.write(page_size - sizeof_headers, 0);
+    }
+    return ios.raw();
+  }
+
+  const auto it_section = std::find_if(sections_.begin(), sections_.end(),
+    [offset] (const std::unique_ptr<Section>& sec) {
+      return sec->pointerto_raw_data() <= offset &&
+             offset < uint64_t(sec->pointerto_raw_data()) + sec->sizeof_raw_data();
+    });
+
+  if (it_section == sections_.end()) {
+    LIEF_DEBUG("No section at offset 0x{:x}", offset);
+    return make_error_code(lief_errors::not_found);
+  }
+
+  const Section& section = **it_section;
+  const uint32_t delta = offset - section.pointerto_raw_data();
+  const uint32_t size = std::min(page_size, section.sizeof_raw_data() - delta);
+  span<const uint8_t> content = section.content();
+  span<const uint8_t> chunk;
+  if (delta < content.size()) {
+    chunk = content.subspan(delta, std::min<size_t>(size, content.size() - delta));
+  }
+  ios
+    .write(chunk)
+    .write(page_size - chunk.size(), 0);
+  return ios.raw();
+}
+
+static const SpcIndirectData* get_page_hashes(const Signature& sig) {
+  const ContentInfo::Content& content = sig.content_info().value();
+  if (!SpcIndirectData::classof(&content)) {
+    LIEF_INFO("Expecting SpcIndirectData");
+    return nullptr;
+  }
+  const auto& spc_indirect_data = static_cast<const SpcIndirectData&>(content);
+  if (spc_indirect_data.page_hashes().empty()) {
+    LIEF_INFO("The signature does not embed page hashes");
+    return nullptr;
+  }
+  return &spc_indirect_data;
+}
+
+result<bool> Binary::verify_page(uint64_t rva) const {
+  if (signatures_.empty()) {
+    return make_error_code(lief_errors::not_found);
+  }
+  return verify_page(rva, signatures_[0]);
+}
+
+result<bool> Binary::verify_page(uint64_t rva, const Signature& sig) const {
+  const SpcIndirectData* spc_indirect_data = get_page_hashes(sig);
+  if (spc_indirect_data == nullptr) {
+    return make_error_code(lief_errors::not_found);
+  }
+
+  uint64_t offset = 0;
+  if (rva >= optional_header_.sizeof_headers()) {
+    const Section* section = section_from_rva(rva);
+    if (section == nullptr) {
+      return make_error_code(lief_errors::not_found);
+    }
+    const uint64_t delta = rva - section->virtual_address();
+    if (delta >= section->sizeof_raw_data()) {
+      LIEF_DEBUG("RVA 0x{:x} is not backed by the file", rva);
+      return make_error_code(lief_errors::not_found);
+    }
+    offset = section->pointerto_raw_data() + delta;
+  }
+
+  // The entries are sorted by offset and the last one marks the end of the
+  // hashed data
+  const SpcIndirectData::page_hashes_t& hashes = spc_indirect_data->page_hashes();
+  const auto it = std::upper_bound(hashes.begin(), hashes.end(), offset,
+    [] (uint64_t offset, const SpcIndirectData::page_hash_t& entry) {
+      return offset < entry.offset;
+    });
+
+  if (it == hashes.begin() || it == hashes.end()) {
+    return make_error_code(lief_errors::not_found);
+  }
+
+  const SpcIndirectData::page_hash_t& entry = *std::prev(it);
+  auto hash = page_hash(entry.offset, spc_indirect_data->page_hash_algorithm());
+  if (!hash) {
+    return make_error_code(get_error(hash));
+  }
+  return *hash == entry.digest;
+}
+
+result<std::vector<uint32_t>> Binary::verify_pages(uint32_t nb_threads) const {
+  if (signatures_.empty()) {
+    return make_error_code(lief_errors::not_found);
+  }
+  return verify_pages(signatures_[0], nb_threads);
+}
+
+result<std::vector<uint32_t>> Binary::verify_pages(const Signature& sig,
+                                                   uint32_t nb_threads) const {
+  const SpcIndirectData* spc_indirect_data = get_page_hashes(sig);
+  if (spc_indirect_data == nullptr) {
+    return make_error_code(lief_errors::not_found);
+  }
+
+  const SpcIndirectData::page_hashes_t& hashes = spc_indirect_data->page_hashes();
+  const ALGORITHMS algo = spc_indirect_data->page_hash_algorithm();
+
+  // The last entry only marks the end of the hashed data
+  const size_t nb_pages = hashes.size() - 1;
+  std::vector<uint8_t> valid(nb_pages, 0);
+  parallel_for(nb_pages, nb_threads, [&] (size_t i) {
+    const SpcIndirectData::page_hash_t& entry = hashes[i];
+    auto hash = page_hash(entry.offset, algo);
+    valid[i] = hash && *hash == entry.digest;
+  });
+
+  std::vector<uint32_t> mismatches;
+  for (size_t i = 0; i < nb_pages; ++i) {
+    if (!valid[i]) {
+      LIEF_DEBUG("Page hash mismatch at offset 0x{:x}", hashes[i].offset);
+      mismatches.push_back(hashes[i].offset);
+    }
+  }
+  return mismatches;
+}
+
 Signature::VERIFICATION_FLAGS Binary::verify_signature(Signature::VERIFICATION_CHECKS checks) const {
   if (!has_signatures()) {
     return Signature::VERIFICATION_FLAGS::NO_SIGNATURE;
@@ -1404,6 +1565,16 @@ LIEF::Binary::functions_t Binary::functions() const {
   };
   std::set<Function, decltype(func_cmd)> functions_set(func_cmd);
 
+  // Inserted first so that the names of the Go functions are kept over
+  // the (unnamed) entries of the exception table
+  if (auto gopclntab = GoPclntab::from_binary(*this)) {
+    const uint64_t base = imagebase();
+    for (Function& func : gopclntab->functions()) {
+      func.address(func.address() - base);
+      functions_set.insert(std::move(func));
+    }
+  }
+
   LIEF::Binary::functions_t exception_functions = this->exception_functions();
   LIEF::Binary::functions_t exported            = get_abstract_exported_functions();
   LIEF::Binary::functions_t ctors               = ctor_functions();
@@ -1420,6 +1591,33 @@ LIEF::Binary::functions_t Binary::functions() const {
   return {std::begin(functions_set), std::end(functions_set)};
 }
 
+std::unique_ptr<Symbolizer> Binary::symbolizer() const {
+  auto sym = std::make_unique<Symbolizer>();
+  const uint64_t base = imagebase();
+
+  if (const Export* exp = get_export()) {
+    for (const ExportEntry& entry : exp->entries()) {
+      if (entry.is_forwarded() || entry.address() == 0) {
+        continue;
+      }
+      sym->add(base + entry.address(), 0, entry.name());
+    }
+  }
+
+  if (auto gopclntab = GoPclntab::from_binary(*this)) {
+    for (uint32_t i = 0; i < gopclntab->size(); ++i) {
+      const uint64_t entry = gopclntab->entry(i);
+      sym->add(entry, gopclntab->end(i) - entry, gopclntab->name(i));
+    }
+  }
+
+  for (const Function& f : exception_functions()) {
+    sym->add(base + f.address(), f.size(), "");
+  }
+  sym->finalize(base + virtual_size());
+  return sym;
+}
+
 LIEF::Binary::functions_t Binary::exception_functions() const {
   LIEF::Binary::functions_t functions;
   if (!has_exceptions()) {
@@ -0,0 +1,221 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+
+#include "logging.hpp"
+
+#include "LIEF/PE/ExportResolver.hpp"
+#include "LIEF/PE/Binary.hpp"
+#include "LIEF/PE/DataDirectory.hpp"
+#include "LIEF/PE/Section.hpp"
+
+#include "PE/Structures.hpp"
+
+namespace LIEF {
+namespace PE {
+
+static constexpr uint32_t NB_ENTRIES_LIMIT = 0x1000000;
+static constexpr size_t MAX_EXPORT_NAME_SIZE = 4096;
+
+template<class T>
+inline T read_at(span<const uint8_t> table, uint32_t idx) {
+  T value = 0;
+  memcpy(&value, table.data() + idx * sizeof(T), sizeof(T));
+  return value;
+}
+
+//! Null-terminated string at the beginning of the given span
+inline span<const uint8_t> cstring(span<const uint8_t> data, size_t max_size) {
+  const size_t size = std::min(data.size(), max_size);
+  const void* end = memchr(data.data(), 0, size);
+  if (end == nullptr) {
+    return {};
+  }
+  return data.subspan(0, static_cast<const uint8_t*>(end) - data.data());
+}
+
+inline int compare(span<const uint8_t> lhs, const std::string& rhs) {
+  const size_t size = std::min<size_t>(lhs.size(), rhs.size());
+  if (int ret = memcmp(lhs.data(), rhs.data(), size); ret != 0) {
+    return ret;
+  }
+  if (lhs.size() == rhs.size()) {
+    return 0;
+  }
+  return lhs.size() < rhs.size() ? -1 : 1;
+}
+
+result<ExportResolver> ExportResolver::from_binary(const Binary& bin) {
+  const DataDirectory* dir = bin.data_directory(DataDirectory::TYPES::EXPORT_TABLE);
+  if (dir == nullptr || dir->RVA() == 0 || dir->size() == 0) {
+    return make_error_code(lief_errors::not_found);
+  }
+
+  ExportResolver resolver;
+  resolver.bin_ = &bin;
+  resolver.dir_start_ = dir->RVA();
+  resolver.dir_end_   = uint64_t(dir->RVA()) + dir->size();
+
+  span<const uint8_t> raw_dir = resolver.content_at(dir->RVA());
+  if (raw_dir.size() < sizeof(details::pe_export_directory_table)) {
+    LIEF_WARN("Can't read the export table at RVA: 0x{:x}", dir->RVA());
+    return make_error_code(lief_errors::read_error);
+  }
+
+  details::pe_export_directory_table hdr;
+  memcpy(&hdr, raw_dir.data(), sizeof(hdr));
+
+  if (hdr.AddressTableEntries > NB_ENTRIES_LIMIT ||
+      hdr.NumberOfNamePointers > NB_ENTRIES_LIMIT)
+  {
+    LIEF_WARN("The export directory is corrupted (#functions: {}, #names: {})",
+              hdr.AddressTableEntries, hdr.NumberOfNamePointers);
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  resolver.nb_functions_ = hdr.AddressTableEntries;
+  resolver.nb_names_     = hdr.NumberOfNamePointers;
+  resolver.ordinal_base_ = hdr.OrdinalBase;
+
+  const auto get_table = [&resolver] (uint32_t rva, size_t size) -> span<const uint8_t> {
+    if (size == 0) {
+      return {};
+    }
+    span<const uint8_t> content = resolver.content_at(rva);
+    if (content.size() < size) {
+      return {};
+    }
+    return content.subspan(0, size);
+  };
+
+  resolver.address_table_ = get_table(hdr.ExportAddressTableRVA, resolver.nb_functions_ * sizeof(uint32_t));
+  resolver.name_table_    = get_table(hdr.NamePointerRVA,        resolver.nb_names_ * sizeof(uint32_t));
+  resolver.ordinal_table_ = get_table(hdr.OrdinalTableRVA,       resolver.nb_names_ * sizeof(uint16_t));
+
+  if (resolver.nb_functions_ > 0 && resolver.address_table_.empty()) {
+    LIEF_WARN("Can't access the export address table (RVA: 0x{:x})", hdr.ExportAddressTableRVA);
+    return make_error_code(lief_errors::read_error);
+  }
+
+  if (resolver.nb_names_ > 0 && (resolver.name_table_.empty() || resolver.ordinal_table_.empty())) {
+    LIEF_WARN("Can't access the export name/ordinal tables");
+    resolver.nb_names_ = 0;
+  }
+
+  span<const uint8_t> name = cstring(resolver.content_at(hdr.NameRVA), 255);
+  resolver.name_.assign(reinterpret_cast<const char*>(name.data()), name.size());
+  return resolver;
+}
+
+span<const uint8_t> ExportResolver::content_at(uint32_t rva) const {
+  const Section* section = bin_->section_from_rva(rva);
+  if (section == nullptr) {
+    return {};
+  }
+  span<const uint8_t> content = section->content();
+  const uint64_t offset = rva - section->virtual_address();
+  if (offset >= content.size()) {
+    return {};
+  }
+  return content.subspan(offset);
+}
+
+span<const uint8_t> ExportResolver::name_span(uint32_t idx) const {
+  const auto rva = read_at<uint32_t>(name_table_, idx);
+  return cstring(content_at(rva), MAX_EXPORT_NAME_SIZE);
+}
+
+result<std::string> ExportResolver::name_at(uint32_t idx) const {
+  if (idx >= nb_names_) {
+    return make_error_code(lief_errors::not_found);
+  }
+  span<const uint8_t> name = name_span(idx);
+  return std::string(reinterpret_cast<const char*>(name.data()), name.size());
+}
+
+result<ExportEntry> ExportResolver::make_entry(uint32_t idx) const {
+  if (idx >= nb_functions_) {
+    return make_error_code(lief_errors::not_found);
+  }
+  const auto rva = read_at<uint32_t>(address_table_, idx);
+  if (rva == 0) {
+    return make_error_code(lief_errors::not_found);
+  }
+  const bool is_extern = dir_start_ <= rva && rva < dir_end_;
+  ExportEntry entry{is_extern ? 0 : rva, is_extern,
+                    static_cast<uint16_t>(idx + ordinal_base_), rva};
+  if (!is_extern) {
+    return entry;
+  }
+
+  // Forwarded export: "LIBRARY.Function" or "LIBRARY.#ordinal"
+  span<const uint8_t> raw = cstring(content_at(rva), MAX_EXPORT_NAME_SIZE);
+  std::string fwd(reinterpret_cast<const char*>(raw.data()), raw.size());
+  const size_t dot_pos = fwd.find('.');
+  if (dot_pos == std::string::npos) {
+    entry.set_forward_info("", std::move(fwd));
+  } else {
+    entry.set_forward_info(fwd.substr(0, dot_pos), fwd.substr(dot_pos + 1));
+  }
+  return entry;
+}
+
+result<ExportEntry> ExportResolver::find(const std::string& name, uint32_t hint) const {
+  uint32_t name_idx = NO_HINT;
+  if (hint < nb_names_ && compare(name_span(hint), name) == 0) {
+    name_idx = hint;
+  } else {
+    // The name pointer table is lexically ordered (which enables the
+    // binary search performed by the Windows loader)
+    uint32_t lo = 0;
+    uint32_t hi = nb_names_;
+    while (lo < hi) {
+      const uint32_t mid = lo + (hi - lo) / 2;
+      const int cmp = compare(name_span(mid), name);
+      if (cmp == 0) {
+        name_idx = mid;
+        break;
+      }
+      if (cmp < 0) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+  }
+
+  if (name_idx == NO_HINT) {
+    return make_error_code(lief_errors::not_found);
+  }
+
+  const auto idx = read_at<uint16_t>(ordinal_table_, name_idx);
+  auto entry = make_entry(idx);
+  if (!entry) {
+    return make_error_code(get_error(entry));
+  }
+  entry->name(name);
+  return entry;
+}
+
+result<ExportEntry> ExportResolver::find_ordinal(uint32_t ordinal) const {
+  if (ordinal < ordinal_base_) {
+    return make_error_code(lief_errors::not_found);
+  }
+  return make_entry(ordinal - ordinal_base_);
+}
+
+}
+}
@@ -0,0 +1,289 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+
+#include "logging.hpp"
+
+#include "LIEF/PE/HeaderPatcher.hpp"
+#include "LIEF/PE/DosHeader.hpp"
+
+#include "PE/Structures.hpp"
+
+namespace LIEF {
+namespace PE {
+
+//! Fold a 32-bit sum into a 16-bit ones' complement sum
+inline uint32_t fold(uint32_t sum) {
+  while ((sum >> 16) != 0) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+  return sum;
+}
+
+HeaderPatcher::HeaderPatcher() = default;
+HeaderPatcher::HeaderPatcher(HeaderPatcher&&) noexcept = default;
+HeaderPatcher& HeaderPatcher::operator=(HeaderPatcher&&) noexcept = default;
+HeaderPatcher::~HeaderPatcher() = default;
+
+result<HeaderPatcher> HeaderPatcher::open(const std::string& path) {
+  auto file = std::make_unique<std::fstream>(path, std::ios::in | std::ios::out | std::ios::binary);
+  if (!file->is_open()) {
+    LIEF_ERR("Can't open '{}' (read/write)", path);
+    return make_error_code(lief_errors::file_error);
+  }
+  file->seekg(0, std::ios::end);
+  const std::streamoff size = file->tellg();
+  if (size < 0) {
+    return make_error_code(lief_errors::file_error);
+  }
+
+  HeaderPatcher patcher;
+  patcher.file_ = std::move(file);
+  patcher.size_ = static_cast<uint64_t>(size);
+  if (auto is_ok = patcher.init(); !is_ok) {
+    return make_error_code(get_error(is_ok));
+  }
+  return patcher;
+}
+
+result<HeaderPatcher> HeaderPatcher::from_buffer(span<uint8_t> buffer) {
+  HeaderPatcher patcher;
+  patcher.buffer_ = buffer;
+  patcher.size_ = buffer.size();
+  if (auto is_ok = patcher.init(); !is_ok) {
+    return make_error_code(get_error(is_ok));
+  }
+  return patcher;
+}
+
+ok_error_t HeaderPatcher::init() {
+  details::pe_dos_header dos_hdr;
+  if (!read(0, {reinterpret_cast<uint8_t*>(&dos_hdr), sizeof(dos_hdr)}) ||
+      dos_hdr.Magic != DosHeader::MAGIC)
+  {
+    LIEF_ERR("Wrong DOS magic");
+    return make_error_code(lief_errors::file_format_error);
+  }
+
+  header_offset_ = dos_hdr.AddressOfNewExeHeader;
+  details::pe_header hdr;
+  if (!read(header_offset_, {reinterpret_cast<uint8_t*>(&hdr), sizeof(hdr)}) ||
+      memcmp(hdr.signature, details::PE_Magic, sizeof(details::PE_Magic)) != 0)
+  {
+    LIEF_ERR("Wrong PE signature");
+    return make_error_code(lief_errors::file_format_error);
+  }
+
+  opt_header_offset_ = header_offset_ + sizeof(details::pe_header);
+  uint16_t magic = 0;
+  if (!read(opt_header_offset_, {reinterpret_cast<uint8_t*>(&magic), sizeof(magic)})) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  uint64_t nb_dirs_offset = 0;
+  if (magic == static_cast<uint16_t>(PE_TYPE::PE32)) {
+    type_ = PE_TYPE::PE32;
+    nb_dirs_offset = opt_header_offset_ + offsetof(details::pe32_optional_header, NumberOfRvaAndSize);
+    data_dirs_offset_ = opt_header_offset_ + sizeof(details::pe32_optional_header);
+  } else if (magic == static_cast<uint16_t>(PE_TYPE::PE32_PLUS)) {
+    type_ = PE_TYPE::PE32_PLUS;
+    nb_dirs_offset = opt_header_offset_ + offsetof(details::pe64_optional_header, NumberOfRvaAndSize);
+    data_dirs_offset_ = opt_header_offset_ + sizeof(details::pe64_optional_header);
+  } else {
+    LIEF_ERR("Unknown optional header magic: 0x{:04x}", magic);
+    return make_error_code(lief_errors::file_format_error);
+  }
+
+  if (!read(nb_dirs_offset, {reinterpret_cast<uint8_t*>(&nb_data_dirs_), sizeof(nb_data_dirs_)})) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  // CheckSum is at the same offset for PE32 and PE32+
+  const uint64_t checksum_offset = opt_header_offset_ + offsetof(details::pe32_optional_header, CheckSum);
+  if (!read(checksum_offset, {reinterpret_cast<uint8_t*>(&checksum_), sizeof(checksum_)})) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  // checksum = (16-bit ones' complement sum of the file) + file size
+  update_checksum_ = checksum_ != 0;
+  if (update_checksum_ && (checksum_ < size_ || checksum_ - size_ > 0xffff)) {
+    LIEF_WARN("The checksum (0x{:08x}) is not consistent with the file size. "
+              "It won't be updated", checksum_);
+    update_checksum_ = false;
+  }
+
+  const auto cert_idx = static_cast<uint32_t>(DataDirectory::TYPES::CERTIFICATE_TABLE);
+  if (cert_idx < nb_data_dirs_) {
+    details::pe_data_directory dir;
+    const uint64_t offset = data_dirs_offset_ + cert_idx * sizeof(details::pe_data_directory);
+    if (read(offset, {reinterpret_cast<uint8_t*>(&dir), sizeof(dir)})) {
+      // The RVA of the certificate table is a file offset
+      cert_offset_ = dir.RelativeVirtualAddress;
+      cert_size_   = dir.Size;
+    }
+  }
+  return ok();
+}
+
+ok_error_t HeaderPatcher::read(uint64_t offset, span<uint8_t> out) const {
+  if (offset > size_ || out.size() > size_ - offset) {
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  if (file_ == nullptr) {
+    memcpy(out.data(), buffer_.data() + offset, out.size());
+    return ok();
+  }
+  file_->seekg(static_cast<std::streamoff>(offset));
+  if (!file_->read(reinterpret_cast<char*>(out.data()), out.size())) {
+    file_->clear();
+    return make_error_code(lief_errors::read_error);
+  }
+  return ok();
+}
+
+ok_error_t HeaderPatcher::write(uint64_t offset, span<const uint8_t> data) {
+  if (offset > size_ || data.size() > size_ - offset) {
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+  if (file_ == nullptr) {
+    memcpy(buffer_.data() + offset, data.data(), data.size());
+    return ok();
+  }
+  file_->seekp(static_cast<std::streamoff>(offset));
+  if (!file_->write(reinterpret_cast<const char*>(data.data()), data.size())) {
+    file_->clear();
+    return make_error_code(lief_errors::file_error);
+  }
+  return ok();
+}
+
+bool HeaderPatcher::is_excluded_from_authentihash(uint64_t offset, uint64_t size) const {
+  const auto contains = [offset, size] (uint64_t start, uint64_t length) {
+    return start <= offset && offset + size <= start + length;
+  };
+  const uint64_t cert_dir_offset =
+    data_dirs_offset_ + static_cast<uint32_t>(DataDirectory::TYPES::CERTIFICATE_TABLE) *
+                        sizeof(details::pe_data_directory);
+  return contains(cert_dir_offset, sizeof(details::pe_data_directory)) ||
+         contains(cert_offset_, cert_size_);
+}
+
+ok_error_t HeaderPatcher::patch(uint64_t offset, span<const uint8_t> data) {
+  if (data.empty()) {
+    return ok();
+  }
+  if (offset > size_ || data.size() > size_ - offset) {
+    LIEF_ERR("Patch [0x{:x}, 0x{:x}] is out of the file", offset, offset + data.size());
+    return make_error_code(lief_errors::read_out_of_bound);
+  }
+
+  const uint64_t checksum_offset = opt_header_offset_ + offsetof(details::pe32_optional_header, CheckSum);
+  if (offset < checksum_offset + sizeof(uint32_t) && checksum_offset < offset + data.size()) {
+    LIEF_ERR("The checksum can't be patched");
+    return make_error_code(lief_errors::not_supported);
+  }
+
+  // Words (16-bit aligned) covered by the patch
+  const uint64_t start = offset & ~uint64_t(1);
+  const uint64_t end   = std::min<uint64_t>((offset + data.size() + 1) & ~uint64_t(1), size_);
+  std::vector<uint8_t> old_words(end - start + 1, 0);
+  if (auto is_ok = read(start, {old_words.data(), end - start}); !is_ok) {
+    return make_error_code(get_error(is_ok));
+  }
+  std::vector<uint8_t> new_words = old_words;
+  std::copy(data.begin(), data.end(), new_words.begin() + (offset - start));
+
+  if (auto is_ok = write(offset, data); !is_ok) {
+    return make_error_code(get_error(is_ok));
+  }
+
+  if (is_signed() && !signature_invalidated_ &&
+      !is_excluded_from_authentihash(offset, data.size()))
+  {
+    LIEF_WARN("Patching [0x{:x}, 0x{:x}] invalidates the Authenticode signature",
+              offset, offset + data.size());
+    signature_invalidated_ = true;
+  }
+
+  if (!update_checksum_) {
+    return ok();
+  }
+
+  // sum' = sum + ~old + new (ones' complement arithmetic, RFC 1624)
+  uint32_t sum = checksum_ - size_;
+  for (uint64_t i = 0; i < end - start; i += sizeof(uint16_t)) {
+    const uint16_t old_word = old_words[i] | (old_words[i + 1] << 8);
+    const uint16_t new_word = new_words[i] | (new_words[i + 1] << 8);
+    sum = fold(sum + static_cast<uint16_t>(~old_word) + new_word);
+  }
+
+  const uint32_t checksum = sum + size_;
+  if (auto is_ok = write(checksum_offset, {reinterpret_cast<const uint8_t*>(&checksum),
+                                           sizeof(checksum)}); !is_ok)
+  {
+    return make_error_code(get_error(is_ok));
+  }
+  checksum_ = checksum;
+  return ok();
+}
+
+ok_error_t HeaderPatcher::time_date_stamp(uint32_t value) {
+  return write_field(header_offset_ + offsetof(details::pe_header, TimeDateStamp), value);
+}
+
+ok_error_t HeaderPatcher::subsystem(OptionalHeader::SUBSYSTEM value) {
+  // Subsystem and DLLCharacteristics are at the same offset for PE32 and PE32+
+  return write_field(opt_header_offset_ + offsetof(details::pe32_optional_header, Subsystem),
+                     static_cast<uint16_t>(value));
+}
+
+ok_error_t HeaderPatcher::dll_characteristics(uint32_t value) {
+  return write_field(opt_header_offset_ + offsetof(details::pe32_optional_header, DLLCharacteristics),
+                     static_cast<uint16_t>(value));
+}
+
+ok_error_t HeaderPatcher::data_directory(DataDirectory::TYPES type, uint32_t rva, uint32_t size) {
+  const auto idx = static_cast<uint32_t>(type);
+  if (idx >= nb_data_dirs_) {
+    LIEF_ERR("The binary does not have the data directory {}", to_string(type));
+    return make_error_code(lief_errors::not_found);
+  }
+  details::pe_data_directory dir;
+  dir.RelativeVirtualAddress = rva;
+  dir.Size = size;
+  const uint64_t offset = data_dirs_offset_ + idx * sizeof(details::pe_data_directory);
+  if (auto is_ok = write_field(offset, dir); !is_ok) {
+    return is_ok;
+  }
+  if (type == DataDirectory::TYPES::CERTIFICATE_TABLE) {
+    cert_offset_ = rva;
+    cert_size_   = size;
+  }
+  return ok();
+}
+
+ok_error_t HeaderPatcher::flush() {
+  if (file_ != nullptr && !file_->flush()) {
+    return make_error_code(lief_errors::file_error);
+  }
+  return ok();
+}
+
+}
+}
@@ -0,0 +1,244 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+#include "logging.hpp"
+#include "frozen.hpp"
+
+#include "LIEF/PE/Binary.hpp"
+#include "LIEF/PE/DelayImport.hpp"
+#include "LIEF/PE/DelayImportEntry.hpp"
+#include "LIEF/PE/Import.hpp"
+#include "LIEF/PE/ImportEntry.hpp"
+#include "LIEF/PE/ImportResolver.hpp"
+
+namespace LIEF {
+namespace PE {
+
+std::string ImportResolver::normalize(const std::string& name) {
+  std::string norm = name;
+  std::transform(norm.begin(), norm.end(), norm.begin(),
+                 [] (unsigned char c) { return std::tolower(c); });
+  if (norm.size() > 4 && norm.compare(norm.size() - 4, 4, ".dll") == 0) {
+    norm.resize(norm.size() - 4);
+  }
+  return norm;
+}
+
+void ImportResolver::apiset(ApiSet schema) {
+  apiset_ = std::make_unique<ApiSet>(std::move(schema));
+  cache_.clear();
+}
+
+ok_error_t ImportResolver::add(const Binary& dll, const std::string& name) {
+  auto resolver = ExportResolver::from_binary(dll);
+  if (!resolver) {
+    LIEF_DEBUG("{} does not have exports", name);
+    return make_error_code(get_error(resolver));
+  }
+  modules_.insert_or_assign(normalize(name), std::move(*resolver));
+  cache_.clear();
+  return ok();
+}
+
+ok_error_t ImportResolver::add(const Binary& dll) {
+  auto resolver = ExportResolver::from_binary(dll);
+  if (!resolver) {
+    return make_error_code(get_error(resolver));
+  }
+  if (resolver->name().empty()) {
+    LIEF_ERR("The export directory does not provide the name of the library");
+    return make_error_code(lief_errors::not_found);
+  }
+  std::string name = normalize(resolver->name());
+  modules_.insert_or_assign(std::move(name), std::move(*resolver));
+  cache_.clear();
+  return ok();
+}
+
+ImportResolver::resolution_t
+ImportResolver::resolve(const std::string& library, const std::string& function,
+                        const std::string& importer) const
+{
+  return resolve_impl(library, function, 0, ExportResolver::NO_HINT,
+                      normalize(importer), 0);
+}
+
+ImportResolver::resolution_t
+ImportResolver::resolve_ordinal(const std::string& library, uint32_t ordinal,
+                                const std::string& importer) const
+{
+  return resolve_impl(library, "", ordinal, ExportResolver::NO_HINT,
+                      normalize(importer), 0);
+}
+
+ImportResolver::resolution_t
+ImportResolver::resolve_impl(const std::string& library, const std::string& function,
+                             uint32_t ordinal, uint32_t hint, const std::string& importer,
+                             uint32_t depth) const
+{
+  const std::string hop_name = function.empty() ?
+                               "#" + std::to_string(ordinal) : function;
+
+  std::string libname = normalize(library);
+  if (ApiSet::is_api_set(libname)) {
+    result<std::string> host = make_error_code(lief_errors::not_found);
+    if (apiset_ != nullptr) {
+      host = apiset_->resolve(libname, importer);
+    }
+    if (!host) {
+      resolution_t res;
+      res.status = STATUS::MISSING_API_SET;
+      res.library = std::move(libname);
+      res.function = function;
+      res.ordinal = ordinal;
+      res.chain.push_back(res.library + '!' + hop_name);
+      return res;
+    }
+    libname = normalize(*host);
+  }
+
+  const std::string key = libname + '!' + hop_name;
+  if (auto it = cache_.find(key); it != cache_.end()) {
+    return it->second;
+  }
+
+  resolution_t res;
+  res.library = libname;
+  res.function = function;
+  res.ordinal = ordinal;
+  res.chain.push_back(key);
+
+  if (depth > MAX_DEPTH || visiting_.count(key) > 0) {
+    // Not memoized: the call that started the walk caches the result
+    res.status = STATUS::CYCLE;
+    return res;
+  }
+
+  auto it_module = modules_.find(libname);
+  if (it_module == modules_.end()) {
+    res.status = STATUS::MISSING_LIBRARY;
+    cache_.emplace(key, res);
+    return res;
+  }
+
+  const ExportResolver& exports = it_module->second;
+  result<ExportEntry> entry = function.empty() ? exports.find_ordinal(ordinal) :
+                                                 exports.find(function, hint);
+  if (!entry) {
+    res.status = STATUS::MISSING_EXPORT;
+    cache_.emplace(key, res);
+    return res;
+  }
+
+  res.ordinal = entry->ordinal();
+
+  if (!entry->is_forwarded()) {
+    res.status = STATUS::RESOLVED;
+    res.rva = entry->function_rva();
+    cache_.emplace(key, res);
+    return res;
+  }
+
+  // Follow the forwarder: LIBRARY.Function or LIBRARY.#ordinal
+  const ExportEntry::forward_information_t fwd = entry->forward_information();
+  std::string fwd_function = fwd.function;
+  uint32_t fwd_ordinal = 0;
+  if (!fwd_function.empty() && fwd_function[0] == '#') {
+    fwd_ordinal = static_cast<uint32_t>(std::strtoul(fwd_function.c_str() + 1, nullptr, 10));
+    fwd_function.clear();
+  }
+
+  visiting_.insert(key);
+  resolution_t next = resolve_impl(fwd.library, fwd_function, fwd_ordinal,
+                                   ExportResolver::NO_HINT, libname, depth + 1);
+  visiting_.erase(key);
+
+  next.chain.insert(next.chain.begin(), key);
+  // A cycle found below this hop depends on how the chain was entered (its
+  // depth and the hops being visited): only the resolution that starts the
+  // walk can memoize it
+  if (next.status != STATUS::CYCLE || depth == 0) {
+    cache_.emplace(key, next);
+  }
+  return next;
+}
+
+std::vector<ImportResolver::import_t>
+ImportResolver::resolve_imports(const Binary& bin, const std::string& name) const {
+  std::vector<import_t> imports;
+  const std::string importer = normalize(name);
+
+  for (const Import& imp : bin.imports()) {
+    for (const ImportEntry& entry : imp.entries()) {
+      import_t info;
+      info.library = imp.name();
+      info.is_ordinal = entry.is_ordinal();
+      if (info.is_ordinal) {
+        info.ordinal = entry.ordinal();
+        info.resolution = resolve_impl(info.library, "", info.ordinal,
+                                       ExportResolver::NO_HINT, importer, 0);
+      } else {
+        info.function = entry.name();
+        info.resolution = resolve_impl(info.library, info.function, 0,
+                                       entry.hint(), importer, 0);
+      }
+      imports.push_back(std::move(info));
+    }
+  }
+
+  for (const DelayImport& imp : bin.delay_imports()) {
+    for (const DelayImportEntry& entry : imp.entries()) {
+      import_t info;
+      info.library = imp.name();
+      info.is_delayed = true;
+      info.is_ordinal = entry.is_ordinal();
+      if (info.is_ordinal) {
+        info.ordinal = entry.ordinal();
+        info.resolution = resolve_impl(info.library, "", info.ordinal,
+                                       ExportResolver::NO_HINT, importer, 0);
+      } else {
+        info.function = entry.name();
+        info.resolution = resolve_impl(info.library, info.function, 0,
+                                       entry.hint(), importer, 0);
+      }
+      imports.push_back(std::move(info));
+    }
+  }
+  return imports;
+}
+
+const char* to_string(ImportResolver::STATUS e) {
+  #define ENTRY(X) std::pair(ImportResolver::STATUS::X, #X)
+  STRING_MAP enums2str {
+    ENTRY(RESOLVED),
+    ENTRY(MISSING_LIBRARY),
+    ENTRY(MISSING_EXPORT),
+    ENTRY(MISSING_API_SET),
+    ENTRY(CYCLE),
+  };
+  #undef ENTRY
+
+  if (auto it = enums2str.find(e); it != enums2str.end()) {
+    return it->second;
+  }
+  return "UNKNOWN";
+}
+
+}
+}
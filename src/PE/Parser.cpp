@@ -46,6 +46,7 @@
 #include "LIEF/PE/utils.hpp"
 
 #include "internal_utils.hpp"
+#include "Abstract/BudgetTracker.hpp"
 #include "Parser.tcc"
 
 // Issue with VS2017
@@ -91,12 +92,14 @@ void Parser::init(const ParserConfig& config) {
   binary_->type_ = type_;
   binary_->original_size_ = stream_->size();
   config_ = config;
+  budget_ = std::make_unique<BudgetTracker>(config_.budget, NB_STAGES);
 
   if (type_ == PE_TYPE::PE32) {
     parse<details::PE32>();
   } else {
     parse<details::PE64>();
   }
+  binary_->truncation_ = budget_->reason();
 }
 
 ok_error_t Parser::parse_dos_stub() {
@@ -206,15 +209,18 @@ ok_error_t Parser::parse_sections() {
 
   uint32_t first_section_offset = UINT_MAX;
 
-  uint32_t numberof_sections = binary_->header().numberof_sections();
-  if (numberof_sections > NB_MAX_SECTIONS) {
-    LIEF_ERR("The PE binary has {} sections while the LIEF limit is {}.\n"
-             "Only the first {} will be parsed", numberof_sections, NB_MAX_SECTIONS, NB_MAX_SECTIONS);
-    numberof_sections = NB_MAX_SECTIONS;
+  const uint32_t nb_sections = binary_->header().numberof_sections();
+  const auto numberof_sections = static_cast<uint32_t>(budget_->limit(nb_sections, NB_MAX_SECTIONS));
+  if (numberof_sections < nb_sections) {
+    LIEF_ERR("The PE binary has {} sections while the limit is {}.\n"
+             "Only the first {} will be parsed", nb_sections, numberof_sections, numberof_sections);
   }
 
   stream_->setpos(sections_offset);
   for (size_t i = 0; i < numberof_sections; ++i) {
+    if (!budget_->tick(sizeof(Section))) {
+      break;
+    }
     details::pe_section raw_sec;
     if (auto res = stream_->read<details::pe_section>()) {
       raw_sec = *res;
@@ -241,6 +247,9 @@ ok_error_t Parser::parse_sections() {
     if (size_to_read > Parser::MAX_DATA_SIZE) {
       LIEF_WARN("Data of section section '{}' is too large (0x{:x})", section->name(), size_to_read);
     } else {
+      if (!budget_->tick(size_to_read)) {
+        break;
+      }
 
       if (!stream_->peek_data(section->content_, offset, size_to_read,
                               section->virtual_address())) {
@@ -311,6 +320,9 @@ ok_error_t Parser::parse_relocations() {
 
   uint32_t current_offset = offset;
   while (res_relocation_headers && current_offset < max_offset && res_relocation_headers->PageRVA != 0) {
+    if (!budget_->tick(sizeof(Relocation))) {
+      break;
+    }
     const details::pe_base_relocation_block& raw_struct = *res_relocation_headers;
     auto relocation = std::make_unique<Relocation>(raw_struct);
 
@@ -324,17 +336,20 @@ ok_error_t Parser::parse_relocations() {
       break;
     }
 
-    size_t numberof_entries = (raw_struct.BlockSize - sizeof(details::pe_base_relocation_block)) / sizeof(uint16_t);
-    if (numberof_entries > MAX_RELOCATION_ENTRIES) {
-      LIEF_WARN("The number of relocation entries () is larger than the LIEF's limit ({})\n"
-                "Only the first {} will be parsed", numberof_entries,
-                MAX_RELOCATION_ENTRIES, MAX_RELOCATION_ENTRIES);
-      numberof_entries = MAX_RELOCATION_ENTRIES;
+    const size_t nb_entries = (raw_struct.BlockSize - sizeof(details::pe_base_relocation_block)) / sizeof(uint16_t);
+    const size_t numberof_entries = budget_->limit(nb_entries, MAX_RELOCATION_ENTRIES);
+    if (numberof_entries < nb_entries) {
+      LIEF_WARN("The number of relocation entries ({}) is larger than the LIEF's limit ({})\n"
+                "Only the first {} will be parsed", nb_entries,
+                numberof_entries, numberof_entries);
     }
 
 
     stream_->setpos(current_offset + sizeof(details::pe_base_relocation_block));
     for (size_t i = 0; i < numberof_entries; ++i) {
+      if (!budget_->tick(sizeof(RelocationEntry))) {
+        break;
+      }
       auto res_entry = stream_->read<uint16_t>();
       if (!res_entry) {
         LIEF_ERR("Can't parse relocation entry #{}", i);
@@ -399,6 +414,9 @@ Parser::parse_resource_node(const details::pe_resource_directory_table& director
 
   // Iterate over the childs
   for (size_t idx = 0; idx < (numberof_name_entries + numberof_ID_entries); ++idx) {
+    if (!budget_->tick(sizeof(ResourceNode))) {
+      break;
+    }
 
     uint32_t data_rva = entries_array.RVA;
     uint32_t id       = entries_array.NameID.IntegerID;
@@ -525,6 +543,9 @@ ok_error_t Parser::parse_symbols() {
 
   uint32_t idx = 0;
   while (idx < nb_symbols) {
+    if (!budget_->tick(sizeof(Symbol))) {
+      break;
+    }
 
 
     auto res_raw_symbol = stream_->peek<details::pe_symbol>(current_offset);
@@ -888,6 +909,9 @@ ok_error_t Parser::parse_exports() {
    * This table is an array of RVAs
    */
   for (size_t i = 0; i < nbof_addr_entries; ++i) {
+    if (!budget_->tick(sizeof(ExportEntry))) {
+      break;
+    }
     uint32_t addr_value = 0;
     if (auto res = address_table_value(*stream_, address_table_offset, i)) {
       addr_value = *res;
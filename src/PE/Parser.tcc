@@ -38,19 +38,35 @@ namespace PE {
 template<typename PE_T>
 ok_error_t Parser::parse() {
 
+  if (!budget_->stage("headers")) {
+    return ok();
+  }
+
   if (!parse_headers<PE_T>()) {
     LIEF_WARN("Fail to parse regular PE headers");
     return make_error_code(lief_errors::parsing_error);
   }
 
+  if (!budget_->stage("dos stub")) {
+    return ok();
+  }
+
   if (!parse_dos_stub()) {
     LIEF_WARN("Fail to parse DOS Stub");
   }
 
+  if (!budget_->stage("rich header")) {
+    return ok();
+  }
+
   if (!parse_rich_header()) {
     LIEF_WARN("Fail to parse rich header");
   }
 
+  if (!budget_->stage("sections")) {
+    return ok();
+  }
+
   if (!parse_sections()) {
     LIEF_WARN("Fail to parse sections");
   }
@@ -59,10 +75,18 @@ ok_error_t Parser::parse() {
     LIEF_WARN("Fail to parse data directories");
   }
 
+  if (!budget_->stage("symbols")) {
+    return ok();
+  }
+
   if (!parse_symbols()) {
     LIEF_WARN("Fail to parse symbols");
   }
 
+  if (!budget_->stage("overlay")) {
+    return ok();
+  }
+
   if (!parse_overlay()) {
     LIEF_WARN("Fail to parse the overlay");
   }
@@ -140,6 +164,9 @@ ok_error_t Parser::parse_data_directories() {
   }
 
   // Import Table
+  if (!budget_->stage("imports")) {
+    return ok();
+  }
   if (DataDirectory* import_data_dir = binary_->data_directory(DataDirectory::TYPES::IMPORT_TABLE)) {
     if (import_data_dir->RVA() > 0 && config_.parse_imports)
     {
@@ -152,6 +179,9 @@ ok_error_t Parser::parse_data_directories() {
   }
 
   // Exports
+  if (!budget_->stage("exports")) {
+    return ok();
+  }
   if (const DataDirectory* export_dir = binary_->data_directory(DataDirectory::TYPES::EXPORT_TABLE)) {
     if (export_dir->RVA() > 0 && config_.parse_exports) {
       LIEF_DEBUG("Parsing Exports");
@@ -160,12 +190,18 @@ ok_error_t Parser::parse_data_directories() {
   }
 
   // Signature
+  if (!budget_->stage("signature")) {
+    return ok();
+  }
   if (const DataDirectory* dir = binary_->data_directory(DataDirectory::TYPES::CERTIFICATE_TABLE)) {
     if (dir->RVA() > 0 && config_.parse_signature) {
       parse_signature();
     }
   }
 
+  if (!budget_->stage("tls")) {
+    return ok();
+  }
   if (DataDirectory* dir = binary_->data_directory(DataDirectory::TYPES::TLS_TABLE)) {
     if (dir->RVA() > 0) {
       if (Section* sec = dir->section()) {
@@ -175,6 +211,9 @@ ok_error_t Parser::parse_data_directories() {
     }
   }
 
+  if (!budget_->stage("load config")) {
+    return ok();
+  }
   if (DataDirectory* dir = binary_->data_directory(DataDirectory::TYPES::LOAD_CONFIG_TABLE)) {
     if (dir->RVA() > 0) {
       LIEF_DEBUG("Parsing LoadConfiguration");
@@ -185,6 +224,9 @@ ok_error_t Parser::parse_data_directories() {
     }
   }
 
+  if (!budget_->stage("relocations")) {
+    return ok();
+  }
   if (DataDirectory* dir = binary_->data_directory(DataDirectory::TYPES::BASE_RELOCATION_TABLE)) {
     if (dir->RVA() > 0 && config_.parse_reloc) {
       LIEF_DEBUG("Parsing Relocations");
@@ -195,6 +237,9 @@ ok_error_t Parser::parse_data_directories() {
     }
   }
 
+  if (!budget_->stage("debug")) {
+    return ok();
+  }
   if (DataDirectory* dir = binary_->data_directory(DataDirectory::TYPES::DEBUG_DIR)) {
     if (dir->RVA() > 0) {
       if (Section* sec = dir->section()) {
@@ -204,6 +249,9 @@ ok_error_t Parser::parse_data_directories() {
     }
   }
 
+  if (!budget_->stage("resources")) {
+    return ok();
+  }
   if (DataDirectory* dir = binary_->data_directory(DataDirectory::TYPES::RESOURCE_TABLE)) {
     if (dir->RVA() > 0 && config_.parse_rsrc) {
       LIEF_DEBUG("Parsing Resources");
@@ -214,6 +262,9 @@ ok_error_t Parser::parse_data_directories() {
     }
   }
 
+  if (!budget_->stage("delay imports")) {
+    return ok();
+  }
   if (DataDirectory* dir = binary_->data_directory(DataDirectory::TYPES::DELAY_IMPORT_DESCRIPTOR)) {
     if (dir->RVA() > 0) {
       auto is_ok = parse_delay_imports<PE_T>();
@@ -245,6 +296,9 @@ ok_error_t Parser::parse_import_table() {
   result<details::pe_import> imp_res;
 
   while (stream_->pos() < import_end && (imp_res = stream_->read<details::pe_import>())) {
+    if (!budget_->tick(sizeof(Import))) {
+      break;
+    }
     const auto raw_imp = *imp_res;
     if (BinaryStream::is_all_zero(raw_imp)) {
       break;
@@ -313,6 +367,9 @@ ok_error_t Parser::parse_import_table() {
     size_t idx = 0;
 
     while (table != 0 || IAT != 0) {
+      if (!budget_->tick(sizeof(ImportEntry))) {
+        break;
+      }
       ImportEntry entry;
       entry.iat_value_ = IAT;
       entry.data_      = table > 0 ? table : IAT; // In some cases, ILT can be corrupted
@@ -389,6 +446,9 @@ ok_error_t Parser::parse_delay_names_table(DelayImport& import, uint32_t names_o
   }
 
   while (names_offset > 0 && entry_val > 0) {
+    if (!budget_->tick(sizeof(DelayImportEntry))) {
+      break;
+    }
     DelayImportEntry entry{entry_val, type_};
     // Index of the current entry (-1 as we start with a read())
     const size_t index = (stream_->pos() - names_offset) / sizeof(uint) - 1;
@@ -494,7 +494,11 @@ void Hash::visit(const SpcIndirectData& content) {
   process(content.file());
   process(content.digest());
   process(content.digest_algorithm());
-
+  process(content.page_hash_algorithm());
+  for (const SpcIndirectData::page_hash_t& entry : content.page_hashes()) {
+    process(entry.offset);
+    process(entry.digest);
+  }
 }
 
 
@@ -856,6 +856,10 @@ void JsonVisitor::visit(const SpcIndirectData& content) {
   node_["digest"]           = content.digest();
   node_["digest_algorithm"] = to_string(content.digest_algorithm());
   node_["content_type"]     = content.content_type();
+  if (!content.page_hashes().empty()) {
+    node_["page_hash_algorithm"] = to_string(content.page_hash_algorithm());
+    node_["nb_page_hashes"]      = content.page_hashes().size();
+  }
 }
 
 void JsonVisitor::visit(const Attribute& auth) {
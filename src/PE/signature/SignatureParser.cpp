@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <memory>
@@ -483,6 +484,26 @@ SignatureParser::parse_spc_indirect_data(BinaryStream& stream, range_t& range) {
       const SpcPeImageData& spc_data_value = *spc_data;
       indirect_data->file_  = spc_data_value.file;
       indirect_data->flags_ = spc_data_value.flags;
+
+      const ALGORITHMS page_hash_algo = spc_data_value.page_hash_algorithm;
+      const size_t digest_size = page_hash_algo == ALGORITHMS::SHA_1   ? 20 :
+                                 page_hash_algo == ALGORITHMS::SHA_256 ? 32 : 0;
+      if (digest_size > 0) {
+        // Sequence of (file offset: uint32_t, digest) entries
+        SpanStream hashes_stream(spc_data_value.page_hashes);
+        const size_t entry_size = sizeof(uint32_t) + digest_size;
+        indirect_data->page_hashes_.reserve(hashes_stream.size() / entry_size);
+        while (hashes_stream.can_read<uint32_t>()) {
+          SpcIndirectData::page_hash_t entry;
+          entry.offset = *hashes_stream.read<uint32_t>();
+          if (!hashes_stream.read_data(entry.digest, digest_size)) {
+            LIEF_INFO("spc-page-hashes: truncated entry at offset 0x{:x}", entry.offset);
+            break;
+          }
+          indirect_data->page_hashes_.push_back(std::move(entry));
+        }
+        indirect_data->page_hash_algorithm_ = page_hash_algo;
+      }
     } else {
       LIEF_INFO("Can't parse SpcPeImageData");
     }
@@ -1641,6 +1662,7 @@ result<SignatureParser::SpcPeImageData>
 SignatureParser::parse_spc_pe_image_data(BinaryStream& stream) {
   LIEF_DEBUG("Parsing SpcPeImageData");
   ASN1Reader asn1r(stream);
+  SpcPeImageData image_data;
 
   /* flags SpcPeImageFlags DEFAULT { includeResources } */
   auto flags = asn1r.read_bitstring();
@@ -1659,10 +1681,16 @@ SignatureParser::parse_spc_pe_image_data(BinaryStream& stream) {
       LIEF_DEBUG("SpcPeImageData.url");
       //LIEF_WARN(SUBMISSION_MSG);
     }
-    else if (auto moniker = asn1r.read_tag(MBEDTLS_ASN1_CONTEXT_SPECIFIC | 1))
+    else if (auto moniker = asn1r.read_tag(MBEDTLS_ASN1_CONSTRUCTED      |
+                                           MBEDTLS_ASN1_CONTEXT_SPECIFIC | 1))
     {
       LIEF_DEBUG("SpcPeImageData.moniker");
-      //LIEF_WARN(SUBMISSION_MSG);
+      SpanStream moniker_stream{stream.p(), *moniker};
+      stream.increment_pos(moniker_stream.size());
+      if (auto page_hashes = parse_spc_serialized_object(moniker_stream)) {
+        image_data.page_hash_algorithm = page_hashes->algorithm;
+        image_data.page_hashes = std::move(page_hashes->hashes);
+      }
     }
     else if (auto file = asn1r.read_tag(MBEDTLS_ASN1_CONSTRUCTED      |
                                         MBEDTLS_ASN1_CONTEXT_SPECIFIC | 2))
@@ -1708,7 +1736,98 @@ SignatureParser::parse_spc_pe_image_data(BinaryStream& stream) {
   //   unicode [0] IMPLICIT BMPSTRING,
   //   ascii   [1] IMPLICIT IA5STRING
   // }
-  return {};
+  return image_data;
+}
+
+result<SignatureParser::SpcPageHashes>
+SignatureParser::parse_spc_serialized_object(BinaryStream& stream) {
+  // SpcSerializedObject ::= SEQUENCE {
+  //   classId        SpcUuid,
+  //   serializedData OCTETSTRING
+  // }
+  //
+  // For the page hashes, classId is a6b586d5-b4a1-2466-ae05-a217da8e60d6
+  // and serializedData is:
+  //
+  // SET {
+  //   SEQUENCE {
+  //     type  ObjectID, // SPC_PE_IMAGE_PAGE_HASHES_V1 (SHA-1) or _V2 (SHA-256)
+  //     value SET { OCTETSTRING } // (offset: uint32_t, digest) entries
+  //   }
+  // }
+  static constexpr std::array<uint8_t, 16> PAGE_HASHES_CLASS_ID = {
+    0xa6, 0xb5, 0x86, 0xd5, 0xb4, 0xa1, 0x24, 0x66,
+    0xae, 0x05, 0xa2, 0x17, 0xda, 0x8e, 0x60, 0xd6,
+  };
+  LIEF_DEBUG("Parsing SpcSerializedObject");
+  ASN1Reader asn1r(stream);
+
+  auto class_id = asn1r.read_octet_string();
+  if (!class_id) {
+    LIEF_INFO("Can't read spc-serialized-object.class-id (pos: {})", stream.pos());
+    return make_error_code(class_id.error());
+  }
+
+  if (!std::equal(class_id->begin(), class_id->end(),
+                  PAGE_HASHES_CLASS_ID.begin(), PAGE_HASHES_CLASS_ID.end()))
+  {
+    LIEF_INFO("spc-serialized-object.class-id: unknown class {}", hex_dump(*class_id));
+    return make_error_code(lief_errors::not_supported);
+  }
+
+  auto serialized_data = asn1r.read_octet_string();
+  if (!serialized_data) {
+    LIEF_INFO("Can't read spc-serialized-object.serialized-data (pos: {})", stream.pos());
+    return make_error_code(serialized_data.error());
+  }
+
+  SpanStream data_stream(*serialized_data);
+  ASN1Reader data_reader(data_stream);
+
+  auto tag = data_reader.read_tag(MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SET);
+  if (!tag) {
+    LIEF_INFO("Wrong tag: {} for spc-page-hashes ::= SET", data_reader.get_str_tag());
+    return make_error_code(tag.error());
+  }
+
+  tag = data_reader.read_tag(MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE);
+  if (!tag) {
+    LIEF_INFO("Wrong tag: {} for spc-page-hashes ::= SEQUENCE", data_reader.get_str_tag());
+    return make_error_code(tag.error());
+  }
+
+  auto type = data_reader.read_oid();
+  if (!type) {
+    LIEF_INFO("Can't read spc-page-hashes.type");
+    return make_error_code(type.error());
+  }
+
+  SpcPageHashes page_hashes;
+  if (*type == /* SPC_PE_IMAGE_PAGE_HASHES_V1 */ "1.3.6.1.4.1.311.2.3.1") {
+    page_hashes.algorithm = ALGORITHMS::SHA_1;
+  }
+  else if (*type == /* SPC_PE_IMAGE_PAGE_HASHES_V2 */ "1.3.6.1.4.1.311.2.3.2") {
+    page_hashes.algorithm = ALGORITHMS::SHA_256;
+  }
+  else {
+    LIEF_INFO("Unsupported page hashes type: {}", oid_to_string(*type));
+    return make_error_code(lief_errors::not_supported);
+  }
+
+  tag = data_reader.read_tag(MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SET);
+  if (!tag) {
+    LIEF_INFO("Wrong tag: {} for spc-page-hashes.value ::= SET", data_reader.get_str_tag());
+    return make_error_code(tag.error());
+  }
+
+  auto hashes = data_reader.read_octet_string();
+  if (!hashes) {
+    LIEF_INFO("Can't read spc-page-hashes.value");
+    return make_error_code(hashes.error());
+  }
+  LIEF_DEBUG("spc-page-hashes: {} ({} bytes)", oid_to_string(*type), hashes->size());
+  page_hashes.hashes = std::move(*hashes);
+  return page_hashes;
 }
 
 
@@ -35,6 +35,10 @@ void SpcIndirectData::print(std::ostream& os) const {
   } else {
     os << fmt::format("{}: {}\n", to_string(digest_algorithm()), hex_dump(digest()));
   }
+  if (!page_hashes_.empty()) {
+    os << fmt::format("Page hashes ({}): {} entries\n",
+                      to_string(page_hash_algorithm()), page_hashes_.size());
+  }
 }
 
 }
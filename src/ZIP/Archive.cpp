@@ -0,0 +1,313 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <unordered_map>
+
+#include "logging.hpp"
+#include "parallel.hpp"
+
+#include "LIEF/config.h"
+#include "LIEF/ZIP/Archive.hpp"
+#include "LIEF/ZIP/Entry.hpp"
+#include "LIEF/ZIP/utils.hpp"
+#include "LIEF/Abstract/Parser.hpp"
+#include "LIEF/Abstract/Binary.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
+#include "LIEF/BinaryStream/VectorStream.hpp"
+#include "LIEF/DEX/File.hpp"
+
+#if defined(LIEF_DEX_SUPPORT)
+#include "LIEF/DEX/Parser.hpp"
+#endif
+
+#include "BinaryStream/Inflate.hpp"
+
+namespace LIEF {
+namespace ZIP {
+
+namespace {
+// Index of the DEX file: classes.dex -> 1, classesN.dex -> N
+uint64_t dex_index(const Entry& entry) {
+  static constexpr size_t PREFIX_LEN = sizeof("classes") - 1;
+  const std::string& name = entry.name();
+  if (name[PREFIX_LEN] == '.') {
+    return 1;
+  }
+  return std::strtoull(name.c_str() + PREFIX_LEN, nullptr, 10);
+}
+
+// Offsets in the header of a DEX file
+static constexpr uint64_t DEX_STRING_IDS_SIZE = 0x38;
+static constexpr uint64_t DEX_TYPE_IDS_SIZE   = 0x40;
+
+// Upper bound of the initial allocation when inflating an entry, relative to
+// its compressed size
+static constexpr uint64_t RESERVE_RATIO = 4;
+}
+
+Archive::Archive() = default;
+Archive::~Archive() = default;
+
+const Entry* Archive::get_entry(const std::string& name) const {
+  const auto it = std::find_if(entries_.begin(), entries_.end(),
+      [&name] (const std::unique_ptr<Entry>& e) {
+        return e->name() == name;
+      });
+  return it != entries_.end() ? it->get() : nullptr;
+}
+
+std::vector<const Entry*> Archive::dex_files() const {
+  std::vector<const Entry*> files;
+  for (const std::unique_ptr<Entry>& entry : entries_) {
+    if (entry->is_dex()) {
+      files.push_back(entry.get());
+    }
+  }
+  std::sort(files.begin(), files.end(),
+    [] (const Entry* lhs, const Entry* rhs) {
+      return dex_index(*lhs) < dex_index(*rhs);
+    });
+  return files;
+}
+
+std::vector<const Entry*> Archive::native_libraries(const std::string& abi) const {
+  std::vector<const Entry*> libs;
+  for (const std::unique_ptr<Entry>& entry : entries_) {
+    if (!entry->is_native_library()) {
+      continue;
+    }
+    if (!abi.empty() && entry->name().compare(4, abi.size() + 1, abi + '/') != 0) {
+      continue;
+    }
+    libs.push_back(entry.get());
+  }
+  return libs;
+}
+
+result<span<const uint8_t>> Archive::content(const Entry& entry, std::vector<uint8_t>& buffer,
+                                             bool check_crc) const
+{
+  if (entry.is_encrypted()) {
+    LIEF_ERR("'{}' is encrypted", entry.name());
+    return make_error_code(lief_errors::not_supported);
+  }
+
+  span<const uint8_t> data;
+  switch (entry.method()) {
+    case Entry::METHOD::STORED:
+      {
+        data = entry.raw_content();
+        break;
+      }
+
+    case Entry::METHOD::DEFLATED:
+      {
+        // The declared size is not trusted for the allocation: the buffer
+        // starts from the typical DEFLATE ratio and grows up to entry.size()
+        buffer.clear();
+        buffer.reserve(std::min<uint64_t>(entry.size(),
+                                          RESERVE_RATIO * entry.raw_content().size()));
+        SpanStream strm(entry.raw_content());
+        details::Inflater inflater(strm, 0);
+        // Stop inside a block as soon as it produces more than the declared
+        // size (a single block can expand to an arbitrary size)
+        inflater.set_limit(entry.size());
+        do {
+          if (auto is_ok = inflater.next_block(); !is_ok) {
+            if (get_error(is_ok) == lief_errors::data_too_large) {
+              LIEF_ERR("'{}' inflates beyond its declared size (0x{:x})",
+                       entry.name(), entry.size());
+              return make_error_code(lief_errors::corrupted);
+            }
+            LIEF_ERR("Can't inflate '{}'", entry.name());
+            return make_error_code(get_error(is_ok));
+          }
+          span<const uint8_t> out = inflater.output();
+          buffer.insert(buffer.end(), out.begin(), out.end());
+          inflater.consume();
+        } while (!inflater.is_final());
+        data = buffer;
+        break;
+      }
+
+    default:
+      {
+        LIEF_ERR("'{}': compression method {} is not supported", entry.name(),
+                 static_cast<uint16_t>(entry.method()));
+        return make_error_code(lief_errors::not_supported);
+      }
+  }
+
+  if (data.size() != entry.size()) {
+    LIEF_ERR("'{}': size mismatch (0x{:x} vs 0x{:x})", entry.name(),
+             data.size(), entry.size());
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  if (check_crc && crc32(data) != entry.crc32()) {
+    LIEF_ERR("'{}': CRC-32 mismatch", entry.name());
+    return make_error_code(lief_errors::corrupted);
+  }
+  return data;
+}
+
+result<std::vector<uint8_t>> Archive::extract(const Entry& entry, bool check_crc) const {
+  std::vector<uint8_t> buffer;
+  auto data = content(entry, buffer, check_crc);
+  if (!data) {
+    return make_error_code(get_error(data));
+  }
+  if (entry.is_stored()) {
+    return std::vector<uint8_t>(data->begin(), data->end());
+  }
+  return buffer;
+}
+
+std::unique_ptr<BinaryStream> Archive::stream(const Entry& entry) const {
+  if (entry.is_stored() && !entry.is_encrypted()) {
+    return std::make_unique<SpanStream>(entry.raw_content());
+  }
+  auto data = extract(entry, /*check_crc=*/false);
+  if (!data) {
+    return nullptr;
+  }
+  return std::make_unique<VectorStream>(std::move(*data));
+}
+
+std::unique_ptr<Binary> Archive::parse(const Entry& entry) const {
+  std::unique_ptr<BinaryStream> strm = stream(entry);
+  if (strm == nullptr) {
+    return nullptr;
+  }
+  return LIEF::Parser::parse(std::move(strm));
+}
+
+std::unique_ptr<DEX::File> Archive::parse_dex(const Entry& entry) const {
+#if defined(LIEF_DEX_SUPPORT)
+  auto data = extract(entry, /*check_crc=*/false);
+  if (!data) {
+    return nullptr;
+  }
+  return DEX::Parser::parse(std::move(*data), entry.name());
+#else
+  LIEF_ERR("DEX support is not enabled");
+  return nullptr;
+#endif
+}
+
+std::vector<std::unique_ptr<Binary>>
+Archive::parse_all(const std::vector<const Entry*>& entries, uint32_t nb_threads) const
+{
+  std::vector<std::unique_ptr<Binary>> binaries(entries.size());
+  parallel_for(entries.size(), nb_threads, [&] (size_t i) {
+    binaries[i] = parse(*entries[i]);
+  });
+  return binaries;
+}
+
+std::vector<std::unique_ptr<DEX::File>>
+Archive::parse_dex_all(const std::vector<const Entry*>& entries, uint32_t nb_threads) const
+{
+  std::vector<std::unique_ptr<DEX::File>> files(entries.size());
+  parallel_for(entries.size(), nb_threads, [&] (size_t i) {
+    files[i] = parse_dex(*entries[i]);
+  });
+  return files;
+}
+
+result<Archive::dex_pool_t> Archive::dex_pool() const {
+  dex_pool_t pool;
+  std::unordered_map<std::string, uint32_t> strings_idx;
+  std::unordered_map<uint32_t, uint32_t> types_idx;
+  std::vector<uint8_t> buffer;
+
+  for (const Entry* entry : dex_files()) {
+    auto data = content(*entry, buffer, /*check_crc=*/false);
+    if (!data) {
+      return make_error_code(get_error(data));
+    }
+    SpanStream strm(*data);
+    auto string_ids = strm.peek<std::array<uint32_t, 2>>(DEX_STRING_IDS_SIZE);
+    auto type_ids   = strm.peek<std::array<uint32_t, 2>>(DEX_TYPE_IDS_SIZE);
+    if (!string_ids || !type_ids) {
+      LIEF_ERR("'{}': corrupted DEX header", entry->name());
+      return make_error_code(lief_errors::corrupted);
+    }
+    const auto [nb_strings, strings_off] = *string_ids;
+    const auto [nb_types, types_off] = *type_ids;
+    if (uint64_t(nb_strings) * sizeof(uint32_t) > strm.size() ||
+        uint64_t(nb_types) * sizeof(uint32_t) > strm.size())
+    {
+      LIEF_ERR("'{}': corrupted DEX header", entry->name());
+      return make_error_code(lief_errors::corrupted);
+    }
+
+    std::vector<uint32_t>& strings_map = pool.strings_map.emplace_back();
+    strings_map.reserve(nb_strings);
+    for (size_t i = 0; i < nb_strings; ++i) {
+      auto data_off = strm.peek<uint32_t>(strings_off + i * sizeof(uint32_t));
+      if (!data_off) {
+        LIEF_ERR("'{}': can't read string #{}", entry->name(), i);
+        return make_error_code(lief_errors::read_error);
+      }
+      // string_data_item: uleb128 length (in UTF-16 units) + MUTF-8 data
+      strm.setpos(*data_off);
+      if (!strm.read_uleb128()) {
+        return make_error_code(lief_errors::read_error);
+      }
+      auto str = strm.read_string();
+      if (!str) {
+        LIEF_ERR("'{}': can't read string #{}", entry->name(), i);
+        return make_error_code(lief_errors::read_error);
+      }
+      auto [it, inserted] = strings_idx.emplace(std::move(*str), pool.strings.size());
+      if (inserted) {
+        pool.strings.push_back(it->first);
+      }
+      strings_map.push_back(it->second);
+    }
+
+    std::vector<uint32_t>& types_map = pool.types_map.emplace_back();
+    types_map.reserve(nb_types);
+    for (size_t i = 0; i < nb_types; ++i) {
+      auto desc_idx = strm.peek<uint32_t>(types_off + i * sizeof(uint32_t));
+      if (!desc_idx || *desc_idx >= strings_map.size()) {
+        LIEF_ERR("'{}': corrupted type #{}", entry->name(), i);
+        return make_error_code(lief_errors::corrupted);
+      }
+      const uint32_t str_idx = strings_map[*desc_idx];
+      auto [it, inserted] = types_idx.emplace(str_idx, pool.types.size());
+      if (inserted) {
+        pool.types.push_back(str_idx);
+      }
+      types_map.push_back(it->second);
+    }
+  }
+  return pool;
+}
+
+std::ostream& operator<<(std::ostream& os, const Archive& zip) {
+  os << "Entries (" << zip.entries_.size() << "):\n";
+  for (const Entry& entry : zip.entries()) {
+    os << "  " << entry << '\n';
+  }
+  return os;
+}
+
+}
+}
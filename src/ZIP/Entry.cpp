@@ -0,0 +1,87 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <spdlog/fmt/fmt.h>
+
+#include "frozen.hpp"
+
+#include "LIEF/ZIP/Entry.hpp"
+
+#include "ZIP/Structures.hpp"
+
+namespace LIEF {
+namespace ZIP {
+
+Entry::~Entry() = default;
+
+bool Entry::is_encrypted() const {
+  return (flags_ & details::FLAG_ENCRYPTED) != 0;
+}
+
+bool Entry::is_dex() const {
+  // classes.dex, classes2.dex, ..., classesN.dex at the root of the APK
+  static constexpr char PREFIX[] = "classes";
+  static constexpr char SUFFIX[] = ".dex";
+  static constexpr size_t PREFIX_LEN = sizeof(PREFIX) - 1;
+  static constexpr size_t SUFFIX_LEN = sizeof(SUFFIX) - 1;
+  if (name_.size() < PREFIX_LEN + SUFFIX_LEN ||
+      name_.compare(0, PREFIX_LEN, PREFIX) != 0 ||
+      name_.compare(name_.size() - SUFFIX_LEN, SUFFIX_LEN, SUFFIX) != 0)
+  {
+    return false;
+  }
+  for (size_t i = PREFIX_LEN; i < name_.size() - SUFFIX_LEN; ++i) {
+    if (name_[i] < '0' || name_[i] > '9') {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Entry::is_native_library() const {
+  // lib/<abi>/<name>.so
+  if (name_.size() < 8 || name_.compare(0, 4, "lib/") != 0 ||
+      name_.compare(name_.size() - 3, 3, ".so") != 0)
+  {
+    return false;
+  }
+  const size_t sep = name_.find('/', 4);
+  return sep != std::string::npos && sep > 4 &&
+         name_.find('/', sep + 1) == std::string::npos;
+}
+
+std::ostream& operator<<(std::ostream& os, const Entry& entry) {
+  os << fmt::format("{:40} {:8} offset=0x{:08x} size=0x{:06x} csize=0x{:06x} crc=0x{:08x}",
+                    entry.name(), to_string(entry.method()), entry.data_offset(),
+                    entry.size(), entry.compressed_size(), entry.crc32());
+  return os;
+}
+
+const char* to_string(Entry::METHOD e) {
+  #define ENTRY(X) std::pair(Entry::METHOD::X, #X)
+  STRING_MAP enums2str {
+    ENTRY(STORED),
+    ENTRY(DEFLATED),
+  };
+  #undef ENTRY
+
+  if (auto it = enums2str.find(e); it != enums2str.end()) {
+    return it->second;
+  }
+  return "UNKNOWN";
+}
+
+}
+}
@@ -0,0 +1,251 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+
+#include "logging.hpp"
+
+#include "LIEF/ZIP/Parser.hpp"
+#include "LIEF/ZIP/Archive.hpp"
+#include "LIEF/ZIP/Entry.hpp"
+
+#include "LIEF/BinaryStream/SpanStream.hpp"
+#include "LIEF/BinaryStream/VectorStream.hpp"
+
+#include "ZIP/Structures.hpp"
+
+namespace LIEF {
+namespace ZIP {
+
+Parser::Parser(std::unique_ptr<Archive> archive) :
+  archive_{std::move(archive)},
+  stream_{std::make_unique<SpanStream>(archive_->data_)}
+{}
+
+Parser::~Parser() = default;
+
+std::unique_ptr<Archive> Parser::parse(const std::string& file) {
+  auto stream = VectorStream::from_file(file);
+  if (!stream) {
+    LIEF_ERR("Can't read '{}'", file);
+    return nullptr;
+  }
+  return parse(stream->move_content());
+}
+
+std::unique_ptr<Archive> Parser::parse(std::vector<uint8_t> data) {
+  std::unique_ptr<Archive> archive(new Archive{});
+  archive->data_ = std::move(data);
+
+  Parser parser{std::move(archive)};
+  auto info = parser.parse_eocd();
+  if (!info) {
+    LIEF_ERR("The input is not a ZIP archive");
+    return nullptr;
+  }
+
+  if (!parser.parse_central_directory(*info)) {
+    LIEF_WARN("The archive is likely corrupted");
+  }
+  return std::move(parser.archive_);
+}
+
+result<Parser::cd_info_t> Parser::parse_eocd() {
+  const uint64_t size = stream_->size();
+  if (size < sizeof(details::eocd_t)) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  // The EOCD record is located at the end of the archive, before a
+  // variable-length comment: scan backward for its magic.
+  const uint64_t last = size - sizeof(details::eocd_t);
+  const uint64_t first = last > details::MAX_COMMENT_SIZE ?
+                         last - details::MAX_COMMENT_SIZE : 0;
+  uint64_t eocd_offset = 0;
+  bool found = false;
+  for (uint64_t pos = last + 1; pos-- > first;) {
+    auto eocd = stream_->peek<details::eocd_t>(pos);
+    if (eocd && eocd->magic == details::EOCD_MAGIC &&
+        pos + sizeof(details::eocd_t) + eocd->comment_len <= size)
+    {
+      eocd_offset = pos;
+      found = true;
+      break;
+    }
+  }
+
+  if (!found) {
+    LIEF_DEBUG("Can't find the end of central directory record");
+    return make_error_code(lief_errors::not_found);
+  }
+
+  const auto eocd = *stream_->peek<details::eocd_t>(eocd_offset);
+  if (eocd.disk != 0 || eocd.cd_disk != 0) {
+    LIEF_ERR("Multi-disk archives are not supported");
+    return make_error_code(lief_errors::not_supported);
+  }
+
+  cd_info_t info;
+  info.offset     = eocd.cd_offset;
+  info.size       = eocd.cd_size;
+  info.nb_entries = eocd.nb_entries;
+
+  const bool need_zip64 = eocd.nb_entries == 0xffff ||
+                          eocd.cd_size    == 0xffffffff ||
+                          eocd.cd_offset  == 0xffffffff;
+
+  if (eocd_offset >= sizeof(details::eocd64_locator_t)) {
+    const uint64_t loc_offset = eocd_offset - sizeof(details::eocd64_locator_t);
+    auto locator = stream_->peek<details::eocd64_locator_t>(loc_offset);
+    if (locator && locator->magic == details::EOCD64_LOCATOR_MAGIC) {
+      auto eocd64 = stream_->peek<details::eocd64_t>(locator->eocd64_offset);
+      if (!eocd64 || eocd64->magic != details::EOCD64_MAGIC) {
+        LIEF_ERR("Corrupted ZIP64 end of central directory record");
+        return make_error_code(lief_errors::corrupted);
+      }
+      info.offset     = eocd64->cd_offset;
+      info.size       = eocd64->cd_size;
+      info.nb_entries = eocd64->nb_entries;
+      return info;
+    }
+  }
+
+  if (need_zip64) {
+    LIEF_ERR("Missing ZIP64 end of central directory record");
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  // Data prepended to the archive (e.g. self-extracting archives) shifts
+  // all the offsets
+  if (info.offset + info.size < eocd_offset) {
+    const uint64_t bias = eocd_offset - (info.offset + info.size);
+    LIEF_DEBUG("Archive prefixed with 0x{:x} bytes", bias);
+    bias_ = bias;
+    info.offset += bias;
+  }
+  return info;
+}
+
+ok_error_t Parser::parse_central_directory(const cd_info_t& info) {
+  const uint64_t size = stream_->size();
+  if (info.offset > size || info.size > size - info.offset) {
+    LIEF_ERR("Central directory out of bounds (offset: 0x{:x})", info.offset);
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  // Each record takes at least sizeof(central_header_t) bytes
+  const uint64_t nb_entries = std::min<uint64_t>(
+      info.nb_entries, info.size / sizeof(details::central_header_t));
+  archive_->entries_.reserve(nb_entries);
+
+  const std::vector<uint8_t>& data = archive_->data_;
+  const uint64_t end = info.offset + info.size;
+  uint64_t pos = info.offset;
+  for (uint64_t i = 0; i < nb_entries; ++i) {
+    auto res_hdr = stream_->peek<details::central_header_t>(pos);
+    if (!res_hdr || res_hdr->magic != details::CENTRAL_HEADER_MAGIC) {
+      LIEF_ERR("Corrupted central directory entry #{} at 0x{:x}", i, pos);
+      return make_error_code(lief_errors::corrupted);
+    }
+    const details::central_header_t& hdr = *res_hdr;
+    const uint64_t name_off  = pos + sizeof(details::central_header_t);
+    const uint64_t extra_off = name_off + hdr.name_len;
+    const uint64_t next      = extra_off + hdr.extra_len + hdr.comment_len;
+    if (next > end) {
+      LIEF_ERR("Central directory entry #{} out of bounds", i);
+      return make_error_code(lief_errors::corrupted);
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->name_   = std::string(data.begin() + name_off, data.begin() + extra_off);
+    entry->method_ = static_cast<Entry::METHOD>(hdr.method);
+    entry->flags_  = hdr.flags;
+    entry->crc32_  = hdr.crc32;
+    entry->size_   = hdr.size;
+    entry->offset_ = hdr.local_header_offset;
+    uint64_t compressed_size = hdr.compressed_size;
+
+    // ZIP64 extended information: the values are present only if the
+    // corresponding field of the header is saturated
+    uint64_t extra = extra_off;
+    while (extra + 4 <= extra_off + hdr.extra_len) {
+      const uint16_t id = *stream_->peek<uint16_t>(extra);
+      const uint16_t len = *stream_->peek<uint16_t>(extra + 2);
+      const uint64_t field_end = extra + 4 + len;
+      if (field_end > extra_off + hdr.extra_len) {
+        break;
+      }
+      if (id == details::ZIP64_EXTRA_ID) {
+        uint64_t field = extra + 4;
+        auto read64 = [&] (uint64_t& value) {
+          if (field + sizeof(uint64_t) <= field_end) {
+            value = *stream_->peek<uint64_t>(field);
+            field += sizeof(uint64_t);
+          }
+        };
+        if (hdr.size == 0xffffffff) {
+          read64(entry->size_);
+        }
+        if (hdr.compressed_size == 0xffffffff) {
+          read64(compressed_size);
+        }
+        if (hdr.local_header_offset == 0xffffffff) {
+          read64(entry->offset_);
+        }
+      }
+      extra = field_end;
+    }
+
+    entry->offset_ += bias_;
+
+    if (entry->method_ != Entry::METHOD::STORED &&
+        entry->method_ != Entry::METHOD::DEFLATED)
+    {
+      LIEF_WARN("'{}': compression method {} is not supported", entry->name_, hdr.method);
+    }
+
+    if (!parse_local_header(*entry, compressed_size)) {
+      LIEF_WARN("Can't resolve the data of '{}'", entry->name_);
+    }
+    archive_->entries_.push_back(std::move(entry));
+    pos = next;
+  }
+  return ok();
+}
+
+ok_error_t Parser::parse_local_header(Entry& entry, uint64_t compressed_size) {
+  auto hdr = stream_->peek<details::local_header_t>(entry.offset_);
+  if (!hdr || hdr->magic != details::LOCAL_HEADER_MAGIC) {
+    LIEF_ERR("Corrupted local header at 0x{:x}", entry.offset_);
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  // The name and the extra field of the local header can differ from the
+  // central directory (e.g. zipalign pads the local extra field)
+  const uint64_t data_offset = entry.offset_ + sizeof(details::local_header_t) +
+                               hdr->name_len + hdr->extra_len;
+  const uint64_t size = stream_->size();
+  if (data_offset > size || compressed_size > size - data_offset) {
+    LIEF_ERR("Data of '{}' out of bounds", entry.name_);
+    return make_error_code(lief_errors::corrupted);
+  }
+  entry.data_offset_ = data_offset;
+  entry.raw_ = span<const uint8_t>(archive_->data_.data() + data_offset,
+                                   compressed_size);
+  return ok();
+}
+
+}
+}
@@ -0,0 +1,112 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ZIP_STRUCTURES_H
+#define LIEF_ZIP_STRUCTURES_H
+#include <cstdint>
+
+namespace LIEF {
+namespace ZIP {
+namespace details {
+
+static constexpr uint32_t LOCAL_HEADER_MAGIC   = 0x04034b50;
+static constexpr uint32_t CENTRAL_HEADER_MAGIC = 0x02014b50;
+static constexpr uint32_t EOCD_MAGIC           = 0x06054b50;
+static constexpr uint32_t EOCD64_MAGIC         = 0x06064b50;
+static constexpr uint32_t EOCD64_LOCATOR_MAGIC = 0x07064b50;
+
+static constexpr uint16_t ZIP64_EXTRA_ID = 0x0001;
+static constexpr uint16_t FLAG_ENCRYPTED = 1 << 0;
+
+// The EOCD record is followed by a comment of at most 64KB
+static constexpr uint32_t MAX_COMMENT_SIZE = 0xffff;
+
+#pragma pack(push,1)
+struct local_header_t {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t flags;
+  uint16_t method;
+  uint16_t mtime;
+  uint16_t mdate;
+  uint32_t crc32;
+  uint32_t compressed_size;
+  uint32_t size;
+  uint16_t name_len;
+  uint16_t extra_len;
+};
+
+struct central_header_t {
+  uint32_t magic;
+  uint16_t version_made_by;
+  uint16_t version;
+  uint16_t flags;
+  uint16_t method;
+  uint16_t mtime;
+  uint16_t mdate;
+  uint32_t crc32;
+  uint32_t compressed_size;
+  uint32_t size;
+  uint16_t name_len;
+  uint16_t extra_len;
+  uint16_t comment_len;
+  uint16_t disk;
+  uint16_t internal_attr;
+  uint32_t external_attr;
+  uint32_t local_header_offset;
+};
+
+struct eocd_t {
+  uint32_t magic;
+  uint16_t disk;
+  uint16_t cd_disk;
+  uint16_t nb_entries_disk;
+  uint16_t nb_entries;
+  uint32_t cd_size;
+  uint32_t cd_offset;
+  uint16_t comment_len;
+};
+
+struct eocd64_locator_t {
+  uint32_t magic;
+  uint32_t disk;
+  uint64_t eocd64_offset;
+  uint32_t nb_disks;
+};
+
+struct eocd64_t {
+  uint32_t magic;
+  uint64_t record_size;
+  uint16_t version_made_by;
+  uint16_t version;
+  uint32_t disk;
+  uint32_t cd_disk;
+  uint64_t nb_entries_disk;
+  uint64_t nb_entries;
+  uint64_t cd_size;
+  uint64_t cd_offset;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(local_header_t)   == 30, "Wrong local_header_t size");
+static_assert(sizeof(central_header_t) == 46, "Wrong central_header_t size");
+static_assert(sizeof(eocd_t)           == 22, "Wrong eocd_t size");
+static_assert(sizeof(eocd64_locator_t) == 20, "Wrong eocd64_locator_t size");
+static_assert(sizeof(eocd64_t)         == 56, "Wrong eocd64_t size");
+
+}
+}
+}
+#endif
@@ -0,0 +1,74 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+
+#include "LIEF/ZIP/utils.hpp"
+#include "LIEF/BinaryStream/FileStream.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
+
+#include "ZIP/Structures.hpp"
+
+namespace LIEF {
+namespace ZIP {
+
+namespace {
+constexpr std::array<uint32_t, 256> make_crc_table() {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < table.size(); ++i) {
+    uint32_t c = i;
+    for (size_t k = 0; k < 8; ++k) {
+      c = (c & 1) ? 0xedb88320 ^ (c >> 1) : (c >> 1);
+    }
+    table[i] = c;
+  }
+  return table;
+}
+
+static constexpr std::array<uint32_t, 256> CRC_TABLE = make_crc_table();
+}
+
+bool is_zip(BinaryStream& stream) {
+  if (auto magic = stream.peek<uint32_t>(0)) {
+    return *magic == details::LOCAL_HEADER_MAGIC ||
+           *magic == details::EOCD_MAGIC;
+  }
+  return false;
+}
+
+bool is_zip(const std::string& file) {
+  if (auto stream = FileStream::from_file(file)) {
+    return is_zip(*stream);
+  }
+  return false;
+}
+
+bool is_zip(const std::vector<uint8_t>& raw) {
+  if (auto stream = SpanStream::from_vector(raw)) {
+    return is_zip(*stream);
+  }
+  return false;
+}
+
+uint32_t crc32(span<const uint8_t> data, uint32_t crc) {
+  crc = ~crc;
+  for (uint8_t byte : data) {
+    crc = CRC_TABLE[(crc ^ byte) & 0xff] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+}
+}
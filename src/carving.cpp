@@ -0,0 +1,598 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <spdlog/fmt/fmt.h>
+
+#include "logging.hpp"
+#include "frozen.hpp"
+#include "parallel.hpp"
+
+#include "LIEF/carving.hpp"
+#include "LIEF/Abstract/Parser.hpp"
+#include "LIEF/Abstract/Binary.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
+
+namespace LIEF {
+namespace carving {
+
+namespace {
+
+//! Bounded, header-only view on the blob at a given candidate offset
+class probe_t {
+  public:
+  probe_t(span<const uint8_t> blob, uint64_t offset) :
+    data_(blob.data() + offset),
+    size_(blob.size() - offset)
+  {}
+
+  uint64_t avail() const {
+    return size_;
+  }
+
+  bool has(uint64_t offset, uint64_t size) const {
+    return offset <= size_ && size <= size_ - offset;
+  }
+
+  template<class T>
+  T read(uint64_t offset, bool big_endian = false) const {
+    T value = 0;
+    if (!has(offset, sizeof(T))) {
+      return value;
+    }
+    uint8_t raw[sizeof(T)];
+    std::memcpy(raw, data_ + offset, sizeof(T));
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      const size_t idx = big_endian ? i : sizeof(T) - i - 1;
+      value = static_cast<T>((static_cast<uint64_t>(value) << 8) | raw[idx]);
+    }
+    return value;
+  }
+
+  bool match(uint64_t offset, const char* magic, size_t size) const {
+    return has(offset, size) && std::memcmp(data_ + offset, magic, size) == 0;
+  }
+
+  private:
+  const uint8_t* data_ = nullptr;
+  uint64_t size_ = 0;
+};
+
+struct probe_result_t {
+  uint64_t size = 0;
+  CONFIDENCE confidence = CONFIDENCE::HIGH;
+
+  //! Extend the candidate with the range [offset, offset + size). A range
+  //! that goes beyond the blob downgrades the confidence.
+  void extend(const probe_t& probe, uint64_t offset, uint64_t size) {
+    const uint64_t end = offset + size;
+    if (end < offset) {
+      confidence = CONFIDENCE::LOW;
+      return;
+    }
+    if (!probe.has(offset, size)) {
+      confidence = std::min(confidence, CONFIDENCE::MEDIUM);
+    }
+    this->size = std::max(this->size, end);
+  }
+};
+
+// ELF
+// ============================================================================
+bool probe_elf(const probe_t& probe, probe_result_t& res) {
+  static constexpr uint8_t ELFCLASS32 = 1;
+  static constexpr uint8_t ELFCLASS64 = 2;
+  static constexpr uint32_t SHT_NULL   = 0;
+  static constexpr uint32_t SHT_NOBITS = 8;
+
+  const auto ei_class = probe.read<uint8_t>(4);
+  const auto ei_data  = probe.read<uint8_t>(5);
+  if ((ei_class != ELFCLASS32 && ei_class != ELFCLASS64) ||
+      (ei_data != 1 && ei_data != 2) || probe.read<uint8_t>(6) != 1)
+  {
+    return false;
+  }
+
+  const bool is64 = ei_class == ELFCLASS64;
+  const bool be   = ei_data == 2;
+  const uint64_t ehsize = is64 ? 64 : 52;
+  if (!probe.has(0, ehsize)) {
+    return false;
+  }
+
+  const auto e_type    = probe.read<uint16_t>(16, be);
+  const auto e_version = probe.read<uint32_t>(20, be);
+  if (e_version != 1 || (e_type > 4 && e_type < 0xfe00)) {
+    return false;
+  }
+
+  const uint64_t e_phoff     = is64 ? probe.read<uint64_t>(32, be) : probe.read<uint32_t>(28, be);
+  const uint64_t e_shoff     = is64 ? probe.read<uint64_t>(40, be) : probe.read<uint32_t>(32, be);
+  const uint16_t e_ehsize    = probe.read<uint16_t>(is64 ? 52 : 40, be);
+  const uint16_t e_phentsize = probe.read<uint16_t>(is64 ? 54 : 42, be);
+  const uint16_t e_phnum     = probe.read<uint16_t>(is64 ? 56 : 44, be);
+  const uint16_t e_shentsize = probe.read<uint16_t>(is64 ? 58 : 46, be);
+  const uint16_t e_shnum     = probe.read<uint16_t>(is64 ? 60 : 48, be);
+
+  const uint64_t phentsize = is64 ? 56 : 32;
+  const uint64_t shentsize = is64 ? 64 : 40;
+
+  if (e_ehsize != ehsize ||
+      (e_phnum > 0 && e_phentsize != phentsize) ||
+      (e_shnum > 0 && e_shentsize != shentsize))
+  {
+    return false;
+  }
+
+  res.size = ehsize;
+  if (e_phnum == 0 && e_shnum == 0) {
+    res.confidence = CONFIDENCE::LOW;
+    return true;
+  }
+
+  if (e_phnum > 0) {
+    const uint64_t table_size = e_phnum * phentsize;
+    res.extend(probe, e_phoff, table_size);
+    if (probe.has(e_phoff, table_size)) {
+      for (size_t i = 0; i < e_phnum; ++i) {
+        const uint64_t base = e_phoff + i * phentsize;
+        const uint64_t p_offset = is64 ? probe.read<uint64_t>(base + 8, be) :
+                                         probe.read<uint32_t>(base + 4, be);
+        const uint64_t p_filesz = is64 ? probe.read<uint64_t>(base + 32, be) :
+                                         probe.read<uint32_t>(base + 16, be);
+        res.extend(probe, p_offset, p_filesz);
+      }
+    }
+  }
+
+  if (e_shnum > 0) {
+    const uint64_t table_size = e_shnum * shentsize;
+    res.extend(probe, e_shoff, table_size);
+    if (probe.has(e_shoff, table_size)) {
+      for (size_t i = 0; i < e_shnum; ++i) {
+        const uint64_t base = e_shoff + i * shentsize;
+        const auto sh_type = probe.read<uint32_t>(base + 4, be);
+        if (sh_type == SHT_NULL || sh_type == SHT_NOBITS) {
+          continue;
+        }
+        const uint64_t sh_offset = is64 ? probe.read<uint64_t>(base + 24, be) :
+                                          probe.read<uint32_t>(base + 16, be);
+        const uint64_t sh_size   = is64 ? probe.read<uint64_t>(base + 32, be) :
+                                          probe.read<uint32_t>(base + 20, be);
+        res.extend(probe, sh_offset, sh_size);
+      }
+    }
+  }
+  return true;
+}
+
+// PE
+// ============================================================================
+bool probe_pe(const probe_t& probe, probe_result_t& res) {
+  static constexpr uint16_t PE32     = 0x10b;
+  static constexpr uint16_t PE32PLUS = 0x20b;
+  static constexpr uint32_t MAX_LFANEW = 0x1000000;
+  static constexpr size_t SECURITY_DIR = 4;
+
+  const auto e_lfanew = probe.read<uint32_t>(0x3c);
+  if (e_lfanew < 4 || e_lfanew > MAX_LFANEW ||
+      !probe.match(e_lfanew, "PE\0\0", 4) || !probe.has(e_lfanew, 24 + 2))
+  {
+    return false;
+  }
+
+  const uint64_t coff = e_lfanew + 4;
+  const auto nb_sections = probe.read<uint16_t>(coff + 2);
+  const auto sizeof_opt  = probe.read<uint16_t>(coff + 16);
+  const uint64_t opt = coff + 20;
+  const auto magic = probe.read<uint16_t>(opt);
+  if (magic != PE32 && magic != PE32PLUS) {
+    return false;
+  }
+
+  const auto sizeof_headers = probe.read<uint32_t>(opt + 60);
+  res.extend(probe, 0, std::max<uint64_t>(sizeof_headers, opt + sizeof_opt));
+
+  const uint64_t sections = opt + sizeof_opt;
+  const uint64_t table_size = nb_sections * 40ull;
+  res.extend(probe, sections, table_size);
+  if (!probe.has(sections, table_size)) {
+    return true;
+  }
+
+  for (size_t i = 0; i < nb_sections; ++i) {
+    const uint64_t base = sections + i * 40;
+    const auto size = probe.read<uint32_t>(base + 16);
+    const auto offset = probe.read<uint32_t>(base + 20);
+    if (size > 0) {
+      res.extend(probe, offset, size);
+    }
+  }
+
+  // The Authenticode signature is not mapped and is usually
+  // located after the last section
+  const uint64_t nb_dirs = probe.read<uint32_t>(opt + (magic == PE32 ? 92 : 108));
+  const uint64_t dirs = opt + (magic == PE32 ? 96 : 112);
+  if (nb_dirs > SECURITY_DIR && dirs + (SECURITY_DIR + 1) * 8 <= sections) {
+    const auto offset = probe.read<uint32_t>(dirs + SECURITY_DIR * 8);
+    const auto size = probe.read<uint32_t>(dirs + SECURITY_DIR * 8 + 4);
+    if (offset > 0 && size > 0) {
+      res.extend(probe, offset, size);
+    }
+  }
+  return true;
+}
+
+// Mach-O
+// ============================================================================
+bool probe_macho(const probe_t& probe, probe_result_t& res) {
+  static constexpr uint32_t MH_MAGIC    = 0xfeedface;
+  static constexpr uint32_t MH_MAGIC_64 = 0xfeedfacf;
+  static constexpr uint32_t LC_SEGMENT        = 0x01;
+  static constexpr uint32_t LC_SYMTAB         = 0x02;
+  static constexpr uint32_t LC_SEGMENT_64     = 0x19;
+  static constexpr uint32_t LC_CODE_SIGNATURE = 0x1d;
+  static constexpr uint32_t MAX_FILETYPE = 0x0c; // MH_FILESET
+
+  const auto magic_le = probe.read<uint32_t>(0);
+  const auto magic_be = probe.read<uint32_t>(0, /*big_endian=*/true);
+  bool be = false;
+  bool is64 = false;
+  if (magic_le == MH_MAGIC || magic_le == MH_MAGIC_64) {
+    is64 = magic_le == MH_MAGIC_64;
+  } else if (magic_be == MH_MAGIC || magic_be == MH_MAGIC_64) {
+    is64 = magic_be == MH_MAGIC_64;
+    be = true;
+  } else {
+    return false;
+  }
+
+  const uint64_t header_size = is64 ? 32 : 28;
+  if (!probe.has(0, header_size)) {
+    return false;
+  }
+
+  const auto filetype   = probe.read<uint32_t>(12, be);
+  const auto ncmds      = probe.read<uint32_t>(16, be);
+  const auto sizeofcmds = probe.read<uint32_t>(20, be);
+  if (filetype == 0 || filetype > MAX_FILETYPE || ncmds == 0 ||
+      sizeofcmds < ncmds * 8ull)
+  {
+    return false;
+  }
+
+  res.extend(probe, 0, header_size + sizeofcmds);
+  if (!probe.has(header_size, sizeofcmds)) {
+    return true;
+  }
+
+  const uint64_t end_cmds = header_size + sizeofcmds;
+  uint64_t cmd_off = header_size;
+  for (size_t i = 0; i < ncmds; ++i) {
+    const auto cmd     = probe.read<uint32_t>(cmd_off, be);
+    const auto cmdsize = probe.read<uint32_t>(cmd_off + 4, be);
+    if (cmdsize < 8 || (cmdsize % 4) != 0 || cmd_off + cmdsize > end_cmds) {
+      res.confidence = CONFIDENCE::LOW;
+      return true;
+    }
+    switch (cmd) {
+      case LC_SEGMENT:
+        {
+          const auto fileoff  = probe.read<uint32_t>(cmd_off + 32, be);
+          const auto filesize = probe.read<uint32_t>(cmd_off + 36, be);
+          res.extend(probe, fileoff, filesize);
+          break;
+        }
+      case LC_SEGMENT_64:
+        {
+          const auto fileoff  = probe.read<uint64_t>(cmd_off + 40, be);
+          const auto filesize = probe.read<uint64_t>(cmd_off + 48, be);
+          res.extend(probe, fileoff, filesize);
+          break;
+        }
+      case LC_SYMTAB:
+        {
+          const auto symoff  = probe.read<uint32_t>(cmd_off + 8, be);
+          const auto nsyms   = probe.read<uint32_t>(cmd_off + 12, be);
+          const auto stroff  = probe.read<uint32_t>(cmd_off + 16, be);
+          const auto strsize = probe.read<uint32_t>(cmd_off + 20, be);
+          res.extend(probe, symoff, nsyms * (is64 ? 16ull : 12ull));
+          res.extend(probe, stroff, strsize);
+          break;
+        }
+      case LC_CODE_SIGNATURE:
+        {
+          const auto dataoff  = probe.read<uint32_t>(cmd_off + 8, be);
+          const auto datasize = probe.read<uint32_t>(cmd_off + 12, be);
+          res.extend(probe, dataoff, datasize);
+          break;
+        }
+      default:
+        break;
+    }
+    cmd_off += cmdsize;
+  }
+  return true;
+}
+
+bool probe_fat(const probe_t& probe, probe_result_t& res) {
+  static constexpr uint32_t FAT_MAGIC    = 0xcafebabe;
+  static constexpr uint32_t FAT_MAGIC_64 = 0xcafebabf;
+  // Java class files share the FAT magic but their version (at the same
+  // location as nfat_arch) is greater than this value.
+  static constexpr uint32_t MAX_ARCHS = 30;
+
+  const auto magic = probe.read<uint32_t>(0, /*big_endian=*/true);
+  if (magic != FAT_MAGIC && magic != FAT_MAGIC_64) {
+    return false;
+  }
+  const bool is64 = magic == FAT_MAGIC_64;
+  const auto nfat_arch = probe.read<uint32_t>(4, /*big_endian=*/true);
+  if (nfat_arch == 0 || nfat_arch > MAX_ARCHS) {
+    return false;
+  }
+  const uint64_t arch_size = is64 ? 32 : 20;
+  if (!probe.has(8, nfat_arch * arch_size)) {
+    return false;
+  }
+
+  res.size = 8 + nfat_arch * arch_size;
+  for (size_t i = 0; i < nfat_arch; ++i) {
+    const uint64_t base = 8 + i * arch_size;
+    const uint64_t offset = is64 ? probe.read<uint64_t>(base + 8, true) :
+                                   probe.read<uint32_t>(base + 8, true);
+    const uint64_t size   = is64 ? probe.read<uint64_t>(base + 16, true) :
+                                   probe.read<uint32_t>(base + 12, true);
+    if (offset < res.size) {
+      return false;
+    }
+    res.extend(probe, offset, size);
+    if (!probe.has(offset, 4)) {
+      continue;
+    }
+    const auto slice_magic = probe.read<uint32_t>(offset);
+    if (slice_magic != 0xfeedface && slice_magic != 0xfeedfacf &&
+        slice_magic != 0xcefaedfe && slice_magic != 0xcffaedfe)
+    {
+      res.confidence = CONFIDENCE::LOW;
+    }
+  }
+  return true;
+}
+
+// DEX
+// ============================================================================
+bool probe_dex(const probe_t& probe, probe_result_t& res) {
+  static constexpr uint32_t HEADER_SIZE = 0x70;
+  static constexpr uint32_t ENDIAN_CONSTANT = 0x12345678;
+
+  // dex\n0XX\0
+  if (!probe.has(0, HEADER_SIZE) || probe.read<uint8_t>(7) != 0) {
+    return false;
+  }
+  for (size_t i = 4; i < 7; ++i) {
+    const auto c = probe.read<uint8_t>(i);
+    if (c < '0' || c > '9') {
+      return false;
+    }
+  }
+
+  const auto file_size   = probe.read<uint32_t>(0x20);
+  const auto header_size = probe.read<uint32_t>(0x24);
+  const auto endian_tag  = probe.read<uint32_t>(0x28);
+  const auto map_off     = probe.read<uint32_t>(0x34);
+  const auto data_size   = probe.read<uint32_t>(0x68);
+  const auto data_off    = probe.read<uint32_t>(0x6c);
+
+  if (header_size != HEADER_SIZE || endian_tag != ENDIAN_CONSTANT ||
+      file_size < HEADER_SIZE)
+  {
+    return false;
+  }
+
+  res.extend(probe, 0, file_size);
+  if (map_off >= file_size || uint64_t(data_off) + data_size > file_size) {
+    res.confidence = CONFIDENCE::LOW;
+  }
+  return true;
+}
+
+using probe_fn_t = bool(*)(const probe_t&, probe_result_t&);
+
+struct magic_t {
+  std::array<uint8_t, 4> value;
+  FORMAT format;
+  probe_fn_t probe;
+  size_t size;
+};
+
+static constexpr magic_t MAGICS[] = {
+  {{0x7f, 'E',  'L',  'F' }, FORMAT::ELF,       probe_elf,   4},
+  {{'M',  'Z',  0,    0   }, FORMAT::PE,        probe_pe,    2},
+  {{0xce, 0xfa, 0xed, 0xfe}, FORMAT::MACHO,     probe_macho, 4},
+  {{0xcf, 0xfa, 0xed, 0xfe}, FORMAT::MACHO,     probe_macho, 4},
+  {{0xfe, 0xed, 0xfa, 0xce}, FORMAT::MACHO,     probe_macho, 4},
+  {{0xfe, 0xed, 0xfa, 0xcf}, FORMAT::MACHO,     probe_macho, 4},
+  {{0xca, 0xfe, 0xba, 0xbe}, FORMAT::MACHO_FAT, probe_fat,   4},
+  {{0xca, 0xfe, 0xba, 0xbf}, FORMAT::MACHO_FAT, probe_fat,   4},
+  {{'d',  'e',  'x',  '\n'}, FORMAT::DEX,       probe_dex,   4},
+};
+
+void check_candidate(span<const uint8_t> blob, uint64_t offset,
+                     const config_t& config, std::vector<Candidate>& out)
+{
+  const uint8_t* ptr = blob.data() + offset;
+  const uint64_t avail = blob.size() - offset;
+  for (const magic_t& magic : MAGICS) {
+    if (magic.size > avail || std::memcmp(ptr, magic.value.data(), magic.size) != 0) {
+      continue;
+    }
+    probe_t probe(blob, offset);
+    probe_result_t res;
+    if (!magic.probe(probe, res)) {
+      continue;
+    }
+    if (res.size > avail) {
+      res.size = avail;
+      res.confidence = std::min(res.confidence, CONFIDENCE::MEDIUM);
+    }
+    if (res.confidence < config.min_confidence) {
+      continue;
+    }
+    out.emplace_back(magic.format, res.confidence, offset,
+                     blob.subspan(offset, res.size));
+    return;
+  }
+}
+
+}
+
+std::vector<Candidate> scan(span<const uint8_t> blob, const config_t& config) {
+  std::vector<Candidate> candidates;
+  if (blob.empty()) {
+    return candidates;
+  }
+
+  const uint8_t* start = blob.data();
+  const uint8_t* end = start + blob.size();
+  const uint32_t alignment = std::max<uint32_t>(config.alignment, 1);
+
+  if (alignment > 1) {
+    // First-byte filter on the aligned offsets only
+    std::array<bool, 256> leads = {};
+    for (const magic_t& magic : MAGICS) {
+      leads[magic.value[0]] = true;
+    }
+    for (uint64_t offset = 0; offset < blob.size(); offset += alignment) {
+      if (leads[start[offset]]) {
+        check_candidate(blob, offset, config, candidates);
+      }
+    }
+  } else {
+    // Locate the leading byte of the magics with memchr() which is
+    // vectorized by the libc, then check the full magic + header.
+    std::array<uint8_t, 256> done = {};
+    for (const magic_t& magic : MAGICS) {
+      const uint8_t lead = magic.value[0];
+      if (done[lead]++ != 0) {
+        continue;
+      }
+      for (const uint8_t* ptr = start;
+           (ptr = static_cast<const uint8_t*>(std::memchr(ptr, lead, end - ptr))) != nullptr;
+           ++ptr)
+      {
+        check_candidate(blob, ptr - start, config, candidates);
+      }
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end(),
+    [] (const Candidate& lhs, const Candidate& rhs) {
+      return lhs.offset() < rhs.offset();
+    }
+  );
+
+  if (config.nested) {
+    return candidates;
+  }
+
+  // Only the candidates with a reliable extent can shadow the others
+  std::vector<Candidate> filtered;
+  filtered.reserve(candidates.size());
+  uint64_t covered = 0;
+  for (const Candidate& C : candidates) {
+    if (C.offset() < covered) {
+      LIEF_DEBUG("Skipping {} at 0x{:06x} (nested)", to_string(C.format()), C.offset());
+      continue;
+    }
+    if (C.confidence() == CONFIDENCE::HIGH) {
+      covered = C.offset() + C.size();
+    }
+    filtered.push_back(C);
+  }
+  return filtered;
+}
+
+std::vector<std::unique_ptr<Binary>>
+parse(const std::vector<Candidate>& candidates, uint32_t nb_threads) {
+  std::vector<std::unique_ptr<Binary>> binaries(candidates.size());
+  parallel_for(candidates.size(), nb_threads, [&] (size_t i) {
+    binaries[i] = candidates[i].parse();
+  });
+  return binaries;
+}
+
+std::unique_ptr<SpanStream> Candidate::stream() const {
+  return std::make_unique<SpanStream>(content_);
+}
+
+std::unique_ptr<Binary> Candidate::parse() const {
+  switch (format_) {
+    case FORMAT::ELF:
+    case FORMAT::PE:
+    case FORMAT::MACHO:
+    case FORMAT::MACHO_FAT:
+      return Parser::parse(stream());
+    case FORMAT::DEX:
+    case FORMAT::UNKNOWN:
+      return nullptr;
+  }
+  return nullptr;
+}
+
+std::ostream& operator<<(std::ostream& os, const Candidate& C) {
+  os << fmt::format("0x{:08x} 0x{:08x} {} ({})", C.offset(), C.size(),
+                    to_string(C.format()), to_string(C.confidence()));
+  return os;
+}
+
+const char* to_string(FORMAT e) {
+  #define ENTRY(X) std::pair(FORMAT::X, #X)
+  STRING_MAP enums2str {
+    ENTRY(UNKNOWN),
+    ENTRY(ELF),
+    ENTRY(PE),
+    ENTRY(MACHO),
+    ENTRY(MACHO_FAT),
+    ENTRY(DEX),
+  };
+  #undef ENTRY
+
+  if (auto it = enums2str.find(e); it != enums2str.end()) {
+    return it->second;
+  }
+  return "UNKNOWN";
+}
+
+const char* to_string(CONFIDENCE e) {
+  #define ENTRY(X) std::pair(CONFIDENCE::X, #X)
+  STRING_MAP enums2str {
+    ENTRY(LOW),
+    ENTRY(MEDIUM),
+    ENTRY(HIGH),
+  };
+  #undef ENTRY
+
+  if (auto it = enums2str.find(e); it != enums2str.end()) {
+    return it->second;
+  }
+  return "UNKNOWN";
+}
+
+}
+}
@@ -0,0 +1,1142 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "logging.hpp"
+#include "frozen.hpp"
+#include "parallel.hpp"
+
+#include "LIEF/config.h"
+#include "LIEF/checksec.hpp"
+#include "LIEF/utils.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
+
+#if defined(LIEF_ELF_SUPPORT)
+#include "LIEF/ELF/DynamicEntry.hpp"
+#include "LIEF/ELF/Header.hpp"
+#include "LIEF/ELF/Segment.hpp"
+#include "LIEF/ELF/utils.hpp"
+#include "ELF/Structures.hpp"
+#endif
+
+#if defined(LIEF_PE_SUPPORT)
+#include "LIEF/PE/DataDirectory.hpp"
+#include "LIEF/PE/OptionalHeader.hpp"
+#include "LIEF/PE/debug/Debug.hpp"
+#include "PE/Structures.hpp"
+#endif
+
+#if defined(LIEF_MACHO_SUPPORT)
+#include "LIEF/MachO/Header.hpp"
+#include "LIEF/MachO/LoadCommand.hpp"
+#include "LIEF/MachO/enums.hpp"
+#include "MachO/Structures.hpp"
+#endif
+
+namespace LIEF {
+namespace checksec {
+
+namespace {
+// Upper bound on the number of imported symbols that are inspected
+static constexpr uint64_t MAX_IMPORTS = 0x100000;
+
+//! Stream over a file that loads (and caches) only the blocks which are
+//! accessed. Contrary to FileStream, small reads (e.g. strings read byte per
+//! byte) don't hit the file.
+class FileBlockStream : public BinaryStream {
+  public:
+  static constexpr uint64_t BLOCK_SIZE = 0x1000;
+  static constexpr size_t MAX_BLOCKS = 0x100;
+
+  FileBlockStream(std::ifstream ifs, uint64_t size) :
+    BinaryStream(STREAM_TYPE::UNKNOWN),
+    ifs_(std::move(ifs)),
+    size_(size)
+  {}
+
+  uint64_t size() const override {
+    return size_;
+  }
+
+  ok_error_t peek_in(void* dst, uint64_t offset, uint64_t size,
+                     uint64_t /* virtual_address */= 0) const override
+  {
+    if (offset > size_ || size > size_ - offset) {
+      return make_error_code(lief_errors::read_error);
+    }
+    auto* out = static_cast<uint8_t*>(dst);
+    while (size > 0) {
+      const uint8_t* data = block(offset / BLOCK_SIZE);
+      if (data == nullptr) {
+        return make_error_code(lief_errors::read_error);
+      }
+      const uint64_t delta = offset % BLOCK_SIZE;
+      const uint64_t len = std::min(size, BLOCK_SIZE - delta);
+      std::memcpy(out, data + delta, len);
+      out += len;
+      offset += len;
+      size -= len;
+    }
+    return ok();
+  }
+
+  result<const void*> read_at(uint64_t, uint64_t, uint64_t) const override {
+    return make_error_code(lief_errors::not_supported);
+  }
+
+  private:
+  const uint8_t* block(uint64_t idx) const {
+    if (last_ != nullptr && idx == last_idx_) {
+      return last_;
+    }
+    auto it = blocks_.find(idx);
+    if (it == blocks_.end()) {
+      if (blocks_.size() >= MAX_BLOCKS) {
+        blocks_.clear();
+      }
+      const uint64_t start = idx * BLOCK_SIZE;
+      std::vector<uint8_t> data(std::min(BLOCK_SIZE, size_ - start));
+      ifs_.seekg(start);
+      if (!ifs_.read(reinterpret_cast<char*>(data.data()), data.size())) {
+        ifs_.clear();
+        return nullptr;
+      }
+      it = blocks_.emplace(idx, std::move(data)).first;
+    }
+    last_idx_ = idx;
+    last_ = it->second.data();
+    return last_;
+  }
+
+  mutable std::ifstream ifs_;
+  uint64_t size_ = 0;
+  mutable std::unordered_map<uint64_t, std::vector<uint8_t>> blocks_;
+  mutable uint64_t last_idx_ = 0;
+  mutable const uint8_t* last_ = nullptr;
+};
+
+//! Update the report with the name of an imported symbol
+void check_import(const std::string& name, report_t& report) {
+  static constexpr char CHK_SUFFIX[] = "_chk";
+  static constexpr size_t CHK_LEN = sizeof(CHK_SUFFIX) - 1;
+
+  if (name == "__stack_chk_fail" || name == "__stack_chk_guard" ||
+      name == "__intel_security_cookie")
+  {
+    report.properties |= PROPERTY::CANARY;
+    return;
+  }
+
+  // glibc, bionic and the Apple libc expose the fortified functions as
+  // __<function>_chk
+  if (name.size() > 2 + CHK_LEN && name.compare(0, 2, "__") == 0 &&
+      name.compare(name.size() - CHK_LEN, CHK_LEN, CHK_SUFFIX) == 0)
+  {
+    report.properties |= PROPERTY::FORTIFY;
+  }
+}
+
+#if defined(LIEF_ELF_SUPPORT)
+// ELF
+// ============================================================================
+
+// Imports looked up with DT_HASH when DT_GNU_HASH is not present
+static constexpr std::array CANARY_IMPORTS = {
+  "__stack_chk_fail", "__stack_chk_guard", "__intel_security_cookie",
+};
+
+static constexpr std::array FORTIFY_IMPORTS = {
+  "__memcpy_chk", "__memmove_chk", "__mempcpy_chk", "__memset_chk",
+  "__stpcpy_chk", "__stpncpy_chk", "__strcat_chk", "__strcpy_chk",
+  "__strncat_chk", "__strncpy_chk", "__strlcat_chk", "__strlcpy_chk",
+  "__strlen_chk", "__strchr_chk", "__strrchr_chk",
+  "__sprintf_chk", "__snprintf_chk", "__vsprintf_chk", "__vsnprintf_chk",
+  "__printf_chk", "__fprintf_chk", "__vprintf_chk", "__vfprintf_chk",
+  "__dprintf_chk", "__vdprintf_chk", "__asprintf_chk", "__vasprintf_chk",
+  "__syslog_chk", "__vsyslog_chk",
+  "__read_chk", "__pread_chk", "__pread64_chk", "__readlink_chk",
+  "__readlinkat_chk", "__recv_chk", "__recvfrom_chk",
+  "__fgets_chk", "__fgets_unlocked_chk", "__fread_chk", "__fread_unlocked_chk",
+  "__getcwd_chk", "__getwd_chk", "__realpath_chk", "__gets_chk",
+  "__wcscpy_chk", "__wmemcpy_chk", "__wmemset_chk", "__swprintf_chk",
+  "__poll_chk", "__ppoll_chk", "__fdelt_chk", "__longjmp_chk",
+  "__explicit_bzero_chk",
+};
+
+static constexpr uint32_t DF_BIND_NOW = 0x00000008;
+static constexpr uint32_t DF_1_NOW    = 0x00000001;
+static constexpr uint32_t DF_1_PIE    = 0x08000000;
+static constexpr uint32_t PF_X        = 0x1;
+static constexpr uint16_t SHN_UNDEF   = 0;
+
+static constexpr uint32_t NT_GNU_PROPERTY_TYPE_0 = 5;
+static constexpr uint32_t GNU_PROPERTY_AARCH64_FEATURE_1_AND = 0xc0000000;
+static constexpr uint32_t GNU_PROPERTY_X86_FEATURE_1_AND     = 0xc0000002;
+
+// Upper bound on the size of the notes that are inspected
+static constexpr uint64_t MAX_NOTES_SIZE = 0x10000;
+
+struct load_t {
+  uint64_t offset;
+  uint64_t address;
+  uint64_t size;
+};
+
+result<uint64_t> va2offset(const std::vector<load_t>& loads, uint64_t address) {
+  for (const load_t& load : loads) {
+    if (load.address <= address && address - load.address < load.size) {
+      return load.offset + (address - load.address);
+    }
+  }
+  return make_error_code(lief_errors::conversion_error);
+}
+
+constexpr bool is_host_big_endian() {
+  #if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__)
+    return __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+  #else
+    return false;
+  #endif
+}
+
+//! Check the GNU properties of the notes located in [offset, offset + size)
+void elf_gnu_properties(BinaryStream& stream, uint64_t offset, uint64_t size,
+                        uint64_t alignment, ELF::ARCH arch, report_t& report)
+{
+  alignment = alignment == 8 ? 8 : 4;
+  const uint64_t end = offset + std::min(size, MAX_NOTES_SIZE);
+  uint64_t cursor = offset;
+  while (cursor + 3 * sizeof(uint32_t) <= end) {
+    auto namesz = stream.peek_conv<uint32_t>(cursor);
+    auto descsz = stream.peek_conv<uint32_t>(cursor + 4);
+    auto type   = stream.peek_conv<uint32_t>(cursor + 8);
+    if (!namesz || !descsz || !type) {
+      return;
+    }
+    const uint64_t name_off = cursor + 3 * sizeof(uint32_t);
+    const uint64_t desc_off = align(name_off + *namesz, alignment);
+    const uint64_t desc_end = desc_off + *descsz;
+    if (desc_end > end) {
+      return;
+    }
+
+    if (*namesz == 4 && *type == NT_GNU_PROPERTY_TYPE_0) {
+      auto name = stream.peek<std::array<char, 4>>(name_off);
+      if (name && std::memcmp(name->data(), "GNU", 4) == 0) {
+        uint64_t prop = desc_off;
+        while (prop + 2 * sizeof(uint32_t) <= desc_end) {
+          auto pr_type   = stream.peek_conv<uint32_t>(prop);
+          auto pr_datasz = stream.peek_conv<uint32_t>(prop + 4);
+          if (!pr_type || !pr_datasz) {
+            return;
+          }
+          if (*pr_datasz >= sizeof(uint32_t)) {
+            auto value = stream.peek_conv<uint32_t>(prop + 8);
+            const uint32_t features = value ? *value : 0;
+            if (*pr_type == GNU_PROPERTY_X86_FEATURE_1_AND &&
+                (arch == ELF::ARCH::X86_64 || arch == ELF::ARCH::I386))
+            {
+              if (features & 0x1) { report.properties |= PROPERTY::IBT; }
+              if (features & 0x2) { report.properties |= PROPERTY::SHSTK; }
+            }
+            else if (*pr_type == GNU_PROPERTY_AARCH64_FEATURE_1_AND &&
+                     arch == ELF::ARCH::AARCH64)
+            {
+              if (features & 0x1) { report.properties |= PROPERTY::IBT; }
+              if (features & 0x2) { report.properties |= PROPERTY::PAC; }
+            }
+          }
+          prop += 2 * sizeof(uint32_t) + align(*pr_datasz, alignment);
+        }
+      }
+    }
+    cursor = align(desc_end, alignment);
+  }
+}
+
+template<class ELF_T>
+void elf_imports_gnu_hash(BinaryStream& stream, uint64_t symtab, uint64_t strtab,
+                          uint64_t strsz, uint64_t gnu_hash, report_t& report)
+{
+  using Elf_Sym = typename ELF_T::Elf_Sym;
+  // The symbols referenced by DT_GNU_HASH are the defined ones and the
+  // linkers sort them after the others: the imports are the symbols
+  // located before symndx
+  auto symndx = stream.peek_conv<uint32_t>(gnu_hash + sizeof(uint32_t));
+  if (!symndx) {
+    return;
+  }
+  report.checked |= PROPERTY::CANARY | PROPERTY::FORTIFY;
+  const uint64_t nb_symbols = std::min<uint64_t>(*symndx, MAX_IMPORTS);
+  for (size_t i = 1; i < nb_symbols; ++i) {
+    auto sym = stream.peek_conv<Elf_Sym>(symtab + i * sizeof(Elf_Sym));
+    if (!sym) {
+      break;
+    }
+    if (sym->st_shndx != SHN_UNDEF || sym->st_name == 0 ||
+        (strsz > 0 && sym->st_name >= strsz))
+    {
+      continue;
+    }
+    if (auto name = stream.peek_string_at(strtab + sym->st_name, /*maxsize=*/64)) {
+      check_import(*name, report);
+    }
+  }
+}
+
+template<class ELF_T>
+void elf_imports_hash(BinaryStream& stream, uint64_t symtab, uint64_t strtab,
+                      uint64_t strsz, uint64_t hash, report_t& report)
+{
+  using Elf_Sym = typename ELF_T::Elf_Sym;
+  auto nbucket = stream.peek_conv<uint32_t>(hash);
+  auto nchain  = stream.peek_conv<uint32_t>(hash + sizeof(uint32_t));
+  if (!nbucket || !nchain || *nbucket == 0) {
+    return;
+  }
+  report.checked |= PROPERTY::CANARY | PROPERTY::FORTIFY;
+
+  const uint64_t buckets = hash + 2 * sizeof(uint32_t);
+  const uint64_t chains  = buckets + uint64_t(*nbucket) * sizeof(uint32_t);
+
+  auto is_imported = [&] (const char* target) {
+    const size_t len = std::strlen(target);
+    const uint32_t h = ELF::hash32(target);
+    auto idx = stream.peek_conv<uint32_t>(buckets + (h % *nbucket) * sizeof(uint32_t));
+    for (uint32_t steps = 0; idx && *idx != 0 && *idx < *nchain && steps < *nchain; ++steps) {
+      auto sym = stream.peek_conv<Elf_Sym>(symtab + uint64_t(*idx) * sizeof(Elf_Sym));
+      if (!sym) {
+        return false;
+      }
+      if (strsz == 0 || sym->st_name < strsz) {
+        auto name = stream.peek_string_at(strtab + sym->st_name, len + 1);
+        if (name && *name == target) {
+          return sym->st_shndx == SHN_UNDEF;
+        }
+      }
+      idx = stream.peek_conv<uint32_t>(chains + uint64_t(*idx) * sizeof(uint32_t));
+    }
+    return false;
+  };
+
+  for (const char* name : CANARY_IMPORTS) {
+    if (is_imported(name)) {
+      report.properties |= PROPERTY::CANARY;
+      break;
+    }
+  }
+
+  for (const char* name : FORTIFY_IMPORTS) {
+    if (is_imported(name)) {
+      report.properties |= PROPERTY::FORTIFY;
+      break;
+    }
+  }
+}
+
+template<class ELF_T>
+ok_error_t audit_elf(BinaryStream& stream, report_t& report) {
+  using Elf_Ehdr = typename ELF_T::Elf_Ehdr;
+  using Elf_Phdr = typename ELF_T::Elf_Phdr;
+  using Elf_Dyn  = typename ELF_T::Elf_Dyn;
+  using Elf_Sym  = typename ELF_T::Elf_Sym;
+  using TAG = ELF::DynamicEntry::TAG;
+
+  auto hdr = stream.peek_conv<Elf_Ehdr>(0);
+  if (!hdr) {
+    return make_error_code(lief_errors::read_error);
+  }
+  if (hdr->e_phnum > 0 && hdr->e_phentsize != sizeof(Elf_Phdr)) {
+    LIEF_DEBUG("Wrong e_phentsize: {}", hdr->e_phentsize);
+    return make_error_code(lief_errors::corrupted);
+  }
+
+  const auto arch = static_cast<ELF::ARCH>(hdr->e_machine);
+  report.format = FORMAT::ELF;
+  report.checked |= PROPERTY::PIE | PROPERTY::NX | PROPERTY::RELRO |
+                    PROPERTY::BIND_NOW | PROPERTY::RPATH | PROPERTY::RUNPATH;
+  if (arch == ELF::ARCH::X86_64 || arch == ELF::ARCH::I386) {
+    report.checked |= PROPERTY::IBT | PROPERTY::SHSTK;
+  } else if (arch == ELF::ARCH::AARCH64) {
+    report.checked |= PROPERTY::IBT | PROPERTY::PAC;
+  }
+
+  std::vector<load_t> loads;
+  std::vector<Elf_Phdr> notes;
+  Elf_Phdr gnu_property{};
+  bool has_gnu_property = false;
+  bool has_interp = false;
+  bool has_gnu_stack = false;
+  bool has_dynamic = false;
+  uint64_t dynamic_offset = 0;
+  uint64_t dynamic_size = 0;
+
+  for (size_t i = 0; i < hdr->e_phnum; ++i) {
+    auto phdr = stream.peek_conv<Elf_Phdr>(hdr->e_phoff + i * sizeof(Elf_Phdr));
+    if (!phdr) {
+      return make_error_code(lief_errors::read_error);
+    }
+    switch (static_cast<ELF::Segment::TYPE>(phdr->p_type)) {
+      case ELF::Segment::TYPE::LOAD:
+        loads.push_back({phdr->p_offset, phdr->p_vaddr, phdr->p_filesz}); break;
+      case ELF::Segment::TYPE::INTERP:
+        has_interp = true; break;
+      case ELF::Segment::TYPE::DYNAMIC:
+        {
+          has_dynamic = true;
+          dynamic_offset = phdr->p_offset;
+          dynamic_size   = phdr->p_filesz;
+          break;
+        }
+      case ELF::Segment::TYPE::GNU_STACK:
+        {
+          has_gnu_stack = true;
+          if ((phdr->p_flags & PF_X) == 0) {
+            report.properties |= PROPERTY::NX;
+          }
+          break;
+        }
+      case ELF::Segment::TYPE::GNU_RELRO:
+        report.properties |= PROPERTY::RELRO; break;
+      case ELF::Segment::TYPE::GNU_PROPERTY:
+        {
+          gnu_property = *phdr;
+          has_gnu_property = true;
+          break;
+        }
+      case ELF::Segment::TYPE::NOTE:
+        notes.push_back(*phdr); break;
+      default: break;
+    }
+  }
+
+  // Same logic as ELF::Binary::has_nx()
+  if (!has_gnu_stack && arch == ELF::ARCH::PPC64) {
+    report.properties |= PROPERTY::NX;
+  }
+
+  if (has_gnu_property) {
+    elf_gnu_properties(stream, gnu_property.p_offset, gnu_property.p_filesz,
+                       gnu_property.p_align, arch, report);
+  } else {
+    for (const Elf_Phdr& note : notes) {
+      elf_gnu_properties(stream, note.p_offset, note.p_filesz, note.p_align,
+                         arch, report);
+    }
+  }
+
+  uint64_t flags_1  = 0;
+  uint64_t symtab   = 0;
+  uint64_t strtab   = 0;
+  uint64_t strsz    = 0;
+  uint64_t hash     = 0;
+  uint64_t gnu_hash = 0;
+  uint64_t syment   = sizeof(Elf_Sym);
+  bool has_needed   = false;
+  for (size_t i = 0; i < dynamic_size / sizeof(Elf_Dyn); ++i) {
+    auto dyn = stream.peek_conv<Elf_Dyn>(dynamic_offset + i * sizeof(Elf_Dyn));
+    if (!dyn || dyn->d_tag == 0) {
+      break;
+    }
+    const uint64_t value = dyn->d_un.d_val;
+    switch (static_cast<TAG>(dyn->d_tag)) {
+      case TAG::FLAGS:
+        {
+          if (value & DF_BIND_NOW) {
+            report.properties |= PROPERTY::BIND_NOW;
+          }
+          break;
+        }
+      case TAG::FLAGS_1:
+        {
+          flags_1 = value;
+          if (value & DF_1_NOW) {
+            report.properties |= PROPERTY::BIND_NOW;
+          }
+          break;
+        }
+      case TAG::NEEDED:   has_needed = true; break;
+      case TAG::BIND_NOW: report.properties |= PROPERTY::BIND_NOW; break;
+      case TAG::RPATH:    report.properties |= PROPERTY::RPATH; break;
+      case TAG::RUNPATH:  report.properties |= PROPERTY::RUNPATH; break;
+      case TAG::SYMTAB:   symtab   = value; break;
+      case TAG::STRTAB:   strtab   = value; break;
+      case TAG::STRSZ:    strsz    = value; break;
+      case TAG::SYMENT:   syment   = value; break;
+      case TAG::HASH:     hash     = value; break;
+      case TAG::GNU_HASH: gnu_hash = value; break;
+      default: break;
+    }
+  }
+
+  // Same logic as ELF::Binary::is_pie()
+  if (hdr->e_type == static_cast<uint16_t>(ELF::Header::FILE_TYPE::DYN) &&
+      (has_interp || (has_dynamic && (flags_1 & DF_1_PIE) != 0)))
+  {
+    report.properties |= PROPERTY::PIE;
+  }
+
+  if (!has_needed || symtab == 0 || strtab == 0 || syment != sizeof(Elf_Sym)) {
+    // Statically-linked binaries (static-pie included): the imports can't be
+    // checked
+    return ok();
+  }
+
+  auto symtab_off = va2offset(loads, symtab);
+  auto strtab_off = va2offset(loads, strtab);
+  if (!symtab_off || !strtab_off) {
+    LIEF_DEBUG("Can't resolve the dynamic symbol table");
+    return ok();
+  }
+
+  if (gnu_hash != 0) {
+    if (auto gnu_hash_off = va2offset(loads, gnu_hash)) {
+      elf_imports_gnu_hash<ELF_T>(stream, *symtab_off, *strtab_off, strsz,
+                                  *gnu_hash_off, report);
+      return ok();
+    }
+  }
+
+  if (hash != 0) {
+    if (auto hash_off = va2offset(loads, hash)) {
+      elf_imports_hash<ELF_T>(stream, *symtab_off, *strtab_off, strsz,
+                              *hash_off, report);
+    }
+  }
+  return ok();
+}
+
+ok_error_t audit_elf(BinaryStream& stream, report_t& report) {
+  auto ident = stream.peek<ELF::Header::identity_t>(0);
+  if (!ident) {
+    return make_error_code(lief_errors::read_error);
+  }
+  const auto elf_class = static_cast<ELF::Header::CLASS>((*ident)[ELF::Header::ELI_CLASS]);
+  const auto elf_data  = static_cast<ELF::Header::ELF_DATA>((*ident)[ELF::Header::ELI_DATA]);
+
+  const bool should_swap = stream.should_swap();
+  stream.set_endian_swap((elf_data == ELF::Header::ELF_DATA::MSB) != is_host_big_endian());
+
+  ok_error_t res = make_error_code(lief_errors::file_format_error);
+  if (elf_class == ELF::Header::CLASS::ELF32) {
+    res = audit_elf<ELF::details::ELF32>(stream, report);
+  } else if (elf_class == ELF::Header::CLASS::ELF64) {
+    res = audit_elf<ELF::details::ELF64>(stream, report);
+  }
+  stream.set_endian_swap(should_swap);
+  return res;
+}
+#endif
+
+#if defined(LIEF_PE_SUPPORT)
+// PE
+// ============================================================================
+static constexpr uint16_t PE32_MAGIC     = 0x10b;
+static constexpr uint16_t PE32PLUS_MAGIC = 0x20b;
+static constexpr uint16_t MACHINE_I386   = 0x14c;
+
+static constexpr uint32_t GUARD_CF_INSTRUMENTED         = 0x00000100;
+static constexpr uint32_t GUARD_SECURITY_COOKIE_UNUSED  = 0x00000800;
+static constexpr uint32_t GUARD_XFG_ENABLED             = 0x00800000;
+static constexpr uint32_t DLLCHARACTERISTICS_EX_CET_COMPAT = 0x01;
+
+static constexpr size_t MAX_DEBUG_ENTRIES = 0x100;
+
+template<class PE_T>
+ok_error_t audit_pe(BinaryStream& stream, const PE::details::pe_header& header,
+                    uint64_t opt_offset, report_t& report)
+{
+  using pe_optional_header = typename PE_T::pe_optional_header;
+  using load_configuration_t = typename PE_T::load_configuration_v1_t;
+  using DLL_CHARACTERISTICS = PE::OptionalHeader::DLL_CHARACTERISTICS;
+  using TYPES = PE::DataDirectory::TYPES;
+
+  auto opt_hdr = stream.peek<pe_optional_header>(opt_offset);
+  if (!opt_hdr) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  const bool is_pe32 = std::is_same_v<PE_T, PE::details::PE32>;
+  report.format = FORMAT::PE;
+  report.checked |= PROPERTY::PIE | PROPERTY::NX | PROPERTY::FORCE_INTEGRITY |
+                    PROPERTY::NO_SEH | PROPERTY::APPCONTAINER | PROPERTY::SIGNED;
+  if (!is_pe32) {
+    report.checked |= PROPERTY::HIGH_ENTROPY_VA;
+  }
+
+  const uint32_t dll_chara = opt_hdr->DLLCharacteristics;
+  auto has = [dll_chara] (DLL_CHARACTERISTICS c) {
+    return (dll_chara & static_cast<uint32_t>(c)) != 0;
+  };
+  if (has(DLL_CHARACTERISTICS::DYNAMIC_BASE)) {
+    report.properties |= PROPERTY::PIE;
+  }
+  if (has(DLL_CHARACTERISTICS::NX_COMPAT)) {
+    report.properties |= PROPERTY::NX;
+  }
+  if (has(DLL_CHARACTERISTICS::HIGH_ENTROPY_VA) && !is_pe32) {
+    report.properties |= PROPERTY::HIGH_ENTROPY_VA;
+  }
+  if (has(DLL_CHARACTERISTICS::FORCE_INTEGRITY)) {
+    report.properties |= PROPERTY::FORCE_INTEGRITY;
+  }
+  if (has(DLL_CHARACTERISTICS::NO_SEH)) {
+    report.properties |= PROPERTY::NO_SEH;
+  }
+  if (has(DLL_CHARACTERISTICS::APPCONTAINER)) {
+    report.properties |= PROPERTY::APPCONTAINER;
+  }
+
+  // Data directories
+  const uint64_t dirs_offset = opt_offset + sizeof(pe_optional_header);
+  const uint32_t nb_dirs = std::min<uint32_t>(opt_hdr->NumberOfRvaAndSize,
+                                              PE::DataDirectory::DEFAULT_NB);
+  auto get_dir = [&] (TYPES type) -> PE::details::pe_data_directory {
+    const auto idx = static_cast<uint32_t>(type);
+    if (idx >= nb_dirs) {
+      return {0, 0};
+    }
+    auto dir = stream.peek<PE::details::pe_data_directory>(
+        dirs_offset + idx * sizeof(PE::details::pe_data_directory));
+    return dir ? *dir : PE::details::pe_data_directory{0, 0};
+  };
+
+  // Sections (to translate RVAs into offsets)
+  std::vector<PE::details::pe_section> sections;
+  sections.reserve(header.NumberOfSections);
+  const uint64_t sections_offset = opt_offset + header.SizeOfOptionalHeader;
+  for (size_t i = 0; i < header.NumberOfSections; ++i) {
+    auto section = stream.peek<PE::details::pe_section>(sections_offset + i * sizeof(PE::details::pe_section));
+    if (!section) {
+      break;
+    }
+    sections.push_back(*section);
+  }
+
+  auto rva2offset = [&] (uint32_t rva) -> uint64_t {
+    for (const PE::details::pe_section& section : sections) {
+      const uint32_t vsize = std::max(section.VirtualSize, section.SizeOfRawData);
+      if (section.VirtualAddress <= rva && rva - section.VirtualAddress < vsize) {
+        return uint64_t(rva - section.VirtualAddress) + section.PointerToRawData;
+      }
+    }
+    return rva;
+  };
+
+  // The RVA of the certificate table is a file offset
+  const PE::details::pe_data_directory cert = get_dir(TYPES::CERTIFICATE_TABLE);
+  if (cert.RelativeVirtualAddress > 0 && cert.Size > 0 &&
+      uint64_t(cert.RelativeVirtualAddress) + cert.Size <= stream.size())
+  {
+    report.properties |= PROPERTY::SIGNED;
+  }
+
+  // Load configuration: /GS, SafeSEH, CFG and XFG
+  const PE::details::pe_data_directory ldcfg = get_dir(TYPES::LOAD_CONFIG_TABLE);
+  load_configuration_t config{};
+  bool has_config = false;
+  if (ldcfg.RelativeVirtualAddress > 0 && ldcfg.Size > 0) {
+    const uint64_t offset = rva2offset(ldcfg.RelativeVirtualAddress);
+    // The first field (named Characteristics in the structure) is the size
+    // of the load configuration
+    if (auto size = stream.peek<uint32_t>(offset)) {
+      std::vector<uint8_t> raw;
+      const uint32_t to_read = std::min<uint32_t>(*size, sizeof(config));
+      if (to_read >= sizeof(uint32_t) && stream.peek_data(raw, offset, to_read) &&
+          raw.size() == to_read)
+      {
+        std::memcpy(&config, raw.data(), raw.size());
+        has_config = true;
+      }
+    }
+  }
+
+  if (ldcfg.RelativeVirtualAddress == 0 || has_config) {
+    report.checked |= PROPERTY::CANARY | PROPERTY::CFG | PROPERTY::XFG;
+    if (is_pe32 && header.Machine == MACHINE_I386) {
+      report.checked |= PROPERTY::SAFESEH;
+    }
+  }
+
+  if (has_config) {
+    const uint32_t guard_flags = config.GuardFlags;
+    if (config.SecurityCookie != 0 && (guard_flags & GUARD_SECURITY_COOKIE_UNUSED) == 0) {
+      report.properties |= PROPERTY::CANARY;
+    }
+    if (is_pe32 && header.Machine == MACHINE_I386 &&
+        config.SEHandlerTable != 0 && config.SEHandlerCount != 0)
+    {
+      report.properties |= PROPERTY::SAFESEH;
+    }
+    if (has(DLL_CHARACTERISTICS::GUARD_CF) && (guard_flags & GUARD_CF_INSTRUMENTED) != 0) {
+      report.properties |= PROPERTY::CFG;
+    }
+    if ((guard_flags & GUARD_XFG_ENABLED) != 0) {
+      report.properties |= PROPERTY::XFG;
+    }
+  }
+
+  // Debug directory: CET shadow stack compatibility
+  const PE::details::pe_data_directory debug = get_dir(TYPES::DEBUG_DIR);
+  report.checked |= PROPERTY::SHSTK;
+  if (debug.RelativeVirtualAddress > 0) {
+    const uint64_t offset = rva2offset(debug.RelativeVirtualAddress);
+    const size_t nb_entries = std::min<size_t>(debug.Size / sizeof(PE::details::pe_debug),
+                                               MAX_DEBUG_ENTRIES);
+    for (size_t i = 0; i < nb_entries; ++i) {
+      auto entry = stream.peek<PE::details::pe_debug>(offset + i * sizeof(PE::details::pe_debug));
+      if (!entry) {
+        break;
+      }
+      if (static_cast<PE::Debug::TYPES>(entry->Type) != PE::Debug::TYPES::EX_DLLCHARACTERISTICS) {
+        continue;
+      }
+      auto ex_chara = stream.peek<uint32_t>(entry->PointerToRawData);
+      if (ex_chara && (*ex_chara & DLLCHARACTERISTICS_EX_CET_COMPAT) != 0) {
+        report.properties |= PROPERTY::SHSTK;
+      }
+    }
+  }
+  return ok();
+}
+
+ok_error_t audit_pe(BinaryStream& stream, report_t& report) {
+  auto dos_hdr = stream.peek<PE::details::pe_dos_header>(0);
+  if (!dos_hdr) {
+    return make_error_code(lief_errors::read_error);
+  }
+  const uint64_t pe_offset = dos_hdr->AddressOfNewExeHeader;
+  auto header = stream.peek<PE::details::pe_header>(pe_offset);
+  if (!header) {
+    return make_error_code(lief_errors::read_error);
+  }
+  if (std::memcmp(header->signature, "PE\0\0", sizeof(header->signature)) != 0) {
+    return make_error_code(lief_errors::file_format_error);
+  }
+
+  const uint64_t opt_offset = pe_offset + sizeof(PE::details::pe_header);
+  auto magic = stream.peek<uint16_t>(opt_offset);
+  if (!magic) {
+    return make_error_code(lief_errors::read_error);
+  }
+  if (*magic == PE32_MAGIC) {
+    return audit_pe<PE::details::PE32>(stream, *header, opt_offset, report);
+  }
+  if (*magic == PE32PLUS_MAGIC) {
+    return audit_pe<PE::details::PE64>(stream, *header, opt_offset, report);
+  }
+  return make_error_code(lief_errors::file_format_error);
+}
+#endif
+
+#if defined(LIEF_MACHO_SUPPORT)
+// Mach-O
+// ============================================================================
+static constexpr uint32_t CSMAGIC_EMBEDDED_SIGNATURE = 0xfade0cc0;
+static constexpr uint32_t CSMAGIC_CODEDIRECTORY      = 0xfade0c02;
+static constexpr uint32_t CSSLOT_CODEDIRECTORY       = 0;
+static constexpr uint32_t CSSLOT_ALTERNATE_CODEDIRECTORIES = 0x1000;
+static constexpr uint32_t CS_RESTRICT   = 0x00000800;
+static constexpr uint32_t CS_REQUIRE_LV = 0x00002000;
+static constexpr uint32_t CS_RUNTIME    = 0x00010000;
+
+static constexpr uint32_t MAX_FAT_ARCH  = 30;
+static constexpr uint32_t MAX_CS_BLOBS  = 0x100;
+
+//! The FAT header and the code signature are stored in big endian
+result<uint32_t> peek_be32(BinaryStream& stream, uint64_t offset) {
+  auto raw = stream.peek<std::array<uint8_t, 4>>(offset);
+  if (!raw) {
+    return make_error_code(raw.error());
+  }
+  return (uint32_t((*raw)[0]) << 24) | (uint32_t((*raw)[1]) << 16) |
+         (uint32_t((*raw)[2]) << 8)  |  uint32_t((*raw)[3]);
+}
+
+//! Return the flags of the code directories of the embedded signature
+uint32_t macho_cs_flags(BinaryStream& stream, uint64_t offset) {
+  auto magic = peek_be32(stream, offset);
+  auto count = peek_be32(stream, offset + 8);
+  if (!magic || !count || *magic != CSMAGIC_EMBEDDED_SIGNATURE) {
+    return 0;
+  }
+  uint32_t flags = 0;
+  for (size_t i = 0; i < std::min(*count, MAX_CS_BLOBS); ++i) {
+    const uint64_t index = offset + 12 + i * 2 * sizeof(uint32_t);
+    auto type     = peek_be32(stream, index);
+    auto blob_off = peek_be32(stream, index + sizeof(uint32_t));
+    if (!type || !blob_off) {
+      break;
+    }
+    if (*type != CSSLOT_CODEDIRECTORY &&
+        (*type < CSSLOT_ALTERNATE_CODEDIRECTORIES || *type >= CSSLOT_ALTERNATE_CODEDIRECTORIES + 5))
+    {
+      continue;
+    }
+    auto cd_magic = peek_be32(stream, offset + *blob_off);
+    auto cd_flags = peek_be32(stream, offset + *blob_off + 12);
+    if (cd_magic && cd_flags && *cd_magic == CSMAGIC_CODEDIRECTORY) {
+      flags |= *cd_flags;
+    }
+  }
+  return flags;
+}
+
+template<class NLIST_T>
+void macho_imports(BinaryStream& stream, uint64_t base,
+                   const MachO::details::symtab_command& symtab,
+                   const MachO::details::dysymtab_command& dysymtab, report_t& report)
+{
+  report.checked |= PROPERTY::CANARY | PROPERTY::FORTIFY;
+  const uint64_t end = std::min<uint64_t>(uint64_t(dysymtab.iundefsym) + dysymtab.nundefsym,
+                                          symtab.nsyms);
+  const uint64_t start = std::min<uint64_t>(dysymtab.iundefsym, end);
+  for (uint64_t i = start; i < std::min(end, start + MAX_IMPORTS); ++i) {
+    auto nlist = stream.peek<NLIST_T>(base + symtab.symoff + i * sizeof(NLIST_T));
+    if (!nlist) {
+      break;
+    }
+    if (nlist->n_strx == 0 || nlist->n_strx >= symtab.strsize) {
+      continue;
+    }
+    auto name = stream.peek_string_at(base + symtab.stroff + nlist->n_strx, /*maxsize=*/64);
+    // Mach-O symbols are prefixed with an underscore
+    if (name && name->size() > 1 && (*name)[0] == '_') {
+      check_import(name->substr(1), report);
+    }
+  }
+}
+
+ok_error_t audit_macho_slice(BinaryStream& stream, uint64_t base, report_t& report) {
+  using LOAD_COMMAND = MachO::LoadCommand::TYPE;
+  using FLAGS = MachO::Header::FLAGS;
+
+  auto magic = stream.peek<uint32_t>(base);
+  if (!magic) {
+    return make_error_code(lief_errors::read_error);
+  }
+  const auto type = static_cast<MachO::MACHO_TYPES>(*magic);
+  if (type != MachO::MACHO_TYPES::MH_MAGIC && type != MachO::MACHO_TYPES::MH_MAGIC_64) {
+    LIEF_DEBUG("Unsupported Mach-O magic: 0x{:08x}", *magic);
+    return make_error_code(lief_errors::not_supported);
+  }
+  const bool is64 = type == MachO::MACHO_TYPES::MH_MAGIC_64;
+
+  auto header = stream.peek<MachO::details::mach_header>(base);
+  if (!header) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  report.format = FORMAT::MACHO;
+  report.checked |= PROPERTY::PIE | PROPERTY::NX | PROPERTY::NX_HEAP |
+                    PROPERTY::SIGNED | PROPERTY::RESTRICT | PROPERTY::ENCRYPTED |
+                    PROPERTY::HARDENED_RUNTIME | PROPERTY::LIBRARY_VALIDATION;
+
+  auto has = [&header] (FLAGS f) {
+    return (header->flags & static_cast<uint32_t>(f)) != 0;
+  };
+  if (has(FLAGS::PIE)) {
+    report.properties |= PROPERTY::PIE;
+  }
+  if (!has(FLAGS::ALLOW_STACK_EXECUTION)) {
+    report.properties |= PROPERTY::NX;
+  }
+  if (has(FLAGS::NO_HEAP_EXECUTION)) {
+    report.properties |= PROPERTY::NX_HEAP;
+  }
+
+  const uint64_t cmds_offset = base + (is64 ? sizeof(MachO::details::mach_header_64) :
+                                              sizeof(MachO::details::mach_header));
+  const uint64_t cmds_end = cmds_offset + header->sizeofcmds;
+
+  MachO::details::symtab_command symtab{};
+  MachO::details::dysymtab_command dysymtab{};
+  bool has_symtab = false;
+  bool has_dysymtab = false;
+
+  uint64_t cursor = cmds_offset;
+  for (size_t i = 0; i < header->ncmds; ++i) {
+    auto cmd = stream.peek<MachO::details::load_command>(cursor);
+    if (!cmd || cmd->cmdsize < sizeof(MachO::details::load_command) ||
+        cursor + cmd->cmdsize > cmds_end)
+    {
+      break;
+    }
+    switch (static_cast<LOAD_COMMAND>(cmd->cmd)) {
+      case LOAD_COMMAND::SEGMENT:
+      case LOAD_COMMAND::SEGMENT_64:
+        {
+          // segname is located at the same offset for 32 and 64 bits
+          auto segname = stream.peek<std::array<char, 16>>(cursor + sizeof(MachO::details::load_command));
+          if (segname && std::strncmp(segname->data(), "__RESTRICT", segname->size()) == 0) {
+            report.properties |= PROPERTY::RESTRICT;
+          }
+          break;
+        }
+      case LOAD_COMMAND::CODE_SIGNATURE:
+        {
+          auto sig = stream.peek<MachO::details::linkedit_data_command>(cursor);
+          if (!sig || sig->datasize == 0) {
+            break;
+          }
+          report.properties |= PROPERTY::SIGNED;
+          const uint32_t flags = macho_cs_flags(stream, base + sig->dataoff);
+          if (flags & CS_RUNTIME) {
+            report.properties |= PROPERTY::HARDENED_RUNTIME;
+          }
+          if (flags & CS_REQUIRE_LV) {
+            report.properties |= PROPERTY::LIBRARY_VALIDATION;
+          }
+          if (flags & CS_RESTRICT) {
+            report.properties |= PROPERTY::RESTRICT;
+          }
+          break;
+        }
+      case LOAD_COMMAND::ENCRYPTION_INFO:
+      case LOAD_COMMAND::ENCRYPTION_INFO_64:
+        {
+          auto info = stream.peek<MachO::details::encryption_info_command>(cursor);
+          if (info && info->cryptid != 0) {
+            report.properties |= PROPERTY::ENCRYPTED;
+          }
+          break;
+        }
+      case LOAD_COMMAND::SYMTAB:
+        {
+          if (auto symcmd = stream.peek<MachO::details::symtab_command>(cursor)) {
+            symtab = *symcmd;
+            has_symtab = true;
+          }
+          break;
+        }
+      case LOAD_COMMAND::DYSYMTAB:
+        {
+          if (auto dysymcmd = stream.peek<MachO::details::dysymtab_command>(cursor)) {
+            dysymtab = *dysymcmd;
+            has_dysymtab = true;
+          }
+          break;
+        }
+      default: break;
+    }
+    cursor += cmd->cmdsize;
+  }
+
+  if (has_symtab && has_dysymtab) {
+    if (is64) {
+      macho_imports<MachO::details::nlist_64>(stream, base, symtab, dysymtab, report);
+    } else {
+      macho_imports<MachO::details::nlist_32>(stream, base, symtab, dysymtab, report);
+    }
+  }
+  return ok();
+}
+
+ok_error_t audit_macho(BinaryStream& stream, report_t& report) {
+  auto magic = stream.peek<uint32_t>(0);
+  if (!magic) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  if (static_cast<MachO::MACHO_TYPES>(*magic) != MachO::MACHO_TYPES::FAT_CIGAM) {
+    report.nb_slices = 1;
+    return audit_macho_slice(stream, 0, report);
+  }
+
+  auto nb_arch = peek_be32(stream, sizeof(uint32_t));
+  if (!nb_arch) {
+    return make_error_code(lief_errors::read_error);
+  }
+  if (*nb_arch == 0 || *nb_arch > MAX_FAT_ARCH) {
+    return make_error_code(lief_errors::file_format_error);
+  }
+
+  for (size_t i = 0; i < *nb_arch; ++i) {
+    const uint64_t arch = sizeof(MachO::details::fat_header) + i * sizeof(MachO::details::fat_arch);
+    auto offset = peek_be32(stream, arch + offsetof(MachO::details::fat_arch, offset));
+    if (!offset) {
+      return make_error_code(lief_errors::read_error);
+    }
+    report_t slice;
+    if (auto res = audit_macho_slice(stream, *offset, slice); !res) {
+      return make_error_code(get_error(res));
+    }
+    if (report.nb_slices == 0) {
+      report = slice;
+    } else {
+      report.properties &= slice.properties;
+      report.checked &= slice.checked;
+    }
+    ++report.nb_slices;
+  }
+  return ok();
+}
+#endif
+}
+
+std::ostream& operator<<(std::ostream& os, const report_t& R) {
+  os << to_string(R.format);
+  for (size_t i = 0; i < 32; ++i) {
+    const auto prop = static_cast<PROPERTY>(uint32_t(1) << i);
+    if (!R.is_checked(prop)) {
+      continue;
+    }
+    os << ' ' << (R.has(prop) ? "" : "!") << to_string(prop);
+  }
+  return os;
+}
+
+result<report_t> audit(BinaryStream& stream) {
+  static constexpr std::array<uint8_t, 4> ELF_MAGIC = {0x7f, 'E', 'L', 'F'};
+  static constexpr std::array<uint8_t, 2> MZ_MAGIC = {'M', 'Z'};
+
+  auto magic = stream.peek<std::array<uint8_t, 4>>(0);
+  if (!magic) {
+    return make_error_code(lief_errors::read_error);
+  }
+
+  report_t report;
+  ok_error_t res = make_error_code(lief_errors::file_format_error);
+  if (std::equal(ELF_MAGIC.begin(), ELF_MAGIC.end(), magic->begin())) {
+    #if defined(LIEF_ELF_SUPPORT)
+    res = audit_elf(stream, report);
+    #else
+    res = make_error_code(lief_errors::not_supported);
+    #endif
+  }
+  else if (std::equal(MZ_MAGIC.begin(), MZ_MAGIC.end(), magic->begin())) {
+    #if defined(LIEF_PE_SUPPORT)
+    res = audit_pe(stream, report);
+    #else
+    res = make_error_code(lief_errors::not_supported);
+    #endif
+  }
+  else {
+    // Mach-O and FAT Mach-O magics in both byte orders
+    uint32_t value = 0;
+    std::memcpy(&value, magic->data(), sizeof(value));
+    switch (value) {
+      case 0xfeedface: case 0xcefaedfe:
+      case 0xfeedfacf: case 0xcffaedfe:
+      case 0xcafebabe: case 0xbebafeca:
+        {
+          #if defined(LIEF_MACHO_SUPPORT)
+          res = audit_macho(stream, report);
+          #else
+          res = make_error_code(lief_errors::not_supported);
+          #endif
+          break;
+        }
+      default: break;
+    }
+  }
+
+  if (!res) {
+    return make_error_code(get_error(res));
+  }
+  return report;
+}
+
+result<report_t> audit(const std::string& path) {
+  std::ifstream ifs(path, std::ios::in | std::ios::binary);
+  if (!ifs) {
+    LIEF_ERR("Can't open '{}'", path);
+    return make_error_code(lief_errors::read_error);
+  }
+  ifs.seekg(0, std::ios::end);
+  const auto size = static_cast<uint64_t>(ifs.tellg());
+  ifs.seekg(0, std::ios::beg);
+  FileBlockStream stream(std::move(ifs), size);
+  return audit(stream);
+}
+
+result<report_t> audit(span<const uint8_t> raw) {
+  SpanStream stream(raw);
+  return audit(stream);
+}
+
+std::vector<result<report_t>> audit(const std::vector<std::string>& paths,
+                                    uint32_t nb_threads)
+{
+  std::vector<result<report_t>> reports(paths.size(),
+                                        make_error_code(lief_errors::read_error));
+  parallel_for(paths.size(), nb_threads, [&] (size_t i) {
+    reports[i] = audit(paths[i]);
+  });
+  return reports;
+}
+
+const char* to_string(FORMAT e) {
+  #define ENTRY(X) std::pair(FORMAT::X, #X)
+  STRING_MAP enums2str {
+    ENTRY(UNKNOWN),
+    ENTRY(ELF),
+    ENTRY(PE),
+    ENTRY(MACHO),
+  };
+  #undef ENTRY
+
+  if (auto it = enums2str.find(e); it != enums2str.end()) {
+    return it->second;
+  }
+  return "UNKNOWN";
+}
+
+const char* to_string(PROPERTY e) {
+  #define ENTRY(X) std::pair(PROPERTY::X, #X)
+  STRING_MAP enums2str {
+    ENTRY(NONE),
+    ENTRY(PIE),
+    ENTRY(NX),
+    ENTRY(CANARY),
+    ENTRY(FORTIFY),
+    ENTRY(RELRO),
+    ENTRY(BIND_NOW),
+    ENTRY(RPATH),
+    ENTRY(RUNPATH),
+    ENTRY(IBT),
+    ENTRY(SHSTK),
+    ENTRY(PAC),
+    ENTRY(HIGH_ENTROPY_VA),
+    ENTRY(FORCE_INTEGRITY),
+    ENTRY(NO_SEH),
+    ENTRY(SAFESEH),
+    ENTRY(CFG),
+    ENTRY(XFG),
+    ENTRY(APPCONTAINER),
+    ENTRY(SIGNED),
+    ENTRY(NX_HEAP),
+    ENTRY(RESTRICT),
+    ENTRY(HARDENED_RUNTIME),
+    ENTRY(LIBRARY_VALIDATION),
+    ENTRY(ENCRYPTED),
+  };
+  #undef ENTRY
+
+  if (auto it = enums2str.find(e); it != enums2str.end()) {
+    return it->second;
+  }
+  return "UNKNOWN";
+}
+
+}
+}
@@ -16,6 +16,7 @@
 #ifndef LIEF_INTERNAL_UTILS_HEADER
 #define LIEF_INTERNAL_UTILS_HEADER
 #include <string>
+#include <string_view>
 #include <vector>
 #include <set>
 #include <algorithm>
@@ -86,93 +87,92 @@ inline std::string to_hex(const T& container, size_t maxsize = 0) {
   return out;
 }
 
-template<typename HANDLER>
-std::vector<std::string> optimize(const HANDLER& container,
-                                  std::string(* getter)(const typename HANDLER::value_type&),
-                                  size_t& offset_counter,
-                                  std::unordered_map<std::string, size_t> *of_map_p = nullptr)
+//! Layout of a string table in which a string that is the suffix of another
+//! one shares its storage (e.g. ``printf`` is stored in ``sprintf``).
+//!
+//! The strings are processed as views so that the (potentially millions of)
+//! names are neither copied nor reversed. The returned views reference the
+//! input strings and must be written in this order, each followed by a
+//! null byte. The optional ``of_map_p`` is filled with the offset of every
+//! input string, starting at ``offset_counter``.
+inline std::vector<std::string_view>
+optimize_strings(std::vector<std::string_view> names, size_t& offset_counter,
+                 std::unordered_map<std::string, size_t>* of_map_p = nullptr)
 {
-  if (container.empty()) {
-    return {};
-  }
-
-  std::set<std::string> string_table;
-  std::vector<std::string> string_table_optimized;
-  string_table_optimized.reserve(container.size());
-
-  // reverse all symbol names and sort them so we can merge then in the linear time:
-  // aaa, aadd, aaaa, cca, ca -> aaaa, aaa, acc, ac ddaa
-  std::transform(std::begin(container), std::end(container),
-                 std::inserter(string_table, std::end(string_table)),
-                 getter);
-
-  for (const auto& val: string_table) {
-    string_table_optimized.emplace_back(val);
-    std::reverse(std::begin(string_table_optimized.back()), std::end(string_table_optimized.back()));
+  const auto rev_less = [] (std::string_view lhs, std::string_view rhs) {
+    return std::lexicographical_compare(lhs.rbegin(), lhs.rend(),
+                                        rhs.rbegin(), rhs.rend());
+  };
+  const auto ends_with = [] (std::string_view str, std::string_view suffix) {
+    return str.size() >= suffix.size() &&
+           str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+  };
+
+  // Sort the strings on their reversed value: a string that is the suffix
+  // of others is located right before them.
+  names.erase(std::remove(names.begin(), names.end(), std::string_view()), names.end());
+  std::sort(names.begin(), names.end(), rev_less);
+  names.erase(std::unique(names.begin(), names.end()), names.end());
+
+  std::vector<std::string_view> table;
+  // (string, index in table) for the strings merged in a longer one
+  std::vector<std::pair<std::string_view, size_t>> merged;
+  for (auto it = names.rbegin(); it != names.rend(); ++it) {
+    if (!table.empty() && ends_with(table.back(), *it)) {
+      merged.emplace_back(*it, table.size() - 1);
+      continue;
+    }
+    table.push_back(*it);
   }
 
-  std::sort(std::begin(string_table_optimized), std::end(string_table_optimized),
-      [] (const std::string& lhs, const std::string& rhs) {
-          bool ret = false;
-          if (lhs.size() > rhs.size()) {
-            auto res = lhs.compare(0, rhs.size(), rhs);
-            ret = (res <= 0);
-          } else {
-            auto res = rhs.compare(0, lhs.size(), lhs);
-            ret = (res > 0);
-          }
-          return ret;
-      }
-  );
-
-  // as all elements that can be merged are adjacent we can just go through the list once
-  // and memorize one we merged to calculate the offsets later
-  std::unordered_map<std::string, std::string> merged_map;
-  size_t to_set_idx = 0, cur_elm_idx = 1;
-  for (; cur_elm_idx < string_table_optimized.size(); ++cur_elm_idx) {
-      auto &cur_elm = string_table_optimized[cur_elm_idx];
-      auto &to_set_elm = string_table_optimized[to_set_idx];
-      if (to_set_elm.size() >= cur_elm.size()) {
-          auto ret = to_set_elm.compare(0, cur_elm.size(), cur_elm);
-          if (ret == 0) {
-            // when memorizing reverse back symbol names
-            std::string rev_cur_elm = cur_elm;
-            std::string rev_to_set_elm = to_set_elm;
-            std::reverse(std::begin(rev_cur_elm), std::end(rev_cur_elm));
-            std::reverse(std::begin(rev_to_set_elm), std::end(rev_to_set_elm));
-            merged_map[rev_cur_elm] = rev_to_set_elm;
-            continue;
-          }
-      }
-      ++to_set_idx;
-      std::swap(string_table_optimized[to_set_idx], cur_elm);
+  // Keep a layout that does not depend on the input order
+  std::vector<size_t> order(table.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
   }
-  // if the first one is empty
-  if (string_table_optimized[0].empty()) {
-    std::swap(string_table_optimized[0], string_table_optimized[to_set_idx]);
-    --to_set_idx;
+  std::sort(order.begin(), order.end(),
+            [&table] (size_t lhs, size_t rhs) { return table[lhs] < table[rhs]; });
+
+  std::vector<size_t> offsets(table.size());
+  std::vector<std::string_view> result;
+  result.reserve(table.size());
+  for (size_t idx : order) {
+    offsets[idx] = offset_counter;
+    offset_counter += table[idx].size() + 1;
+    result.push_back(table[idx]);
   }
-  string_table_optimized.resize(to_set_idx + 1);
-
-  //reverse symbols back and sort them again
-  for (auto &val: string_table_optimized) {
-    std::reverse(std::begin(val), std::end(val));
-  }
-  std::sort(std::begin(string_table_optimized), std::end(string_table_optimized));
 
   if (of_map_p != nullptr) {
     std::unordered_map<std::string, size_t>& offset_map = *of_map_p;
+    offset_map.reserve(offset_map.size() + table.size() + merged.size() + 1);
     offset_map[""] = 0;
-    for (const auto &v : string_table_optimized) {
-      offset_map[v] = offset_counter;
-      offset_counter += v.size() + 1;
+    for (size_t i = 0; i < table.size(); ++i) {
+      offset_map[std::string(table[i])] = offsets[i];
     }
-    for (const auto &kv : merged_map) {
-      offset_map[kv.first] = offset_map[kv.second] + (kv.second.size() - kv.first.size());
+    for (const auto& [str, idx] : merged) {
+      offset_map[std::string(str)] = offsets[idx] + (table[idx].size() - str.size());
     }
   }
+  return result;
+}
+
+template<typename HANDLER, typename GETTER>
+std::vector<std::string> optimize(const HANDLER& container, GETTER getter,
+                                  size_t& offset_counter,
+                                  std::unordered_map<std::string, size_t> *of_map_p = nullptr)
+{
+  if (container.empty()) {
+    return {};
+  }
+
+  std::vector<std::string> strings;
+  strings.reserve(container.size());
+  std::transform(std::begin(container), std::end(container),
+                 std::back_inserter(strings), getter);
 
-  return string_table_optimized;
+  std::vector<std::string_view> views(strings.begin(), strings.end());
+  std::vector<std::string_view> table = optimize_strings(std::move(views), offset_counter, of_map_p);
+  return {table.begin(), table.end()};
 }
 
 template<class T>
@@ -0,0 +1,71 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_PARALLEL_H
+#define LIEF_PARALLEL_H
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace LIEF {
+
+//! Number of workers used to process ``count`` jobs with at most
+//! ``nb_threads`` threads (0: number of hardware threads)
+inline size_t nb_workers(size_t count, uint32_t nb_threads) {
+  size_t nb = nb_threads;
+  if (nb == 0) {
+    nb = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  return std::min(nb, count);
+}
+
+//! Call ``fn(i)`` for each ``i`` in ``[0, count)`` from at most
+//! ``nb_threads`` threads (0: number of hardware threads).
+//!
+//! The jobs are dispatched dynamically, so ``fn`` must only write to the
+//! slot ``i`` of shared outputs. The calling thread is one of the workers and
+//! no thread is spawned when there is a single worker.
+template<class F>
+void parallel_for(size_t count, uint32_t nb_threads, F&& fn) {
+  const size_t nb = nb_workers(count, nb_threads);
+  if (nb <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      fn(i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next{0};
+  auto worker = [&] {
+    for (size_t i = next++; i < count; i = next++) {
+      fn(i);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(nb - 1);
+  for (size_t i = 1; i < nb; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+}
+#endif
@@ -113,3 +113,63 @@ def test_entropy():
 
     assert weird_section_0 >= 0
     assert weird_section_1 >= 0
+
+def test_symbolizer():
+    elf: lief.ELF.Binary = lief.parse(get_sample('ELF/ELF64_x86-64_binary_hello-gdb.bin'))
+    sym = elf.symbolizer()
+    assert len(sym) > 0
+
+    functions = [s for s in elf.symtab_symbols
+                 if s.type == lief.ELF.Symbol.TYPE.FUNC and s.size > 0]
+    assert len(functions) > 0
+    addresses = [s.value for s in functions]
+    indexes = sym.lookup(addresses)
+    assert indexes == [sym.lookup(addr) for addr in addresses]
+    for addr, idx in zip(addresses, indexes):
+        assert idx != lief.Symbolizer.NOT_FOUND
+        assert sym.start(idx) <= addr < sym.end(idx)
+        assert sym.symbolize(addr) is not None
+
+    assert sym.lookup(0) == lief.Symbolizer.NOT_FOUND
+    assert sym.symbolize(0xffffffffffffffff) is None
+
+    pe: lief.PE.Binary = lief.parse(get_sample('PE/PE64_x86-64_library_libLIEF.dll'))
+    sym = pe.symbolizer()
+    for entry in list(pe.get_export().entries)[:100]:
+        if entry.is_forwarded or len(entry.name) == 0:
+            continue
+        assert sym.symbolize(pe.imagebase + entry.address) is not None
+
+    macho: lief.MachO.Binary = lief.parse(get_sample('MachO/MachO64_x86-64_binary_id.bin'))
+    sym = macho.symbolizer()
+    for func in list(macho.unwind_functions)[:50]:
+        assert sym.lookup(macho.imagebase + func.address) != lief.Symbolizer.NOT_FOUND
+
+def test_go_pclntab():
+    elf: lief.ELF.Binary = lief.parse(get_sample('ELF/batch-x86-64/test.go.static.bin'))
+    assert lief.GoPclntab.is_go(elf)
+
+    pclntab = lief.GoPclntab.from_binary(elf)
+    assert pclntab.version != lief.GoPclntab.VERSION.UNKNOWN
+    assert pclntab.pointer_size == 8
+    assert pclntab.quantum == 1
+    assert len(pclntab) > 0
+
+    main = elf.get_symbol("main.main")
+    idx = pclntab.lookup(main.value)
+    assert idx != lief.GoPclntab.NOT_FOUND
+    assert pclntab.name(idx) == "main.main"
+    assert pclntab.entry(idx) == main.value
+    assert pclntab.end(idx) > main.value
+
+    loc = pclntab.location(main.value)
+    assert loc.file.endswith(".go")
+    assert loc.line > 0
+
+    assert pclntab.lookup(0) == lief.GoPclntab.NOT_FOUND
+    assert len(pclntab.functions) == len(pclntab)
+
+    sym = elf.symbolizer()
+    assert sym.symbolize(main.value + 1) == "main.main"
+
+    assert not lief.GoPclntab.is_go(lief.parse(get_sample('ELF/ELF64_x86-64_binary_ls.bin')))
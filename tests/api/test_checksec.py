@@ -0,0 +1,63 @@
+#!/usr/bin/env python
+from pathlib import Path
+
+import lief
+from utils import get_sample
+
+PROPERTY = lief.checksec.PROPERTY
+
+def test_elf():
+    path = get_sample("ELF/ELF64_x86-64_binary_ls.bin")
+    report = lief.checksec.audit(path)
+    assert isinstance(report, lief.checksec.report_t)
+    assert report.format == lief.checksec.FORMAT.ELF
+
+    elf = lief.ELF.parse(path)
+    assert report.has(PROPERTY.PIE) == elf.is_pie
+    assert report.has(PROPERTY.NX) == elf.has_nx
+    assert report.has(PROPERTY.RELRO) == elf.has(lief.ELF.Segment.TYPE.GNU_RELRO)
+    assert report.is_checked(PROPERTY.BIND_NOW)
+    assert report.full_relro == (report.has(PROPERTY.RELRO) and report.has(PROPERTY.BIND_NOW))
+    assert not report.is_checked(PROPERTY.SAFESEH)
+    assert "ELF" in str(report)
+
+    # Same report from the raw content
+    raw = lief.checksec.audit(Path(path).read_bytes())
+    assert raw.properties == report.properties
+    assert raw.checked == report.checked
+
+def test_pe():
+    path = get_sample("PE/PE32_x86_binary_cmd.exe")
+    report = lief.checksec.audit(path)
+    assert report.format == lief.checksec.FORMAT.PE
+
+    pe = lief.PE.parse(path)
+    DLL_CHARACTERISTICS = lief.PE.OptionalHeader.DLL_CHARACTERISTICS
+    assert report.has(PROPERTY.PIE) == pe.optional_header.has(DLL_CHARACTERISTICS.DYNAMIC_BASE)
+    assert report.has(PROPERTY.NX) == pe.optional_header.has(DLL_CHARACTERISTICS.NX_COMPAT)
+    assert report.has(PROPERTY.SIGNED) == pe.has_signatures
+    assert not report.is_checked(PROPERTY.HIGH_ENTROPY_VA)
+
+def test_errors():
+    assert isinstance(lief.checksec.audit(b"\x41" * 0x100), lief.lief_errors)
+    assert isinstance(lief.checksec.audit("/this/file/does/not/exist"), lief.lief_errors)
+
+def test_parallel():
+    paths = [
+        get_sample("ELF/ELF64_x86-64_binary_ls.bin"),
+        get_sample("PE/PE32_x86_binary_cmd.exe"),
+        "/this/file/does/not/exist",
+        get_sample("MachO/MachO64_x86-64_binary_nm.bin"),
+    ]
+    for nb_threads in (1, 4):
+        reports = lief.checksec.audit(paths, nb_threads=nb_threads)
+        assert len(reports) == len(paths)
+        assert isinstance(reports[2], lief.lief_errors)
+        for path, report in zip(paths, reports):
+            expected = lief.checksec.audit(path)
+            if isinstance(expected, lief.lief_errors):
+                assert isinstance(report, lief.lief_errors)
+                continue
+            assert report.format == expected.format
+            assert report.properties == expected.properties
+            assert report.checked == expected.checked
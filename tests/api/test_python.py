@@ -1,5 +1,7 @@
 #!/usr/bin/env python
+import os
 import sys
+import threading
 import pytest
 import io
 from io import open as io_open
@@ -62,6 +64,25 @@ def test_io():
         bytes_stream = io.BytesIO(f.read())
         assert bytes_stream is not None
 
+def test_io_pipe():
+    lspath = get_sample('ELF/ELF64_x86-64_binary_ls.bin')
+    raw = Path(lspath).read_bytes()
+
+    rfd, wfd = os.pipe()
+    def writer():
+        with os.fdopen(wfd, 'wb') as f:
+            f.write(raw)
+
+    thread = threading.Thread(target=writer)
+    thread.start()
+    with os.fdopen(rfd, 'rb') as f:
+        assert not f.seekable()
+        ls = lief.parse(f)
+    thread.join()
+
+    assert ls is not None
+    assert ls.entrypoint == lief.parse(lspath).entrypoint
+
 def test_wrong_io():
     class Wrong1:
         pass
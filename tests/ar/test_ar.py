@@ -0,0 +1,109 @@
+#!/usr/bin/env python
+import io
+import struct
+from pathlib import Path
+
+import lief
+from utils import get_sample
+
+def _member(name: str, data: bytes) -> bytes:
+    hdr = f"{name:<16}{0:<12}{0:<6}{0:<6}{644:<8}{len(data):<10}`\n".encode()
+    assert len(hdr) == 60
+    return hdr + data + (b"\n" if len(data) & 1 else b"")
+
+def _gnu_archive(members: list[tuple[str, bytes]], symbols: dict[str, int]) -> bytes:
+    """
+    Build a GNU archive where ``symbols`` maps a symbol to the index of the
+    member that defines it
+    """
+    names = b"".join(s.encode() + b"\0" for s in symbols)
+    symtab_size = 4 + 4 * len(symbols) + len(names)
+    offset = 8 + 60 + symtab_size + (symtab_size & 1)
+    offsets = []
+    for name, data in members:
+        offsets.append(offset)
+        offset += 60 + len(data) + (len(data) & 1)
+
+    symtab = struct.pack(">I", len(symbols))
+    symtab += b"".join(struct.pack(">I", offsets[idx]) for idx in symbols.values())
+    symtab += names
+
+    raw = b"!<arch>\n" + _member("/", symtab)
+    for name, data in members:
+        raw += _member(name + "/", data)
+    return raw
+
+def test_gnu(tmp_path: Path):
+    ls = Path(get_sample('ELF/ELF64_x86-64_binary_ls.bin')).read_bytes()
+    arm = Path(get_sample('ELF/ELF32_ARM_binary_ls.bin')).read_bytes()
+    raw = _gnu_archive([("ls.o", ls), ("arm.o", arm), ("notes.txt", b"LIEF")],
+                       {"main": 0, "arm_main": 1})
+
+    assert lief.AR.is_archive(list(raw))
+    output = tmp_path / "libtest.a"
+    output.write_bytes(raw)
+    assert lief.AR.is_archive(output.as_posix())
+
+    for ar in (lief.AR.parse(output.as_posix()), lief.AR.parse(list(raw)),
+               lief.AR.parse(io.BytesIO(raw))):
+        assert ar is not None
+        assert ar.kind == lief.AR.Archive.KIND.GNU
+        assert len(ar.members) == 3
+        assert [m.name for m in ar.members] == ["ls.o", "arm.o", "notes.txt"]
+
+        member = ar.find_symbol("main")
+        assert member is not None
+        assert member.name == "ls.o"
+        assert member.size == len(ls)
+        assert member.format == lief.Binary.FORMATS.ELF
+        assert bytes(member.content) == ls
+        assert ar.raw[member.data_offset:member.data_offset + member.size] == ls
+
+        assert ar.has_symbol("arm_main")
+        assert not ar.has_symbol("foo")
+        assert set(ar.symbols.keys()) == {"main", "arm_main"}
+        assert ar.symbols["arm_main"].name == "arm.o"
+
+        elf = ar.parse(member)
+        assert isinstance(elf, lief.ELF.Binary)
+        assert elf.header.machine_type == lief.ELF.ARCH.X86_64
+        assert ar.parse(ar.get_member("notes.txt")) is None
+
+    binaries = ar.parse(nb_threads=4)
+    assert len(binaries) == 2
+    assert [b.header.machine_type for b in binaries] == \
+           [lief.ELF.ARCH.X86_64, lief.ELF.ARCH.ARM]
+
+def test_coff():
+    obj = struct.pack("<HH", 0x8664, 0) + bytes(16)
+
+    linker2_size = 4 + 2 * 4 + 4 + 2 * 2 + len(b"bar\0foo\0")
+    linker1_size = 4 + 2 * 4 + len(b"foo\0bar\0")
+    off_a = 8 + 60 + linker1_size + 60 + linker2_size
+    off_b = off_a + 60 + len(obj)
+
+    linker1 = struct.pack(">III", 2, off_a, off_b) + b"foo\0bar\0"
+    linker2 = struct.pack("<IIII", 2, off_a, off_b, 2) + struct.pack("<HH", 2, 1) + b"bar\0foo\0"
+    raw = b"!<arch>\n" + _member("/", linker1) + _member("/", linker2) + \
+          _member("a.obj/", obj) + _member("b.obj/", obj)
+
+    ar = lief.AR.parse(list(raw))
+    assert ar.kind == lief.AR.Archive.KIND.COFF
+    assert ar.find_symbol("foo").name == "a.obj"
+    assert ar.find_symbol("bar").name == "b.obj"
+
+    # COFF objects are indexed but not parsed
+    assert ar.find_symbol("foo").format == lief.Binary.FORMATS.UNKNOWN
+    assert ar.parse(ar.find_symbol("foo")) is None
+    assert ar.parse() == []
+
+def test_corrupted():
+    # /SYM64/ with a number of symbols that wraps around once multiplied by 8
+    symtab = struct.pack(">QQ", 0x2000000000000001, 0) + b"foo\0"
+    raw = b"!<arch>\n" + _member("/SYM64/", symtab) + _member("a.o/", b"LIEF")
+    ar = lief.AR.parse(list(raw))
+    assert ar is not None
+    assert len(ar.members) == 1
+    assert len(ar.symbols) == 0
+
+    assert lief.AR.parse(list(b"LIEF")) is None
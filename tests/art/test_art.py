@@ -1,5 +1,6 @@
 #!/usr/bin/env python
 import lief
+import pytest
 from utils import get_sample
 
 lief.logging.set_level(lief.logging.LEVEL.INFO)
@@ -29,3 +30,39 @@ def test_art56():
     boot = lief.ART.parse(get_sample("ART/ART_056_AArch64_boot.art"))
     assert boot.header is not None
 
+
+@pytest.mark.parametrize("sample", [
+    "ART/ART_017_AArch64_boot.art",
+    "ART/ART_029_ARM_boot.art",
+    "ART/ART_030_AArch64_boot.art",
+    "ART/ART_044_ARM_boot.art",
+    "ART/ART_046_AArch64_boot.art",
+    "ART/ART_056_AArch64_boot.art",
+])
+def test_image_reader(sample):
+    boot = lief.ART.parse(get_sample(sample))
+    image = boot.image
+    assert image is not None
+    assert image.image_begin == boot.header.image_begin
+    assert image.pointer_size == boot.header.pointer_size
+
+    objects = image.get(lief.ART.ImageReader.SECTION.OBJECTS)
+    assert objects is not None and objects.size > 0
+
+    roots = image.class_roots
+    assert image.class_name(roots[0]) == "java.lang.Class"
+    assert image.class_name(roots[1]) == "java.lang.Object"
+    assert image.class_name(roots[4]) == "java.lang.String"
+
+    first = next(iter(image.objects))
+    assert image.find_object(first.address + 4).address == first.address
+
+    assert any(cache.location.endswith(".jar") for cache in image.dex_caches)
+    assert len(image.art_methods) > 0
+    for cls in image.class_table[:10]:
+        assert isinstance(image.class_name(cls), str)
+
+    if boot.header.storage_mode == lief.ART.STORAGE_MODES.UNCOMPRESSED:
+        assert image.nb_decoded_blocks == 0
+    else:
+        assert image.nb_decoded_blocks == 1
@@ -100,3 +100,87 @@ def test_kik_iterators():
 
 
 
+
+def test_checksums():
+    assert KIK.verify_checksum()
+    assert KIK.verify_signature()
+
+    assert lief.DEX.adler32(b"Wikipedia") == 0x11e60398
+
+    raw = bytes(KIK.raw(deoptimize=False))
+    assert lief.DEX.compute_checksum(raw) == KIK.header.checksum
+    assert lief.DEX.compute_signature(raw) == KIK.header.signature
+
+    # Patch the data and repair the header
+    patched = bytearray(raw)
+    patched[-1] ^= 0xff
+    dex = lief.DEX.parse(list(patched))
+    assert not dex.verify_checksum()
+    assert not dex.verify_signature()
+
+    fixed = lief.DEX.update_checksums(bytes(patched))
+    dex = lief.DEX.parse(list(fixed))
+    assert dex.verify_checksum()
+    assert dex.verify_signature()
+
+def test_bulk_checksums():
+    patched = bytearray(KIK.raw(deoptimize=False))
+    patched[-1] ^= 0xff
+    dex = lief.DEX.parse(list(patched))
+
+    telecom = lief.VDEX.parse(get_sample('VDEX/VDEX_06_AArch64_Telecom.vdex'))
+    files = [KIK, dex] + list(telecom.dex_files)
+
+    for nb_threads in (1, 0):
+        status = lief.DEX.verify(files, nb_threads)
+        assert len(status) == len(files)
+        assert status[0].is_valid
+        assert not status[1].checksum and not status[1].signature
+        for file, check in zip(files, status):
+            assert check.checksum == file.verify_checksum()
+            assert check.signature == file.verify_signature()
+
+    fixed = lief.DEX.fix(files)
+    assert len(fixed) == len(files)
+    assert fixed[0] == bytes(KIK.raw())
+    assert fixed[1] == lief.DEX.update_checksums(bytes(patched))
+    for raw in fixed:
+        dex = lief.DEX.parse(list(raw))
+        assert dex.verify_checksum()
+        assert dex.verify_signature()
+
+def test_xref():
+    xref = lief.DEX.XRef.build(KIK)
+
+    nb_calls = 0
+    for method in KIK.methods:
+        idx = method.index
+        for callee in xref.callees(idx):
+            assert idx in xref.callers(callee)
+            nb_calls += 1
+        for string in xref.strings(idx):
+            assert idx in xref.string_users(string)
+        for field in xref.fields(idx):
+            assert idx in xref.field_users(field)
+        for typ in xref.types(idx):
+            assert idx in xref.type_users(typ)
+    assert nb_calls > 0
+
+    method = next(m for m in KIK.methods if len(xref.callers(m.index)) > 0)
+    callers = xref.method_callers(method)
+    assert len(callers) == len(xref.callers(method.index))
+    for caller in callers:
+        assert method.index in xref.callees(caller.index)
+
+def test_xref_threads():
+    # The index must not depend on the number of threads
+    ref = lief.DEX.XRef.build(KIK, nb_threads=1)
+    for nb_threads in (2, 0):
+        xref = lief.DEX.XRef.build(KIK, nb_threads)
+        for method in KIK.methods:
+            idx = method.index
+            assert xref.callees(idx) == ref.callees(idx)
+            assert xref.callers(idx) == ref.callers(idx)
+            assert xref.strings(idx) == ref.strings(idx)
+            assert xref.fields(idx) == ref.fields(idx)
+            assert xref.types(idx) == ref.types(idx)
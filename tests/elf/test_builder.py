@@ -133,6 +133,51 @@ def test_symtab(tmp_path):
         sym_names = [s.name for s in out.symtab_symbols]
         assert "test_sym_029" in sym_names
 
+def test_strtab_reuse(tmp_path):
+    """
+    The original .strtab must be kept as-is if the symbols are not renamed
+    """
+    target = SAMPLE_DIR / "ELF" / "batch-x86-64" / "test.clang.debug.bin"
+    elf: lief.ELF.Binary = lief.ELF.parse(target.as_posix())
+    strtab = bytes(elf.get_section(".strtab").content)
+
+    out_path = tmp_path / "strtab_reuse.bin"
+    elf.write(out_path.as_posix())
+    new = lief.ELF.parse(out_path.as_posix())
+    assert bytes(new.get_section(".strtab").content) == strtab
+
+    sym = next(s for s in new.symtab_symbols if s.name == "main")
+    sym.name = "renamed_main"
+    out_path = tmp_path / "strtab_renamed.bin"
+    new.write(out_path.as_posix())
+
+    renamed = lief.ELF.parse(out_path.as_posix())
+    names = {s.name for s in renamed.symtab_symbols}
+    assert "renamed_main" in names
+    assert "main" not in names
+    assert len(names) == len({s.name for s in elf.symtab_symbols})
+
+    # The name of a removed symbol must not leak in the new .strtab
+    new = lief.ELF.parse(out_path.as_posix())
+    new.remove_symtab_symbol(next(s for s in new.symtab_symbols if s.name == "renamed_main"))
+    out_path = tmp_path / "strtab_removed.bin"
+    new.write(out_path.as_posix())
+
+    removed = lief.ELF.parse(out_path.as_posix())
+    assert b"renamed_main" not in bytes(removed.get_section(".strtab").content)
+    assert len(removed.symtab_symbols) == len(renamed.symtab_symbols) - 1
+
+    # Same if the removed symbol is replaced by a new (unnamed) one
+    new = lief.ELF.parse((tmp_path / "strtab_renamed.bin").as_posix())
+    new.remove_symtab_symbol(next(s for s in new.symtab_symbols if s.name == "renamed_main"))
+    new.add_symtab_symbol(lief.ELF.Symbol())
+    out_path = tmp_path / "strtab_replaced.bin"
+    new.write(out_path.as_posix())
+
+    replaced = lief.ELF.parse(out_path.as_posix())
+    assert b"renamed_main" not in bytes(replaced.get_section(".strtab").content)
+    assert len(replaced.symtab_symbols) == len(renamed.symtab_symbols)
+
 @pytest.mark.skipif(not is_linux() or glibc_too_old, reason="not linux or glibc too old")
 def test_add_interpreter(tmp_path):
     TARGET = SAMPLE_DIR / "ELF" / "batch-x86-64" / "test.clang.lld.nolinker.bin"
@@ -349,3 +349,50 @@ def test_core_write(tmp_path: Path):
     assert len(note.description) == orig_siginfo_len
 
     assert note.sigerrno == 0xCC
+
+def test_core_unwinder(tmp_path: Path):
+    core = lief.ELF.parse(get_sample('ELF/ELF64_x86-64_core_hello.core'))
+    status = [n for n in core.notes if isinstance(n, lief.ELF.CorePrStatus)]
+
+    unwinder = lief.ELF.CoreUnwinder()
+    # The modules are not available: only the frame-pointer chain can be used
+    unwinder.sysroot = tmp_path.as_posix()
+    threads = unwinder.unwind(core)
+    assert len(threads) == len(status)
+
+    thread = threads[0]
+    assert thread.tid == status[0].status.pid
+    frame = thread.frames[0]
+    assert frame.method == lief.ELF.CoreUnwinder.METHOD.CONTEXT
+    assert frame.pc == status[0].pc
+    assert frame.sp == status[0].sp
+    for frame in thread.frames[1:]:
+        assert frame.method == lief.ELF.CoreUnwinder.METHOD.FRAME_POINTER
+
+    # Same result with a single worker
+    sequential = unwinder.unwind(core, nb_threads=1)
+    assert [[(f.pc, f.sp) for f in t.frames] for t in sequential] == \
+           [[(f.pc, f.sp) for f in t.frames] for t in threads]
+
+    unwinder.clear_cache()
+    assert unwinder.nb_modules == 0
+
+    assert unwinder.unwind(core, status[0]).tid == thread.tid
+
+    arm_core = lief.ELF.parse(get_sample('ELF/ELF32_ARM_core_hello.core'))
+    assert unwinder.unwind(arm_core) == lief.lief_errors.not_supported
+
+def test_core_file_budget():
+    fpath = get_sample('ELF/ELF32_ARM_core_hello.core')
+    reference = next(n for n in lief.ELF.parse(fpath).notes if isinstance(n, lief.ELF.CoreFile))
+    assert len(reference) == 21
+
+    config = lief.ELF.ParserConfig()
+    config.budget.max_objects = 10
+    core = lief.ELF.parse(fpath, config)
+    assert core.truncation == lief.ParserBudget.TRUNCATION.OBJECTS
+
+    note = next(n for n in core.notes if isinstance(n, lief.ELF.CoreFile))
+    assert len(note) == 10
+    assert note.files[9].path == reference.files[9].path
+    assert bytes(note.description) == bytes(reference.description)
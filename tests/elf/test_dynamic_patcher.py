@@ -0,0 +1,105 @@
+#!/usr/bin/env python
+import shutil
+import struct
+from pathlib import Path
+
+import lief
+from utils import get_sample
+
+def _copy(sample: str, tmp_path: Path) -> Path:
+    output = tmp_path / Path(sample).name
+    shutil.copy(get_sample(sample), output)
+    return output
+
+def test_interpreter(tmp_path: Path):
+    target = _copy('ELF/ELF64_x86-64_binary_ls.bin', tmp_path)
+    original = target.read_bytes()
+
+    patcher = lief.ELF.DynamicPatcher.open(target.as_posix())
+    interpreter = patcher.current_interpreter
+    assert interpreter == "/lib64/ld-linux-x86-64.so.2"
+
+    assert patcher.interpreter("/lib/ld-x64.so")
+    assert patcher.commit()
+
+    new = target.read_bytes()
+    assert len(new) == len(original)
+    assert sum(a != b for a, b in zip(original, new)) <= len(interpreter) + 1
+
+    elf = lief.ELF.parse(target)
+    assert elf.interpreter == "/lib/ld-x64.so"
+
+    # Does not fit in PT_INTERP
+    patcher = lief.ELF.DynamicPatcher.open(target.as_posix())
+    assert patcher.interpreter("/" + "a" * 200) == lief.lief_errors.data_too_large
+
+def test_soname(tmp_path: Path):
+    target = _copy('ELF/ELF64_x86-64_library_libfreebl3.so', tmp_path)
+    nb_symbols = len(lief.ELF.parse(target).dynamic_symbols)
+
+    patcher = lief.ELF.DynamicPatcher.open(target.as_posix())
+    assert patcher.soname("libfb3.so")
+    assert patcher.commit()
+
+    elf = lief.ELF.parse(target)
+    assert elf[lief.ELF.DynamicEntry.TAG.SONAME].name == "libfb3.so"
+    assert len(elf.dynamic_symbols) == nb_symbols
+
+def test_apply(tmp_path: Path):
+    target = _copy('ELF/ELF64_x86-64_binary_ls.bin', tmp_path)
+    libraries = lief.ELF.parse(target).libraries
+
+    runpath = "/opt/" + "x" * 0x800
+    in_place = lief.ELF.DynamicPatcher.apply(target.as_posix(),
+                                             runpath=runpath,
+                                             needed=["libfoo.so"])
+    # The runpath can't fit in .dynstr: the binary is rebuilt
+    assert not in_place
+
+    elf = lief.ELF.parse(target)
+    assert elf[lief.ELF.DynamicEntry.TAG.RUNPATH].runpath == runpath
+    assert elf.libraries == libraries + ["libfoo.so"]
+
+    # The library is already present: nothing is written
+    patcher = lief.ELF.DynamicPatcher.open(target.as_posix())
+    assert patcher.needed == libraries + ["libfoo.so"]
+    assert patcher.add_needed("libfoo.so")
+    assert patcher.modifications == []
+    assert lief.ELF.DynamicPatcher.apply(target.as_posix(), needed=["libfoo.so"])
+
+def test_overflowing_sizes(tmp_path: Path):
+    target = _copy('ELF/ELF64_x86-64_binary_ls.bin', tmp_path)
+    elf = lief.ELF.parse(target)
+    phoff = elf.header.program_header_offset
+    interp_idx = [s.type for s in elf.segments].index(lief.ELF.Segment.TYPE.INTERP)
+    interp = elf.segments[interp_idx]
+
+    # p_offset + p_filesz wraps around
+    raw = bytearray(target.read_bytes())
+    filesz = phoff + interp_idx * 56 + 32
+    raw[filesz:filesz + 8] = struct.pack("<Q", (1 << 64) - interp.file_offset + 0x10)
+    target.write_bytes(raw)
+
+    patcher = lief.ELF.DynamicPatcher.open(target.as_posix())
+    assert not isinstance(patcher, lief.lief_errors)
+    assert patcher.current_interpreter == ""
+
+    # DT_STRTAB's offset + DT_STRSZ wraps around
+    target = _copy('ELF/ELF64_x86-64_binary_ls.bin', tmp_path)
+    raw = bytearray(target.read_bytes())
+    dynamic = elf.get(lief.ELF.Segment.TYPE.DYNAMIC)
+    strsz = [e.tag for e in elf.dynamic_entries].index(lief.ELF.DynamicEntry.TAG.STRSZ)
+    value = dynamic.file_offset + strsz * 16 + 8
+    raw[value:value + 8] = struct.pack("<Q", (1 << 64) - 0x10)
+    target.write_bytes(raw)
+
+    assert lief.ELF.DynamicPatcher.open(target.as_posix()) == lief.lief_errors.corrupted
+
+    # Truncated PT_INTERP: it goes beyond the end of the file
+    target = _copy('ELF/ELF64_x86-64_binary_ls.bin', tmp_path)
+    raw = bytearray(target.read_bytes())
+    raw[filesz:filesz + 8] = struct.pack("<Q", len(raw))
+    target.write_bytes(raw)
+
+    patcher = lief.ELF.DynamicPatcher.open(target.as_posix())
+    assert patcher.current_interpreter == ""
@@ -290,3 +290,36 @@ def test_misc():
     raw_bytes = bytes(int(c, 16) for c in hexdigits)
 
     assert isinstance(lief.ELF.Segment.from_raw(raw_bytes), lief.ELF.Segment)
+
+def test_clone(tmp_path: Path):
+    ls = lief.ELF.parse(get_sample('ELF/ELF64_x86-64_binary_ls.bin'))
+    text = ls.get_section(".text")
+    original = bytes(text.content)
+
+    clone = ls.clone()
+    assert len(clone.sections) == len(ls.sections)
+    assert len(clone.relocations) == len(ls.relocations)
+    assert len(clone.dynamic_symbols) == len(ls.dynamic_symbols)
+    for sym, ref in zip(clone.dynamic_symbols, ls.dynamic_symbols):
+        assert sym.name == ref.name
+        assert sym.has_version == ref.has_version
+        if ref.section is not None:
+            assert sym.section.name == ref.section.name
+
+    # The content is shared until it is modified
+    clone.patch_address(text.virtual_address, [0xcc])
+    clone.add_library("libfoo.so")
+
+    assert bytes(ls.get_section(".text").content) == original
+    assert clone.get_section(".text").content[0] == 0xcc
+    assert not ls.has_library("libfoo.so")
+
+    output = tmp_path / "ls_clone.bin"
+    clone.write(output.as_posix())
+
+    new = lief.ELF.parse(output)
+    assert new.has_library("libfoo.so")
+    assert new.get_section(".text").content[0] == 0xcc
+    assert len(new.dynamic_symbols) == len(ls.dynamic_symbols)
+    assert [s.symbol_version.value for s in new.dynamic_symbols] == \
+           [s.symbol_version.value for s in ls.dynamic_symbols]
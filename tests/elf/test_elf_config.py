@@ -72,3 +72,29 @@ def test_config_no_overlay():
     assert elf.has_overlay
     elf = lief.ELF.parse(fpath, config)
     assert len(elf.overlay) == 0
+
+def test_budget():
+    fpath = get_sample("ELF/ELF64_AARCH64_piebinary_linker64.pie")
+
+    elf = lief.ELF.parse(fpath)
+    assert not elf.is_truncated
+    assert elf.truncation == lief.ParserBudget.TRUNCATION.NONE
+
+    config = lief.ELF.ParserConfig()
+    config.budget.max_objects = 10
+    elf = lief.ELF.parse(fpath, config)
+    assert elf.truncation == lief.ParserBudget.TRUNCATION.OBJECTS
+    assert len(elf.symtab_symbols) <= 10
+
+    stages = []
+    config = lief.ELF.ParserConfig()
+    config.budget.progress = lambda stage, progress: stages.append((stage, progress))
+    lief.ELF.parse(fpath, config)
+    assert stages[0] == ("header", 0.0)
+    assert [p for _, p in stages] == sorted(p for _, p in stages)
+
+    config = lief.ELF.ParserConfig()
+    config.budget.cancellation.cancel()
+    elf = lief.ELF.parse(fpath, config)
+    assert elf.truncation == lief.ParserBudget.TRUNCATION.CANCELLED
+    assert len(elf.sections) == 0
@@ -0,0 +1,119 @@
+import lief
+import struct
+from utils import get_sample
+
+def test_relocate_x86_64():
+    elf = lief.ELF.parse(get_sample('ELF/triton-x8664-systemv-stubs.o'))
+
+    layout = {}
+    address = 0x400000
+    for section in elf.sections:
+        if not section.has(lief.ELF.Section.FLAGS.ALLOC):
+            continue
+        layout[section] = address
+        address += (section.size + 0xfff) & ~0xfff
+
+    imports = {}
+    def resolver(sym: lief.ELF.Symbol):
+        return imports.setdefault(sym.name, 0x10000000 + len(imports) * 0x10)
+
+    nb_applied = elf.relocate(layout, resolver)
+    assert nb_applied > 0
+
+    bases = {section.name: base for section, base in layout.items()}
+    checked = 0
+    for reloc in elf.object_relocations:
+        if reloc.type not in (lief.ELF.Relocation.TYPE.X86_64_PC32,
+                              lief.ELF.Relocation.TYPE.X86_64_PLT32):
+            continue
+        section = reloc.section
+        if section is None or section.name not in bases:
+            continue
+        sym = reloc.symbol
+        if sym.shndx == 0:
+            S = imports[sym.name]
+        else:
+            S = bases[sym.section.name] + sym.value
+        P = bases[section.name] + reloc.address
+        expected = (S + reloc.addend - P) & 0xffffffff
+        value = struct.unpack("<I", bytes(section.content[reloc.address:reloc.address + 4]))[0]
+        assert value == expected
+        checked += 1
+    assert checked > 0
+
+def test_relocate_empty_layout():
+    elf = lief.ELF.parse(get_sample('ELF/issue_984_ilp32.o'))
+    assert elf.relocate({}) == 0
+
+def _layout(elf: lief.ELF.Binary, address: int = 0x400000):
+    layout = {}
+    for section in elf.sections:
+        if not section.has(lief.ELF.Section.FLAGS.ALLOC):
+            continue
+        layout[section] = address
+        address += (section.size + 0xfff) & ~0xfff
+    return layout
+
+def test_relocate_aarch64():
+    elf = lief.ELF.parse(get_sample('ELF/issue_975_aarch64.o'))
+    layout = _layout(elf)
+
+    imports = {}
+    def resolver(sym: lief.ELF.Symbol):
+        return imports.setdefault(sym.name, 0x500000 + len(imports) * 0x10)
+
+    assert elf.relocate(layout, resolver) > 0
+
+    TYPE = lief.ELF.Relocation.TYPE
+    bases = {section.name: base for section, base in layout.items()}
+    checked = 0
+    for reloc in elf.object_relocations:
+        section = reloc.section
+        if section is None or section.name not in bases:
+            continue
+        sym = reloc.symbol
+        if sym.shndx == 0:
+            S = imports[sym.name]
+        else:
+            S = bases[sym.section.name] + sym.value
+        P = bases[section.name] + reloc.address
+        V = S + reloc.addend
+        insn = struct.unpack("<I", bytes(section.content[reloc.address:reloc.address + 4]))[0]
+        if reloc.type in (TYPE.AARCH64_CALL26, TYPE.AARCH64_JUMP26):
+            assert (insn & 0x03ffffff) == ((V - P) >> 2) & 0x03ffffff
+        elif reloc.type == TYPE.AARCH64_ADR_PREL_PG_HI21:
+            imm = ((insn >> 29) & 0x3) | (((insn >> 5) & 0x7ffff) << 2)
+            assert imm == (((V & ~0xfff) - (P & ~0xfff)) >> 12) & 0x1fffff
+        elif reloc.type == TYPE.AARCH64_ADD_ABS_LO12_NC:
+            assert (insn >> 10) & 0xfff == V & 0xfff
+        else:
+            continue
+        checked += 1
+    assert checked > 0
+
+def test_relocate_overflow():
+    path = get_sample('ELF/triton-x8664-systemv-stubs.o')
+    TYPE = lief.ELF.Relocation.TYPE
+
+    elf = lief.ELF.parse(path)
+    nb_applied = elf.relocate(_layout(elf), lambda _: 0x10000000)
+
+    # The imports are more than 2GB away from the code: the PC-relative
+    # relocations that reference them can't be encoded
+    elf = lief.ELF.parse(path)
+    layout = _layout(elf)
+    bases = {section.name for section in layout.keys()}
+    original = {section.name: bytes(section.content) for section in layout.keys()}
+    nb_far = elf.relocate(layout, lambda _: 0x7fff00000000)
+
+    overflowed = [
+        reloc for reloc in elf.object_relocations
+        if reloc.section is not None and reloc.section.name in bases and
+        reloc.symbol.shndx == 0 and
+        reloc.type in (TYPE.X86_64_PC32, TYPE.X86_64_PLT32)
+    ]
+    assert len(overflowed) > 0
+    assert nb_far == nb_applied - len(overflowed)
+    for reloc in overflowed:
+        start, end = reloc.address, reloc.address + 4
+        assert bytes(reloc.section.content[start:end]) == original[reloc.section.name][start:end]
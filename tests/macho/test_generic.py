@@ -3,6 +3,7 @@ import lief
 import pytest
 from utils import get_sample, has_private_samples
 import hashlib
+from pathlib import Path
 
 def test_function_starts():
     dd = lief.MachO.parse(get_sample('MachO/MachO64_x86-64_binary_dd.bin')).at(0)
@@ -342,3 +343,39 @@ def test_arm64e():
     sample = lief.MachO.parse(get_sample("private/MachO/libCoreKE_arm64e.dylib")).at(0)
     assert sample.support_arm64_ptr_auth
 
+
+def test_budget():
+    fpath = get_sample("MachO/FAT_MachO_x86_x86-64_library_libdyld.dylib")
+
+    fat = lief.MachO.parse(fpath)
+    assert len(fat) == 2
+    assert all(bin.truncation == lief.ParserBudget.TRUNCATION.NONE for bin in fat)
+    nb_commands = len(fat.at(1).commands)
+
+    # The FAT header and the load commands are clamped
+    config = lief.MachO.ParserConfig.deep
+    config.budget.max_objects = 1
+    fat = lief.MachO.parse(fpath, config)
+    assert len(fat) == 1
+    assert fat.at(0).truncation == lief.ParserBudget.TRUNCATION.OBJECTS
+    assert len(fat.at(0).commands) == 1
+
+    config = lief.MachO.ParserConfig.deep
+    config.budget.max_objects = 1 << 40
+    fat = lief.MachO.parse(fpath, config)
+    assert len(fat) == 2
+    assert len(fat.at(1).commands) == nb_commands
+
+    # The slices share the memory budget: the copy of the first slice
+    # leaves a few bytes to parse it and the second one is not parsed
+    raw = Path(fpath).read_bytes()
+    first_size = int.from_bytes(raw[8 + 12:8 + 16], "big")
+    config = lief.MachO.ParserConfig.deep
+    config.budget.max_memory = first_size + 16
+    fat = lief.MachO.parse(fpath, config)
+    assert len(fat) == 1
+    assert fat.at(0).truncation == lief.ParserBudget.TRUNCATION.MEMORY
+
+    config = lief.MachO.ParserConfig.deep
+    config.budget.cancellation.cancel()
+    assert len(lief.MachO.parse(fpath, config)) == 0
@@ -60,6 +60,44 @@ def test_rm_symbols(tmp_path):
         print(stdout)
         assert re.search(r'Hello World', stdout) is not None
 
+def test_can_remove_bound_symbols():
+    macho = lief.MachO.parse(get_sample("MachO/MachO64_x86-64_binary_sym2remove.bin")).at(0)
+
+    bound = {b.symbol.name for b in macho.bindings if b.has_symbol}
+    assert len(bound) > 0
+
+    for name in bound:
+        assert not macho.can_remove(macho.get_symbol(name))
+        assert not macho.can_remove_symbol(name)
+
+    sym = macho.get_symbol("_remove_me")
+    assert macho.can_remove(sym)
+    assert macho.unexport(sym)
+    assert not sym.has_export_info
+    assert not macho.unexport(sym)
+
+    assert macho.remove(sym)
+    assert macho.get_symbol("_remove_me") is None
+
+def test_remove_same_name_symbols():
+    macho = lief.MachO.parse(get_sample("MachO/MachO64_x86-64_binary_sym2remove.bin")).at(0)
+
+    name = next(b.symbol.name for b in macho.bindings if b.has_symbol)
+    bound = macho.get_symbol(name)
+    assert not macho.can_remove(bound)
+    nb_bindings = sum(1 for b in macho.bindings if b.has_symbol and b.symbol.name == name)
+
+    # Unbound symbol with the same name as the bound one
+    dup = macho.add_local_symbol(0, name)
+    assert macho.can_remove(dup)
+    assert macho.remove(dup)
+
+    syms = [s for s in macho.symbols if s.name == name]
+    assert len(syms) == 1
+    assert not macho.can_remove(syms[0])
+    # The bindings still reference the (live) bound symbol
+    assert sum(1 for b in macho.bindings if b.has_symbol and b.symbol.name == name) == nb_bindings
+
 def test_dynsym_command():
     macho = lief.MachO.parse(get_sample("MachO/MachO64_x86-64_binary_all.bin")).at(0)
 
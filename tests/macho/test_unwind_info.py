@@ -0,0 +1,48 @@
+import lief
+import pytest
+from utils import get_sample
+
+# The synthetic tables of tests/unittests/test_unwind_info.cpp cover the
+# regular pages and the DWARF entries that these samples might not have
+@pytest.mark.parametrize("sample, arch", [
+    ("MachO/MachO64_x86-64_binary_id.bin", lief.MachO.Header.CPU_TYPE.X86_64),
+    ("MachO/mbedtls_selftest_arm64.bin", lief.MachO.Header.CPU_TYPE.ARM64),
+])
+def test_unwind_info(sample, arch):
+    macho = lief.MachO.parse(get_sample(sample)).at(0)
+    unwind = lief.MachO.UnwindInfo.from_binary(macho)
+
+    assert unwind.version == 1
+    assert unwind.arch == arch
+    assert unwind.imagebase == macho.imagebase
+    assert unwind.nb_pages > 0
+
+    entries = list(unwind.entries)
+    assert len(entries) > 0
+    for prev, cur in zip(entries, entries[1:]):
+        assert prev.address < cur.address
+        assert prev.address + prev.size == cur.address
+
+    starts = [e.address - macho.imagebase for e in entries if e.is_function_start]
+    assert starts == [f.address for f in macho.unwind_functions]
+
+    for entry in entries:
+        for addr in (entry.address, entry.address + entry.size - 1):
+            found = unwind.lookup(addr)
+            assert found.address == entry.address
+            assert found.encoding == entry.encoding
+            assert found.lsda == entry.lsda
+
+    batch = unwind.lookup([e.address for e in entries] + [0])
+    assert [e.encoding for e in batch[:-1]] == [e.encoding for e in entries]
+    assert batch[-1].address == 0
+
+    assert isinstance(unwind.lookup(0), lief.lief_errors)
+
+    for entry in entries:
+        if not unwind.is_dwarf(entry.encoding):
+            assert isinstance(unwind.fde(entry), lief.lief_errors)
+            continue
+        fde = unwind.fde(entry)
+        assert fde.pc_begin == entry.address
+        assert fde.pc_end > fde.pc_begin
@@ -41,3 +41,23 @@ def test_header_key_values():
 
     assert all(k == "foo" for k in header.values)
 
+
+def test_parser_config():
+    path = get_sample('OAT/OAT_079_x86-64_CallDeviceId.oat')
+    assert lief.is_oat(path)
+    assert lief.OAT.version(path) == 79
+
+    oat = lief.OAT.parse(path, lief.OAT.light_config())
+    full = lief.OAT.parse(path)
+    assert oat is not None and full is not None
+
+    assert oat.header.version == full.header.version
+    assert len(oat.oat_dex_files) == len(full.oat_dex_files)
+    assert len(oat.classes) == len(full.classes)
+    assert len(oat.methods) == len(full.methods)
+    assert len(oat.dynamic_symbols) == len(full.dynamic_symbols)
+
+    # The default is the complete ELF parse
+    explicit = lief.OAT.parse(path, lief.ELF.ParserConfig.all)
+    assert len(explicit.relocations) == len(full.relocations)
+    assert len(explicit.symtab_symbols) == len(full.symtab_symbols)
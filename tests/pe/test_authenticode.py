@@ -335,3 +335,42 @@ def test_playready_signature():
     sig = pe.signatures[0]
     spc = sig.signers[0].get_auth_attribute(lief.PE.Attribute.TYPE.SPC_RELAXED_PE_MARKER_CHECK)
     assert spc is not None
+
+def test_page_hashes():
+    # ntoskrnl.exe is signed with SHA-256 page hashes (SPC_PE_IMAGE_PAGE_HASHES_V2)
+    pe = lief.PE.parse(get_sample("PE/ntoskrnl.exe"))
+    content = pe.signatures[0].content_info.value
+    page_hashes = content.page_hashes
+    assert len(page_hashes) > 1
+    assert content.page_hash_algorithm in (lief.PE.ALGORITHMS.SHA_1, lief.PE.ALGORITHMS.SHA_256)
+    assert page_hashes[0].offset == 0
+    assert bytes(page_hashes[-1].digest) == b"\x00" * len(page_hashes[-1].digest)
+    assert bytes(pe.page_hash(0, content.page_hash_algorithm)) == bytes(page_hashes[0].digest)
+    assert pe.verify_pages() == []
+    assert pe.verify_pages(nb_threads=1) == []
+    assert pe.verify_pages(pe.signatures[0], nb_threads=4) == []
+    assert pe.verify_page(pe.optional_header.addressof_entrypoint)
+    assert pe.verify_page(0)
+
+    # Tamper a byte of the section that contains the entrypoint
+    section = pe.section_from_rva(pe.optional_header.addressof_entrypoint)
+    delta = pe.optional_header.addressof_entrypoint - section.virtual_address
+    raw = list(section.content)
+    raw[delta] ^= 0xff
+    section.content = raw
+
+    page_size = pe.optional_header.section_alignment
+    offset = section.offset + delta
+    expected = [offset - (offset - section.offset) % page_size]
+    assert pe.verify_pages() == expected
+    assert pe.verify_pages(nb_threads=1) == expected
+    assert not pe.verify_page(pe.optional_header.addressof_entrypoint)
+    assert pe.verify_page(0)
+
+def test_no_page_hashes():
+    pe = lief.PE.parse(get_sample("PE/PE32_x86-64_binary_avast-free-antivirus-setup-online.exe"))
+    content = pe.signatures[0].content_info.value
+    assert len(content.page_hashes) == 0
+    assert content.page_hash_algorithm == lief.PE.ALGORITHMS.UNKNOWN
+    assert isinstance(pe.verify_pages(), lief.lief_errors)
+    assert isinstance(pe.verify_page(pe.optional_header.addressof_entrypoint), lief.lief_errors)
@@ -23,3 +23,64 @@ def test_basic():
     assert json_serialized["forward_information"]["library"] == "NTDLL"
     assert json_serialized["forward_information"]["function"] == "RtlInterlockedPushListSList"
 
+
+def test_export_resolver():
+    path = get_sample('PE/PE32_x86_library_kernel32.dll')
+    exports = lief.PE.parse(path).get_export()
+
+    config = lief.PE.ParserConfig()
+    config.parse_exports = False
+    pe = lief.PE.parse(path, config)
+    assert not pe.has_exports
+
+    resolver = lief.PE.ExportResolver.from_binary(pe)
+    assert resolver.name == exports.name
+    assert resolver.ordinal_base == exports.ordinal_base
+
+    for entry in exports.entries:
+        found = resolver.find_ordinal(entry.ordinal)
+        assert found.ordinal == entry.ordinal
+        assert found.function_rva == entry.function_rva
+        assert found.is_forwarded == entry.is_forwarded
+        if entry.is_forwarded:
+            assert found.forward_information.library == entry.forward_information.library
+            assert found.forward_information.function == entry.forward_information.function
+
+    for idx in range(resolver.nb_names):
+        name = resolver.name_at(idx)
+        by_name = resolver.find(name)
+        assert by_name.name == name
+        assert resolver.find(name, idx).ordinal == by_name.ordinal
+
+    fwd = next(resolver.find_ordinal(e.ordinal) for e in exports.entries if e.is_forwarded)
+    assert fwd.is_forwarded
+    assert fwd.forward_information.library == "NTDLL"
+    assert fwd.forward_information.function == "RtlInterlockedPushListSList"
+
+    assert isinstance(resolver.find("DoesNotExist"), lief.lief_errors)
+
+def test_import_resolver():
+    kernel32 = lief.PE.parse(get_sample('PE/PE32_x86_library_kernel32.dll'))
+    exports = kernel32.get_export()
+
+    resolver = lief.PE.ImportResolver()
+    resolver.add(kernel32, "KERNEL32.dll")
+    assert resolver.size == 1
+
+    fwd = next(e for e in exports.entries if e.is_forwarded and e.name)
+    res = resolver.resolve("kernel32.dll", fwd.name)
+    assert res.status == lief.PE.ImportResolver.STATUS.MISSING_LIBRARY
+    assert res.library == "ntdll"
+    assert res.chain[0] == f"kernel32!{fwd.name}"
+
+    entry = next(e for e in exports.entries if not e.is_forwarded and e.name)
+    res = resolver.resolve("KERNEL32", entry.name)
+    assert res.is_resolved
+    assert res.rva == entry.function_rva
+    assert resolver.resolve_ordinal("kernel32", entry.ordinal).rva == entry.function_rva
+
+    res = resolver.resolve("api-ms-win-core-file-l1-2-4.dll", "CreateFileW")
+    assert res.status == lief.PE.ImportResolver.STATUS.MISSING_API_SET
+
+    for imp in resolver.resolve_imports(kernel32, "kernel32.dll"):
+        assert len(imp.resolution.chain) > 0
@@ -556,3 +556,40 @@ def test_issue_1049():
 def test_xbox_file():
     pe = lief.PE.parse(get_sample("PE/backcompat.exe"))
     assert pe.header.machine == lief.PE.Header.MACHINE_TYPES.POWERPCBE
+
+def test_budget():
+    fpath = get_sample("PE/PE64_x86-64_library_libLIEF.dll")
+
+    pe = lief.PE.parse(fpath)
+    assert pe.truncation == lief.ParserBudget.TRUNCATION.NONE
+
+    config = lief.PE.ParserConfig()
+    config.budget.max_objects = 2
+    pe = lief.PE.parse(fpath, config)
+    assert pe.truncation == lief.ParserBudget.TRUNCATION.OBJECTS
+    assert len(pe.sections) == 2
+
+    # max_objects can't raise the built-in limits
+    config = lief.PE.ParserConfig()
+    config.budget.max_objects = 1 << 40
+    assert lief.PE.parse(fpath, config).truncation == lief.ParserBudget.TRUNCATION.NONE
+
+    # The content of the sections is accounted
+    config = lief.PE.ParserConfig()
+    config.budget.max_memory = 0x1000
+    pe = lief.PE.parse(fpath, config)
+    assert pe.truncation == lief.ParserBudget.TRUNCATION.MEMORY
+    assert len(pe.sections) == 0
+
+    stages = []
+    config = lief.PE.ParserConfig()
+    config.budget.progress = lambda stage, progress: stages.append((stage, progress))
+    lief.PE.parse(fpath, config)
+    assert stages[0] == ("headers", 0.0)
+    assert [p for _, p in stages] == sorted(p for _, p in stages)
+
+    config = lief.PE.ParserConfig()
+    config.budget.cancellation.cancel()
+    pe = lief.PE.parse(fpath, config)
+    assert pe.truncation == lief.ParserBudget.TRUNCATION.CANCELLED
+    assert len(pe.sections) == 0
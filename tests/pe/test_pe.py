@@ -5,6 +5,7 @@ import json
 import lief
 import os
 import pytest
+import shutil
 import stat
 from pathlib import Path
 
@@ -80,3 +81,34 @@ def test_json(pe_file):
     assert out is not None
     assert len(out) > 0
     assert json.loads(out) is not None
+
+def test_header_patcher(tmp_path: Path):
+    output = tmp_path / "avast.exe"
+    shutil.copy(get_sample("PE/PE32_x86-64_binary_avast-free-antivirus-setup-online.exe"), output)
+    original = lief.PE.parse(output.as_posix())
+    checksum_ok = original.optional_header.checksum == original.compute_checksum()
+
+    patcher = lief.PE.HeaderPatcher.open(output.as_posix())
+    assert patcher.is_signed
+    assert patcher.checksum == original.optional_header.checksum
+
+    # The certificate table's entry is not hashed by Authenticode
+    cert = original.data_directory(lief.PE.DataDirectory.TYPES.CERTIFICATE_TABLE)
+    patcher.data_directory(lief.PE.DataDirectory.TYPES.CERTIFICATE_TABLE, cert.rva, cert.size)
+    assert not patcher.signature_invalidated
+
+    patcher.time_date_stamp(0x11223344)
+    patcher.subsystem(lief.PE.OptionalHeader.SUBSYSTEM.WINDOWS_CUI)
+    assert patcher.signature_invalidated
+    patcher.flush()
+    del patcher
+
+    pe = lief.PE.parse(output.as_posix())
+    assert pe.header.time_date_stamps == 0x11223344
+    assert pe.optional_header.subsystem == lief.PE.OptionalHeader.SUBSYSTEM.WINDOWS_CUI
+    assert pe.optional_header.dll_characteristics == original.optional_header.dll_characteristics
+    if checksum_ok:
+        assert pe.optional_header.checksum == pe.compute_checksum()
+    assert pe.verify_signature() != lief.PE.Signature.VERIFICATION_FLAGS.OK
+    sample = get_sample("PE/PE32_x86-64_binary_avast-free-antivirus-setup-online.exe")
+    assert os.path.getsize(output) == os.path.getsize(sample)
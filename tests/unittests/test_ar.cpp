@@ -0,0 +1,301 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <LIEF/AR.hpp>
+
+#include <cstring>
+#include <string>
+
+using namespace LIEF;
+
+namespace {
+void add_header(std::vector<uint8_t>& out, const std::string& name, size_t size) {
+  char hdr[61];
+  snprintf(hdr, sizeof(hdr), "%-16s%-12s%-6s%-6s%-8s%-10zu`\n",
+           name.c_str(), "0", "0", "0", "644", size);
+  out.insert(out.end(), hdr, hdr + 60);
+}
+
+void add_member(std::vector<uint8_t>& out, const std::string& name,
+                const std::vector<uint8_t>& data)
+{
+  add_header(out, name, data.size());
+  out.insert(out.end(), data.begin(), data.end());
+  if (data.size() & 1) {
+    out.push_back('\n');
+  }
+}
+
+void push_be32(std::vector<uint8_t>& out, uint32_t v) {
+  out.push_back(v >> 24); out.push_back(v >> 16);
+  out.push_back(v >> 8);  out.push_back(v);
+}
+
+void push_be64(std::vector<uint8_t>& out, uint64_t v) {
+  push_be32(out, v >> 32); push_be32(out, v);
+}
+
+void push_le16(std::vector<uint8_t>& out, uint16_t v) {
+  out.push_back(v); out.push_back(v >> 8);
+}
+
+void push_le32(std::vector<uint8_t>& out, uint32_t v) {
+  out.push_back(v);       out.push_back(v >> 8);
+  out.push_back(v >> 16); out.push_back(v >> 24);
+}
+
+void push_le64(std::vector<uint8_t>& out, uint64_t v) {
+  push_le32(out, v); push_le32(out, v >> 32);
+}
+
+void push_str(std::vector<uint8_t>& out, const std::string& str) {
+  out.insert(out.end(), str.begin(), str.end());
+  out.push_back('\0');
+}
+}
+
+TEST_CASE("lief.test.ar", "[lief][test][ar]") {
+  SECTION("GNU") {
+    const std::string long_name = "a_very_long_object_name.o";
+    const std::string long_names = long_name + "/\n";
+    const std::vector<uint8_t> data_a = {1, 2, 3};
+    const std::vector<uint8_t> data_b = {4, 5, 6, 7};
+
+    // Compute the layout: magic | / | // | a.o | long name
+    const size_t symtab_size = 4 + 2 * 4 + sizeof("foo") + sizeof("bar");
+    const size_t off_symtab = 8;
+    const size_t off_names  = off_symtab + 60 + symtab_size + (symtab_size & 1);
+    const size_t off_a      = off_names + 60 + long_names.size() + (long_names.size() & 1);
+    const size_t off_b      = off_a + 60 + data_a.size() + 1;
+
+    std::vector<uint8_t> symtab;
+    push_be32(symtab, 2);
+    push_be32(symtab, off_a);
+    push_be32(symtab, off_b);
+    push_str(symtab, "foo");
+    push_str(symtab, "bar");
+
+    std::vector<uint8_t> raw = {'!', '<', 'a', 'r', 'c', 'h', '>', '\n'};
+    add_member(raw, "/", symtab);
+    add_member(raw, "//", {long_names.begin(), long_names.end()});
+    add_member(raw, "a.o/", data_a);
+    add_member(raw, "/0", data_b);
+
+    REQUIRE(AR::is_archive(raw));
+    std::unique_ptr<AR::Archive> ar = AR::Parser::parse(raw);
+    REQUIRE(ar != nullptr);
+    REQUIRE(ar->kind() == AR::Archive::KIND::GNU);
+    REQUIRE(ar->members().size() == 2);
+
+    const AR::Member* a = ar->get_member("a.o");
+    const AR::Member* b = ar->get_member(long_name);
+    REQUIRE(a != nullptr);
+    REQUIRE(b != nullptr);
+    REQUIRE(a->offset() == off_a);
+    REQUIRE(b->offset() == off_b);
+    REQUIRE(std::vector<uint8_t>(b->content().begin(), b->content().end()) == data_b);
+    // Zero-copy: the content points into the archive's data
+    REQUIRE(b->content().data() == ar->raw().data() + b->data_offset());
+
+    REQUIRE(ar->find_symbol("foo") == a);
+    REQUIRE(ar->find_symbol("bar") == b);
+    REQUIRE(!ar->has_symbol("baz"));
+    REQUIRE(a->format() == Binary::FORMATS::UNKNOWN);
+    REQUIRE(ar->parse(*a) == nullptr);
+  }
+
+  SECTION("BSD") {
+    const std::string name = "long_bsd_name_object.o";
+    const std::string symdef_name = "__.SYMDEF SORTED";
+    const std::vector<uint8_t> data = {0xAA, 0xBB};
+
+    const std::string strtab = std::string("_main") + '\0' + "_foo" + '\0';
+    std::vector<uint8_t> symdef;
+    symdef.insert(symdef.end(), symdef_name.begin(), symdef_name.end());
+    symdef.push_back(0); symdef.push_back(0); symdef.push_back(0); symdef.push_back(0);
+
+    const size_t symdef_size = symdef.size() + 4 + 2 * 8 + 4 + strtab.size();
+    const size_t off_member = 8 + 60 + symdef_size + (symdef_size & 1);
+
+    push_le32(symdef, 2 * 8);
+    push_le32(symdef, 0);
+    push_le32(symdef, off_member);
+    push_le32(symdef, 6);
+    push_le32(symdef, off_member);
+    push_le32(symdef, strtab.size());
+    symdef.insert(symdef.end(), strtab.begin(), strtab.end());
+
+    std::vector<uint8_t> member;
+    member.insert(member.end(), name.begin(), name.end());
+    member.push_back(0); member.push_back(0);
+    member.insert(member.end(), data.begin(), data.end());
+
+    std::vector<uint8_t> raw = {'!', '<', 'a', 'r', 'c', 'h', '>', '\n'};
+    add_member(raw, "#1/" + std::to_string(symdef_name.size() + 4), symdef);
+    add_member(raw, "#1/" + std::to_string(name.size() + 2), member);
+
+    std::unique_ptr<AR::Archive> ar = AR::Parser::parse(raw);
+    REQUIRE(ar != nullptr);
+    REQUIRE(ar->kind() == AR::Archive::KIND::BSD);
+    REQUIRE(ar->members().size() == 1);
+
+    const AR::Member& m = ar->members()[0];
+    REQUIRE(m.name() == name);
+    REQUIRE(m.size() == data.size());
+    REQUIRE(ar->find_symbol("_main") == &m);
+    REQUIRE(ar->find_symbol("_foo") == &m);
+  }
+
+  SECTION("BSD 64-bit") {
+    const std::string symdef_name = "__.SYMDEF_64";
+    const std::string strtab = std::string("_main") + '\0';
+    const std::vector<uint8_t> data = {0xAA, 0xBB};
+
+    auto make = [&] (uint64_t strtab_size) {
+      std::vector<uint8_t> symdef;
+      symdef.insert(symdef.end(), symdef_name.begin(), symdef_name.end());
+      symdef.insert(symdef.end(), 4, 0);
+
+      const size_t strtab_offset = 8 + 2 * 8 + 8;
+      const size_t symdef_size = symdef.size() + strtab_offset + strtab.size();
+      const size_t off_member = 8 + 60 + symdef_size + (symdef_size & 1);
+
+      push_le64(symdef, 2 * 8);
+      push_le64(symdef, 0);
+      push_le64(symdef, off_member);
+      push_le64(symdef, strtab_size != 0 ? strtab_size : -uint64_t(strtab_offset) + 1);
+      symdef.insert(symdef.end(), strtab.begin(), strtab.end());
+
+      std::vector<uint8_t> raw = {'!', '<', 'a', 'r', 'c', 'h', '>', '\n'};
+      add_member(raw, "#1/" + std::to_string(symdef_name.size() + 4), symdef);
+      add_member(raw, "a.o", data);
+      return AR::Parser::parse(raw);
+    };
+
+    std::unique_ptr<AR::Archive> ar = make(strtab.size());
+    REQUIRE(ar != nullptr);
+    REQUIRE(ar->kind() == AR::Archive::KIND::BSD);
+    REQUIRE(ar->find_symbol("_main") == ar->get_member("a.o"));
+
+    // strtab_offset + strtab_size wraps around to 1
+    ar = make(0);
+    REQUIRE(ar != nullptr);
+    REQUIRE(ar->members().size() == 1);
+    REQUIRE(ar->symbols().empty());
+  }
+
+  SECTION("COFF") {
+    // MSVC archive: the first linker member (SysV) is followed by the
+    // second linker member (little-endian, sorted) and the COFF objects
+    std::vector<uint8_t> obj(20, 0);
+    obj[0] = 0x64; obj[1] = 0x86; // IMAGE_FILE_MACHINE_AMD64
+
+    const size_t off_linker2 = 8 + 60 + 20;
+    const size_t off_a = off_linker2 + 60 + 34;
+    const size_t off_b = off_a + 60 + obj.size();
+
+    // The entries of the first linker member are swapped on purpose: the
+    // second one takes precedence
+    std::vector<uint8_t> linker1;
+    push_be32(linker1, 2);
+    push_be32(linker1, off_b);
+    push_be32(linker1, off_a);
+    push_str(linker1, "foo");
+    push_str(linker1, "bar");
+
+    std::vector<uint8_t> linker2;
+    push_le32(linker2, 2);
+    push_le32(linker2, off_a);
+    push_le32(linker2, off_b);
+    push_le32(linker2, 3);
+    push_le16(linker2, 2);
+    push_le16(linker2, 1);
+    push_le16(linker2, 3); // Out of range member index
+    push_str(linker2, "bar");
+    push_str(linker2, "foo");
+    push_str(linker2, "baz");
+
+    std::vector<uint8_t> raw = {'!', '<', 'a', 'r', 'c', 'h', '>', '\n'};
+    add_member(raw, "/", linker1);
+    add_member(raw, "/", linker2);
+    add_member(raw, "a.obj/", obj);
+    add_member(raw, "b.obj/", obj);
+
+    std::unique_ptr<AR::Archive> ar = AR::Parser::parse(raw);
+    REQUIRE(ar != nullptr);
+    REQUIRE(ar->kind() == AR::Archive::KIND::COFF);
+    REQUIRE(ar->members().size() == 2);
+
+    const AR::Member* a = ar->get_member("a.obj");
+    const AR::Member* b = ar->get_member("b.obj");
+    REQUIRE(a != nullptr);
+    REQUIRE(b != nullptr);
+    REQUIRE(a->offset() == off_a);
+    REQUIRE(b->offset() == off_b);
+    REQUIRE(ar->symbols().size() == 2);
+    REQUIRE(ar->find_symbol("foo") == a);
+    REQUIRE(ar->find_symbol("bar") == b);
+    REQUIRE(!ar->has_symbol("baz"));
+
+    // COFF objects are not supported by the PE parser
+    REQUIRE(a->format() == Binary::FORMATS::UNKNOWN);
+    REQUIRE(ar->parse(*a) == nullptr);
+    REQUIRE(ar->parse(2).empty());
+  }
+
+  SECTION("SYM64") {
+    const std::vector<uint8_t> data = {1, 2, 3, 4};
+    const size_t off_a = 8 + 60 + 8 + 8 + sizeof("foo");
+
+    std::vector<uint8_t> symtab;
+    push_be64(symtab, 1);
+    push_be64(symtab, off_a);
+    push_str(symtab, "foo");
+
+    std::vector<uint8_t> raw = {'!', '<', 'a', 'r', 'c', 'h', '>', '\n'};
+    add_member(raw, "/SYM64/", symtab);
+    add_member(raw, "a.o/", data);
+
+    std::unique_ptr<AR::Archive> ar = AR::Parser::parse(raw);
+    REQUIRE(ar != nullptr);
+    REQUIRE(ar->kind() == AR::Archive::KIND::GNU);
+    REQUIRE(ar->find_symbol("foo") == ar->get_member("a.o"));
+
+    // nb_symbols * 8 wraps around to 8
+    std::vector<uint8_t> corrupted = {'!', '<', 'a', 'r', 'c', 'h', '>', '\n'};
+    symtab.clear();
+    push_be64(symtab, 0x2000000000000001);
+    push_be64(symtab, off_a);
+    push_str(symtab, "foo");
+    add_member(corrupted, "/SYM64/", symtab);
+    add_member(corrupted, "a.o/", data);
+
+    ar = AR::Parser::parse(corrupted);
+    REQUIRE(ar != nullptr);
+    REQUIRE(ar->members().size() == 1);
+    REQUIRE(ar->symbols().empty());
+  }
+
+  SECTION("Corrupted") {
+    std::vector<uint8_t> raw = {'!', '<', 'a', 'r', 'c', 'h', '>', '\n'};
+    add_header(raw, "a.o/", 0x1000);
+    std::unique_ptr<AR::Archive> ar = AR::Parser::parse(raw);
+    REQUIRE(ar != nullptr);
+    REQUIRE(ar->members().empty());
+    REQUIRE(AR::Parser::parse(std::vector<uint8_t>{1, 2, 3}) == nullptr);
+  }
+}
@@ -0,0 +1,241 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <LIEF/ART.hpp>
+
+#include <cstdio>
+#include <cstring>
+
+using namespace LIEF;
+
+namespace {
+constexpr uint32_t IMAGE_BEGIN = 0x70000000;
+
+// Blocks produced by the reference implementation (``lz4 -l -12``)
+
+// "java.lang.Object #00\n" ... "java.lang.Object #31\n"
+const std::vector<uint8_t> LZ4_OBJECTS = {
+  0xfe, 0x07, 0x6a, 0x61, 0x76, 0x61, 0x2e, 0x6c, 0x61, 0x6e, 0x67, 0x2e,
+  0x4f, 0x62, 0x6a, 0x65, 0x63, 0x74, 0x20, 0x23, 0x30, 0x30, 0x0a, 0x6a,
+  0x15, 0x00, 0x1f, 0x31, 0x15, 0x00, 0x01, 0x1f, 0x32, 0x15, 0x00, 0x01,
+  0x1f, 0x33, 0x15, 0x00, 0x01, 0x1f, 0x34, 0x15, 0x00, 0x01, 0x1f, 0x35,
+  0x15, 0x00, 0x01, 0x1f, 0x36, 0x15, 0x00, 0x01, 0x1f, 0x37, 0x15, 0x00,
+  0x01, 0x1f, 0x38, 0x15, 0x00, 0x01, 0x2e, 0x39, 0x0a, 0x15, 0x00, 0x2f,
+  0x31, 0x30, 0x15, 0x00, 0x01, 0x1f, 0x31, 0x15, 0x00, 0x01, 0x1f, 0x32,
+  0x15, 0x00, 0x01, 0x1f, 0x33, 0x15, 0x00, 0x01, 0x1f, 0x34, 0x15, 0x00,
+  0x01, 0x1f, 0x35, 0x15, 0x00, 0x01, 0x1f, 0x36, 0x15, 0x00, 0x01, 0x1f,
+  0x37, 0x15, 0x00, 0x01, 0x1f, 0x38, 0x15, 0x00, 0x01, 0x0f, 0xd2, 0x00,
+  0x01, 0x2f, 0x32, 0x30, 0x15, 0x00, 0x01, 0x1f, 0x31, 0x15, 0x00, 0x01,
+  0x1f, 0x32, 0x15, 0x00, 0x01, 0x1f, 0x33, 0x15, 0x00, 0x01, 0x1f, 0x34,
+  0x15, 0x00, 0x01, 0x1f, 0x35, 0x15, 0x00, 0x01, 0x1f, 0x36, 0x15, 0x00,
+  0x01, 0x1f, 0x37, 0x15, 0x00, 0x01, 0x1f, 0x38, 0x15, 0x00, 0x01, 0x0f,
+  0xd2, 0x00, 0x01, 0x1e, 0x33, 0xd2, 0x00, 0x50, 0x20, 0x23, 0x33, 0x31,
+  0x0a,
+};
+
+// 'A' * 1000 + "<art>": overlapping match (offset 1) and 255-byte length
+// extensions
+const std::vector<uint8_t> LZ4_RUN = {
+  0x1f, 0x41, 0x01, 0x00, 0xff, 0xff, 0xff, 0xd7, 0x50, 0x3c, 0x61, 0x72,
+  0x74, 0x3e,
+};
+
+std::vector<uint8_t> objects_text() {
+  std::string text;
+  char line[32];
+  for (size_t i = 0; i < 32; ++i) {
+    snprintf(line, sizeof(line), "java.lang.Object #%02zu\n", i);
+    text += line;
+  }
+  return {text.begin(), text.end()};
+}
+
+std::vector<uint8_t> run_text() {
+  std::vector<uint8_t> text(1000, 'A');
+  for (char c : std::string("<art>")) {
+    text.push_back(c);
+  }
+  return text;
+}
+
+template<class T>
+void put(std::vector<uint8_t>& out, size_t offset, T value) {
+  std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+// Size of the header for the versions (29 and 56) supported by make_art()
+size_t header_size(uint32_t version) {
+  return version == 29 ? 200 : 232;
+}
+
+// Build an ART image whose data (the part that follows the header) is
+// ``image`` and is stored as ``stored`` in the file
+std::vector<uint8_t> make_art(uint32_t version, ART::STORAGE_MODES mode,
+                              const std::vector<uint8_t>& image,
+                              const std::vector<uint8_t>& stored)
+{
+  const size_t hdr_size = header_size(version);
+  const size_t nb_sections = version == 29 ? 9 : 10;
+  const size_t nb_methods = version == 29 ? 6 : 9;
+  const size_t storage_mode = 72 + nb_sections * 8 + nb_methods * 8;
+
+  std::vector<uint8_t> out(hdr_size);
+  std::memcpy(out.data(), "art\n", 4);
+  char str_version[4] = {};
+  snprintf(str_version, sizeof(str_version), "%03u", version);
+  std::memcpy(out.data() + 4, str_version, 4);
+
+  put<uint32_t>(out, 8,  IMAGE_BEGIN);
+  put<uint32_t>(out, 12, hdr_size + image.size());
+  put<uint32_t>(out, 60, sizeof(uint32_t)); // pointer_size
+
+  // OBJECTS
+  put<uint32_t>(out, 72, hdr_size);
+  put<uint32_t>(out, 76, image.size());
+
+  put<uint32_t>(out, storage_mode, mode);
+  put<uint32_t>(out, storage_mode + 4, stored.size());
+
+  out.insert(out.end(), stored.begin(), stored.end());
+  return out;
+}
+
+const ART::ImageReader& image(const std::unique_ptr<ART::File>& file) {
+  REQUIRE(file != nullptr);
+  REQUIRE(file->image() != nullptr);
+  return *file->image();
+}
+}
+
+TEST_CASE("lief.test.art.uncompressed", "[lief][test][art]") {
+  const std::vector<uint8_t> text = objects_text();
+  for (uint32_t version : {29, 56}) {
+    std::unique_ptr<ART::File> file =
+      ART::Parser::parse(make_art(version, ART::STORAGE_UNCOMPRESSED, text, text));
+    const ART::ImageReader& reader = image(file);
+
+    CHECK(reader.image_begin() == IMAGE_BEGIN);
+    CHECK(reader.pointer_size() == 4);
+    CHECK(file->header().storage_mode() == ART::STORAGE_UNCOMPRESSED);
+
+    auto data = reader.read(IMAGE_BEGIN + header_size(version), text.size());
+    REQUIRE(data);
+    CHECK(*data == text);
+    CHECK(reader.nb_decoded_blocks() == 0);
+  }
+}
+
+TEST_CASE("lief.test.art.lz4", "[lief][test][art]") {
+  const std::vector<uint8_t> objects = objects_text();
+  const std::vector<uint8_t> run = run_text();
+
+  for (uint32_t version : {29, 56}) {
+    for (ART::STORAGE_MODES mode : {ART::STORAGE_LZ4, ART::STORAGE_LZ4HC}) {
+      const uint64_t base = IMAGE_BEGIN + header_size(version);
+      {
+        std::unique_ptr<ART::File> file =
+          ART::Parser::parse(make_art(version, mode, objects, LZ4_OBJECTS));
+        const ART::ImageReader& reader = image(file);
+        CHECK(file->header().storage_mode() == mode);
+        CHECK(reader.nb_decoded_blocks() == 0);
+
+        // The header is never compressed
+        auto magic = reader.read(IMAGE_BEGIN, 4);
+        REQUIRE(magic);
+        CHECK(std::memcmp(magic->data(), "art\n", 4) == 0);
+        CHECK(reader.nb_decoded_blocks() == 0);
+
+        auto data = reader.read(base, objects.size());
+        REQUIRE(data);
+        CHECK(*data == objects);
+        CHECK(reader.nb_decoded_blocks() == 1);
+
+        auto line = reader.read(base + 21 * 31, 21);
+        REQUIRE(line);
+        CHECK(std::string(line->begin(), line->end()) == "java.lang.Object #31\n");
+        // Read that straddles the header and the block
+        CHECK(reader.read(base - 4, 8));
+        CHECK(reader.nb_decoded_blocks() == 1);
+      }
+      {
+        std::unique_ptr<ART::File> file =
+          ART::Parser::parse(make_art(version, mode, run, LZ4_RUN));
+        auto data = image(file).read(base, run.size());
+        REQUIRE(data);
+        CHECK(*data == run);
+      }
+    }
+  }
+}
+
+TEST_CASE("lief.test.art.lz4_corrupted", "[lief][test][art]") {
+  const std::vector<uint8_t> objects = objects_text();
+  const std::vector<uint8_t> run = run_text();
+  const uint64_t base = IMAGE_BEGIN + header_size(56);
+
+  {
+    // Truncated literals
+    std::vector<uint8_t> truncated(LZ4_OBJECTS.begin(), LZ4_OBJECTS.end() - 3);
+    std::unique_ptr<ART::File> file =
+      ART::Parser::parse(make_art(56, ART::STORAGE_LZ4, objects, truncated));
+    const ART::ImageReader& reader = image(file);
+    CHECK_FALSE(reader.read(base, objects.size()));
+    CHECK_FALSE(reader.read(base + 8, 4));
+    CHECK(reader.nb_decoded_blocks() == 0);
+
+    // The header is still readable
+    CHECK(reader.read(IMAGE_BEGIN, 8));
+  }
+  {
+    // Truncated match offset
+    std::vector<uint8_t> truncated(LZ4_RUN.begin(), LZ4_RUN.begin() + 3);
+    std::vector<uint8_t> small(run.begin(), run.begin() + 100);
+    std::unique_ptr<ART::File> file =
+      ART::Parser::parse(make_art(56, ART::STORAGE_LZ4, small, truncated));
+    CHECK_FALSE(image(file).read(base, 4));
+  }
+  {
+    // Null match offset
+    std::vector<uint8_t> corrupted = LZ4_RUN;
+    corrupted[2] = 0;
+    std::unique_ptr<ART::File> file =
+      ART::Parser::parse(make_art(56, ART::STORAGE_LZ4, run, corrupted));
+    CHECK_FALSE(image(file).read(base, 4));
+  }
+  {
+    // Match before the start of the output
+    std::vector<uint8_t> corrupted = LZ4_RUN;
+    corrupted[2] = 2;
+    std::unique_ptr<ART::File> file =
+      ART::Parser::parse(make_art(56, ART::STORAGE_LZ4, run, corrupted));
+    CHECK_FALSE(image(file).read(base, 4));
+  }
+  {
+    // Decompressed data larger than the image
+    std::vector<uint8_t> small(run.begin(), run.begin() + 100);
+    std::unique_ptr<ART::File> file =
+      ART::Parser::parse(make_art(56, ART::STORAGE_LZ4, small, LZ4_RUN));
+    CHECK_FALSE(image(file).read(base, 4));
+  }
+  {
+    // Compression ratio that LZ4 can't reach
+    std::vector<uint8_t> large(0x10000, 'A');
+    std::unique_ptr<ART::File> file =
+      ART::Parser::parse(make_art(56, ART::STORAGE_LZ4, large, LZ4_RUN));
+    CHECK_FALSE(image(file).read(base, 4));
+  }
+}
@@ -23,9 +23,79 @@
 #include <LIEF/BinaryStream/SpanStream.hpp>
 #include <LIEF/BinaryStream/VectorStream.hpp>
 #include <LIEF/BinaryStream/FileStream.hpp>
+#include <LIEF/BinaryStream/CompressedStream.hpp>
+#include <LIEF/BinaryStream/ForwardStream.hpp>
+#include <LIEF/Abstract/Parser.hpp>
+#include <LIEF/Abstract/Binary.hpp>
+#include <LIEF/ELF/Binary.hpp>
+#include <LIEF/ZIP/utils.hpp>
 
 using namespace LIEF;
 
+namespace {
+const std::vector<uint8_t> GZIP_HEADER = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff
+};
+
+void push_le32(std::vector<uint8_t>& out, uint32_t v) {
+  out.push_back(v);       out.push_back(v >> 8);
+  out.push_back(v >> 16); out.push_back(v >> 24);
+}
+
+// gzip member made of deflate stored blocks
+std::vector<uint8_t> gzip_stored(const std::vector<uint8_t>& raw) {
+  std::vector<uint8_t> gz = GZIP_HEADER;
+  size_t pos = 0;
+  do {
+    const size_t size = std::min<size_t>(0xffff, raw.size() - pos);
+    const bool is_final = pos + size == raw.size();
+    gz.push_back(is_final ? 1 : 0);
+    gz.push_back(size & 0xff);
+    gz.push_back((size >> 8) & 0xff);
+    gz.push_back(~size & 0xff);
+    gz.push_back((~size >> 8) & 0xff);
+    gz.insert(gz.end(), raw.begin() + pos, raw.begin() + pos + size);
+    pos += size;
+  } while (pos < raw.size());
+  push_le32(gz, ZIP::crc32(raw));
+  push_le32(gz, raw.size());
+  return gz;
+}
+
+// Deflate block with fixed Huffman codes that encodes a literal 0 followed by
+// ``count`` matches (length: 258, distance: 1), i.e. 1 + 258 * count zeros
+std::vector<uint8_t> deflate_zeros(size_t count) {
+  std::vector<uint8_t> out;
+  uint32_t acc = 0;
+  uint32_t nbits = 0;
+  auto put = [&] (uint32_t value, uint32_t size) {
+    acc |= value << nbits;
+    nbits += size;
+    for (; nbits >= 8; nbits -= 8, acc >>= 8) {
+      out.push_back(acc & 0xff);
+    }
+  };
+  // Huffman codes are packed starting from their most significant bit
+  auto put_code = [&] (uint32_t code, uint32_t size) {
+    for (uint32_t i = size; i > 0; --i) {
+      put((code >> (i - 1)) & 1, 1);
+    }
+  };
+  put(1, 1);            // BFINAL
+  put(1, 2);            // BTYPE: fixed Huffman codes
+  put_code(0x30, 8);    // Literal 0
+  for (size_t i = 0; i < count; ++i) {
+    put_code(0xc5, 8);  // Length code 285 (258)
+    put_code(0, 5);     // Distance code 0 (1)
+  }
+  put_code(0, 7);       // End of block (256)
+  if (nbits > 0) {
+    out.push_back(acc & 0xff);
+  }
+  return out;
+}
+}
+
 TEST_CASE("lief.test.binarystream", "[lief][test][binarystream]") {
   SECTION("MemoryStream") {
     std::vector<uint8_t> buffer = {
@@ -79,4 +149,271 @@ TEST_CASE("lief.test.binarystream", "[lief][test][binarystream]") {
     REQUIRE(vs.start() != vs.p());
   }
 
+  SECTION("CompressedStream") {
+    // gzip -9 of "0: LIEF compressed stream\n" ... "63: LIEF compressed stream\n"
+    // (dynamic Huffman codes)
+    std::vector<uint8_t> gz = {
+      0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0xd4,
+      0xbb, 0x4d, 0x04, 0x51, 0x0c, 0x40, 0xd1, 0x9c, 0x2a, 0xa6, 0x84, 0xf5,
+      0xef, 0x2d, 0x90, 0x83, 0x84, 0x44, 0x13, 0x88, 0x9d, 0x70, 0x05, 0xda,
+      0xa1, 0x7f, 0x51, 0xc1, 0x99, 0xf8, 0x46, 0x3e, 0xb2, 0x7d, 0x79, 0xdd,
+      0x3e, 0x3f, 0xde, 0xde, 0xb7, 0xef, 0x9f, 0xfb, 0xef, 0x63, 0x3f, 0x8e,
+      0xfd, 0xb6, 0x1d, 0x7f, 0x8f, 0xfd, 0xeb, 0xfe, 0x14, 0x2c, 0xc9, 0x52,
+      0x2c, 0xcd, 0x32, 0x2c, 0x8b, 0xe5, 0xca, 0xf2, 0xcc, 0xf2, 0xe2, 0x49,
+      0x2f, 0x4e, 0x56, 0x08, 0x33, 0x84, 0x1d, 0xc2, 0x10, 0x61, 0x89, 0x30,
+      0x45, 0xd8, 0x22, 0x8c, 0x11, 0xd6, 0x48, 0x6b, 0xe4, 0xc9, 0x4e, 0x58,
+      0x23, 0xad, 0x91, 0xd6, 0x48, 0x6b, 0xa4, 0x35, 0xd2, 0x1a, 0x69, 0x8d,
+      0xb4, 0x46, 0x59, 0xa3, 0xac, 0x51, 0x27, 0x27, 0x62, 0x8d, 0xb2, 0x46,
+      0x59, 0xa3, 0xac, 0x51, 0xd6, 0x28, 0x6b, 0x94, 0x35, 0xda, 0x1a, 0x6d,
+      0x8d, 0xb6, 0x46, 0x9f, 0x7c, 0x0c, 0x6b, 0xb4, 0x35, 0xda, 0x1a, 0x6d,
+      0x8d, 0xb6, 0x46, 0x5b, 0x63, 0xac, 0x31, 0xd6, 0x18, 0x6b, 0x8c, 0x35,
+      0xe6, 0xe4, 0x81, 0x5a, 0x63, 0xac, 0x31, 0xd6, 0x18, 0x6b, 0x8c, 0x35,
+      0x96, 0x35, 0x96, 0x35, 0x96, 0x35, 0x96, 0x35, 0xfe, 0x01, 0x6a, 0xc7,
+      0x72, 0xf6, 0xb6, 0x06, 0x00, 0x00
+    };
+    auto cstream = CompressedStream::from_stream(std::make_unique<VectorStream>(gz));
+    REQUIRE(cstream);
+    CompressedStream& cs = *cstream;
+    REQUIRE(CompressedStream::classof(cs));
+    REQUIRE(cs.format() == CompressedStream::FORMAT::GZIP);
+    REQUIRE(cs.size() == 1718);
+    // peek_string() replaces the last character read with the null terminator
+    REQUIRE(*cs.peek_string_at(0, 26) == "0: LIEF compressed stream");
+    REQUIRE(*cs.peek_string_at(1691) == "63: LIEF compressed stream");
+
+    std::vector<uint8_t> buffer;
+    REQUIRE(!cs.peek_data(buffer, 1700, 100));
+  }
+
+  SECTION("CompressedStream - Seek index") {
+    // Wrap an ELF sample in a gzip stream made of stored blocks
+    const std::string path = test::get_elf_sample("ELF64_x86-64_binary_ls.bin");
+    auto fstream = FileStream::from_file(path);
+    REQUIRE(fstream);
+    const std::vector<uint8_t> raw = fstream->content();
+
+    const std::vector<uint8_t> gz = gzip_stored(raw);
+
+    CompressedStream::config_t config;
+    config.index_span = 0x10000;
+    config.cache_size = 2;
+    auto cstream = CompressedStream::from_stream(std::make_unique<VectorStream>(gz), config);
+    REQUIRE(cstream);
+    REQUIRE(cstream->size() == raw.size());
+    REQUIRE(cstream->nb_seek_points() > 1);
+
+    std::vector<uint8_t> buffer;
+    for (uint64_t offset : {raw.size() / 2, uint64_t(0), raw.size() - 0x20010, uint64_t(0xfff0)}) {
+      REQUIRE(cstream->peek_data(buffer, offset, 0x20));
+      REQUIRE(std::equal(buffer.begin(), buffer.end(), raw.begin() + offset));
+    }
+    REQUIRE(cstream->content() == raw);
+
+    std::unique_ptr<Binary> bin = Parser::parse(std::make_unique<VectorStream>(gz));
+    REQUIRE(bin != nullptr);
+    REQUIRE(ELF::Binary::classof(bin.get()));
+    REQUIRE(bin->entrypoint() == Parser::parse(path)->entrypoint());
+
+    // Only one level of compression is handled by the parser
+    REQUIRE(Parser::parse(std::make_unique<VectorStream>(gzip_stored(gz))) == nullptr);
+  }
+
+  SECTION("CompressedStream - read_at") {
+    std::vector<uint8_t> raw(0x50000);
+    for (size_t i = 0; i < raw.size(); ++i) {
+      raw[i] = (i * 7) ^ (i >> 8);
+    }
+
+    CompressedStream::config_t config;
+    config.index_span = 0x8000;
+    config.cache_size = 1;
+    auto cstream = CompressedStream::from_stream(std::make_unique<VectorStream>(gzip_stored(raw)), config);
+    REQUIRE(cstream);
+    REQUIRE(cstream->nb_seek_points() > 3);
+
+    // The pointers remain valid while other chunks are decompressed
+    const uint8_t* first = cstream->peek_array<uint8_t>(0x100, 0x10);
+    const uint8_t* across = cstream->peek_array<uint8_t>(0xfff8, 0x10);
+    REQUIRE(first != nullptr);
+    REQUIRE(across != nullptr);
+    std::vector<uint8_t> buffer;
+    for (uint64_t offset : {0x20000, 0x40000, 0x10000, 0x30000}) {
+      REQUIRE(cstream->peek_data(buffer, offset, 0x20));
+      REQUIRE(cstream->peek_array<uint8_t>(offset + 0x20, 0x10) != nullptr);
+    }
+    REQUIRE(std::equal(first, first + 0x10, raw.begin() + 0x100));
+    REQUIRE(std::equal(across, across + 0x10, raw.begin() + 0xfff8));
+
+    // The leases of the old pointers are recycled (bounded memory)
+    for (size_t i = 0; i < 4 * CompressedStream::READ_AT_LEASES; ++i) {
+      const uint64_t offset = (i * 0x8000 + 0x7ff8) % (raw.size() - 0x10);
+      const uint8_t* ptr = cstream->peek_array<uint8_t>(offset, 0x10);
+      REQUIRE(ptr != nullptr);
+      REQUIRE(std::equal(ptr, ptr + 0x10, raw.begin() + offset));
+    }
+  }
+
+  SECTION("CompressedStream - Limits") {
+    const size_t count = 0x2000;
+    const std::vector<uint8_t> zeros(1 + 258 * count, 0);
+    const std::vector<uint8_t> deflate = deflate_zeros(count);
+
+    std::vector<uint8_t> gz = GZIP_HEADER;
+    gz.insert(gz.end(), deflate.begin(), deflate.end());
+    push_le32(gz, ZIP::crc32(zeros));
+    push_le32(gz, zeros.size());
+
+    // ~160:1, above the default ratio
+    auto cstream = CompressedStream::from_stream(std::make_unique<VectorStream>(gz));
+    REQUIRE(!cstream);
+    REQUIRE(cstream.error() == lief_errors::data_too_large);
+
+    CompressedStream::config_t config;
+    config.max_ratio = 0;
+    cstream = CompressedStream::from_stream(std::make_unique<VectorStream>(gz), config);
+    REQUIRE(cstream);
+    REQUIRE(cstream->content() == zeros);
+
+    config.max_size = 0x1000;
+    cstream = CompressedStream::from_stream(std::make_unique<VectorStream>(gz), config);
+    REQUIRE(!cstream);
+    REQUIRE(cstream.error() == lief_errors::data_too_large);
+
+    {
+      // The limit is enforced while the (single) block is decoded: the
+      // decoder stops before reaching the truncated end of the block
+      std::vector<uint8_t> truncated = GZIP_HEADER;
+      truncated.insert(truncated.end(), deflate.begin(), deflate.begin() + deflate.size() / 2);
+      cstream = CompressedStream::from_stream(std::make_unique<VectorStream>(truncated), config);
+      REQUIRE(!cstream);
+      REQUIRE(cstream.error() == lief_errors::data_too_large);
+    }
+
+    // Corrupted trailers
+    config.max_size = 0;
+    for (size_t offset : {gz.size() - 8, gz.size() - 1}) {
+      std::vector<uint8_t> corrupted = gz;
+      corrupted[offset] ^= 1;
+      REQUIRE(!CompressedStream::from_stream(std::make_unique<VectorStream>(corrupted), config));
+      config.check_integrity = false;
+      REQUIRE(CompressedStream::from_stream(std::make_unique<VectorStream>(corrupted), config));
+      config.check_integrity = true;
+    }
+  }
+
+  SECTION("CompressedStream - zlib") {
+    const std::vector<uint8_t> zeros(1 + 258 * 4, 0);
+    const std::vector<uint8_t> deflate = deflate_zeros(4);
+    std::vector<uint8_t> zlib = {0x78, 0x9c};
+    zlib.insert(zlib.end(), deflate.begin(), deflate.end());
+    // Adler-32 of the zeros (big-endian)
+    const uint32_t adler = (uint32_t(zeros.size()) << 16) | 1;
+    zlib.push_back(adler >> 24); zlib.push_back(adler >> 16);
+    zlib.push_back(adler >> 8);  zlib.push_back(adler);
+
+    VectorStream vs(zlib);
+    REQUIRE(CompressedStream::detect(vs) == CompressedStream::FORMAT::UNKNOWN);
+    REQUIRE(CompressedStream::detect(vs, /*zlib=*/true) == CompressedStream::FORMAT::ZLIB);
+
+    REQUIRE(!CompressedStream::from_stream(std::make_unique<VectorStream>(zlib)));
+    CompressedStream::config_t config;
+    config.zlib = true;
+    auto cstream = CompressedStream::from_stream(std::make_unique<VectorStream>(zlib), config);
+    REQUIRE(cstream);
+    REQUIRE(cstream->format() == CompressedStream::FORMAT::ZLIB);
+    REQUIRE(cstream->content() == zeros);
+
+    zlib.back() ^= 1;
+    REQUIRE(!CompressedStream::from_stream(std::make_unique<VectorStream>(zlib), config));
+  }
+
+
+  SECTION("ForwardStream") {
+    const std::string path = test::get_elf_sample("ELF64_x86-64_binary_ls.bin");
+    auto fstream = FileStream::from_file(path);
+    REQUIRE(fstream);
+    const std::vector<uint8_t> raw = fstream->content();
+
+    // Source that delivers (at most) 0x100 bytes per call, like a pipe
+    auto make_reader = [&raw] {
+      return [&raw, pos = size_t(0)] (uint8_t* dst, size_t size) mutable {
+        const size_t count = std::min<size_t>({size, 0x100, raw.size() - pos});
+        std::copy(raw.begin() + pos, raw.begin() + pos + count, dst);
+        pos += count;
+        return count;
+      };
+    };
+
+    {
+      ForwardStream::config_t config;
+      config.size = raw.size();
+      ForwardStream stream(make_reader(), config);
+      REQUIRE(stream.size() == raw.size());
+      REQUIRE(stream.buffered() == 0);
+
+      auto magic = stream.peek<uint32_t>(0);
+      REQUIRE(magic);
+      REQUIRE(*magic == 0x464c457f);
+      REQUIRE(stream.buffered() < raw.size());
+
+      std::vector<uint8_t> rest;
+      const uint64_t drained = stream.drain([&rest] (span<const uint8_t> data) {
+        rest.insert(rest.end(), data.begin(), data.end());
+      });
+      REQUIRE(stream.is_eof());
+      REQUIRE(stream.buffered() + drained == raw.size());
+      REQUIRE(std::equal(rest.begin(), rest.end(), raw.begin() + stream.buffered()));
+      REQUIRE(!stream.peek<uint8_t>(raw.size() - 1));
+    }
+
+    {
+      ForwardStream::config_t config;
+      config.max_buffer = 0x1000;
+      ForwardStream stream(make_reader(), config);
+      REQUIRE(stream.peek<uint64_t>(0x100));
+      REQUIRE(!stream.peek<uint64_t>(0x2000));
+    }
+
+    std::unique_ptr<Binary> bin = Parser::parse(std::make_unique<ForwardStream>(make_reader()));
+    REQUIRE(bin != nullptr);
+    REQUIRE(ELF::Binary::classof(bin.get()));
+    REQUIRE(bin->entrypoint() == Parser::parse(path)->entrypoint());
+
+    {
+      // Known size: the whole input is parsed and the data that follow it
+      // are left in the source
+      std::vector<uint8_t> source = raw;
+      const std::string trailer = "next message";
+      source.insert(source.end(), trailer.begin(), trailer.end());
+      size_t pos = 0;
+      auto reader = [&source, &pos] (uint8_t* dst, size_t size) {
+        const size_t count = std::min<size_t>({size, 0x100, source.size() - pos});
+        std::copy(source.begin() + pos, source.begin() + pos + count, dst);
+        pos += count;
+        return count;
+      };
+
+      ForwardStream::config_t config;
+      config.size = raw.size();
+      std::unique_ptr<Binary> bin = Parser::parse(std::make_unique<ForwardStream>(reader, config));
+      REQUIRE(bin != nullptr);
+      REQUIRE(pos == raw.size());
+      std::unique_ptr<Binary> ref = Parser::parse(path);
+      REQUIRE(bin->entrypoint() == ref->entrypoint());
+      REQUIRE(bin->sections().size() == ref->sections().size());
+      REQUIRE(bin->symbols().size() == ref->symbols().size());
+      REQUIRE(static_cast<ELF::Binary&>(*bin).eof_offset() ==
+              static_cast<ELF::Binary&>(*ref).eof_offset());
+
+      pos = 0;
+      ForwardStream stream(reader, config);
+      REQUIRE(stream.peek<uint32_t>(0x100));
+      uint64_t drained = stream.drain([] (span<const uint8_t>) {});
+      REQUIRE(stream.is_eof());
+      REQUIRE(stream.buffered() + drained == raw.size());
+      REQUIRE(pos == raw.size());
+      REQUIRE(stream.drain([] (span<const uint8_t>) {}) == 0);
+    }
+  }
+
 }
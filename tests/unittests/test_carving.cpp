@@ -0,0 +1,112 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <LIEF/carving.hpp>
+#include <LIEF/Abstract/Binary.hpp>
+#include <LIEF/utils.hpp>
+
+#include <fstream>
+#include <iterator>
+
+#include "utils.hpp"
+
+using namespace LIEF;
+
+namespace {
+std::vector<uint8_t> read_file(const std::string& path) {
+  std::ifstream ifs(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+}
+
+size_t append(std::vector<uint8_t>& blob, const std::vector<uint8_t>& data) {
+  // Some noise with partial magics before the binary
+  static const uint8_t NOISE[] = {'M', 'Z', 0x7f, 'E', 'L', 0xca, 0xfe, 'd', 'e', 'x'};
+  blob.insert(blob.end(), std::begin(NOISE), std::end(NOISE));
+  blob.resize(align(blob.size(), 0x1000), 0);
+  const size_t offset = blob.size();
+  blob.insert(blob.end(), data.begin(), data.end());
+  return offset;
+}
+}
+
+TEST_CASE("lief.test.carving", "[lief][test][carving]") {
+  const std::vector<uint8_t> elf = read_file(test::get_elf_sample("ELF32_ARM_binary_ls.bin"));
+  const std::vector<uint8_t> pe = read_file(test::get_pe_sample("PE64_x86-64_binary_WinApp.exe"));
+  const std::vector<uint8_t> macho = read_file(test::get_macho_sample("alivcffmpeg_armv7.dylib"));
+
+  std::vector<uint8_t> blob;
+  const size_t elf_off = append(blob, elf);
+  const size_t pe_off = append(blob, pe);
+  const size_t macho_off = append(blob, macho);
+  append(blob, {});
+
+  SECTION("Scan") {
+    std::vector<carving::Candidate> candidates = carving::scan(blob);
+    REQUIRE(candidates.size() == 3);
+
+    CHECK(candidates[0].format() == carving::FORMAT::ELF);
+    CHECK(candidates[0].offset() == elf_off);
+    CHECK(candidates[0].size() == elf.size());
+    CHECK(candidates[0].confidence() == carving::CONFIDENCE::HIGH);
+
+    CHECK(candidates[1].format() == carving::FORMAT::PE);
+    CHECK(candidates[1].offset() == pe_off);
+    CHECK(candidates[1].size() <= pe.size());
+
+    CHECK(candidates[2].format() == carving::FORMAT::MACHO);
+    CHECK(candidates[2].offset() == macho_off);
+    CHECK(candidates[2].size() == macho.size());
+
+    std::unique_ptr<Binary> bin = candidates[0].parse();
+    REQUIRE(bin != nullptr);
+    CHECK(bin->format() == Binary::FORMATS::ELF);
+
+    // Parallel parsing: the results follow the order of the candidates
+    for (uint32_t nb_threads : {1u, 2u, 0u}) {
+      std::vector<std::unique_ptr<Binary>> binaries = carving::parse(candidates, nb_threads);
+      REQUIRE(binaries.size() == candidates.size());
+      REQUIRE(binaries[0] != nullptr);
+      REQUIRE(binaries[1] != nullptr);
+      REQUIRE(binaries[2] != nullptr);
+      CHECK(binaries[0]->format() == Binary::FORMATS::ELF);
+      CHECK(binaries[1]->format() == Binary::FORMATS::PE);
+      CHECK(binaries[2]->format() == Binary::FORMATS::MACHO);
+      CHECK(binaries[0]->entrypoint() == bin->entrypoint());
+    }
+    CHECK(carving::parse({}).empty());
+  }
+
+  SECTION("Alignment") {
+    carving::config_t config;
+    config.alignment = 0x1000;
+    std::vector<carving::Candidate> candidates = carving::scan(blob, config);
+    REQUIRE(candidates.size() == 3);
+    CHECK(candidates[1].offset() == pe_off);
+  }
+
+  SECTION("Truncated") {
+    span<const uint8_t> truncated(blob.data(), elf_off + elf.size() / 2);
+    std::vector<carving::Candidate> candidates = carving::scan(truncated);
+    REQUIRE(candidates.size() == 1);
+    CHECK(candidates[0].confidence() == carving::CONFIDENCE::MEDIUM);
+    CHECK(candidates[0].size() == elf.size() / 2);
+
+    carving::config_t config;
+    config.min_confidence = carving::CONFIDENCE::HIGH;
+    CHECK(carving::scan(truncated, config).empty());
+  }
+}
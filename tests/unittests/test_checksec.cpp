@@ -0,0 +1,485 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <LIEF/checksec.hpp>
+#include <LIEF/ELF.hpp>
+#include <LIEF/PE.hpp>
+#include <LIEF/MachO.hpp>
+
+#include <fstream>
+#include <iterator>
+
+#include "utils.hpp"
+
+using namespace LIEF;
+using PROPERTY = checksec::PROPERTY;
+
+namespace {
+bool imports(const std::string& name, const std::vector<std::string>& names) {
+  return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+template<class T>
+void put(std::vector<uint8_t>& out, size_t offset, T value) {
+  if (out.size() < offset + sizeof(T)) {
+    out.resize(offset + sizeof(T));
+  }
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    out[offset + i] = uint8_t(uint64_t(value) >> (8 * i));
+  }
+}
+
+void put_be32(std::vector<uint8_t>& out, size_t offset, uint32_t value) {
+  put<uint32_t>(out, offset, (value >> 24) | ((value >> 8) & 0xff00) |
+                             ((value << 8) & 0xff0000) | (value << 24));
+}
+
+void put_str(std::vector<uint8_t>& out, size_t offset, const std::string& str) {
+  if (out.size() < offset + str.size() + 1) {
+    out.resize(offset + str.size() + 1);
+  }
+  std::copy(str.begin(), str.end(), out.begin() + offset);
+}
+
+struct elf_options_t {
+  uint16_t machine = 62; // EM_X86_64
+  bool relro = false;
+  bool bind_now = false;
+  uint32_t features = 0; // GNU_PROPERTY_{X86,AARCH64}_FEATURE_1_AND
+  bool imports = true;   // __stack_chk_fail and __printf_chk are undefined
+};
+
+//! Dynamically-linked ELF64 PIE whose dynamic symbols are only indexed
+//! by a DT_HASH table
+std::vector<uint8_t> make_elf(const elf_options_t& opt) {
+  std::vector<uint8_t> out;
+  uint16_t phnum = 0;
+  auto phdr = [&] (uint32_t type, uint32_t flags, uint64_t offset,
+                   uint64_t size, uint64_t align) {
+    const size_t entry = 0x40 + (phnum++) * 0x38;
+    put<uint32_t>(out, entry + 0x00, type);
+    put<uint32_t>(out, entry + 0x04, flags);
+    put<uint64_t>(out, entry + 0x08, offset);
+    put<uint64_t>(out, entry + 0x10, offset);
+    put<uint64_t>(out, entry + 0x18, offset);
+    put<uint64_t>(out, entry + 0x20, size);
+    put<uint64_t>(out, entry + 0x28, size);
+    put<uint64_t>(out, entry + 0x30, align);
+  };
+
+  put<uint32_t>(out, 0, 0x464c457f);
+  put<uint8_t>(out, 4, 2); // ELFCLASS64
+  put<uint8_t>(out, 5, 1); // ELFDATA2LSB
+  put<uint8_t>(out, 6, 1);
+  put<uint16_t>(out, 0x10, 3); // ET_DYN
+  put<uint16_t>(out, 0x12, opt.machine);
+  put<uint32_t>(out, 0x14, 1);
+  put<uint64_t>(out, 0x20, 0x40);
+  put<uint16_t>(out, 0x34, 0x40);
+  put<uint16_t>(out, 0x36, 0x38);
+
+  phdr(/* PT_LOAD */ 1, /* R */ 4, 0, 0x600, 0x1000);
+  phdr(/* PT_INTERP */ 3, 4, 0x200, 0x10, 1);
+  put_str(out, 0x200, "/lib/ld.so");
+  phdr(/* PT_DYNAMIC */ 2, 6, 0x300, 0x100, 8);
+  phdr(/* PT_GNU_STACK */ 0x6474e551, /* RW */ 6, 0, 0, 0x10);
+  if (opt.relro) {
+    phdr(/* PT_GNU_RELRO */ 0x6474e552, 4, 0x300, 0x100, 1);
+  }
+  if (opt.features != 0) {
+    // NT_GNU_PROPERTY_TYPE_0 with a single FEATURE_1_AND property
+    phdr(/* PT_GNU_PROPERTY */ 0x6474e553, 4, 0x220, 0x20, 8);
+    const uint32_t pr_type = opt.machine == 183 ? 0xc0000000 : 0xc0000002;
+    put<uint32_t>(out, 0x220, 4);
+    put<uint32_t>(out, 0x224, 0x10);
+    put<uint32_t>(out, 0x228, /* NT_GNU_PROPERTY_TYPE_0 */ 5);
+    put_str(out, 0x22c, "GNU");
+    put<uint32_t>(out, 0x230, pr_type);
+    put<uint32_t>(out, 0x234, 4);
+    put<uint32_t>(out, 0x238, opt.features);
+  }
+  put<uint16_t>(out, 0x38, phnum);
+
+  // .dynstr
+  put_str(out, 0x480, "");
+  put_str(out, 0x481, "__stack_chk_fail");
+  put_str(out, 0x492, "__printf_chk");
+  put_str(out, 0x49f, "libc.so.6");
+
+  // .dynsym: null, __stack_chk_fail, __printf_chk
+  for (uint32_t i = 1; i < 3; ++i) {
+    const size_t sym = 0x400 + i * 0x18;
+    put<uint32_t>(out, sym, i == 1 ? 0x1 : 0x12);
+    put<uint8_t>(out, sym + 4, /* STB_GLOBAL | STT_FUNC */ 0x12);
+    put<uint16_t>(out, sym + 6, opt.imports ? 0 : 1);
+  }
+
+  // DT_HASH: one bucket chaining __printf_chk -> __stack_chk_fail
+  put<uint32_t>(out, 0x500, 1); // nbucket
+  put<uint32_t>(out, 0x504, 3); // nchain
+  put<uint32_t>(out, 0x508, 2); // bucket[0]
+  put<uint32_t>(out, 0x50c, 0); // chain[0]
+  put<uint32_t>(out, 0x510, 0); // chain[1]
+  put<uint32_t>(out, 0x514, 1); // chain[2]
+  out.resize(0x600);
+
+  // .dynamic
+  size_t dyn = 0x300;
+  auto entry = [&] (uint64_t tag, uint64_t value) {
+    put<uint64_t>(out, dyn, tag);
+    put<uint64_t>(out, dyn + 8, value);
+    dyn += 0x10;
+  };
+  entry(/* DT_NEEDED */ 1, 0x1f);
+  entry(/* DT_HASH   */ 4, 0x500);
+  entry(/* DT_STRTAB */ 5, 0x480);
+  entry(/* DT_SYMTAB */ 6, 0x400);
+  entry(/* DT_STRSZ  */ 10, 0x29);
+  entry(/* DT_SYMENT */ 11, 0x18);
+  if (opt.bind_now) {
+    entry(/* DT_FLAGS */ 30, /* DF_BIND_NOW */ 0x8);
+  }
+  entry(/* DT_NULL */ 0, 0);
+  return out;
+}
+
+struct pe_options_t {
+  uint16_t dll_characteristics = 0;
+  uint32_t guard_flags = 0;
+  uint32_t nb_seh_handlers = 0;
+  bool cet_compat = false;
+};
+
+//! PE32 (x86) with a single section that holds the load configuration and
+//! the debug directory
+std::vector<uint8_t> make_pe32(const pe_options_t& opt) {
+  static constexpr size_t PE_HDR  = 0x40;
+  static constexpr size_t OPT_HDR = PE_HDR + 0x18;
+  static constexpr size_t DIRS    = OPT_HDR + 0x60;
+  static constexpr size_t SECTION = OPT_HDR + 0xe0;
+  static constexpr uint32_t RAW   = 0x200;
+  static constexpr uint32_t RVA   = 0x1000;
+
+  std::vector<uint8_t> out(0x400);
+  put_str(out, 0, "MZ");
+  put<uint32_t>(out, 0x3c, PE_HDR);
+
+  put_str(out, PE_HDR, "PE");
+  put<uint16_t>(out, PE_HDR + 0x04, 0x14c); // I386
+  put<uint16_t>(out, PE_HDR + 0x06, 1);
+  put<uint16_t>(out, PE_HDR + 0x14, 0xe0);
+  put<uint16_t>(out, PE_HDR + 0x16, 0x102);
+
+  put<uint16_t>(out, OPT_HDR + 0x00, 0x10b);
+  put<uint32_t>(out, OPT_HDR + 0x1c, 0x400000); // ImageBase
+  put<uint32_t>(out, OPT_HDR + 0x20, 0x1000);   // SectionAlignment
+  put<uint32_t>(out, OPT_HDR + 0x24, 0x200);    // FileAlignment
+  put<uint32_t>(out, OPT_HDR + 0x38, 0x2000);   // SizeOfImage
+  put<uint32_t>(out, OPT_HDR + 0x3c, 0x200);    // SizeOfHeaders
+  put<uint16_t>(out, OPT_HDR + 0x44, 3);        // CUI
+  put<uint16_t>(out, OPT_HDR + 0x46, opt.dll_characteristics);
+  put<uint32_t>(out, OPT_HDR + 0x5c, 16);
+
+  put<uint32_t>(out, DIRS + 6 * 8, RVA + 0x80);  // DEBUG_DIR
+  put<uint32_t>(out, DIRS + 6 * 8 + 4, 0x1c);
+  put<uint32_t>(out, DIRS + 10 * 8, RVA);        // LOAD_CONFIG_TABLE
+  put<uint32_t>(out, DIRS + 10 * 8 + 4, 0x40);
+
+  put_str(out, SECTION, ".rdata");
+  put<uint32_t>(out, SECTION + 0x08, 0x200);
+  put<uint32_t>(out, SECTION + 0x0c, RVA);
+  put<uint32_t>(out, SECTION + 0x10, 0x200);
+  put<uint32_t>(out, SECTION + 0x14, RAW);
+  put<uint32_t>(out, SECTION + 0x24, 0x40000040);
+
+  // IMAGE_LOAD_CONFIG_DIRECTORY32 (up to GuardFlags)
+  put<uint32_t>(out, RAW + 0x00, 0x5c);
+  put<uint32_t>(out, RAW + 0x3c, 0x401100); // SecurityCookie
+  if (opt.nb_seh_handlers > 0) {
+    put<uint32_t>(out, RAW + 0x40, 0x401120); // SEHandlerTable
+    put<uint32_t>(out, RAW + 0x44, opt.nb_seh_handlers);
+  }
+  put<uint32_t>(out, RAW + 0x58, opt.guard_flags);
+
+  // IMAGE_DEBUG_TYPE_EX_DLLCHARACTERISTICS
+  put<uint32_t>(out, RAW + 0x80 + 0x0c, 20);
+  put<uint32_t>(out, RAW + 0x80 + 0x10, 4);
+  put<uint32_t>(out, RAW + 0x80 + 0x14, RVA + 0xa0);
+  put<uint32_t>(out, RAW + 0x80 + 0x18, RAW + 0xa0);
+  put<uint32_t>(out, RAW + 0xa0, opt.cet_compat ? 1 : 0);
+  return out;
+}
+
+//! Thin 64-bit Mach-O executable with a ``__RESTRICT`` segment
+void put_macho_slice(std::vector<uint8_t>& out, size_t offset, uint32_t cputype,
+                     uint32_t flags)
+{
+  put<uint32_t>(out, offset + 0x00, 0xfeedfacf);
+  put<uint32_t>(out, offset + 0x04, cputype);
+  put<uint32_t>(out, offset + 0x0c, /* MH_EXECUTE */ 2);
+  put<uint32_t>(out, offset + 0x10, 1);
+  put<uint32_t>(out, offset + 0x14, 0x48);
+  put<uint32_t>(out, offset + 0x18, flags);
+  put<uint32_t>(out, offset + 0x20, /* LC_SEGMENT_64 */ 0x19);
+  put<uint32_t>(out, offset + 0x24, 0x48);
+  put_str(out, offset + 0x28, "__RESTRICT");
+  out.resize(std::max<size_t>(out.size(), offset + 0x100));
+}
+}
+
+TEST_CASE("lief.test.checksec.elf", "[lief][test][checksec]") {
+  for (const char* sample : {"ELF64_x86-64_binary_ls.bin", "ELF32_ARM_binary-pie_ls.bin"}) {
+    const std::string path = test::get_elf_sample(sample);
+    result<checksec::report_t> report = checksec::audit(path);
+    REQUIRE(report);
+    CHECK(report->format == checksec::FORMAT::ELF);
+
+    std::unique_ptr<ELF::Binary> elf = ELF::Parser::parse(path);
+    REQUIRE(elf != nullptr);
+    CHECK(report->has(PROPERTY::PIE) == elf->is_pie());
+    CHECK(report->has(PROPERTY::NX) == elf->has_nx());
+    CHECK(report->has(PROPERTY::RELRO) == elf->has(ELF::Segment::TYPE::GNU_RELRO));
+    CHECK(report->has(PROPERTY::RUNPATH) == elf->has(ELF::DynamicEntry::TAG::RUNPATH));
+
+    std::vector<std::string> names;
+    for (const ELF::Symbol& sym : elf->dynamic_symbols()) {
+      if (sym.shndx() == 0) {
+        names.push_back(sym.name());
+      }
+    }
+    REQUIRE(report->is_checked(PROPERTY::CANARY));
+    CHECK(report->has(PROPERTY::CANARY) == imports("__stack_chk_fail", names));
+  }
+
+  // Statically-linked: the stack canary can't be checked from the imports
+  {
+    result<checksec::report_t> report = checksec::audit(test::get_elf_sample("elf64_static_pie.bin"));
+    REQUIRE(report);
+    CHECK(report->has(PROPERTY::PIE));
+    CHECK(!report->is_checked(PROPERTY::CANARY));
+  }
+}
+
+TEST_CASE("lief.test.checksec.pe", "[lief][test][checksec]") {
+  using DLL_CHARACTERISTICS = PE::OptionalHeader::DLL_CHARACTERISTICS;
+  for (const char* sample : {"PE32_x86_binary_cmd.exe", "PE64_x86-64_binary_WinApp.exe"}) {
+    const std::string path = test::get_pe_sample(sample);
+    result<checksec::report_t> report = checksec::audit(path);
+    REQUIRE(report);
+    CHECK(report->format == checksec::FORMAT::PE);
+
+    std::unique_ptr<PE::Binary> pe = PE::Parser::parse(path);
+    REQUIRE(pe != nullptr);
+    const PE::OptionalHeader& opt_hdr = pe->optional_header();
+    CHECK(report->has(PROPERTY::PIE) == opt_hdr.has(DLL_CHARACTERISTICS::DYNAMIC_BASE));
+    CHECK(report->has(PROPERTY::NX) == opt_hdr.has(DLL_CHARACTERISTICS::NX_COMPAT));
+    CHECK(report->has(PROPERTY::SIGNED) == pe->has_signatures());
+
+    const PE::LoadConfiguration* config = pe->load_configuration();
+    CHECK(report->has(PROPERTY::CANARY) == (config != nullptr && config->security_cookie() != 0));
+  }
+}
+
+TEST_CASE("lief.test.checksec.macho", "[lief][test][checksec]") {
+  const std::string path = test::get_macho_sample("MachO64_x86-64_binary_nm.bin");
+  result<checksec::report_t> report = checksec::audit(path);
+  REQUIRE(report);
+  CHECK(report->format == checksec::FORMAT::MACHO);
+  CHECK(report->nb_slices == 1);
+
+  std::unique_ptr<MachO::FatBinary> fat = MachO::Parser::parse(path);
+  REQUIRE(fat != nullptr);
+  const MachO::Binary& bin = *fat->at(0);
+  CHECK(report->has(PROPERTY::PIE) == bin.header().has(MachO::Header::FLAGS::PIE));
+  CHECK(report->has(PROPERTY::SIGNED) == bin.has_code_signature());
+
+  std::vector<std::string> names;
+  for (const MachO::Symbol& sym : bin.imported_symbols()) {
+    names.push_back(sym.name());
+  }
+  REQUIRE(report->is_checked(PROPERTY::CANARY));
+  CHECK(report->has(PROPERTY::CANARY) == imports("___stack_chk_fail", names));
+}
+
+TEST_CASE("lief.test.checksec.errors", "[lief][test][checksec]") {
+  const std::vector<uint8_t> garbage(0x100, 0x41);
+  CHECK(!checksec::audit(garbage));
+  CHECK(!checksec::audit(span<const uint8_t>()));
+  CHECK(!checksec::audit(std::string("/this/file/does/not/exist")));
+
+  // Truncated ELF header
+  std::ifstream ifs(test::get_elf_sample("ELF64_x86-64_binary_ls.bin"), std::ios::binary);
+  std::vector<uint8_t> elf{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+  elf.resize(0x20);
+  CHECK(!checksec::audit(elf));
+}
+
+TEST_CASE("lief.test.checksec.elf_synthetic", "[lief][test][checksec]") {
+  SECTION("Full RELRO and CET") {
+    elf_options_t opt;
+    opt.relro = true;
+    opt.bind_now = true;
+    opt.features = /* IBT | SHSTK */ 0x3;
+    result<checksec::report_t> report = checksec::audit(make_elf(opt));
+    REQUIRE(report);
+    CHECK(report->has(PROPERTY::PIE | PROPERTY::NX | PROPERTY::RELRO | PROPERTY::BIND_NOW));
+    CHECK(report->full_relro());
+    CHECK(report->has(PROPERTY::IBT | PROPERTY::SHSTK));
+    CHECK(!report->is_checked(PROPERTY::PAC));
+    CHECK(!report->has(PROPERTY::RPATH));
+    CHECK(report->is_checked(PROPERTY::RUNPATH));
+  }
+
+  SECTION("Partial RELRO") {
+    elf_options_t opt;
+    opt.relro = true;
+    result<checksec::report_t> report = checksec::audit(make_elf(opt));
+    REQUIRE(report);
+    CHECK(report->has(PROPERTY::RELRO));
+    CHECK(report->is_checked(PROPERTY::BIND_NOW));
+    CHECK(!report->has(PROPERTY::BIND_NOW));
+    CHECK(!report->full_relro());
+    CHECK(report->is_checked(PROPERTY::IBT | PROPERTY::SHSTK));
+    CHECK(!report->has(PROPERTY::IBT));
+    CHECK(!report->has(PROPERTY::SHSTK));
+  }
+
+  SECTION("AArch64 BTI and PAC") {
+    elf_options_t opt;
+    opt.machine = 183; // EM_AARCH64
+    opt.features = /* BTI | PAC */ 0x3;
+    result<checksec::report_t> report = checksec::audit(make_elf(opt));
+    REQUIRE(report);
+    CHECK(report->has(PROPERTY::IBT | PROPERTY::PAC));
+    CHECK(!report->is_checked(PROPERTY::SHSTK));
+    CHECK(!report->has(PROPERTY::RELRO));
+  }
+
+  SECTION("DT_HASH imports") {
+    result<checksec::report_t> report = checksec::audit(make_elf({}));
+    REQUIRE(report);
+    REQUIRE(report->is_checked(PROPERTY::CANARY | PROPERTY::FORTIFY));
+    CHECK(report->has(PROPERTY::CANARY | PROPERTY::FORTIFY));
+
+    // Same symbols but defined: they are not imports
+    elf_options_t opt;
+    opt.imports = false;
+    report = checksec::audit(make_elf(opt));
+    REQUIRE(report);
+    REQUIRE(report->is_checked(PROPERTY::CANARY | PROPERTY::FORTIFY));
+    CHECK(!report->has(PROPERTY::CANARY));
+    CHECK(!report->has(PROPERTY::FORTIFY));
+  }
+}
+
+TEST_CASE("lief.test.checksec.pe_synthetic", "[lief][test][checksec]") {
+  SECTION("SafeSEH, CFG, XFG and CET") {
+    pe_options_t opt;
+    opt.dll_characteristics = /* DYNAMIC_BASE | NX_COMPAT | GUARD_CF */ 0x4140;
+    opt.guard_flags = /* CF_INSTRUMENTED | XFG_ENABLED */ 0x00800100;
+    opt.nb_seh_handlers = 2;
+    opt.cet_compat = true;
+    result<checksec::report_t> report = checksec::audit(make_pe32(opt));
+    REQUIRE(report);
+    CHECK(report->format == checksec::FORMAT::PE);
+    CHECK(report->has(PROPERTY::PIE | PROPERTY::NX | PROPERTY::CANARY));
+    CHECK(report->has(PROPERTY::SAFESEH | PROPERTY::CFG | PROPERTY::XFG | PROPERTY::SHSTK));
+    CHECK(!report->is_checked(PROPERTY::HIGH_ENTROPY_VA));
+    CHECK(!report->has(PROPERTY::SIGNED));
+
+    std::unique_ptr<PE::Binary> pe = PE::Parser::parse(make_pe32(opt));
+    REQUIRE(pe != nullptr);
+    const auto* config = PE::LoadConfiguration::cast<PE::LoadConfigurationV1>(pe->load_configuration());
+    REQUIRE(config != nullptr);
+    CHECK(static_cast<uint32_t>(config->guard_flags()) == opt.guard_flags);
+    CHECK(config->se_handler_count() == opt.nb_seh_handlers);
+  }
+
+  SECTION("No SafeSEH, CFG without GUARD_CF") {
+    pe_options_t opt;
+    opt.dll_characteristics = /* DYNAMIC_BASE | NX_COMPAT */ 0x0140;
+    opt.guard_flags = /* CF_INSTRUMENTED | SECURITY_COOKIE_UNUSED */ 0x00000900;
+    result<checksec::report_t> report = checksec::audit(make_pe32(opt));
+    REQUIRE(report);
+    REQUIRE(report->is_checked(PROPERTY::SAFESEH | PROPERTY::CFG | PROPERTY::XFG |
+                               PROPERTY::CANARY | PROPERTY::SHSTK));
+    CHECK(!report->has(PROPERTY::SAFESEH));
+    CHECK(!report->has(PROPERTY::CFG));
+    CHECK(!report->has(PROPERTY::XFG));
+    CHECK(!report->has(PROPERTY::CANARY));
+    CHECK(!report->has(PROPERTY::SHSTK));
+  }
+}
+
+TEST_CASE("lief.test.checksec.fat", "[lief][test][checksec]") {
+  static constexpr uint32_t MH_PIE               = 0x00200000;
+  static constexpr uint32_t MH_NO_HEAP_EXECUTION = 0x01000000;
+
+  std::vector<uint8_t> fat;
+  put_be32(fat, 0x00, 0xcafebabe);
+  put_be32(fat, 0x04, 2);
+  for (uint32_t i = 0; i < 2; ++i) {
+    const size_t arch = 0x08 + i * 0x14;
+    put_be32(fat, arch + 0x00, i == 0 ? 0x01000007 : 0x0100000c); // x86-64, arm64
+    put_be32(fat, arch + 0x08, 0x1000 * (i + 1));
+    put_be32(fat, arch + 0x0c, 0x100);
+    put_be32(fat, arch + 0x10, 12);
+  }
+  put_macho_slice(fat, 0x1000, 0x01000007, MH_PIE | MH_NO_HEAP_EXECUTION);
+  put_macho_slice(fat, 0x2000, 0x0100000c, MH_PIE);
+
+  result<checksec::report_t> report = checksec::audit(fat);
+  REQUIRE(report);
+  CHECK(report->format == checksec::FORMAT::MACHO);
+  CHECK(report->nb_slices == 2);
+  CHECK(report->has(PROPERTY::PIE | PROPERTY::NX | PROPERTY::RESTRICT));
+
+  // Only enabled in the first slice
+  CHECK(report->is_checked(PROPERTY::NX_HEAP));
+  CHECK(!report->has(PROPERTY::NX_HEAP));
+
+  result<checksec::report_t> first = checksec::audit(span<const uint8_t>(fat).subspan(0x1000));
+  REQUIRE(first);
+  CHECK(first->nb_slices == 1);
+  CHECK(first->has(PROPERTY::NX_HEAP));
+}
+
+TEST_CASE("lief.test.checksec.parallel", "[lief][test][checksec]") {
+  const std::vector<std::string> paths = {
+    test::get_elf_sample("ELF64_x86-64_binary_ls.bin"),
+    test::get_pe_sample("PE32_x86_binary_cmd.exe"),
+    "/this/file/does/not/exist",
+    test::get_macho_sample("MachO64_x86-64_binary_nm.bin"),
+    test::get_elf_sample("ELF32_ARM_binary-pie_ls.bin"),
+  };
+
+  for (uint32_t nb_threads : {1, 4}) {
+    std::vector<result<checksec::report_t>> reports = checksec::audit(paths, nb_threads);
+    REQUIRE(reports.size() == paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+      result<checksec::report_t> expected = checksec::audit(paths[i]);
+      REQUIRE(bool(reports[i]) == bool(expected));
+      if (!expected) {
+        continue;
+      }
+      CHECK(reports[i]->format == expected->format);
+      CHECK(reports[i]->properties == expected->properties);
+      CHECK(reports[i]->checked == expected->checked);
+    }
+    CHECK(!reports[2]);
+  }
+}
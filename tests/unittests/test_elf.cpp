@@ -17,7 +17,17 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
 #include "LIEF/ELF/Binary.hpp"
+#include "LIEF/ELF/CoreUnwinder.hpp"
+#include "LIEF/ELF/DynamicPatcher.hpp"
+#include "LIEF/ELF/DynamicSharedObject.hpp"
+#include "LIEF/ELF/Parser.hpp"
+#include "LIEF/ELF/Section.hpp"
+#include "LIEF/ELF/Symbol.hpp"
 #include "LIEF/Abstract/Parser.hpp"
 
 #include "utils.hpp"
@@ -25,6 +35,213 @@
 using namespace LIEF;
 using namespace std::string_literals;
 
+namespace {
+template<class T>
+void put(std::vector<uint8_t>& out, size_t offset, T value) {
+  if (out.size() < offset + sizeof(T)) {
+    out.resize(offset + sizeof(T));
+  }
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    out[offset + i] = uint8_t(uint64_t(value) >> (8 * i));
+  }
+}
+
+void put_bytes(std::vector<uint8_t>& out, size_t offset, const std::vector<uint8_t>& bytes) {
+  if (out.size() < offset + bytes.size()) {
+    out.resize(offset + bytes.size());
+  }
+  std::copy(bytes.begin(), bytes.end(), out.begin() + offset);
+}
+
+void put_ehdr(std::vector<uint8_t>& out, uint16_t type, uint16_t phnum,
+              uint64_t shoff = 0, uint16_t shnum = 0, uint16_t shstrndx = 0)
+{
+  put_bytes(out, 0, {0x7f, 'E', 'L', 'F', 2, 1, 1});
+  put<uint16_t>(out, 0x10, type);
+  put<uint16_t>(out, 0x12, 62); // EM_X86_64
+  put<uint32_t>(out, 0x14, 1);
+  put<uint64_t>(out, 0x20, 0x40);
+  put<uint64_t>(out, 0x28, shoff);
+  put<uint16_t>(out, 0x34, 0x40);
+  put<uint16_t>(out, 0x36, 0x38);
+  put<uint16_t>(out, 0x38, phnum);
+  put<uint16_t>(out, 0x3a, 0x40);
+  put<uint16_t>(out, 0x3c, shnum);
+  put<uint16_t>(out, 0x3e, shstrndx);
+}
+
+void put_phdr(std::vector<uint8_t>& out, size_t idx, uint32_t type, uint64_t offset,
+              uint64_t vaddr, uint64_t size)
+{
+  const size_t phdr = 0x40 + idx * 0x38;
+  put<uint32_t>(out, phdr + 0x00, type);
+  put<uint32_t>(out, phdr + 0x04, 5); // PF_R | PF_X
+  put<uint64_t>(out, phdr + 0x08, offset);
+  put<uint64_t>(out, phdr + 0x10, vaddr);
+  put<uint64_t>(out, phdr + 0x18, vaddr);
+  put<uint64_t>(out, phdr + 0x20, size);
+  put<uint64_t>(out, phdr + 0x28, size);
+  put<uint64_t>(out, phdr + 0x30, type == 1 ? 0x1000 : 4);
+}
+
+size_t put_note(std::vector<uint8_t>& out, size_t offset, const std::string& name,
+                uint32_t type, const std::vector<uint8_t>& desc)
+{
+  const size_t namesz = name.size() + 1;
+  put<uint32_t>(out, offset + 0, namesz);
+  put<uint32_t>(out, offset + 4, desc.size());
+  put<uint32_t>(out, offset + 8, type);
+  put_bytes(out, offset + 12, {name.begin(), name.end()});
+  const size_t desc_offset = offset + 12 + ((namesz + 3) & ~3);
+  put_bytes(out, desc_offset, desc);
+  const size_t end = desc_offset + ((desc.size() + 3) & ~3);
+  out.resize(std::max(out.size(), end));
+  return end;
+}
+
+// x86-64 shared library with a build-id and an .eh_frame that describes the
+// function at [0x200, 0x300):
+//   0x200: push %rbp  (CFA = rsp + 16 from 0x201, rbp saved at CFA - 16)
+std::vector<uint8_t> unwinder_module(uint8_t build_id) {
+  std::vector<uint8_t> out;
+  put_ehdr(out, /* ET_DYN */ 3, 2, /* shoff */ 0x300, 3, 2);
+  put_phdr(out, 0, /* PT_LOAD */ 1, 0, 0, 0x3c0);
+  put_phdr(out, 1, /* PT_NOTE */ 4, 0xc0, 0xc0, 0x18);
+  put_note(out, 0xc0, "GNU", /* NT_GNU_BUILD_ID */ 3,
+           {build_id, 1, 2, 3, 4, 5, 6, 7});
+
+  // CIE: "zR", code align 1, data align -8, RA: r16, FDE encoding pcrel|sdata4
+  //      DW_CFA_def_cfa: rsp + 8, DW_CFA_offset: r16 at CFA - 8
+  put_bytes(out, 0x100, {
+    20, 0, 0, 0,  0, 0, 0, 0,  1, 'z', 'R', 0, 1, 0x78, 16, 1, 0x1b,
+    0x0c, 0x07, 0x08, 0x90, 0x01, 0, 0,
+  });
+  // FDE: [0x200, 0x300)
+  //      DW_CFA_advance_loc: 1, DW_CFA_def_cfa_offset: 16, DW_CFA_offset: rbp at CFA - 16
+  put_bytes(out, 0x118, {
+    20, 0, 0, 0,  0x1c, 0, 0, 0,  0xe0, 0, 0, 0,  0, 1, 0, 0,  0,
+    0x41, 0x0e, 0x10, 0x86, 0x02, 0, 0,
+    0, 0, 0, 0,
+  });
+  put<uint8_t>(out, 0x200, 0x55); // push %rbp
+
+  const std::string shstrtab("\0.eh_frame\0.shstrtab\0", 21);
+  put_bytes(out, 0x2c0, {shstrtab.begin(), shstrtab.end()});
+  auto put_shdr = [&] (size_t idx, uint32_t name, uint32_t type, uint64_t addr,
+                       uint64_t offset, uint64_t size) {
+    const size_t shdr = 0x300 + idx * 0x40;
+    put<uint32_t>(out, shdr + 0x00, name);
+    put<uint32_t>(out, shdr + 0x04, type);
+    put<uint64_t>(out, shdr + 0x08, type == 1 ? 2 : 0); // SHF_ALLOC
+    put<uint64_t>(out, shdr + 0x10, addr);
+    put<uint64_t>(out, shdr + 0x18, offset);
+    put<uint64_t>(out, shdr + 0x20, size);
+    put<uint64_t>(out, shdr + 0x30, 1);
+  };
+  put_shdr(0, 0, 0, 0, 0, 0);
+  put_shdr(1, 1, /* SHT_PROGBITS */ 1, 0x100, 0x100, 0x34);
+  put_shdr(2, 11, /* SHT_STRTAB */ 3, 0, 0x2c0, shstrtab.size());
+  out.resize(0x3c0);
+  return out;
+}
+
+// Core of a process with two threads stopped in the function of the
+// module (after the push %rbp) which is mapped at 0x7f0000000000
+std::vector<uint8_t> unwinder_core(const std::vector<uint8_t>& module,
+                                   uint64_t stack, uint64_t return_address)
+{
+  static constexpr uint64_t BASE = 0x7f0000000000;
+  std::vector<uint8_t> out;
+  put_ehdr(out, /* ET_CORE */ 4, 3);
+
+  size_t end = 0x100;
+  for (int32_t tid : {100, 101}) {
+    // elf_prstatus: pr_pid at 0x20, pr_reg at 0x70
+    std::vector<uint8_t> prstatus(336);
+    put<int32_t>(prstatus, 0x20, tid);
+    put<uint64_t>(prstatus, 0x70 + 4 * 8, 0);                 // rbp
+    put<uint64_t>(prstatus, 0x70 + 16 * 8, BASE + 0x250);     // rip
+    put<uint64_t>(prstatus, 0x70 + 19 * 8, stack);            // rsp
+    end = put_note(out, end, "CORE", /* NT_PRSTATUS */ 1, prstatus);
+  }
+
+  std::vector<uint8_t> file;
+  put<uint64_t>(file, 0x00, 1);          // count
+  put<uint64_t>(file, 0x08, 0x1000);     // page size
+  put<uint64_t>(file, 0x10, BASE);
+  put<uint64_t>(file, 0x18, BASE + 0x1000);
+  put<uint64_t>(file, 0x20, 0);
+  const std::string path = "/lib/libmod.so";
+  put_bytes(file, 0x28, {path.begin(), path.end()});
+  file.push_back(0);
+  end = put_note(out, end, "CORE", /* NT_FILE */ 0x46494c45, file);
+  put_phdr(out, 0, /* PT_NOTE */ 4, 0x100, 0, end - 0x100);
+
+  // First page of the module and the stack
+  put_bytes(out, 0x1000, module);
+  put_phdr(out, 1, /* PT_LOAD */ 1, 0x1000, BASE, 0x1000);
+  put<uint64_t>(out, 0x2000, 0);                // saved rbp
+  put<uint64_t>(out, 0x2008, return_address);   // return address
+  put<uint64_t>(out, 0x2ff8, 0);
+  put_phdr(out, 2, /* PT_LOAD */ 1, 0x2000, stack, 0x1000);
+  return out;
+}
+
+// AArch64 relocatable object whose .data holds:
+//   .word far; .word far - .; .word near; .word near - .
+// where far and near are undefined symbols
+std::vector<uint8_t> aarch64_data_object() {
+  std::vector<uint8_t> out;
+  put_ehdr(out, /* ET_REL */ 1, 0, /* shoff */ 0x140, 6, 5);
+  put<uint16_t>(out, 0x12, 183); // EM_AARCH64
+
+  // .rela.data (the addends are null)
+  size_t rela = 0x50;
+  for (uint64_t sym : {/* far */ 2, /* near */ 3}) {
+    for (uint64_t type : {/* R_AARCH64_ABS32 */ 258, /* R_AARCH64_PREL32 */ 261}) {
+      put<uint64_t>(out, rela + 0x00, (rela - 0x50) / 0x18 * 4);
+      put<uint64_t>(out, rela + 0x08, (sym << 32) | type);
+      rela += 0x18;
+    }
+  }
+
+  // .symtab: null, .data (section), far, near
+  put<uint8_t>(out,  0xc8 + 0x04, /* STB_LOCAL | STT_SECTION */ 3);
+  put<uint16_t>(out, 0xc8 + 0x06, 1);
+  put<uint32_t>(out, 0xe0 + 0x00, 1);
+  put<uint8_t>(out,  0xe0 + 0x04, /* STB_GLOBAL | STT_NOTYPE */ 0x10);
+  put<uint32_t>(out, 0xf8 + 0x00, 5);
+  put<uint8_t>(out,  0xf8 + 0x04, /* STB_GLOBAL | STT_NOTYPE */ 0x10);
+
+  const std::string strtab("\0far\0near\0", 10);
+  put_bytes(out, 0x110, {strtab.begin(), strtab.end()});
+  const std::string shstrtab("\0.rela.data\0.symtab\0.strtab\0.shstrtab\0", 38);
+  put_bytes(out, 0x11a, {shstrtab.begin(), shstrtab.end()});
+
+  auto put_shdr = [&] (size_t idx, uint32_t name, uint32_t type, uint64_t flags,
+                       uint64_t offset, uint64_t size, uint32_t link, uint32_t info,
+                       uint64_t entsize) {
+    const size_t shdr = 0x140 + idx * 0x40;
+    put<uint32_t>(out, shdr + 0x00, name);
+    put<uint32_t>(out, shdr + 0x04, type);
+    put<uint64_t>(out, shdr + 0x08, flags);
+    put<uint64_t>(out, shdr + 0x18, offset);
+    put<uint64_t>(out, shdr + 0x20, size);
+    put<uint32_t>(out, shdr + 0x28, link);
+    put<uint32_t>(out, shdr + 0x2c, info);
+    put<uint64_t>(out, shdr + 0x30, 8);
+    put<uint64_t>(out, shdr + 0x38, entsize);
+  };
+  put_shdr(0, 0, 0, 0, 0, 0, 0, 0, 0);
+  put_shdr(1, 6, /* SHT_PROGBITS */ 1, /* SHF_WRITE | SHF_ALLOC */ 3, 0x40, 0x10, 0, 0, 0);
+  put_shdr(2, 1, /* SHT_RELA */ 4, /* SHF_INFO_LINK */ 0x40, 0x50, 0x60, 3, 1, 0x18);
+  put_shdr(3, 12, /* SHT_SYMTAB */ 2, 0, 0xb0, 0x60, 4, 2, 0x18);
+  put_shdr(4, 20, /* SHT_STRTAB */ 3, 0, 0x110, strtab.size(), 0, 0, 0);
+  put_shdr(5, 28, /* SHT_STRTAB */ 3, 0, 0x11a, shstrtab.size(), 0, 0, 0);
+  return out;
+}
+}
+
 TEST_CASE("lief.test.elf", "[lief][test][elf]") {
   SECTION("classof") {
     {
@@ -46,4 +263,146 @@ TEST_CASE("lief.test.elf", "[lief][test][elf]") {
   }
 }
 
+TEST_CASE("lief.test.elf.dynamic_patcher", "[lief][test][elf]") {
+  // Its .dynstr is empty and followed by 7 bytes of zero-padding
+  std::ifstream ifs(test::get_elf_sample("elf64_static_pie.bin"), std::ios::binary);
+  std::vector<uint8_t> raw{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+
+  auto patcher = ELF::DynamicPatcher::from_buffer(raw);
+  REQUIRE(patcher);
+  REQUIRE(patcher->dynstr_slack() == 7);
+
+  // Tail-merged strings: DT_SONAME reuses the suffix of the DT_NEEDED string
+  REQUIRE(patcher->add_needed("x.so"));
+  REQUIRE(patcher->soname(".so"));
+  CHECK(patcher->dynstr_slack() == 2);
+
+  // "a" fits in ".so" but overwriting it would also change "x.so": it must
+  // be appended instead
+  REQUIRE(patcher->soname("a"));
+  CHECK(patcher->dynstr_slack() == 0);
+  CHECK(patcher->needed() == std::vector<std::string>{"x.so"});
+
+  std::unique_ptr<ELF::Binary> elf = ELF::Parser::parse(raw);
+  REQUIRE(elf != nullptr);
+  CHECK(elf->imported_libraries() == std::vector<std::string>{"x.so"});
+  const ELF::DynamicEntry* soname = elf->get(ELF::DynamicEntry::TAG::SONAME);
+  REQUIRE(soname != nullptr);
+  CHECK(static_cast<const ELF::DynamicSharedObject*>(soname)->name() == "a");
+}
+
+TEST_CASE("lief.test.elf.core_unwinder", "[lief][test][elf]") {
+  using ELF::CoreUnwinder;
+  static constexpr uint64_t STACK = 0x7ffe00000000;
+  static constexpr uint64_t RETURN_ADDRESS = 0x401234;
+
+  const std::vector<uint8_t> module = unwinder_module(0xaa);
+  std::unique_ptr<ELF::Binary> core =
+    ELF::Parser::parse(unwinder_core(module, STACK, RETURN_ADDRESS));
+  REQUIRE(core != nullptr);
+
+  SECTION("CFI") {
+    CoreUnwinder unwinder;
+    unwinder.add_module("/lib/libmod.so", ELF::Parser::parse(module));
+
+    auto threads = unwinder.unwind(*core, /* nb_threads */ 2);
+    REQUIRE(threads);
+    REQUIRE(threads->size() == 2);
+    for (const CoreUnwinder::thread_t& thread : *threads) {
+      REQUIRE(thread.frames.size() == 2);
+      const CoreUnwinder::frame_t& callee = thread.frames[0];
+      CHECK(callee.method == CoreUnwinder::METHOD::CONTEXT);
+      CHECK(callee.module == "/lib/libmod.so");
+      CHECK(callee.offset == 0x250);
+      CHECK(callee.sp == STACK);
+
+      const CoreUnwinder::frame_t& caller = thread.frames[1];
+      CHECK(caller.method == CoreUnwinder::METHOD::CFI);
+      CHECK(caller.pc == RETURN_ADDRESS);
+      CHECK(caller.sp == STACK + 16);
+      CHECK(caller.module.empty());
+    }
+    CHECK((*threads)[0].tid == 100);
+    CHECK((*threads)[1].tid == 101);
+  }
+
+  SECTION("Build-id") {
+    // Another build of the module: its CFI must not be used
+    CoreUnwinder unwinder;
+    unwinder.add_module("/lib/libmod.so", ELF::Parser::parse(unwinder_module(0xbb)));
+    unwinder.sysroot("/nonexistent");
+
+    auto threads = unwinder.unwind(*core);
+    REQUIRE(threads);
+    REQUIRE(threads->size() == 2);
+    for (const CoreUnwinder::thread_t& thread : *threads) {
+      REQUIRE(!thread.frames.empty());
+      CHECK(thread.frames[0].offset == 0);
+      for (const CoreUnwinder::frame_t& frame : thread.frames) {
+        CHECK(frame.method != CoreUnwinder::METHOD::CFI);
+      }
+    }
+    // The mismatching build and the negative entry for the core's build
+    CHECK(unwinder.nb_modules() == 2);
+
+    unwinder.add_module("/lib/libmod.so", ELF::Parser::parse(module));
+    CHECK(unwinder.nb_modules() == 2);
+    threads = unwinder.unwind(*core);
+    REQUIRE(threads);
+    CHECK((*threads)[0].frames.size() == 2);
+    CHECK((*threads)[0].frames[1].method == CoreUnwinder::METHOD::CFI);
+  }
+}
+
+TEST_CASE("lief.test.elf.relocate", "[lief][test][elf]") {
+  static constexpr uint64_t DATA = 0x1000;
+  static constexpr uint64_t NEAR = 0x2000;
+
+  // Apply the relocations of aarch64_data_object() with .data at DATA
+  // and return the number of relocations applied and the content of .data
+  auto relocate = [] (uint64_t far) {
+    std::unique_ptr<ELF::Binary> elf = ELF::Parser::parse(aarch64_data_object());
+    REQUIRE(elf != nullptr);
+    REQUIRE(elf->header().machine_type() == ELF::ARCH::AARCH64);
+    const ELF::Section* data = elf->get_section(".data");
+    REQUIRE(data != nullptr);
+
+    auto nb_applied = elf->relocate({{data, DATA}},
+      [far] (const ELF::Symbol& sym) -> result<uint64_t> {
+        return sym.name() == "far" ? far : NEAR;
+      });
+    REQUIRE(nb_applied);
 
+    std::vector<uint32_t> words(4);
+    span<const uint8_t> content = data->content();
+    REQUIRE(content.size() == 16);
+    std::memcpy(words.data(), content.data(), content.size());
+    return std::make_pair(*nb_applied, words);
+  };
+
+  {
+    // Both values fit in 32 bits (unsigned)
+    auto [nb_applied, words] = relocate(0xffffffff);
+    CHECK(nb_applied == 4);
+    CHECK(words == std::vector<uint32_t>{
+      0xffffffff, uint32_t(0xffffffff - DATA - 4), NEAR, uint32_t(NEAR - DATA - 12)
+    });
+  }
+
+  {
+    // S + A fits in 32 bits (signed) but S + A - P doesn't
+    auto [nb_applied, words] = relocate(-uint64_t(0x80000000));
+    CHECK(nb_applied == 3);
+    CHECK(words == std::vector<uint32_t>{
+      0x80000000, 0, NEAR, uint32_t(NEAR - DATA - 12)
+    });
+  }
+
+  {
+    // far is out of the range of the 32-bit relocations: the fields are
+    // left untouched
+    auto [nb_applied, words] = relocate(0x200000000);
+    CHECK(nb_applied == 2);
+    CHECK(words == std::vector<uint32_t>{0, 0, NEAR, uint32_t(NEAR - DATA - 12)});
+  }
+}
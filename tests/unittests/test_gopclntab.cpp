@@ -0,0 +1,391 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <LIEF/Abstract/GoPclntab.hpp>
+#include <LIEF/Abstract/Function.hpp>
+#include <LIEF/Abstract/Symbolizer.hpp>
+#include <LIEF/PE.hpp>
+#include <LIEF/MachO.hpp>
+
+using namespace LIEF;
+using VERSION = GoPclntab::VERSION;
+
+namespace {
+struct go_func_t {
+  std::string name;
+  uint64_t entry = 0;
+  int32_t line = 0;
+};
+
+class writer_t {
+  public:
+  writer_t(bool big_endian) :
+    big_endian_(big_endian)
+  {}
+
+  void put(size_t offset, uint64_t value, size_t size) {
+    if (raw.size() < offset + size) {
+      raw.resize(offset + size);
+    }
+    for (size_t i = 0; i < size; ++i) {
+      const size_t pos = big_endian_ ? size - 1 - i : i;
+      raw[offset + pos] = uint8_t(value >> (8 * i));
+    }
+  }
+
+  size_t append(uint64_t value, size_t size) {
+    const size_t offset = raw.size();
+    put(offset, value, size);
+    return offset;
+  }
+
+  size_t append(const std::string& str) {
+    const size_t offset = raw.size();
+    raw.insert(raw.end(), str.begin(), str.end());
+    raw.push_back(0);
+    return offset;
+  }
+
+  //! pcvalue program which maps [0, size) to the given value
+  size_t append_pcvalue(int32_t value, uint32_t size) {
+    const size_t offset = raw.size();
+    raw.push_back(uint8_t((value + 1) << 1)); // zig-zag delta from -1
+    raw.push_back(uint8_t(size));
+    raw.push_back(0);
+    return offset;
+  }
+
+  void align(size_t alignment) {
+    raw.resize((raw.size() + alignment - 1) / alignment * alignment);
+  }
+
+  std::vector<uint8_t> raw;
+
+  private:
+  bool big_endian_ = false;
+};
+
+static constexpr uint32_t FUNC_SIZE = 0x40;
+
+//! Go 1.2 or Go 1.16 table. Every function is FUNC_SIZE bytes long and all
+//! of them are defined in main.go.
+std::vector<uint8_t> make_pclntab(VERSION version, uint8_t psize, bool big_endian,
+                                  const std::vector<go_func_t>& funcs)
+{
+  const size_t nb = funcs.size();
+  const uint64_t end = funcs.back().entry + FUNC_SIZE;
+  writer_t w(big_endian);
+  w.append(version == VERSION::GO_1_2 ? 0xfffffffb : 0xfffffffa, 4);
+  w.append(0, 2);
+  w.append(/* quantum */ 1, 1);
+  w.append(psize, 1);
+
+  if (version == VERSION::GO_1_2) {
+    // nfunc, functab, end pc, filetab offset, _func[], names, pc data, filetab
+    w.append(nb, psize);
+    const size_t functab = w.raw.size();
+    w.raw.resize(functab + (2 * nb + 1) * psize + 4);
+    w.align(8);
+
+    std::vector<size_t> func_offsets;
+    for (size_t i = 0; i < nb; ++i) {
+      func_offsets.push_back(w.raw.size());
+      w.raw.resize(w.raw.size() + psize + 8 * 4);
+    }
+
+    for (size_t i = 0; i < nb; ++i) {
+      const size_t func = func_offsets[i];
+      w.put(functab + 2 * i * psize, funcs[i].entry, psize);
+      w.put(functab + (2 * i + 1) * psize, func, psize);
+      w.put(func, funcs[i].entry, psize);
+      w.put(func + psize, w.append(funcs[i].name), 4);                        // nameoff
+      w.put(func + psize + 4 * 4, w.append_pcvalue(1, FUNC_SIZE), 4);          // pcfile
+      w.put(func + psize + 5 * 4, w.append_pcvalue(funcs[i].line, FUNC_SIZE), 4); // pcln
+    }
+    w.put(functab + 2 * nb * psize, end, psize);
+
+    const size_t file = w.append("main.go");
+    w.align(4);
+    // nfiles followed by the offsets of the files 1 to nfiles - 1
+    const size_t filetab = w.append(2, 4);
+    w.append(file, 4);
+    w.put(functab + (2 * nb + 1) * psize, filetab, 4);
+    return w.raw;
+  }
+
+  // Go 1.16: the offsets of the sub-tables follow the header
+  const size_t words = w.raw.size();
+  w.raw.resize(words + 7 * psize);
+  w.put(words + 0 * psize, nb, psize);
+  w.put(words + 1 * psize, 1, psize);
+
+  const size_t funcnametab = w.raw.size();
+  std::vector<size_t> nameoffs;
+  for (const go_func_t& func : funcs) {
+    nameoffs.push_back(w.append(func.name) - funcnametab);
+  }
+
+  w.align(4);
+  const size_t cutab = w.append(0, 4);
+  const size_t filetab = w.raw.size();
+  w.append("main.go");
+
+  // The offset 0 of pctab means "no data"
+  const size_t pctab = w.raw.size();
+  w.raw.push_back(0);
+  std::vector<std::pair<size_t, size_t>> pcdata;
+  for (const go_func_t& func : funcs) {
+    const size_t pcfile = w.append_pcvalue(0, FUNC_SIZE) - pctab;
+    const size_t pcln   = w.append_pcvalue(func.line, FUNC_SIZE) - pctab;
+    pcdata.emplace_back(pcfile, pcln);
+  }
+
+  w.align(8);
+  const size_t functab = w.raw.size();
+  w.raw.resize(functab + (2 * nb + 1) * psize);
+  for (size_t i = 0; i < nb; ++i) {
+    w.align(4);
+    const size_t func = w.raw.size();
+    w.raw.resize(func + psize + 8 * 4);
+    w.put(functab + 2 * i * psize, funcs[i].entry, psize);
+    w.put(functab + (2 * i + 1) * psize, func - functab, psize);
+    w.put(func, funcs[i].entry, psize);
+    w.put(func + psize, nameoffs[i], 4);
+    w.put(func + psize + 4 * 4, pcdata[i].first, 4);
+    w.put(func + psize + 5 * 4, pcdata[i].second, 4);
+    w.put(func + psize + 7 * 4, /* cuOffset */ 0, 4);
+  }
+  w.put(functab + 2 * nb * psize, end, psize);
+
+  w.put(words + 2 * psize, funcnametab, psize);
+  w.put(words + 3 * psize, cutab, psize);
+  w.put(words + 4 * psize, filetab, psize);
+  w.put(words + 5 * psize, pctab, psize);
+  w.put(words + 6 * psize, functab, psize);
+  return w.raw;
+}
+
+std::vector<go_func_t> go_functions(uint64_t text) {
+  return {
+    {"runtime.text", text + 0 * FUNC_SIZE, 10},
+    {"main.init",    text + 1 * FUNC_SIZE, 20},
+    {"main.main",    text + 2 * FUNC_SIZE, 30},
+    {"main.helper",  text + 3 * FUNC_SIZE, 40},
+  };
+}
+
+void check_pclntab(const GoPclntab& tab, const std::vector<go_func_t>& funcs) {
+  REQUIRE(tab.size() == funcs.size());
+  for (uint32_t i = 0; i < funcs.size(); ++i) {
+    CHECK(tab.name(i) == funcs[i].name);
+    CHECK(tab.entry(i) == funcs[i].entry);
+    CHECK(tab.end(i) == funcs[i].entry + FUNC_SIZE);
+    CHECK(tab.lookup(funcs[i].entry + FUNC_SIZE - 1) == i);
+
+    result<GoPclntab::location_t> loc = tab.location(funcs[i].entry + 4);
+    REQUIRE(loc);
+    CHECK(loc->file == "main.go");
+    CHECK(loc->line == funcs[i].line);
+  }
+  CHECK(tab.lookup(funcs.front().entry - 1) == GoPclntab::NOT_FOUND);
+  CHECK(tab.lookup(funcs.back().entry + FUNC_SIZE) == GoPclntab::NOT_FOUND);
+
+  std::vector<Function> functions = tab.functions();
+  REQUIRE(functions.size() == funcs.size());
+  CHECK(functions[2].name() == "main.main");
+  CHECK(functions[2].size() == FUNC_SIZE);
+}
+
+void put_le(std::vector<uint8_t>& out, size_t offset, uint64_t value, size_t size) {
+  if (out.size() < offset + size) {
+    out.resize(offset + size);
+  }
+  for (size_t i = 0; i < size; ++i) {
+    out[offset + i] = uint8_t(value >> (8 * i));
+  }
+}
+
+void put_str(std::vector<uint8_t>& out, size_t offset, const std::string& str) {
+  if (out.size() < offset + str.size()) {
+    out.resize(offset + str.size());
+  }
+  std::copy(str.begin(), str.end(), out.begin() + offset);
+}
+
+static constexpr char GO_BUILDID[] = "\xff Go build ID: \"stripped\"\n \xff";
+static constexpr size_t TABLE_PADDING = 0x24;
+}
+
+TEST_CASE("lief.test.gopclntab.layouts", "[lief][test][gopclntab]") {
+  for (VERSION version : {VERSION::GO_1_2, VERSION::GO_1_16}) {
+    for (uint8_t psize : {4, 8}) {
+      for (bool big_endian : {false, true}) {
+        const std::vector<go_func_t> funcs = go_functions(0x401000);
+        const std::vector<uint8_t> raw = make_pclntab(version, psize, big_endian, funcs);
+
+        result<GoPclntab> tab = GoPclntab::parse(raw, 0x500000);
+        REQUIRE(tab);
+        CHECK(tab->version() == version);
+        CHECK(tab->pointer_size() == psize);
+        CHECK(tab->is_big_endian() == big_endian);
+        CHECK(tab->quantum() == 1);
+        CHECK(tab->address() == 0x500000);
+        check_pclntab(*tab, funcs);
+
+        // The header is found after unrelated data (including a bogus
+        // header whose function table is out of bounds)
+        std::vector<uint8_t> data(TABLE_PADDING, 0x90);
+        std::copy(raw.begin(), raw.begin() + 16, data.begin() + 4);
+        data.insert(data.end(), raw.begin(), raw.end());
+        result<size_t> offset = GoPclntab::find(data);
+        REQUIRE(offset);
+        CHECK(*offset == TABLE_PADDING);
+      }
+    }
+  }
+
+  // Truncated function table
+  std::vector<uint8_t> raw = make_pclntab(VERSION::GO_1_2, 8, false, go_functions(0x401000));
+  raw.resize(0x30);
+  CHECK(!GoPclntab::parse(raw));
+}
+
+TEST_CASE("lief.test.gopclntab.stripped_pe", "[lief][test][gopclntab]") {
+  static constexpr uint64_t IMAGEBASE = 0x140000000;
+  static constexpr size_t PE_HDR  = 0x40;
+  static constexpr size_t OPT_HDR = PE_HDR + 0x18;
+  static constexpr size_t SECTIONS = OPT_HDR + 0xf0;
+
+  const std::vector<go_func_t> funcs = go_functions(IMAGEBASE + 0x1000);
+  const std::vector<uint8_t> table = make_pclntab(VERSION::GO_1_16, 8, false, funcs);
+
+  // PE32+ with a .text section that starts with the Go build ID and a
+  // .rdata section that contains the (unnamed) table
+  std::vector<uint8_t> out(0x400);
+  put_str(out, 0, "MZ");
+  put_le(out, 0x3c, PE_HDR, 4);
+  put_str(out, PE_HDR, "PE");
+  put_le(out, PE_HDR + 0x04, 0x8664, 2);
+  put_le(out, PE_HDR + 0x06, 2, 2);
+  put_le(out, PE_HDR + 0x14, 0xf0, 2);
+  put_le(out, PE_HDR + 0x16, 0x22, 2);
+
+  put_le(out, OPT_HDR + 0x00, 0x20b, 2);
+  put_le(out, OPT_HDR + 0x10, 0x1000, 4);     // AddressOfEntryPoint
+  put_le(out, OPT_HDR + 0x18, IMAGEBASE, 8);
+  put_le(out, OPT_HDR + 0x20, 0x1000, 4);     // SectionAlignment
+  put_le(out, OPT_HDR + 0x24, 0x200, 4);      // FileAlignment
+  put_le(out, OPT_HDR + 0x38, 0x4000, 4);     // SizeOfImage
+  put_le(out, OPT_HDR + 0x3c, 0x400, 4);      // SizeOfHeaders
+  put_le(out, OPT_HDR + 0x44, 3, 2);          // CUI
+  put_le(out, OPT_HDR + 0x6c, 16, 4);         // NumberOfRvaAndSize
+
+  const uint32_t rdata_size = (TABLE_PADDING + table.size() + 0x1ff) & ~0x1ffu;
+  auto section = [&] (size_t idx, const char* name, uint32_t rva, uint32_t size,
+                      uint32_t offset, uint32_t chara) {
+    const size_t hdr = SECTIONS + idx * 0x28;
+    put_str(out, hdr, name);
+    put_le(out, hdr + 0x08, size, 4);
+    put_le(out, hdr + 0x0c, rva, 4);
+    put_le(out, hdr + 0x10, size, 4);
+    put_le(out, hdr + 0x14, offset, 4);
+    put_le(out, hdr + 0x24, chara, 4);
+  };
+  section(0, ".text", 0x1000, 0x200, 0x400, 0x60000020);
+  section(1, ".rdata", 0x2000, rdata_size, 0x600, 0x40000040);
+
+  out.resize(0x600 + rdata_size);
+  put_str(out, 0x400, GO_BUILDID);
+  std::copy(table.begin(), table.end(), out.begin() + 0x600 + TABLE_PADDING);
+
+  std::unique_ptr<PE::Binary> pe = PE::Parser::parse(out);
+  REQUIRE(pe != nullptr);
+  REQUIRE(GoPclntab::is_go(*pe));
+
+  result<GoPclntab> tab = GoPclntab::from_binary(*pe);
+  REQUIRE(tab);
+  CHECK(tab->address() == IMAGEBASE + 0x2000 + TABLE_PADDING);
+  check_pclntab(*tab, funcs);
+
+  std::unique_ptr<Symbolizer> sym = pe->symbolizer();
+  const std::string* name = sym->symbolize(funcs[2].entry + 1);
+  REQUIRE(name != nullptr);
+  CHECK(*name == "main.main");
+}
+
+TEST_CASE("lief.test.gopclntab.stripped_macho", "[lief][test][gopclntab]") {
+  static constexpr uint64_t TEXT = 0x100000000;
+
+  const std::vector<go_func_t> funcs = go_functions(TEXT + 0x1000);
+  const std::vector<uint8_t> table = make_pclntab(VERSION::GO_1_2, 8, false, funcs);
+  const uint64_t rodata_size = (TABLE_PADDING + table.size() + 0xfff) & ~uint64_t(0xfff);
+
+  // MH_EXECUTE with a __TEXT segment made of __text (which starts with the
+  // Go build ID) and __rodata (which contains the unnamed table)
+  std::vector<uint8_t> out;
+  put_le(out, 0x00, 0xfeedfacf, 4);
+  put_le(out, 0x04, 0x01000007, 4); // x86-64
+  put_le(out, 0x08, 3, 4);
+  put_le(out, 0x0c, /* MH_EXECUTE */ 2, 4);
+  put_le(out, 0x10, 1, 4);
+  put_le(out, 0x14, 0x48 + 2 * 0x50, 4);
+  put_le(out, 0x18, /* MH_PIE */ 0x00200000, 4);
+
+  const size_t seg = 0x20;
+  put_le(out, seg + 0x00, /* LC_SEGMENT_64 */ 0x19, 4);
+  put_le(out, seg + 0x04, 0x48 + 2 * 0x50, 4);
+  put_str(out, seg + 0x08, "__TEXT");
+  put_le(out, seg + 0x18, TEXT, 8);
+  put_le(out, seg + 0x20, 0x2000 + rodata_size, 8);
+  put_le(out, seg + 0x28, 0, 8);
+  put_le(out, seg + 0x30, 0x2000 + rodata_size, 8);
+  put_le(out, seg + 0x38, 5, 4);
+  put_le(out, seg + 0x3c, 5, 4);
+  put_le(out, seg + 0x40, 2, 4);
+
+  auto section = [&] (size_t idx, const char* name, uint64_t offset, uint64_t size) {
+    const size_t hdr = seg + 0x48 + idx * 0x50;
+    put_str(out, hdr, name);
+    put_str(out, hdr + 0x10, "__TEXT");
+    put_le(out, hdr + 0x20, TEXT + offset, 8);
+    put_le(out, hdr + 0x28, size, 8);
+    put_le(out, hdr + 0x30, offset, 4);
+    put_le(out, hdr + 0x34, 4, 4);
+  };
+  section(0, "__text", 0x1000, 0x1000);
+  section(1, "__rodata", 0x2000, rodata_size);
+
+  out.resize(0x2000 + rodata_size);
+  put_str(out, 0x1000, GO_BUILDID);
+  std::copy(table.begin(), table.end(), out.begin() + 0x2000 + TABLE_PADDING);
+
+  std::unique_ptr<MachO::FatBinary> fat = MachO::Parser::parse(out);
+  REQUIRE(fat != nullptr);
+  const MachO::Binary& bin = *fat->at(0);
+  REQUIRE(GoPclntab::is_go(bin));
+
+  result<GoPclntab> tab = GoPclntab::from_binary(bin);
+  REQUIRE(tab);
+  CHECK(tab->version() == VERSION::GO_1_2);
+  CHECK(tab->address() == TEXT + 0x2000 + TABLE_PADDING);
+  check_pclntab(*tab, funcs);
+
+  std::unique_ptr<Symbolizer> sym = bin.symbolizer();
+  const std::string* name = sym->symbolize(funcs[3].entry + 1);
+  REQUIRE(name != nullptr);
+  CHECK(*name == "main.helper");
+}
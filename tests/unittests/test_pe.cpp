@@ -16,6 +16,8 @@
 #include <catch2/catch_session.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
+#include <algorithm>
+#include <cstring>
 
 #include "LIEF/PE/LoadConfigurations.hpp"
 #include "LIEF/hash.hpp"
@@ -25,6 +27,10 @@
 #include "LIEF/PE/debug/Pogo.hpp"
 #include "LIEF/PE/debug/Repro.hpp"
 #include "LIEF/PE/Binary.hpp"
+#include "LIEF/PE/ApiSet.hpp"
+#include "LIEF/PE/ExportResolver.hpp"
+#include "LIEF/PE/ImportResolver.hpp"
+#include "LIEF/PE/HeaderPatcher.hpp"
 #include "LIEF/PE/ResourceData.hpp"
 #include "LIEF/PE/ResourceNode.hpp"
 #include "LIEF/PE/ResourceDirectory.hpp"
@@ -115,4 +121,498 @@ TEST_CASE("lief.test.pe", "[lief][test][pe]") {
   }
 }
 
+TEST_CASE("lief.test.pe.apiset", "[lief][test][pe][apiset]") {
+  // Build a minimal API set namespace (v6) in memory
+  struct value_t {
+    std::u16string importer;
+    std::u16string host;
+  };
+  struct contract_t {
+    std::u16string name;
+    std::vector<value_t> values;
+  };
+  const std::vector<contract_t> contracts = {
+    {u"api-ms-win-core-file-l1-2-4", {{u"", u"kernelbase.dll"}}},
+    {u"api-ms-win-core-heap-l1-1-0", {{u"", u"kernelbase.dll"},
+                                      {u"kernel32.dll", u"ntdll.dll"}}},
+    {u"ext-ms-win-foo-l1-1-0", {}},
+  };
 
+  std::vector<uint8_t> raw(28 + contracts.size() * 24);
+  const auto write_u32 = [&raw] (size_t offset, uint32_t value) {
+    if (raw.size() < offset + sizeof(value)) {
+      raw.resize(offset + sizeof(value));
+    }
+    memcpy(raw.data() + offset, &value, sizeof(value));
+  };
+  const auto add_str = [&raw] (const std::u16string& str) {
+    const size_t offset = raw.size();
+    raw.resize(offset + str.size() * sizeof(char16_t));
+    memcpy(raw.data() + offset, str.data(), str.size() * sizeof(char16_t));
+    return offset;
+  };
+
+  write_u32(0, 6);
+  write_u32(12, contracts.size());
+  write_u32(16, 28);
+  for (size_t i = 0; i < contracts.size(); ++i) {
+    const contract_t& contract = contracts[i];
+    const size_t entry = 28 + i * 24;
+    write_u32(entry + 4, add_str(contract.name));
+    write_u32(entry + 8, contract.name.size() * 2);
+    write_u32(entry + 12, contract.name.rfind(u'-') * 2);
+    const size_t values = raw.size();
+    raw.resize(values + contract.values.size() * 20);
+    write_u32(entry + 16, values);
+    write_u32(entry + 20, contract.values.size());
+    for (size_t j = 0; j < contract.values.size(); ++j) {
+      const size_t value = values + j * 20;
+      const value_t& val = contract.values[j];
+      const size_t importer = add_str(val.importer);
+      const size_t host = add_str(val.host);
+      write_u32(value + 4, importer);
+      write_u32(value + 8, val.importer.size() * 2);
+      write_u32(value + 12, host);
+      write_u32(value + 16, val.host.size() * 2);
+    }
+  }
+
+  auto apiset = PE::ApiSet::parse(raw);
+  REQUIRE(apiset);
+  REQUIRE(apiset->version() == 6);
+  REQUIRE(apiset->entries().size() == 3);
+  REQUIRE(PE::ApiSet::is_api_set("API-MS-Win-Core-File-L1-1-0.dll"));
+  REQUIRE(!PE::ApiSet::is_api_set("kernel32.dll"));
+
+  // The version of the contract is not taken into account
+  REQUIRE(*apiset->resolve("api-ms-win-core-file-l1-2-0.dll") == "kernelbase.dll");
+  REQUIRE(*apiset->resolve("API-MS-WIN-CORE-FILE-L1-2-4") == "kernelbase.dll");
+  REQUIRE(!apiset->resolve("api-ms-win-core-file-l2-1-0.dll"));
+
+  REQUIRE(*apiset->resolve("api-ms-win-core-heap-l1-1-0.dll") == "kernelbase.dll");
+  REQUIRE(*apiset->resolve("api-ms-win-core-heap-l1-1-0.dll", "KERNEL32.DLL") == "ntdll.dll");
+  REQUIRE(*apiset->resolve("api-ms-win-core-heap-l1-1-0.dll", "user32.dll") == "kernelbase.dll");
+
+  // Contract without host
+  REQUIRE(apiset->find("ext-ms-win-foo-l1-1-0.dll") != nullptr);
+  REQUIRE(!apiset->resolve("ext-ms-win-foo-l1-1-0.dll"));
+
+  // Unresolved API set in a forwarder chain
+  PE::ImportResolver resolver;
+  PE::ImportResolver::resolution_t res = resolver.resolve("api-ms-win-core-file-l1-2-4.dll", "CreateFileW");
+  REQUIRE(res.status == PE::ImportResolver::STATUS::MISSING_API_SET);
+  resolver.apiset(std::move(*apiset));
+  res = resolver.resolve("api-ms-win-core-file-l1-2-4.dll", "CreateFileW");
+  REQUIRE(res.status == PE::ImportResolver::STATUS::MISSING_LIBRARY);
+  REQUIRE(res.library == "kernelbase");
+  REQUIRE(res.chain.size() == 1);
+  REQUIRE(res.chain[0] == "kernelbase!CreateFileW");
+
+  REQUIRE(!PE::ApiSet::parse(std::vector<uint8_t>{3, 0, 0, 0}));
+  REQUIRE(!PE::ApiSet::parse(std::vector<uint8_t>{6, 0, 0}));
+}
+
+TEST_CASE("lief.test.pe.apiset.legacy", "[lief][test][pe][apiset]") {
+  // Windows 7 (v2) and Windows 8.1 (v4) schemas: the names are stored
+  // without the api-/ext- prefix and with the version of the contract
+  struct value_t {
+    std::u16string importer;
+    std::u16string host;
+  };
+  struct contract_t {
+    std::u16string name;
+    std::vector<value_t> values;
+  };
+  const std::vector<contract_t> contracts = {
+    {u"MS-Win-Core-File-L1-1-0", {{u"", u"kernelbase.dll"}}},
+    {u"MS-Win-Core-Heap-L1-1-0", {{u"", u"kernelbase.dll"},
+                                  {u"kernel32.dll", u"ntdll.dll"}}},
+  };
+
+  for (uint32_t version : {2, 4}) {
+    const size_t hdr_size   = version == 2 ? 8 : 16;
+    const size_t entry_size = version == 2 ? 12 : 24;
+    const size_t value_size = version == 2 ? 16 : 20;
+    // Size of the header of the value array (Count or Flags/Count)
+    const size_t array_size = version == 2 ? 4 : 8;
+
+    std::vector<uint8_t> raw(hdr_size + contracts.size() * entry_size);
+    const auto write_u32 = [&raw] (size_t offset, uint32_t value) {
+      memcpy(raw.data() + offset, &value, sizeof(value));
+    };
+    const auto add_str = [&raw] (const std::u16string& str) {
+      const size_t offset = raw.size();
+      raw.resize(offset + str.size() * sizeof(char16_t));
+      memcpy(raw.data() + offset, str.data(), str.size() * sizeof(char16_t));
+      return offset;
+    };
+
+    write_u32(0, version);
+    write_u32(version == 2 ? 4 : 12, contracts.size());
+    for (size_t i = 0; i < contracts.size(); ++i) {
+      const contract_t& contract = contracts[i];
+      // v2: NameOffset, NameLength, DataOffset
+      // v4: Flags, NameOffset, NameLength, AliasOffset, AliasLength, DataOffset
+      const size_t entry = hdr_size + i * entry_size;
+      const size_t name_field = version == 2 ? entry : entry + 4;
+      const size_t data_field = version == 2 ? entry + 8 : entry + 20;
+      write_u32(name_field, add_str(contract.name));
+      write_u32(name_field + 4, contract.name.size() * 2);
+
+      const size_t values = raw.size();
+      raw.resize(values + array_size + contract.values.size() * value_size);
+      write_u32(data_field, values);
+      write_u32(values + array_size - 4, contract.values.size());
+      for (size_t j = 0; j < contract.values.size(); ++j) {
+        // v4 values start with a Flags field
+        const size_t value = values + array_size + j * value_size + (version == 2 ? 0 : 4);
+        const value_t& val = contract.values[j];
+        const size_t importer = add_str(val.importer);
+        const size_t host = add_str(val.host);
+        write_u32(value + 0, importer);
+        write_u32(value + 4, val.importer.size() * 2);
+        write_u32(value + 8, host);
+        write_u32(value + 12, val.host.size() * 2);
+      }
+    }
+
+    auto apiset = PE::ApiSet::parse(raw);
+    REQUIRE(apiset);
+    REQUIRE(apiset->version() == version);
+    REQUIRE(apiset->entries().size() == 2);
+    REQUIRE(apiset->entries()[0].name == "ms-win-core-file-l1-1-0");
+    REQUIRE(apiset->entries()[1].values.size() == 2);
+
+    REQUIRE(*apiset->resolve("API-MS-WIN-CORE-FILE-L1-1-0.dll") == "kernelbase.dll");
+    REQUIRE(*apiset->resolve("api-ms-win-core-heap-l1-1-0.dll") == "kernelbase.dll");
+    REQUIRE(*apiset->resolve("api-ms-win-core-heap-l1-1-0.dll", "kernel32.dll") == "ntdll.dll");
+
+    // Prior to v6, the version of the contract is part of its name
+    REQUIRE(!apiset->resolve("api-ms-win-core-file-l1-2-0.dll"));
+    REQUIRE(!apiset->resolve("kernel32.dll"));
+
+    // Truncated value array: the contract is kept without host
+    raw.resize(raw.size() - 2);
+    auto truncated = PE::ApiSet::parse(raw);
+    REQUIRE(truncated);
+    REQUIRE(truncated->entries().size() == 2);
+    REQUIRE(*truncated->resolve("api-ms-win-core-file-l1-1-0.dll") == "kernelbase.dll");
+  }
+}
+
+namespace {
+//! Export of the DLLs built by make_dll(). An empty ``forward`` means that
+//! the function is implemented in the DLL
+struct export_t {
+  std::string name;
+  std::string forward;
+};
+
+//! Build a PE32 DLL which exports the given functions (ordinal base: 1)
+std::unique_ptr<PE::Binary> make_dll(const std::string& name,
+                                     const std::vector<export_t>& exports)
+{
+  static constexpr size_t PE_HDR  = 0x40;
+  static constexpr size_t OPT_HDR = PE_HDR + 0x18;
+  static constexpr size_t DIRS    = OPT_HDR + 0x60;
+  static constexpr size_t SECTION = OPT_HDR + 0xe0;
+  static constexpr uint32_t RAW   = 0x200;
+  static constexpr uint32_t RVA   = 0x1000;
+  static constexpr uint32_t SIZE  = 0x1000;
+  // The functions are implemented after the export directory
+  static constexpr uint32_t CODE  = RVA + 0x800;
+
+  std::vector<uint8_t> out(RAW + SIZE);
+  const auto put = [&out] (size_t offset, auto value) {
+    memcpy(out.data() + offset, &value, sizeof(value));
+  };
+  const auto put_str = [&out] (size_t offset, const std::string& str) {
+    memcpy(out.data() + offset, str.c_str(), str.size() + 1);
+  };
+
+  put_str(0, "MZ");
+  put(0x3c, uint32_t(PE_HDR));
+  put_str(PE_HDR, "PE");
+  put(PE_HDR + 0x04, uint16_t(0x14c));
+  put(PE_HDR + 0x06, uint16_t(1));
+  put(PE_HDR + 0x14, uint16_t(0xe0));
+  put(PE_HDR + 0x16, uint16_t(0x2102)); // DLL
+  put(OPT_HDR + 0x00, uint16_t(0x10b));
+  put(OPT_HDR + 0x1c, uint32_t(0x10000000));
+  put(OPT_HDR + 0x20, uint32_t(0x1000));
+  put(OPT_HDR + 0x24, uint32_t(0x200));
+  put(OPT_HDR + 0x38, uint32_t(RVA + SIZE));
+  put(OPT_HDR + 0x3c, uint32_t(RAW));
+  put(OPT_HDR + 0x44, uint16_t(2));
+  put(OPT_HDR + 0x5c, uint32_t(16));
+
+  put_str(SECTION, ".edata");
+  put(SECTION + 0x08, SIZE);
+  put(SECTION + 0x0c, RVA);
+  put(SECTION + 0x10, SIZE);
+  put(SECTION + 0x14, RAW);
+  put(SECTION + 0x24, uint32_t(0x40000040));
+
+  // IMAGE_EXPORT_DIRECTORY followed by the address, name and ordinal tables
+  const uint32_t nb = exports.size();
+  const uint32_t functions = 40;
+  const uint32_t names     = functions + nb * 4;
+  const uint32_t ordinals  = names + nb * 4;
+  uint32_t strings         = ordinals + nb * 2;
+  const auto add_str = [&] (const std::string& str) {
+    const uint32_t offset = strings;
+    put_str(RAW + offset, str);
+    strings += str.size() + 1;
+    return RVA + offset;
+  };
+
+  put(RAW + 12, add_str(name));
+  put(RAW + 16, uint32_t(1));
+  put(RAW + 20, nb);
+  put(RAW + 24, nb);
+  put(RAW + 28, RVA + functions);
+  put(RAW + 32, RVA + names);
+  put(RAW + 36, RVA + ordinals);
+
+  // The name pointer table is lexically ordered
+  std::vector<uint16_t> sorted(nb);
+  for (uint16_t i = 0; i < nb; ++i) {
+    sorted[i] = i;
+  }
+  std::sort(sorted.begin(), sorted.end(), [&exports] (uint16_t lhs, uint16_t rhs) {
+    return exports[lhs].name < exports[rhs].name;
+  });
+
+  for (uint32_t i = 0; i < nb; ++i) {
+    const export_t& exp = exports[i];
+    put(RAW + functions + i * 4, exp.forward.empty() ? CODE + i * 0x10 :
+                                                       add_str(exp.forward));
+  }
+  for (uint32_t i = 0; i < nb; ++i) {
+    put(RAW + names + i * 4, add_str(exports[sorted[i]].name));
+    put(RAW + ordinals + i * 2, sorted[i]);
+  }
+  REQUIRE(strings <= CODE - RVA);
+
+  // The directory covers the forwarder strings
+  put(DIRS, RVA);
+  put(DIRS + 4, strings);
+  return PE::Parser::parse(std::move(out));
+}
+}
+
+TEST_CASE("lief.test.pe.import_resolver", "[lief][test][pe][apiset]") {
+  using STATUS = PE::ImportResolver::STATUS;
+  std::unique_ptr<PE::Binary> kernel32 = make_dll("KERNEL32.dll", {
+    {"CreateFileW",  "api-ms-win-core-file-l1-1-0.CreateFileW"},
+    {"HeapAlloc",    "NTDLL.RtlAllocateHeap"},
+    {"Loop",         "NTDLL.Loop"},
+    {"SecondByOrd",  "KERNELBASE.#2"},
+    {"Missing",      "KERNELBASE.DoesNotExist"},
+  });
+  std::unique_ptr<PE::Binary> kernelbase = make_dll("KERNELBASE.dll", {
+    {"CreateFileW", ""},
+    {"Second",      ""},
+  });
+  std::unique_ptr<PE::Binary> ntdll = make_dll("ntdll.dll", {
+    {"Loop",            "kernel32.Loop"},
+    {"RtlAllocateHeap", ""},
+  });
+
+  // CHAIN!F0 -> CHAIN!F1 -> ... -> CHAIN!F40 which is longer than the
+  // forwarder chains accepted by the resolver
+  std::vector<export_t> chain_exports;
+  static constexpr size_t CHAIN_SIZE = 40;
+  for (size_t i = 0; i < CHAIN_SIZE; ++i) {
+    chain_exports.push_back({"F" + std::to_string(i), "CHAIN.F" + std::to_string(i + 1)});
+  }
+  chain_exports.push_back({"F" + std::to_string(CHAIN_SIZE), ""});
+  std::unique_ptr<PE::Binary> chain = make_dll("chain.dll", chain_exports);
+
+  PE::ImportResolver resolver;
+  for (const PE::Binary* dll : {kernel32.get(), kernelbase.get(), ntdll.get(), chain.get()}) {
+    REQUIRE(dll != nullptr);
+    REQUIRE(resolver.add(*dll));
+  }
+  REQUIRE(resolver.size() == 4);
+
+  {
+    // Forwarder chain through another DLL
+    PE::ImportResolver::resolution_t res = resolver.resolve("kernel32.dll", "HeapAlloc");
+    REQUIRE(res.status == STATUS::RESOLVED);
+    REQUIRE(res.library == "ntdll");
+    REQUIRE(res.function == "RtlAllocateHeap");
+    REQUIRE(res.ordinal == 2);
+    REQUIRE(res.rva == 0x1800 + 0x10);
+    REQUIRE(res.chain == std::vector<std::string>{"kernel32!HeapAlloc", "ntdll!RtlAllocateHeap"});
+
+    // Memoized resolution
+    REQUIRE(resolver.resolve("KERNEL32", "HeapAlloc").chain == res.chain);
+  }
+  {
+    // Forwarder by ordinal
+    PE::ImportResolver::resolution_t res = resolver.resolve("kernel32.dll", "SecondByOrd");
+    REQUIRE(res.status == STATUS::RESOLVED);
+    REQUIRE(res.library == "kernelbase");
+    REQUIRE(res.ordinal == 2);
+    REQUIRE(res.rva == 0x1800 + 0x10);
+    REQUIRE(res.chain.back() == "kernelbase!#2");
+    REQUIRE(resolver.resolve_ordinal("kernel32.dll", 4).rva == res.rva);
+  }
+  {
+    PE::ImportResolver::resolution_t res = resolver.resolve("kernel32.dll", "Missing");
+    REQUIRE(res.status == STATUS::MISSING_EXPORT);
+    REQUIRE(res.chain.size() == 2);
+  }
+  {
+    // The API set schema is required to follow the contract
+    REQUIRE(resolver.resolve("kernel32.dll", "CreateFileW").status == STATUS::MISSING_API_SET);
+  }
+  {
+    // kernel32!Loop -> ntdll!Loop -> kernel32!Loop
+    PE::ImportResolver::resolution_t res = resolver.resolve("kernel32.dll", "Loop");
+    REQUIRE(res.status == STATUS::CYCLE);
+    REQUIRE(res.chain == std::vector<std::string>{"kernel32!Loop", "ntdll!Loop", "kernel32!Loop"});
+
+    res = resolver.resolve("ntdll.dll", "Loop");
+    REQUIRE(res.status == STATUS::CYCLE);
+    REQUIRE(res.chain.front() == "ntdll!Loop");
+  }
+  {
+    // The chain is too long from F0 ...
+    PE::ImportResolver::resolution_t res = resolver.resolve("chain.dll", "F0");
+    REQUIRE(res.status == STATUS::CYCLE);
+
+    // ... but not from the middle of the chain, even though these hops have
+    // been visited by the previous resolution
+    res = resolver.resolve("chain.dll", "F20");
+    REQUIRE(res.status == STATUS::RESOLVED);
+    REQUIRE(res.function == "F40");
+    REQUIRE(res.chain.size() == 21);
+
+    // The memoized hops give the same result
+    REQUIRE(resolver.resolve("chain.dll", "F0").status == STATUS::CYCLE);
+    REQUIRE(resolver.resolve("chain.dll", "F10").status == STATUS::RESOLVED);
+  }
+}
+
+TEST_CASE("lief.test.pe.export_resolver", "[lief][test][pe]") {
+  std::unique_ptr<PE::Binary> dll = make_dll("test.dll", {
+    {"Forward", "NTDLL.RtlAllocateHeap"},
+    {"Local",   ""},
+  });
+  REQUIRE(dll != nullptr);
+  {
+    auto resolver = PE::ExportResolver::from_binary(*dll);
+    REQUIRE(resolver);
+    auto fwd = resolver->find("Forward");
+    REQUIRE(fwd);
+    REQUIRE(fwd->is_extern());
+    REQUIRE(fwd->forward_information().library == "NTDLL");
+    REQUIRE(fwd->forward_information().function == "RtlAllocateHeap");
+    auto local = resolver->find("Local");
+    REQUIRE(local);
+    REQUIRE(!local->is_extern());
+  }
+  {
+    // RVA + size of the directory overflows 32 bits: every RVA after the
+    // start of the directory is a forwarder
+    PE::DataDirectory* dir = dll->data_directory(PE::DataDirectory::TYPES::EXPORT_TABLE);
+    REQUIRE(dir != nullptr);
+    dir->size(0xfffff800);
+    auto resolver = PE::ExportResolver::from_binary(*dll);
+    REQUIRE(resolver);
+    auto fwd = resolver->find("Forward");
+    REQUIRE(fwd);
+    REQUIRE(fwd->is_extern());
+    REQUIRE(fwd->forward_information().library == "NTDLL");
+    auto local = resolver->find("Local");
+    REQUIRE(local);
+    REQUIRE(local->is_extern());
+  }
+}
+
+TEST_CASE("lief.test.pe.header_patcher", "[lief][test][pe][patcher]") {
+  static constexpr size_t PE_OFFSET = 0x80;
+  static constexpr size_t OPT_OFFSET = PE_OFFSET + 24;
+  static constexpr size_t CHECKSUM_OFFSET = OPT_OFFSET + 64;
+  static constexpr size_t DIRS_OFFSET = OPT_OFFSET + 112;
+
+  // Odd size to check the trailing byte of the checksum
+  std::vector<uint8_t> raw(0x1001);
+  for (size_t i = 0; i < raw.size(); ++i) {
+    raw[i] = static_cast<uint8_t>((i * 2654435761u) >> 13);
+  }
+  const auto write = [&raw] (size_t offset, auto value) {
+    memcpy(raw.data() + offset, &value, sizeof(value));
+  };
+  const auto compute_checksum = [&raw] {
+    uint32_t sum = 0;
+    for (size_t i = 0; i < raw.size(); i += 2) {
+      if (CHECKSUM_OFFSET <= i && i < CHECKSUM_OFFSET + 4) {
+        continue;
+      }
+      sum += raw[i] | (i + 1 < raw.size() ? raw[i + 1] << 8 : 0);
+      sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return ((sum & 0xffff) + (sum >> 16) & 0xffff) + uint32_t(raw.size());
+  };
+  const auto checksum = [&raw] {
+    uint32_t value = 0;
+    memcpy(&value, raw.data() + CHECKSUM_OFFSET, sizeof(value));
+    return value;
+  };
+
+  write(0, uint16_t(0x5a4d));
+  write(0x3c, uint32_t(PE_OFFSET));
+  memcpy(raw.data() + PE_OFFSET, "PE\0\0", 4);
+  write(OPT_OFFSET, uint16_t(0x20b));
+  write(OPT_OFFSET + 108, uint32_t(16));
+  write(DIRS_OFFSET + 4 * 8, uint64_t(0)); // No signature
+  write(CHECKSUM_OFFSET, compute_checksum());
+
+  auto patcher = PE::HeaderPatcher::from_buffer(raw);
+  REQUIRE(patcher);
+  REQUIRE(patcher->type() == PE::PE_TYPE::PE32_PLUS);
+  REQUIRE(patcher->checksum() == compute_checksum());
+  REQUIRE(!patcher->is_signed());
+
+  REQUIRE(patcher->time_date_stamp(0xdeadbeef));
+  REQUIRE(checksum() == compute_checksum());
+  REQUIRE(patcher->subsystem(PE::OptionalHeader::SUBSYSTEM::WINDOWS_CUI));
+  REQUIRE(patcher->dll_characteristics(0x8160));
+  REQUIRE(patcher->data_directory(PE::DataDirectory::TYPES::DEBUG_DIR, 0x2000, 0x1c));
+  REQUIRE(checksum() == compute_checksum());
+
+  // Unaligned patch and trailing byte
+  const uint8_t bytes[] = {1, 2, 3};
+  REQUIRE(patcher->patch(0x201, bytes));
+  REQUIRE(patcher->patch(raw.size() - 1, {bytes, 1}));
+  REQUIRE(checksum() == compute_checksum());
+  REQUIRE(patcher->checksum() == checksum());
+
+  REQUIRE(!patcher->patch(CHECKSUM_OFFSET - 1, bytes));
+  REQUIRE(!patcher->patch(raw.size() - 1, bytes));
+  REQUIRE(!patcher->data_directory(PE::DataDirectory::TYPES::UNKNOWN, 0, 0));
+
+  // Signed binary: only the certificate table (and its entry) can be
+  // patched without breaking the signature
+  REQUIRE(patcher->data_directory(PE::DataDirectory::TYPES::CERTIFICATE_TABLE, 0xf00, 0x100));
+  REQUIRE(patcher->is_signed());
+  REQUIRE(!patcher->signature_invalidated());
+  REQUIRE(patcher->patch(0xf10, bytes));
+  REQUIRE(!patcher->signature_invalidated());
+  REQUIRE(patcher->time_date_stamp(0));
+  REQUIRE(patcher->signature_invalidated());
+  REQUIRE(checksum() == compute_checksum());
+
+  // A null checksum is kept as-is
+  write(CHECKSUM_OFFSET, uint32_t(0));
+  patcher = PE::HeaderPatcher::from_buffer(raw);
+  REQUIRE(patcher);
+  REQUIRE(patcher->time_date_stamp(1));
+  REQUIRE(checksum() == 0);
+
+  raw[0] = 0;
+  REQUIRE(!PE::HeaderPatcher::from_buffer(raw));
+}
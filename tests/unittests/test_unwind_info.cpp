@@ -0,0 +1,269 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <LIEF/MachO/UnwindInfo.hpp>
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+using namespace LIEF;
+using MachO::UnwindInfo;
+
+namespace {
+constexpr uint64_t IMAGEBASE = 0x100000000;
+constexpr uint64_t EH_FRAME = IMAGEBASE + 0x4000;
+constexpr uint32_t PERSONALITY = 0x8000;
+
+// Non-DWARF encodings (their mode is ignored by the decoder)
+constexpr uint32_t COMMON_0 = 0x02001000;
+constexpr uint32_t COMMON_1 = 0x02002000;
+
+constexpr uint32_t MODE_DWARF_ARM64 = 0x03000000;
+constexpr uint32_t MODE_DWARF_X86   = 0x04000000;
+
+// Offsets of the FDEs in the __eh_frame built by make_eh_frame()
+constexpr uint32_t FDE_0 = 20;
+constexpr uint32_t FDE_1 = 40;
+
+template<class T>
+void push(std::vector<uint8_t>& out, T value) {
+  const size_t offset = out.size();
+  out.resize(offset + sizeof(T));
+  std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+// __eh_frame with a "zR" CIE (pcrel|sdata4 pointers) followed by the FDEs
+// of the functions at 0x1180 and 0x2200
+std::vector<uint8_t> make_eh_frame() {
+  std::vector<uint8_t> out;
+  push<uint32_t>(out, 16);  // length
+  push<uint32_t>(out, 0);   // CIE id
+  push<uint8_t>(out, 1);    // version
+  for (uint8_t c : {'z', 'R', '\0'}) {
+    push<uint8_t>(out, c);
+  }
+  push<uint8_t>(out, 1);    // code alignment
+  push<uint8_t>(out, 0x78); // data alignment (-8)
+  push<uint8_t>(out, 30);   // return address register
+  push<uint8_t>(out, 1);    // augmentation length
+  push<uint8_t>(out, 0x1b); // DW_EH_PE_pcrel | DW_EH_PE_sdata4
+  out.resize(20);           // DW_CFA_nop
+
+  for (uint32_t function : {0x1180, 0x2200}) {
+    const uint32_t start = out.size();
+    push<uint32_t>(out, 16);         // length
+    push<uint32_t>(out, start + 4);  // CIE pointer
+    const uint64_t pc_begin = EH_FRAME + out.size();
+    push<int32_t>(out, static_cast<int32_t>(IMAGEBASE + function - pc_begin));
+    push<int32_t>(out, 0x80);        // pc range
+    push<uint8_t>(out, 0);           // augmentation length
+    out.resize(start + 20);
+  }
+  return out;
+}
+
+// __unwind_info with a regular page that covers [0x1000, 0x2000) and a
+// compressed page that covers [0x2000, 0x3000):
+//
+//   0x1000  COMMON_0
+//   0x1100  COMMON_0 + LSDA + personality
+//   0x1180  DWARF (FDE_0)
+//   ------
+//   0x2000  COMMON_0                        (common encoding #0)
+//   0x2200  DWARF (FDE_1) + LSDA + personality (page encoding)
+//   0x2300  COMMON_1                        (common encoding #1)
+std::vector<uint8_t> make_unwind_info(uint32_t dwarf_mode) {
+  constexpr uint32_t ENCODINGS     = 28;
+  constexpr uint32_t PERSONALITIES = ENCODINGS + 2 * 4;
+  constexpr uint32_t INDEX         = PERSONALITIES + 4;
+  constexpr uint32_t LSDA          = INDEX + 3 * 12;
+  constexpr uint32_t REGULAR       = LSDA + 2 * 8;
+  constexpr uint32_t COMPRESSED    = REGULAR + 8 + 3 * 8;
+
+  const uint32_t personality_1 = 1 << 28;
+
+  std::vector<uint8_t> out;
+  push<uint32_t>(out, 1); // version
+  push<uint32_t>(out, ENCODINGS);
+  push<uint32_t>(out, 2);
+  push<uint32_t>(out, PERSONALITIES);
+  push<uint32_t>(out, 1);
+  push<uint32_t>(out, INDEX);
+  push<uint32_t>(out, 3);
+
+  push<uint32_t>(out, COMMON_0);
+  push<uint32_t>(out, COMMON_1);
+  push<uint32_t>(out, PERSONALITY);
+
+  // First-level index (the last entry is the sentinel)
+  for (uint32_t value : {0x1000u, REGULAR,    LSDA,
+                         0x2000u, COMPRESSED, LSDA + 8,
+                         0x3000u, 0u,         LSDA + 16})
+  {
+    push<uint32_t>(out, value);
+  }
+
+  // LSDA of the functions at 0x1100 and 0x2200
+  for (uint32_t value : {0x1100, 0x9000, 0x2200, 0x9100}) {
+    push<uint32_t>(out, value);
+  }
+
+  // Regular page
+  push<uint32_t>(out, 2); // kind
+  push<uint16_t>(out, 8); // entry_page_offset
+  push<uint16_t>(out, 3); // entry_count
+  for (uint32_t value : {0x1000u, COMMON_0,
+                         0x1100u, COMMON_0 | UnwindInfo::HAS_LSDA | personality_1,
+                         0x1180u, dwarf_mode | FDE_0})
+  {
+    push<uint32_t>(out, value);
+  }
+
+  // Compressed page
+  push<uint32_t>(out, 3);  // kind
+  push<uint16_t>(out, 12); // entry_page_offset
+  push<uint16_t>(out, 3);  // entry_count
+  push<uint16_t>(out, 24); // encodings_page_offset
+  push<uint16_t>(out, 1);  // encodings_count
+  push<uint32_t>(out, (0 << 24) | 0x000);
+  push<uint32_t>(out, (2 << 24) | 0x200);
+  push<uint32_t>(out, (1 << 24) | 0x300);
+  push<uint32_t>(out, dwarf_mode | FDE_1 | UnwindInfo::HAS_LSDA | personality_1);
+  return out;
+}
+
+struct expected_t {
+  uint64_t offset;
+  uint64_t size;
+  uint64_t lsda;
+  bool dwarf;
+};
+
+const std::vector<expected_t> EXPECTED = {
+  {0x1000, 0x100, 0,      false},
+  {0x1100, 0x080, 0x9000, false},
+  {0x1180, 0xe80, 0,      true},
+  {0x2000, 0x200, 0,      false},
+  {0x2200, 0x100, 0x9100, true},
+  {0x2300, 0xd00, 0,      false},
+};
+
+void check_entry(const UnwindInfo::entry_t& entry, const expected_t& expected) {
+  CHECK(entry.address == IMAGEBASE + expected.offset);
+  CHECK(entry.size == expected.size);
+  CHECK(entry.lsda == (expected.lsda != 0 ? IMAGEBASE + expected.lsda : 0));
+  CHECK(entry.personality == (expected.lsda != 0 ? IMAGEBASE + PERSONALITY : 0));
+  CHECK(entry.is_function_start());
+}
+}
+
+TEST_CASE("lief.test.macho.unwind_info", "[lief][test][macho]") {
+  const std::vector<uint8_t> eh_frame = make_eh_frame();
+
+  for (auto [arch, mode] : {std::pair{MachO::Header::CPU_TYPE::ARM64, MODE_DWARF_ARM64},
+                            std::pair{MachO::Header::CPU_TYPE::X86_64, MODE_DWARF_X86}})
+  {
+    const std::vector<uint8_t> raw = make_unwind_info(mode);
+    auto info = UnwindInfo::parse(raw, IMAGEBASE, arch, eh_frame, EH_FRAME);
+    REQUIRE(info);
+
+    CHECK(info->version() == 1);
+    CHECK(info->arch() == arch);
+    CHECK(info->nb_pages() == 2);
+    CHECK(info->common_encodings() == std::vector<uint32_t>{COMMON_0, COMMON_1});
+    CHECK(info->personalities() == std::vector<uint64_t>{IMAGEBASE + PERSONALITY});
+
+    std::vector<UnwindInfo::entry_t> entries(info->entries().begin(),
+                                             info->entries().end());
+    REQUIRE(entries.size() == EXPECTED.size());
+
+    size_t nb_dwarf = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+      const UnwindInfo::entry_t& entry = entries[i];
+      check_entry(entry, EXPECTED[i]);
+      CHECK(info->is_dwarf(entry.encoding) == EXPECTED[i].dwarf);
+
+      for (uint64_t address : {entry.address, entry.address + entry.size - 1}) {
+        auto found = info->lookup(address);
+        REQUIRE(found);
+        check_entry(*found, EXPECTED[i]);
+        CHECK(found->encoding == entry.encoding);
+      }
+
+      auto fde = info->fde(entry);
+      if (!EXPECTED[i].dwarf) {
+        CHECK_FALSE(fde);
+        continue;
+      }
+      REQUIRE(fde);
+      CHECK(fde->address == EH_FRAME + (i < 3 ? FDE_0 : FDE_1));
+      CHECK(fde->pc_begin == entry.address);
+      CHECK(fde->pc_end == entry.address + 0x80);
+      ++nb_dwarf;
+    }
+    CHECK(nb_dwarf == 2);
+
+    // Batch lookup that goes back and forth between the two pages
+    std::vector<uint64_t> addresses = {
+      IMAGEBASE + 0x2250, IMAGEBASE + 0x1000, IMAGEBASE + 0x2fff,
+      IMAGEBASE + 0x1180, IMAGEBASE + 0x3000, IMAGEBASE + 0xfff, 0,
+    };
+    std::vector<UnwindInfo::entry_t> batch = info->lookup(addresses);
+    REQUIRE(batch.size() == addresses.size());
+    check_entry(batch[0], EXPECTED[4]);
+    check_entry(batch[1], EXPECTED[0]);
+    check_entry(batch[2], EXPECTED[5]);
+    check_entry(batch[3], EXPECTED[2]);
+    CHECK(batch[4].address == 0);
+    CHECK(batch[5].address == 0);
+    CHECK(batch[6].address == 0);
+
+    CHECK_FALSE(info->lookup(IMAGEBASE + 0xfff));
+    CHECK_FALSE(info->lookup(IMAGEBASE + 0x3000));
+  }
+
+  {
+    // The DWARF mode depends on the architecture
+    const std::vector<uint8_t> raw = make_unwind_info(MODE_DWARF_X86);
+    auto info = UnwindInfo::parse(raw, IMAGEBASE, MachO::Header::CPU_TYPE::ARM64,
+                                  eh_frame, EH_FRAME);
+    REQUIRE(info);
+    auto entry = info->lookup(IMAGEBASE + 0x1180);
+    REQUIRE(entry);
+    CHECK_FALSE(info->is_dwarf(entry->encoding));
+    CHECK_FALSE(info->fde(*entry));
+  }
+
+  {
+    // Without __eh_frame, the FDEs can't be resolved
+    const std::vector<uint8_t> raw = make_unwind_info(MODE_DWARF_ARM64);
+    auto info = UnwindInfo::parse(raw, IMAGEBASE, MachO::Header::CPU_TYPE::ARM64);
+    REQUIRE(info);
+    auto entry = info->lookup(IMAGEBASE + 0x2200);
+    REQUIRE(entry);
+    CHECK(info->is_dwarf(entry->encoding));
+    CHECK_FALSE(info->fde(*entry));
+  }
+
+  {
+    // Truncated table
+    std::vector<uint8_t> raw = make_unwind_info(MODE_DWARF_ARM64);
+    raw.resize(50);
+    CHECK_FALSE(UnwindInfo::parse(raw, IMAGEBASE, MachO::Header::CPU_TYPE::ARM64));
+  }
+}
@@ -0,0 +1,362 @@
+/* Copyright 2017 - 2024 R. Thomas
+ * Copyright 2017 - 2024 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <LIEF/ZIP.hpp>
+#include <LIEF/Abstract/Binary.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "utils.hpp"
+
+using namespace LIEF;
+
+namespace {
+void push_le16(std::vector<uint8_t>& out, uint16_t v) {
+  out.push_back(v); out.push_back(v >> 8);
+}
+
+void push_le32(std::vector<uint8_t>& out, uint32_t v) {
+  out.push_back(v);       out.push_back(v >> 8);
+  out.push_back(v >> 16); out.push_back(v >> 24);
+}
+
+void push_str(std::vector<uint8_t>& out, const std::string& str) {
+  out.insert(out.end(), str.begin(), str.end());
+}
+
+struct file_t {
+  std::string name;
+  uint16_t method = 0;
+  std::vector<uint8_t> data;
+  uint32_t crc = 0;
+  uint32_t size = 0;
+  size_t align = 0;
+};
+
+// Build a ZIP archive. Stored entries can be aligned (as zipalign does)
+// with padding in the extra field of their local header.
+std::vector<uint8_t> make_zip(const std::vector<file_t>& files) {
+  std::vector<uint8_t> out;
+  std::vector<uint32_t> offsets;
+  for (const file_t& f : files) {
+    offsets.push_back(out.size());
+    size_t padding = 0;
+    if (f.align > 0) {
+      const size_t data_off = out.size() + 30 + f.name.size();
+      padding = (f.align - data_off % f.align) % f.align;
+    }
+    push_le32(out, 0x04034b50);
+    push_le16(out, 20); push_le16(out, 0); push_le16(out, f.method);
+    push_le16(out, 0);  push_le16(out, 0);
+    push_le32(out, f.crc);
+    push_le32(out, f.data.size());
+    push_le32(out, f.size);
+    push_le16(out, f.name.size());
+    push_le16(out, padding);
+    push_str(out, f.name);
+    out.insert(out.end(), padding, 0);
+    out.insert(out.end(), f.data.begin(), f.data.end());
+  }
+
+  const uint32_t cd_offset = out.size();
+  for (size_t i = 0; i < files.size(); ++i) {
+    const file_t& f = files[i];
+    push_le32(out, 0x02014b50);
+    push_le16(out, 20); push_le16(out, 20); push_le16(out, 0); push_le16(out, f.method);
+    push_le16(out, 0);  push_le16(out, 0);
+    push_le32(out, f.crc);
+    push_le32(out, f.data.size());
+    push_le32(out, f.size);
+    push_le16(out, f.name.size());
+    push_le16(out, 0); push_le16(out, 0); push_le16(out, 0); push_le16(out, 0);
+    push_le32(out, 0);
+    push_le32(out, offsets[i]);
+    push_str(out, f.name);
+  }
+  const uint32_t cd_size = out.size() - cd_offset;
+
+  push_le32(out, 0x06054b50);
+  push_le16(out, 0); push_le16(out, 0);
+  push_le16(out, files.size()); push_le16(out, files.size());
+  push_le32(out, cd_size);
+  push_le32(out, cd_offset);
+  push_le16(out, 0);
+  return out;
+}
+
+file_t stored(const std::string& name, const std::vector<uint8_t>& data, size_t align = 0) {
+  file_t f;
+  f.name = name;
+  f.data = data;
+  f.crc = ZIP::crc32(data);
+  f.size = data.size();
+  f.align = align;
+  return f;
+}
+
+// Fixed Huffman block that inflates to 1 + 258 * count zeros. The end of
+// block code is omitted if ``truncated`` is true.
+std::vector<uint8_t> deflate_zeros(size_t count, bool truncated = false) {
+  std::vector<uint8_t> out;
+  uint32_t acc = 0;
+  uint32_t nbits = 0;
+  // Huffman codes are packed starting from their most significant bit
+  auto put_code = [&] (uint32_t code, uint32_t size) {
+    for (uint32_t i = size; i > 0; --i) {
+      acc |= ((code >> (i - 1)) & 1) << nbits;
+      if (++nbits == 8) {
+        out.push_back(acc);
+        acc = nbits = 0;
+      }
+    }
+  };
+  put_code(0b110, 3);   // BFINAL, BTYPE: fixed Huffman codes
+  put_code(0x30, 8);    // Literal 0
+  for (size_t i = 0; i < count; ++i) {
+    put_code(0xc5, 8);  // Length code 285 (258)
+    put_code(0, 5);     // Distance code 0 (1)
+  }
+  if (!truncated) {
+    put_code(0, 7);     // End of block (256)
+  }
+  if (nbits > 0) {
+    out.push_back(acc);
+  }
+  return out;
+}
+
+std::vector<uint8_t> read_file(const std::string& path) {
+  std::ifstream ifs(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+}
+
+// Minimal DEX file with only the string and type ids
+std::vector<uint8_t> make_dex(const std::vector<std::string>& strings,
+                              const std::vector<uint32_t>& types)
+{
+  std::vector<uint8_t> dex = {'d', 'e', 'x', '\n', '0', '3', '5', '\0'};
+  dex.resize(0x70);
+  const uint32_t strings_off = dex.size();
+  const uint32_t types_off = strings_off + strings.size() * 4;
+  uint32_t data_off = types_off + types.size() * 4;
+  auto set_le32 = [&] (size_t off, uint32_t v) {
+    for (size_t i = 0; i < 4; ++i) {
+      dex[off + i] = (v >> (8 * i)) & 0xff;
+    }
+  };
+  set_le32(0x38, strings.size());
+  set_le32(0x3c, strings_off);
+  set_le32(0x40, types.size());
+  set_le32(0x44, types_off);
+  for (const std::string& str : strings) {
+    push_le32(dex, data_off);
+    data_off += 1 + str.size() + 1;
+  }
+  for (uint32_t idx : types) {
+    push_le32(dex, idx);
+  }
+  for (const std::string& str : strings) {
+    dex.push_back(str.size());
+    push_str(dex, str);
+    dex.push_back(0);
+  }
+  return dex;
+}
+}
+
+TEST_CASE("lief.test.zip", "[lief][test][zip]") {
+  SECTION("crc32") {
+    const std::string str = "123456789";
+    REQUIRE(ZIP::crc32({reinterpret_cast<const uint8_t*>(str.data()), str.size()}) == 0xcbf43926);
+  }
+
+  SECTION("entries") {
+    const std::string text = "LIEF LIEF LIEF LIEF LIEF LIEF LIEF LIEF";
+    file_t deflated;
+    deflated.name = "assets/text.txt";
+    deflated.method = 8;
+    deflated.data = {0xf3, 0xf1, 0x74, 0x75, 0x53, 0xf0, 0x21, 0x48, 0x00, 0x00};
+    deflated.crc = 0xb73d3ad2;
+    deflated.size = text.size();
+
+    // Deflate "stored" block (BTYPE=00)
+    file_t deflated_raw;
+    deflated_raw.name = "lib/x86_64/libbar.so";
+    deflated_raw.method = 8;
+    deflated_raw.data = {0x01, 0x04, 0x00, 0xfb, 0xff, 0x7f, 'E', 'L', 'F'};
+    deflated_raw.size = 4;
+    deflated_raw.crc = ZIP::crc32(span<const uint8_t>(deflated_raw.data).subspan(5));
+
+    const std::vector<uint8_t> lib = {0x7f, 'E', 'L', 'F', 1, 2, 3};
+
+    std::vector<uint8_t> raw = make_zip({
+      stored("AndroidManifest.xml", {1, 2, 3}),
+      deflated,
+      stored("lib/arm64-v8a/libfoo.so", lib, 0x1000),
+      deflated_raw,
+      stored("lib/arm64-v8a/sub/libnot.so", {}),
+    });
+
+    REQUIRE(ZIP::is_zip(raw));
+    std::unique_ptr<ZIP::Archive> zip = ZIP::Parser::parse(raw);
+    REQUIRE(zip != nullptr);
+    REQUIRE(zip->entries().size() == 5);
+
+    const ZIP::Entry* so = zip->get_entry("lib/arm64-v8a/libfoo.so");
+    REQUIRE(so != nullptr);
+    CHECK(so->is_stored());
+    CHECK(so->is_page_aligned());
+    CHECK(so->is_native_library());
+
+    // Stored entries reference the archive's data
+    std::vector<uint8_t> buffer;
+    auto content = zip->content(*so, buffer);
+    REQUIRE(content);
+    CHECK(buffer.empty());
+    CHECK(content->data() == zip->raw().data() + so->data_offset());
+    CHECK(std::vector<uint8_t>(content->begin(), content->end()) == lib);
+
+    const ZIP::Entry* txt = zip->get_entry("assets/text.txt");
+    REQUIRE(txt != nullptr);
+    CHECK(txt->method() == ZIP::Entry::METHOD::DEFLATED);
+    CHECK(!txt->is_page_aligned());
+    content = zip->content(*txt, buffer);
+    REQUIRE(content);
+    CHECK(std::string(content->begin(), content->end()) == text);
+
+    auto extracted = zip->extract(*zip->get_entry("lib/x86_64/libbar.so"));
+    REQUIRE(extracted);
+    CHECK(*extracted == std::vector<uint8_t>{0x7f, 'E', 'L', 'F'});
+
+    CHECK(zip->native_libraries().size() == 2);
+    REQUIRE(zip->native_libraries("arm64-v8a").size() == 1);
+    CHECK(zip->native_libraries("arm64-v8a")[0] == so);
+    CHECK(zip->native_libraries("arm64").empty());
+
+    // Corrupted CRC
+    std::vector<uint8_t> corrupted = raw;
+    corrupted[txt->data_offset()] ^= 0xff;
+    std::unique_ptr<ZIP::Archive> bad = ZIP::Parser::parse(corrupted);
+    REQUIRE(bad != nullptr);
+    CHECK(!bad->content(*bad->get_entry("assets/text.txt"), buffer));
+  }
+
+  SECTION("multidex") {
+    std::vector<uint8_t> dex1 = make_dex({"I", "LFoo;", "Ljava/lang/Object;"}, {0, 1, 2});
+    std::vector<uint8_t> dex2 = make_dex({"LBar;", "Ljava/lang/Object;", "bar"}, {0, 1});
+
+    std::vector<uint8_t> raw = make_zip({
+      stored("classes2.dex", dex2),
+      stored("classes.dex", dex1),
+      stored("assets/classes.dex", {}),
+    });
+
+    std::unique_ptr<ZIP::Archive> zip = ZIP::Parser::parse(raw);
+    REQUIRE(zip != nullptr);
+    std::vector<const ZIP::Entry*> dex_files = zip->dex_files();
+    REQUIRE(dex_files.size() == 2);
+    CHECK(dex_files[0]->name() == "classes.dex");
+    CHECK(dex_files[1]->name() == "classes2.dex");
+
+    auto pool = zip->dex_pool();
+    REQUIRE(pool);
+    CHECK(pool->strings.size() == 5);
+    CHECK(pool->types.size() == 4);
+    REQUIRE(pool->strings_map.size() == 2);
+    REQUIRE(pool->types_map.size() == 2);
+    // Ljava/lang/Object; is shared by the two DEX files
+    CHECK(pool->strings_map[0][2] == pool->strings_map[1][1]);
+    CHECK(pool->types_map[0][2] == pool->types_map[1][1]);
+    CHECK(pool->strings[pool->types[pool->types_map[1][0]]] == "LBar;");
+  }
+
+  SECTION("declared size") {
+    // Stored deflate block of 4 bytes that declares 4GiB once inflated
+    file_t bomb;
+    bomb.name = "assets/bomb.bin";
+    bomb.method = 8;
+    bomb.data = {0x01, 0x04, 0x00, 0xfb, 0xff, 'L', 'I', 'E', 'F'};
+    bomb.size = 0xffffffff;
+    bomb.crc = ZIP::crc32(span<const uint8_t>(bomb.data).subspan(5));
+
+    std::unique_ptr<ZIP::Archive> zip = ZIP::Parser::parse(make_zip({bomb}));
+    REQUIRE(zip != nullptr);
+    std::vector<uint8_t> buffer;
+    CHECK(!zip->content(*zip->get_entry("assets/bomb.bin"), buffer));
+    CHECK(buffer.capacity() < 0x1000);
+
+    // A single (truncated) block that expands beyond the declared size: the
+    // inflater stops inside the block, before reaching its end
+    file_t zeros;
+    zeros.name = "assets/zeros.bin";
+    zeros.method = 8;
+    zeros.data = deflate_zeros(0x4000, /*truncated=*/true);
+    zeros.size = 0x1000;
+
+    zip = ZIP::Parser::parse(make_zip({zeros}));
+    REQUIRE(zip != nullptr);
+    auto content = zip->content(*zip->get_entry("assets/zeros.bin"), buffer);
+    REQUIRE(!content);
+    CHECK(content.error() == lief_errors::corrupted);
+
+    // Same block with its end: the declared size is reached exactly
+    zeros.data = deflate_zeros(15);
+    zeros.size = 1 + 258 * 15;
+    zeros.crc = ZIP::crc32(std::vector<uint8_t>(zeros.size, 0));
+    zip = ZIP::Parser::parse(make_zip({zeros}));
+    REQUIRE(zip != nullptr);
+    content = zip->content(*zip->get_entry("assets/zeros.bin"), buffer);
+    REQUIRE(content);
+    CHECK(content->size() == zeros.size);
+  }
+
+  SECTION("parallel parsing") {
+    const std::vector<uint8_t> arm = read_file(test::get_elf_sample("ELF32_ARM_binary_ls.bin"));
+    const std::vector<uint8_t> x64 = read_file(test::get_elf_sample("ELF64_x86-64_binary_ls.bin"));
+
+    std::vector<file_t> files;
+    for (size_t i = 0; i < 8; ++i) {
+      files.push_back(stored("lib/armeabi-v7a/lib" + std::to_string(i) + ".so", arm, 0x1000));
+      files.push_back(stored("lib/x86_64/lib" + std::to_string(i) + ".so", x64, 0x1000));
+    }
+    files.push_back(stored("lib/x86_64/libbad.so", {'L', 'I', 'E', 'F'}));
+
+    std::unique_ptr<ZIP::Archive> zip = ZIP::Parser::parse(make_zip(files));
+    REQUIRE(zip != nullptr);
+    const std::vector<const ZIP::Entry*> libs = zip->native_libraries();
+    REQUIRE(libs.size() == files.size());
+
+    std::vector<std::unique_ptr<Binary>> binaries = zip->parse_all(libs, 4);
+    REQUIRE(binaries.size() == libs.size());
+    for (size_t i = 0; i < libs.size(); ++i) {
+      if (libs[i]->name() == "lib/x86_64/libbad.so") {
+        CHECK(binaries[i] == nullptr);
+        continue;
+      }
+      REQUIRE(binaries[i] != nullptr);
+      std::unique_ptr<Binary> expected = zip->parse(*libs[i]);
+      CHECK(binaries[i]->header().architecture() == expected->header().architecture());
+      CHECK(binaries[i]->entrypoint() == expected->entrypoint());
+    }
+  }
+
+  SECTION("not a zip") {
+    CHECK(ZIP::Parser::parse(std::vector<uint8_t>{1, 2, 3}) == nullptr);
+  }
+}
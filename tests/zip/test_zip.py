@@ -0,0 +1,80 @@
+#!/usr/bin/env python
+import io
+import zipfile
+import zlib
+from pathlib import Path
+
+import lief
+from utils import get_sample
+
+def _apk(files: list[tuple[str, bytes, int]]) -> bytes:
+    out = io.BytesIO()
+    with zipfile.ZipFile(out, "w") as zf:
+        for name, data, method in files:
+            zf.writestr(zipfile.ZipInfo(name), data, compress_type=method)
+    return out.getvalue()
+
+def test_apk(tmp_path: Path):
+    ls = Path(get_sample('ELF/ELF64_x86-64_binary_ls.bin')).read_bytes()
+    arm = Path(get_sample('ELF/ELF32_ARM_binary_ls.bin')).read_bytes()
+    text = b"LIEF " * 100
+    raw = _apk([
+        ("lib/x86_64/libls.so",       ls,   zipfile.ZIP_STORED),
+        ("lib/armeabi-v7a/libarm.so", arm,  zipfile.ZIP_DEFLATED),
+        ("assets/text.txt",           text, zipfile.ZIP_DEFLATED),
+    ])
+
+    assert lief.ZIP.is_zip(list(raw))
+    output = tmp_path / "test.apk"
+    output.write_bytes(raw)
+    assert lief.ZIP.is_zip(output.as_posix())
+    assert lief.ZIP.crc32(text) == zlib.crc32(text)
+
+    for apk in (lief.ZIP.parse(output.as_posix()), lief.ZIP.parse(list(raw)),
+                lief.ZIP.parse(io.BytesIO(raw))):
+        assert apk is not None
+        assert [e.name for e in apk.entries] == [
+            "lib/x86_64/libls.so", "lib/armeabi-v7a/libarm.so", "assets/text.txt"
+        ]
+        assert apk.raw == raw
+
+        txt = apk.get_entry("assets/text.txt")
+        assert txt is not None
+        assert txt.method == lief.ZIP.Entry.METHOD.DEFLATED
+        assert txt.size == len(text)
+        assert txt.compressed_size < len(text)
+        assert txt.crc32 == zlib.crc32(text)
+        assert apk.extract(txt) == text
+
+        libs = apk.native_libraries()
+        assert [lib.name for lib in libs] == ["lib/x86_64/libls.so", "lib/armeabi-v7a/libarm.so"]
+        assert all(lib.is_native_library for lib in libs)
+        assert [lib.name for lib in apk.native_libraries("x86_64")] == ["lib/x86_64/libls.so"]
+        assert libs[0].is_stored
+        assert bytes(libs[0].raw_content) == ls
+
+        binaries = apk.parse_all(libs)
+        assert len(binaries) == 2
+        assert isinstance(binaries[0], lief.ELF.Binary)
+        assert binaries[0].header.machine_type == lief.ELF.ARCH.X86_64
+        assert binaries[1].header.machine_type == lief.ELF.ARCH.ARM
+        assert apk.parse(libs[1]).header.machine_type == lief.ELF.ARCH.ARM
+        assert apk.parse(txt) is None
+
+        assert len(apk.dex_files) == 0
+
+def test_corrupted():
+    text = b"LIEF " * 100
+    raw = bytearray(_apk([("assets/text.txt", text, zipfile.ZIP_STORED)]))
+    apk = lief.ZIP.parse(list(raw))
+    entry = apk.get_entry("assets/text.txt")
+    raw[entry.data_offset] ^= 0xff
+
+    apk = lief.ZIP.parse(list(raw))
+    entry = apk.get_entry("assets/text.txt")
+    assert apk.extract(entry) == lief.lief_errors.corrupted
+    assert apk.extract(entry, check_crc=False)[1:] == text[1:]
+
+def test_not_zip():
+    assert not lief.ZIP.is_zip(list(b"LIEF"))
+    assert lief.ZIP.parse(list(b"LIEF")) is None